@@ -38,6 +38,7 @@ const string ProcessorConfig::BATCH_PROCESSOR_STRATEGY = "batch";
 ProcessorConfig::ProcessorConfig()
     : processorThreadNum(DEFAULT_PROCESSOR_THREAD_NUM)
     , processorQueueSize(DEFAULT_PROCESSOR_QUEUE_SIZE)
+    , processorSerializeThreadNum(0)
     , srcThreadNum(DEFAULT_SRC_THREAD_NUM)
     , srcQueueSize(DEFAULT_SRC_QUEUE_SIZE)
     , checkpointInterval(DEFAULT_CHECKPOINT_INTERVAL)
@@ -53,6 +54,7 @@ void ProcessorConfig::Jsonize(autil::legacy::Jsonizable::JsonWrapper& json)
     json.Jsonize("processor_strategy", processorStrategyStr, processorStrategyStr);
     json.Jsonize("processor_strategy_parameter", processorStrategyParameter, processorStrategyParameter);
     json.Jsonize("processor_thread_num", processorThreadNum, processorThreadNum);
+    json.Jsonize("processor_serialize_thread_num", processorSerializeThreadNum, processorSerializeThreadNum);
     json.Jsonize("src_thread_num", srcThreadNum, srcThreadNum);
     json.Jsonize("_bs_checkpoint_interval", checkpointInterval, checkpointInterval);
     json.Jsonize("enable_rewrite_delete_sub_doc", enableRewriteDeleteSubDoc, enableRewriteDeleteSubDoc);
@@ -45,6 +45,9 @@ public:
 public:
     uint32_t processorThreadNum;
     uint32_t processorQueueSize;
+    // threads serializing processed docs after processor chain, 0 means serialize in output thread.
+    // only useful when processed docs are written to swift
+    uint32_t processorSerializeThreadNum;
 
     uint32_t srcThreadNum;
     uint32_t srcQueueSize;
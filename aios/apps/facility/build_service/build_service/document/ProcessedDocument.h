@@ -54,7 +54,7 @@ public:
     typedef std::vector<DocClusterMeta> DocClusterMetaVec;
 
 public:
-    ProcessedDocument() : _needSkip(false), _isUserDoc(true), _serializeFormat(SF_BINARY) {}
+    ProcessedDocument() : _needSkip(false), _isUserDoc(true), _hasDocStr(false), _serializeFormat(SF_BINARY) {}
     ~ProcessedDocument() {}
 
 public:
@@ -79,10 +79,12 @@ public:
 
     void setDocSerializeFormat(SerializeFormat format);
     std::string transToDocString();
+    // serialize ahead of the output thread, later transToDocString returns the cached string
+    void prepareDocString();
 
     const std::string& getRawDocString() const { return _rawDocStr; }
     void setRawDocString(const std::string& str) { _rawDocStr = str; }
-    void enableSerializeRawDocument() { _serializeFormat = SF_RAW; }
+    void enableSerializeRawDocument() { setDocSerializeFormat(SF_RAW); }
 
     static std::string transToBinaryDocStr(const std::shared_ptr<indexlibv2::document::IDocument>& document)
     {
@@ -128,9 +130,11 @@ private:
     DocClusterMetaVec _docClusterMeta;
     bool _needSkip;
     bool _isUserDoc;
+    bool _hasDocStr;
     SerializeFormat _serializeFormat;
     std::string _traceField;
     std::string _rawDocStr;
+    std::string _docStr;
 };
 
 BS_TYPEDEF_PTR(ProcessedDocument);
@@ -156,6 +160,7 @@ inline std::shared_ptr<indexlib::document::Document> ProcessedDocument::getLegac
 inline void ProcessedDocument::setDocumentBatch(const std::shared_ptr<indexlibv2::document::IDocumentBatch>& docBatch)
 {
     _documentBatch = docBatch;
+    _hasDocStr = false;
 }
 inline const std::shared_ptr<indexlibv2::document::IDocumentBatch>& ProcessedDocument::getDocumentBatch() const
 {
@@ -186,8 +191,18 @@ inline void ProcessedDocument::setIsUserDoc(bool isUserDoc) { _isUserDoc = isUse
 
 inline bool ProcessedDocument::isUserDoc() const { return _isUserDoc; }
 
+inline void ProcessedDocument::setDocSerializeFormat(SerializeFormat format)
+{
+    _serializeFormat = format;
+    // cached doc string is in the old format
+    _hasDocStr = false;
+}
+
 inline std::string ProcessedDocument::transToDocString()
 {
+    if (_hasDocStr) {
+        return _docStr;
+    }
     std::shared_ptr<indexlibv2::document::IDocument> document = getDocument();
     assert(document);
     if (_serializeFormat == SF_RAW) {
@@ -212,6 +227,12 @@ inline std::string ProcessedDocument::transToDocString()
     return transToBinaryDocStr(document);
 }
 
+inline void ProcessedDocument::prepareDocString()
+{
+    _docStr = transToDocString();
+    _hasDocStr = true;
+}
+
 inline void ProcessedDocument::TEST_setDocument(const std::shared_ptr<indexlibv2::document::IDocument>& document)
 {
     if (!document) {
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "build_service/processor/PipelinedProcessorWorkItemExecutor.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "alog/Logger.h"
+#include "autil/CommonMacros.h"
+#include "autil/ThreadPool.h"
+#include "autil/WorkItem.h"
+
+using namespace std;
+
+namespace build_service { namespace processor {
+BS_LOG_SETUP(processor, PipelinedProcessorWorkItemExecutor);
+
+namespace {
+
+class SerializeWorkItem : public autil::WorkItem
+{
+public:
+    explicit SerializeWorkItem(ProcessorWorkItem* workItem) : _workItem(workItem) {}
+    ~SerializeWorkItem() { DELETE_AND_SET_NULL(_workItem); }
+
+public:
+    void process() override { _workItem->serializeProcessedDocs(); }
+    ProcessorWorkItem* stealWorkItem()
+    {
+        ProcessorWorkItem* workItem = _workItem;
+        _workItem = NULL;
+        return workItem;
+    }
+
+private:
+    ProcessorWorkItem* _workItem;
+};
+
+} // namespace
+
+PipelinedProcessorWorkItemExecutor::PipelinedProcessorWorkItemExecutor(uint32_t processThreadNum,
+                                                                       uint32_t serializeThreadNum, uint32_t queueSize)
+    : _stopped(false)
+{
+    _processThreadPool.reset(new autil::OutputOrderedThreadPool(processThreadNum, queueSize));
+    _serializeThreadPool.reset(new autil::OutputOrderedThreadPool(serializeThreadNum, queueSize));
+}
+
+PipelinedProcessorWorkItemExecutor::~PipelinedProcessorWorkItemExecutor()
+{
+    stop(/*instant*/ false);
+
+    ProcessorWorkItem* item = pop();
+    if (item != NULL) {
+        BS_LOG(WARN, "some processor work itmes still in queue, drop them");
+    }
+    while (item != NULL) {
+        DELETE_AND_SET_NULL(item);
+        item = pop();
+    }
+}
+
+bool PipelinedProcessorWorkItemExecutor::start()
+{
+    if (!_processThreadPool->start("BsProcess") || !_serializeThreadPool->start("BsSerialize")) {
+        return false;
+    }
+    _forwardThread = autil::Thread::createThread(bind(&PipelinedProcessorWorkItemExecutor::forwardLoop, this),
+                                                 "BsProcessForward");
+    if (!_forwardThread) {
+        BS_LOG(ERROR, "create processor forward thread failed");
+        return false;
+    }
+    return true;
+}
+
+void PipelinedProcessorWorkItemExecutor::forwardLoop()
+{
+    while (true) {
+        // return NULL only after process stage is stopped and drained
+        ProcessorWorkItem* workItem = static_cast<ProcessorWorkItem*>(_processThreadPool->popWorkItem());
+        if (workItem == NULL) {
+            break;
+        }
+        SerializeWorkItem* serializeItem = new SerializeWorkItem(workItem);
+        if (!_serializeThreadPool->pushWorkItem(serializeItem)) {
+            BS_LOG(WARN, "push serialize work item failed, drop it");
+            delete serializeItem;
+        }
+    }
+}
+
+bool PipelinedProcessorWorkItemExecutor::push(ProcessorWorkItem* workItem)
+{
+    return _processThreadPool->pushWorkItem(workItem);
+}
+
+ProcessorWorkItem* PipelinedProcessorWorkItemExecutor::pop()
+{
+    SerializeWorkItem* serializeItem = static_cast<SerializeWorkItem*>(_serializeThreadPool->popWorkItem());
+    if (serializeItem == NULL) {
+        return NULL;
+    }
+    ProcessorWorkItem* workItem = serializeItem->stealWorkItem();
+    delete serializeItem;
+    return workItem;
+}
+
+void PipelinedProcessorWorkItemExecutor::stop(bool instant)
+{
+    if (_stopped) {
+        return;
+    }
+    if (instant) {
+        // stop downstream first so that forward thread blocked on a full serialize queue is woken up
+        auto stopType = autil::ThreadPool::STOP_AND_CLEAR_QUEUE_IGNORE_EXCEPTION;
+        _serializeThreadPool->waitStop(stopType);
+        _processThreadPool->waitStop(stopType);
+        _forwardThread.reset();
+    } else {
+        // forward thread exits once process stage is drained, consumer keeps popping meanwhile
+        auto stopType = autil::ThreadPool::STOP_AFTER_QUEUE_EMPTY;
+        _processThreadPool->waitStop(stopType);
+        _forwardThread.reset();
+        _serializeThreadPool->waitStop(stopType);
+    }
+    _stopped = true;
+}
+
+uint32_t PipelinedProcessorWorkItemExecutor::getWaitItemCount()
+{
+    return _processThreadPool->getWaitItemCount() + _serializeThreadPool->getWaitItemCount();
+}
+
+uint32_t PipelinedProcessorWorkItemExecutor::getOutputItemCount() { return _serializeThreadPool->getOutputItemCount(); }
+
+}} // namespace build_service::processor
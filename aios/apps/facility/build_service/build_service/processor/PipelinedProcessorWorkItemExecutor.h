@@ -0,0 +1,65 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#include "autil/OutputOrderedThreadPool.h"
+#include "autil/Thread.h"
+#include "build_service/common_define.h"
+#include "build_service/processor/ProcessorWorkItem.h"
+#include "build_service/processor/ProcessorWorkItemExecutor.h"
+#include "build_service/util/Log.h"
+
+namespace build_service { namespace processor {
+
+// two ordered stages: processor chain (including tokenize) and doc serialize, each with its own threads.
+// items leave both stages in push order, so locators of one source stay monotonic.
+class PipelinedProcessorWorkItemExecutor : public ProcessorWorkItemExecutor
+{
+public:
+    PipelinedProcessorWorkItemExecutor(uint32_t processThreadNum, uint32_t serializeThreadNum, uint32_t queueSize);
+    ~PipelinedProcessorWorkItemExecutor();
+
+private:
+    PipelinedProcessorWorkItemExecutor(const PipelinedProcessorWorkItemExecutor&);
+    PipelinedProcessorWorkItemExecutor& operator=(const PipelinedProcessorWorkItemExecutor&);
+
+public:
+    bool start() override;
+    bool push(ProcessorWorkItem* workItem) override;
+    ProcessorWorkItem* pop() override;
+    void stop(bool instant) override;
+    uint32_t getWaitItemCount() override;
+    uint32_t getOutputItemCount() override;
+
+private:
+    void forwardLoop();
+
+private:
+    autil::OutputOrderedThreadPoolPtr _processThreadPool;
+    autil::OutputOrderedThreadPoolPtr _serializeThreadPool;
+    autil::ThreadPtr _forwardThread;
+    std::atomic<bool> _stopped;
+
+private:
+    BS_LOG_DECLARE();
+};
+
+BS_TYPEDEF_PTR(PipelinedProcessorWorkItemExecutor);
+
+}} // namespace build_service::processor
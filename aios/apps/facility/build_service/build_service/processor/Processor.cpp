@@ -38,6 +38,7 @@
 #include "build_service/processor/DocumentProcessorChainCreator.h"
 #include "build_service/processor/DocumentProcessorChainCreatorV2.h"
 #include "build_service/processor/MultiThreadProcessorWorkItemExecutor.h"
+#include "build_service/processor/PipelinedProcessorWorkItemExecutor.h"
 #include "build_service/processor/ProcessorChainSelector.h"
 #include "build_service/processor/ProcessorWorkItem.h"
 #include "build_service/processor/RegionDocumentProcessor.h"
@@ -70,6 +71,8 @@ BS_LOG_SETUP(processor, Processor);
 
 Processor::Processor(const string& strategyParam)
     : _strategyParam(strategyParam)
+    , _processStageThreadNum(1)
+    , _serializeStageThreadNum(0)
     , _stopped(false)
     , _dropped(false)
     , _sealed(false)
@@ -119,7 +122,13 @@ bool Processor::start(const config::ProcessorConfigReaderPtr& resourceReaderPtr,
         return false;
     }
 
-    if (!forceSingleThreaded && processorConfig.processorThreadNum > 1) {
+    if (!forceSingleThreaded && processorConfig.processorSerializeThreadNum > 0) {
+        _processStageThreadNum = processorConfig.processorThreadNum;
+        _serializeStageThreadNum = processorConfig.processorSerializeThreadNum;
+        _executor.reset(new PipelinedProcessorWorkItemExecutor(_processStageThreadNum, _serializeStageThreadNum,
+                                                               processorConfig.processorQueueSize));
+    } else if (!forceSingleThreaded && processorConfig.processorThreadNum > 1) {
+        _processStageThreadNum = processorConfig.processorThreadNum;
         _executor.reset(new MultiThreadProcessorWorkItemExecutor(processorConfig.processorThreadNum,
                                                                  processorConfig.processorQueueSize));
     } else {
@@ -443,6 +452,7 @@ document::ProcessedDocumentVecPtr Processor::getProcessedDoc()
 {
     while (true) {
         REPORT_METRIC(_waitProcessCountMetric, _executor->getWaitItemCount());
+        _reporter.reportStageUtilization(_processStageThreadNum, _serializeStageThreadNum);
         ProcessorWorkItem* workItem = _executor->pop();
         if (!workItem) {
             break;
@@ -124,6 +124,8 @@ protected:
     indexlib::util::AccumulativeCounterPtr _processDocCountCounter;
     ProcessorChainSelectorPtr _chainSelector;
     std::string _strategyParam;
+    uint32_t _processStageThreadNum;
+    uint32_t _serializeStageThreadNum;
 
     bool _stopped;
 
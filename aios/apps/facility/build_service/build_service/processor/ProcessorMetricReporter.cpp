@@ -16,6 +16,7 @@
 #include "build_service/processor/ProcessorMetricReporter.h"
 
 #include "alog/Logger.h"
+#include "autil/TimeUtility.h"
 #include "build_service/util/Monitor.h"
 #include "indexlib/util/metrics/MetricProvider.h"
 #include "kmonitor/client/MetricType.h"
@@ -38,6 +39,10 @@ bool ProcessorMetricReporter::declareMetrics(indexlib::util::MetricProviderPtr m
     _addDocDeleteSubQpsMetric = DECLARE_METRIC(metricProvider, "debug/addDocDeleteSubQps", kmonitor::QPS, "count");
     _rewriteDeleteSubDocQpsMetric =
         DECLARE_METRIC(metricProvider, "debug/rewriteDeleteSubDocQps", kmonitor::QPS, "count");
+    _processStageUtilizationMetric =
+        DECLARE_METRIC(metricProvider, "perf/processStageUtilization", kmonitor::GAUGE, "%");
+    _serializeStageUtilizationMetric =
+        DECLARE_METRIC(metricProvider, "perf/serializeStageUtilization", kmonitor::GAUGE, "%");
     return true;
 }
 
@@ -47,4 +52,33 @@ void ProcessorMetricReporter::increaseDocCount(uint32_t docCount)
     REPORT_METRIC(_totalDocCountMetric, _totalDocCount);
 }
 
+void ProcessorMetricReporter::reportStageUtilization(uint32_t processThreadNum, uint32_t serializeThreadNum)
+{
+    int64_t currentTime = autil::TimeUtility::currentTime();
+    if (currentTime - _lastStageReportTime.load(std::memory_order_relaxed) < 1000 * 1000) {
+        return;
+    }
+    autil::ScopedLock lock(_stageReportMutex);
+    int64_t lastReportTime = _lastStageReportTime.load(std::memory_order_relaxed);
+    int64_t interval = currentTime - lastReportTime;
+    if (interval < 1000 * 1000) {
+        return;
+    }
+    int64_t processStageTime = _processStageTime.load(std::memory_order_relaxed);
+    int64_t serializeStageTime = _serializeStageTime.load(std::memory_order_relaxed);
+    if (lastReportTime > 0) {
+        if (processThreadNum > 0) {
+            REPORT_METRIC(_processStageUtilizationMetric,
+                          100.0 * (processStageTime - _lastProcessStageTime) / (interval * processThreadNum));
+        }
+        if (serializeThreadNum > 0) {
+            REPORT_METRIC(_serializeStageUtilizationMetric,
+                          100.0 * (serializeStageTime - _lastSerializeStageTime) / (interval * serializeThreadNum));
+        }
+    }
+    _lastStageReportTime.store(currentTime, std::memory_order_relaxed);
+    _lastProcessStageTime = processStageTime;
+    _lastSerializeStageTime = serializeStageTime;
+}
+
 }} // namespace build_service::processor
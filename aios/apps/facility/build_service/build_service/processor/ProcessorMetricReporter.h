@@ -15,9 +15,11 @@
  */
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <stdint.h>
 
+#include "autil/Lock.h"
 #include "build_service/util/Log.h"
 
 namespace indexlib { namespace util {
@@ -33,11 +35,25 @@ namespace build_service { namespace processor {
 class ProcessorMetricReporter
 {
 public:
-    ProcessorMetricReporter() : _totalDocCount(0) {}
+    ProcessorMetricReporter()
+        : _totalDocCount(0)
+        , _processStageTime(0)
+        , _serializeStageTime(0)
+        , _lastStageReportTime(0)
+        , _lastProcessStageTime(0)
+        , _lastSerializeStageTime(0)
+    {
+    }
 
 public:
     void increaseDocCount(uint32_t docCount = 1);
 
+    // busy time in us, accumulated by all threads of the stage
+    void addProcessStageTime(int64_t time) { _processStageTime.fetch_add(time, std::memory_order_relaxed); }
+    void addSerializeStageTime(int64_t time) { _serializeStageTime.fetch_add(time, std::memory_order_relaxed); }
+    // report busy ratio of each stage since last report, at most once per second
+    void reportStageUtilization(uint32_t processThreadNum, uint32_t serializeThreadNum);
+
 public:
     bool declareMetrics(indexlib::util::MetricProviderPtr metricProvider);
     indexlib::util::MetricPtr _processLatencyMetric;
@@ -49,9 +65,17 @@ public:
     indexlib::util::MetricPtr _totalDocCountMetric;
     indexlib::util::MetricPtr _addDocDeleteSubQpsMetric;
     indexlib::util::MetricPtr _rewriteDeleteSubDocQpsMetric;
+    indexlib::util::MetricPtr _processStageUtilizationMetric;
+    indexlib::util::MetricPtr _serializeStageUtilizationMetric;
 
 private:
     uint32_t _totalDocCount;
+    std::atomic<int64_t> _processStageTime;
+    std::atomic<int64_t> _serializeStageTime;
+    autil::ThreadMutex _stageReportMutex;
+    std::atomic<int64_t> _lastStageReportTime;
+    int64_t _lastProcessStageTime;
+    int64_t _lastSerializeStageTime;
 
 private:
     BS_LOG_DECLARE();
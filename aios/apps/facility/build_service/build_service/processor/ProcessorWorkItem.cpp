@@ -20,6 +20,8 @@
 #include <string>
 
 #include "alog/Logger.h"
+#include "autil/TimeUtility.h"
+#include "autil/legacy/exception.h"
 #include "build_service/document/ClassifiedDocument.h"
 #include "build_service/processor/DeleteSubRawDocRewriter.h"
 #include "build_service/processor/ProcessorMetricReporter.h"
@@ -55,11 +57,38 @@ ProcessorWorkItem::~ProcessorWorkItem() {}
 
 void ProcessorWorkItem::process()
 {
+    int64_t beginTime = autil::TimeUtility::currentTime();
     if (_batchRawDocsPtr) {
         batchProcess();
+    } else {
+        singleProcess();
+    }
+    _reporter->addProcessStageTime(autil::TimeUtility::currentTime() - beginTime);
+}
+
+void ProcessorWorkItem::serializeProcessedDocs()
+{
+    if (!_processedDocumentVecPtr) {
         return;
     }
-    singleProcess();
+    int64_t beginTime = autil::TimeUtility::currentTime();
+    for (const auto& processedDoc : *_processedDocumentVecPtr) {
+        if (!processedDoc || processedDoc->needSkip()) {
+            continue;
+        }
+        const auto& document = processedDoc->getDocument();
+        if (!document || document->GetDocOperateType() == SKIP_DOC ||
+            document->GetDocOperateType() == CHECKPOINT_DOC || document->GetDocOperateType() == UNKNOWN_OP) {
+            continue;
+        }
+        try {
+            processedDoc->prepareDocString();
+        } catch (const autil::legacy::ExceptionBase& e) {
+            // leave it to output thread, which reports the error as before
+            BS_INTERVAL_LOG(60, WARN, "serialize processed doc failed, exception [%s]", e.what());
+        }
+    }
+    _reporter->addSerializeStageTime(autil::TimeUtility::currentTime() - beginTime);
 }
 
 void ProcessorWorkItem::batchProcess()
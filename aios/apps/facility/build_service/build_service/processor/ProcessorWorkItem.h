@@ -59,6 +59,8 @@ public:
 
 public:
     void process() override;
+    // serialize processed docs for swift output, called by the serialize stage of pipelined executor
+    void serializeProcessedDocs();
     void setProcessErrorCounter(const indexlib::util::AccumulativeCounterPtr& processErrorCounter)
     {
         _processErrorCounter = processErrorCounter;
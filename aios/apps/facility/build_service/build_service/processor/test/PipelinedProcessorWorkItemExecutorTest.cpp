@@ -0,0 +1,158 @@
+#include "build_service/processor/PipelinedProcessorWorkItemExecutor.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "build_service/document/ProcessedDocument.h"
+#include "build_service/processor/ProcessorMetricReporter.h"
+#include "build_service/test/unittest.h"
+#include "indexlib/document/normal/NormalDocument.h"
+
+using namespace std;
+using namespace build_service::document;
+
+namespace build_service { namespace processor {
+
+namespace {
+
+class FakeProcessorWorkItem : public ProcessorWorkItem
+{
+public:
+    FakeProcessorWorkItem(uint32_t id, ProcessorMetricReporter* reporter, std::atomic<uint32_t>* processedCount)
+        : ProcessorWorkItem(/*chains=*/nullptr, /*chainSelector=*/nullptr, /*enableRewriteDeleteSubDoc=*/false,
+                            reporter)
+        , _id(id)
+        , _processedCount(processedCount)
+    {
+    }
+
+public:
+    void process() override
+    {
+        // earlier items finish later, output must still follow push order
+        usleep((10 - _id % 10) * 100);
+        auto document = make_shared<indexlibv2::document::NormalDocument>();
+        document->SetDocOperateType(ADD_DOC);
+        auto processedDoc = make_shared<ProcessedDocument>();
+        processedDoc->TEST_setDocument(document);
+        auto skipDoc = make_shared<ProcessedDocument>();
+        skipDoc->TEST_setDocument(document);
+        skipDoc->setNeedSkip(true);
+        _processedDocumentVecPtr.reset(new ProcessedDocumentVec({processedDoc, skipDoc}));
+        (*_processedCount)++;
+    }
+    uint32_t getId() const { return _id; }
+
+private:
+    uint32_t _id;
+    std::atomic<uint32_t>* _processedCount;
+};
+
+} // namespace
+
+class PipelinedProcessorWorkItemExecutorTest : public BUILD_SERVICE_TESTBASE
+{
+protected:
+    void pushItems(PipelinedProcessorWorkItemExecutor& executor, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; ++i) {
+            ASSERT_TRUE(executor.push(new FakeProcessorWorkItem(i, &_reporter, &_processedCount)));
+        }
+    }
+    void checkSerialized(ProcessorWorkItem* workItem)
+    {
+        const auto& processedDocs = workItem->getProcessedDocs();
+        ASSERT_TRUE(processedDocs);
+        ASSERT_EQ(2u, processedDocs->size());
+        const auto& processedDoc = (*processedDocs)[0];
+        ASSERT_TRUE(processedDoc->_hasDocStr);
+        ASSERT_EQ(ProcessedDocument::transToBinaryDocStr(processedDoc->getDocument()), processedDoc->_docStr);
+        ASSERT_EQ(processedDoc->_docStr, processedDoc->transToDocString());
+        // skipped doc is left to output thread
+        ASSERT_FALSE((*processedDocs)[1]->_hasDocStr);
+    }
+
+protected:
+    ProcessorMetricReporter _reporter;
+    std::atomic<uint32_t> _processedCount {0};
+};
+
+TEST_F(PipelinedProcessorWorkItemExecutorTest, testOutputInPushOrder)
+{
+    const uint32_t itemCount = 200;
+    PipelinedProcessorWorkItemExecutor executor(/*processThreadNum=*/4, /*serializeThreadNum=*/2, /*queueSize=*/8);
+    ASSERT_TRUE(executor.start());
+    std::thread pushThread([&]() { pushItems(executor, itemCount); });
+    for (uint32_t i = 0; i < itemCount; ++i) {
+        ProcessorWorkItem* workItem = executor.pop();
+        ASSERT_TRUE(workItem);
+        EXPECT_EQ(i, static_cast<FakeProcessorWorkItem*>(workItem)->getId());
+        checkSerialized(workItem);
+        delete workItem;
+    }
+    pushThread.join();
+    ASSERT_EQ(itemCount, _processedCount.load());
+    ASSERT_EQ(0u, executor.getWaitItemCount());
+    ASSERT_EQ(0u, executor.getOutputItemCount());
+    executor.stop(/*instant=*/false);
+    ASSERT_FALSE(executor.pop());
+}
+
+TEST_F(PipelinedProcessorWorkItemExecutorTest, testSerializeStage)
+{
+    PipelinedProcessorWorkItemExecutor executor(/*processThreadNum=*/1, /*serializeThreadNum=*/1, /*queueSize=*/4);
+    ASSERT_TRUE(executor.start());
+    pushItems(executor, 1);
+    ProcessorWorkItem* workItem = executor.pop();
+    ASSERT_TRUE(workItem);
+    checkSerialized(workItem);
+
+    // cached doc string is dropped once the serialize format changes
+    const auto& processedDoc = (*workItem->getProcessedDocs())[0];
+    processedDoc->setDocSerializeFormat(ProcessedDocument::SF_BINARY);
+    ASSERT_FALSE(processedDoc->_hasDocStr);
+    processedDoc->prepareDocString();
+    ASSERT_TRUE(processedDoc->_hasDocStr);
+    processedDoc->enableSerializeRawDocument();
+    ASSERT_FALSE(processedDoc->_hasDocStr);
+    delete workItem;
+}
+
+TEST_F(PipelinedProcessorWorkItemExecutorTest, testStopAfterDrain)
+{
+    const uint32_t itemCount = 50;
+    PipelinedProcessorWorkItemExecutor executor(/*processThreadNum=*/2, /*serializeThreadNum=*/2, /*queueSize=*/4);
+    ASSERT_TRUE(executor.start());
+    std::thread stopThread([&]() {
+        pushItems(executor, itemCount);
+        executor.stop(/*instant=*/false);
+    });
+    // items pushed before stop all come out in order, then pop returns NULL
+    uint32_t popCount = 0;
+    while (ProcessorWorkItem* workItem = executor.pop()) {
+        EXPECT_EQ(popCount, static_cast<FakeProcessorWorkItem*>(workItem)->getId());
+        checkSerialized(workItem);
+        delete workItem;
+        ++popCount;
+    }
+    stopThread.join();
+    ASSERT_EQ(itemCount, popCount);
+    std::unique_ptr<ProcessorWorkItem> lateItem(new FakeProcessorWorkItem(itemCount, &_reporter, &_processedCount));
+    ASSERT_FALSE(executor.push(lateItem.get()));
+}
+
+TEST_F(PipelinedProcessorWorkItemExecutorTest, testStopInstant)
+{
+    PipelinedProcessorWorkItemExecutor executor(/*processThreadNum=*/2, /*serializeThreadNum=*/1, /*queueSize=*/4);
+    ASSERT_TRUE(executor.start());
+    // fill both stages without consuming, forward thread blocks on the full serialize queue
+    pushItems(executor, 8);
+    ASSERT_TRUE(timeWait([&]() { return _processedCount.load() >= 8; }, std::chrono::milliseconds(10), 500));
+    executor.stop(/*instant=*/true);
+    // queued items are dropped, nothing left to pop
+    ASSERT_FALSE(executor.pop());
+}
+
+}} // namespace build_service::processor
@@ -15,6 +15,11 @@
  */
 #pragma once
 
+#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "build_service/common_define.h"
 #include "build_service/util/Log.h"
 
@@ -33,6 +38,9 @@ private:
 public:
     const char* findInBuffer(const char* buffer, const char* end) const;
 
+private:
+    const char* findShortInBuffer(const char* buffer, const char* end) const;
+
 public:
     size_t size() const { return _sep.size(); }
     bool isEmpty() { return _sep.empty(); }
@@ -48,8 +56,7 @@ inline const char* Separator::findInBuffer(const char* buffer, const char* end)
     size_t sepLen = _sep.size();
     const char* sepBegin = _sep.data();
     if (sepLen <= 4) {
-        const char* ret = std::search(buffer, end, sepBegin, sepBegin + sepLen);
-        return ret != end ? ret : NULL;
+        return findShortInBuffer(buffer, end);
     }
 
     const char* curBack = buffer + sepLen - 1;
@@ -73,4 +80,36 @@ inline const char* Separator::findInBuffer(const char* buffer, const char* end)
     return NULL;
 }
 
+// short separators (ha3 "=" and "\x1F\n") are matched 16 bytes at a time: compare the first
+// and last separator bytes at every offset, then verify the candidates
+inline const char* Separator::findShortInBuffer(const char* buffer, const char* end) const
+{
+    size_t sepLen = _sep.size();
+    const char* sepBegin = _sep.data();
+    if (sepLen == 0 || buffer >= end) {
+        return NULL;
+    }
+    const char* cur = buffer;
+#if defined(__SSE2__)
+    const __m128i first = _mm_set1_epi8(sepBegin[0]);
+    const __m128i last = _mm_set1_epi8(sepBegin[sepLen - 1]);
+    while (end - cur >= (ptrdiff_t)(16 + sepLen - 1)) {
+        __m128i blockFirst = _mm_loadu_si128((const __m128i*)cur);
+        __m128i blockLast = _mm_loadu_si128((const __m128i*)(cur + sepLen - 1));
+        __m128i match = _mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last));
+        uint32_t mask = _mm_movemask_epi8(match);
+        while (mask != 0) {
+            const char* candidate = cur + __builtin_ctz(mask);
+            if (sepLen <= 2 || memcmp(candidate + 1, sepBegin + 1, sepLen - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+        cur += 16;
+    }
+#endif
+    const char* ret = std::search(cur, end, sepBegin, sepBegin + sepLen);
+    return ret != end ? ret : NULL;
+}
+
 }} // namespace build_service::reader
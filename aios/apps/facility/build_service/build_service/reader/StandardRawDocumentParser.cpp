@@ -15,6 +15,10 @@
  */
 #include "build_service/reader/StandardRawDocumentParser.h"
 
+#include <string.h>
+
+#include "autil/mem_pool/Pool.h"
+
 using namespace std;
 using namespace autil;
 using namespace build_service::document;
@@ -32,6 +36,54 @@ StandardRawDocumentParser::StandardRawDocumentParser(const string& fieldSep, con
 StandardRawDocumentParser::~StandardRawDocumentParser() {}
 
 bool StandardRawDocumentParser::parse(const string& docString, RawDocument& rawDoc)
+{
+    autil::mem_pool::Pool* pool = rawDoc.getPool();
+    if (!pool) {
+        return parseWithCopy(docString, rawDoc);
+    }
+    // copy the doc into the document pool once, field values are views of this buffer.
+    // the first byte of every separator is overwritten by '\0' so that values stay c strings.
+    size_t docLen = docString.size();
+    char* docBuffer = (char*)pool->allocate(docLen + 1);
+    memcpy(docBuffer, docString.data(), docLen);
+    docBuffer[docLen] = '\0';
+
+    char* docCursor = docBuffer;
+    char* docEnd = docBuffer + docLen;
+    while (docCursor < docEnd) {
+        char* nameBegin = docCursor;
+        char* nameEnd = (char*)_keyValueSep.findInBuffer(nameBegin, docEnd);
+        if (!nameEnd) {
+            break;
+        }
+        docCursor = nameEnd + _keyValueSep.size();
+        if (docCursor > docEnd) {
+            break;
+        }
+        char* valueBegin = docCursor;
+        char* valueEnd = docEnd;
+        if (docCursor < docEnd) {
+            char* sepPos = (char*)_fieldSep.findInBuffer(valueBegin, docEnd);
+            if (sepPos) {
+                valueEnd = sepPos;
+            }
+            docCursor = valueEnd + _fieldSep.size();
+        }
+        *valueEnd = '\0';
+
+        const char* fieldName = nameBegin;
+        size_t nameLen = nameEnd - nameBegin;
+        trim(fieldName, nameLen);
+        if (nameLen == 0) {
+            BS_LOG(WARN, "fieldName should not be empty after trim");
+            continue;
+        }
+        rawDoc.setFieldNoCopy(StringView(fieldName, nameLen), StringView(valueBegin, valueEnd - valueBegin));
+    }
+    return finishParse(docString, rawDoc);
+}
+
+bool StandardRawDocumentParser::parseWithCopy(const string& docString, RawDocument& rawDoc)
 {
     const char* docCursor = docString.data();
     const char* docEnd = docString.data() + docString.size();
@@ -62,6 +114,11 @@ bool StandardRawDocumentParser::parse(const string& docString, RawDocument& rawD
         }
         rawDoc.setField(fieldName.first, fieldName.second, fieldValue.first, fieldValue.second);
     }
+    return finishParse(docString, rawDoc);
+}
+
+bool StandardRawDocumentParser::finishParse(const string& docString, RawDocument& rawDoc)
+{
     if (rawDoc.getFieldCount() == 0) {
         BS_LOG(WARN,
                "fieldCount is zero, docString is: %s"
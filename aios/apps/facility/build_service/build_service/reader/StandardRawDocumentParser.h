@@ -42,6 +42,8 @@ public:
     }
 
 private:
+    bool parseWithCopy(const std::string& docString, document::RawDocument& rawDoc);
+    bool finishParse(const std::string& docString, document::RawDocument& rawDoc);
     void trim(const char*& ptr, size_t& len);
     std::pair<const char*, size_t> findNext(const Separator& sep, const char*& docCursor, const char* docEnd);
 
@@ -0,0 +1,114 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "autil/StringUtil.h"
+#include "build_service/document/RawDocument.h"
+#include "build_service/document/RawDocumentHashMapManager.h"
+#include "build_service/reader/DocumentSeparators.h"
+#include "build_service/reader/StandardRawDocumentParser.h"
+#include "indexlib/document/raw_document/DefaultRawDocument.h"
+
+using namespace std;
+using namespace build_service::document;
+
+namespace build_service { namespace reader {
+
+class StandardRawDocumentParserBenchmark : public benchmark::Fixture
+{
+public:
+    void SetUp(const ::benchmark::State& state) override
+    {
+        _hashMapManager.reset(new RawDocumentHashMapManager);
+        _docs.clear();
+        for (size_t i = 0; i < DOC_COUNT; ++i) {
+            _docs.push_back(makeHa3Doc(i));
+        }
+        _bytes = 0;
+        for (const auto& doc : _docs) {
+            _bytes += doc.size();
+        }
+    }
+
+    // ha3 doc with the usual mix of ids, numbers, multi value attributes and a long text body
+    static string makeHa3Doc(size_t id)
+    {
+        const string& fieldSep = RAW_DOCUMENT_HA3_FIELD_SEP;
+        const string& kvSep = RAW_DOCUMENT_HA3_KV_SEP;
+        string doc;
+        doc += "CMD" + kvSep + "add" + fieldSep;
+        doc += "nid" + kvSep + autil::StringUtil::toString(100000000 + id) + fieldSep;
+        doc += "price" + kvSep + autil::StringUtil::toString(id % 997) + ".99" + fieldSep;
+        doc += "category" + kvSep + "12\x1D" + "345\x1D" + "6789" + fieldSep;
+        doc += "title" + kvSep + "high quality cotton t-shirt for summer, size " + autil::StringUtil::toString(id % 7) +
+               fieldSep;
+        string body;
+        for (size_t i = 0; i < 32; ++i) {
+            body += "token" + autil::StringUtil::toString((id + i) % 1000) + " ";
+        }
+        doc += "body" + kvSep + body + fieldSep;
+        for (size_t i = 0; i < 16; ++i) {
+            doc += "attr_" + autil::StringUtil::toString(i) + kvSep + autil::StringUtil::toString(id * i) + fieldSep;
+        }
+        doc += "timestamp" + kvSep + "1700000000" + autil::StringUtil::toString(id % 1000);
+        return doc;
+    }
+
+    template <typename ParseFunc>
+    void run(benchmark::State& state, ParseFunc parseFunc)
+    {
+        StandardRawDocumentParser parser(RAW_DOCUMENT_HA3_FIELD_SEP, RAW_DOCUMENT_HA3_KV_SEP);
+        size_t docCount = 0;
+        for (auto _ : state) {
+            for (const auto& docStr : _docs) {
+                indexlib::document::DefaultRawDocument rawDoc(_hashMapManager);
+                bool ret = parseFunc(parser, docStr, rawDoc);
+                benchmark::DoNotOptimize(ret);
+            }
+            docCount += _docs.size();
+        }
+        state.SetItemsProcessed(docCount);
+        state.SetBytesProcessed(state.iterations() * _bytes);
+    }
+
+protected:
+    static constexpr size_t DOC_COUNT = 1000;
+    RawDocumentHashMapManagerPtr _hashMapManager;
+    vector<string> _docs;
+    size_t _bytes = 0;
+};
+
+BENCHMARK_F(StandardRawDocumentParserBenchmark, testParseHa3Doc)(benchmark::State& state)
+{
+    run(state, [](StandardRawDocumentParser& parser, const string& docStr, RawDocument& rawDoc) {
+        return parser.parse(docStr, rawDoc);
+    });
+}
+
+BENCHMARK_F(StandardRawDocumentParserBenchmark, testParseHa3DocWithCopy)(benchmark::State& state)
+{
+    run(state, [](StandardRawDocumentParser& parser, const string& docStr, RawDocument& rawDoc) {
+        return parser.parseWithCopy(docStr, rawDoc);
+    });
+}
+
+BENCHMARK_F(StandardRawDocumentParserBenchmark, testFindSeparator)(benchmark::State& state)
+{
+    Separator sep(RAW_DOCUMENT_HA3_FIELD_SEP);
+    size_t found = 0;
+    for (auto _ : state) {
+        for (const auto& docStr : _docs) {
+            const char* cursor = docStr.data();
+            const char* end = docStr.data() + docStr.size();
+            while ((cursor = sep.findInBuffer(cursor, end)) != NULL) {
+                cursor += sep.size();
+                ++found;
+            }
+        }
+    }
+    benchmark::DoNotOptimize(found);
+    state.SetBytesProcessed(state.iterations() * _bytes);
+}
+
+}} // namespace build_service::reader
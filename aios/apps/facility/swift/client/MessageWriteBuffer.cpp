@@ -83,6 +83,7 @@ MessageWriteBuffer::MessageWriteBuffer(BlockPoolPtr pool,
     , _mergeCount(SwiftWriterConfig::DEFAULT_MERGE_THRESHOLD_IN_COUNT)
     , _mergeSize(SwiftWriterConfig::DEFAULT_MERGE_THRESHOLD_IN_SIZE)
     , _compressThresholdInBytes(SwiftWriterConfig::DEFAULT_COMPRESS_THRESHOLD_IN_BYTES)
+    , _mergedMsgCodec(protocol::MMC_ZLIB)
     , _limiter(limiter)
     , _mergeThreadPool(mergeThreadPool) {
     _msgConverter = new MessageConverter(pool.get());
@@ -385,12 +386,14 @@ size_t MessageWriteBuffer::getUncommittedSize() { return _uncommittedSize; }
 void MessageWriteBuffer::updateMergeInfo(bool mergeMsg,
                                          uint32_t mergeCount,
                                          uint32_t mergeSize,
-                                         uint64_t compressThresholdInBytes) {
+                                         uint64_t compressThresholdInBytes,
+                                         protocol::MergedMessageCodec mergedMsgCodec) {
     ScopedWriteLock lock(_rwLock);
     _mergeMsg = mergeMsg;
     _mergeCount = mergeCount;
     _mergeSize = mergeSize;
     _compressThresholdInBytes = compressThresholdInBytes;
+    _mergedMsgCodec = mergedMsgCodec;
 }
 
 void MessageWriteBuffer::updateRangeUtil(const RangeUtilPtr &rangeUtil) {
@@ -639,7 +642,7 @@ void MessageWriteBuffer::doMergeMessage(uint16_t hashId,
                                         uint64_t reserveLen,
                                         ZlibCompressor *compressor) {
     MessageInfoUtil::mergeMessage(hashId, msgVec, reserveLen, msgInfo);
-    MessageInfoUtil::compressMessage(compressor, _compressThresholdInBytes, msgInfo);
+    MessageInfoUtil::compressMessage(compressor, _mergedMsgCodec, _compressThresholdInBytes, msgInfo);
     AUTIL_LOG(DEBUG, "[%s %d] merge [%d] messages", _topicName.c_str(), _partitionId, (int)msgVec.size());
 }
 
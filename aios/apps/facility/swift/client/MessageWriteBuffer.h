@@ -44,6 +44,9 @@ class ClientMemoryMessage;
 class MessageInfo;
 } // namespace common
 namespace protocol {
+enum MergedMessageCodec : uint8_t;
+} // namespace protocol
+namespace protocol {
 class FBMessageWriter;
 class ProductionRequest;
 } // namespace protocol
@@ -86,7 +89,11 @@ public:
     size_t getUnsendSize();
     size_t getUncommittedCount();
     size_t getUncommittedSize();
-    void updateMergeInfo(bool mergeMsg, uint32_t mergeCount, uint32_t mergeSize, uint64_t compressThresholdInBytes);
+    void updateMergeInfo(bool mergeMsg,
+                         uint32_t mergeCount,
+                         uint32_t mergeSize,
+                         uint64_t compressThresholdInBytes,
+                         protocol::MergedMessageCodec mergedMsgCodec);
     void updateRangeUtil(const RangeUtilPtr &rangeUtil);
     void setTopicName(const std::string &topicName);
     void setPartitionId(uint32_t partitionId);
@@ -157,6 +164,7 @@ private:
     uint64_t _mergeCount;
     uint64_t _mergeSize;
     uint64_t _compressThresholdInBytes;
+    protocol::MergedMessageCodec _mergedMsgCodec;
     BufferSizeLimiterPtr _limiter;
     RangeUtilPtr _rangeUtil;
     util::MessageConverter *_msgConverter;
@@ -367,13 +367,17 @@ bool SingleSwiftWriter::postSendMessageRequest(int64_t now, ClientMetricsCollect
               _partitionId,
               versionInfo.ShortDebugString().c_str());
     if (!versionInfo.supportmergemsg()) {
-        _writeBuffer.updateMergeInfo(
-            false, _config.mergeThresholdInCount, _config.mergeThresholdInSize, _config.compressThresholdInBytes);
+        _writeBuffer.updateMergeInfo(false,
+                                     _config.mergeThresholdInCount,
+                                     _config.mergeThresholdInSize,
+                                     _config.compressThresholdInBytes,
+                                     _config.getMergedMessageCodec());
     } else {
         _writeBuffer.updateMergeInfo(_config.mergeMsg,
                                      _config.mergeThresholdInCount,
                                      _config.mergeThresholdInSize,
-                                     _config.compressThresholdInBytes);
+                                     _config.compressThresholdInBytes,
+                                     _config.getMergedMessageCodec());
     }
     if (versionInfo.supportfb() && _config.messageFormat == 1) {
         ThreadBasedObjectPool<FBMessageWriter> *objectPool =
@@ -25,6 +25,7 @@
 #include "autil/TimeUtility.h"
 #include "autil/legacy/exception.h"
 #include "autil/legacy/legacy_jsonizable.h"
+#include "swift/protocol/MessageCompressor.h"
 
 using namespace std;
 using namespace autil;
@@ -66,6 +67,7 @@ SwiftWriterConfig::SwiftWriterConfig()
     , brokerBusyWaitIntervalMax(BROKER_BUSY_WAIT_INTERVAL_MAX)
     , waitFinishedWriterTime(DEFAULT_WAIT_FINISHED_WRITER_TIME)
     , compressThresholdInBytes(DEFAULT_COMPRESS_THRESHOLD_IN_BYTES)
+    , mergedMsgCompressor("zlib")
     , commitDetectionInterval(DEFAULT_BROKER_COMMIT_PROGRESS_DETECTION_INTERVAL)
     , compress(false)
     , compressMsg(false)
@@ -86,7 +88,11 @@ SwiftWriterConfig::~SwiftWriterConfig() {}
 
 bool SwiftWriterConfig::isValidate() const {
     return (brokerBusyWaitIntervalMax >= brokerBusyWaitIntervalMin) && !topicName.empty() &&
-           mergeThresholdInCount <= MAX_MERGE_THRESHOLD_IN_COUNT;
+           mergeThresholdInCount <= MAX_MERGE_THRESHOLD_IN_COUNT && getMergedMessageCodec() != protocol::MMC_UNKNOWN;
+}
+
+protocol::MergedMessageCodec SwiftWriterConfig::getMergedMessageCodec() const {
+    return protocol::MessageCompressor::parseMergedMessageCodec(mergedMsgCompressor);
 }
 
 void SwiftWriterConfig::Jsonize(autil::legacy::Jsonizable::JsonWrapper &json) {
@@ -106,6 +112,7 @@ void SwiftWriterConfig::Jsonize(autil::legacy::Jsonizable::JsonWrapper &json) {
     json.Jsonize(WRITER_CONFIG_MESSAGE_COMPRESS, compressMsg, false);
     json.Jsonize(WRITER_CONFIG_MESSAGE_COMPRESS_IN_BROKER, compressMsgInBroker, false);
     json.Jsonize(WRITER_CONFIG_COMPRESS_THRESHOLD_IN_BYTES, compressThresholdInBytes, compressThresholdInBytes);
+    json.Jsonize(WRITER_CONFIG_MERGED_MESSAGE_COMPRESSOR, mergedMsgCompressor, mergedMsgCompressor);
     json.Jsonize(
         WRITER_CONFIG_BROKER_COMMIT_PROGRESS_DETECTION_INTERVAL, commitDetectionInterval, commitDetectionInterval);
     json.Jsonize(WRITER_CONFIG_SYNC_SEND_TIMEOUT, syncSendTimeout, syncSendTimeout);
@@ -245,6 +252,9 @@ bool SwiftWriterConfig::parseFromString(const string &configStr) {
         else if (key == WRITER_CONFIG_FUNCTION_CHAIN) {
             functionChain = valueStr;
         }
+        else if (key == WRITER_CONFIG_MERGED_MESSAGE_COMPRESSOR) {
+            mergedMsgCompressor = valueStr;
+        }
         else if (key == WRITER_CONFIG_ZK_PATH) {
             zkPath = valueStr;
         }
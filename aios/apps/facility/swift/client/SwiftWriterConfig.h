@@ -24,6 +24,10 @@
 #include "swift/protocol/Common.pb.h"
 
 namespace swift {
+namespace protocol {
+enum MergedMessageCodec : uint8_t;
+} // namespace protocol
+
 namespace client {
 constexpr char WRITER_CONFIG_SEPERATOR[] = ";";
 constexpr char WRITER_CONFIG_KV_SEPERATOR[] = "=";
@@ -43,6 +47,7 @@ constexpr char WRITER_CONFIG_MESSAGE_COMPRESS[] = "compressMsg";
 constexpr char WRITER_CONFIG_NEED_TIMESTAMP[] = "needTimestamp";
 constexpr char WRITER_CONFIG_MESSAGE_COMPRESS_IN_BROKER[] = "compressMsgInBroker";
 constexpr char WRITER_CONFIG_COMPRESS_THRESHOLD_IN_BYTES[] = "compressThresholdInBytes";
+constexpr char WRITER_CONFIG_MERGED_MESSAGE_COMPRESSOR[] = "mergedMsgCompressor";
 constexpr char WRITER_CONFIG_BROKER_COMMIT_PROGRESS_DETECTION_INTERVAL[] = "commitDetectionInterval";
 constexpr char WRITER_TOPIC_NAME[] = "topicName";
 constexpr char WRITER_CONFIG_SYNC_SEND_TIMEOUT[] = "syncSendTimeout";
@@ -104,6 +109,7 @@ public:
         }
         return authInfo;
     }
+    protocol::MergedMessageCodec getMergedMessageCodec() const;
 
 private:
     bool parseMode(const std::string &modeStr);
@@ -123,6 +129,8 @@ public:
     std::string functionChain;
     uint64_t waitFinishedWriterTime;
     uint64_t compressThresholdInBytes;
+    // zlib, lz4 or zstd, readers must support the codec before writers enable lz4 or zstd
+    std::string mergedMsgCompressor;
     uint64_t commitDetectionInterval;
     bool compress;
     bool compressMsg;
@@ -5,6 +5,7 @@
 #include <string>
 
 #include "swift/protocol/Common.pb.h"
+#include "swift/protocol/MessageCompressor.h"
 #include "unittest/unittest.h"
 
 using namespace std;
@@ -188,6 +189,22 @@ TEST_F(SwiftWriterConfigTest, testSimpleProcess) {
     EXPECT_EQ(uint32_t(10), config.schemaVersion);
 }
 
+TEST_F(SwiftWriterConfigTest, testMergedMessageCompressor) {
+    SwiftWriterConfig config;
+    config.topicName = "topic";
+    EXPECT_EQ(protocol::MMC_ZLIB, config.getMergedMessageCodec());
+    EXPECT_TRUE(config.parseFromString("topicName=topic;mergeMessage=true;mergedMsgCompressor=zstd"));
+    EXPECT_EQ(protocol::MMC_ZSTD, config.getMergedMessageCodec());
+    EXPECT_TRUE(config.isValidate());
+    EXPECT_TRUE(config.parseFromString("mergedMsgCompressor=snappy"));
+    EXPECT_EQ(protocol::MMC_UNKNOWN, config.getMergedMessageCodec());
+    EXPECT_FALSE(config.isValidate());
+
+    SwiftWriterConfig jsonConfig;
+    EXPECT_TRUE(jsonConfig.parseFromString(R"({"topicName":"topic", "mergedMsgCompressor":"lz4"})"));
+    EXPECT_EQ(protocol::MMC_LZ4, jsonConfig.getMergedMessageCodec());
+}
+
 TEST_F(SwiftWriterConfigTest, testParseMode) {
     SwiftWriterConfig config;
 
@@ -23,6 +23,7 @@
 #include "swift/filter/AndMsgFilter.h"
 #include "swift/filter/ContainMsgFilter.h"
 #include "swift/filter/InMsgFilter.h"
+#include "swift/filter/RangeMsgFilter.h"
 
 namespace swift {
 namespace filter {
@@ -39,6 +40,7 @@ using namespace autil;
 string MsgFilterCreator::OPERATOR_IN_FILTER_SEPARATOR = " IN ";
 string MsgFilterCreator::OPERATOR_AND_FILTER_SEPARATOR = " AND ";
 string MsgFilterCreator::OPERATOR_CONTAIN_FILTER_SEPARATOR = " CONTAIN ";
+string MsgFilterCreator::OPERATOR_RANGE_FILTER_SEPARATOR = " RANGE ";
 
 MsgFilterCreator::MsgFilterCreator() {}
 
@@ -48,12 +50,15 @@ MsgFilter *MsgFilterCreator::createMsgFilter(const std::string &filterDesc) {
     size_t pos1 = filterDesc.find(OPERATOR_AND_FILTER_SEPARATOR);
     size_t pos2 = filterDesc.find(OPERATOR_CONTAIN_FILTER_SEPARATOR);
     size_t pos3 = filterDesc.find(OPERATOR_IN_FILTER_SEPARATOR);
+    size_t pos4 = filterDesc.find(OPERATOR_RANGE_FILTER_SEPARATOR);
     if (pos1 != string::npos) {
         return createAndMsgFilter(filterDesc);
     } else if (pos2 != string::npos) {
         return createContainMsgFilter(filterDesc);
     } else if (pos3 != string::npos) {
         return createInMsgFilter(filterDesc);
+    } else if (pos4 != string::npos) {
+        return createRangeMsgFilter(filterDesc);
     } else {
         return nullptr;
     }
@@ -88,6 +93,21 @@ InMsgFilter *MsgFilterCreator::createInMsgFilter(const std::string &inDesc) {
     return msgFilter;
 }
 
+RangeMsgFilter *MsgFilterCreator::createRangeMsgFilter(const std::string &rangeDesc) {
+    StringTokenizer st(rangeDesc,
+                       OPERATOR_RANGE_FILTER_SEPARATOR,
+                       StringTokenizer::TOKEN_TRIM | StringTokenizer::TOKEN_IGNORE_EMPTY);
+    if (st.getNumTokens() != 2) {
+        return nullptr;
+    }
+    RangeMsgFilter *msgFilter = new RangeMsgFilter(st[0], st[1]);
+    if (!msgFilter->init()) {
+        delete msgFilter;
+        msgFilter = nullptr;
+    }
+    return msgFilter;
+}
+
 AndMsgFilter *MsgFilterCreator::createAndMsgFilter(const std::string &andDesc) {
     StringTokenizer st(
         andDesc, OPERATOR_AND_FILTER_SEPARATOR, StringTokenizer::TOKEN_TRIM | StringTokenizer::TOKEN_IGNORE_EMPTY);
@@ -98,11 +118,14 @@ AndMsgFilter *MsgFilterCreator::createAndMsgFilter(const std::string &andDesc) {
     for (size_t i = 0; i < st.getNumTokens(); i++) {
         size_t pos1 = st[i].find(OPERATOR_CONTAIN_FILTER_SEPARATOR);
         size_t pos2 = st[i].find(OPERATOR_IN_FILTER_SEPARATOR);
+        size_t pos3 = st[i].find(OPERATOR_RANGE_FILTER_SEPARATOR);
         MsgFilter *msgFilter = nullptr;
         if (pos1 != string::npos) {
             msgFilter = createContainMsgFilter(st[i]);
         } else if (pos2 != string::npos) {
             msgFilter = createInMsgFilter(st[i]);
+        } else if (pos3 != string::npos) {
+            msgFilter = createRangeMsgFilter(st[i]);
         }
         if (msgFilter == nullptr) {
             DELETE_AND_SET_NULL(andFilter);
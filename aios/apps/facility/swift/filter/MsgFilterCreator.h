@@ -26,6 +26,7 @@ class AndMsgFilter;
 class InMsgFilter;
 class ContainMsgFilter;
 class MsgFilter;
+class RangeMsgFilter;
 } // namespace filter
 } // namespace swift
 
@@ -37,6 +38,7 @@ public:
     static std::string OPERATOR_IN_FILTER_SEPARATOR;
     static std::string OPERATOR_AND_FILTER_SEPARATOR;
     static std::string OPERATOR_CONTAIN_FILTER_SEPARATOR;
+    static std::string OPERATOR_RANGE_FILTER_SEPARATOR;
 
 public:
     MsgFilterCreator();
@@ -53,6 +55,7 @@ private:
     static InMsgFilter *createInMsgFilter(const std::string &inDesc);
     static AndMsgFilter *createAndMsgFilter(const std::string &andDesc);
     static ContainMsgFilter *createContainMsgFilter(const std::string &containDesc);
+    static RangeMsgFilter *createRangeMsgFilter(const std::string &rangeDesc);
 
 private:
     friend class MsgFilterCreatorTest;
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "swift/filter/RangeMsgFilter.h"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include "autil/Span.h"
+#include "autil/StringUtil.h"
+#include "swift/common/FieldGroupReader.h"
+#include "swift/filter/InMsgFilter.h"
+
+using namespace std;
+using namespace swift::common;
+
+namespace swift {
+namespace filter {
+AUTIL_LOG_SETUP(swift, RangeMsgFilter);
+
+std::string RangeMsgFilter::RANGE_SEPARATOR = ",";
+
+RangeMsgFilter::RangeMsgFilter(const std::string &fieldName, const std::string &rangeStr)
+    : _descStr(rangeStr)
+    , _lower(0)
+    , _upper(0)
+    , _hasLower(false)
+    , _hasUpper(false)
+    , _lowerInclusive(true)
+    , _upperInclusive(true)
+    , _optionalField(false) {
+    parseFieldName(fieldName);
+}
+
+RangeMsgFilter::~RangeMsgFilter() {}
+
+bool RangeMsgFilter::filterMsg(const FieldGroupReader &fieldGroupReader) const {
+    const Field *field = fieldGroupReader.getField(_fieldName);
+    if (field == NULL) {
+        return _optionalField;
+    }
+    // field value is not null terminated, numbers are short enough for the stack buffer
+    char buffer[MAX_NUMBER_LENGTH + 1];
+    size_t len = field->value.size();
+    if (len == 0 || len > MAX_NUMBER_LENGTH) {
+        return false;
+    }
+    memcpy(buffer, field->value.data(), len);
+    buffer[len] = '\0';
+    double value = 0;
+    if (!autil::StringUtil::strToDouble(buffer, value)) {
+        return false;
+    }
+    if (_hasLower && (value < _lower || (!_lowerInclusive && value == _lower))) {
+        return false;
+    }
+    if (_hasUpper && (value > _upper || (!_upperInclusive && value == _upper))) {
+        return false;
+    }
+    return true;
+}
+
+void RangeMsgFilter::parseFieldName(const std::string &fieldName) {
+    const string &beginFlag = InMsgFilter::OPTIONAL_FIELD_BEGIN_FLAG;
+    const string &endFlag = InMsgFilter::OPTIONAL_FIELD_END_FLAG;
+    if (fieldName.size() > beginFlag.size() + endFlag.size() && fieldName.find(beginFlag) == 0 &&
+        fieldName.rfind(endFlag) == (fieldName.length() - endFlag.length())) {
+        _fieldName = fieldName.substr(beginFlag.length(), fieldName.length() - beginFlag.length() - endFlag.length());
+        _optionalField = true;
+    } else {
+        _fieldName = fieldName;
+        _optionalField = false;
+    }
+}
+
+bool RangeMsgFilter::parseBound(const std::string &boundStr, bool &hasBound, double &bound) const {
+    string str = boundStr;
+    autil::StringUtil::trim(str);
+    if (str.empty()) {
+        hasBound = false;
+        return true;
+    }
+    hasBound = true;
+    return autil::StringUtil::fromString(str, bound);
+}
+
+bool RangeMsgFilter::init() {
+    if (_fieldName.empty() || _descStr.size() < 3) {
+        AUTIL_LOG(INFO, "RangeMsgFilter field Name [%s] or desc [%s] is invalid.", _fieldName.c_str(), _descStr.c_str());
+        return false;
+    }
+    char begin = _descStr[0];
+    char end = _descStr[_descStr.size() - 1];
+    if ((begin != '[' && begin != '(') || (end != ']' && end != ')')) {
+        AUTIL_LOG(INFO, "RangeMsgFilter desc [%s] should be enclosed by [] or ().", _descStr.c_str());
+        return false;
+    }
+    _lowerInclusive = begin == '[';
+    _upperInclusive = end == ']';
+    string bounds = _descStr.substr(1, _descStr.size() - 2);
+    size_t pos = bounds.find(RANGE_SEPARATOR);
+    if (pos == string::npos || bounds.find(RANGE_SEPARATOR, pos + 1) != string::npos) {
+        AUTIL_LOG(INFO, "RangeMsgFilter desc [%s] should have two bounds.", _descStr.c_str());
+        return false;
+    }
+    if (!parseBound(bounds.substr(0, pos), _hasLower, _lower) ||
+        !parseBound(bounds.substr(pos + RANGE_SEPARATOR.size()), _hasUpper, _upper)) {
+        AUTIL_LOG(INFO, "RangeMsgFilter desc [%s] has invalid number.", _descStr.c_str());
+        return false;
+    }
+    if (!_hasLower && !_hasUpper) {
+        AUTIL_LOG(INFO, "RangeMsgFilter desc [%s] has no bound.", _descStr.c_str());
+        return false;
+    }
+    if (_hasLower && _hasUpper && _lower > _upper) {
+        AUTIL_LOG(INFO, "RangeMsgFilter desc [%s] lower bound is larger than upper.", _descStr.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace filter
+} // namespace swift
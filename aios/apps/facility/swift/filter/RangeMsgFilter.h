@@ -0,0 +1,79 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+
+#include "autil/Log.h"
+#include "swift/common/Common.h"
+#include "swift/filter/MsgFilter.h"
+
+namespace swift {
+namespace common {
+
+class FieldGroupReader;
+} // namespace common
+} // namespace swift
+
+namespace swift {
+namespace filter {
+
+// numeric range on one field, desc like "[10,20)", "(,5]" or "[3.5,]", empty bound means unbounded
+class RangeMsgFilter : public MsgFilter {
+public:
+    static std::string RANGE_SEPARATOR;
+    static constexpr size_t MAX_NUMBER_LENGTH = 63;
+
+public:
+    RangeMsgFilter(const std::string &fieldName, const std::string &rangeStr);
+    ~RangeMsgFilter();
+
+private:
+    RangeMsgFilter(const RangeMsgFilter &);
+    RangeMsgFilter &operator=(const RangeMsgFilter &);
+
+public:
+    bool init() override;
+    bool filterMsg(const common::FieldGroupReader &fieldGroupReader) const override;
+    bool isOptionalField() { return _optionalField; }
+
+public:
+    // for test
+    const std::string &getFieldName() const { return _fieldName; }
+
+private:
+    void parseFieldName(const std::string &fieldName);
+    bool parseBound(const std::string &boundStr, bool &hasBound, double &bound) const;
+
+private:
+    std::string _fieldName;
+    std::string _descStr;
+    double _lower;
+    double _upper;
+    bool _hasLower;
+    bool _hasUpper;
+    bool _lowerInclusive;
+    bool _upperInclusive;
+    bool _optionalField;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+
+SWIFT_TYPEDEF_PTR(RangeMsgFilter);
+
+} // namespace filter
+} // namespace swift
@@ -11,6 +11,7 @@
 #include "swift/filter/ContainMsgFilter.h"
 #include "swift/filter/InMsgFilter.h"
 #include "swift/filter/MsgFilter.h"
+#include "swift/filter/RangeMsgFilter.h"
 #include "unittest/unittest.h"
 
 using namespace std;
@@ -178,6 +179,47 @@ TEST_F(MsgFilterCreatorTest, testCreateAndMsgFilter) {
         EXPECT_EQ((size_t)1, filter->_msgFilterVec.size());
         delete filter;
     }
+    {
+        string desc = "name CONTAIN a|d AND type RANGE [1,3]";
+        AndMsgFilter *filter = MsgFilterCreator::createAndMsgFilter(desc);
+        EXPECT_TRUE(filter);
+        EXPECT_EQ((size_t)2, filter->_msgFilterVec.size());
+        EXPECT_TRUE(dynamic_cast<const RangeMsgFilter *>(filter->_msgFilterVec[1]));
+        delete filter;
+    }
+    {
+        string desc = "name IN a|b AND type RANGE [3,1]";
+        AndMsgFilter *filter = MsgFilterCreator::createAndMsgFilter(desc);
+        EXPECT_FALSE(filter);
+    }
+}
+
+TEST_F(MsgFilterCreatorTest, testCreateRangeMsgFilter) {
+    {
+        string desc = "price RANGE [10,20)";
+        MsgFilter *filter = MsgFilterCreator::createMsgFilter(desc);
+        EXPECT_TRUE(filter != NULL);
+        RangeMsgFilter *rangeFilter = dynamic_cast<RangeMsgFilter *>(filter);
+        EXPECT_TRUE(rangeFilter != NULL);
+        EXPECT_EQ(string("price"), rangeFilter->getFieldName());
+        delete filter;
+    }
+    {
+        string desc = "  price   RANGE   (,5] ";
+        MsgFilter *filter = MsgFilterCreator::createMsgFilter(desc);
+        EXPECT_TRUE(filter != NULL);
+        delete filter;
+    }
+    {
+        string desc = "price RANGE 10";
+        MsgFilter *filter = MsgFilterCreator::createMsgFilter(desc);
+        EXPECT_TRUE(filter == NULL);
+    }
+    {
+        string desc = " RANGE [1,2]";
+        MsgFilter *filter = MsgFilterCreator::createMsgFilter(desc);
+        EXPECT_TRUE(filter == NULL);
+    }
 }
 
 TEST_F(MsgFilterCreatorTest, testCreateMsgFilter) {
@@ -0,0 +1,103 @@
+#include "swift/filter/RangeMsgFilter.h"
+
+#include <cstddef>
+#include <string>
+
+#include "swift/common/Common.h"
+#include "swift/common/FieldGroupReader.h"
+#include "swift/common/FieldGroupWriter.h"
+#include "unittest/unittest.h"
+
+using namespace std;
+using namespace swift::common;
+
+namespace swift {
+namespace filter {
+
+class RangeMsgFilterTest : public TESTBASE {};
+
+TEST_F(RangeMsgFilterTest, testFilterMsg) {
+    FieldGroupWriter fieldGroupWriter;
+    string name1 = string("price");
+    string value1 = string("10");
+    fieldGroupWriter.addProductionField(name1, value1, true);
+    string name2 = string("name");
+    string value2 = string("abc");
+    fieldGroupWriter.addProductionField(name2, value2, false);
+    string data;
+    fieldGroupWriter.toString(data);
+    FieldGroupReader fieldGroupReader;
+    EXPECT_TRUE(fieldGroupReader.fromProductionString(data));
+    {
+        RangeMsgFilter filter("price", "[10,20)");
+        EXPECT_TRUE(filter.init());
+        EXPECT_TRUE(filter.filterMsg(fieldGroupReader));
+    }
+    {
+        RangeMsgFilter filter("price", "(10,20]");
+        EXPECT_TRUE(filter.init());
+        EXPECT_FALSE(filter.filterMsg(fieldGroupReader));
+    }
+    {
+        RangeMsgFilter filter("price", "(,10]");
+        EXPECT_TRUE(filter.init());
+        EXPECT_TRUE(filter.filterMsg(fieldGroupReader));
+    }
+    {
+        RangeMsgFilter filter("price", "(, 10)");
+        EXPECT_TRUE(filter.init());
+        EXPECT_FALSE(filter.filterMsg(fieldGroupReader));
+    }
+    {
+        RangeMsgFilter filter("price", "[9.5,]");
+        EXPECT_TRUE(filter.init());
+        EXPECT_TRUE(filter.filterMsg(fieldGroupReader));
+    }
+    {
+        RangeMsgFilter filter("price", "[10.5,]");
+        EXPECT_TRUE(filter.init());
+        EXPECT_FALSE(filter.filterMsg(fieldGroupReader));
+    }
+    {
+        RangeMsgFilter filter("price", "[10,10]");
+        EXPECT_TRUE(filter.init());
+        EXPECT_TRUE(filter.filterMsg(fieldGroupReader));
+    }
+    {
+        // not a number
+        RangeMsgFilter filter("name", "[0,]");
+        EXPECT_TRUE(filter.init());
+        EXPECT_FALSE(filter.filterMsg(fieldGroupReader));
+    }
+    {
+        RangeMsgFilter filter("age", "[0,]");
+        EXPECT_TRUE(filter.init());
+        EXPECT_FALSE(filter.isOptionalField());
+        EXPECT_FALSE(filter.filterMsg(fieldGroupReader));
+    }
+    {
+        RangeMsgFilter filter("[age]", "[0,]");
+        EXPECT_TRUE(filter.init());
+        EXPECT_TRUE(filter.isOptionalField());
+        EXPECT_EQ(string("age"), filter.getFieldName());
+        EXPECT_TRUE(filter.filterMsg(fieldGroupReader));
+    }
+}
+
+TEST_F(RangeMsgFilterTest, testInit) {
+    EXPECT_FALSE(RangeMsgFilter("", "[1,2]").init());
+    EXPECT_FALSE(RangeMsgFilter("price", "").init());
+    EXPECT_FALSE(RangeMsgFilter("price", "1,2").init());
+    EXPECT_FALSE(RangeMsgFilter("price", "{1,2]").init());
+    EXPECT_FALSE(RangeMsgFilter("price", "[1,2").init());
+    EXPECT_FALSE(RangeMsgFilter("price", "[1]").init());
+    EXPECT_FALSE(RangeMsgFilter("price", "[1,2,3]").init());
+    EXPECT_FALSE(RangeMsgFilter("price", "[,]").init());
+    EXPECT_FALSE(RangeMsgFilter("price", "[a,2]").init());
+    EXPECT_FALSE(RangeMsgFilter("price", "[3,2]").init());
+    EXPECT_TRUE(RangeMsgFilter("price", "[-3,-2]").init());
+    EXPECT_TRUE(RangeMsgFilter("price", "(1e2,1e3)").init());
+}
+
+} // namespace filter
+} // namespace swift
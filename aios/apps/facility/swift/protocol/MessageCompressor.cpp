@@ -16,6 +16,10 @@
 #include "swift/protocol/MessageCompressor.h"
 
 #include <cstddef>
+#include <limits>
+#include <lz4.h>
+#include <memory>
+#include <zstd.h>
 
 #include "autil/TimeUtility.h"
 #include "swift/common/MessageInfo.h"
@@ -30,6 +34,20 @@ namespace swift {
 namespace protocol {
 AUTIL_LOG_SETUP(swift, MessageCompressor);
 
+namespace {
+// compression method 15 is reserved by zlib, so a legacy zlib body never starts with it
+constexpr uint8_t MERGED_CODEC_MAGIC = 0xff;
+constexpr size_t MERGED_CODEC_HEADER_LEN = sizeof(uint8_t) + sizeof(uint8_t) + sizeof(uint32_t);
+constexpr int ZSTD_MERGED_MESSAGE_LEVEL = 1;
+
+struct ZstdCCtxDeleter {
+    void operator()(ZSTD_CCtx *ctx) const { ZSTD_freeCCtx(ctx); }
+};
+struct ZstdDCtxDeleter {
+    void operator()(ZSTD_DCtx *ctx) const { ZSTD_freeDCtx(ctx); }
+};
+} // namespace
+
 MessageCompressor::MessageCompressor() {}
 
 MessageCompressor::~MessageCompressor() {}
@@ -163,6 +181,31 @@ bool MessageCompressor::compressMergedMessage(autil::ZlibCompressor *compressor,
     }
 }
 
+bool MessageCompressor::compressMergedMessage(autil::ZlibCompressor *compressor,
+                                              MergedMessageCodec codec,
+                                              uint64_t compressThreshold,
+                                              const char *data,
+                                              size_t dataLen,
+                                              string &compressedData) {
+    if (codec == MMC_ZLIB) {
+        return compressMergedMessage(compressor, compressThreshold, data, dataLen, compressedData);
+    }
+    if (dataLen <= sizeof(uint16_t) || dataLen <= compressThreshold ||
+        dataLen - sizeof(uint16_t) > numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+    uint32_t rawLen = dataLen - sizeof(uint16_t);
+    compressedData.append(data, sizeof(uint16_t));
+    compressedData.push_back((char)MERGED_CODEC_MAGIC);
+    compressedData.push_back((char)codec);
+    compressedData.append((const char *)&rawLen, sizeof(rawLen));
+    if (compressBatchData(codec, data + sizeof(uint16_t), rawLen, compressedData) && compressedData.size() < dataLen) {
+        return true;
+    }
+    compressedData.clear();
+    return false;
+}
+
 bool MessageCompressor::decompressMergedMessage(autil::ZlibCompressor *compressor,
                                                 const char *data,
                                                 size_t len,
@@ -170,9 +213,119 @@ bool MessageCompressor::decompressMergedMessage(autil::ZlibCompressor *compresso
     if (len <= sizeof(uint16_t)) {
         return false;
     }
+    const char *body = data + sizeof(uint16_t);
+    size_t bodyLen = len - sizeof(uint16_t);
+    if (bodyLen >= MERGED_CODEC_HEADER_LEN && (uint8_t)body[0] == MERGED_CODEC_MAGIC) {
+        MergedMessageCodec codec = (MergedMessageCodec)body[1];
+        uint32_t rawLen = *(const uint32_t *)(body + 2 * sizeof(uint8_t));
+        uncompressData.append(data, sizeof(uint16_t));
+        if (!decompressBatchData(
+                codec, body + MERGED_CODEC_HEADER_LEN, bodyLen - MERGED_CODEC_HEADER_LEN, rawLen, uncompressData)) {
+            AUTIL_LOG(WARN, "decompress merged message with codec [%d] failed", (int)codec);
+            return false;
+        }
+        return true;
+    }
     uncompressData.append(data, sizeof(uint16_t));
-    return MessageCompressor::uncompressData(
-        compressor, data + sizeof(uint16_t), len - sizeof(uint16_t), uncompressData);
+    return MessageCompressor::uncompressData(compressor, body, bodyLen, uncompressData);
+}
+
+bool MessageCompressor::compressBatchData(MergedMessageCodec codec,
+                                          const char *data,
+                                          size_t len,
+                                          string &compressData) {
+    size_t oldLen = compressData.size();
+    switch (codec) {
+    case MMC_LZ4: {
+        int bound = LZ4_compressBound((int)len);
+        if (bound <= 0) {
+            return false;
+        }
+        compressData.resize(oldLen + bound);
+        int compLen = LZ4_compress_default(data, &compressData[oldLen], (int)len, bound);
+        if (compLen <= 0) {
+            compressData.resize(oldLen);
+            return false;
+        }
+        compressData.resize(oldLen + compLen);
+        return true;
+    }
+    case MMC_ZSTD: {
+        static thread_local unique_ptr<ZSTD_CCtx, ZstdCCtxDeleter> cctx(ZSTD_createCCtx());
+        if (!cctx) {
+            return false;
+        }
+        size_t bound = ZSTD_compressBound(len);
+        compressData.resize(oldLen + bound);
+        size_t compLen =
+            ZSTD_compressCCtx(cctx.get(), &compressData[oldLen], bound, data, len, ZSTD_MERGED_MESSAGE_LEVEL);
+        if (ZSTD_isError(compLen)) {
+            compressData.resize(oldLen);
+            return false;
+        }
+        compressData.resize(oldLen + compLen);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool MessageCompressor::decompressBatchData(
+    MergedMessageCodec codec, const char *data, size_t len, size_t rawLen, string &uncompressData) {
+    size_t oldLen = uncompressData.size();
+    switch (codec) {
+    case MMC_LZ4: {
+        uncompressData.resize(oldLen + rawLen);
+        int ret = LZ4_decompress_safe(data, &uncompressData[oldLen], (int)len, (int)rawLen);
+        if (ret < 0 || (size_t)ret != rawLen) {
+            uncompressData.resize(oldLen);
+            return false;
+        }
+        uncompressData.resize(oldLen + ret);
+        return true;
+    }
+    case MMC_ZSTD: {
+        static thread_local unique_ptr<ZSTD_DCtx, ZstdDCtxDeleter> dctx(ZSTD_createDCtx());
+        if (!dctx) {
+            return false;
+        }
+        uncompressData.resize(oldLen + rawLen);
+        size_t ret = ZSTD_decompressDCtx(dctx.get(), &uncompressData[oldLen], rawLen, data, len);
+        if (ZSTD_isError(ret) || ret != rawLen) {
+            uncompressData.resize(oldLen);
+            return false;
+        }
+        uncompressData.resize(oldLen + ret);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+MergedMessageCodec MessageCompressor::parseMergedMessageCodec(const string &codecStr) {
+    if (codecStr.empty() || codecStr == "zlib") {
+        return MMC_ZLIB;
+    } else if (codecStr == "lz4") {
+        return MMC_LZ4;
+    } else if (codecStr == "zstd") {
+        return MMC_ZSTD;
+    }
+    return MMC_UNKNOWN;
+}
+
+const char *MessageCompressor::getMergedMessageCodecName(MergedMessageCodec codec) {
+    switch (codec) {
+    case MMC_ZLIB:
+        return "zlib";
+    case MMC_LZ4:
+        return "lz4";
+    case MMC_ZSTD:
+        return "zstd";
+    default:
+        return "unknown";
+    }
 }
 
 ErrorCode MessageCompressor::decompressMessageInfo(common::MessageInfo &msg, float &ratio) {
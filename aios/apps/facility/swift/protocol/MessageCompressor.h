@@ -54,6 +54,15 @@ protected:
     static autil::ZlibCompressor *createZlibCompressor() { return new autil::ZlibCompressor(Z_BEST_SPEED); }
 };
 
+// codec of the merged message body, zlib keeps the legacy layout [count][zlib body],
+// other codecs are layout [count][MERGED_CODEC_MAGIC][codec][raw len][body]
+enum MergedMessageCodec : uint8_t {
+    MMC_ZLIB = 0,
+    MMC_LZ4 = 1,
+    MMC_ZSTD = 2,
+    MMC_UNKNOWN = 255,
+};
+
 class MessageCompressor {
 public:
     MessageCompressor();
@@ -101,11 +110,26 @@ public:
                                       const char *data,
                                       size_t dataLen,
                                       std::string &compressData);
+    static bool compressMergedMessage(autil::ZlibCompressor *compressor,
+                                      MergedMessageCodec codec,
+                                      uint64_t compressThreshold,
+                                      const char *data,
+                                      size_t dataLen,
+                                      std::string &compressData);
+    // codec is detected from data, zlib compressor is only used for legacy layout
     static bool decompressMergedMessage(autil::ZlibCompressor *compressor,
                                         const char *data,
                                         size_t len,
                                         std::string &uncompressData);
 
+    static MergedMessageCodec parseMergedMessageCodec(const std::string &codecStr);
+    static const char *getMergedMessageCodecName(MergedMessageCodec codec);
+
+private:
+    static bool compressBatchData(MergedMessageCodec codec, const char *data, size_t len, std::string &compressData);
+    static bool decompressBatchData(
+        MergedMessageCodec codec, const char *data, size_t len, size_t rawLen, std::string &uncompressData);
+
 private:
     template <class T>
     static void compressMessage(T *type, uint64_t compressThreshold, float &ratio);
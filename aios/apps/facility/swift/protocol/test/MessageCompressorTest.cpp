@@ -3,6 +3,7 @@
 #include <iosfwd>
 #include <memory>
 #include <stdint.h>
+#include <string.h>
 #include <string>
 
 #include "autil/Singleton.h"
@@ -422,6 +423,58 @@ TEST_F(MessageCompressorTest, testMergedMessage) {
     ASSERT_EQ(data, uncompressData);
 }
 
+TEST_F(MessageCompressorTest, testMergedMessageWithCodec) {
+    ASSERT_EQ(MMC_ZLIB, MessageCompressor::parseMergedMessageCodec(""));
+    ASSERT_EQ(MMC_ZLIB, MessageCompressor::parseMergedMessageCodec("zlib"));
+    ASSERT_EQ(MMC_LZ4, MessageCompressor::parseMergedMessageCodec("lz4"));
+    ASSERT_EQ(MMC_ZSTD, MessageCompressor::parseMergedMessageCodec("zstd"));
+    ASSERT_EQ(MMC_UNKNOWN, MessageCompressor::parseMergedMessageCodec("snappy"));
+
+    string data(10000, 'a');
+    for (size_t i = 0; i < data.size(); i += 7) {
+        data[i] = 'a' + i % 26;
+    }
+    ZlibCompressor compressor;
+    for (auto codec : {MMC_ZLIB, MMC_LZ4, MMC_ZSTD}) {
+        string compressedData;
+        ASSERT_FALSE(
+            MessageCompressor::compressMergedMessage(&compressor, codec, 0, data.c_str(), 1, compressedData));
+        ASSERT_EQ(0, compressedData.size());
+        ASSERT_FALSE(MessageCompressor::compressMergedMessage(
+            &compressor, codec, 10000, data.c_str(), data.size(), compressedData));
+        ASSERT_EQ(0, compressedData.size());
+        ASSERT_TRUE(MessageCompressor::compressMergedMessage(
+            &compressor, codec, 0, data.c_str(), data.size(), compressedData));
+        ASSERT_TRUE(data.size() > compressedData.size());
+        // message count is kept uncompressed for the broker
+        ASSERT_EQ(0, memcmp(data.c_str(), compressedData.c_str(), sizeof(uint16_t)));
+
+        string uncompressData;
+        ASSERT_TRUE(MessageCompressor::decompressMergedMessage(
+            &compressor, compressedData.c_str(), compressedData.size(), uncompressData))
+            << MessageCompressor::getMergedMessageCodecName(codec);
+        ASSERT_EQ(data, uncompressData);
+
+        MessageInfo msgInfo;
+        msgInfo.compress = true;
+        msgInfo.isMerged = true;
+        msgInfo.data = compressedData;
+        float ratio = 0.0;
+        ASSERT_EQ(ERROR_NONE, MessageCompressor::decompressMessageInfo(msgInfo, ratio));
+        ASSERT_EQ(data, msgInfo.data);
+        ASSERT_FALSE(msgInfo.compress);
+    }
+    { // corrupted body
+        string compressedData;
+        ASSERT_TRUE(MessageCompressor::compressMergedMessage(
+            &compressor, MMC_ZSTD, 0, data.c_str(), data.size(), compressedData));
+        compressedData.resize(compressedData.size() / 2);
+        string uncompressData;
+        ASSERT_FALSE(MessageCompressor::decompressMergedMessage(
+            &compressor, compressedData.c_str(), compressedData.size(), uncompressData));
+    }
+}
+
 TEST_F(MessageCompressorTest, testDecompressMessageInfo) {
     string data(10000, 'a');
     ZlibCompressor compressor;
@@ -123,11 +123,18 @@ void MessageInfoUtil::mergeMessage(uint16_t hashId,
 }
 
 void MessageInfoUtil::compressMessage(autil::ZlibCompressor *compressor, uint64_t threashold, MessageInfo &msgInfo) {
+    compressMessage(compressor, MMC_ZLIB, threashold, msgInfo);
+}
+
+void MessageInfoUtil::compressMessage(autil::ZlibCompressor *compressor,
+                                      protocol::MergedMessageCodec mergedCodec,
+                                      uint64_t threashold,
+                                      MessageInfo &msgInfo) {
     if (compressor && !msgInfo.compress) {
         string compressedData;
         if (msgInfo.isMerged) {
             if (MessageCompressor::compressMergedMessage(
-                    compressor, threashold, msgInfo.data.c_str(), msgInfo.data.size(), compressedData)) {
+                    compressor, mergedCodec, threashold, msgInfo.data.c_str(), msgInfo.data.size(), compressedData)) {
                 msgInfo.compress = true;
                 msgInfo.data.swap(compressedData);
             }
@@ -28,6 +28,7 @@ namespace swift {
 namespace protocol {
 class WriteMessageInfo;
 class WriteMessageInfoVec;
+enum MergedMessageCodec : uint8_t;
 } // namespace protocol
 } // namespace swift
 
@@ -48,6 +49,11 @@ public:
                              common::MessageInfo &msgInfo);
 
     static void compressMessage(autil::ZlibCompressor *compressor, uint64_t threashold, common::MessageInfo &msgInfo);
+    // merged message is compressed by mergedCodec, single message is always compressed by zlib
+    static void compressMessage(autil::ZlibCompressor *compressor,
+                                protocol::MergedMessageCodec mergedCodec,
+                                uint64_t threashold,
+                                common::MessageInfo &msgInfo);
 
     static common::MessageInfo constructMsgInfo(const std::string &data,
                                                 int64_t checkpointId = -1,
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "future_lite/executors/LinuxAIOExecutor.h"
+
+#include <errno.h>
+#include <linux/aio_abi.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+namespace future_lite {
+
+namespace executors {
+
+FL_LOG_SETUP(future_lite, LinuxAIOExecutor);
+
+static constexpr long kMaxReapEvents = 256;
+static constexpr long kReapTimeoutNs = 100 * 1000 * 1000;
+
+struct LinuxAIOExecutor::Request {
+    AIOCallback callback;
+    struct iocb cb;
+    iovec singleIov;
+    std::vector<iovec> iovs;
+    const iovec *iovPtr = nullptr;
+    uint32_t iovCount = 0;
+};
+
+LinuxAIOExecutor::LinuxAIOExecutor() : _ctx(0), _inflight(0), _shutdown(false) {}
+
+LinuxAIOExecutor::~LinuxAIOExecutor() { destroy(); }
+
+bool LinuxAIOExecutor::init(uint32_t maxEvents) {
+    aio_context_t ctx = 0;
+    if (syscall(__NR_io_setup, maxEvents, &ctx) < 0) {
+        FL_LOG(WARN, "io_setup with [%u] events failed, errno [%d]", maxEvents, errno);
+        return false;
+    }
+    _ctx = ctx;
+    _reapThread = std::thread([this]() { reapLoop(); });
+    FL_LOG(INFO, "linux aio executor started, max events [%u]", maxEvents);
+    return true;
+}
+
+void LinuxAIOExecutor::destroy() {
+    if (_ctx == 0) {
+        return;
+    }
+    _shutdown = true;
+    if (_reapThread.joinable()) {
+        _reapThread.join();
+    }
+    syscall(__NR_io_destroy, _ctx);
+    _ctx = 0;
+}
+
+void LinuxAIOExecutor::submitIO(
+    int fd, iocb_cmd cmd, void *buffer, size_t length, off_t offset, AIOCallback cbfn) {
+    Request *request = new Request;
+    request->callback = std::move(cbfn);
+    request->singleIov.iov_base = buffer;
+    request->singleIov.iov_len = length;
+    request->iovPtr = &request->singleIov;
+    request->iovCount = 1;
+    submit(fd, cmd, request, offset);
+}
+
+void LinuxAIOExecutor::submitIOV(
+    int fd, iocb_cmd cmd, const iovec *iov, size_t count, off_t offset, AIOCallback cbfn) {
+    Request *request = new Request;
+    request->callback = std::move(cbfn);
+    request->iovs.assign(iov, iov + count);
+    request->iovPtr = request->iovs.data();
+    request->iovCount = count;
+    submit(fd, cmd, request, offset);
+}
+
+void LinuxAIOExecutor::submit(int fd, iocb_cmd cmd, Request *request, off_t offset) {
+    uint16_t opcode;
+    if (cmd == future_lite::IOCB_CMD_PREAD || cmd == future_lite::IOCB_CMD_PREADV) {
+        opcode = ::IOCB_CMD_PREADV;
+    } else if (cmd == future_lite::IOCB_CMD_PWRITE || cmd == future_lite::IOCB_CMD_PWRITEV) {
+        opcode = ::IOCB_CMD_PWRITEV;
+    } else {
+        request->callback(-EINVAL);
+        delete request;
+        return;
+    }
+    memset(&request->cb, 0, sizeof(request->cb));
+    request->cb.aio_fildes = fd;
+    request->cb.aio_lio_opcode = opcode;
+    request->cb.aio_buf = reinterpret_cast<uint64_t>(request->iovPtr);
+    request->cb.aio_nbytes = request->iovCount;
+    request->cb.aio_offset = offset;
+    request->cb.aio_data = reinterpret_cast<uint64_t>(request);
+    struct iocb *cbs[1] = {&request->cb};
+    _inflight.fetch_add(1, std::memory_order_relaxed);
+    while (true) {
+        long ret = syscall(__NR_io_submit, _ctx, 1, cbs);
+        if (ret == 1) {
+            return;
+        }
+        int err = ret < 0 ? errno : EAGAIN;
+        if (err == EAGAIN || err == EINTR) {
+            // aio context is full, wait for reap thread to free some slots
+            std::this_thread::yield();
+            continue;
+        }
+        _inflight.fetch_sub(1, std::memory_order_relaxed);
+        request->callback(-err);
+        delete request;
+        return;
+    }
+}
+
+void LinuxAIOExecutor::reapLoop() {
+    std::vector<struct io_event> events(kMaxReapEvents);
+    while (!_shutdown || _inflight.load(std::memory_order_relaxed) > 0) {
+        struct timespec timeout = {0, kReapTimeoutNs};
+        long ret = syscall(__NR_io_getevents, _ctx, 1, kMaxReapEvents, events.data(), &timeout);
+        if (ret < 0) {
+            if (errno != EINTR) {
+                FL_LOG(ERROR, "io_getevents failed, errno [%d]", errno);
+                usleep(1000);
+            }
+            continue;
+        }
+        for (long i = 0; i < ret; ++i) {
+            Request *request = reinterpret_cast<Request *>(events[i].data);
+            request->callback(static_cast<int32_t>(events[i].res));
+            delete request;
+            _inflight.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace executors
+
+} // namespace future_lite
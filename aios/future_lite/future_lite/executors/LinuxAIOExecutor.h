@@ -0,0 +1,69 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FUTURE_LINUX_AIO_EXECUTOR_H
+#define FUTURE_LINUX_AIO_EXECUTOR_H
+
+#include <atomic>
+#include <stdint.h>
+#include <thread>
+
+#include "future_lite/IOExecutor.h"
+#include "future_lite/Log.h"
+
+namespace future_lite {
+
+namespace executors {
+
+// IOExecutor on linux native aio (io_submit/io_getevents), used when io_uring is unavailable.
+// ios are only truly asynchronous for files opened with O_DIRECT.
+class LinuxAIOExecutor : public IOExecutor {
+public:
+    LinuxAIOExecutor();
+    ~LinuxAIOExecutor() override;
+
+    LinuxAIOExecutor(const LinuxAIOExecutor &) = delete;
+    LinuxAIOExecutor &operator=(const LinuxAIOExecutor &) = delete;
+
+public:
+    bool init(uint32_t maxEvents);
+    void destroy();
+
+public:
+    void submitIO(int fd, iocb_cmd cmd, void *buffer, size_t length, off_t offset, AIOCallback cbfn) override;
+    void submitIOV(int fd, iocb_cmd cmd, const iovec *iov, size_t count, off_t offset, AIOCallback cbfn) override;
+
+private:
+    struct Request;
+
+    void submit(int fd, iocb_cmd cmd, Request *request, off_t offset);
+    void reapLoop();
+
+private:
+    // aio_context_t
+    unsigned long _ctx;
+    std::atomic<int64_t> _inflight;
+    std::atomic<bool> _shutdown;
+    std::thread _reapThread;
+
+private:
+    FL_LOG_DECLARE();
+};
+
+} // namespace executors
+
+} // namespace future_lite
+
+#endif // FUTURE_LINUX_AIO_EXECUTOR_H
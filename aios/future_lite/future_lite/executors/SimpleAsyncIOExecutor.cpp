@@ -13,10 +13,64 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "future_lite/executors/LinuxAIOExecutor.h"
 #include "future_lite/executors/SimpleExecutor.h"
+#include "future_lite/executors/UringIOExecutor.h"
+
+namespace future_lite {
+
+namespace executors {
+
+// SimpleExecutor whose ios can go to io_uring or linux aio instead of posix aio.
+// backend is one of posix|uring|aio, default posix. uring falls back to aio, and aio falls back to posix,
+// when the kernel does not support it.
+class SimpleAsyncIOExecutor : public SimpleExecutor {
+public:
+    SimpleAsyncIOExecutor(size_t threadNum, uint32_t ioDepth, std::string backend) : SimpleExecutor(threadNum) {
+        if (backend == "uring") {
+            auto uringExecutor = std::make_unique<UringIOExecutor>();
+            if (uringExecutor->init(ioDepth)) {
+                _nativeIOExecutor = std::move(uringExecutor);
+                return;
+            }
+            backend = "aio";
+        }
+        if (backend == "aio") {
+            auto aioExecutor = std::make_unique<LinuxAIOExecutor>();
+            if (aioExecutor->init(ioDepth * kAioEventsFactor)) {
+                _nativeIOExecutor = std::move(aioExecutor);
+            }
+        }
+    }
+    ~SimpleAsyncIOExecutor() {
+        // drain native ios before worker threads of SimpleExecutor go away
+        _nativeIOExecutor.reset();
+    }
+
+public:
+    IOExecutor *getIOExecutor() override {
+        return _nativeIOExecutor ? _nativeIOExecutor.get() : SimpleExecutor::getIOExecutor();
+    }
+
+private:
+    static constexpr uint32_t kAioEventsFactor = 8;
+    std::unique_ptr<IOExecutor> _nativeIOExecutor;
+};
+
+} // namespace executors
+
+} // namespace future_lite
 
 REGISTER_FUTURE_LITE_EXECUTOR(async_io) {
     auto threadNum = params.GetThreadNum();
-    return std::make_unique<future_lite::executors::SimpleExecutor>(threadNum.value_or(/*defaultValue*/ 1));
+    // max_aio is the submission queue depth, completion side holds several times more outstanding ios
+    auto maxAio = params.Get<uint32_t>("max_aio");
+    uint32_t ioDepth = std::max<uint32_t>(maxAio.value_or(/*defaultValue*/ 256), 64);
+    auto ioBackend = params.Get<std::string>("io_backend");
+    return std::make_unique<future_lite::executors::SimpleAsyncIOExecutor>(
+        threadNum.value_or(/*defaultValue*/ 1), ioDepth, ioBackend.value_or(/*defaultValue*/ "posix"));
 }
-
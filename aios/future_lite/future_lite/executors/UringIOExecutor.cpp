@@ -0,0 +1,387 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "future_lite/executors/UringIOExecutor.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define FUTURE_LITE_HAS_IO_URING 1
+#endif
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+
+namespace future_lite {
+
+namespace executors {
+
+FL_LOG_SETUP(future_lite, UringIOExecutor);
+
+struct UringIOExecutor::Request {
+    AIOCallback callback;
+    int fd = -1;
+    uint8_t opcode = 0;
+    off_t offset = 0;
+    iovec singleIov;
+    std::vector<iovec> iovs;
+    const iovec *iovPtr = nullptr;
+    uint32_t iovCount = 0;
+};
+
+UringIOExecutor::UringIOExecutor()
+    : _ringFd(-1)
+    , _sqRing(MAP_FAILED)
+    , _sqRingSize(0)
+    , _cqRing(MAP_FAILED)
+    , _cqRingSize(0)
+    , _sqes(MAP_FAILED)
+    , _sqesSize(0)
+    , _sqHead(nullptr)
+    , _sqTail(nullptr)
+    , _sqRingMask(nullptr)
+    , _sqRingEntries(nullptr)
+    , _sqArray(nullptr)
+    , _cqHead(nullptr)
+    , _cqTail(nullptr)
+    , _cqRingMask(nullptr)
+    , _cqes(nullptr)
+    , _maxInflight(0)
+    , _sqLocalTail(0)
+    , _inflight(0)
+    , _shutdown(false) {}
+
+UringIOExecutor::~UringIOExecutor() { destroy(); }
+
+#ifdef FUTURE_LITE_HAS_IO_URING
+
+static constexpr uint32_t kCqEntriesFactor = 8;
+// the executor whose reap thread is the current thread, callbacks submitting ios run there
+static thread_local UringIOExecutor *tlsReapingExecutor = nullptr;
+
+bool UringIOExecutor::init(uint32_t entries) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    // a larger completion ring lets many more ios be outstanding than sqes can be queued at once
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = entries * kCqEntriesFactor;
+    int fd = syscall(__NR_io_uring_setup, entries, &params);
+    if (fd < 0 && errno == EINVAL) {
+        memset(&params, 0, sizeof(params));
+        fd = syscall(__NR_io_uring_setup, entries, &params);
+    }
+    if (fd < 0) {
+        FL_LOG(WARN, "io_uring_setup with [%u] entries failed, errno [%d]", entries, errno);
+        return false;
+    }
+    _ringFd = fd;
+    _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) {
+        _sqRingSize = std::max(_sqRingSize, _cqRingSize);
+        _cqRingSize = _sqRingSize;
+    }
+    _sqRing = mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (_sqRing == MAP_FAILED) {
+        FL_LOG(WARN, "mmap io_uring sq ring failed, errno [%d]", errno);
+        unmapRings();
+        return false;
+    }
+    if (singleMmap) {
+        _cqRing = _sqRing;
+    } else {
+        _cqRing =
+            mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (_cqRing == MAP_FAILED) {
+            FL_LOG(WARN, "mmap io_uring cq ring failed, errno [%d]", errno);
+            unmapRings();
+            return false;
+        }
+    }
+    _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    _sqes = mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (_sqes == MAP_FAILED) {
+        FL_LOG(WARN, "mmap io_uring sqes failed, errno [%d]", errno);
+        unmapRings();
+        return false;
+    }
+    char *sq = static_cast<char *>(_sqRing);
+    _sqHead = reinterpret_cast<uint32_t *>(sq + params.sq_off.head);
+    _sqTail = reinterpret_cast<uint32_t *>(sq + params.sq_off.tail);
+    _sqRingMask = reinterpret_cast<uint32_t *>(sq + params.sq_off.ring_mask);
+    _sqRingEntries = reinterpret_cast<uint32_t *>(sq + params.sq_off.ring_entries);
+    _sqArray = reinterpret_cast<uint32_t *>(sq + params.sq_off.array);
+    char *cq = static_cast<char *>(_cqRing);
+    _cqHead = reinterpret_cast<uint32_t *>(cq + params.cq_off.head);
+    _cqTail = reinterpret_cast<uint32_t *>(cq + params.cq_off.tail);
+    _cqRingMask = reinterpret_cast<uint32_t *>(cq + params.cq_off.ring_mask);
+    _cqes = cq + params.cq_off.cqes;
+    _sqLocalTail = *_sqTail;
+    _maxInflight = (params.features & IORING_FEAT_NODROP) ? INT64_MAX : params.cq_entries;
+
+    _reapThread = std::thread([this]() { reapLoop(); });
+    FL_LOG(INFO,
+           "io_uring executor started, sq entries [%u], cq entries [%u], features [%u]",
+           params.sq_entries,
+           params.cq_entries,
+           params.features);
+    return true;
+}
+
+void UringIOExecutor::destroy() {
+    if (_ringFd < 0) {
+        return;
+    }
+    if (_reapThread.joinable()) {
+        _shutdown = true;
+        // nop without request wakes up reap thread blocked in io_uring_enter
+        submit(-1, IORING_OP_NOP, nullptr, 0);
+        _reapThread.join();
+    }
+    unmapRings();
+}
+
+void UringIOExecutor::unmapRings() {
+    if (_sqes != MAP_FAILED) {
+        munmap(_sqes, _sqesSize);
+        _sqes = MAP_FAILED;
+    }
+    if (_cqRing != MAP_FAILED && _cqRing != _sqRing) {
+        munmap(_cqRing, _cqRingSize);
+    }
+    _cqRing = MAP_FAILED;
+    if (_sqRing != MAP_FAILED) {
+        munmap(_sqRing, _sqRingSize);
+        _sqRing = MAP_FAILED;
+    }
+    if (_ringFd >= 0) {
+        close(_ringFd);
+        _ringFd = -1;
+    }
+}
+
+int UringIOExecutor::enter(uint32_t toSubmit, uint32_t minComplete, uint32_t flags) {
+    int ret = syscall(__NR_io_uring_enter, _ringFd, toSubmit, minComplete, flags, nullptr, 0);
+    return ret < 0 ? -errno : ret;
+}
+
+void UringIOExecutor::submitIO(
+    int fd, iocb_cmd cmd, void *buffer, size_t length, off_t offset, AIOCallback cbfn) {
+    uint8_t opcode;
+    if (cmd == IOCB_CMD_PREAD) {
+        opcode = IORING_OP_READV;
+    } else if (cmd == IOCB_CMD_PWRITE) {
+        opcode = IORING_OP_WRITEV;
+    } else {
+        cbfn(-EINVAL);
+        return;
+    }
+    Request *request = new Request;
+    request->callback = std::move(cbfn);
+    request->singleIov.iov_base = buffer;
+    request->singleIov.iov_len = length;
+    request->iovPtr = &request->singleIov;
+    request->iovCount = 1;
+    submit(fd, opcode, request, offset);
+}
+
+void UringIOExecutor::submitIOV(
+    int fd, iocb_cmd cmd, const iovec *iov, size_t count, off_t offset, AIOCallback cbfn) {
+    uint8_t opcode;
+    if (cmd == IOCB_CMD_PREADV || cmd == IOCB_CMD_PREAD) {
+        opcode = IORING_OP_READV;
+    } else if (cmd == IOCB_CMD_PWRITEV || cmd == IOCB_CMD_PWRITE) {
+        opcode = IORING_OP_WRITEV;
+    } else {
+        cbfn(-EINVAL);
+        return;
+    }
+    Request *request = new Request;
+    request->callback = std::move(cbfn);
+    // caller's iovec array may go away before kernel picks up the sqe
+    request->iovs.assign(iov, iov + count);
+    request->iovPtr = request->iovs.data();
+    request->iovCount = count;
+    submit(fd, opcode, request, offset);
+}
+
+void UringIOExecutor::submit(int fd, uint8_t opcode, Request *request, off_t offset) {
+    if (request) {
+        request->fd = fd;
+        request->opcode = opcode;
+        request->offset = offset;
+    }
+    if (request && tlsReapingExecutor == this) {
+        // waiting for inflight ios on reap thread never ends, as nobody else reaps their completions
+        if (!_deferred.empty() || !queueSqe(fd, opcode, request, offset, /*waitInflight*/ false)) {
+            _deferred.push_back(request);
+        }
+        return;
+    }
+    queueSqe(fd, opcode, request, offset, /*waitInflight*/ true);
+}
+
+bool UringIOExecutor::queueSqe(int fd, uint8_t opcode, Request *request, off_t offset, bool waitInflight) {
+    std::unique_lock<std::mutex> lock(_submitMutex);
+    while (true) {
+        uint32_t head = __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+        bool sqFull = _sqLocalTail - head >= *_sqRingEntries;
+        bool tooManyInflight = request && _inflight.load(std::memory_order_relaxed) >= _maxInflight;
+        if (!sqFull && !tooManyInflight) {
+            break;
+        }
+        if (tooManyInflight && !waitInflight) {
+            return false;
+        }
+        if (sqFull) {
+            enter(_sqLocalTail - head, 0, 0);
+        }
+        lock.unlock();
+        std::this_thread::yield();
+        lock.lock();
+    }
+    uint32_t index = _sqLocalTail & *_sqRingMask;
+    io_uring_sqe *sqe = static_cast<io_uring_sqe *>(_sqes) + index;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->off = offset;
+    if (request) {
+        sqe->addr = reinterpret_cast<uint64_t>(request->iovPtr);
+        sqe->len = request->iovCount;
+        _inflight.fetch_add(1, std::memory_order_relaxed);
+    }
+    sqe->user_data = reinterpret_cast<uint64_t>(request);
+    _sqArray[index] = index;
+    ++_sqLocalTail;
+    __atomic_store_n(_sqTail, _sqLocalTail, __ATOMIC_RELEASE);
+    lock.unlock();
+
+    // sqes queued by concurrent submitters meanwhile are handed to kernel by the same call
+    uint32_t toSubmit = __atomic_load_n(_sqTail, __ATOMIC_ACQUIRE) - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+    if (toSubmit > 0) {
+        int ret = enter(toSubmit, 0, 0);
+        if (ret < 0 && ret != -EAGAIN && ret != -EBUSY && ret != -EINTR) {
+            // sqes stay in ring and are submitted again by reap thread
+            FL_LOG(WARN, "io_uring_enter submit failed, ret [%d]", ret);
+        }
+    }
+    return true;
+}
+
+void UringIOExecutor::submitDeferred() {
+    while (!_deferred.empty()) {
+        Request *request = _deferred.front();
+        if (!queueSqe(request->fd, request->opcode, request, request->offset, /*waitInflight*/ false)) {
+            break;
+        }
+        _deferred.pop_front();
+    }
+}
+
+uint32_t UringIOExecutor::reapCompletions() {
+    uint32_t head = *_cqHead;
+    uint32_t tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+    uint32_t count = 0;
+    io_uring_cqe *cqes = static_cast<io_uring_cqe *>(_cqes);
+    while (head != tail) {
+        io_uring_cqe *cqe = cqes + (head & *_cqRingMask);
+        Request *request = reinterpret_cast<Request *>(cqe->user_data);
+        int32_t res = cqe->res;
+        ++head;
+        // release the slot before running callback, which may submit new ios
+        __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+        if (request) {
+            request->callback(res);
+            delete request;
+            _inflight.fetch_sub(1, std::memory_order_relaxed);
+        }
+        ++count;
+        if (head == tail) {
+            tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+        }
+    }
+    return count;
+}
+
+void UringIOExecutor::reapLoop() {
+    tlsReapingExecutor = this;
+    while (true) {
+        reapCompletions();
+        submitDeferred();
+        if (_shutdown && _inflight.load(std::memory_order_relaxed) == 0 && _deferred.empty()) {
+            break;
+        }
+        uint32_t toSubmit = __atomic_load_n(_sqTail, __ATOMIC_ACQUIRE) - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+        int ret = enter(toSubmit, 1, IORING_ENTER_GETEVENTS);
+        if (ret < 0 && ret != -EINTR && ret != -EAGAIN && ret != -EBUSY && ret != -ETIME) {
+            FL_LOG(ERROR, "io_uring_enter wait failed, ret [%d]", ret);
+            usleep(1000);
+        }
+    }
+}
+
+#else
+
+bool UringIOExecutor::init(uint32_t entries) {
+    FL_LOG(WARN, "io_uring is not supported by kernel headers");
+    return false;
+}
+
+void UringIOExecutor::destroy() {}
+
+void UringIOExecutor::unmapRings() {}
+
+int UringIOExecutor::enter(uint32_t toSubmit, uint32_t minComplete, uint32_t flags) { return -ENOSYS; }
+
+void UringIOExecutor::submitIO(
+    int fd, iocb_cmd cmd, void *buffer, size_t length, off_t offset, AIOCallback cbfn) {
+    cbfn(-ENOSYS);
+}
+
+void UringIOExecutor::submitIOV(
+    int fd, iocb_cmd cmd, const iovec *iov, size_t count, off_t offset, AIOCallback cbfn) {
+    cbfn(-ENOSYS);
+}
+
+void UringIOExecutor::submit(int fd, uint8_t opcode, Request *request, off_t offset) {}
+
+bool UringIOExecutor::queueSqe(int fd, uint8_t opcode, Request *request, off_t offset, bool waitInflight) {
+    return false;
+}
+
+void UringIOExecutor::submitDeferred() {}
+
+uint32_t UringIOExecutor::reapCompletions() { return 0; }
+
+void UringIOExecutor::reapLoop() {}
+
+#endif
+
+} // namespace executors
+
+} // namespace future_lite
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FUTURE_URING_IO_EXECUTOR_H
+#define FUTURE_URING_IO_EXECUTOR_H
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+
+#include "future_lite/IOExecutor.h"
+#include "future_lite/Log.h"
+
+namespace future_lite {
+
+namespace executors {
+
+// IOExecutor on io_uring. Submitters queue sqes under a lock and one io_uring_enter hands every pending
+// sqe to kernel, a single reap thread waits for completions and runs callbacks. Outstanding ios do not
+// occupy any thread, so queue depth is only bounded by the completion ring. Ios submitted by callbacks
+// while inflight ios are capped are deferred and submitted by the reap thread once completions free slots.
+class UringIOExecutor : public IOExecutor {
+public:
+    UringIOExecutor();
+    ~UringIOExecutor() override;
+
+    UringIOExecutor(const UringIOExecutor &) = delete;
+    UringIOExecutor &operator=(const UringIOExecutor &) = delete;
+
+public:
+    // return false if io_uring is not supported by kernel or forbidden by seccomp
+    bool init(uint32_t entries);
+    void destroy();
+
+public:
+    void submitIO(int fd, iocb_cmd cmd, void *buffer, size_t length, off_t offset, AIOCallback cbfn) override;
+    void submitIOV(int fd, iocb_cmd cmd, const iovec *iov, size_t count, off_t offset, AIOCallback cbfn) override;
+
+private:
+    struct Request;
+
+    void submit(int fd, uint8_t opcode, Request *request, off_t offset);
+    // return false without queueing if inflight ios are capped and waitInflight is false
+    bool queueSqe(int fd, uint8_t opcode, Request *request, off_t offset, bool waitInflight);
+    void submitDeferred();
+    void reapLoop();
+    uint32_t reapCompletions();
+    int enter(uint32_t toSubmit, uint32_t minComplete, uint32_t flags);
+    void unmapRings();
+
+private:
+    int _ringFd;
+    void *_sqRing;
+    size_t _sqRingSize;
+    void *_cqRing;
+    size_t _cqRingSize;
+    void *_sqes;
+    size_t _sqesSize;
+    uint32_t *_sqHead;
+    uint32_t *_sqTail;
+    uint32_t *_sqRingMask;
+    uint32_t *_sqRingEntries;
+    uint32_t *_sqArray;
+    uint32_t *_cqHead;
+    uint32_t *_cqTail;
+    uint32_t *_cqRingMask;
+    void *_cqes;
+    // without IORING_FEAT_NODROP completions beyond cq size are lost, so inflight ios are capped
+    int64_t _maxInflight;
+
+    std::mutex _submitMutex;
+    uint32_t _sqLocalTail;
+    std::atomic<int64_t> _inflight;
+    std::atomic<bool> _shutdown;
+    std::thread _reapThread;
+    // ios submitted on reap thread while inflight ios are capped, only touched by reap thread
+    std::deque<Request *> _deferred;
+
+private:
+    FL_LOG_DECLARE();
+};
+
+} // namespace executors
+
+} // namespace future_lite
+
+#endif // FUTURE_URING_IO_EXECUTOR_H
@@ -0,0 +1,198 @@
+#include <atomic>
+#include <chrono>
+#include <errno.h>
+#include <fcntl.h>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "future_lite/executors/LinuxAIOExecutor.h"
+#include "future_lite/executors/UringIOExecutor.h"
+#include "unittest/unittest.h"
+
+namespace future_lite {
+
+namespace executors {
+
+class NativeIOExecutorTest : public TESTBASE {
+public:
+    void setUp() override {
+        _filePath = GET_TEMP_DATA_PATH() + "/native_io_data";
+        _fd = ::open(_filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        ASSERT_LE(0, _fd);
+    }
+    void tearDown() override {
+        if (_fd >= 0) {
+            ::close(_fd);
+        }
+    }
+
+protected:
+    // io_uring may be unsupported by kernel or forbidden by seccomp, only run the backends available here
+    std::vector<std::pair<std::string, std::function<std::unique_ptr<IOExecutor>()>>> getExecutorFactories() {
+        std::vector<std::pair<std::string, std::function<std::unique_ptr<IOExecutor>()>>> factories;
+        if (UringIOExecutor().init(kIODepth)) {
+            factories.emplace_back("uring", []() {
+                auto executor = std::make_unique<UringIOExecutor>();
+                EXPECT_TRUE(executor->init(kIODepth));
+                return std::unique_ptr<IOExecutor>(std::move(executor));
+            });
+        }
+        if (LinuxAIOExecutor().init(kIODepth)) {
+            factories.emplace_back("aio", []() {
+                auto executor = std::make_unique<LinuxAIOExecutor>();
+                EXPECT_TRUE(executor->init(kIODepth));
+                return std::unique_ptr<IOExecutor>(std::move(executor));
+            });
+        }
+        return factories;
+    }
+    int32_t submitIOAndWait(IOExecutor *executor, iocb_cmd cmd, void *buffer, size_t length, off_t offset) {
+        std::promise<int32_t> promise;
+        executor->submitIO(_fd, cmd, buffer, length, offset, [&promise](int32_t res) { promise.set_value(res); });
+        return promise.get_future().get();
+    }
+    int32_t submitIOVAndWait(IOExecutor *executor, iocb_cmd cmd, const std::vector<iovec> &iovs, off_t offset) {
+        std::promise<int32_t> promise;
+        executor->submitIOV(
+            _fd, cmd, iovs.data(), iovs.size(), offset, [&promise](int32_t res) { promise.set_value(res); });
+        return promise.get_future().get();
+    }
+
+protected:
+    static constexpr uint32_t kIODepth = 64;
+    std::string _filePath;
+    int _fd = -1;
+};
+
+TEST_F(NativeIOExecutorTest, testReadWrite) {
+    for (const auto &[name, factory] : getExecutorFactories()) {
+        SCOPED_TRACE(name);
+        ASSERT_EQ(0, ::ftruncate(_fd, 0));
+        auto executor = factory();
+        std::string data(8192, 'a');
+        ASSERT_EQ(8192, submitIOAndWait(executor.get(), IOCB_CMD_PWRITE, data.data(), data.size(), 0));
+        std::string buffer(4096, '\0');
+        ASSERT_EQ(4096, submitIOAndWait(executor.get(), IOCB_CMD_PREAD, buffer.data(), buffer.size(), 4096));
+        ASSERT_EQ(std::string(4096, 'a'), buffer);
+
+        std::string head(100, 'h');
+        std::string tail(200, 't');
+        std::vector<iovec> writeIovs = {{head.data(), head.size()}, {tail.data(), tail.size()}};
+        ASSERT_EQ(300, submitIOVAndWait(executor.get(), IOCB_CMD_PWRITEV, writeIovs, 1000));
+        std::string first(150, '\0');
+        std::string second(150, '\0');
+        std::vector<iovec> readIovs = {{first.data(), first.size()}, {second.data(), second.size()}};
+        ASSERT_EQ(300, submitIOVAndWait(executor.get(), IOCB_CMD_PREADV, readIovs, 1000));
+        ASSERT_EQ(std::string(100, 'h') + std::string(50, 't'), first);
+        ASSERT_EQ(std::string(150, 't'), second);
+    }
+}
+
+TEST_F(NativeIOExecutorTest, testShortRead) {
+    std::string data(100, 'd');
+    ASSERT_EQ(100, ::pwrite(_fd, data.data(), data.size(), 0));
+    for (const auto &[name, factory] : getExecutorFactories()) {
+        SCOPED_TRACE(name);
+        auto executor = factory();
+        std::string buffer(4096, '\0');
+        ASSERT_EQ(100, submitIOAndWait(executor.get(), IOCB_CMD_PREAD, buffer.data(), buffer.size(), 0));
+        ASSERT_EQ(data, buffer.substr(0, 100));
+        ASSERT_EQ(40, submitIOAndWait(executor.get(), IOCB_CMD_PREAD, buffer.data(), buffer.size(), 60));
+        // read from end of file
+        ASSERT_EQ(0, submitIOAndWait(executor.get(), IOCB_CMD_PREAD, buffer.data(), buffer.size(), 4096));
+    }
+}
+
+TEST_F(NativeIOExecutorTest, testErrorCompletion) {
+    for (const auto &[name, factory] : getExecutorFactories()) {
+        SCOPED_TRACE(name);
+        auto executor = factory();
+        std::string buffer(4096, '\0');
+        int fd = ::dup(_fd);
+        ASSERT_LE(0, fd);
+        ::close(fd);
+        std::promise<int32_t> promise;
+        executor->submitIO(fd, IOCB_CMD_PREAD, buffer.data(), buffer.size(), 0, [&promise](int32_t res) {
+            promise.set_value(res);
+        });
+        ASSERT_EQ(-EBADF, promise.get_future().get());
+
+        // the executor keeps working after a failed io
+        ASSERT_EQ(0, submitIOAndWait(executor.get(), IOCB_CMD_PREAD, buffer.data(), buffer.size(), 0));
+    }
+}
+
+TEST_F(NativeIOExecutorTest, testShutdownWithInflightIO) {
+    constexpr size_t kIOCount = 2000;
+    constexpr size_t kIOSize = 4096;
+    std::string data(kIOSize * 16, 'x');
+    ASSERT_EQ((ssize_t)data.size(), ::pwrite(_fd, data.data(), data.size(), 0));
+    for (const auto &[name, factory] : getExecutorFactories()) {
+        SCOPED_TRACE(name);
+        std::vector<std::string> buffers(kIOCount, std::string(kIOSize, '\0'));
+        std::atomic<size_t> doneCount(0);
+        std::atomic<size_t> failCount(0);
+        {
+            auto executor = factory();
+            for (size_t i = 0; i < kIOCount; ++i) {
+                executor->submitIO(
+                    _fd, IOCB_CMD_PREAD, buffers[i].data(), kIOSize, (i % 16) * kIOSize, [&, i](int32_t res) {
+                        if (res != (int32_t)kIOSize || buffers[i] != std::string(kIOSize, 'x')) {
+                            ++failCount;
+                        }
+                        ++doneCount;
+                    });
+            }
+            // destroying the executor waits for every submitted io, buffers must not be touched afterwards
+        }
+        ASSERT_EQ(kIOCount, doneCount.load());
+        ASSERT_EQ(0u, failCount.load());
+    }
+}
+
+TEST_F(NativeIOExecutorTest, testSubmitFromCallbackAtFullInflight) {
+    auto executor = std::make_unique<UringIOExecutor>();
+    if (!executor->init(kIODepth)) {
+        return;
+    }
+    // as without IORING_FEAT_NODROP, inflight ios are capped
+    executor->_maxInflight = 2;
+    constexpr size_t kIOCount = 200;
+    std::string data(4096, 'c');
+    ASSERT_EQ((ssize_t)data.size(), ::pwrite(_fd, data.data(), data.size(), 0));
+    std::vector<std::string> buffers(kIOCount, std::string(data.size(), '\0'));
+    std::atomic<size_t> submitCount(0);
+    std::atomic<size_t> failCount(0);
+    std::promise<void> allDone;
+    std::atomic<size_t> doneCount(0);
+    std::function<void()> submitOne = [&]() {
+        size_t i = submitCount++;
+        if (i >= kIOCount) {
+            return;
+        }
+        executor->submitIO(_fd, IOCB_CMD_PREAD, buffers[i].data(), data.size(), 0, [&, i](int32_t res) {
+            if (res != (int32_t)data.size() || buffers[i] != data) {
+                ++failCount;
+            }
+            // the completing io still counts as inflight, so each callback submits at full inflight
+            submitOne();
+            submitOne();
+            if (++doneCount == kIOCount) {
+                allDone.set_value();
+            }
+        });
+    };
+    submitOne();
+    submitOne();
+    ASSERT_EQ(std::future_status::ready, allDone.get_future().wait_for(std::chrono::seconds(30)));
+    executor.reset();
+    ASSERT_EQ(0u, failCount.load());
+}
+
+} // namespace executors
+
+} // namespace future_lite
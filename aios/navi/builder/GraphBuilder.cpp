@@ -148,6 +148,13 @@ GraphBuilder &GraphBuilder::inlineMode(bool inlineMode) {
     return *this;
 }
 
+GraphBuilder &GraphBuilder::fuseLinearChain(bool fuse) {
+    auto graphBuildInfo = getGraphBuildInfo(_graphId);
+    assert(graphBuildInfo);
+    graphBuildInfo->fuseLinearChain(fuse);
+    return *this;
+}
+
 GraphBuilder &GraphBuilder::errorHandleStrategy(ErrorHandleStrategy strategy) {
     auto graphBuildInfo = getGraphBuildInfo(_graphId);
     assert(graphBuildInfo);
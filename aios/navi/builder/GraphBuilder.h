@@ -52,6 +52,7 @@ public:
     GraphBuilder &gigTag(const std::string &tag, multi_call::TagMatchType type);
     GraphBuilder &subGraph(GraphId graphId);
     GraphBuilder &inlineMode(bool inlineMode);
+    GraphBuilder &fuseLinearChain(bool fuse);
     GraphBuilder &errorHandleStrategy(ErrorHandleStrategy strategy);
     GraphBuilder &subGraphAttr(const std::string &key, std::string value);
     GraphBuilder &ignoreIsolate(bool ignoreIsolate);
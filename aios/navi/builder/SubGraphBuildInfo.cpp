@@ -89,6 +89,10 @@ void SubGraphBuildInfo::inlineMode(bool inlineMode) {
     _subGraphDef->mutable_option()->set_inline_mode(inlineMode);
 }
 
+void SubGraphBuildInfo::fuseLinearChain(bool fuse) {
+    _subGraphDef->mutable_option()->set_fuse_linear_chain(fuse);
+}
+
 void SubGraphBuildInfo::errorHandleStrategy(ErrorHandleStrategy strategy) {
     _subGraphDef->mutable_option()->set_error_handle_strategy(strategy);
 }
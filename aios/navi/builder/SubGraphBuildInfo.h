@@ -36,6 +36,7 @@ public:
     void gigTag(const std::string &tag, multi_call::TagMatchType type);
     void subGraphAttr(const std::string &key, std::string &&value);
     void inlineMode(bool inlineMode);
+    void fuseLinearChain(bool fuse);
     void errorHandleStrategy(ErrorHandleStrategy strategy);
     void ignoreIsolate(bool ignoreIsolate);
     void replaceR(const std::string &from, const std::string &to);
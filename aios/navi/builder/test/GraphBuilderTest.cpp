@@ -36,6 +36,20 @@ TEST_F(GraphBuilderTest, testSimple) {
     std::cout << def->DebugString() << endl;
 }
 
+TEST_F(GraphBuilderTest, testFuseLinearChain) {
+    std::unique_ptr<GraphDef> def(new GraphDef());
+    GraphBuilder builder(def.get());
+    builder.newSubGraph("biz1");
+    builder.node("node1").kernel("kernel1");
+    builder.newSubGraph("biz2");
+    builder.fuseLinearChain(true);
+    builder.node("node2").kernel("kernel2");
+    ASSERT_TRUE(builder.ok());
+    ASSERT_EQ(2, def->sub_graphs_size());
+    ASSERT_FALSE(def->sub_graphs(0).option().fuse_linear_chain());
+    ASSERT_TRUE(def->sub_graphs(1).option().fuse_linear_chain());
+}
+
 TEST_F(GraphBuilderTest, testMultiSubGraph) {
     std::unique_ptr<GraphDef> def(new GraphDef());
     GraphBuilder builder(def.get());
@@ -418,6 +418,14 @@ enum RegistryType : int32_t {
     RT_MAX = 3,
 };
 
+// session priority class in task queue, zero is the default
+enum TaskPriority : int32_t {
+    TP_NORMAL = 0,
+    TP_HIGH = 1,
+    TP_LOW = 2,
+    TP_COUNT = 3,
+};
+
 template <int N>
 class DependMatcher {
 public:
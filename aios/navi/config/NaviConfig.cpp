@@ -51,6 +51,10 @@ ConcurrencyConfig::ConcurrencyConfig()
     , maxThreadNum(DEFAULT_THREAD_NUMBER)
     , queueSize(DEFAULT_QUEUE_SIZE)
     , processingSize(DEFAULT_PROCESSING_SIZE)
+    , workStealing(false)
+    , numaBind(true)
+    , prioritySchedule(false)
+    , shedExpired(false)
 {}
 
 ConcurrencyConfig::ConcurrencyConfig(int threadNum_, size_t queueSize_, size_t processingSize_)
@@ -59,6 +63,10 @@ ConcurrencyConfig::ConcurrencyConfig(int threadNum_, size_t queueSize_, size_t p
     , maxThreadNum(DEFAULT_THREAD_NUMBER)
     , queueSize(queueSize_)
     , processingSize(processingSize_)
+    , workStealing(false)
+    , numaBind(true)
+    , prioritySchedule(false)
+    , shedExpired(false)
 {}
 
 void ConcurrencyConfig::Jsonize(autil::legacy::Jsonizable::JsonWrapper &json) {
@@ -67,6 +75,10 @@ void ConcurrencyConfig::Jsonize(autil::legacy::Jsonizable::JsonWrapper &json) {
     json.Jsonize("max_thread_num", maxThreadNum, maxThreadNum);
     json.Jsonize("queue_size", queueSize, queueSize);
     json.Jsonize("processing_size", processingSize, processingSize);
+    json.Jsonize("work_stealing", workStealing, workStealing);
+    json.Jsonize("numa_bind", numaBind, numaBind);
+    json.Jsonize("priority_schedule", prioritySchedule, prioritySchedule);
+    json.Jsonize("shed_expired", shedExpired, shedExpired);
 }
 
 EngineConfig::EngineConfig()
@@ -67,6 +67,15 @@ public:
     size_t maxThreadNum;
     size_t queueSize;
     size_t processingSize;
+    // per worker queues with stealing instead of one shared queue
+    bool workStealing;
+    // pin workers to their numa node, work stealing mode only
+    bool numaBind;
+    // order sessions by priority class, then earliest deadline
+    bool prioritySchedule;
+    // dispatch sessions expired in queue at once, they drop before any
+    // kernel runs instead of waiting for a processing slot
+    bool shedExpired;
 };
 
 class EngineConfig : public autil::legacy::Jsonizable {
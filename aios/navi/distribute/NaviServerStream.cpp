@@ -106,6 +106,10 @@ bool NaviServerStream::notifyInitReceive(multi_call::PartIdTy partId) {
     sessionId.instance = pbParams.id().instance();
     sessionId.queryId = pbParams.id().query_id();
     auto item = new NaviStreamReceiveItem(shared_from_this(), partId);
+    item->setPriority(pbParams.priority() >= TP_NORMAL && pbParams.priority() < TP_COUNT
+                          ? (TaskPriority)pbParams.priority()
+                          : TP_NORMAL);
+    item->setDeadlineByTimeout(pbParams.timeout_ms());
     {
         NaviLoggerScope _(nullptr);
         _snapshot->runStreamSession(taskQueueName, sessionId, item, _logger.logger);
@@ -40,6 +40,7 @@ LocalSubGraph::LocalSubGraph(SubGraphDef *subGraphDef,
     , _finishPortIndex(0)
     , _frozen(true)
     , _inlineMode(false)
+    , _fuseLinearChain(false)
 {
     _logger.addPrefix("local");
 }
@@ -86,6 +87,7 @@ bool LocalSubGraph::doInit() {
     if (!postInit()) {
         return false;
     }
+    initFusedChain();
     finishPendingOutput();
     if (!checkGraph()) {
         return false;
@@ -166,6 +168,9 @@ bool LocalSubGraph::schedule(Node *node) {
                  node->getName().c_str(), node->getKernelName().c_str());
         return true;
     }
+    if (node->deferFusedCompute()) {
+        return true;
+    }
     auto worker = _param->worker;
     bool collectPerf = _param->runParams.collectPerf();
     if (inlineCompute(worker, node)) {
@@ -227,6 +232,7 @@ bool LocalSubGraph::inlineCompute(NaviWorkerBase * worker,
 
 void LocalSubGraph::initSubGraphOption() {
     _inlineMode = _subGraphDef->option().inline_mode();
+    _fuseLinearChain = _subGraphDef->option().fuse_linear_chain();
     _errorHandleStrategy = _subGraphDef->option().error_handle_strategy();
 }
 
@@ -426,6 +432,56 @@ bool LocalSubGraph::postInit() {
     return true;
 }
 
+void LocalSubGraph::initFusedChain() {
+    if (!_fuseLinearChain) {
+        return;
+    }
+    std::unordered_map<Node *, size_t> outCount;
+    std::unordered_map<Node *, size_t> inCount;
+    std::unordered_map<Node *, Node *> producerMap;
+    for (const auto &pair : _edges) {
+        auto edge = pair.second;
+        auto producer = edge->getInputNode();
+        for (const auto &slot : edge->getOutputSlots()) {
+            auto consumer = slot.outputNode;
+            if (!consumer) {
+                continue;
+            }
+            inCount[consumer]++;
+            if (producer) {
+                outCount[producer]++;
+                producerMap[consumer] = producer;
+            }
+        }
+    }
+    size_t fusedCount = 0;
+    for (const auto &pair : producerMap) {
+        auto consumer = pair.first;
+        auto producer = pair.second;
+        if (1 != inCount[consumer] || 1 != outCount[producer]) {
+            continue;
+        }
+        if (producer == consumer || !canFuse(producer) || !canFuse(consumer)) {
+            continue;
+        }
+        if (producer->getScope() != consumer->getScope() ||
+            1 != producer->outputDegree())
+        {
+            continue;
+        }
+        NAVI_LOG(SCHEDULE1, "fuse node [%s] after producer [%s]",
+                 consumer->getName().c_str(), producer->getName().c_str());
+        consumer->setFusedProducer(producer);
+        fusedCount++;
+    }
+    NAVI_LOG(DEBUG, "fused [%lu] nodes in linear chains", fusedCount);
+}
+
+bool LocalSubGraph::canFuse(Node *node) const {
+    return NT_NORMAL == node->getDef()->type() &&
+           !node->isResourceCreateKernel() && !node->isBorder();
+}
+
 Node *LocalSubGraph::getNode(const std::string &nodeName) const {
     auto it = _nodeMap.find(nodeName);
     if (it == _nodeMap.end()) {
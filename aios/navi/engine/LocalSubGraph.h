@@ -137,6 +137,8 @@ private:
     bool checkEdge() const;
     void finishPendingOutput();
     bool postInit();
+    void initFusedChain();
+    bool canFuse(Node *node) const;
     void doSchedule();
     ErrorCode flushEdgeOverride();
     bool inlineCompute(NaviWorkerBase *worker, Node *node);
@@ -150,6 +152,7 @@ private:
     IndexType _finishPortIndex;
     bool _frozen;
     bool _inlineMode;
+    bool _fuseLinearChain;
     ErrorHandleStrategy _errorHandleStrategy = EHS_ERROR_AS_FATAL;
     std::unordered_map<int32_t, ScopeInfo> _scopeInfoMap;
 };
@@ -19,6 +19,7 @@
 #include "kmonitor/client/core/MutableMetric.h"
 #include "navi/engine/TaskQueue.h"
 #include "navi/engine/NaviStat.h"
+#include "navi/engine/NaviThreadPool.h"
 
 namespace navi {
 
@@ -94,4 +95,38 @@ void TaskQueueStatMetrics::report(const kmonitor::MetricsTags *tags,
     REPORT_MUTABLE_METRIC(_queueCount, stat->queueCount);
     REPORT_MUTABLE_METRIC(_queueCountRatio, stat->queueCountRatio);
 }
+
+bool TaskQueueClassStatMetrics::init(kmonitor::MetricsGroupManager *manager) {
+    REGISTER_GAUGE_MUTABLE_METRIC(_queueCount, "run_sql.NaviClassQueueCount");
+    REGISTER_GAUGE_MUTABLE_METRIC(_admitCount, "run_sql.NaviClassAdmitCount");
+    REGISTER_GAUGE_MUTABLE_METRIC(_rejectCount, "run_sql.NaviClassRejectCount");
+    REGISTER_GAUGE_MUTABLE_METRIC(_expireCount, "run_sql.NaviClassExpireCount");
+    REGISTER_GAUGE_MUTABLE_METRIC(_shedCount, "run_sql.NaviClassShedCount");
+    return true;
+}
+
+void TaskQueueClassStatMetrics::report(const kmonitor::MetricsTags *tags,
+                                       const TaskQueueClassStat *stat) {
+    REPORT_MUTABLE_METRIC(_queueCount, stat->queueCount);
+    REPORT_MUTABLE_METRIC(_admitCount, stat->admitCount);
+    REPORT_MUTABLE_METRIC(_rejectCount, stat->rejectCount);
+    REPORT_MUTABLE_METRIC(_expireCount, stat->expireCount);
+    REPORT_MUTABLE_METRIC(_shedCount, stat->shedCount);
+}
+
+bool ThreadPoolWorkerStatMetrics::init(kmonitor::MetricsGroupManager *manager) {
+    REGISTER_GAUGE_MUTABLE_METRIC(_queueSize, "run_sql.NaviWorkerQueueSize");
+    REGISTER_GAUGE_MUTABLE_METRIC(_localPopCount, "run_sql.NaviWorkerLocalPopCount");
+    REGISTER_GAUGE_MUTABLE_METRIC(_stealCount, "run_sql.NaviWorkerStealCount");
+    REGISTER_GAUGE_MUTABLE_METRIC(_remoteStealCount, "run_sql.NaviWorkerRemoteStealCount");
+    return true;
+}
+
+void ThreadPoolWorkerStatMetrics::report(const kmonitor::MetricsTags *tags,
+                                         const NaviThreadPoolWorkerStat *stat) {
+    REPORT_MUTABLE_METRIC(_queueSize, stat->queueSize);
+    REPORT_MUTABLE_METRIC(_localPopCount, stat->localPopCount);
+    REPORT_MUTABLE_METRIC(_stealCount, stat->stealCount);
+    REPORT_MUTABLE_METRIC(_remoteStealCount, stat->remoteStealCount);
+}
 }
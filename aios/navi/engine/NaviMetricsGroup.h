@@ -80,5 +80,32 @@ private:
     kmonitor::MutableMetric *_queueCountRatio = nullptr;
 };
 
+struct TaskQueueClassStat;
+
+class TaskQueueClassStatMetrics : public kmonitor::MetricsGroup {
+public:
+    bool init(kmonitor::MetricsGroupManager *manager) override;
+    void report(const kmonitor::MetricsTags *tags, const TaskQueueClassStat *stat);
+private:
+    kmonitor::MutableMetric *_queueCount = nullptr;
+    kmonitor::MutableMetric *_admitCount = nullptr;
+    kmonitor::MutableMetric *_rejectCount = nullptr;
+    kmonitor::MutableMetric *_expireCount = nullptr;
+    kmonitor::MutableMetric *_shedCount = nullptr;
+};
+
+struct NaviThreadPoolWorkerStat;
+
+class ThreadPoolWorkerStatMetrics : public kmonitor::MetricsGroup {
+public:
+    bool init(kmonitor::MetricsGroupManager *manager) override;
+    void report(const kmonitor::MetricsTags *tags, const NaviThreadPoolWorkerStat *stat);
+private:
+    kmonitor::MutableMetric *_queueSize = nullptr;
+    kmonitor::MutableMetric *_localPopCount = nullptr;
+    kmonitor::MutableMetric *_stealCount = nullptr;
+    kmonitor::MutableMetric *_remoteStealCount = nullptr;
+};
+
 
 }
@@ -586,6 +586,8 @@ bool NaviSnapshot::runGraphImpl(GraphDef *graphDef,
         return false;
     }
     auto *item = new NaviSessionScheduleItem(session);
+    item->setPriority(params.getPriority());
+    item->setDeadlineByTimeout(params.getTimeoutMs());
     if (!taskQueue->push(item)) {
         NAVI_KERNEL_LOG(WARN, "session push failed, dropped");
         REPORT_USER_MUTABLE_QPS(_metricsReporter, "dropQps");
@@ -674,11 +676,35 @@ void NaviSnapshot::reportStat(kmonitor::MetricsReporter &reporter) {
         auto stat = _defaultTaskQueue->getStat();
         kmonitor::MetricsTags tag{"name", "builtin"};
         _metricsReporter->report<TaskQueueStatMetrics>(&tag, &stat);
+        reportWorkerStat("builtin", _defaultTaskQueue.get());
+        reportClassStat("builtin", _defaultTaskQueue.get());
     }
     for (auto &pair : _extraTaskQueueMap) {
         auto stat = pair.second->getStat();
         kmonitor::MetricsTags tag{"name", pair.first};
         _metricsReporter->report<TaskQueueStatMetrics>(&tag, &stat);
+        reportWorkerStat(pair.first, pair.second.get());
+        reportClassStat(pair.first, pair.second.get());
+    }
+}
+
+void NaviSnapshot::reportClassStat(const std::string &name, TaskQueue *taskQueue) {
+    for (int32_t priority = 0; priority < TP_COUNT; priority++) {
+        auto stat = taskQueue->getClassStat((TaskPriority)priority);
+        kmonitor::MetricsTags tag{"name", name};
+        tag.AddTag("priority", TaskQueue::getPriorityName((TaskPriority)priority));
+        _metricsReporter->report<TaskQueueClassStatMetrics>(&tag, &stat);
+    }
+}
+
+void NaviSnapshot::reportWorkerStat(const std::string &name, TaskQueue *taskQueue) {
+    std::vector<NaviThreadPoolWorkerStat> statVec;
+    taskQueue->getThreadPool()->collectWorkerStat(statVec);
+    for (const auto &stat : statVec) {
+        kmonitor::MetricsTags tag{"name", name};
+        tag.AddTag("worker", std::to_string(stat.index));
+        tag.AddTag("node", std::to_string(stat.node));
+        _metricsReporter->report<ThreadPoolWorkerStatMetrics>(&tag, &stat);
     }
 }
 
@@ -124,6 +124,8 @@ public:
 public:
     static NaviLoggerPtr getTlsLogger();
 private:
+    void reportWorkerStat(const std::string &name, TaskQueue *taskQueue);
+    void reportClassStat(const std::string &name, TaskQueue *taskQueue);
     void initDefaultLogger();
     bool initLogger(InstanceId instanceId, const NaviSnapshotPtr &oldSnapshot);
     bool initTaskQueue();
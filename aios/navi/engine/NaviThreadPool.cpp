@@ -15,7 +15,11 @@
  */
 #include "navi/log/NaviLogger.h"
 #include "navi/engine/NaviThreadPool.h"
+#include "autil/StringUtil.h"
+#include <fstream>
+#include <limits>
 #include <malloc.h>
+#include <sched.h>
 #include <unistd.h>
 // #include "navi/perf/perf.h"
 
@@ -25,6 +29,63 @@ thread_local int32_t INLINE_DEPTH_TLS = INVALID_INLINE_DEPTH;
 thread_local size_t current_thread_id = 0;
 thread_local size_t current_thread_counter = 0;
 thread_local size_t current_thread_wait_counter = 0;
+thread_local const NaviThreadPool *current_thread_pool = nullptr;
+thread_local int32_t current_worker_index = -1;
+
+static const std::string NUMA_NODE_SYS_PATH = "/sys/devices/system/node/";
+
+static bool parseCpuList(const std::string &cpuListStr, std::vector<int32_t> &cpus) {
+    // format: 0-23,48-71
+    std::vector<std::string> ranges;
+    autil::StringUtil::split(ranges, cpuListStr, ',');
+    for (const auto &range : ranges) {
+        std::vector<int32_t> bounds;
+        autil::StringUtil::fromString(range, bounds, "-");
+        if (bounds.size() == 1) {
+            cpus.push_back(bounds[0]);
+        } else if (bounds.size() == 2 && bounds[0] <= bounds[1]) {
+            for (int32_t cpu = bounds[0]; cpu <= bounds[1]; cpu++) {
+                cpus.push_back(cpu);
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// cpus of each numa node usable by this process, empty nodes skipped
+static std::vector<std::vector<int32_t>> loadNumaTopology() {
+    std::vector<std::vector<int32_t>> nodeCpus;
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (0 != sched_getaffinity(0, sizeof(allowed), &allowed)) {
+        return nodeCpus;
+    }
+    for (int32_t node = 0;; node++) {
+        std::ifstream in(NUMA_NODE_SYS_PATH + "node" + std::to_string(node) + "/cpulist");
+        if (!in) {
+            break;
+        }
+        std::string line;
+        std::getline(in, line);
+        autil::StringUtil::trim(line);
+        std::vector<int32_t> cpus;
+        if (!parseCpuList(line, cpus)) {
+            return {};
+        }
+        std::vector<int32_t> usable;
+        for (auto cpu : cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+                usable.push_back(cpu);
+            }
+        }
+        if (!usable.empty()) {
+            nodeCpus.push_back(std::move(usable));
+        }
+    }
+    return nodeCpus;
+}
 
 NaviThreadPool::NaviThreadPool()
     : _run(false)
@@ -35,6 +96,8 @@ NaviThreadPool::NaviThreadPool()
     , _maxThreadNum(DEFAULT_THREAD_NUMBER)
     , _activeThreadNum(DEFAULT_THREAD_NUMBER)
     , _threads(nullptr)
+    , _workStealing(false)
+    , _numaBind(false)
 {
     atomic_set(&_workerCount, 0);
     atomic_set(&_runningThread, 0);
@@ -72,6 +135,10 @@ void NaviThreadPool::stop() {
     int32_t tid = 0;
     while (_idleQueue.Pop(&tid)) {
     }
+    for (auto &idleQueue : _nodeIdleQueues) {
+        while (idleQueue->Pop(&tid)) {
+        }
+    }
 }
 
 void NaviThreadPool::clear() {
@@ -80,6 +147,14 @@ void NaviThreadPool::clear() {
         NAVI_KERNEL_LOG(ERROR, "drop item [%p]", item);
         item->destroy();
     }
+    if (_workStealing && _threads) {
+        for (size_t i = 0; i < _threadNum; i++) {
+            while ((item = popFrom(i))) {
+                NAVI_KERNEL_LOG(ERROR, "drop item [%p]", item);
+                item->destroy();
+            }
+        }
+    }
 }
 
 int32_t NaviThreadPool::getIdleTid() {
@@ -145,7 +220,11 @@ bool NaviThreadPool::wait(int32_t tid) {
         stat = TS_WAIT;
         if (tid < _activeThreadNum) {
             NAVI_KERNEL_LOG(SCHEDULE3, "push to idle [%d]", tid);
-            _idleQueue.Push(tid);
+            if (_workStealing) {
+                _nodeIdleQueues[_threads[tid].node]->Push(tid);
+            } else {
+                _idleQueue.Push(tid);
+            }
         } else {
             suspend = true;
             NAVI_KERNEL_LOG(SCHEDULE3, "thread [%d] suspended", tid);
@@ -171,7 +250,7 @@ void NaviThreadPool::waitQueueEmpty() {
             autil::ScopedLock lock(cond);
             cond.signal();
         }
-        if (0ul == _scheduleQueue.Size() &&
+        if (0ul == getQueueSize() &&
             atomic_read(&_workerCount) == 0)
         {
             break;
@@ -181,7 +260,7 @@ void NaviThreadPool::waitQueueEmpty() {
                  INFO,
                  "thread pool not empty, scheduleQueue size [%lu], workerCount "
                  "[%lld]",
-                 _scheduleQueue.Size(), atomic_read(&_workerCount));
+                 getQueueSize(), atomic_read(&_workerCount));
         }
         usleep(sleepTime);
         sleepTime += 1000;
@@ -231,6 +310,7 @@ bool NaviThreadPool::createThreads(const ConcurrencyConfig &config,
     }
     _activeThreadNum = _threadNum;
     _threads = new NaviThread[_threadNum];
+    initWorkStealing(config);
     for (size_t i = 0; i < _threadNum; i++) {
         auto thread = autil::Thread::createThread(
             std::bind(&NaviThreadPool::workLoop, this, (int32_t)i), name);
@@ -251,12 +331,60 @@ bool NaviThreadPool::createThreads(const ConcurrencyConfig &config,
     _backgroundThread = bgThread;
     NAVI_KERNEL_LOG(INFO,
                     "create threads success, autoScale[%d], config[%d],"
-                    "threadNum[%lu], minThreadNum[%lu], maxThreadNum[%lu]",
+                    "threadNum[%lu], minThreadNum[%lu], maxThreadNum[%lu], "
+                    "workStealing[%d], numaNodeCount[%lu], numaBind[%d]",
                     _autoScale, _configThreadNum,
-                    _threadNum, _minThreadNum, _maxThreadNum);
+                    _threadNum, _minThreadNum, _maxThreadNum,
+                    _workStealing, _nodeWorkers.size(), _numaBind);
     return true;
 }
 
+void NaviThreadPool::initWorkStealing(const ConcurrencyConfig &config) {
+    _workStealing = config.workStealing;
+    if (!_workStealing) {
+        return;
+    }
+    _nodeCpus = loadNumaTopology();
+    if (_nodeCpus.empty()) {
+        _nodeCpus.resize(1);
+    }
+    // a single node gains nothing from pinning
+    _numaBind = config.numaBind && _nodeCpus.size() > 1;
+    size_t nodeCount = _nodeCpus.size();
+    _nodeWorkers.resize(nodeCount);
+    _nodeIdleQueues.clear();
+    for (size_t node = 0; node < nodeCount; node++) {
+        _nodeIdleQueues.emplace_back(new arpc::common::LockFreeQueue<int32_t>());
+    }
+    _nodeWakeIndex.reset(new std::atomic<uint64_t>[nodeCount]);
+    // interleave workers so that the active prefix under auto scale is
+    // spread over all nodes
+    for (size_t i = 0; i < _threadNum; i++) {
+        int32_t node = i % nodeCount;
+        _threads[i].node = node;
+        _nodeWorkers[node].push_back(i);
+    }
+    for (size_t node = 0; node < nodeCount; node++) {
+        _nodeWakeIndex[node] = 0;
+    }
+}
+
+void NaviThreadPool::bindNumaNode(int32_t tid) {
+    if (!_numaBind) {
+        return;
+    }
+    const auto &cpus = _nodeCpus[_threads[tid].node];
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (auto cpu : cpus) {
+        CPU_SET(cpu, &mask);
+    }
+    if (0 != sched_setaffinity(0, sizeof(mask), &mask)) {
+        NAVI_KERNEL_LOG(WARN, "bind thread [%d] to numa node [%d] failed, errno [%d]",
+                        tid, _threads[tid].node, errno);
+    }
+}
+
 void NaviThreadPool::initThreadNumRange(const ConcurrencyConfig &config) {
     _minThreadNum = config.minThreadNum;
     _maxThreadNum = config.maxThreadNum;
@@ -353,6 +481,10 @@ void NaviThreadPool::push(NaviThreadPoolItemBase *item) {
         item->destroy();
         return;
     }
+    if (_workStealing) {
+        pushLocal(item);
+        return;
+    }
     auto tid = getIdleTid();
     if (tid >= 0) {
         item->setSignalTid(_threads[tid].tid, getQueueSize());
@@ -373,14 +505,227 @@ int64_t NaviThreadPool::getRunningThreadCount() const {
 }
 
 size_t NaviThreadPool::getQueueSize() const {
-    return _scheduleQueue.Size();
+    size_t size = _scheduleQueue.Size();
+    if (_workStealing) {
+        for (size_t i = 0; i < _threadNum; i++) {
+            size += _threads[i].localQueueSize.load(std::memory_order_relaxed);
+        }
+    }
+    return size;
 }
 
 size_t NaviThreadPool::getIdleQueueSize() const {
-    return _idleQueue.Size();
+    size_t size = _idleQueue.Size();
+    for (const auto &idleQueue : _nodeIdleQueues) {
+        size += idleQueue->Size();
+    }
+    return size;
+}
+
+size_t NaviThreadPool::getNodeQueueSize(int32_t node) const {
+    size_t size = 0;
+    for (auto tid : _nodeWorkers[node]) {
+        size += _threads[tid].localQueueSize.load(std::memory_order_relaxed);
+    }
+    return size;
+}
+
+int32_t NaviThreadPool::selectNumaNode() const {
+    if (!_workStealing) {
+        return -1;
+    }
+    if (current_thread_pool == this) {
+        return _threads[current_worker_index].node;
+    }
+    int32_t bestNode = 0;
+    size_t bestSize = std::numeric_limits<size_t>::max();
+    for (size_t node = 0; node < _nodeWorkers.size(); node++) {
+        auto size = getNodeQueueSize(node);
+        if (size < bestSize) {
+            bestSize = size;
+            bestNode = node;
+        }
+    }
+    return bestNode;
+}
+
+void NaviThreadPool::collectWorkerStat(std::vector<NaviThreadPoolWorkerStat> &statVec) {
+    if (!_workStealing) {
+        return;
+    }
+    for (size_t i = 0; i < _threadNum; i++) {
+        auto &thread = _threads[i];
+        NaviThreadPoolWorkerStat stat;
+        stat.index = i;
+        stat.node = thread.node;
+        stat.queueSize = thread.localQueueSize.load(std::memory_order_relaxed);
+        stat.localPopCount = thread.localPopCount.exchange(0, std::memory_order_relaxed);
+        stat.stealCount = thread.stealCount.exchange(0, std::memory_order_relaxed);
+        stat.remoteStealCount = thread.remoteStealCount.exchange(0, std::memory_order_relaxed);
+        statVec.push_back(stat);
+    }
+}
+
+int32_t NaviThreadPool::selectWorker(int32_t node) {
+    const auto &workers = _nodeWorkers[node];
+    size_t count = workers.size();
+    for (size_t i = 0; i < count; i++) {
+        auto index = _nodeWakeIndex[node].fetch_add(1, std::memory_order_relaxed) % count;
+        auto tid = workers[index];
+        if ((size_t)tid < _activeThreadNum) {
+            return tid;
+        }
+    }
+    // no active worker on this node after scale down
+    return atomic_inc_return(&_wakeIndex) % _activeThreadNum;
+}
+
+void NaviThreadPool::pushLocal(NaviThreadPoolItemBase *item) {
+    int32_t tid = -1;
+    auto node = item->getNumaNode();
+    if (current_thread_pool == this &&
+        (size_t)current_worker_index < _activeThreadNum &&
+        (node < 0 || node == _threads[current_worker_index].node))
+    {
+        tid = current_worker_index;
+    } else {
+        if (node < 0 || (size_t)node >= _nodeWorkers.size()) {
+            node = selectNumaNode();
+        }
+        tid = selectWorker(node);
+    }
+    auto &thread = _threads[tid];
+    size_t queueSize = 0;
+    {
+        autil::ScopedLock lock(thread.queueLock);
+        thread.localQueue.push_back(item);
+        queueSize = thread.localQueueSize.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    NAVI_KERNEL_LOG(SCHEDULE3, "push WorkItem [%p] to local queue [%d], node [%d], queueSize [%lu]",
+                    item, tid, thread.node, queueSize);
+    // wake remote node only when the owner can not drain it alone
+    signalNode(thread.node, queueSize > 1);
+}
+
+int32_t NaviThreadPool::getNodeIdleTid(int32_t node, bool allowRemote) {
+    int32_t tid = 0;
+    if (_nodeIdleQueues[node]->Pop(&tid)) {
+        return tid;
+    }
+    if (!allowRemote) {
+        return -1;
+    }
+    for (size_t i = 1; i < _nodeIdleQueues.size(); i++) {
+        auto remote = (node + i) % _nodeIdleQueues.size();
+        if (_nodeIdleQueues[remote]->Pop(&tid)) {
+            return tid;
+        }
+    }
+    return -1;
+}
+
+void NaviThreadPool::signalNode(int32_t node, bool allowRemote) {
+    auto tid = getNodeIdleTid(node, allowRemote);
+    if (tid >= 0) {
+        auto &thread = _threads[tid];
+        auto &cond = thread.cond;
+        if (0 == cond.trylock()) {
+            NAVI_KERNEL_LOG(SCHEDULE3, "wake up [%d] node [%d]", tid, thread.node);
+            thread.stat = TS_WAKEUP;
+            cond.signal();
+            cond.unlock();
+            return;
+        }
+    }
+    const auto &workers = _nodeWorkers[node];
+    while (true) {
+        auto index = _nodeWakeIndex[node].fetch_add(1, std::memory_order_relaxed) % workers.size();
+        auto wakeTid = workers[index];
+        if ((size_t)wakeTid >= _activeThreadNum) {
+            wakeTid = atomic_inc_return(&_wakeIndex) % _activeThreadNum;
+        }
+        auto &thread = _threads[wakeTid];
+        auto &cond = thread.cond;
+        if (0 == cond.trylock()) {
+            if (TS_WAIT == thread.stat) {
+                NAVI_KERNEL_LOG(SCHEDULE3, "wake up [%d]", wakeTid);
+                cond.signal();
+            }
+            thread.stat = TS_WAKEUP;
+            cond.unlock();
+            break;
+        }
+    }
+}
+
+NaviThreadPoolItemBase *NaviThreadPool::popFrom(int32_t victim) {
+    auto &thread = _threads[victim];
+    if (0 == thread.localQueueSize.load(std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    autil::ScopedLock lock(thread.queueLock);
+    if (thread.localQueue.empty()) {
+        return nullptr;
+    }
+    auto item = thread.localQueue.front();
+    thread.localQueue.pop_front();
+    thread.localQueueSize.fetch_sub(1, std::memory_order_relaxed);
+    return item;
+}
+
+NaviThreadPoolItemBase *NaviThreadPool::popLocal(int32_t tid) {
+    auto item = popFrom(tid);
+    if (item) {
+        _threads[tid].localPopCount.fetch_add(1, std::memory_order_relaxed);
+        return item;
+    }
+    if ((size_t)tid >= _activeThreadNum) {
+        // suspended threads only drain their own queue
+        return nullptr;
+    }
+    return steal(tid);
+}
+
+NaviThreadPoolItemBase *NaviThreadPool::steal(int32_t tid) {
+    auto &thread = _threads[tid];
+    // oldest items first: the victim's queue is FIFO
+    const auto &sameNode = _nodeWorkers[thread.node];
+    size_t count = sameNode.size();
+    size_t start = current_thread_counter;
+    for (size_t i = 0; i < count; i++) {
+        auto victim = sameNode[(start + i) % count];
+        if (victim == tid) {
+            continue;
+        }
+        auto item = popFrom(victim);
+        if (item) {
+            thread.stealCount.fetch_add(1, std::memory_order_relaxed);
+            return item;
+        }
+    }
+    // cross node only for backlog the remote owner can not drain alone,
+    // or for items stranded on suspended workers
+    size_t nodeCount = _nodeWorkers.size();
+    for (size_t n = 1; n < nodeCount; n++) {
+        const auto &workers = _nodeWorkers[(thread.node + n) % nodeCount];
+        for (auto victim : workers) {
+            auto queueSize = _threads[victim].localQueueSize.load(std::memory_order_relaxed);
+            if (queueSize > 1 || (queueSize > 0 && (size_t)victim >= _activeThreadNum)) {
+                auto item = popFrom(victim);
+                if (item) {
+                    thread.remoteStealCount.fetch_add(1, std::memory_order_relaxed);
+                    return item;
+                }
+            }
+        }
+    }
+    return nullptr;
 }
 
-NaviThreadPoolItemBase *NaviThreadPool::pop() {
+NaviThreadPoolItemBase *NaviThreadPool::pop(int32_t tid) {
+    if (_workStealing) {
+        return popLocal(tid);
+    }
     NaviThreadPoolItemBase *item = nullptr;
     if (_scheduleQueue.Pop(&item)) {
         return item;
@@ -403,11 +748,14 @@ std::vector<pid_t> NaviThreadPool::getPidVec() const {
 void NaviThreadPool::workLoop(int32_t tid) {
     current_thread_id = (long)syscall(SYS_gettid);
     _threads[tid].tid = current_thread_id;
+    current_thread_pool = this;
+    current_worker_index = tid;
+    bindNumaNode(tid);
     NAVI_MEMORY_BARRIER();
     atomic_inc(&_runningThread);
     NaviLoggerScope scope(_logger);
     while (_run) {
-        auto item = pop();
+        auto item = pop(tid);
         NAVI_KERNEL_LOG(SCHEDULE3, "thread pop [%d] [%p] queueSize [%lu]", tid, item, getQueueSize());
         if (item) {
             atomic_inc(&_processingCount);
@@ -426,7 +774,11 @@ void NaviThreadPool::workLoop(int32_t tid) {
         }
         if (unlikely(tid >= _activeThreadNum)) {
             // transfer to active thread
-            signal(-1);
+            if (_workStealing) {
+                signalNode(_threads[tid].node, true);
+            } else {
+                signal(-1);
+            }
             if (!wait(tid)) {
                 break;
             }
@@ -442,6 +794,8 @@ void NaviThreadPool::workLoop(int32_t tid) {
         }
     }
     NAVI_KERNEL_LOG(INFO, "thread exited");
+    current_thread_pool = nullptr;
+    current_worker_index = -1;
     atomic_dec(&_runningThread);
     INLINE_DEPTH_TLS = INVALID_INLINE_DEPTH;
 }
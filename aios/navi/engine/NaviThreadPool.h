@@ -23,6 +23,9 @@
 #include <arpc/common/LockFreeQueue.h>
 #include <autil/Lock.h>
 #include <autil/Thread.h>
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <vector>
 
 namespace navi {
@@ -37,18 +40,42 @@ enum ThreadStat {
     TS_WAKEUP,
 };
 
+class NaviThreadPoolItemBase;
+
 struct NaviThread {
     NaviThread()
         : tid(-1)
         , stat(TS_RUNNING)
+        , node(0)
+        , localQueueSize(0)
+        , localPopCount(0)
+        , stealCount(0)
+        , remoteStealCount(0)
     {
     }
     pid_t tid;
     autil::ThreadPtr thread;
     autil::ThreadCond cond;
     volatile ThreadStat stat;
+    // work stealing mode only
+    int32_t node;
+    autil::ThreadMutex queueLock;
+    std::deque<NaviThreadPoolItemBase *> localQueue;
+    std::atomic<size_t> localQueueSize;
+    std::atomic<uint64_t> localPopCount;
+    std::atomic<uint64_t> stealCount;
+    std::atomic<uint64_t> remoteStealCount;
 } __attribute__((aligned(64)));
 
+struct NaviThreadPoolWorkerStat {
+    int32_t index = 0;
+    int32_t node = 0;
+    size_t queueSize = 0;
+    uint64_t localPopCount = 0;
+    uint64_t stealCount = 0;
+    uint64_t remoteStealCount = 0;
+};
+
 class NaviThreadPoolItemBase
 {
 public:
@@ -66,6 +93,12 @@ public:
         return false;
     }
 public:
+    void setNumaNode(int32_t node) {
+        _numaNode = node;
+    }
+    int32_t getNumaNode() const {
+        return _numaNode;
+    }
     void setEnqueueTime(int64_t enqueueTime) {
         _schedInfo.enqueueTime = enqueueTime;
         _schedInfo.dequeueTime = _schedInfo.enqueueTime;
@@ -87,6 +120,7 @@ public:
 
 protected:
     ScheduleInfo _schedInfo;
+    int32_t _numaNode = -1;
 };
 
 class NaviThreadPool
@@ -109,17 +143,37 @@ public:
     size_t getQueueSize() const;
     size_t getIdleQueueSize() const;
     std::vector<pid_t> getPidVec() const;
+    bool workStealing() const {
+        return _workStealing;
+    }
+    size_t getNumaNodeCount() const {
+        return _nodeWorkers.size();
+    }
+    // node of the calling worker thread, or the least loaded node
+    int32_t selectNumaNode() const;
+    // counters are reset after each collect
+    void collectWorkerStat(std::vector<NaviThreadPoolWorkerStat> &statVec);
 private:
     bool createThreads(const ConcurrencyConfig &config, const std::string &name);
+    void initWorkStealing(const ConcurrencyConfig &config);
+    void bindNumaNode(int32_t tid);
     void initThreadNumRange(const ConcurrencyConfig &config);
     size_t getCoreNum();
     void backgroundThread();
     void updateActiveThreadCount();
     void checkTimeout();
     void workLoop(int32_t tid);
-    NaviThreadPoolItemBase *pop();
+    NaviThreadPoolItemBase *pop(int32_t tid);
     int32_t getIdleTid();
     void signal(int32_t tid);
+    void pushLocal(NaviThreadPoolItemBase *item);
+    int32_t selectWorker(int32_t node);
+    NaviThreadPoolItemBase *popLocal(int32_t tid);
+    NaviThreadPoolItemBase *popFrom(int32_t victim);
+    NaviThreadPoolItemBase *steal(int32_t tid);
+    void signalNode(int32_t node, bool allowRemote);
+    int32_t getNodeIdleTid(int32_t node, bool allowRemote);
+    size_t getNodeQueueSize(int32_t node) const;
     bool wait(int32_t tid);
     void waitQueueEmpty();
     void waitThreadStop();
@@ -143,6 +197,12 @@ private:
     atomic64_t _wakeIndex;
     arpc::common::LockFreeQueue<NaviThreadPoolItemBase *> _scheduleQueue;
     arpc::common::LockFreeQueue<int32_t> _idleQueue;
+    bool _workStealing;
+    bool _numaBind;
+    std::vector<std::vector<int32_t>> _nodeWorkers;
+    std::vector<std::vector<int32_t>> _nodeCpus;
+    std::vector<std::unique_ptr<arpc::common::LockFreeQueue<int32_t>>> _nodeIdleQueues;
+    std::unique_ptr<std::atomic<uint64_t>[]> _nodeWakeIndex;
 };
 
 NAVI_TYPEDEF_PTR(NaviThreadPool);
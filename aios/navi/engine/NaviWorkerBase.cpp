@@ -151,6 +151,7 @@ NaviWorkerBase::NaviWorkerBase(
     , _hostInfo(nullptr)
     , _threadLimit(DEFAULT_THREAD_LIMIT)
     , _maxInline(DEFAULT_MAX_INLINE)
+    , _numaNode(-1)
     , _collectPerf(false)
     , _metric(std::make_shared<KernelMetric>(INVALID_GRAPH_ID, "navi.graph_init", ""))
 {
@@ -323,6 +324,7 @@ void NaviWorkerBase::initCounters() {
 void NaviWorkerBase::initSchedule() {
     NAVI_LOG(SCHEDULE1, "init schedule with sync mode");
     _metricsCollector.initScheduleTime = autil::TimeUtility::currentTime();
+    _numaNode = _threadPool->selectNumaNode();
 
     if (_threadPool->incWorkerCount()) {
         _initSuccess = true;
@@ -344,6 +346,7 @@ bool NaviWorkerBase::schedule(NaviWorkerItem *item, bool force) {
         return false;
     }
     incItemCount();
+    item->setNumaNode(_numaNode);
     if (force || atomic_read(&_processingCount) < _threadLimit) {
         atomic_inc(&_processingCount);
         _threadPool->push(item);
@@ -198,6 +198,8 @@ private:
     const NaviHostInfo *_hostInfo;
     uint32_t _threadLimit;
     int32_t _maxInline;
+    // numa node the session started on, items stay there in work stealing mode
+    int32_t _numaNode;
     arpc::common::LockFreeQueue<NaviWorkerItem *> _scheduleQueue;
     atomic64_t _itemCount;
     atomic64_t _processingCount;
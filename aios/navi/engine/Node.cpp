@@ -37,6 +37,10 @@
 
 namespace navi {
 
+// node computing on this thread and fused consumers waiting for it
+thread_local Node *COMPUTING_NODE_TLS = nullptr;
+thread_local std::vector<Node *> *FUSED_PENDING_TLS = nullptr;
+
 class DataDestructItem : public NaviNoDropWorkerItem
 {
 public:
@@ -135,6 +139,7 @@ Node::Node(const NodeDef &nodeDef,
     _stopSchedule = false;
     _forceStop = false;
     _forceStopNode = nullptr;
+    _fusedProducer = nullptr;
 }
 
 Node::~Node() {
@@ -1454,7 +1459,61 @@ size_t Node::outputDegree() const {
     return _outputDegree;
 }
 
-void Node::compute(const ScheduleInfo &schedInfo)
+bool Node::deferFusedCompute() {
+    if (!_fusedProducer || _fusedProducer != COMPUTING_NODE_TLS ||
+        !FUSED_PENDING_TLS)
+    {
+        return false;
+    }
+    NAVI_LOG(SCHEDULE2, "fused compute deferred after producer [%s]",
+             _fusedProducer->getName().c_str());
+    FUSED_PENDING_TLS->push_back(this);
+    return true;
+}
+
+void Node::compute(const ScheduleInfo &schedInfo) {
+    auto prevNode = COMPUTING_NODE_TLS;
+    if (prevNode) {
+        // nested inline compute, fused consumers run in the outermost one
+        COMPUTING_NODE_TLS = this;
+        computeImpl(schedInfo);
+        COMPUTING_NODE_TLS = prevNode;
+        return;
+    }
+    std::vector<Node *> pending;
+    FUSED_PENDING_TLS = &pending;
+    COMPUTING_NODE_TLS = this;
+    computeImpl(schedInfo);
+    for (size_t i = 0; i < pending.size(); i++) {
+        // the chain may grow while draining
+        pending[i]->runFusedCompute();
+    }
+    COMPUTING_NODE_TLS = nullptr;
+    FUSED_PENDING_TLS = nullptr;
+}
+
+void Node::runFusedCompute() {
+    auto worker = _graph->getWorker();
+    if (worker->isStopped()) {
+        return;
+    }
+    // same as the inline compute in LocalSubGraph::schedule
+    bool collectPerf = _graph->getParam()->runParams.collectPerf();
+    worker->inlineBegin();
+    auto schedInfo = worker->makeInlineSchedInfo();
+    bool enableSuccess = false;
+    if (collectPerf) {
+        enableSuccess = worker->enablePerf();
+    }
+    COMPUTING_NODE_TLS = this;
+    computeImpl(schedInfo);
+    if (collectPerf && enableSuccess) {
+        worker->disablePerf();
+    }
+    worker->inlineEnd();
+}
+
+void Node::computeImpl(const ScheduleInfo &schedInfo)
 {
     NaviLoggerScope scope(getLogger());
     // critical region under SS_RUNNING stat;
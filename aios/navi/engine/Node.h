@@ -147,6 +147,15 @@ public:
     bool isInline() const;
     size_t outputDegree() const;
     void compute(const ScheduleInfo &schedInfo);
+    // consumer in a fused linear chain, computed on the producer's thread
+    // right after the producer instead of through a KernelWorkItem
+    void setFusedProducer(Node *producer) {
+        _fusedProducer = producer;
+    }
+    Node *getFusedProducer() const {
+        return _fusedProducer;
+    }
+    bool deferFusedCompute();
     void incNodeSnapshot();
     int64_t readNodeSnapshot() const;
     LocalSubGraph *getGraph() const;
@@ -234,6 +243,8 @@ private:
 private:
     bool scheduleLock(const Node *callNode);
     bool doSchedule(const Node *callNode, bool ignoreFrozen, bool &resched);
+    void computeImpl(const ScheduleInfo &schedInfo);
+    void runFusedCompute();
     ErrorCode doCompute(const ScheduleInfo &schedInfo);
     void clearControlInput();
     const InputSnapshot &doFillInput(const EdgeOutputInfo &info,
@@ -305,6 +316,7 @@ private:
     bool _stopSchedule;
     bool _forceStop;
     Node *_forceStopNode;
+    Node *_fusedProducer;
     autil::RecursiveThreadMutex _forkLock;
     GraphDef *_forkGraphDef;
     Graph *_forkGraph;
@@ -25,6 +25,7 @@ namespace navi {
 RunGraphParams::RunGraphParams()
     : _threadLimit(DEFAULT_THREAD_LIMIT)
     , _timeoutMs(DEFAULT_TIMEOUT_MS)
+    , _priority(TP_NORMAL)
     , _traceLevel(LOG_LEVEL_DISABLE)
     , _traceFormatPattern(DEFAULT_LOG_PATTERN)
     , _collectMetric(false)
@@ -70,6 +71,17 @@ const std::string &RunGraphParams::getTaskQueueName() const {
     return _taskQueueName;
 }
 
+void RunGraphParams::setPriority(TaskPriority priority) {
+    if (priority < TP_NORMAL || priority >= TP_COUNT) {
+        priority = TP_NORMAL;
+    }
+    _priority = priority;
+}
+
+TaskPriority RunGraphParams::getPriority() const {
+    return _priority;
+}
+
 void RunGraphParams::setTraceLevel(const std::string &traceLevelStr) {
     _traceLevel = getLevelByString(traceLevelStr);
 }
@@ -222,6 +234,7 @@ bool RunGraphParams::fromProto(const RunParams &pbParams,
     params.setSessionId(sessionId);
 
     params.setTaskQueueName(pbParams.task_queue_name());
+    params.setPriority((TaskPriority)pbParams.priority());
     params.setTraceLevel(pbParams.trace_level());
     params.setThreadLimit(pbParams.thread_limit());
     params.setTimeoutMs(pbParams.timeout_ms());
@@ -324,6 +337,7 @@ ErrorCode RunGraphParams::toProto(const RunGraphParams &params,
     pbParams.set_thread_limit(params.getThreadLimit());
     pbParams.set_timeout_ms(timeoutMs);
     pbParams.set_task_queue_name(params.getTaskQueueName());
+    pbParams.set_priority(params.getPriority());
     pbParams.set_trace_level(params.getTraceLevelStr());
     pbParams.set_collect_metric(params.collectMetric());
     pbParams.set_collect_perf(params.collectPerf());
@@ -62,6 +62,8 @@ public:
     int64_t getTimeoutMs() const;
     void setTaskQueueName(const std::string &taskQueueName);
     const std::string &getTaskQueueName() const;
+    void setPriority(TaskPriority priority);
+    TaskPriority getPriority() const;
     void setTraceLevel(const std::string &traceLevelStr);
     std::string getTraceLevelStr() const;
     LogLevel getTraceLevel() const;
@@ -128,6 +130,7 @@ private:
     uint32_t _threadLimit;
     int64_t _timeoutMs;
     std::string _taskQueueName;
+    TaskPriority _priority;
     LogLevel _traceLevel;
     std::string _traceFormatPattern;
     std::vector<std::pair<std::string, int>> _traceBtFilterParams;
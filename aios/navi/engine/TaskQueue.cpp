@@ -15,6 +15,10 @@
  */
 #include "navi/engine/TaskQueue.h"
 
+#include <algorithm>
+#include <limits>
+
+#include "autil/TimeUtility.h"
 #include "navi/config/NaviConfig.h"
 #include "navi/engine/NaviThreadPool.h"
 #include "navi/engine/NaviWorkerBase.h"
@@ -25,6 +29,14 @@ namespace navi {
 TaskQueueScheduleItemBase::TaskQueueScheduleItemBase() {}
 TaskQueueScheduleItemBase::~TaskQueueScheduleItemBase() {}
 
+void TaskQueueScheduleItemBase::setDeadlineByTimeout(int64_t timeoutMs) {
+    if (timeoutMs <= 0 || timeoutMs >= DEFAULT_TIMEOUT_MS) {
+        _deadline = 0;
+        return;
+    }
+    _deadline = autil::TimeUtility::currentTime() + timeoutMs * FACTOR_MS_TO_US;
+}
+
 TaskQueue::TaskQueue() {
     atomic_set(&_processingCount, 0);
 }
@@ -59,6 +71,8 @@ bool TaskQueue::init(const std::string &name, const ConcurrencyConfig &config, T
         _processingMax = config.processingSize;
     }
     _scheduleQueueMax = config.queueSize;
+    _prioritySchedule = config.prioritySchedule;
+    _shedExpired = config.prioritySchedule && config.shedExpired;
 
     return true;
 }
@@ -66,13 +80,13 @@ bool TaskQueue::init(const std::string &name, const ConcurrencyConfig &config, T
 void TaskQueue::stop() {
     NAVI_KERNEL_LOG(INFO, "[%s] begin stop", _desc.c_str());
     size_t count = 0;
-    while (!_scheduleQueue.Empty()) {
+    while (0 != getQueueCount()) {
         if (count++ % 200 == 0) {
             NAVI_KERNEL_LOG(INFO,
                             "[%s] session schedule queue not empty, "
                             "size[%lu], loop[%lu], waiting...",
                             _desc.c_str(),
-                            _scheduleQueue.Size(),
+                            getQueueCount(),
                             count);
         }
         usleep(1 * 1000);
@@ -90,26 +104,37 @@ void TaskQueue::stop() {
 
 bool TaskQueue::push(TaskQueueScheduleItemBase *item) {
     NAVI_KERNEL_LOG(SCHEDULE1, "[%s] push item[%p] type[%s]", _desc.c_str(), item, typeid(*item).name());
-    size_t queueSize = _scheduleQueue.Size();
+    size_t queueSize = getQueueCount();
     size_t processingCount = atomic_read(&_processingCount);
+    auto &classQueue = _classQueues[item->getPriority()];
     if (processingCount + queueSize >= _processingMax + _scheduleQueueMax) {
         NAVI_KERNEL_LOG(
             WARN, "[%s] session schedule queue full, limit [%lu], dropped", _desc.c_str(), _scheduleQueueMax);
+        classQueue.rejectCount++;
         item->destroy();
         return false;
     }
+    classQueue.admitCount++;
     NAVI_KERNEL_LOG(SCHEDULE1,
                     "[%s] before push schedule queue, queue size[%lu] "
                     "processing count[%lu]",
                     _desc.c_str(),
                     queueSize,
                     processingCount);
-    _scheduleQueue.Push(item);
+    if (_prioritySchedule) {
+        pushPriority(item);
+    } else {
+        _scheduleQueue.Push(item);
+    }
     schedule();
     return true;
 }
 
 void TaskQueue::schedule() {
+    if (_prioritySchedule) {
+        schedulePriority();
+        return;
+    }
     if (size_t processingCount = atomic_read(&_processingCount); processingCount >= _processingMax) {
         NAVI_KERNEL_LOG(SCHEDULE2,
                         "[%s] processing count[%lu] exceed, skip, schedule queue size[%lu]",
@@ -129,6 +154,103 @@ void TaskQueue::schedule() {
     }
 }
 
+bool TaskQueue::laterThan(const TaskQueueScheduleItemBase *lhs,
+                          const TaskQueueScheduleItemBase *rhs) {
+    auto lhsDeadline = lhs->_deadline > 0 ? lhs->_deadline : std::numeric_limits<int64_t>::max();
+    auto rhsDeadline = rhs->_deadline > 0 ? rhs->_deadline : std::numeric_limits<int64_t>::max();
+    if (lhsDeadline != rhsDeadline) {
+        return lhsDeadline > rhsDeadline;
+    }
+    return lhs->_sequence > rhs->_sequence;
+}
+
+void TaskQueue::pushPriority(TaskQueueScheduleItemBase *item) {
+    autil::ScopedLock lock(_priorityLock);
+    item->_sequence = _sequence++;
+    auto &heap = _classQueues[item->getPriority()].heap;
+    heap.push_back(item);
+    std::push_heap(heap.begin(), heap.end(), laterThan);
+    _priorityQueueCount++;
+}
+
+TaskQueueScheduleItemBase *TaskQueue::popExpired(int64_t now) {
+    autil::ScopedLock lock(_priorityLock);
+    for (auto &classQueue : _classQueues) {
+        auto &heap = classQueue.heap;
+        if (heap.empty()) {
+            continue;
+        }
+        auto item = heap.front();
+        if (item->_deadline <= 0 || item->_deadline >= now) {
+            continue;
+        }
+        std::pop_heap(heap.begin(), heap.end(), laterThan);
+        heap.pop_back();
+        _priorityQueueCount--;
+        classQueue.expireCount++;
+        classQueue.shedCount++;
+        return item;
+    }
+    return nullptr;
+}
+
+TaskQueueScheduleItemBase *TaskQueue::popPriority(int64_t now) {
+    static const TaskPriority order[] = {TP_HIGH, TP_NORMAL, TP_LOW};
+    autil::ScopedLock lock(_priorityLock);
+    for (auto priority : order) {
+        auto &classQueue = _classQueues[priority];
+        auto &heap = classQueue.heap;
+        if (heap.empty()) {
+            continue;
+        }
+        std::pop_heap(heap.begin(), heap.end(), laterThan);
+        auto item = heap.back();
+        heap.pop_back();
+        _priorityQueueCount--;
+        if (item->_deadline > 0 && item->_deadline < now) {
+            classQueue.expireCount++;
+        }
+        return item;
+    }
+    return nullptr;
+}
+
+void TaskQueue::schedulePriority() {
+    auto now = autil::TimeUtility::currentTime();
+    if (_shedExpired) {
+        // the session drops itself as timeout in initSchedule, no kernel runs
+        while (auto item = popExpired(now)) {
+            NAVI_KERNEL_LOG(SCHEDULE1, "[%s] item[%p] expired in queue, shed", _desc.c_str(), item);
+            dispatch(item);
+        }
+    }
+    if (size_t processingCount = atomic_read(&_processingCount); processingCount >= _processingMax) {
+        NAVI_KERNEL_LOG(SCHEDULE2,
+                        "[%s] processing count[%lu] exceed, skip, schedule queue size[%lu]",
+                        _desc.c_str(),
+                        processingCount,
+                        getQueueCount());
+        return;
+    }
+    auto item = popPriority(now);
+    if (item) {
+        NAVI_KERNEL_LOG(SCHEDULE1,
+                        "[%s] item[%p] poped, priority[%s] deadline[%ld]",
+                        _desc.c_str(),
+                        item,
+                        getPriorityName(item->getPriority()),
+                        item->getDeadline());
+        dispatch(item);
+    }
+}
+
+void TaskQueue::dispatch(TaskQueueScheduleItemBase *item) {
+    bool sync = _testMode != TM_NONE;
+    incProcessingCount();
+    item->setSyncMode(sync);
+    _threadPool->push(item);
+}
+
 void TaskQueue::scheduleNext() {
     NAVI_KERNEL_LOG(SCHEDULE2, "[%s] start", _desc.c_str());
     decProcessingCount();
@@ -163,7 +285,7 @@ TaskQueueStat TaskQueue::getStat() const {
     stat.activeThreadQueueSize = _threadPool->getQueueSize();
     stat.idleThreadQueueSize = _threadPool->getIdleQueueSize();
     stat.processingCount = getProcessingCount();
-    stat.queueCount = _scheduleQueue.Size();
+    stat.queueCount = getQueueCount();
     stat.processingCountRatio =
         _processingMax > 0 ? stat.processingCount * 100 / _processingMax : 0;
     stat.queueCountRatio =
@@ -171,4 +293,35 @@ TaskQueueStat TaskQueue::getStat() const {
     return stat;
 }
 
+TaskQueueClassStat TaskQueue::getClassStat(TaskPriority priority) {
+    TaskQueueClassStat stat;
+    auto &classQueue = _classQueues[priority];
+    {
+        autil::ScopedLock lock(_priorityLock);
+        stat.queueCount = classQueue.heap.size();
+    }
+    stat.admitCount = classQueue.admitCount.exchange(0);
+    stat.rejectCount = classQueue.rejectCount.exchange(0);
+    stat.expireCount = classQueue.expireCount.exchange(0);
+    stat.shedCount = classQueue.shedCount.exchange(0);
+    return stat;
+}
+
+size_t TaskQueue::getQueueCount() const {
+    return _scheduleQueue.Size() + _priorityQueueCount.load();
+}
+
+const char *TaskQueue::getPriorityName(TaskPriority priority) {
+    switch (priority) {
+    case TP_HIGH:
+        return "high";
+    case TP_NORMAL:
+        return "normal";
+    case TP_LOW:
+        return "low";
+    default:
+        return "unknown";
+    }
+}
+
 }
@@ -16,8 +16,10 @@
 #pragma once
 
 #include <atomic>
+#include <vector>
 
 #include "arpc/common/LockFreeQueue.h"
+#include "autil/Lock.h"
 #include "navi/common.h"
 #include "navi/engine/NaviThreadPool.h"
 
@@ -38,6 +40,15 @@ struct TaskQueueStat {
     size_t queueCountRatio = 0;
 };
 
+// admission counters are reset after each getClassStat
+struct TaskQueueClassStat {
+    size_t queueCount = 0;
+    size_t admitCount = 0;
+    size_t rejectCount = 0;
+    size_t expireCount = 0;
+    size_t shedCount = 0;
+};
+
 class TaskQueueScheduleItemBase : public NaviThreadPoolItemBase {
 public:
     TaskQueueScheduleItemBase();
@@ -48,9 +59,21 @@ public:
 public:
     bool syncMode() const override { return _sync; }
     void setSyncMode(bool sync) { _sync = sync; }
+    void setPriority(TaskPriority priority) { _priority = priority; }
+    TaskPriority getPriority() const { return _priority; }
+    // absolute time in us, 0 for no deadline
+    void setDeadline(int64_t deadline) { _deadline = deadline; }
+    int64_t getDeadline() const { return _deadline; }
+    void setDeadlineByTimeout(int64_t timeoutMs);
 
 private:
     bool _sync = false;
+    TaskPriority _priority = TP_NORMAL;
+    int64_t _deadline = 0;
+    uint64_t _sequence = 0;
+
+private:
+    friend class TaskQueue;
 };
 
 class TaskQueue {
@@ -67,12 +90,34 @@ public:
     NaviThreadPool *getThreadPool() const { return _threadPool.get(); }
     void scheduleNext();
     TaskQueueStat getStat() const;
+    TaskQueueClassStat getClassStat(TaskPriority priority);
     size_t getProcessingCount() const { return atomic_read(&_processingCount); }
+    bool prioritySchedule() const { return _prioritySchedule; }
+    size_t getQueueCount() const;
+
+public:
+    static const char *getPriorityName(TaskPriority priority);
+
+private:
+    struct ClassQueue {
+        std::vector<TaskQueueScheduleItemBase *> heap;
+        std::atomic<size_t> admitCount{0};
+        std::atomic<size_t> rejectCount{0};
+        std::atomic<size_t> expireCount{0};
+        std::atomic<size_t> shedCount{0};
+    };
 
 private:
     virtual void schedule(); // virtual for test
+    void schedulePriority();
+    void pushPriority(TaskQueueScheduleItemBase *item);
+    TaskQueueScheduleItemBase *popExpired(int64_t now);
+    TaskQueueScheduleItemBase *popPriority(int64_t now);
+    void dispatch(TaskQueueScheduleItemBase *item);
     void incProcessingCount();
     void decProcessingCount();
+    static bool laterThan(const TaskQueueScheduleItemBase *lhs,
+                          const TaskQueueScheduleItemBase *rhs);
 
 private:
     TestMode _testMode;
@@ -82,6 +127,13 @@ private:
     size_t _processingMax = 0;
     size_t _scheduleQueueMax = 0;
     arpc::common::LockFreeQueue<TaskQueueScheduleItemBase *> _scheduleQueue;
+    // priority schedule only, one deadline heap per class
+    bool _prioritySchedule = false;
+    bool _shedExpired = false;
+    mutable autil::ThreadMutex _priorityLock;
+    ClassQueue _classQueues[TP_COUNT];
+    std::atomic<size_t> _priorityQueueCount{0};
+    uint64_t _sequence = 0;
 };
 
 NAVI_TYPEDEF_PTR(TaskQueue);
@@ -0,0 +1,109 @@
+#include "navi/engine/NaviThreadPool.h"
+
+#include "navi/config/NaviConfig.h"
+#include "unittest/unittest.h"
+#include <atomic>
+
+using namespace std;
+using namespace testing;
+
+namespace navi {
+
+class CountItem : public NaviThreadPoolItemBase {
+public:
+    CountItem(NaviThreadPool *pool, std::atomic<int32_t> *counter, int32_t depth)
+        : _pool(pool)
+        , _counter(counter)
+        , _depth(depth)
+    {
+    }
+
+public:
+    void process() override {
+        if (_depth > 0) {
+            for (size_t i = 0; i < 2; i++) {
+                auto child = new CountItem(_pool, _counter, _depth - 1);
+                child->setNumaNode(getNumaNode());
+                _pool->push(child);
+            }
+        }
+        (*_counter)++;
+    }
+    void destroy() override { delete this; }
+
+private:
+    NaviThreadPool *_pool;
+    std::atomic<int32_t> *_counter;
+    int32_t _depth;
+};
+
+class NaviThreadPoolTest : public TESTBASE {
+public:
+    void runItems(bool workStealing);
+};
+
+void NaviThreadPoolTest::runItems(bool workStealing) {
+    ConcurrencyConfig config;
+    config.threadNum = 4;
+    config.workStealing = workStealing;
+    config.numaBind = false;
+    NaviThreadPool pool;
+    ASSERT_TRUE(pool.start(config, nullptr, "test"));
+    ASSERT_EQ(workStealing, pool.workStealing());
+    std::atomic<int32_t> counter(0);
+    size_t rootCount = 100;
+    for (size_t i = 0; i < rootCount; i++) {
+        auto item = new CountItem(&pool, &counter, 4);
+        item->setNumaNode(pool.selectNumaNode());
+        pool.push(item);
+    }
+    int32_t expect = rootCount * 31;
+    for (size_t i = 0; i < 1000 && counter.load() < expect; i++) {
+        usleep(10 * 1000);
+    }
+    ASSERT_EQ(expect, counter.load());
+    ASSERT_EQ(0u, pool.getQueueSize());
+
+    std::vector<NaviThreadPoolWorkerStat> statVec;
+    pool.collectWorkerStat(statVec);
+    if (!workStealing) {
+        ASSERT_TRUE(statVec.empty());
+    } else {
+        ASSERT_EQ(4u, statVec.size());
+        uint64_t total = 0;
+        for (const auto &stat : statVec) {
+            ASSERT_GT(pool.getNumaNodeCount(), (size_t)stat.node);
+            total += stat.localPopCount + stat.stealCount + stat.remoteStealCount;
+        }
+        ASSERT_EQ(expect, total);
+        statVec.clear();
+        pool.collectWorkerStat(statVec);
+        for (const auto &stat : statVec) {
+            ASSERT_EQ(0u, stat.localPopCount + stat.stealCount + stat.remoteStealCount);
+        }
+    }
+    pool.stop();
+}
+
+TEST_F(NaviThreadPoolTest, testSharedQueue) { runItems(false); }
+
+TEST_F(NaviThreadPoolTest, testWorkStealing) { runItems(true); }
+
+TEST_F(NaviThreadPoolTest, testSelectNumaNode) {
+    NaviThreadPool pool;
+    ConcurrencyConfig config;
+    config.threadNum = 2;
+    ASSERT_TRUE(pool.start(config, nullptr, "test"));
+    ASSERT_EQ(-1, pool.selectNumaNode());
+    pool.stop();
+
+    NaviThreadPool stealingPool;
+    config.workStealing = true;
+    ASSERT_TRUE(stealingPool.start(config, nullptr, "test"));
+    auto node = stealingPool.selectNumaNode();
+    ASSERT_LE(0, node);
+    ASSERT_GT(stealingPool.getNumaNodeCount(), (size_t)node);
+    stealingPool.stop();
+}
+
+} // namespace navi
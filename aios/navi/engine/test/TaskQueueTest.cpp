@@ -1,5 +1,7 @@
 #include "navi/engine/TaskQueue.h"
 
+#include "autil/TimeUtility.h"
+#include "navi/config/NaviConfig.h"
 #include "unittest/unittest.h"
 
 using namespace std;
@@ -95,4 +97,112 @@ TEST_F(TaskQueueTest, testScheduleNext) {
     ASSERT_EQ(0, taskQueue.getProcessingCount());
 }
 
+TEST_F(TaskQueueTest, testPrioritySchedule) {
+    TaskQueue taskQueue;
+    ConcurrencyConfig config;
+    config.threadNum = 1;
+    config.prioritySchedule = true;
+    ASSERT_TRUE(taskQueue.init("test", config, TM_KERNEL_TEST));
+    ASSERT_TRUE(taskQueue.prioritySchedule());
+    taskQueue._processingMax = 0;
+    taskQueue._scheduleQueueMax = 10;
+
+    auto now = autil::TimeUtility::currentTime();
+    StrictMock<MockTaskQueueScheduleItemBase> lowItem;
+    lowItem.setPriority(TP_LOW);
+    lowItem.setDeadline(now + 1000);
+    StrictMock<MockTaskQueueScheduleItemBase> normalNoDeadline;
+    StrictMock<MockTaskQueueScheduleItemBase> normalLate;
+    normalLate.setDeadline(now + 20 * 1000 * 1000);
+    StrictMock<MockTaskQueueScheduleItemBase> normalEarly;
+    normalEarly.setDeadline(now + 10 * 1000 * 1000);
+    StrictMock<MockTaskQueueScheduleItemBase> highItem;
+    highItem.setPriority(TP_HIGH);
+
+    ASSERT_TRUE(taskQueue.push(&lowItem));
+    ASSERT_TRUE(taskQueue.push(&normalNoDeadline));
+    ASSERT_TRUE(taskQueue.push(&normalLate));
+    ASSERT_TRUE(taskQueue.push(&normalEarly));
+    ASSERT_TRUE(taskQueue.push(&highItem));
+    ASSERT_EQ(5u, taskQueue.getQueueCount());
+    ASSERT_EQ(5u, taskQueue.getStat().queueCount);
+
+    {
+        InSequence seq;
+        EXPECT_CALL(highItem, process()).WillOnce(Return());
+        EXPECT_CALL(highItem, destroy()).WillOnce(Return());
+        EXPECT_CALL(normalEarly, process()).WillOnce(Return());
+        EXPECT_CALL(normalEarly, destroy()).WillOnce(Return());
+        EXPECT_CALL(normalLate, process()).WillOnce(Return());
+        EXPECT_CALL(normalLate, destroy()).WillOnce(Return());
+        EXPECT_CALL(normalNoDeadline, process()).WillOnce(Return());
+        EXPECT_CALL(normalNoDeadline, destroy()).WillOnce(Return());
+        EXPECT_CALL(lowItem, process()).WillOnce(Return());
+        EXPECT_CALL(lowItem, destroy()).WillOnce(Return());
+    }
+    taskQueue._processingMax = 5;
+    for (size_t i = 0; i < 5; i++) {
+        taskQueue.schedule();
+    }
+    ASSERT_EQ(0u, taskQueue.getQueueCount());
+    ASSERT_EQ(5, taskQueue.getProcessingCount());
+
+    auto highStat = taskQueue.getClassStat(TP_HIGH);
+    ASSERT_EQ(1u, highStat.admitCount);
+    auto normalStat = taskQueue.getClassStat(TP_NORMAL);
+    ASSERT_EQ(3u, normalStat.admitCount);
+    ASSERT_EQ(0u, normalStat.queueCount);
+    ASSERT_EQ(0u, taskQueue.getClassStat(TP_NORMAL).admitCount);
+    atomic_set(&taskQueue._processingCount, 0);
+}
+
+TEST_F(TaskQueueTest, testShedExpired) {
+    TaskQueue taskQueue;
+    ConcurrencyConfig config;
+    config.threadNum = 1;
+    config.prioritySchedule = true;
+    config.shedExpired = true;
+    ASSERT_TRUE(taskQueue.init("test", config, TM_KERNEL_TEST));
+    taskQueue._processingMax = 0;
+    taskQueue._scheduleQueueMax = 10;
+
+    auto now = autil::TimeUtility::currentTime();
+    StrictMock<MockTaskQueueScheduleItemBase> expiredItem;
+    expiredItem.setPriority(TP_LOW);
+    expiredItem.setDeadline(now - 1000);
+    StrictMock<MockTaskQueueScheduleItemBase> liveItem;
+    liveItem.setDeadline(now + 10 * 1000 * 1000);
+    ASSERT_TRUE(taskQueue.push(&liveItem));
+
+    // expired item dispatched even if processing count exceeds
+    EXPECT_CALL(expiredItem, process()).WillOnce(Return());
+    EXPECT_CALL(expiredItem, destroy()).WillOnce(Return());
+    ASSERT_TRUE(taskQueue.push(&expiredItem));
+    ASSERT_EQ(1u, taskQueue.getQueueCount());
+    auto lowStat = taskQueue.getClassStat(TP_LOW);
+    ASSERT_EQ(1u, lowStat.expireCount);
+    ASSERT_EQ(1u, lowStat.shedCount);
+
+    EXPECT_CALL(liveItem, process()).WillOnce(Return());
+    EXPECT_CALL(liveItem, destroy()).WillOnce(Return());
+    taskQueue._processingMax = 2;
+    taskQueue.schedule();
+    ASSERT_EQ(0u, taskQueue.getQueueCount());
+    atomic_set(&taskQueue._processingCount, 0);
+}
+
+TEST_F(TaskQueueTest, testRejectStat) {
+    StrictMock<MockTaskQueue> taskQueue;
+    taskQueue._testMode = TM_NONE;
+    taskQueue._processingMax = 0;
+    taskQueue._scheduleQueueMax = 0;
+    StrictMock<MockTaskQueueScheduleItemBase> item;
+    item.setPriority(TP_HIGH);
+    EXPECT_CALL(item, destroy()).WillOnce(Return());
+    ASSERT_FALSE(taskQueue.push(&item));
+    auto stat = taskQueue.getClassStat(TP_HIGH);
+    ASSERT_EQ(1u, stat.rejectCount);
+    ASSERT_EQ(0u, stat.admitCount);
+}
+
 } // namespace navi
@@ -0,0 +1,112 @@
+#include "navi/builder/GraphBuilder.h"
+#include "navi/engine/RunGraphParams.h"
+#include "navi/example/TestData.h"
+#include "navi/test_cluster/NaviGraphRunner.h"
+#include "unittest/unittest.h"
+
+using namespace std;
+using namespace testing;
+
+namespace navi {
+
+class RunFusedGraphTest : public TESTBASE {
+public:
+    void setUp();
+    void tearDown();
+
+protected:
+    void runChain(bool fuse, bool collectPerf, std::vector<std::string> &result,
+                  std::vector<std::string> &traces);
+    static size_t countTrace(const std::vector<std::string> &traces, const std::string &pattern);
+};
+
+void RunFusedGraphTest::setUp() {}
+
+void RunFusedGraphTest::tearDown() {}
+
+void RunFusedGraphTest::runChain(bool fuse, bool collectPerf, std::vector<std::string> &result,
+                                 std::vector<std::string> &traces)
+{
+    NaviGraphRunner naviGraphRunner;
+    ASSERT_TRUE(naviGraphRunner.init());
+
+    auto graphDef = std::make_unique<GraphDef>();
+    {
+        GraphBuilder builder(graphDef.get());
+        builder.newSubGraph(naviGraphRunner.getBizName());
+        builder.fuseLinearChain(fuse);
+        auto source = builder.node("source").kernel("SourceKernel").jsonAttrs(R"json({"times" : 5})json");
+        auto identity1 = builder.node("identity1").kernel("IdentityTestKernel");
+        auto identity2 = builder.node("identity2").kernel("IdentityTestKernel");
+        source.out("output1").to(identity1.in("input1"));
+        identity1.out("output1").to(identity2.in("input1"));
+        identity2.out("output1").asGraphOutput("o");
+        ASSERT_TRUE(builder.ok());
+    }
+    RunGraphParams params;
+    params.setTimeoutMs(2000000);
+    // fusion is traced at SCHEDULE1 when the sub graph is initialized
+    params.setTraceLevel("SCHEDULE1");
+    params.setCollectMetric(true);
+    params.setCollectPerf(collectPerf);
+    auto naviUserResult = naviGraphRunner.runLocalGraph(graphDef.release(), params, {});
+    ASSERT_NE(nullptr, naviUserResult);
+    while (true) {
+        NaviUserData data;
+        bool eof = false;
+        ASSERT_TRUE(naviUserResult->nextData(data, eof));
+        if (data.data) {
+            auto helloData = dynamic_cast<HelloData *>(data.data.get());
+            ASSERT_NE(nullptr, helloData);
+            const auto &values = helloData->getData();
+            result.insert(result.end(), values.begin(), values.end());
+        }
+        if (eof) {
+            break;
+        }
+    }
+    auto naviResult = naviUserResult->getNaviResult();
+    ASSERT_NE(nullptr, naviResult);
+    ASSERT_EQ(EC_NONE, naviResult->getErrorCode()) << naviResult->getErrorMessage();
+    naviResult->collectTrace(traces);
+}
+
+size_t RunFusedGraphTest::countTrace(const std::vector<std::string> &traces, const std::string &pattern) {
+    size_t count = 0;
+    for (const auto &trace : traces) {
+        if (trace.find(pattern) != std::string::npos) {
+            count++;
+        }
+    }
+    return count;
+}
+
+TEST_F(RunFusedGraphTest, testFusedChain) {
+    std::vector<std::string> expected;
+    {
+        std::vector<std::string> traces;
+        ASSERT_NO_FATAL_FAILURE(runChain(false, false, expected, traces));
+        ASSERT_FALSE(traces.empty());
+        ASSERT_EQ(0u, countTrace(traces, "fuse node ["));
+        ASSERT_EQ(0u, countTrace(traces, "fused ["));
+    }
+    ASSERT_EQ(5u, expected.size());
+    for (bool collectPerf : {false, true}) {
+        std::vector<std::string> result;
+        std::vector<std::string> traces;
+        ASSERT_NO_FATAL_FAILURE(runChain(true, collectPerf, result, traces));
+        // both identity nodes are fused after their producers
+        ASSERT_EQ(1u, countTrace(traces, "fuse node [identity1] after producer [source]"));
+        ASSERT_EQ(1u, countTrace(traces, "fuse node [identity2] after producer [identity1]"));
+        ASSERT_EQ(1u, countTrace(traces, "fused [2] nodes in linear chains"));
+        ASSERT_EQ(expected.size(), result.size()) << "collectPerf: " << collectPerf;
+        for (size_t i = 0; i < result.size(); i++) {
+            // data is "<query id>_<node name>_<compute count>", query id differs between runs
+            auto pos = result[i].find('_');
+            ASSERT_NE(std::string::npos, pos);
+            ASSERT_EQ(expected[i].substr(expected[i].find('_')), result[i].substr(pos));
+        }
+    }
+}
+
+} // namespace navi
@@ -39,6 +39,13 @@ NaviUserResultPtr NaviGraphRunner::runLocalGraph(GraphDef *graphDef,
     return _navi->runLocalGraph(graphDef, params, resourceMap);
 }
 
+NaviUserResultPtr NaviGraphRunner::runLocalGraph(GraphDef *graphDef,
+                                                 const RunGraphParams &params,
+                                                 const ResourceMap &resourceMap) {
+    assert(_navi);
+    return _navi->runLocalGraph(graphDef, params, resourceMap);
+}
+
 void NaviGraphRunner::runLocalGraphAsync(GraphDef *graphDef,
                                          const ResourceMap &resourceMap,
                                          NaviUserResultClosure *closure,
@@ -17,6 +17,9 @@ public:
                                     const ResourceMap &resourceMap,
                                     const std::string &taskQueueName = "",
                                     int64_t timeoutMs = 2000000);
+    NaviUserResultPtr runLocalGraph(GraphDef *graphDef,
+                                    const RunGraphParams &params,
+                                    const ResourceMap &resourceMap);
     void runLocalGraphAsync(GraphDef *graphDef,
                             const ResourceMap &resourceMap,
                             NaviUserResultClosure *closure,
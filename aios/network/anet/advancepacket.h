@@ -230,6 +230,12 @@ public:
     virtual bool encode(DataBuffer *output);
     virtual bool decode(DataBuffer *input, PacketHeader *header);
 
+    /* The advance header and checksum only come out of encode(), so a body
+     * that T exposes is encoded again as a whole into the packet buffer. */
+    virtual bool getWritePayload(size_t minPayloadLen, struct iovec &payload) {
+        return T::getWritePayload(minPayloadLen, payload) && Packet::encodeWritePayload(payload);
+    }
+
     /* Get channel id by combing the chid field in Packet and chidHigh field
      * in AdvancePacket. */
     virtual uint64_t getChannelId(void) {
@@ -122,6 +122,16 @@ bool DefaultPacket::encode(DataBuffer *output) {
     return true;
 }
 
+bool DefaultPacket::getWritePayload(size_t minPayloadLen, struct iovec &payload) {
+    // encode() writes the body as is, so it can be sent straight from _body
+    if (_bodyLength == 0 || (size_t)_bodyLength < minPayloadLen) {
+        return false;
+    }
+    payload.iov_base = _body;
+    payload.iov_len = _bodyLength;
+    return true;
+}
+
 bool DefaultPacket::decode(DataBuffer *input, PacketHeader *header) {
     assert(input->getDataLen() >= header->_dataLen);
     bool rc = setBody(input->getData(), header->_dataLen);
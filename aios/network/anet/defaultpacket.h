@@ -46,6 +46,7 @@ public:
     char *getBody();
 
     bool encode(DataBuffer *output);
+    bool getWritePayload(size_t minPayloadLen, struct iovec &payload);
     bool decode(DataBuffer *input, PacketHeader *header);
 
     int64_t getSpaceUsed();
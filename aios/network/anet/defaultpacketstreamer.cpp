@@ -126,6 +126,22 @@ bool DefaultPacketStreamer::encode(Packet *packet, DataBuffer *output) {
     return true;
 }
 
+bool DefaultPacketStreamer::encode(Packet *packet, DataBuffer *output, size_t minPayloadLen, struct iovec &payload) {
+    if (!_existPacketHeader || minPayloadLen == 0 || !packet->getWritePayload(minPayloadLen, payload) ||
+        payload.iov_len < minPayloadLen || payload.iov_len > (size_t)max_package_size) {
+        payload.iov_base = NULL;
+        payload.iov_len = 0;
+        return encode(packet, output);
+    }
+    PacketHeader *header = packet->getPacketHeader();
+    header->_dataLen = (int32_t)payload.iov_len;
+    output->writeInt32(ANET_PACKET_FLAG);
+    output->writeInt32(header->_chid);
+    output->writeInt32(header->_pcode);
+    output->writeInt32(header->_dataLen);
+    return true;
+}
+
 bool DefaultPacketStreamer::processData(DataBuffer *dataBuffer, StreamingContext *context) {
     Packet *packet = context->getPacket();
     if (NULL == packet) {
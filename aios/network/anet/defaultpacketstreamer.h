@@ -55,6 +55,18 @@ public:
      */
     bool encode(Packet *packet, DataBuffer *output);
 
+    /**
+     * encode a packet header into output data buffer and return a large
+     * body as payload so it can be written without copying
+     *
+     * @param packet packet to be encoded
+     * @param output output data buffer
+     * @param minPayloadLen bodies shorter than this are copied into output
+     * @param payload body to be written right after output
+     * @return return true if we finished encode. return false if not
+     */
+    bool encode(Packet *packet, DataBuffer *output, size_t minPayloadLen, struct iovec &payload);
+
     bool processData(DataBuffer *dataBuffer, StreamingContext *context);
 };
 } // namespace anet
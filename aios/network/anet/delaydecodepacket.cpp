@@ -44,6 +44,7 @@ DelayDecodePacket::~DelayDecodePacket() {
 void DelayDecodePacket::setContent(DataBufferSerializable *content, bool ownContent) {
     assert(content);
     clearContent();
+    clearWritePayload();
     _content = content;
     setContentOwnership(ownContent);
 }
@@ -68,6 +69,15 @@ bool DelayDecodePacket::encode(DataBuffer *output) {
     return false;
 }
 
+bool DelayDecodePacket::getWritePayload(size_t minPayloadLen, struct iovec &payload) {
+    // 0 means the content does not know its size without serializing
+    if (_content == NULL || minPayloadLen == 0 || _content->getSerializedSize() < minPayloadLen) {
+        return false;
+    }
+    // encode() is virtual, packets framing the content are encoded as a whole
+    return encodeWritePayload(payload);
+}
+
 // header is deprecated pamameter
 bool DelayDecodePacket::decode(DataBuffer *input, PacketHeader *header) {
     assert(input);
@@ -135,6 +145,9 @@ int64_t DelayDecodePacket::getSpaceUsed() {
     if (ownContent() && _content) {
         spaceUsed += _content->getSpaceUsed();
     }
+    if (_writeBuffer) {
+        spaceUsed += _writeBuffer->getDataLen();
+    }
     return spaceUsed;
 }
 
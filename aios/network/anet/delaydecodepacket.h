@@ -60,6 +60,10 @@ public:
 
     bool encode(DataBuffer *output);
 
+    // serialize the content into a buffer owned by this packet when its
+    // serialized size is known to reach minPayloadLen
+    bool getWritePayload(size_t minPayloadLen, struct iovec &payload);
+
     bool decode(DataBuffer *input, PacketHeader *header);
 
     // decode the content from 'data' in databuffer
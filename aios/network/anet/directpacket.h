@@ -81,6 +81,9 @@ public:
     int32_t getPayloadSizeFromHeader() const { return _directHeader._payloadSize; }
     int32_t getToReceiveSizeFromHeader() const { return _directHeader._toReceiveSize; }
 
+    // direct packets are written by DirectPacketStreamer with their own header
+    bool getWritePayload(size_t minPayloadLen, struct iovec &payload) { return false; }
+
     using DefaultPacket::decode;
     bool decode(DataBuffer *input, DirectPacketHeader *header);
 
@@ -93,6 +93,7 @@ public:
     virtual ~HTTPPacket();
 
     bool encode(DataBuffer *output);
+    bool getWritePayload(size_t minPayloadLen, struct iovec &payload) { return false; }
     bool encodeStartLine(DataBuffer *output);
     bool encodeHeaders(DataBuffer *output);
     bool encodeBody(DataBuffer *output);
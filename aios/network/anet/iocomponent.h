@@ -260,6 +260,13 @@ public:
 
     IocType getType() const { return _type; }
 
+    /*
+     * pin the component to an io worker instead of hashing its fd,
+     * must be called before init(), -1 means not pinned
+     */
+    void setIoWorkerIdx(int idx) { _ioWorkerIdx = idx; }
+    int getIoWorkerIdx() const { return _ioWorkerIdx; }
+
 protected:
     /**
      * Transport distribute ioworker based on socket fd
@@ -287,6 +294,7 @@ protected:
     ThreadMutex _socketMutex;
     IocType _type;
     IoWorker *_belongedWorker;
+    int _ioWorkerIdx;
 
 private:
     IOComponent *_prev; // 用于链表
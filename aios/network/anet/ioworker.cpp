@@ -31,6 +31,7 @@
 #include "aios/network/anet/iocomponent.h"
 #include "aios/network/anet/log.h"
 #include "aios/network/anet/socketevent.h"
+#include "aios/network/anet/stats.h"
 #include "aios/network/anet/tcpcomponent.h"
 #include "aios/network/anet/thread.h"
 #include "aios/network/anet/threadmutex.h"
@@ -127,6 +128,11 @@ void IoWorker::step(int64_t timeStamp) {
         ioc->updateUseTime(timeStamp);
     }
     processCommands();
+    atomic_inc(&_stat._loopCnt);
+    if (cnt > 0) {
+        atomic_add(cnt, &_stat._eventCnt);
+        atomic_add(TimeUtil::getTime() - _loopTime, &_stat._busyTime);
+    }
 }
 
 void IoWorker::postCommand(const Transport::CommandType type, IOComponent *ioc) {
@@ -188,6 +194,7 @@ void IoWorker::addComponent(IOComponent *ioc) {
     _iocListTail = ioc;
     ioc->addRef();
     ioc->referencedByReadWriteThread(true);
+    atomic_inc(&_stat._componentCnt);
 }
 
 void IoWorker::removeComponent(IOComponent *ioc) {
@@ -209,6 +216,7 @@ void IoWorker::removeComponent(IOComponent *ioc) {
         ioc->_next->_prev = ioc->_prev;
     ioc->referencedByReadWriteThread(false);
     ioc->subRef();
+    atomic_dec(&_stat._componentCnt);
 }
 
 void IoWorker::closeComponents() {
@@ -222,6 +230,7 @@ void IoWorker::closeComponents() {
         ioc->subRef();
     }
     _iocListHead = _iocListTail = NULL;
+    atomic_set(&_stat._componentCnt, 0);
 
     for (std::vector<Transport::TransportCommand>::iterator it = _commands.begin(); it != _commands.end(); ++it) {
         ANET_LOG(DEBUG, "IOC(%p)->subRef(), [%d]", it->ioc, it->ioc->getRef());
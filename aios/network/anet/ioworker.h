@@ -24,6 +24,7 @@
 #include "aios/network/anet/iocomponent.h"
 #include "aios/network/anet/runnable.h"
 #include "aios/network/anet/socket.h"
+#include "aios/network/anet/stats.h"
 #include "aios/network/anet/thread.h"
 #include "aios/network/anet/threadmutex.h"
 #include "aios/network/anet/transport.h"
@@ -100,6 +101,7 @@ public:
     void postCommand(const Transport::CommandType type, IOComponent *ioc);
 
     SocketEvent *getSocketEvent();
+    ReactorStatCounter *getStat() { return &_stat; }
     void closeComponents();
     int dump(std::ostringstream &buf);
     void getTcpConnStats(std::vector<ConnStat> &connStats);
@@ -127,6 +129,7 @@ private:
     IOComponent *_iocListHead, *_iocListTail; // IOComponent list
     std::vector<Transport::TransportCommand> _commands;
     int _epollWaitTimeoutMs{100};
+    ReactorStatCounter _stat;
 
 public:
     static __thread int64_t _loopTime;
@@ -15,6 +15,9 @@
  */
 #ifndef ANET_IPACKETSTREAMER_H_
 #define ANET_IPACKETSTREAMER_H_
+#include <stddef.h>
+#include <sys/uio.h>
+
 #include "aios/network/anet/controlpacket.h"
 #include "aios/network/anet/ipacketfactory.h"
 
@@ -67,6 +70,25 @@ public:
      */
     virtual bool encode(Packet *packet, DataBuffer *output) = 0;
 
+    /*
+     * Encode a packet for a gather write. Streamers that support it
+     * write only the packet header into output and return a body of
+     * at least minPayloadLen bytes in payload, which must be sent
+     * right after output. payload.iov_len is 0 if everything has been
+     * written into output.
+     *
+     * @param packet 数据包
+     * @param output 组装后的数据流
+     * @param minPayloadLen 不拷贝发送的最小包体长度
+     * @param payload 不拷贝发送的包体
+     * @return 是否成功
+     */
+    virtual bool encode(Packet *packet, DataBuffer *output, size_t minPayloadLen, struct iovec &payload) {
+        payload.iov_base = NULL;
+        payload.iov_len = 0;
+        return encode(packet, output);
+    }
+
     /*
      * 是否有数据包头
      */
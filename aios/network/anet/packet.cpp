@@ -17,6 +17,7 @@
 
 #include "aios/network/anet/channel.h"
 #include "aios/network/anet/common.h"
+#include "aios/network/anet/databuffer.h"
 #include "aios/network/anet/ipackethandler.h"
 #include "aios/network/anet/timeutil.h"
 
@@ -28,10 +29,29 @@ Packet::Packet() {
     _expireTime = 0;
     _timeoutMs = 0;
     _packetDequeueCB = NULL;
+    _writeBuffer = NULL;
     memset(&_packetHeader, 0, sizeof(PacketHeader));
 }
 
-Packet::~Packet() {}
+Packet::~Packet() { clearWritePayload(); }
+
+bool Packet::encodeWritePayload(struct iovec &payload) {
+    if (_writeBuffer == NULL) {
+        _writeBuffer = new DataBuffer();
+        if (!encode(_writeBuffer)) {
+            clearWritePayload();
+            return false;
+        }
+    }
+    payload.iov_base = _writeBuffer->getData();
+    payload.iov_len = _writeBuffer->getDataLen();
+    return true;
+}
+
+void Packet::clearWritePayload() {
+    delete _writeBuffer;
+    _writeBuffer = NULL;
+}
 
 void Packet::setChannel(Channel *channel) {
     if (channel) {
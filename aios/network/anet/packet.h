@@ -15,9 +15,11 @@
  */
 #ifndef ANET_PACKET_H_
 #define ANET_PACKET_H_
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/uio.h>
 
 #include "aios/network/anet/common.h"
 #include "aios/network/anet/connectionpriority.h"
@@ -87,6 +89,19 @@ public:
      */
     virtual bool encode(DataBuffer *output) = 0;
 
+    /**
+     * Expose the bytes encode() would write so that the streamer can
+     * hand them to the socket without copying them into the output
+     * DataBuffer. The memory must stay valid and unmodified until the
+     * packet is freed. Packets that override encode() must override
+     * this too, or keep the default that always copies.
+     *
+     * @param minPayloadLen payloads shorter than this are not exposed
+     * @param payload filled with the encoded bytes when supported
+     * @return Return true if the encoded bytes are exposed as payload.
+     */
+    virtual bool getWritePayload(size_t minPayloadLen, struct iovec &payload) { return false; }
+
     /**
      * Read data form DataBuffer according to the information in
      * PacketHeader and construct packet. The DataBuffer contains
@@ -186,6 +201,13 @@ protected:
      *       The callback will be invoked from the IO thread. */
     IPacketHandler *_packetDequeueCB;
     Packet *_next;
+
+    /* encode() into a buffer owned by the packet and expose it as payload,
+     * for packets that have no contiguous copy of their encoded bytes.
+     * The buffer is kept until the packet is freed or it is cleared. */
+    bool encodeWritePayload(struct iovec &payload);
+    void clearWritePayload();
+    DataBuffer *_writeBuffer;
 };
 
 END_ANET_NS();
@@ -19,6 +19,7 @@
 #include <assert.h>
 #include <fcntl.h>
 #include <netinet/in.h>
+#include <linux/errqueue.h>
 #include <netinet/tcp.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -37,6 +38,16 @@
 #include "aios/network/anet/log.h"
 #include "aios/network/anet/stats.h"
 
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+
 namespace anet {
 
 atomic64_t Socket::_globalAcceptConnCnt = {0};
@@ -217,6 +228,67 @@ int Socket::write(const void *data, int len) {
     return res;
 }
 
+int Socket::writev(const struct iovec *iov, int iovcnt, bool zeroCopy) {
+    if (_socketHandle == -1) {
+        return -1;
+    }
+    if (iov == NULL || iovcnt <= 0)
+        return -1;
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = const_cast<struct iovec *>(iov);
+    msg.msg_iovlen = iovcnt;
+    int flags = MSG_NOSIGNAL;
+    if (zeroCopy) {
+        flags |= MSG_ZEROCOPY;
+    }
+    int res = -1;
+    do {
+        res = ::sendmsg(_socketHandle, &msg, flags);
+        if (res > 0) {
+            ANET_COUNT_DATA_WRITE(res);
+        } else if (-1 == res && (errno != EINTR && errno != EAGAIN && errno != ENOBUFS)) {
+            writeErrInc();
+        }
+    } while (res < 0 && errno == EINTR);
+    return res;
+}
+
+bool Socket::setZeroCopy(bool on) { return setIntOption(SO_ZEROCOPY, on ? 1 : 0); }
+
+int Socket::readZeroCopyCompletion(uint32_t &lo, uint32_t &hi) {
+    if (_socketHandle == -1) {
+        return -1;
+    }
+    char control[CMSG_SPACE(sizeof(struct sock_extended_err)) + CMSG_SPACE(64)];
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    int res = -1;
+    do {
+        res = ::recvmsg(_socketHandle, &msg, MSG_ERRQUEUE | MSG_DONTWAIT);
+    } while (res < 0 && errno == EINTR);
+    if (res < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+    for (struct cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm != NULL; cm = CMSG_NXTHDR(&msg, cm)) {
+        if (!((cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) ||
+              (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR))) {
+            continue;
+        }
+        const struct sock_extended_err *serr = (const struct sock_extended_err *)CMSG_DATA(cm);
+        if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+            continue;
+        }
+        lo = serr->ee_info;
+        hi = serr->ee_data;
+        return 1;
+    }
+    return -1;
+}
+
 int Socket::read(void *data, int len) {
     if (_socketHandle == -1) {
         return -1;
@@ -20,6 +20,7 @@
 #include <stdint.h>
 #include <string>
 #include <sys/socket.h>
+#include <sys/uio.h>
 
 #include "aios/network/anet/addrspec.h"
 #include "aios/network/anet/atomic.h"
@@ -72,12 +73,35 @@ public:
     virtual int write(const void *data, int len);
     virtual int read(void *data, int len);
 
+    /*
+     * Gather write of iovcnt buffers with one sendmsg call. The
+     * buffers must not be modified until the zero copy completion
+     * is reaped when zeroCopy is true.
+     */
+    virtual int writev(const struct iovec *iov, int iovcnt, bool zeroCopy = false);
+
+    /*
+     * Enable SO_ZEROCOPY so that writev() can be called with zeroCopy.
+     */
+    virtual bool setZeroCopy(bool on);
+
+    /*
+     * Reap one zero copy completion notification from the error queue.
+     *
+     * @param lo first completed zero copy send
+     * @param hi last completed zero copy send
+     * @return 1 if a notification is reaped, 0 if none is pending, -1 on error
+     */
+    virtual int readZeroCopyCompletion(uint32_t &lo, uint32_t &hi);
+
     bool setKeepAlive(bool on) { return setIntOption(SO_KEEPALIVE, on ? 1 : 0); }
 
     bool setKeepAliveParameter(int idleTime, int keepInterval, int cnt);
 
     bool setReuseAddress(bool on) { return setIntOption(SO_REUSEADDR, on ? 1 : 0); }
 
+    bool setReusePort(bool on) { return setIntOption(SO_REUSEPORT, on ? 1 : 0); }
+
     bool setSoLinger(bool doLinger, int seconds);
 
     bool setTcpNoDelay(bool noDelay);
@@ -114,6 +138,8 @@ public:
 
     int getProtocolType(void) { return addr.getProtocolType(); }
 
+    const std::string &getAddrSpec() const { return _addrSpec; }
+
     /* Functions restructed from ServerSocket class */
     Socket *accept();
     bool listen(int backlog);
@@ -101,4 +101,35 @@ int64_t StatCounter::getOutputQueueSpaceUsed() { return atomic_read(&_outputQueu
 
 int64_t StatCounter::getOutputQueueSize() { return atomic_read(&_outputQueueSize); }
 
+ReactorStatCounter::ReactorStatCounter() { clear(); }
+
+ReactorStatCounter::~ReactorStatCounter() {}
+
+void ReactorStatCounter::clear() {
+    atomic_set(&_loopCnt, 0);
+    atomic_set(&_eventCnt, 0);
+    atomic_set(&_busyTime, 0);
+    atomic_set(&_acceptCnt, 0);
+    atomic_set(&_componentCnt, 0);
+}
+
+int ReactorStatCounter::dump(ostringstream &buf) {
+    buf << "loop count: " << atomic_read(&_loopCnt);
+    buf << "\tevent count: " << atomic_read(&_eventCnt);
+    buf << "\tbusy time: " << atomic_read(&_busyTime) << "us";
+    buf << "\taccept count: " << atomic_read(&_acceptCnt);
+    buf << "\tcomponent count: " << atomic_read(&_componentCnt) << endl;
+    return 0;
+}
+
+int64_t ReactorStatCounter::getLoopCnt() { return atomic_read(&_loopCnt); }
+
+int64_t ReactorStatCounter::getEventCnt() { return atomic_read(&_eventCnt); }
+
+int64_t ReactorStatCounter::getBusyTime() { return atomic_read(&_busyTime); }
+
+int64_t ReactorStatCounter::getAcceptCnt() { return atomic_read(&_acceptCnt); }
+
+int64_t ReactorStatCounter::getComponentCnt() { return atomic_read(&_componentCnt); }
+
 } // namespace anet
@@ -61,6 +61,31 @@ public:
     static StatCounter _gStatCounter;
 };
 
+/**
+ * Load counters of one io worker, updated by the worker thread and
+ * read by dump and monitoring threads.
+ */
+class ReactorStatCounter {
+public:
+    ReactorStatCounter();
+    ~ReactorStatCounter();
+    void clear();
+    int64_t getLoopCnt();
+    int64_t getEventCnt();
+    int64_t getBusyTime();
+    int64_t getAcceptCnt();
+    int64_t getComponentCnt();
+
+    int dump(std::ostringstream &buf);
+
+public:
+    atomic64_t _loopCnt;      // epoll wait rounds
+    atomic64_t _eventCnt;     // socket events handled
+    atomic64_t _busyTime;     // time spent handling events in us
+    atomic64_t _acceptCnt;    // connections accepted
+    atomic64_t _componentCnt; // components owned
+};
+
 #define ANET_GLOBAL_STAT StatCounter::_gStatCounter
 #define ANET_COUNT_PACKET_READ(i)                                                                                      \
     { atomic_add((i), &(ANET_GLOBAL_STAT._packetReadCnt)); }
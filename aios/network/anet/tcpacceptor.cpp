@@ -18,6 +18,7 @@
 #include <assert.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string>
 
 #include "aios/network/anet/connection.h"
 #include "aios/network/anet/controlpacket.h"
@@ -28,6 +29,7 @@
 #include "aios/network/anet/log.h"
 #include "aios/network/anet/socket.h"
 #include "aios/network/anet/socketevent.h"
+#include "aios/network/anet/stats.h"
 #include "aios/network/anet/tcpcomponent.h"
 #include "aios/network/anet/threadmutex.h"
 #include "aios/network/anet/transport.h"
@@ -77,6 +79,9 @@ bool TCPAcceptor::handleReadEvent() {
         ANET_LOG(DEBUG, "New connection coming. fd=%d", socket->getSocketHandle());
         TCPComponent *component = new TCPComponent(_owner, socket);
         assert(component);
+        atomic_inc(&_belongedWorker->getStat()->_acceptCnt);
+        // a sharded acceptor keeps its connections in its own io worker
+        component->setIoWorkerIdx(_ioWorkerIdx);
         component->setMaxIdleTime(_maxIdleTimeInMillseconds);
         if (!component->init(true)) {
             delete component; /**@TODO: may coredump?*/
@@ -103,8 +108,39 @@ bool TCPAcceptor::handleErrorEvent() {
     return false;
 }
 
+bool TCPAcceptor::addShard(int workerIdx) {
+    int port = _socket->getPort();
+    if (port < 0) {
+        return false;
+    }
+    // resolve an ephemeral port so every shard binds the same one
+    std::string spec = _socket->getAddrSpec();
+    spec = spec.substr(0, spec.rfind(':') + 1) + std::to_string(port);
+    Socket *socket = new Socket();
+    if (!socket->setAddrSpec(spec.c_str()) || !socket->setReusePort(true)) {
+        delete socket;
+        return false;
+    }
+    TCPAcceptor *shard =
+        new TCPAcceptor(_owner, socket, _streamer, _serverAdapter, _timeout, _maxIdleTimeInMillseconds, _backlog);
+    shard->setIoWorkerIdx(workerIdx);
+    if (!shard->init()) {
+        delete shard;
+        return false;
+    }
+    lock();
+    _shards.push_back(shard);
+    unlock();
+    return true;
+}
+
 void TCPAcceptor::close() {
     lock();
+    for (size_t i = 0; i < _shards.size(); i++) {
+        _shards[i]->close();
+        _shards[i]->subRef();
+    }
+    _shards.clear();
     if (getState() != ANET_CLOSED) {
         closeSocketNoLock();
         setState(ANET_CLOSED);
@@ -17,6 +17,7 @@
 #define ANET_TCPACCEPTOR_H_
 #include <ostream>
 #include <stdint.h>
+#include <vector>
 
 #include "aios/network/anet/iocomponent.h"
 
@@ -51,6 +52,12 @@ public:
 
     bool checkTimeout(int64_t now);
 
+    /**
+     * Open an acceptor on the same SO_REUSEPORT address in io worker
+     * workerIdx. It is closed together with this acceptor.
+     */
+    bool addShard(int workerIdx);
+
     virtual void dump(std::ostringstream &buf) {
         IOComponent::dump(buf);
         buf << "Type: TCPAcceptor" << std::endl;
@@ -58,6 +65,7 @@ public:
         buf << "Max Idle Time: " << _maxIdleTimeInMillseconds << "ms" << std::endl;
         buf << "Queue Timeout: " << _timeout << "ms" << std::endl;
         buf << "Backlog: " << _backlog << std::endl;
+        buf << "Shards: " << _shards.size() << std::endl;
     }
 
     /* for UT purpose */
@@ -69,6 +77,7 @@ private:
     int _timeout;
     int _maxIdleTimeInMillseconds;
     int _backlog;
+    std::vector<TCPAcceptor *> _shards;
 
     /* for testing purpose */
     IOComponent *_lastAcceptedComponent;
@@ -240,6 +240,12 @@ bool TCPComponent::handleWriteEvent() {
 bool TCPComponent::handleErrorEvent() {
     lock();
     ANET_LOG(DEBUG, "(IOC:%p)", this);
+    // zero copy completions are reported through the error queue
+    if (getState() == ANET_CONNECTED && static_cast<TCPConnection *>(_connection)->reapZeroCopyCompletion() &&
+        _socket->getSoError() == 0) {
+        unlock();
+        return true;
+    }
     // add stat ANET_CONNECTING when handle error for Ticket #23 by wanggf 200810162037
     if ((getState() == ANET_CONNECTED) || (getState() == ANET_CONNECTING)) {
         ANET_LOG(WARN, "Detect error event from (IOC:%p), state:%d, error:%d", this, getState(), _socket->getSoError());
@@ -15,6 +15,7 @@
  */
 #include "aios/network/anet/tcpconnection.h"
 
+#include <algorithm>
 #include <errno.h>
 #include <stdint.h>
 #include <string.h>
@@ -34,10 +35,24 @@
 #include "aios/network/anet/streamingcontext.h"
 #include "aios/network/anet/threadcond.h"
 #include "aios/network/anet/timeutil.h"
+#include "autil/EnvUtil.h"
 
 namespace anet {
 class IServerAdapter;
 
+const static size_t MAX_GATHER_PAYLOAD_COUNT = 32;
+
+// gather and zero copy write are off unless enabled, read env once as connections are created on every connect
+static size_t getDefaultGatherWriteSize() {
+    static const size_t gatherWriteSize = autil::EnvUtil::getEnv("ANET_GATHER_WRITE_SIZE", (size_t)0);
+    return gatherWriteSize;
+}
+
+static size_t getDefaultZeroCopyWriteSize() {
+    static const size_t zeroCopyWriteSize = autil::EnvUtil::getEnv("ANET_ZERO_COPY_WRITE_SIZE", (size_t)0);
+    return zeroCopyWriteSize;
+}
+
 TCPConnection::TCPConnection(Socket *socket, IPacketStreamer *streamer, IServerAdapter *serverAdapter)
     : Connection(socket, streamer, serverAdapter) {
     _gotHeader = false;
@@ -48,9 +63,20 @@ TCPConnection::TCPConnection(Socket *socket, IPacketStreamer *streamer, IServerA
     _outputBufferSpaceAllocated = 0;
     _maxRecvPacketSize = 0;
     _maxSendPacketSize = 0;
+    _gatherOutputLen = 0;
+    _zeroCopyEnabled = false;
+    _zeroCopySeq = 0;
+    setWriteSize(getDefaultGatherWriteSize(), getDefaultZeroCopyWriteSize());
+}
+
+void TCPConnection::setWriteSize(size_t gatherWriteSize, size_t zeroCopyWriteSize) {
+    _gatherWriteSize = gatherWriteSize;
+    // zero copy bodies are sent through the gather path
+    _zeroCopyWriteSize = gatherWriteSize == 0 ? 0 : zeroCopyWriteSize;
 }
 
 TCPConnection::~TCPConnection() {
+    freeGatherPackets();
     addInputBufferSpaceAllocated(0 - _input.getSpaceUsed());
     addOutputBufferSpaceAllocated(0 - _output.getSpaceUsed());
     ANET_ADD_OUTPUT_BUFFER_SPACE_USED(0 - _output.getDataLen());
@@ -59,13 +85,150 @@ TCPConnection::~TCPConnection() {
 void TCPConnection::clearOutputBuffer() {
     ANET_ADD_OUTPUT_BUFFER_SPACE_USED(0 - _output.getDataLen());
     _output.clear();
+    freeGatherPackets();
+}
+
+void TCPConnection::freeGatherPackets() {
+    for (size_t i = 0; i < _gatherQueue.size(); i++) {
+        _gatherQueue[i].packet->free();
+    }
+    _gatherQueue.clear();
+    _gatherOutputLen = 0;
+    for (size_t i = 0; i < _zeroCopyPackets.size(); i++) {
+        _zeroCopyPackets[i].second->free();
+    }
+    _zeroCopyPackets.clear();
+    // the zero copy counter is per socket, a reconnected socket starts over
+    _zeroCopyEnabled = false;
+    _zeroCopySeq = 0;
+}
+
+bool TCPConnection::reapZeroCopyCompletion() {
+    bool reaped = false;
+    uint32_t lo = 0;
+    uint32_t hi = 0;
+    while (_zeroCopyEnabled && _socket->readZeroCopyCompletion(lo, hi) > 0) {
+        reaped = true;
+        // tcp completes zero copy sends in order
+        while (!_zeroCopyPackets.empty() && (int32_t)(_zeroCopyPackets.front().first - hi) <= 0) {
+            _zeroCopyPackets.front().second->free();
+            _zeroCopyPackets.pop_front();
+        }
+    }
+    return reaped;
+}
+
+void TCPConnection::drainGather(size_t len) {
+    while (len > 0 && !_gatherQueue.empty()) {
+        GatherPayload &front = _gatherQueue.front();
+        if (front.outputLen > 0) {
+            size_t n = std::min(len, (size_t)front.outputLen);
+            _output.drainData(n);
+            ANET_ADD_OUTPUT_BUFFER_SPACE_USED(0 - (int64_t)n);
+            front.outputLen -= n;
+            _gatherOutputLen -= n;
+            len -= n;
+            continue;
+        }
+        size_t n = std::min(len, front.len - front.written);
+        front.written += n;
+        len -= n;
+        if (front.written == front.len) {
+            if (front.zeroCopy) {
+                _zeroCopyPackets.push_back(std::make_pair(front.zeroCopySeq, front.packet));
+            } else {
+                front.packet->free();
+            }
+            _gatherQueue.pop_front();
+        }
+    }
+    if (len > 0) {
+        _output.drainData(len);
+        ANET_ADD_OUTPUT_BUFFER_SPACE_USED(0 - (int64_t)len);
+    }
+}
+
+int TCPConnection::writeGather(int &error, bool &drained) {
+    struct iovec iov[2 * MAX_GATHER_PAYLOAD_COUNT + 1];
+    int iovcnt = 0;
+    bool zeroCopy = false;
+    GatherPayload &front = _gatherQueue.front();
+    if (front.zeroCopy && front.outputLen == 0 && !_zeroCopyEnabled) {
+        _zeroCopyEnabled = _socket->setZeroCopy(true);
+        if (!_zeroCopyEnabled) {
+            char spec[32];
+            ANET_LOG(WARN, "Connection (%s) enable zero copy failed, fall back to copy", _socket->getAddr(spec, 32));
+            _zeroCopyWriteSize = 0;
+            for (size_t i = 0; i < _gatherQueue.size(); i++) {
+                _gatherQueue[i].zeroCopy = false;
+            }
+        }
+    }
+    if (front.zeroCopy && front.outputLen == 0) {
+        // MSG_ZEROCOPY pins every buffer of the call, so send the body
+        // alone to keep _output reusable right after the write
+        iov[iovcnt].iov_base = (void *)(front.data + front.written);
+        iov[iovcnt].iov_len = front.len - front.written;
+        iovcnt++;
+        zeroCopy = true;
+    } else {
+        const char *data = _output.getData();
+        int64_t offset = 0;
+        bool stopped = false;
+        for (size_t i = 0; i < _gatherQueue.size(); i++) {
+            const GatherPayload &gather = _gatherQueue[i];
+            if (gather.outputLen > 0) {
+                iov[iovcnt].iov_base = (void *)(data + offset);
+                iov[iovcnt].iov_len = gather.outputLen;
+                iovcnt++;
+                offset += gather.outputLen;
+            }
+            if (gather.zeroCopy) {
+                stopped = true;
+                break;
+            }
+            iov[iovcnt].iov_base = (void *)(gather.data + gather.written);
+            iov[iovcnt].iov_len = gather.len - gather.written;
+            iovcnt++;
+        }
+        if (!stopped && _output.getDataLen() > offset) {
+            iov[iovcnt].iov_base = (void *)(data + offset);
+            iov[iovcnt].iov_len = _output.getDataLen() - offset;
+            iovcnt++;
+        }
+    }
+
+    size_t total = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        total += iov[i].iov_len;
+    }
+    int ret = _socket->writev(iov, iovcnt, zeroCopy);
+    drained = ret > 0 && (size_t)ret == total;
+    if (ret > 0) {
+        if (zeroCopy) {
+            front.zeroCopySeq = _zeroCopySeq++;
+        }
+        drainGather(ret);
+        _stats.totalTxBytes += ret;
+    } else {
+        int lastError = Socket::getLastError();
+        error = _socket->getSoError();
+        if (zeroCopy && error == 0 && lastError == ENOBUFS) {
+            // out of optmem for pinned pages, copy this body instead
+            front.zeroCopy = false;
+        }
+    }
+    return ret;
 }
 
 bool TCPConnection::writeData() {
+    if (!_zeroCopyPackets.empty()) {
+        reapZeroCopyCompletion();
+    }
     // to reduce the odds of blocking postPacket()
     _outputCond.lock();
     _outputQueue.moveTo(&_myQueue);
-    if (_myQueue.size() == 0 && _output.getDataLen() == 0) {
+    if (_myQueue.size() == 0 && _output.getDataLen() == 0 && _gatherQueue.empty()) {
         ANET_LOG(DEBUG, "IOC(%p)->enableWrite(false)", _iocomponent);
         _iocomponent->enableWrite(false);
         _outputCond.unlock();
@@ -79,10 +242,11 @@ bool TCPConnection::writeData() {
     int myQueueSize = _myQueue.size();
     _stats.queueSize = myQueueSize;
     int error = 0;
+    bool moreGather = false;
 
     _lasttime = TimeUtil::getTime();
     do {
-        while (_output.getDataLen() < _readWriteBufSize) {
+        while (_output.getDataLen() < _readWriteBufSize && _gatherQueue.size() < MAX_GATHER_PAYLOAD_COUNT) {
             if (myQueueSize == 0) {
                 break;
             }
@@ -91,7 +255,8 @@ bool TCPConnection::writeData() {
             myQueueSize--;
             int64_t oldDataLen = _output.getDataLen();
             int64_t oldSpaceAllocated = _output.getSpaceUsed();
-            _streamer->encode(packet, &_output);
+            struct iovec payload;
+            _streamer->encode(packet, &_output, _gatherWriteSize, payload);
             int64_t newDataLen = _output.getDataLen();
             int64_t newSpaceAllocated = _output.getSpaceUsed();
             int64_t packetSizeInBuffer = newDataLen - oldDataLen;
@@ -114,30 +279,51 @@ bool TCPConnection::writeData() {
             }
             updateQueueStatus(packet, false);
             packet->invokeDequeueCB();
-            packet->free();
+            if (payload.iov_len > 0) {
+                // the body is written from the packet, free it once sent
+                GatherPayload gather;
+                gather.packet = packet;
+                gather.outputLen = newDataLen - _gatherOutputLen;
+                gather.data = (const char *)payload.iov_base;
+                gather.len = payload.iov_len;
+                gather.written = 0;
+                gather.zeroCopy = _zeroCopyWriteSize > 0 && payload.iov_len >= _zeroCopyWriteSize;
+                gather.zeroCopySeq = 0;
+                _gatherQueue.push_back(gather);
+                _gatherOutputLen = newDataLen;
+            } else {
+                packet->free();
+            }
 
             ANET_COUNT_PACKET_WRITE(1);
         }
 
-        if (_output.getDataLen() == 0) {
+        if (_output.getDataLen() == 0 && _gatherQueue.empty()) {
             break;
         }
 
         // write data
-        ret = _socket->write(_output.getData(), _output.getDataLen());
-        if (ret > 0) {
-            _output.drainData(ret);
-            _stats.totalTxBytes += ret;
-            ANET_ADD_OUTPUT_BUFFER_SPACE_USED(0 - ret);
+        moreGather = false;
+        if (!_gatherQueue.empty()) {
+            bool drained = false;
+            ret = writeGather(error, drained);
+            // the socket took everything, keep going with the bodies left
+            moreGather = drained && !_gatherQueue.empty();
         } else {
-            error = _socket->getSoError();
+            ret = _socket->write(_output.getData(), _output.getDataLen());
+            if (ret > 0) {
+                _output.drainData(ret);
+                _stats.totalTxBytes += ret;
+                ANET_ADD_OUTPUT_BUFFER_SPACE_USED(0 - ret);
+            } else {
+                error = _socket->getSoError();
+            }
         }
 
         writeCnt++;
-    } while (ret > 0 &&
-             _output.getDataLen() == 0
+    } while (ret > 0 && ((_output.getDataLen() == 0 && _gatherQueue.empty() && myQueueSize > 0) || moreGather)
              /**@todo remove magic number 10*/
-             && myQueueSize > 0 && writeCnt < 10);
+             && writeCnt < 10);
     _stats.callWriteCount += writeCnt;
 
     _outputCond.lock();
@@ -150,7 +336,7 @@ bool TCPConnection::writeData() {
         clearOutputBuffer();
         return false;
     }
-    int queueSize = _outputQueue.size() + (_output.getDataLen() > 0 ? 1 : 0);
+    int queueSize = _outputQueue.size() + ((_output.getDataLen() > 0 || !_gatherQueue.empty()) ? 1 : 0);
     if (queueSize > 0) {
         // when using level triggered mode, do NOT need to call enableWrite() any more.
         //         ANET_LOG(DEBUG,"IOC(%p)->enableWrite(true)", _iocomponent);
@@ -15,7 +15,11 @@
  */
 #ifndef ANET_TCPCONNECTION_H_
 #define ANET_TCPCONNECTION_H_
+#include <deque>
+#include <stddef.h>
 #include <stdint.h>
+#include <sys/uio.h>
+#include <utility>
 
 #include "aios/network/anet/connection.h"
 #include "aios/network/anet/databuffer.h"
@@ -70,6 +74,22 @@ public:
      */
     void clearInputBuffer() { _input.clear(); }
 
+    /*
+     * Free packets whose zero copy sends are completed.
+     *
+     * @return true if any completion is reaped
+     */
+    bool reapZeroCopyCompletion();
+
+    /*
+     * Bodies of at least gatherWriteSize bytes are sent from the packet
+     * instead of being copied into the output buffer, and those of at
+     * least zeroCopyWriteSize bytes with MSG_ZEROCOPY. 0 disables either.
+     * Defaults come from ANET_GATHER_WRITE_SIZE and ANET_ZERO_COPY_WRITE_SIZE,
+     * call it before any packet is posted.
+     */
+    void setWriteSize(size_t gatherWriteSize, size_t zeroCopyWriteSize);
+
     void addInputBufferSpaceAllocated(int64_t size);
     void addOutputBufferSpaceAllocated(int64_t size);
     int64_t getInputBufferSpaceAllocated() { return _inputBufferSpaceAllocated; };
@@ -117,6 +137,25 @@ public:
         return ret;
     }
 
+protected:
+    /*
+     * A packet body sent by gather write instead of being copied into
+     * _output. outputLen bytes of _output precede it on the wire.
+     */
+    struct GatherPayload {
+        Packet *packet;
+        int64_t outputLen;
+        const char *data;
+        size_t len;
+        size_t written;
+        bool zeroCopy;
+        uint32_t zeroCopySeq;
+    };
+
+    int writeGather(int &error, bool &drained);
+    void drainGather(size_t len);
+    void freeGatherPackets();
+
 protected:
     DataBuffer _output;         // 输出的buffer
     DataBuffer _input;          // 读入的buffer
@@ -133,6 +172,14 @@ protected:
      */
     int64_t _maxRecvPacketSize;
     int64_t _maxSendPacketSize;
+
+    std::deque<GatherPayload> _gatherQueue;                 // bodies waiting for gather write
+    int64_t _gatherOutputLen;                               // bytes of _output owned by _gatherQueue
+    size_t _gatherWriteSize;                                // min body size for gather write, 0 to disable
+    size_t _zeroCopyWriteSize;                              // min body size for MSG_ZEROCOPY, 0 to disable
+    bool _zeroCopyEnabled;                                  // SO_ZEROCOPY set on socket
+    uint32_t _zeroCopySeq;                                  // zero copy sends issued
+    std::deque<std::pair<uint32_t, Packet *>> _zeroCopyPackets; // written, waiting for completion
 };
 
 } // namespace anet
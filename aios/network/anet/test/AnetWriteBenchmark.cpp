@@ -0,0 +1,223 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "aios/network/anet/connection.h"
+#include "aios/network/anet/databuffer.h"
+#include "aios/network/anet/databufferserializable.h"
+#include "aios/network/anet/defaultpacket.h"
+#include "aios/network/anet/defaultpacketfactory.h"
+#include "aios/network/anet/defaultpacketstreamer.h"
+#include "aios/network/anet/delaydecodepacket.h"
+#include "aios/network/anet/iocomponent.h"
+#include "aios/network/anet/iserveradapter.h"
+#include "aios/network/anet/log.h"
+#include "aios/network/anet/socket.h"
+#include "aios/network/anet/tcpconnection.h"
+#include "aios/network/anet/transport.h"
+
+using namespace std;
+
+namespace anet {
+
+// write modes, set on the client connection
+enum WriteMode {
+    WM_COPY = 0,
+    WM_GATHER = 1,
+    WM_ZERO_COPY = 2,
+};
+
+class ReplyServerAdapter : public IServerAdapter {
+public:
+    IPacketHandler::HPRetCode handlePacket(Connection *connection, Packet *packet) override {
+        if (packet->isRegularPacket()) {
+            DefaultPacket *reply = new DefaultPacket();
+            reply->setChannelId(packet->getChannelId());
+            if (!connection->postPacket(reply)) {
+                reply->free();
+            }
+        }
+        packet->free();
+        return IPacketHandler::FREE_CHANNEL;
+    }
+};
+
+// counts replies so that a batch is only done when the server has received all of it
+class ReplyCounter : public IPacketHandler {
+public:
+    HPRetCode handlePacket(Packet *packet, void *args) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (packet->isRegularPacket()) {
+            ++_replied;
+        } else {
+            ++_failed;
+        }
+        packet->free();
+        _cond.notify_all();
+        return FREE_CHANNEL;
+    }
+    void reset() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _replied = 0;
+        _failed = 0;
+    }
+    bool waitReplied(int64_t expected) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cond.wait(lock, [&]() { return _replied + _failed >= expected; });
+        return _failed == 0;
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    int64_t _replied = 0;
+    int64_t _failed = 0;
+};
+
+// mimics an rpc message which is only serialized when the packet is written
+class BytesSerializable : public DataBufferSerializable {
+public:
+    explicit BytesSerializable(const string &data) : _data(data) {}
+    bool serialize(DataBuffer *outputBuffer) const override {
+        outputBuffer->writeBytes(_data.data(), _data.size());
+        return true;
+    }
+    bool deserialize(DataBuffer *inputBuffer, int length) override { return false; }
+    size_t getSerializedSize() const override { return _data.size(); }
+
+private:
+    const string &_data;
+};
+
+class AnetWriteBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State &state) override {
+        Logger::setLogLevel("WARN");
+        _replyCounter.reset();
+        _server.reset(new Transport());
+        _client.reset(new Transport());
+        _server->start();
+        _client->start();
+        _listener = _server->listen("tcp:127.0.0.1:0", &_serverStreamer, &_adapter);
+        if (_listener == NULL) {
+            return;
+        }
+        string spec = "tcp:127.0.0.1:" + to_string(_listener->getSocket()->getPort());
+        _connection = _client->connect(spec.c_str(), &_clientStreamer, false);
+        if (_connection) {
+            _connection->setQueueLimit(1024);
+            setWriteMode(static_cast<TCPConnection *>(_connection), (WriteMode)state.range(1));
+        }
+        _payload.assign(state.range(0), 'a');
+    }
+    void TearDown(const benchmark::State &state) override {
+        if (_connection) {
+            _connection->close();
+            _connection->subRef();
+            _connection = NULL;
+        }
+        if (_listener) {
+            _listener->close();
+            _listener->subRef();
+            _listener = NULL;
+        }
+        _client->stop();
+        _server->stop();
+        _client->wait();
+        _server->wait();
+        _client.reset();
+        _server.reset();
+    }
+
+protected:
+    static void setWriteMode(TCPConnection *connection, WriteMode mode) {
+        connection->setWriteSize(mode == WM_COPY ? 0 : 4096, mode == WM_ZERO_COPY ? 65536 : 0);
+    }
+    Packet *createDefaultPacket() {
+        DefaultPacket *packet = new DefaultPacket();
+        packet->setBody(_payload.data(), _payload.size());
+        return packet;
+    }
+    Packet *createDelayDecodePacket() {
+        DelayDecodePacket *packet = new DelayDecodePacket();
+        packet->setContent(new BytesSerializable(_payload), true);
+        return packet;
+    }
+    template <typename Creator>
+    void run(benchmark::State &state, Creator creator) {
+        if (_connection == NULL) {
+            state.SkipWithError("listen or connect failed");
+            return;
+        }
+        const int64_t batch = 64;
+        int64_t sent = 0;
+        for (auto _ : state) {
+            for (int64_t i = 0; i < batch; ++i) {
+                Packet *packet = creator();
+                if (!_connection->postPacket(packet, &_replyCounter, NULL, true)) {
+                    packet->free();
+                    state.SkipWithError("post packet failed");
+                    return;
+                }
+            }
+            sent += batch;
+            if (!_replyCounter.waitReplied(sent)) {
+                state.SkipWithError("packet timeout or connection closed");
+                return;
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * batch);
+        state.SetBytesProcessed(state.iterations() * batch * _payload.size());
+    }
+
+protected:
+    std::unique_ptr<Transport> _server;
+    std::unique_ptr<Transport> _client;
+    DefaultPacketFactory _serverFactory;
+    DefaultPacketFactory _clientFactory;
+    DefaultPacketStreamer _serverStreamer{&_serverFactory};
+    DefaultPacketStreamer _clientStreamer{&_clientFactory};
+    ReplyServerAdapter _adapter;
+    ReplyCounter _replyCounter;
+    IOComponent *_listener = NULL;
+    Connection *_connection = NULL;
+    string _payload;
+};
+
+// {payload size, write mode}
+static void writeArgs(benchmark::internal::Benchmark *b) {
+    for (int64_t size : {128, 4 << 10, 64 << 10, 1 << 20}) {
+        for (int64_t mode : {WM_COPY, WM_GATHER, WM_ZERO_COPY}) {
+            b->Args({size, mode});
+        }
+    }
+}
+
+BENCHMARK_DEFINE_F(AnetWriteBenchmark, DefaultPacket)(benchmark::State &state) {
+    run(state, [this]() { return createDefaultPacket(); });
+}
+BENCHMARK_REGISTER_F(AnetWriteBenchmark, DefaultPacket)->Apply(writeArgs)->UseRealTime();
+
+BENCHMARK_DEFINE_F(AnetWriteBenchmark, DelayDecodePacket)(benchmark::State &state) {
+    run(state, [this]() { return createDelayDecodePacket(); });
+}
+BENCHMARK_REGISTER_F(AnetWriteBenchmark, DelayDecodePacket)->Apply(writeArgs)->UseRealTime();
+
+} // namespace anet
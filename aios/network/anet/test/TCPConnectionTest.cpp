@@ -0,0 +1,256 @@
+#include "aios/network/anet/tcpconnection.h"
+
+#include <deque>
+#include <errno.h>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "aios/network/anet/databuffer.h"
+#include "aios/network/anet/defaultpacket.h"
+#include "aios/network/anet/defaultpacketfactory.h"
+#include "aios/network/anet/defaultpacketstreamer.h"
+#include "aios/network/anet/iocomponent.h"
+#include "aios/network/anet/socket.h"
+#include "aios/network/anet/transport.h"
+#include "unittest/unittest.h"
+
+using namespace std;
+
+namespace anet {
+
+static const int64_t UNLIMITED = numeric_limits<int64_t>::max();
+
+// takes at most the scripted bytes per call, a negative limit fails the call with that errno
+class FakeSocket : public Socket {
+public:
+    int write(const void *data, int len) override {
+        copyWriteCount++;
+        struct iovec iov;
+        iov.iov_base = const_cast<void *>(data);
+        iov.iov_len = len;
+        return doWrite(&iov, 1);
+    }
+    int writev(const struct iovec *iov, int iovcnt, bool zeroCopy) override {
+        zeroCopyCalls.push_back(zeroCopy);
+        return doWrite(iov, iovcnt);
+    }
+    int getSoError() override { return 0; }
+    bool setZeroCopy(bool on) override { return zeroCopySupported; }
+    int readZeroCopyCompletion(uint32_t &lo, uint32_t &hi) override {
+        if (completions.empty()) {
+            return 0;
+        }
+        lo = completions.front().first;
+        hi = completions.front().second;
+        completions.pop_front();
+        return 1;
+    }
+
+private:
+    int doWrite(const struct iovec *iov, int iovcnt) {
+        int64_t limit = UNLIMITED;
+        if (!writeLimits.empty()) {
+            limit = writeLimits.front();
+            writeLimits.pop_front();
+        }
+        if (limit < 0) {
+            errno = -limit;
+            return -1;
+        }
+        int64_t len = 0;
+        for (int i = 0; i < iovcnt && len < limit; i++) {
+            int64_t n = min((int64_t)iov[i].iov_len, limit - len);
+            written.append((const char *)iov[i].iov_base, n);
+            len += n;
+        }
+        return len;
+    }
+
+public:
+    string written;
+    deque<int64_t> writeLimits;
+    vector<bool> zeroCopyCalls;
+    size_t copyWriteCount = 0;
+    bool zeroCopySupported = true;
+    deque<pair<uint32_t, uint32_t>> completions;
+};
+
+class FakeIOComponent : public IOComponent {
+public:
+    FakeIOComponent(Transport *owner, Socket *socket) : IOComponent(owner, socket) {}
+    bool init(bool isServer = false) override { return true; }
+    bool handleWriteEvent() override { return true; }
+    bool handleReadEvent() override { return true; }
+    bool handleErrorEvent() override { return true; }
+    bool checkTimeout(int64_t now) override { return true; }
+};
+
+class CountedPacket : public DefaultPacket {
+public:
+    CountedPacket(size_t bodyLen, size_t *freeCount) : _freeCount(freeCount) {
+        string body(bodyLen, 'a' + bodyLen % 26);
+        setBody(body.data(), body.size());
+    }
+    void free() override {
+        (*_freeCount)++;
+        delete this;
+    }
+
+private:
+    size_t *_freeCount;
+};
+
+class TCPConnectionTest : public TESTBASE {
+public:
+    void setUp() override {
+        _socket = new FakeSocket();
+        _ioc = new FakeIOComponent(&_transport, _socket);
+        _connection = new TCPConnection(_socket, &_streamer, NULL);
+        _connection->setIOComponent(_ioc);
+        _freeCount = 0;
+        _expected.clear();
+    }
+    void tearDown() override {
+        delete _connection;
+        delete _ioc;
+    }
+
+protected:
+    void post(size_t bodyLen) {
+        auto packet = new CountedPacket(bodyLen, &_freeCount);
+        packet->setChannelId(bodyLen);
+        DataBuffer buffer;
+        ASSERT_TRUE(_streamer.encode(packet, &buffer));
+        _expected.append(buffer.getData(), buffer.getDataLen());
+        _connection->_outputQueue.push(packet);
+    }
+    bool hasPending() const {
+        return _connection->_outputQueue.size() > 0 || _connection->_output.getDataLen() > 0 ||
+               !_connection->_gatherQueue.empty();
+    }
+
+protected:
+    Transport _transport;
+    DefaultPacketFactory _factory;
+    DefaultPacketStreamer _streamer{&_factory};
+    FakeSocket *_socket;
+    FakeIOComponent *_ioc;
+    TCPConnection *_connection;
+    size_t _freeCount;
+    string _expected;
+};
+
+TEST_F(TCPConnectionTest, testDefaultCopyWrite) {
+    // gather write is off unless enabled
+    ASSERT_EQ(0u, _connection->_gatherWriteSize);
+    ASSERT_EQ(0u, _connection->_zeroCopyWriteSize);
+    post(100);
+    post(100 * 1024);
+    while (hasPending()) {
+        ASSERT_TRUE(_connection->writeData());
+    }
+    ASSERT_EQ(_expected, _socket->written);
+    ASSERT_TRUE(_socket->zeroCopyCalls.empty());
+    ASSERT_LT(0u, _socket->copyWriteCount);
+    ASSERT_EQ(2u, _freeCount);
+}
+
+TEST_F(TCPConnectionTest, testGatherWritePartialAndEagain) {
+    _connection->setWriteSize(1024, 0);
+    _socket->writeLimits = {50, 3000, 7, -EAGAIN};
+    post(100);
+    post(4096);
+    post(10);
+    post(8000);
+
+    ASSERT_TRUE(_connection->writeData());
+    ASSERT_EQ(50u, _socket->written.size());
+    // small packets are copied and freed at once, large ones wait for their body
+    ASSERT_EQ(2u, _freeCount);
+    ASSERT_EQ(2u, _connection->_gatherQueue.size());
+
+    ASSERT_TRUE(_connection->writeData());
+    ASSERT_EQ(3050u, _socket->written.size());
+    ASSERT_TRUE(_connection->writeData());
+    ASSERT_EQ(3057u, _socket->written.size());
+    ASSERT_EQ(2u, _freeCount);
+
+    // EAGAIN keeps everything queued
+    ASSERT_TRUE(_connection->writeData());
+    ASSERT_EQ(3057u, _socket->written.size());
+    ASSERT_EQ(2u, _connection->_gatherQueue.size());
+
+    while (hasPending()) {
+        ASSERT_TRUE(_connection->writeData());
+    }
+    ASSERT_EQ(_expected, _socket->written);
+    ASSERT_EQ(0u, _socket->copyWriteCount);
+    ASSERT_EQ(4u, _freeCount);
+    ASSERT_EQ(0, _connection->_gatherOutputLen);
+}
+
+TEST_F(TCPConnectionTest, testZeroCopyWriteAndReap) {
+    _connection->setWriteSize(1024, 2048);
+    // header of the zero copy body, then part of the body
+    _socket->writeLimits = {UNLIMITED, 1000};
+    post(4096);
+    post(100);
+    post(1500);
+
+    ASSERT_TRUE(_connection->writeData());
+    ASSERT_EQ(1016u, _socket->written.size());
+    ASSERT_EQ(vector<bool>({false, true}), _socket->zeroCopyCalls);
+    ASSERT_TRUE(_connection->_zeroCopyEnabled);
+
+    while (hasPending()) {
+        ASSERT_TRUE(_connection->writeData());
+    }
+    ASSERT_EQ(_expected, _socket->written);
+    // rest of the body is the second zero copy send, the others go in one gather write
+    ASSERT_EQ(vector<bool>({false, true, true, false}), _socket->zeroCopyCalls);
+    ASSERT_EQ(2u, _freeCount);
+    ASSERT_EQ(1u, _connection->_zeroCopyPackets.size());
+
+    // the packet is kept until its last send completes
+    _socket->completions.push_back(make_pair(0, 0));
+    ASSERT_TRUE(_connection->reapZeroCopyCompletion());
+    ASSERT_EQ(2u, _freeCount);
+    ASSERT_FALSE(_connection->reapZeroCopyCompletion());
+
+    // completions are also reaped by the next write
+    _socket->completions.push_back(make_pair(1, 1));
+    ASSERT_TRUE(_connection->writeData());
+    ASSERT_EQ(3u, _freeCount);
+    ASSERT_TRUE(_connection->_zeroCopyPackets.empty());
+}
+
+TEST_F(TCPConnectionTest, testZeroCopyFallback) {
+    _connection->setWriteSize(1024, 2048);
+    // out of optmem, the body is sent by copy
+    _socket->writeLimits = {UNLIMITED, -ENOBUFS};
+    post(4096);
+    ASSERT_TRUE(_connection->writeData());
+    ASSERT_EQ(16u, _socket->written.size());
+    ASSERT_TRUE(_connection->writeData());
+    ASSERT_EQ(_expected, _socket->written);
+    ASSERT_EQ(vector<bool>({false, true, false}), _socket->zeroCopyCalls);
+    ASSERT_EQ(1u, _freeCount);
+    ASSERT_TRUE(_connection->_zeroCopyPackets.empty());
+
+    // SO_ZEROCOPY not supported, zero copy is turned off for the connection
+    _socket->zeroCopySupported = false;
+    _connection->_zeroCopyEnabled = false;
+    post(4096);
+    while (hasPending()) {
+        ASSERT_TRUE(_connection->writeData());
+    }
+    ASSERT_EQ(_expected, _socket->written);
+    ASSERT_EQ(0u, _connection->_zeroCopyWriteSize);
+    ASSERT_EQ(2u, _freeCount);
+    for (size_t i = 3; i < _socket->zeroCopyCalls.size(); i++) {
+        ASSERT_FALSE(_socket->zeroCopyCalls[i]);
+    }
+}
+
+} // namespace anet
@@ -34,6 +34,7 @@
 #include "aios/network/anet/ioworker.h"
 #include "aios/network/anet/log.h"
 #include "aios/network/anet/socket.h"
+#include "aios/network/anet/stats.h"
 #include "aios/network/anet/tcpacceptor.h"
 #include "aios/network/anet/tcpcomponent.h"
 #include "aios/network/anet/thread.h"
@@ -270,10 +271,21 @@ IOComponent *Transport::listen(const char *spec,
         TCPAcceptor *acceptor =
             new TCPAcceptor(this, socket, streamer, serverAdapter, postPacketTimeout, maxIdleTime, backlog);
         DBGASSERT(acceptor);
+        bool reusePort = _listenFdThreadMode == REUSEPORT_LISTEN && socket->getProtocolFamily() != AF_UNIX;
+        if (reusePort) {
+            acceptor->setIoWorkerIdx(0);
+            socket->setReusePort(true);
+        }
         if (!acceptor->init()) {
             delete acceptor;
             return NULL;
         }
+        for (int k = 1; reusePort && k < _ioThreadNum; ++k) {
+            if (!acceptor->addShard(k)) {
+                ANET_LOG(WARN, "add SO_REUSEPORT acceptor for io worker %d failed, spec %s", k, spec);
+                break;
+            }
+        }
         return acceptor;
     } else {
         ANET_LOG(WARN, "SOCK_DGRAM server does not support yet, spec %s", spec);
@@ -292,6 +304,13 @@ IoWorker *Transport::getBelongedWorker(const IOComponent *ioc) {
     return &_ioWorkers[chunkId];
 }
 
+ReactorStatCounter *Transport::getReactorStat(int idx) {
+    if (idx < 0 || idx >= _ioThreadNum + _listenThreadNum) {
+        return NULL;
+    }
+    return _ioWorkers[idx].getStat();
+}
+
 void Transport::addToCheckingList(IOComponent *ioc) {
     ioc->addRef();
 
@@ -307,6 +326,9 @@ int Transport::getChunkId(const IOComponent *ioc) const {
     if (ioc == NULL) {
         return 0;
     }
+    if (ioc->getIoWorkerIdx() >= 0) {
+        return ioc->getIoWorkerIdx() % (_ioThreadNum + _listenThreadNum);
+    }
 
     if (_listenFdThreadMode == EXCLUSIVE_LISTEN_THREAD) {
         assert(_listenThreadNum > 0);
@@ -329,6 +351,10 @@ void Transport::dump(ostringstream &buf) {
     buf << "\tTimeout interval: " << _timeoutLoopInterval << "us\t"
         << "Next check: " << _nextCheckTime << "-" << timestr << endl;
 
+    for (int k = 0; k < _ioThreadNum + _listenThreadNum; ++k) {
+        buf << "IoWorker " << k << ": ";
+        _ioWorkers[k].getStat()->dump(buf);
+    }
     for (int k = 0; k < _ioThreadNum + _listenThreadNum; ++k) {
         totalIOC += _ioWorkers[k].dump(buf);
     }
@@ -39,6 +39,7 @@
 namespace anet {
 
 class IoWorker;
+class ReactorStatCounter;
 
 /**
  * This class controls behavior of ANET. There are two work modes:
@@ -53,6 +54,7 @@ class IoWorker;
 enum ListenFdThreadModeEnum {
     SHARE_THREAD, // default: share thread with normal fd
     EXCLUSIVE_LISTEN_THREAD,
+    REUSEPORT_LISTEN, // every io thread accepts on its own SO_REUSEPORT fd and keeps its connections
 };
 
 class Transport : public Runnable, public ITransport {
@@ -241,6 +243,12 @@ public:
     IoWorker *getBelongedWorker(const IOComponent *ioc);
     virtual void getTcpConnStats(std::vector<ConnStat> &connStats);
 
+    /**
+     * load counters of each io worker, including the listen thread
+     */
+    int getIoWorkerNum() const { return _ioThreadNum + _listenThreadNum; }
+    ReactorStatCounter *getReactorStat(int idx);
+
     void setName(const std::string &name);
     const std::string &getName() const { return _name; }
 
@@ -86,6 +86,12 @@ constexpr int32_t DEFAULT_HEARTBEAT_UNHEALTH_INTERVAL = 20 * 1000; // 20s
 constexpr int32_t DEFAULT_RETRY_LIMIT_PER_SECOND = -1; // no limit
 constexpr int32_t DEFAULT_LATENCY_TIME_WINDOW_SIZE = 0;
 
+// hedge
+constexpr float DEFAULT_HEDGE_BUDGET_RATIO = 0.05f;
+constexpr int64_t HEDGE_BUDGET_BURST = 100;
+constexpr int64_t HEDGE_LATENCY_WINDOW_SIZE = 1000;
+constexpr int64_t HEDGE_MIN_LATENCY_SAMPLE = 100;
+
 struct ControllerParam {
 public:
     static void logParam();
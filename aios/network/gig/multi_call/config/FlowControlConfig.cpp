@@ -28,6 +28,8 @@ void FlowControlConfig::validate() {
     etTriggerPercent = getValidPercent(etTriggerPercent, "et percent");
     retryTriggerPercent = getValidPercent(retryTriggerPercent, "retry percent");
     latencyTimeWindowSize = getValidInteger(latencyTimeWindowSize, "window_size");
+    hedgeLatencyPercent = getValidPercent(hedgeLatencyPercent, "hedge percent");
+    hedgeBudgetRatio = getValidPercent(hedgeBudgetRatio, "hedge budget ratio");
     if (beginServerDegradeLatency > beginDegradeLatency) {
         AUTIL_LOG(ERROR,
                   "beginServerDegradeLatency [%u] is great than "
@@ -71,6 +73,8 @@ bool FlowControlConfig::operator==(const FlowControlConfig &rhs) const {
            etTriggerPercent == rhs.etTriggerPercent && etWaitTimeFactor == rhs.etWaitTimeFactor &&
            etMinWaitTime == rhs.etMinWaitTime && retryTriggerPercent == rhs.retryTriggerPercent &&
            retryWaitTimeFactor == rhs.retryWaitTimeFactor &&
+           hedgeLatencyPercent == rhs.hedgeLatencyPercent &&
+           hedgeMinWaitTime == rhs.hedgeMinWaitTime && hedgeBudgetRatio == rhs.hedgeBudgetRatio &&
            beginServerDegradeErrorRatio == rhs.beginServerDegradeErrorRatio &&
            beginDegradeErrorRatio == rhs.beginDegradeErrorRatio &&
            fullDegradeErrorRatio == rhs.fullDegradeErrorRatio;
@@ -42,6 +42,9 @@ public:
         , retryMinProviderWeight(0)
         , retryLimitPerSecond(DEFAULT_RETRY_LIMIT_PER_SECOND)
         , latencyTimeWindowSize(DEFAULT_LATENCY_TIME_WINDOW_SIZE)
+        , hedgeLatencyPercent(MAX_PERCENT)
+        , hedgeMinWaitTime(0)
+        , hedgeBudgetRatio(DEFAULT_HEDGE_BUDGET_RATIO)
         , beginServerDegradeErrorRatio(MAX_PERCENT)
         , beginDegradeErrorRatio(MAX_PERCENT)
         , fullDegradeErrorRatio(MAX_PERCENT)
@@ -72,6 +75,10 @@ public:
         json.Jsonize("retry_limit_per_second", retryLimitPerSecond, retryLimitPerSecond);
         json.Jsonize("latency_time_window_size", latencyTimeWindowSize, latencyTimeWindowSize);
 
+        json.Jsonize("hedge_latency_percent", hedgeLatencyPercent, hedgeLatencyPercent);
+        json.Jsonize("hedge_min_wait_time", hedgeMinWaitTime, hedgeMinWaitTime);
+        json.Jsonize("hedge_budget_ratio", hedgeBudgetRatio, hedgeBudgetRatio);
+
         json.Jsonize("full_degrade_error_ratio", fullDegradeErrorRatio, fullDegradeErrorRatio);
         json.Jsonize("begin_degrade_error_ratio", beginDegradeErrorRatio, fullDegradeErrorRatio);
         json.Jsonize("begin_server_degrade_error_ratio", beginServerDegradeErrorRatio,
@@ -98,6 +105,9 @@ public:
     bool singleRetryEnabled() const {
         return latencyTimeWindowSize > DEFAULT_LATENCY_TIME_WINDOW_SIZE;
     }
+    bool hedgeEnabled() const {
+        return MAX_PERCENT != hedgeLatencyPercent && hedgeBudgetRatio > MIN_PERCENT;
+    }
     FlowControlConfig *clone();
     void validate();
     bool operator==(const FlowControlConfig &rhs) const;
@@ -122,6 +132,12 @@ public:
     int32_t retryLimitPerSecond;
     int32_t latencyTimeWindowSize;
 
+    // duplicate a sub request to another replica if it has not returned
+    // within this percentile of the biz's recent latency
+    float hedgeLatencyPercent;
+    uint32_t hedgeMinWaitTime; // ms
+    float hedgeBudgetRatio;    // hedge count / request count
+
     float beginServerDegradeErrorRatio;
     float beginDegradeErrorRatio;
     float fullDegradeErrorRatio;
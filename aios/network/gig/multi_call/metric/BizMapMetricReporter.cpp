@@ -109,6 +109,9 @@ void BizMapMetricReporter::reportReplyInfo(const ReplyInfoCollector &replyInfo)
         if (retryInfo.isRetry) {
             bizReporter->reportRetryQueryQps(1.0);
             bizReporter->reportRetryQueryTriggerLatency(retryInfo.latency / FACTOR_US_TO_MS);
+            if (retryInfo.isHedge) {
+                bizReporter->reportHedgeQueryQps(1.0);
+            }
         }
         if (replyBizInfo.probeCallNum != 0) {
             bizReporter->reportProbeCallQps(replyBizInfo.probeCallNum);
@@ -85,6 +85,7 @@ BizMetricReporter::BizMetricReporter(const std::string &bizName, KMonitor *kMoni
         DEFINE_METRIC(kMonitor, RetryQueryQps, "retryQueryQps", QPS, NORMAL, _bizTags);
         DEFINE_METRIC(kMonitor, RetryQueryTriggerLatency, "retryQueryTriggerLatency", GAUGE, NORMAL,
                       _bizTags);
+        DEFINE_METRIC(kMonitor, HedgeQueryQps, "hedgeQueryQps", QPS, NORMAL, _bizTags);
 
         DEFINE_METRIC(kMonitor, ProbeCallQps, "probeQps", QPS, NORMAL, _bizTags);
         DEFINE_METRIC(kMonitor, CopyCallQps, "copyQps", QPS, NORMAL, _bizTags);
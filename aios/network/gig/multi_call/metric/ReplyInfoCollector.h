@@ -31,9 +31,10 @@ struct EtInfo {
 };
 
 struct RetryInfo {
-    RetryInfo() : isRetry(false), latency(0), retryCallNum(0), retrySuccNum(0) {
+    RetryInfo() : isRetry(false), isHedge(false), latency(0), retryCallNum(0), retrySuccNum(0) {
     }
     bool isRetry;
+    bool isHedge;
     double latency;
     uint32_t retryCallNum;
     uint32_t retrySuccNum;
@@ -29,7 +29,8 @@ struct BizStatistic {
         , etThreshold(0)
         , retryThreshold(0)
         , needRetry(false)
-        , needSingleRetry(false) {
+        , needSingleRetry(false)
+        , needHedge(false) {
     }
 
     uint32_t expectNum;
@@ -38,6 +39,7 @@ struct BizStatistic {
     uint32_t retryThreshold;
     bool needRetry;
     bool needSingleRetry;
+    bool needHedge;
     void setEtThreshold(uint32_t num) {
         if (num < 1) {
             num = 1;
@@ -79,6 +81,9 @@ public:
     inline bool IsSingleResultNeedRetry(const BizStatistic &stat) const {
         return stat.needSingleRetry && 1 == stat.expectNum && 0 == stat.resultNum;
     }
+    inline bool needHedge(const BizStatistic &stat) const {
+        return stat.needHedge && stat.resultNum < stat.expectNum;
+    }
 
     uint32_t getClusterResultNum(const std::string &clusterName) const {
         autil::ScopedReadLock lock(_lock);
@@ -42,6 +42,7 @@ ChildNodeCaller::ChildNodeCaller(const SearchServiceSnapshotPtr &snapshot,
     , _earlyTerminationEnabled(false)
     , _retryEnabled(false)
     , _singleRetryEnable(false)
+    , _hedgeEnabled(false)
     , _canRetry(false) {
     _callBeginTime = autil::TimeUtility::currentTime();
 }
@@ -125,8 +126,10 @@ void ChildNodeCaller::initCaller() {
     _reply.reset(new ChildNodeReply(_flowConfigSnapshot, _replyInfoCollector, _retryLimitChecker,
                                     _latencyTimeSnapshot));
     _flowConfigSnapshot->getFlowControlSwitch(flowControlStrategyVec, _earlyTerminationEnabled,
-                                              _retryEnabled, _singleRetryEnable);
+                                              _retryEnabled, _singleRetryEnable,
+                                              _hedgeEnabled);
     _reply->setSingleRetryEnabled(_singleRetryEnable);
+    _reply->setHedgeEnabled(_hedgeEnabled);
     if (isDetectionOn()) {
         _reply->prepareCallDelegationStatistic(bizNameVec, flowControlStrategyVec);
     }
@@ -164,7 +167,7 @@ bool ChildNodeCaller::isDetectionOn() const {
 }
 
 bool ChildNodeCaller::isRetryOn() const {
-    return _canRetry && (_retryEnabled || _singleRetryEnable);
+    return _canRetry && (_retryEnabled || _singleRetryEnable || _hedgeEnabled);
 }
 
 const CallerPtr &ChildNodeCaller::getCaller() const {
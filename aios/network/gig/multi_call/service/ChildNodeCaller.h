@@ -82,6 +82,7 @@ private:
     bool _earlyTerminationEnabled;
     bool _retryEnabled;
     bool _singleRetryEnable;
+    bool _hedgeEnabled;
     bool _canRetry;
 
 private:
@@ -38,6 +38,7 @@ ChildNodeReply::ChildNodeReply(const FlowConfigSnapshotPtr &flowConfigSnapshot,
     , _etTime(numeric_limits<int64_t>::max())
     , _startDetectionTime(numeric_limits<int64_t>::max())
     , _singleRetryEnabled(false)
+    , _hedgeEnabled(false)
     , _needEndStream(false)
 {
     assert(_replyInfoCollector);
@@ -58,7 +59,6 @@ size_t ChildNodeReply::fillResponses(vector<ResponsePtr> &responseVec) {
 void ChildNodeReply::endStreamQuery() {
     for (const auto &searchResourcePtr : _searchResourceVec) {
         assert(searchResourcePtr->isNormalRequest());
-        bool singleRetryEnabled = searchResourcePtr->singleRetryEnabled();
         const string &bizName = searchResourcePtr->getBizName();
         auto request = searchResourcePtr->getRequest();
         if (request) {
@@ -70,8 +70,8 @@ void ChildNodeReply::endStreamQuery() {
                                                response->rpcUsedTime(), response->netLatency());
             _replyInfoCollector->addResponseSize(bizName, response->size());
 
-            if (singleRetryEnabled && !response->isFailed()) {
-                _latencyTimeSnapshot->pushLatency(bizName, response->rpcUsedTime());
+            if (!response->isFailed()) {
+                pushLatency(searchResourcePtr, response->rpcUsedTime());
             }
 
             // statistic error or timeout request
@@ -93,7 +93,6 @@ size_t ChildNodeReply::fillResponses(std::vector<ResponsePtr> &responseVec,
                                      std::vector<LackResponseInfo> &lackInfos) {
     for (const auto &searchResourcePtr : _searchResourceVec) {
         assert(searchResourcePtr->isNormalRequest());
-        bool singleRetryEnabled = searchResourcePtr->singleRetryEnabled();
         const string &bizName = searchResourcePtr->getBizName();
         auto request = searchResourcePtr->getRequest();
         if (request) {
@@ -107,8 +106,8 @@ size_t ChildNodeReply::fillResponses(std::vector<ResponsePtr> &responseVec,
                                                response->rpcUsedTime(), response->netLatency());
             _replyInfoCollector->addResponseSize(bizName, response->size());
 
-            if (singleRetryEnabled && !response->isFailed()) {
-                _latencyTimeSnapshot->pushLatency(bizName, response->callUsedTime());
+            if (!response->isFailed()) {
+                pushLatency(searchResourcePtr, response->callUsedTime());
             }
 
             // statistic error or timeout request
@@ -134,6 +133,24 @@ size_t ChildNodeReply::fillResponses(std::vector<ResponsePtr> &responseVec,
     return _expectProviderCount - responseVec.size();
 }
 
+void ChildNodeReply::pushLatency(const SearchServiceResourcePtr &searchResourcePtr,
+                                 int64_t latency) {
+    bool singleRetryEnabled = searchResourcePtr->singleRetryEnabled();
+    bool hedgeEnabled = searchResourcePtr->hedgeEnabled();
+    if (!singleRetryEnabled && !hedgeEnabled) {
+        return;
+    }
+    const auto &bizName = searchResourcePtr->getBizName();
+    if (_latencyTimeSnapshot->pushLatency(bizName, latency) < 0 && hedgeEnabled) {
+        // hedge keeps its own window, single retry creates it on first retry
+        const auto &configPtr = searchResourcePtr->getFlowControlConfig();
+        int64_t windowSize =
+            singleRetryEnabled ? configPtr->latencyTimeWindowSize : HEDGE_LATENCY_WINDOW_SIZE;
+        _latencyTimeSnapshot->updateLatencyTimeWindow(bizName, windowSize);
+        _latencyTimeSnapshot->pushLatency(bizName, latency);
+    }
+}
+
 void ChildNodeReply::reportLinkMetric(const SearchServiceResourcePtr &searchResourcePtr,
                                       const ResponsePtr &responsePtr) {
     if (!_metricReporterManager) {
@@ -248,6 +265,10 @@ bool ChildNodeReply::collectStatistic(const string &bizName, size_t providerCoun
     }
     _callDelegationStatistic.collectStatistic(bizName, providerCount, flowControlConfig,
                                               disableRetry);
+    if (!disableRetry && flowControlConfig->hedgeEnabled()) {
+        _retryLimitChecker->addHedgeBudget(clusterResponse.flowControlStrategy, providerCount,
+                                           flowControlConfig->hedgeBudgetRatio);
+    }
     return true;
 }
 
@@ -276,6 +297,11 @@ void ChildNodeReply::getRetryBizs(int64_t currentTime, map<string, int32_t> &ret
         if (0 == stat.expectNum) {
             continue;
         }
+        int32_t hedgeMinProviderWeight = 0;
+        if (needHedge(currentTime, bizName, stat, clusterRsp, hedgeMinProviderWeight)) {
+            retryBizInfos[bizName] = hedgeMinProviderWeight;
+            continue;
+        }
         int64_t latency = numeric_limits<int64_t>::max();
         if (1 == stat.expectNum) {
             if (_callDelegationStatistic.IsSingleResultNeedRetry(stat)) {
@@ -322,6 +348,45 @@ void ChildNodeReply::getRetryBizs(int64_t currentTime, map<string, int32_t> &ret
     }
 }
 
+bool ChildNodeReply::needHedge(int64_t currentTime, const string &bizName,
+                               const BizStatistic &stat, ClusterResponse &clusterRsp,
+                               int32_t &minProviderWeight) {
+    if (clusterRsp.hedged || !_callDelegationStatistic.needHedge(stat)) {
+        return false;
+    }
+    const auto &strategy = clusterRsp.flowControlStrategy;
+    auto configPtr = _flowConfigSnapshot->getFlowControlConfig(strategy);
+    if (!configPtr) {
+        return false;
+    }
+    if (clusterRsp.startHedgeTime == numeric_limits<int64_t>::max()) {
+        auto latency = _latencyTimeSnapshot->getPercentileLatency(bizName,
+                                                                  configPtr->hedgeLatencyPercent);
+        if (latency < 0) {
+            // not enough samples yet
+            return false;
+        }
+        clusterRsp.hedgeLatency = latency;
+        clusterRsp.startHedgeTime =
+            _startTime + max(latency, (int64_t)configPtr->hedgeMinWaitTime * 1000);
+    }
+    if (clusterRsp.startHedgeTime > currentTime) {
+        return false;
+    }
+    int64_t timeout = min(_etTime, _startTime + _rpcTimeout);
+    if (clusterRsp.hedgeLatency + currentTime > timeout) {
+        return false;
+    }
+    // an exhausted budget or retry limit leaves the request unhedged, it may hedge later
+    if (!_retryLimitChecker->canHedge(strategy, currentTime / FACTOR_S_TO_US,
+                                      configPtr->retryLimitPerSecond)) {
+        return false;
+    }
+    clusterRsp.hedged = true;
+    minProviderWeight = configPtr->retryMinProviderWeight;
+    return true;
+}
+
 void ChildNodeReply::updateRetryBizs(const map<string, int32_t> &retryBizInfos) {
     for (const auto &info : retryBizInfos) {
         auto it = _clusterResponseMap.find(info.first);
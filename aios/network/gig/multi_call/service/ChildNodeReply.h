@@ -46,12 +46,18 @@ public:
         ClusterResponse()
             : fastestResponseTime(std::numeric_limits<int64_t>::max())
             , startRetryTime(std::numeric_limits<int64_t>::max())
-            , retried(false) {
+            , startHedgeTime(std::numeric_limits<int64_t>::max())
+            , hedgeLatency(0)
+            , retried(false)
+            , hedged(false) {
         }
         std::string flowControlStrategy;
         int64_t fastestResponseTime;
         int64_t startRetryTime;
+        int64_t startHedgeTime;
+        int64_t hedgeLatency;
         bool retried;
+        bool hedged;
     };
     typedef std::map<std::string, ClusterResponse> ClusterResponseMap;
 
@@ -104,6 +110,9 @@ private:
                        const ResponsePtr &responsePtr);
     void reportLinkMetric(const SearchServiceResourcePtr &searchResourcePtr,
                           const ResponsePtr &responsePtr);
+    void pushLatency(const SearchServiceResourcePtr &searchResourcePtr, int64_t latency);
+    bool needHedge(int64_t currentTime, const std::string &bizName, const BizStatistic &stat,
+                   ClusterResponse &clusterRsp, int32_t &minProviderWeight);
 
 public:
     // for test
@@ -149,6 +158,16 @@ public:
     bool singleRetryEnabled() const {
         return _singleRetryEnabled;
     }
+    void setHedgeEnabled(bool hedgeEnabled) {
+        _hedgeEnabled = hedgeEnabled;
+    }
+    bool hedgeEnabled() const {
+        return _hedgeEnabled;
+    }
+    bool isHedged(const std::string &bizName) const {
+        auto it = _clusterResponseMap.find(bizName);
+        return _clusterResponseMap.end() != it && it->second.hedged;
+    }
 
 private:
     int64_t _rpcTimeout; // us
@@ -167,6 +186,7 @@ private:
     int64_t _startDetectionTime;
     int64_t _startTime;
     bool _singleRetryEnabled;
+    bool _hedgeEnabled;
     bool _needEndStream;
 
 private:
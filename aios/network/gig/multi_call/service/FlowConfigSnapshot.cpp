@@ -85,10 +85,11 @@ bool FlowConfigSnapshot::getFlowControlConfig(const std::string &strategy,
 
 void FlowConfigSnapshot::getFlowControlSwitch(const vector<string> &strategyVec,
                                               bool &earlyTermination, bool &retry,
-                                              bool &singleRetry) const {
+                                              bool &singleRetry, bool &hedge) const {
     earlyTermination = false;
     retry = false;
     singleRetry = false;
+    hedge = false;
     for (vector<string>::const_iterator it = strategyVec.begin(); it != strategyVec.end(); ++it) {
         const auto &strategy = *it;
         const auto &configPtr = getFlowControlConfig(strategy);
@@ -96,6 +97,7 @@ void FlowConfigSnapshot::getFlowControlSwitch(const vector<string> &strategyVec,
             earlyTermination = earlyTermination || configPtr->etEnabled();
             retry = retry || configPtr->retryEnabled();
             singleRetry = singleRetry || configPtr->singleRetryEnabled();
+            hedge = hedge || configPtr->hedgeEnabled();
         }
     }
 }
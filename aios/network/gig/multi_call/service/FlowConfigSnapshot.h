@@ -42,7 +42,7 @@ public:
     FlowControlConfigPtr getFlowControlConfig(const std::string &strategy) const;
     bool getFlowControlConfig(const std::string &strategy, FlowControlConfigPtr &config) const;
     void getFlowControlSwitch(const std::vector<std::string> &strategyVec, bool &earlyTermination,
-                              bool &retry, bool &singleRetry) const;
+                              bool &retry, bool &singleRetry, bool &hedge) const;
     const FlowControlConfigMap &getConfigMap() const {
         return *_configMap;
     }
@@ -60,6 +60,15 @@ int64_t LatencyTimeSnapshot::getAvgLatency(const std::string &bizName) {
     }
 }
 
+int64_t LatencyTimeSnapshot::getPercentileLatency(const std::string &bizName, float percent) {
+    auto latencyTimeWindow = getLatencyTimeWindow(bizName);
+    if (latencyTimeWindow) {
+        return latencyTimeWindow->getPercentileLatency(percent);
+    } else {
+        return -1;
+    }
+}
+
 int64_t LatencyTimeSnapshot::pushLatency(const std::string &bizName, int64_t latency) {
     auto latencyTimeWindow = getLatencyTimeWindow(bizName);
     if (latencyTimeWindow) {
@@ -28,6 +28,7 @@ public:
     void updateLatencyTimeWindow(const std::string &bizName, int64_t windowSize);
     LatencyTimeWindowPtr getLatencyTimeWindow(const std::string &bizName);
     int64_t getAvgLatency(const std::string &bizName);
+    int64_t getPercentileLatency(const std::string &bizName, float percent);
     int64_t pushLatency(const std::string &bizName, int64_t latency);
 
 private:
@@ -7,9 +7,17 @@
 
 #include "aios/network/gig/multi_call/service/LatencyTimeWindow.h"
 
+#include <algorithm>
+
 namespace multi_call {
 
-LatencyTimeWindow::LatencyTimeWindow(int64_t windowSize) : _windowSize(windowSize) {
+LatencyTimeWindow::LatencyTimeWindow(int64_t windowSize)
+    : _windowSize(windowSize)
+    , _sampleCount(0)
+    , _decaying(false) {
+    for (auto &bucket : _buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
 }
 
 LatencyTimeWindow::~LatencyTimeWindow() {
@@ -26,7 +34,73 @@ int64_t LatencyTimeWindow::push(int64_t latency) {
     int64_t value = (latency << 10) + (avg * (_windowSize - 1));
     value /= _windowSize;
     _currentAvg.setValue(value);
+    pushHistogram(latency);
     return value >> 10;
 }
 
+/* 对数分桶的延迟直方图, 用于估计分位数,
+ * 样本数超过HEDGE_LATENCY_WINDOW_SIZE后所有桶减半, 旧样本逐渐淡出
+ */
+void LatencyTimeWindow::pushHistogram(int64_t latency) {
+    _buckets[getBucketIndex(latency)].fetch_add(1, std::memory_order_relaxed);
+    auto count = _sampleCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (count >= 2 * HEDGE_LATENCY_WINDOW_SIZE) {
+        decayHistogram();
+    }
+}
+
+void LatencyTimeWindow::decayHistogram() {
+    if (_decaying.exchange(true, std::memory_order_acquire)) {
+        return;
+    }
+    int64_t total = 0;
+    for (auto &bucket : _buckets) {
+        auto value = bucket.load(std::memory_order_relaxed) / 2;
+        bucket.store(value, std::memory_order_relaxed);
+        total += value;
+    }
+    _sampleCount.store(total, std::memory_order_relaxed);
+    _decaying.store(false, std::memory_order_release);
+}
+
+int64_t LatencyTimeWindow::getPercentileLatency(float percent) const {
+    int64_t counts[BUCKET_COUNT];
+    int64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        counts[i] = _buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total < HEDGE_MIN_LATENCY_SAMPLE) {
+        return -1;
+    }
+    auto target = (int64_t)(total * percent);
+    int64_t current = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        current += counts[i];
+        if (current > target) {
+            return getBucketLatency(i);
+        }
+    }
+    return getBucketLatency(BUCKET_COUNT - 1);
+}
+
+size_t LatencyTimeWindow::getBucketIndex(int64_t latency) {
+    if (latency < 8) {
+        return latency < 0 ? 0 : latency;
+    }
+    size_t highBit = 63 - __builtin_clzll(latency);
+    size_t subBucket = (latency >> (highBit - 2)) & 3;
+    return std::min(highBit * 4 + subBucket, BUCKET_COUNT - 1);
+}
+
+// upper bound of the bucket
+int64_t LatencyTimeWindow::getBucketLatency(size_t index) {
+    if (index < 8) {
+        return index + 1;
+    }
+    size_t highBit = index / 4;
+    size_t subBucket = index % 4;
+    return (int64_t)(4 + subBucket + 1) << (highBit - 2);
+}
+
 } // namespace multi_call
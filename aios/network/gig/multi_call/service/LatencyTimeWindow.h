@@ -8,6 +8,9 @@
 #ifndef ISEARCH_MULTI_CALL_LATENCYTIMEWINDOW_H_
 #define ISEARCH_MULTI_CALL_LATENCYTIMEWINDOW_H_
 
+#include <atomic>
+
+#include "aios/network/gig/multi_call/common/ControllerParam.h"
 #include "aios/network/gig/multi_call/common/common.h"
 #include "autil/AtomicCounter.h"
 
@@ -33,10 +36,25 @@ public:
             return;
         _windowSize = windowSize;
     }
+    // -1 if there are not enough samples yet
+    int64_t getPercentileLatency(float percent) const;
+
+private:
+    void pushHistogram(int64_t latency);
+    void decayHistogram();
+    static size_t getBucketIndex(int64_t latency);
+    static int64_t getBucketLatency(size_t index);
+
+private:
+    // 4 buckets per power of 2, up to 2^31 us
+    static constexpr size_t BUCKET_COUNT = 128;
 
 private:
     int64_t _windowSize;
     autil::AtomicCounter _currentAvg;
+    std::atomic<int64_t> _sampleCount;
+    std::atomic<bool> _decaying;
+    std::atomic<int64_t> _buckets[BUCKET_COUNT];
 };
 
 MULTI_CALL_TYPEDEF_PTR(LatencyTimeWindow);
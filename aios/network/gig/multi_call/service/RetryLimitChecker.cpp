@@ -15,6 +15,9 @@
  */
 #include "aios/network/gig/multi_call/service/RetryLimitChecker.h"
 
+#include <algorithm>
+
+#include "aios/network/gig/multi_call/common/ControllerParam.h"
 #include "autil/TimeUtility.h"
 
 using namespace std;
@@ -63,30 +66,79 @@ bool RetryCheckerItem::canRetry(int64_t currentTimeInSeconds, int32_t retryCount
     return true;
 }
 
-bool RetryLimitChecker::canRetry(const string &strategy, int64_t currentTimeInSeconds,
-                                 int32_t retryCountLimit) {
-    RetryCheckerItem *item = nullptr;
+void RetryCheckerItem::addHedgeBudget(size_t requestCount, float budgetRatio) {
+    constexpr int64_t maxBudget = HEDGE_BUDGET_BURST * HEDGE_BUDGET_SCALE;
+    auto earned = (int64_t)(requestCount * budgetRatio * HEDGE_BUDGET_SCALE);
+    auto budget = hedgeBudget.load(std::memory_order_relaxed);
+    while (budget < maxBudget) {
+        auto newBudget = std::min(budget + earned, maxBudget);
+        if (hedgeBudget.compare_exchange_weak(budget, newBudget, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+}
+
+bool RetryCheckerItem::consumeHedgeBudget() {
+    auto budget = hedgeBudget.load(std::memory_order_relaxed);
+    while (budget >= HEDGE_BUDGET_SCALE) {
+        if (hedgeBudget.compare_exchange_weak(budget, budget - HEDGE_BUDGET_SCALE,
+                                              std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void RetryCheckerItem::refundHedgeBudget() {
+    constexpr int64_t maxBudget = HEDGE_BUDGET_BURST * HEDGE_BUDGET_SCALE;
+    auto budget = hedgeBudget.load(std::memory_order_relaxed);
+    while (budget < maxBudget) {
+        auto newBudget = std::min(budget + HEDGE_BUDGET_SCALE, maxBudget);
+        if (hedgeBudget.compare_exchange_weak(budget, newBudget, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+}
+
+RetryCheckerItem *RetryLimitChecker::getCheckerItem(const string &strategy) {
     {
         ScopedReadLock rlock(_checkerLock);
         auto iter = _StrategyRetryChecker.find(strategy);
         if (_StrategyRetryChecker.end() != iter) {
-            item = iter->second.get();
+            return iter->second.get();
         }
     }
-    if (item) {
-        return item->canRetry(currentTimeInSeconds, retryCountLimit);
-    } else {
-        ScopedWriteLock wlock(_checkerLock);
-        auto iter = _StrategyRetryChecker.find(strategy);
-        if (_StrategyRetryChecker.end() != iter) {
-            return iter->second->canRetry(currentTimeInSeconds, retryCountLimit);
-        } else {
-            auto checkerItem = make_unique<RetryCheckerItem>();
-            bool ret = checkerItem->canRetry(currentTimeInSeconds, retryCountLimit);
-            _StrategyRetryChecker[strategy] = std::move(checkerItem);
-            return ret;
-        }
+    ScopedWriteLock wlock(_checkerLock);
+    auto &item = _StrategyRetryChecker[strategy];
+    if (!item) {
+        item = make_unique<RetryCheckerItem>();
     }
+    return item.get();
+}
+
+bool RetryLimitChecker::canRetry(const string &strategy, int64_t currentTimeInSeconds,
+                                 int32_t retryCountLimit) {
+    return getCheckerItem(strategy)->canRetry(currentTimeInSeconds, retryCountLimit);
+}
+
+void RetryLimitChecker::addHedgeBudget(const string &strategy, size_t requestCount,
+                                       float budgetRatio) {
+    getCheckerItem(strategy)->addHedgeBudget(requestCount, budgetRatio);
+}
+
+bool RetryLimitChecker::canHedge(const string &strategy, int64_t currentTimeInSeconds,
+                                 int32_t retryCountLimit) {
+    auto item = getCheckerItem(strategy);
+    if (!item->consumeHedgeBudget()) {
+        AUTIL_INTERVAL_LOG(200, INFO, "hedge budget exhausted, strategy [%s]", strategy.c_str());
+        return false;
+    }
+    if (!item->canRetry(currentTimeInSeconds, retryCountLimit)) {
+        // no hedge is sent, give the token back
+        item->refundHedgeBudget();
+        return false;
+    }
+    return true;
 }
 
 } // namespace multi_call
@@ -16,6 +16,7 @@
 #ifndef ISEARCH_MULTI_CALL_RETRYLIMITCHECKER_H
 #define ISEARCH_MULTI_CALL_RETRYLIMITCHECKER_H
 
+#include <atomic>
 #include <unordered_map>
 
 #include "aios/network/gig/multi_call/common/common.h"
@@ -27,7 +28,15 @@ struct RetryCheckerItem {
     int32_t retryCountPerSecond = 0;
     int64_t retryTimeStamp = 0;
     autil::ReadWriteLock limitLock;
+    // hedge tokens scaled by HEDGE_BUDGET_SCALE, earned by normal requests
+    std::atomic<int64_t> hedgeBudget{0};
     bool canRetry(int64_t currentTimeInSeconds, int32_t retryCountLimit);
+    void addHedgeBudget(size_t requestCount, float budgetRatio);
+    bool consumeHedgeBudget();
+    void refundHedgeBudget();
+
+public:
+    static constexpr int64_t HEDGE_BUDGET_SCALE = 1000;
 
 private:
     AUTIL_LOG_DECLARE();
@@ -45,6 +54,13 @@ private:
 public:
     bool canRetry(const std::string &strategy, int64_t currentTimeInSeconds,
                   int32_t retryCountLimit);
+    void addHedgeBudget(const std::string &strategy, size_t requestCount, float budgetRatio);
+    // takes one hedge token and one retry quota, nothing is taken if either is exhausted
+    bool canHedge(const std::string &strategy, int64_t currentTimeInSeconds,
+                  int32_t retryCountLimit);
+
+private:
+    RetryCheckerItem *getCheckerItem(const std::string &strategy);
 
 private:
     std::unordered_map<std::string, std::unique_ptr<RetryCheckerItem>> _StrategyRetryChecker;
@@ -96,6 +96,9 @@ public:
     bool singleRetryEnabled() const {
         return !_disableRetry && _flowControlConfig && _flowControlConfig->singleRetryEnabled();
     }
+    bool hedgeEnabled() const {
+        return !_disableRetry && _flowControlConfig && _flowControlConfig->hedgeEnabled();
+    }
     bool hasRetried() const {
         return _retryResponse.get();
     }
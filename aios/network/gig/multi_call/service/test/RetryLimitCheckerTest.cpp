@@ -0,0 +1,62 @@
+#include "aios/network/gig/multi_call/service/RetryLimitChecker.h"
+
+#include "aios/network/gig/multi_call/common/ControllerParam.h"
+#include "unittest/unittest.h"
+
+using namespace std;
+
+namespace multi_call {
+
+class RetryLimitCheckerTest : public TESTBASE
+{
+protected:
+    int64_t getHedgeBudget(RetryLimitChecker &checker, const string &strategy) {
+        return checker.getCheckerItem(strategy)->hedgeBudget.load() /
+               RetryCheckerItem::HEDGE_BUDGET_SCALE;
+    }
+};
+
+TEST_F(RetryLimitCheckerTest, testCanHedgeConsumesBudget) {
+    RetryLimitChecker checker;
+    checker.addHedgeBudget("s", 2, 1.0f);
+    ASSERT_EQ(2, getHedgeBudget(checker, "s"));
+    ASSERT_TRUE(checker.canHedge("s", 10, -1));
+    ASSERT_TRUE(checker.canHedge("s", 10, -1));
+    ASSERT_FALSE(checker.canHedge("s", 10, -1));
+    ASSERT_EQ(0, getHedgeBudget(checker, "s"));
+    // budget is kept per strategy
+    ASSERT_FALSE(checker.canHedge("other", 10, -1));
+}
+
+TEST_F(RetryLimitCheckerTest, testRetryLimitKeepsHedgeBudget) {
+    RetryLimitChecker checker;
+    checker.addHedgeBudget("s", 1, 1.0f);
+    ASSERT_TRUE(checker.canRetry("s", 10, 1));
+    // budget ok but retry limit hit, the token is given back
+    ASSERT_FALSE(checker.canHedge("s", 10, 1));
+    ASSERT_FALSE(checker.canHedge("s", 10, 1));
+    ASSERT_EQ(1, getHedgeBudget(checker, "s"));
+    // retry quota of the next second lets the kept token hedge
+    ASSERT_TRUE(checker.canHedge("s", 11, 1));
+    ASSERT_EQ(0, getHedgeBudget(checker, "s"));
+}
+
+TEST_F(RetryLimitCheckerTest, testBudgetExhaustedKeepsRetryQuota) {
+    RetryLimitChecker checker;
+    ASSERT_TRUE(checker.canRetry("s", 10, 2));
+    ASSERT_FALSE(checker.canHedge("s", 10, 2));
+    // the failed hedge took no retry quota
+    ASSERT_TRUE(checker.canRetry("s", 10, 2));
+    ASSERT_FALSE(checker.canRetry("s", 10, 2));
+}
+
+TEST_F(RetryLimitCheckerTest, testRefundCappedByBurst) {
+    RetryLimitChecker checker;
+    checker.addHedgeBudget("s", 2 * HEDGE_BUDGET_BURST, 1.0f);
+    ASSERT_EQ(HEDGE_BUDGET_BURST, getHedgeBudget(checker, "s"));
+    ASSERT_TRUE(checker.canRetry("s", 10, 1));
+    ASSERT_FALSE(checker.canHedge("s", 10, 1));
+    ASSERT_EQ(HEDGE_BUDGET_BURST, getHedgeBudget(checker, "s"));
+}
+
+} // namespace multi_call
@@ -193,6 +193,7 @@ constexpr char IQUAN_EXEC_LEADER_PREFER_LEVEL[] = "exec.leader.prefer.level";
 constexpr char IQUAN_EXEC_TASK_QUEUE[] = "exec.task.queue";
 constexpr char IQUAN_EXEC_USER_KV[] = "exec.user.kv";
 constexpr char IQUAN_EXEC_INLINE_WORKER[] = "exec.inline.worker";
+constexpr char IQUAN_EXEC_FUSE_KERNEL[] = "exec.fuse.kernel";
 constexpr char IQUAN_EXEC_ATTR_SOURCE_ID[] = "source_id";
 constexpr char IQUAN_EXEC_ATTR_SOURCE_SPEC[] = "source_spec";
 constexpr char IQUAN_EXEC_ATTR_TASK_QUEUE[] = "task_queue";
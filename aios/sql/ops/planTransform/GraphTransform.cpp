@@ -370,6 +370,7 @@ GraphTransform::Config::Config(const iquan::ExecConfig &execConfig,
             qrsGraphInline = true;
             searcherGraphInline = true;
         }
+        fuseKernel = getRequestParam(IQUAN_EXEC_FUSE_KERNEL) == "true";
     }
     {
         const auto &tables = _execConfig.parallelConfig.parallelTables;
@@ -1072,6 +1073,9 @@ navi::GraphId GraphTransform::newSubGraph(plan::GraphRoot &root, navi::GraphBuil
     if (root.getInlineMode()) {
         _builder->inlineMode(true);
     }
+    if (_config.fuseKernel) {
+        _builder->fuseLinearChain(true);
+    }
     const auto &curDist = root.getCurDist();
     if (!curDist.empty()) {
         _builder->subGraphAttr("table_distribution", curDist);
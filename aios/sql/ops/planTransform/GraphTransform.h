@@ -244,6 +244,7 @@ public:
         std::string leaderPreferLevel;
         bool qrsGraphInline {false};
         bool searcherGraphInline {false};
+        bool fuseKernel {false};
         std::set<std::string> parallelTables;
         std::set<std::string> logicTableOps;
         iquan::DynamicParams const *params {nullptr};
@@ -45,7 +45,8 @@ RangeScanIterator::RangeScanIterator(
     , _delMapReader(delMapReader)
     , _layerMeta(layerMeta)
     , _rangeIdx(0)
-    , _curId(-1) {}
+    , _curId(-1)
+    , _nonDeletedRunEnd(-1) {}
 
 Result<bool> RangeScanIterator::batchSeek(size_t batchSize,
                                           std::vector<matchdoc::MatchDoc> &matchDocs) {
@@ -59,15 +60,29 @@ Result<bool> RangeScanIterator::batchSeek(size_t batchSize,
     for (; _rangeIdx < _layerMeta->size(); ++_rangeIdx) {
         auto &range = (*_layerMeta)[_rangeIdx];
         _curId = _curId >= (range.begin - 1) ? _curId : (range.begin - 1);
+        // run is clamped to the range and realtime docs may be deleted between batches, query it again
+        _nonDeletedRunEnd = -1;
         while (docCount < batchSize && ++_curId <= range.end) {
             if (_timeoutTerminator && _timeoutTerminator->checkTimeout()) {
                 _isTimeout = true;
                 break;
             }
-            ++_totalScanCount;
-            if (_delMapReader && _delMapReader->IsDeleted(_curId)) {
-                continue;
+            if (_delMapReader && _curId >= _nonDeletedRunEnd) {
+                // skip deleted docs by run instead of testing them one by one, the run is looked up in windows of
+                // at most minBatchSize docs so that timeout is still checked in long deleted or non-deleted spans
+                docid_t runLimit = (docid_t)std::min((int64_t)range.end + 1, (int64_t)_curId + minBatchSize);
+                auto [runBegin, runEnd] = _delMapReader->GetNextNonDeletedRun(_curId, runLimit);
+                if (runBegin >= runEnd) {
+                    // all deleted in the window, go on from its end
+                    _totalScanCount += runLimit - _curId;
+                    _curId = runLimit - 1;
+                    continue;
+                }
+                _totalScanCount += runBegin - _curId;
+                _curId = runBegin;
+                _nonDeletedRunEnd = runEnd;
             }
+            ++_totalScanCount;
             docIds.push_back(_curId);
             if (docIds.size() >= minBatchSize) {
                 docCount += batchFilter(docIds, matchDocs);
@@ -61,6 +61,7 @@ private:
     isearch::search::LayerMetaPtr _layerMeta; // hold resource for queryexecutor use raw pointer
     size_t _rangeIdx;
     int32_t _curId;
+    int32_t _nonDeletedRunEnd; // docs in [_curId, _nonDeletedRunEnd) are known not deleted
 };
 
 typedef std::shared_ptr<RangeScanIterator> RangeScanIteratorPtr;
@@ -15,6 +15,7 @@
  */
 #include "sql/ops/scan/RangeScanIteratorWithoutFilter.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 
@@ -40,7 +41,8 @@ RangeScanIteratorWithoutFilter::RangeScanIteratorWithoutFilter(
     , _delMapReader(delMapReader)
     , _layerMeta(layerMeta)
     , _rangeIdx(0)
-    , _curId(-1) {}
+    , _curId(-1)
+    , _nonDeletedRunEnd(-1) {}
 
 Result<bool> RangeScanIteratorWithoutFilter::batchSeek(size_t batchSize,
                                                        std::vector<matchdoc::MatchDoc> &matchDocs) {
@@ -50,18 +52,33 @@ Result<bool> RangeScanIteratorWithoutFilter::batchSeek(size_t batchSize,
     size_t docCount = 0;
     std::vector<int32_t> docIds;
     docIds.reserve(batchSize);
+    size_t runLimitSize = std::min(batchSize, (size_t)DEFAULT_BATCH_COUNT);
     for (; _rangeIdx < _layerMeta->size(); ++_rangeIdx) {
         auto &range = (*_layerMeta)[_rangeIdx];
         _curId = _curId >= (range.begin - 1) ? _curId : (range.begin - 1);
+        // run is clamped to the range and realtime docs may be deleted between batches, query it again
+        _nonDeletedRunEnd = -1;
         while (docCount < batchSize && ++_curId <= range.end) {
             if (_timeoutTerminator && _timeoutTerminator->checkTimeout()) {
                 _isTimeout = true;
                 break;
             }
-            ++_totalScanCount;
-            if (_delMapReader && _delMapReader->IsDeleted(_curId)) {
-                continue;
+            if (_delMapReader && _curId >= _nonDeletedRunEnd) {
+                // skip deleted docs by run instead of testing them one by one, the run is looked up in windows of
+                // at most runLimitSize docs so that timeout is still checked in long deleted or non-deleted spans
+                docid_t runLimit = (docid_t)std::min((int64_t)range.end + 1, (int64_t)_curId + runLimitSize);
+                auto [runBegin, runEnd] = _delMapReader->GetNextNonDeletedRun(_curId, runLimit);
+                if (runBegin >= runEnd) {
+                    // all deleted in the window, go on from its end
+                    _totalScanCount += runLimit - _curId;
+                    _curId = runLimit - 1;
+                    continue;
+                }
+                _totalScanCount += runBegin - _curId;
+                _curId = runBegin;
+                _nonDeletedRunEnd = runEnd;
             }
+            ++_totalScanCount;
             docIds.push_back(_curId);
             ++docCount;
         }
@@ -129,6 +129,77 @@ TEST_F(RangeScanIteratorWithoutFilterTest, testBatchSeek100WithMultRange) {
     }
 }
 
+TEST_F(RangeScanIteratorWithoutFilterTest, testBatchSeekWithDeletion) {
+    autil::mem_pool::PoolAsan pool;
+    LayerMetaPtr layerMeta(new LayerMeta(&pool));
+    layerMeta->push_back(DocIdRangeMeta(10, 30, DocIdRangeMeta::OT_UNKNOWN, 21));
+    layerMeta->push_back(DocIdRangeMeta(40, 50, DocIdRangeMeta::OT_UNKNOWN, 11));
+    MatchDocAllocatorPtr allocator(new MatchDocAllocator(&pool));
+    indexlib::index::DeletionMapReaderPtr delMapReader(new indexlib::index::DeletionMapReader(100));
+    delMapReader->Delete(12);
+    delMapReader->Delete(13);
+    delMapReader->Delete(45);
+    auto delMapReaderAdaptor = make_shared<indexlib::index::DeletionMapReaderAdaptor>(delMapReader);
+    RangeScanIteratorWithoutFilter scanIter(allocator, delMapReaderAdaptor, layerMeta);
+    vector<MatchDoc> matchDocVec;
+    bool ret = scanIter.batchSeek(5, matchDocVec).unwrap();
+    ASSERT_TRUE(!ret);
+    vector<int32_t> expect {10, 11, 14, 15, 16};
+    ASSERT_EQ(expect.size(), matchDocVec.size());
+    for (size_t i = 0; i < expect.size(); i++) {
+        ASSERT_EQ(expect[i], matchDocVec[i].getDocId());
+    }
+    ASSERT_EQ(7, scanIter.getTotalScanCount());
+    matchDocVec.clear();
+
+    // realtime deletions between batches must be seen by the next batch
+    delMapReader->Delete(17);
+    delMapReader->Delete(18);
+    delMapReader->Delete(46);
+    ret = scanIter.batchSeek(5, matchDocVec).unwrap();
+    ASSERT_TRUE(!ret);
+    expect = {19, 20, 21, 22, 23};
+    ASSERT_EQ(expect.size(), matchDocVec.size());
+    for (size_t i = 0; i < expect.size(); i++) {
+        ASSERT_EQ(expect[i], matchDocVec[i].getDocId());
+    }
+    matchDocVec.clear();
+
+    ret = scanIter.batchSeek(100, matchDocVec).unwrap();
+    ASSERT_TRUE(ret);
+    expect = {24, 25, 26, 27, 28, 29, 30, 40, 41, 42, 43, 44, 47, 48, 49, 50};
+    ASSERT_EQ(expect.size(), matchDocVec.size());
+    for (size_t i = 0; i < expect.size(); i++) {
+        ASSERT_EQ(expect[i], matchDocVec[i].getDocId());
+    }
+    ASSERT_EQ(21 + 11, scanIter.getTotalScanCount());
+}
+
+TEST_F(RangeScanIteratorWithoutFilterTest, testLongDeletedSpanChecksTimeout) {
+    int32_t docCount = 10000;
+    autil::mem_pool::PoolAsan pool;
+    LayerMetaPtr layerMeta(new LayerMeta(&pool));
+    layerMeta->push_back(DocIdRangeMeta(0, docCount - 1, DocIdRangeMeta::OT_UNKNOWN, docCount));
+    MatchDocAllocatorPtr allocator(new MatchDocAllocator(&pool));
+    indexlib::index::DeletionMapReaderPtr delMapReader(new indexlib::index::DeletionMapReader(docCount));
+    for (int32_t docId = 0; docId < docCount - 1; docId++) {
+        delMapReader->Delete(docId);
+    }
+    auto delMapReaderAdaptor = make_shared<indexlib::index::DeletionMapReaderAdaptor>(delMapReader);
+    autil::TimeoutTerminator timeoutTerminator;
+    RangeScanIteratorWithoutFilter scanIter(
+        allocator, delMapReaderAdaptor, layerMeta, &timeoutTerminator);
+    vector<MatchDoc> matchDocVec;
+    size_t batchSize = 10;
+    bool ret = scanIter.batchSeek(batchSize, matchDocVec).unwrap();
+    ASSERT_TRUE(ret);
+    ASSERT_EQ(1, matchDocVec.size());
+    ASSERT_EQ(docCount - 1, matchDocVec[0].getDocId());
+    ASSERT_EQ(docCount, scanIter.getTotalScanCount());
+    // deleted docs are skipped in windows of batch size docs, timeout is checked for each window
+    ASSERT_LE(docCount / batchSize, timeoutTerminator.getCheckTimes());
+}
+
 TEST_F(RangeScanIteratorWithoutFilterTest, testSeekTimeOut) {
     int32_t begin = 10;
     int32_t end = 100;
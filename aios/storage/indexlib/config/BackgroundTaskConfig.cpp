@@ -34,6 +34,7 @@ struct BackgroundTaskConfig::Impl {
     int64_t asyncDumpIntervalMs = 10 * 1000;            // 10s
     int64_t mergeIntervalMs = 1 * 60 * 1000;            // 1min
     int64_t subscribeRemoteIndexIntervalMs = 0;         // do not subscribe remote index, for madrox
+    int64_t recordPageHeatIntervalMs = 5 * 60 * 1000;   // 5min, only for recorded warmup
 };
 
 BackgroundTaskConfig::BackgroundTaskConfig() : _impl(std::make_unique<BackgroundTaskConfig::Impl>())
@@ -87,6 +88,7 @@ void BackgroundTaskConfig::Jsonize(autil::legacy::Jsonizable::JsonWrapper& json)
     json.Jsonize("merge_interval_ms", _impl->mergeIntervalMs, _impl->mergeIntervalMs);
     json.Jsonize("subscribe_remote_index_interval_ms", _impl->subscribeRemoteIndexIntervalMs,
                  _impl->subscribeRemoteIndexIntervalMs);
+    json.Jsonize("record_page_heat_interval_ms", _impl->recordPageHeatIntervalMs, _impl->recordPageHeatIntervalMs);
 }
 
 int64_t BackgroundTaskConfig::GetCleanResourceIntervalMs() const { return _impl->cleanResourceIntervalMs; }
@@ -99,6 +101,7 @@ int64_t BackgroundTaskConfig::GetSubscribeRemoteIndexIntervalMs() const
 {
     return _impl->subscribeRemoteIndexIntervalMs;
 }
+int64_t BackgroundTaskConfig::GetRecordPageHeatIntervalMs() const { return _impl->recordPageHeatIntervalMs; }
 
 void BackgroundTaskConfig::SwitchToTestDefault()
 {
@@ -120,6 +123,7 @@ void BackgroundTaskConfig::DisableAll()
     _impl->asyncDumpIntervalMs = INVALID_INTERVAL;
     _impl->mergeIntervalMs = INVALID_INTERVAL;
     _impl->subscribeRemoteIndexIntervalMs = INVALID_INTERVAL;
+    _impl->recordPageHeatIntervalMs = INVALID_INTERVAL;
 }
 
 } // namespace indexlibv2::config
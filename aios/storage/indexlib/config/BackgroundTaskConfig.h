@@ -43,6 +43,7 @@ public:
     int64_t GetAsyncDumpIntervalMs() const;
     int64_t GetMergeIntervalMs() const;
     int64_t GetSubscribeRemoteIndexIntervalMs() const;
+    int64_t GetRecordPageHeatIntervalMs() const;
 
 private:
     void SwitchToTestDefault();
@@ -117,7 +117,7 @@ FSResult<std::shared_ptr<FileNodeCreator>> DiskStorage::CreateFileNodeCreator(co
 
     std::shared_ptr<FileNodeCreator> fileNodeCreator;
     if (loadConfig.GetLoadStrategyName() == READ_MODE_MMAP) {
-        fileNodeCreator.reset(new MmapFileNodeCreator());
+        fileNodeCreator.reset(new MmapFileNodeCreator(_options->lazyLoadScheduler, _options->pageHeatRecorder));
     } else if (loadConfig.GetLoadStrategyName() == READ_MODE_MEM) {
         fileNodeCreator.reset(new MemFileNodeCreator());
     } else if (loadConfig.GetLoadStrategyName() == READ_MODE_CACHE) {
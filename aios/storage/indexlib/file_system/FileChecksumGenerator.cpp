@@ -0,0 +1,75 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/file_system/FileChecksumGenerator.h"
+
+#include "autil/ThreadPool.h"
+#include "indexlib/file_system/FileChecksumTable.h"
+
+using namespace std;
+
+namespace indexlib { namespace file_system {
+AUTIL_LOG_SETUP(indexlib.file_system, FileChecksumGenerator);
+
+FileChecksumGenerator::FileChecksumGenerator() {}
+
+FileChecksumGenerator::~FileChecksumGenerator() { Stop(); }
+
+bool FileChecksumGenerator::Start()
+{
+    if (_threadPool) {
+        return true;
+    }
+    auto threadPool = std::make_unique<autil::ThreadPool>(/*threadNum=*/1, GENERATE_QUEUE_SIZE,
+                                                          /*stopIfHasException=*/false, "FileChecksum");
+    if (!threadPool->start()) {
+        AUTIL_LOG(WARN, "start file checksum thread pool failed");
+        return false;
+    }
+    _threadPool = std::move(threadPool);
+    return true;
+}
+
+void FileChecksumGenerator::Stop()
+{
+    if (_threadPool) {
+        _threadPool->stop(autil::ThreadPool::STOP_AND_CLEAR_QUEUE);
+        _threadPool.reset();
+    }
+}
+
+bool FileChecksumGenerator::GenerateAsync(const string& physicalRoot, versionid_t versionId,
+                                          const string& lastPhysicalRoot, versionid_t lastVersionId)
+{
+    if (!_threadPool) {
+        AUTIL_LOG(WARN, "file checksum generator is not started, skip version [%d] in [%s]", versionId,
+                  physicalRoot.c_str());
+        return false;
+    }
+    auto task = [physicalRoot, versionId, lastPhysicalRoot, lastVersionId]() {
+        auto ec = FileChecksumTable::Generate(physicalRoot, versionId, lastPhysicalRoot, lastVersionId);
+        if (ec != FSEC_OK) {
+            AUTIL_LOG(WARN, "generate file checksum table for version [%d] in [%s] failed, ec[%d]", versionId,
+                      physicalRoot.c_str(), ec);
+        }
+    };
+    if (_threadPool->pushTask(std::move(task), /*isBlocked=*/false) != autil::ThreadPool::ERROR_NONE) {
+        AUTIL_LOG(WARN, "file checksum queue is full, skip version [%d] in [%s]", versionId, physicalRoot.c_str());
+        return false;
+    }
+    return true;
+}
+
+}} // namespace indexlib::file_system
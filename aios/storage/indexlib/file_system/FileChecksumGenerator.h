@@ -0,0 +1,55 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "autil/Log.h"
+#include "autil/NoCopyable.h"
+#include "indexlib/base/Types.h"
+
+namespace autil {
+class ThreadPool;
+}
+
+namespace indexlib { namespace file_system {
+
+// Generates file checksum tables in a background thread owned by the caller, e.g. the tablet committer. Tables are
+// generated one by one in commit order, so each table can reuse the one of the previous version.
+class FileChecksumGenerator : private autil::NoCopyable
+{
+public:
+    FileChecksumGenerator();
+    ~FileChecksumGenerator();
+
+public:
+    bool Start();
+    // pending tables are dropped, the one being generated is finished
+    void Stop();
+    // lastPhysicalRoot and lastVersionId locate the table of the previously published version, if any
+    bool GenerateAsync(const std::string& physicalRoot, versionid_t versionId, const std::string& lastPhysicalRoot,
+                       versionid_t lastVersionId);
+
+private:
+    std::unique_ptr<autil::ThreadPool> _threadPool;
+
+private:
+    static constexpr size_t GENERATE_QUEUE_SIZE = 64;
+    AUTIL_LOG_DECLARE();
+};
+
+}} // namespace indexlib::file_system
@@ -0,0 +1,266 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/file_system/FileChecksumTable.h"
+
+#include <stdio.h>
+#include <vector>
+
+#include "autil/CRC32C.h"
+#include "autil/CommonMacros.h"
+#include "autil/MurmurHash.h"
+#include "autil/StringUtil.h"
+#include "indexlib/file_system/IndexFileDeployer.h"
+#include "indexlib/file_system/JsonUtil.h"
+#include "indexlib/file_system/fslib/FslibFileWrapper.h"
+#include "indexlib/file_system/fslib/FslibWrapper.h"
+#include "indexlib/file_system/load_config/LoadConfigList.h"
+#include "indexlib/util/PathUtil.h"
+
+using namespace std;
+
+namespace indexlib { namespace file_system {
+AUTIL_LOG_SETUP(indexlib.file_system, FileChecksumTable);
+
+void FileChecksumTable::Jsonize(autil::legacy::Jsonizable::JsonWrapper& json)
+{
+    json.Jsonize("checksums", _checksums, _checksums);
+    json.Jsonize("modify_times", _modifyTimes, _modifyTimes);
+}
+
+string FileChecksumTable::GetFileName(versionid_t versionId)
+{
+    return string(FILE_CHECKSUM_FILE_NAME_DOT_PREFIX) + std::to_string(versionId);
+}
+
+FSResult<bool> FileChecksumTable::Load(const string& physicalRoot, versionid_t versionId) noexcept
+{
+    _checksums.clear();
+    _modifyTimes.clear();
+    auto ec = JsonUtil::Load(util::PathUtil::JoinPath(physicalRoot, GetFileName(versionId)), this).Code();
+    if (ec == FSEC_NOENT) {
+        return {FSEC_OK, false};
+    }
+    if (ec != FSEC_OK) {
+        _checksums.clear();
+        _modifyTimes.clear();
+        return {ec, false};
+    }
+    return {FSEC_OK, true};
+}
+
+ErrorCode FileChecksumTable::Store(const string& physicalRoot, versionid_t versionId) const noexcept
+{
+    auto [ec, content] = JsonUtil::ToString(*this);
+    RETURN_IF_FS_ERROR(ec, "serialize file checksum table failed");
+    string path = util::PathUtil::JoinPath(physicalRoot, GetFileName(versionId));
+    ec = FslibWrapper::AtomicStore(path, content, /*removeIfExist=*/true).Code();
+    RETURN_IF_FS_ERROR(ec, "store file checksum table [%s] failed", path.c_str());
+    return FSEC_OK;
+}
+
+string FileChecksumTable::MakeKey(const string& physicalRoot, const string& filePath) noexcept
+{
+    string root = util::PathUtil::NormalizePath(physicalRoot) + "/";
+    string path = util::PathUtil::NormalizePath(filePath);
+    if (autil::StringUtil::startsWith(path, root)) {
+        return path.substr(root.size());
+    }
+    return path;
+}
+
+const string* FileChecksumTable::Find(const string& physicalRoot, const string& filePath) const noexcept
+{
+    auto it = _checksums.find(MakeKey(physicalRoot, filePath));
+    return it == _checksums.end() ? nullptr : &it->second;
+}
+
+void FileChecksumTable::Set(const string& physicalRoot, const string& filePath, const string& checksum,
+                            uint64_t modifyTime) noexcept
+{
+    string key = MakeKey(physicalRoot, filePath);
+    _checksums[key] = checksum;
+    if (modifyTime != INVALID_MODIFY_TIME) {
+        _modifyTimes[key] = modifyTime;
+    } else {
+        _modifyTimes.erase(key);
+    }
+}
+
+const string* FileChecksumTable::FindReusable(const string& key, int64_t length, uint64_t modifyTime) const noexcept
+{
+    // a file rewritten in place may keep its length, so the modify time must match as well
+    if (length < 0 || modifyTime == INVALID_MODIFY_TIME) {
+        return nullptr;
+    }
+    auto timeIt = _modifyTimes.find(key);
+    if (timeIt == _modifyTimes.end() || timeIt->second != modifyTime) {
+        return nullptr;
+    }
+    auto it = _checksums.find(key);
+    if (it == _checksums.end() || !autil::StringUtil::startsWith(it->second, std::to_string(length) + "-")) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void FileChecksumTable::Fill(const string& physicalRoot, DeployIndexMeta* deployIndexMeta) const noexcept
+{
+    auto fill = [&](IndexFileList::FileInfoVec& fileInfos) {
+        for (auto& fileInfo : fileInfos) {
+            if (!fileInfo.isFile() || !fileInfo.checksum.empty()) {
+                continue;
+            }
+            auto checksum =
+                Find(physicalRoot, util::PathUtil::JoinPath(deployIndexMeta->sourceRootPath, fileInfo.filePath));
+            if (checksum) {
+                fileInfo.checksum = *checksum;
+            }
+        }
+    };
+    fill(deployIndexMeta->deployFileMetas);
+    fill(deployIndexMeta->finalDeployFileMetas);
+}
+
+FSResult<string> FileChecksumTable::ComputeChecksum(const string& filePath) noexcept
+{
+    auto [ec, file] = FslibWrapper::OpenFile(filePath, fslib::READ);
+    RETURN2_IF_FS_ERROR(ec, "", "open [%s] failed", filePath.c_str());
+    vector<char> buffer(CHECKSUM_BLOCK_SIZE);
+    vector<uint64_t> blockHashes;
+    uint32_t crc = 0;
+    int64_t length = 0;
+    while (true) {
+        size_t readLen = 0;
+        ec = file->Read(buffer.data(), buffer.size(), readLen).Code();
+        if (ec != FSEC_OK) {
+            [[maybe_unused]] auto closeEc = file->Close().Code();
+            AUTIL_LOG(ERROR, "read [%s] failed, ec[%d]", filePath.c_str(), ec);
+            return {ec, ""};
+        }
+        if (readLen == 0) {
+            break;
+        }
+        crc = autil::CRC32C::Extend(crc, buffer.data(), readLen);
+        blockHashes.push_back(autil::MurmurHash::MurmurHash64A(buffer.data(), readLen, /*seed=*/0));
+        length += readLen;
+    }
+    ec = file->Close().Code();
+    RETURN2_IF_FS_ERROR(ec, "", "close [%s] failed", filePath.c_str());
+    uint64_t hash = autil::MurmurHash::MurmurHash64A(blockHashes.data(), blockHashes.size() * sizeof(uint64_t),
+                                                     /*seed=*/0);
+    char checksum[64];
+    snprintf(checksum, sizeof(checksum), "%ld-%08x-%016lx", length, crc, hash);
+    return {FSEC_OK, string(checksum)};
+}
+
+FSResult<versionid_t> FileChecksumTable::GetLastTableVersion(const string& physicalRoot,
+                                                             versionid_t maxVersionId) noexcept
+{
+    fslib::FileList fileList;
+    auto ec = FslibWrapper::ListDir(physicalRoot, fileList).Code();
+    RETURN2_IF_FS_ERROR(ec, INVALID_VERSIONID, "list dir [%s] failed", physicalRoot.c_str());
+    versionid_t lastVersionId = INVALID_VERSIONID;
+    const string prefix = FILE_CHECKSUM_FILE_NAME_DOT_PREFIX;
+    for (const auto& fileName : fileList) {
+        if (!autil::StringUtil::startsWith(fileName, prefix)) {
+            continue;
+        }
+        versionid_t versionId =
+            autil::StringUtil::strToInt32WithDefault(fileName.substr(prefix.size()).c_str(), INVALID_VERSIONID);
+        if (versionId < maxVersionId) {
+            lastVersionId = std::max(lastVersionId, versionId);
+        }
+    }
+    return {FSEC_OK, lastVersionId};
+}
+
+ErrorCode FileChecksumTable::Generate(const string& rawPhysicalRoot, versionid_t versionId,
+                                      const string& rawLastPhysicalRoot, versionid_t lastVersionId) noexcept
+{
+    string physicalRoot = util::PathUtil::NormalizePath(rawPhysicalRoot);
+    DeployIndexMetaVec localDeployIndexMetaVec;
+    DeployIndexMetaVec remoteDeployIndexMetaVec;
+    IndexFileDeployer indexFileDeployer(&localDeployIndexMetaVec, &remoteDeployIndexMetaVec);
+    auto ec = indexFileDeployer.FillDeployIndexMetaVec(versionId, physicalRoot, LoadConfigList(), nullptr);
+    RETURN_IF_FS_ERROR(ec, "get files of version [%d] in [%s] failed", versionId, physicalRoot.c_str());
+
+    // a path whose length and modify time are unchanged since an older table keeps its checksum
+    FileChecksumTable lastTable;
+    string lastPhysicalRoot;
+    if (!rawLastPhysicalRoot.empty() && lastVersionId != INVALID_VERSIONID) {
+        lastPhysicalRoot = util::PathUtil::NormalizePath(rawLastPhysicalRoot);
+        auto [loadEc, exist] = lastTable.Load(lastPhysicalRoot, lastVersionId);
+        if (loadEc != FSEC_OK || !exist) {
+            AUTIL_LOG(INFO, "file checksum table [%d] in [%s] not loaded, ec[%d], fall back to tables in [%s]",
+                      lastVersionId, lastPhysicalRoot.c_str(), loadEc, physicalRoot.c_str());
+            lastPhysicalRoot.clear();
+        }
+    }
+    if (lastPhysicalRoot.empty()) {
+        lastPhysicalRoot = physicalRoot;
+        auto [ec2, lastRootVersionId] = GetLastTableVersion(physicalRoot, versionId);
+        RETURN_IF_FS_ERROR(ec2, "get last file checksum table failed");
+        if (lastRootVersionId != INVALID_VERSIONID) {
+            auto ret = lastTable.Load(physicalRoot, lastRootVersionId);
+            if (!ret.OK()) {
+                AUTIL_LOG(WARN, "load file checksum table [%d] in [%s] failed, recompute all", lastRootVersionId,
+                          physicalRoot.c_str());
+            }
+        }
+    }
+
+    FileChecksumTable table;
+    size_t computedCount = 0;
+    auto generate = [&](const DeployIndexMetaVec& deployIndexMetaVec) -> ErrorCode {
+        for (const auto& deployIndexMeta : deployIndexMetaVec) {
+            for (const auto* fileInfos : {&deployIndexMeta->deployFileMetas, &deployIndexMeta->finalDeployFileMetas}) {
+                for (const auto& fileInfo : *fileInfos) {
+                    if (!fileInfo.isFile()) {
+                        continue;
+                    }
+                    string filePath = util::PathUtil::JoinPath(deployIndexMeta->sourceRootPath, fileInfo.filePath);
+                    if (table.Find(physicalRoot, filePath)) {
+                        continue;
+                    }
+                    // stat before reading, a file changed while being read gets a new modify time next time
+                    auto [metaEc, fileMeta] = FslibWrapper::GetFileMeta(filePath);
+                    RETURN_IF_FS_ERROR(metaEc, "get file meta of [%s] failed", filePath.c_str());
+                    uint64_t modifyTime = fileMeta.lastModifyTime;
+                    // keys of the last table are relative to its own root
+                    auto lastChecksum =
+                        lastTable.FindReusable(MakeKey(lastPhysicalRoot, filePath), fileMeta.fileLength, modifyTime);
+                    if (lastChecksum) {
+                        table.Set(physicalRoot, filePath, *lastChecksum, modifyTime);
+                        continue;
+                    }
+                    auto [ec, checksum] = ComputeChecksum(filePath);
+                    RETURN_IF_FS_ERROR(ec, "compute checksum for [%s] failed", filePath.c_str());
+                    table.Set(physicalRoot, filePath, checksum, modifyTime);
+                    ++computedCount;
+                }
+            }
+        }
+        return FSEC_OK;
+    };
+    RETURN_IF_FS_ERROR(generate(localDeployIndexMetaVec), "");
+    RETURN_IF_FS_ERROR(generate(remoteDeployIndexMetaVec), "");
+    RETURN_IF_FS_ERROR(table.Store(physicalRoot, versionId), "");
+    AUTIL_LOG(INFO, "generate file checksum table for version [%d] in [%s], files [%lu], computed [%lu]", versionId,
+              physicalRoot.c_str(), table.Size(), computedCount);
+    return FSEC_OK;
+}
+
+}} // namespace indexlib::file_system
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "autil/Log.h"
+#include "autil/legacy/jsonizable.h"
+#include "indexlib/file_system/DeployIndexMeta.h"
+#include "indexlib/file_system/ErrorCode.h"
+#include "indexlib/file_system/FSResult.h"
+#include "indexlib/file_system/FileSystemDefine.h"
+
+namespace indexlib { namespace file_system {
+
+// Content checksums of the files a version refers to, stored as file_checksum.${versionId} beside the entry table.
+// Deployers use them to reuse local files with identical content that were deployed under other paths.
+class FileChecksumTable : public autil::legacy::Jsonizable
+{
+public:
+    FileChecksumTable() = default;
+    ~FileChecksumTable() = default;
+
+public:
+    void Jsonize(autil::legacy::Jsonizable::JsonWrapper& json) override;
+
+    FSResult<bool> Load(const std::string& physicalRoot, versionid_t versionId) noexcept;
+    ErrorCode Store(const std::string& physicalRoot, versionid_t versionId) const noexcept;
+
+    // fill FileInfo::checksum of the files under physicalRoot
+    void Fill(const std::string& physicalRoot, DeployIndexMeta* deployIndexMeta) const noexcept;
+    const std::string* Find(const std::string& physicalRoot, const std::string& filePath) const noexcept;
+    void Set(const std::string& physicalRoot, const std::string& filePath, const std::string& checksum,
+             uint64_t modifyTime = INVALID_MODIFY_TIME) noexcept;
+    size_t Size() const noexcept { return _checksums.size(); }
+
+public:
+    // checksum all files of version, files with the same length and modify time in the last table are not read
+    // again. The last table is the one of lastVersionId in lastPhysicalRoot, e.g. the previously published version
+    // in an older fence, or else the latest older table of the same root.
+    static ErrorCode Generate(const std::string& physicalRoot, versionid_t versionId,
+                              const std::string& lastPhysicalRoot = "",
+                              versionid_t lastVersionId = INVALID_VERSIONID) noexcept;
+    // "${length}-${crc32c}-${murmur64 of block hashes}"
+    static FSResult<std::string> ComputeChecksum(const std::string& filePath) noexcept;
+    static std::string GetFileName(versionid_t versionId);
+
+private:
+    static std::string MakeKey(const std::string& physicalRoot, const std::string& filePath) noexcept;
+    static FSResult<versionid_t> GetLastTableVersion(const std::string& physicalRoot, versionid_t maxVersionId) noexcept;
+    const std::string* FindReusable(const std::string& key, int64_t length, uint64_t modifyTime) const noexcept;
+
+private:
+    // path relative to physical root, or absolute path for files out of it -> checksum
+    std::map<std::string, std::string> _checksums;
+    // same keys as _checksums, modify time of the file when its checksum was computed
+    std::map<std::string, uint64_t> _modifyTimes;
+
+private:
+    static constexpr size_t CHECKSUM_BLOCK_SIZE = 4 * 1024 * 1024;
+    static constexpr uint64_t INVALID_MODIFY_TIME = (uint64_t)-1;
+    AUTIL_LOG_DECLARE();
+};
+
+}} // namespace indexlib::file_system
@@ -41,6 +41,9 @@ public:
         json.Jsonize("path", filePath, filePath);
         json.Jsonize("file_length", fileLength, fileLength);
         json.Jsonize("modify_time", modifyTime, modifyTime);
+        if (json.GetMode() != TO_JSON || !checksum.empty()) {
+            json.Jsonize("checksum", checksum, checksum);
+        }
     }
 
 public:
@@ -64,5 +67,7 @@ public:
     std::string filePath;
     int64_t fileLength;
     uint64_t modifyTime;
+    // content checksum from FileChecksumTable, empty if unknown, not part of equality
+    std::string checksum;
 };
 }} // namespace indexlib::file_system
@@ -34,6 +34,8 @@ static constexpr const char* ENTRY_TABLE_FILE_NAME_PREFIX = "entry_table";
 static constexpr const char* ENTRY_TABLE_FILE_NAME_DOT_PREFIX = "entry_table.";
 static constexpr const char* ENTRY_TABLE_PRELOAD_FILE_NAME = "entry_table.preload";
 static constexpr const char* ENTRY_TABLE_PRELOAD_BACK_UP_FILE_NAME = "entry_table.preload.back";
+static constexpr const char* FILE_CHECKSUM_FILE_NAME_DOT_PREFIX = "file_checksum.";
+static constexpr const char* PAGE_HEAT_MAP_FILE_NAME = "page_heat_map";
 static constexpr const char* FILE_SYSTEM_PATCH_DOT_PREFIX = "patch.";
 static constexpr const char* FILE_SYSTEM_INNER_SUFFIX = ".__fs__";
 static constexpr const char* COMPRESS_HINT_SAMPLE_RATIO = "hint_sample_ratio";
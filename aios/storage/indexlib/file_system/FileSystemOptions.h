@@ -36,6 +36,8 @@ class MetricProvider;
 namespace file_system {
 class PackageFileTagConfigList;
 class FileBlockCacheContainer;
+class LazyLoadScheduler;
+class PageHeatRecorder;
 
 struct FlushRetryStrategy {
     int32_t retryTimes = 3;
@@ -49,6 +51,8 @@ struct FileSystemOptions {
     std::shared_ptr<indexlibv2::MemoryQuotaController> memoryQuotaControllerV2;
     std::shared_ptr<FileBlockCacheContainer> fileBlockCacheContainer;
     std::shared_ptr<PackageFileTagConfigList> packageFileTagConfigList;
+    std::shared_ptr<LazyLoadScheduler> lazyLoadScheduler; // loads files of lazy mmap load configs, null for eager
+    std::shared_ptr<PageHeatRecorder> pageHeatRecorder;   // hot ranges for recorded warmup, null if not used
     std::vector<std::string> memMetricGroupPaths;
     FSStorageType outputStorage = FSST_DISK;
     FlushRetryStrategy flushRetryStrategy;
@@ -28,6 +28,7 @@
 #include "indexlib/file_system/EntryMeta.h"
 #include "indexlib/file_system/EntryTable.h"
 #include "indexlib/file_system/EntryTableBuilder.h"
+#include "indexlib/file_system/FileChecksumTable.h"
 #include "indexlib/file_system/FileInfo.h"
 #include "indexlib/file_system/FileSystemOptions.h"
 #include "indexlib/file_system/LifecycleTable.h"
@@ -216,6 +217,21 @@ ErrorCode IndexFileDeployer::FillDeployIndexMetaVec(versionid_t versionId, const
     dedupDeployIndexMetaVec(_localDeployIndexMetaVec);
     dedupDeployIndexMetaVec(_remoteDeployIndexMetaVec);
 
+    // content checksums are optional, deployers use them to reuse identical files already on local disk
+    FileChecksumTable checksumTable;
+    auto [ec3, hasChecksum] = checksumTable.Load(physicalRoot, versionId);
+    if (ec3 != FSEC_OK) {
+        AUTIL_LOG(WARN, "load file checksum table of version[%d] failed, rootPath[%s], ignore it", versionId,
+                  physicalRoot.c_str());
+    } else if (hasChecksum) {
+        for (const auto& deployIndexMeta : *_localDeployIndexMetaVec) {
+            checksumTable.Fill(physicalRoot, deployIndexMeta.get());
+        }
+        for (const auto& deployIndexMeta : *_remoteDeployIndexMetaVec) {
+            checksumTable.Fill(physicalRoot, deployIndexMeta.get());
+        }
+    }
+
     return FSEC_OK;
 }
 }} // namespace indexlib::file_system
@@ -0,0 +1,221 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/file_system/file/LazyLoadScheduler.h"
+
+#include <chrono>
+#include <vector>
+
+#include "autil/StringUtil.h"
+#include "autil/TimeUtility.h"
+#include "indexlib/file_system/file/MmapFileNode.h"
+
+using namespace std;
+
+namespace indexlib { namespace file_system {
+AUTIL_LOG_SETUP(indexlib.file_system, LazyLoadScheduler);
+
+LazyLoadScheduler::LazyLoadScheduler() {}
+
+LazyLoadScheduler::~LazyLoadScheduler() { Stop(); }
+
+void LazyLoadScheduler::Stop() noexcept
+{
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        _stopped = true;
+    }
+    _cond.notify_all();
+    if (_thread) {
+        _thread->join();
+        _thread.reset();
+    }
+}
+
+string LazyLoadScheduler::ExtractIndexKey(const string& logicalPath) noexcept
+{
+    vector<string> parts = autil::StringUtil::split(logicalPath, "/");
+    if (parts.empty()) {
+        return logicalPath;
+    }
+    size_t begin = 0;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        if (autil::StringUtil::startsWith(parts[i], "segment_")) {
+            begin = i + 1;
+            break;
+        }
+    }
+    // index type dir and index name, the file name itself is never part of the key
+    size_t end = min(begin + 2, parts.size() - 1);
+    if (begin >= end) {
+        return logicalPath;
+    }
+    string key = parts[begin];
+    for (size_t i = begin + 1; i < end; ++i) {
+        key += "/" + parts[i];
+    }
+    return key;
+}
+
+void LazyLoadScheduler::Submit(const std::shared_ptr<MmapFileNode>& fileNode) noexcept
+{
+    string indexKey = ExtractIndexKey(fileNode->GetLogicalPath());
+    Task task;
+    task.fileNode = fileNode;
+    task.length = fileNode->GetLength();
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        if (_stopped) {
+            return;
+        }
+        auto& tasks = _pendingTasks[indexKey];
+        if (tasks.empty()) {
+            _firstSubmitSeq[indexKey] = _submitSeq;
+        }
+        ++_submitSeq;
+        tasks.push_back(task);
+        auto& readiness = _readiness[indexKey];
+        ++readiness.pendingFileCount;
+        readiness.pendingBytes += task.length;
+        if (!_thread) {
+            _thread = autil::Thread::createThread([this]() { WorkLoop(); }, "IdxLazyLoad");
+            if (!_thread) {
+                AUTIL_LOG(ERROR, "create lazy load thread failed, [%s] will be loaded on access only",
+                          fileNode->DebugString().c_str());
+            }
+        }
+    }
+    AUTIL_LOG(DEBUG, "file [%s] of [%s] loads lazily", fileNode->DebugString().c_str(), indexKey.c_str());
+    _cond.notify_all();
+}
+
+void LazyLoadScheduler::UpdateAccessHints(const std::map<std::string, int64_t>& accessHints) noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    _accessHints = accessHints;
+}
+
+std::map<std::string, LazyLoadScheduler::Readiness> LazyLoadScheduler::GetReadiness() const noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _readiness;
+}
+
+size_t LazyLoadScheduler::GetPendingBytes() const noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    size_t pendingBytes = 0;
+    for (const auto& [indexKey, readiness] : _readiness) {
+        pendingBytes += readiness.pendingBytes;
+    }
+    return pendingBytes;
+}
+
+size_t LazyLoadScheduler::GetPendingFileCount() const noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    size_t pendingFileCount = 0;
+    for (const auto& [indexKey, readiness] : _readiness) {
+        pendingFileCount += readiness.pendingFileCount;
+    }
+    return pendingFileCount;
+}
+
+bool LazyLoadScheduler::WaitIdle(int64_t timeoutInMs) noexcept
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _cond.wait_for(lock, std::chrono::milliseconds(timeoutInMs),
+                          [this]() { return _stopped || (_pendingTasks.empty() && _runningCount == 0); });
+}
+
+bool LazyLoadScheduler::PopTask(string* indexKey, Task* task)
+{
+    auto selected = _pendingTasks.end();
+    int64_t selectedHint = 0;
+    uint64_t selectedSeq = 0;
+    for (auto it = _pendingTasks.begin(); it != _pendingTasks.end(); ++it) {
+        auto hintIt = _accessHints.find(it->first);
+        int64_t hint = hintIt == _accessHints.end() ? 0 : hintIt->second;
+        uint64_t seq = _firstSubmitSeq[it->first];
+        if (selected == _pendingTasks.end() || hint > selectedHint || (hint == selectedHint && seq < selectedSeq)) {
+            selected = it;
+            selectedHint = hint;
+            selectedSeq = seq;
+        }
+    }
+    if (selected == _pendingTasks.end()) {
+        return false;
+    }
+    *indexKey = selected->first;
+    *task = selected->second.front();
+    selected->second.pop_front();
+    if (selected->second.empty()) {
+        _firstSubmitSeq.erase(selected->first);
+        _pendingTasks.erase(selected);
+    }
+    return true;
+}
+
+void LazyLoadScheduler::WorkLoop() noexcept
+{
+    while (true) {
+        string indexKey;
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cond.wait(lock, [this]() { return _stopped || !_pendingTasks.empty(); });
+            if (_stopped) {
+                return;
+            }
+            PopTask(&indexKey, &task);
+            ++_runningCount;
+        }
+        bool loaded = false;
+        auto fileNode = task.fileNode.lock();
+        if (fileNode) {
+            int64_t beginTs = autil::TimeUtility::currentTimeInMicroSeconds();
+            auto ec = fileNode->LazyPopulate().Code();
+            if (ec == FSEC_OK) {
+                loaded = true;
+                AUTIL_LOG(DEBUG, "lazy load file [%s] done, length [%lu], used [%ld]us",
+                          fileNode->DebugString().c_str(), task.length,
+                          autil::TimeUtility::currentTimeInMicroSeconds() - beginTs);
+            } else {
+                AUTIL_LOG(WARN, "lazy load file [%s] failed, ec [%d], it stays loaded on access",
+                          fileNode->DebugString().c_str(), ec);
+            }
+            // release the file out of lock, closing it may be expensive
+            fileNode.reset();
+        }
+        {
+            std::lock_guard<std::mutex> guard(_mutex);
+            auto& readiness = _readiness[indexKey];
+            --readiness.pendingFileCount;
+            readiness.pendingBytes -= task.length;
+            if (loaded) {
+                ++readiness.loadedFileCount;
+                readiness.loadedBytes += task.length;
+            }
+            if (readiness.IsReady()) {
+                AUTIL_LOG(INFO, "[%s] is fully loaded, [%lu] files, [%lu] bytes", indexKey.c_str(),
+                          readiness.loadedFileCount, readiness.loadedBytes);
+            }
+            --_runningCount;
+        }
+        _cond.notify_all();
+    }
+}
+
+}} // namespace indexlib::file_system
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#include "autil/Log.h"
+#include "autil/Thread.h"
+
+namespace indexlib { namespace file_system {
+
+class MmapFileNode;
+
+// Background loader for mmap files opened with a lazy load strategy. Such files serve page faults on demand right
+// after open, and are warmed up (and locked) here one by one, indexes with more recorded accesses first.
+class LazyLoadScheduler
+{
+public:
+    struct Readiness {
+        size_t pendingFileCount = 0;
+        size_t pendingBytes = 0;
+        size_t loadedFileCount = 0;
+        size_t loadedBytes = 0;
+        bool IsReady() const { return pendingFileCount == 0; }
+    };
+
+public:
+    LazyLoadScheduler();
+    ~LazyLoadScheduler();
+
+    LazyLoadScheduler(const LazyLoadScheduler&) = delete;
+    LazyLoadScheduler& operator=(const LazyLoadScheduler&) = delete;
+
+public:
+    void Submit(const std::shared_ptr<MmapFileNode>& fileNode) noexcept;
+    // access counts keyed by index key, e.g. {"attribute/price": 1024, "index/title": 512}
+    void UpdateAccessHints(const std::map<std::string, int64_t>& accessHints) noexcept;
+    // index key -> readiness, for indexes with lazily loaded files
+    std::map<std::string, Readiness> GetReadiness() const noexcept;
+    size_t GetPendingBytes() const noexcept;
+    size_t GetPendingFileCount() const noexcept;
+    bool WaitIdle(int64_t timeoutInMs) noexcept;
+    void Stop() noexcept;
+
+public:
+    // "segment_1_level_0/attribute/price/data" -> "attribute/price"
+    static std::string ExtractIndexKey(const std::string& logicalPath) noexcept;
+
+private:
+    struct Task {
+        std::weak_ptr<MmapFileNode> fileNode;
+        size_t length = 0;
+    };
+
+    void WorkLoop() noexcept;
+    // pick the index with the most accesses, ties go to the earliest submitted one
+    bool PopTask(std::string* indexKey, Task* task);
+
+private:
+    mutable std::mutex _mutex;
+    std::condition_variable _cond;
+    std::map<std::string, std::deque<Task>> _pendingTasks;
+    std::map<std::string, uint64_t> _firstSubmitSeq;
+    std::map<std::string, int64_t> _accessHints;
+    std::map<std::string, Readiness> _readiness;
+    uint64_t _submitSeq = 0;
+    size_t _runningCount = 0;
+    bool _stopped = false;
+    autil::ThreadPtr _thread;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+
+}} // namespace indexlib::file_system
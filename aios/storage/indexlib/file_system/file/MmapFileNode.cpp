@@ -40,6 +40,8 @@
 #include "indexlib/file_system/FileSystemDefine.h"
 #include "indexlib/file_system/file/FileCarrier.h"
 #include "indexlib/file_system/file/FileNode.h"
+#include "indexlib/file_system/file/LazyLoadScheduler.h"
+#include "indexlib/file_system/file/PageHeatRecorder.h"
 #include "indexlib/file_system/file/ReadOption.h"
 #include "indexlib/file_system/fslib/FslibWrapper.h"
 #include "indexlib/file_system/load_config/LoadConfig.h"
@@ -64,8 +66,10 @@ MmapFileNode::MmapFileNode(const LoadConfig& loadConfig, const util::BlockMemory
     , _data(NULL)
     , _length(0)
     , _type(FSFT_UNKNOWN)
-    , _warmup(loadConfig.GetWarmupStrategy().GetWarmupType() != WarmupStrategy::WARMUP_NONE)
+    , _warmup(loadConfig.GetWarmupStrategy().GetWarmupType() == WarmupStrategy::WARMUP_SEQUENTIAL)
+    , _recordedWarmup(loadConfig.GetWarmupStrategy().GetWarmupType() == WarmupStrategy::WARMUP_RECORDED)
     , _populated(false)
+    , _lazyPending(false)
     , _readOnly(readOnly)
 {
     assert(_loadStrategy);
@@ -73,6 +77,15 @@ MmapFileNode::MmapFileNode(const LoadConfig& loadConfig, const util::BlockMemory
     _memController.reset(new util::SimpleMemoryQuotaController(memController));
 }
 
+MmapFileNode::MmapFileNode(const LoadConfig& loadConfig, const util::BlockMemoryQuotaControllerPtr& memController,
+                           bool readOnly, const std::shared_ptr<LazyLoadScheduler>& lazyLoadScheduler,
+                           const std::shared_ptr<PageHeatRecorder>& pageHeatRecorder) noexcept
+    : MmapFileNode(loadConfig, memController, readOnly)
+{
+    _lazyLoadScheduler = lazyLoadScheduler;
+    _pageHeatRecorder = pageHeatRecorder;
+}
+
 MmapFileNode::~MmapFileNode() noexcept { [[maybe_unused]] auto ret = Close(); }
 
 ErrorCode MmapFileNode::DoOpen(const PackageOpenMeta& packageOpenMeta, FSOpenType openType) noexcept
@@ -189,11 +202,53 @@ FSResult<void> MmapFileNode::Populate() noexcept
         _populated = true;
         return FSEC_OK;
     }
+    if (NeedLazyPopulate()) {
+        auto scheduler = _lazyLoadScheduler.lock();
+        auto self = weak_from_this().lock();
+        if (scheduler && self) {
+            if (_data && _loadStrategy->IsAdviseRandom() && madvise(_data, _length, MADV_RANDOM) < 0) {
+                AUTIL_LOG(WARN, "madvice failed! errno:%d", errno);
+            }
+            // pages are faulted in on access until the scheduler loads the whole file
+            _lazyPending = true;
+            _populated = true;
+            scheduler->Submit(self);
+            return FSEC_OK;
+        }
+    }
+    RETURN_IF_FS_ERROR(DoPopulate(), "");
+    _populated = true;
+    return FSEC_OK;
+}
+
+FSResult<void> MmapFileNode::LazyPopulate() noexcept
+{
+    ScopedLock lock(_lock);
+    if (!_lazyPending || !_file) {
+        return FSEC_OK;
+    }
+    RETURN_IF_FS_ERROR(DoPopulate(), "");
+    _lazyPending = false;
+    return FSEC_OK;
+}
+
+bool MmapFileNode::NeedLazyPopulate() const noexcept
+{
+    if (!_loadStrategy->IsLazy() || _lazyLoadScheduler.expired()) {
+        return false;
+    }
+    // anonymous mmap (dcache) is in memory already
+    if (!_file || -1 == _file->getFd()) {
+        return false;
+    }
+    return (_loadStrategy->IsLock() || _warmup) && _length >= _loadStrategy->GetLazyMinLength() && _length > 0;
+}
 
+FSResult<void> MmapFileNode::DoPopulate() noexcept
+{
     fslib::ErrorCode ec = _file->populate(_loadStrategy->IsLock(), (int64_t)_loadStrategy->GetSlice(),
                                           (int64_t)_loadStrategy->GetInterval());
     if (ec == fslib::EC_OK) {
-        _populated = true;
         return FSEC_OK;
     } else if (ec != fslib::EC_NOTSUP) {
         AUTIL_LOG(ERROR, "populate file [%s] failed, ec[%d], lock[%d], slice[%uB], interval[%ums]",
@@ -202,7 +257,6 @@ FSResult<void> MmapFileNode::Populate() noexcept
         return ParseFromFslibEC(ec);
     } else if (-1 == _file->getFd()) {
         // for old dcache version without populate
-        _populated = true;
         return FSEC_OK;
     }
 
@@ -215,8 +269,70 @@ FSResult<void> MmapFileNode::Populate() noexcept
 
     if (_warmup) {
         RETURN_IF_FS_ERROR(LoadData(), "load data for file[%s] failed", DebugString().c_str());
+    } else if (_recordedWarmup) {
+        WarmUpRecordedRanges();
+    }
+    return FSEC_OK;
+}
+
+void MmapFileNode::WarmUpRecordedRanges() noexcept
+{
+    auto recorder = _pageHeatRecorder.lock();
+    if (!recorder || !_data || _length == 0) {
+        return;
+    }
+    if (auto self = weak_from_this().lock()) {
+        recorder->Register(self);
+    }
+    static const uintptr_t PAGE_SIZE = getpagesize();
+    size_t prefetchBytes = 0;
+    auto ranges = recorder->GetHotRanges(GetLogicalPath(), _length);
+    for (const auto& [offset, length] : ranges) {
+        uintptr_t addr = (uintptr_t)_data + offset;
+        uintptr_t alignedAddr = addr & ~(PAGE_SIZE - 1);
+        // async readahead, hottest ranges are queued first
+        if (madvise((void*)alignedAddr, length + (addr - alignedAddr), MADV_WILLNEED) < 0) {
+            AUTIL_LOG(WARN, "madvise willneed for file [%s] failed, errno:%d", DebugString().c_str(), errno);
+            return;
+        }
+        prefetchBytes += length;
+    }
+    AUTIL_LOG(DEBUG, "prefetch [%lu] hot ranges of [%luB] for file [%s]", ranges.size(), prefetchBytes,
+              DebugString().c_str());
+}
+
+ErrorCode MmapFileNode::GetResidentBlocks(size_t blockSize, std::vector<double>* residentRatios) const noexcept
+{
+    ScopedLock lock(_lock);
+    residentRatios->clear();
+    if (!_file || -1 == _file->getFd() || !_data || _length == 0 || blockSize == 0) {
+        return FSEC_OK;
+    }
+    static const uintptr_t PAGE_SIZE = getpagesize();
+    uintptr_t begin = (uintptr_t)_data & ~(PAGE_SIZE - 1);
+    uintptr_t end = (uintptr_t)_data + _length;
+    size_t pageCount = (end - begin + PAGE_SIZE - 1) / PAGE_SIZE;
+    std::vector<unsigned char> residentPages(pageCount);
+    if (mincore((void*)begin, end - begin, residentPages.data()) < 0) {
+        AUTIL_LOG(WARN, "mincore for file [%s] failed, errno:%d", DebugString().c_str(), errno);
+        return FSEC_ERROR;
+    }
+    size_t blockCount = (_length + blockSize - 1) / blockSize;
+    std::vector<uint32_t> residentCount(blockCount, 0);
+    std::vector<uint32_t> totalCount(blockCount, 0);
+    for (size_t i = 0; i < pageCount; ++i) {
+        uintptr_t pageAddr = begin + i * PAGE_SIZE;
+        size_t offset = pageAddr > (uintptr_t)_data ? pageAddr - (uintptr_t)_data : 0;
+        size_t block = offset / blockSize;
+        ++totalCount[block];
+        residentCount[block] += (residentPages[i] & 1);
+    }
+    residentRatios->resize(blockCount, 0);
+    for (size_t block = 0; block < blockCount; ++block) {
+        if (totalCount[block] > 0) {
+            (*residentRatios)[block] = (double)residentCount[block] / totalCount[block];
+        }
     }
-    _populated = true;
     return FSEC_OK;
 }
 
@@ -280,7 +396,9 @@ FSResult<void> MmapFileNode::Close() noexcept
         AUTIL_LOG(DEBUG, "close file[%s] in package[%s] shared, useCount[%ld]", DebugString().c_str(),
                   _dependFileNode->DebugString().c_str(), _dependFileNode.use_count());
     }
+    ScopedLock lock(_lock);
     _populated = false;
+    _lazyPending = false;
     _file.reset();
     _dependFileNode.reset();
     return FSEC_OK;
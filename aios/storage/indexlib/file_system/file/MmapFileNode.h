@@ -21,6 +21,7 @@
 #include <stdint.h>
 #include <string>
 #include <sys/types.h>
+#include <vector>
 
 #include "autil/CommonMacros.h"
 #include "autil/Lock.h"
@@ -34,8 +35,10 @@ class MMapFile;
 }} // namespace fslib::fs
 namespace indexlib {
 namespace file_system {
+class LazyLoadScheduler;
 class LoadConfig;
 class PackageOpenMeta;
+class PageHeatRecorder;
 struct ReadOption;
 } // namespace file_system
 namespace util {
@@ -51,15 +54,22 @@ AUTIL_DECLARE_CLASS_SHARED_PTR(indexlib::file_system, MmapLoadStrategy);
 
 namespace indexlib { namespace file_system {
 
-class MmapFileNode : public FileNode
+class MmapFileNode : public FileNode, public std::enable_shared_from_this<MmapFileNode>
 {
 public:
     MmapFileNode(const LoadConfig& loadConfig, const std::shared_ptr<util::BlockMemoryQuotaController>& memController,
                  bool readOnly) noexcept;
+    MmapFileNode(const LoadConfig& loadConfig, const std::shared_ptr<util::BlockMemoryQuotaController>& memController,
+                 bool readOnly, const std::shared_ptr<LazyLoadScheduler>& lazyLoadScheduler,
+                 const std::shared_ptr<PageHeatRecorder>& pageHeatRecorder) noexcept;
     ~MmapFileNode() noexcept;
 
 public:
     FSResult<void> Populate() noexcept override;
+    // load data deferred by a lazy Populate, called by LazyLoadScheduler
+    FSResult<void> LazyPopulate() noexcept;
+    // resident page ratio of each block, sampled by PageHeatRecorder
+    ErrorCode GetResidentBlocks(size_t blockSize, std::vector<double>* residentRatios) const noexcept;
     FSFileType GetType() const noexcept override;
     size_t GetLength() const noexcept override;
     void* GetBaseAddress() const noexcept override;
@@ -85,6 +95,9 @@ private:
     ErrorCode DoOpenInSharedFile(const std::string& path, size_t offset, size_t length,
                                  const std::shared_ptr<fslib::fs::MMapFile>& sharedFile, FSOpenType openType) noexcept;
     uint8_t WarmUp(const char* addr, int64_t len) noexcept;
+    bool NeedLazyPopulate() const noexcept;
+    FSResult<void> DoPopulate() noexcept;
+    void WarmUpRecordedRanges() noexcept;
 
 protected:
     mutable autil::ThreadMutex _lock;
@@ -92,11 +105,15 @@ protected:
     std::shared_ptr<util::SimpleMemoryQuotaController> _memController;
     std::shared_ptr<MmapLoadStrategy> _loadStrategy;
     std::shared_ptr<FileNode> _dependFileNode; // dcache, for hold shared package file
+    std::weak_ptr<LazyLoadScheduler> _lazyLoadScheduler;
+    std::weak_ptr<PageHeatRecorder> _pageHeatRecorder;
     void* _data;
     size_t _length;
     FSFileType _type;
     bool _warmup;
+    bool _recordedWarmup;
     bool _populated;
+    bool _lazyPending;
     bool _readOnly;
 
 private:
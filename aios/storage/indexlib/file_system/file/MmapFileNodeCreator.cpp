@@ -29,7 +29,16 @@ using namespace std;
 namespace indexlib { namespace file_system {
 AUTIL_LOG_SETUP(indexlib.file_system, MmapFileNodeCreator);
 
-MmapFileNodeCreator::MmapFileNodeCreator() : _fullMemory(false) {}
+MmapFileNodeCreator::MmapFileNodeCreator() : _lock(false), _fullMemory(false) {}
+
+MmapFileNodeCreator::MmapFileNodeCreator(const std::shared_ptr<LazyLoadScheduler>& lazyLoadScheduler,
+                                         const std::shared_ptr<PageHeatRecorder>& pageHeatRecorder)
+    : _lazyLoadScheduler(lazyLoadScheduler)
+    , _pageHeatRecorder(pageHeatRecorder)
+    , _lock(false)
+    , _fullMemory(false)
+{
+}
 
 MmapFileNodeCreator::~MmapFileNodeCreator() {}
 
@@ -51,7 +60,8 @@ std::shared_ptr<FileNode> MmapFileNodeCreator::CreateFileNode(FSOpenType type, b
                                                               const std::string& linkRoot)
 {
     assert(type == FSOT_MMAP || type == FSOT_LOAD_CONFIG);
-    std::shared_ptr<MmapFileNode> mmapFileNode(new MmapFileNode(_loadConfig, _memController, readOnly));
+    std::shared_ptr<MmapFileNode> mmapFileNode(
+        new MmapFileNode(_loadConfig, _memController, readOnly, _lazyLoadScheduler, _pageHeatRecorder));
     return mmapFileNode;
 }
 
@@ -26,11 +26,15 @@
 #include "indexlib/util/memory_control/BlockMemoryQuotaController.h"
 
 namespace indexlib { namespace file_system {
+class LazyLoadScheduler;
+class PageHeatRecorder;
 
 class MmapFileNodeCreator : public FileNodeCreator
 {
 public:
     MmapFileNodeCreator();
+    MmapFileNodeCreator(const std::shared_ptr<LazyLoadScheduler>& lazyLoadScheduler,
+                        const std::shared_ptr<PageHeatRecorder>& pageHeatRecorder);
     ~MmapFileNodeCreator();
 
 public:
@@ -47,6 +51,8 @@ public:
 
 private:
     LoadConfig _loadConfig;
+    std::shared_ptr<LazyLoadScheduler> _lazyLoadScheduler;
+    std::shared_ptr<PageHeatRecorder> _pageHeatRecorder;
     bool _lock;
     bool _fullMemory;
 
@@ -0,0 +1,187 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/file_system/file/PageHeatRecorder.h"
+
+#include <algorithm>
+
+#include "autil/legacy/jsonizable.h"
+#include "indexlib/file_system/FileSystemDefine.h"
+#include "indexlib/file_system/JsonUtil.h"
+#include "indexlib/file_system/file/MmapFileNode.h"
+#include "indexlib/file_system/fslib/FslibWrapper.h"
+#include "indexlib/util/PathUtil.h"
+
+using namespace std;
+
+namespace indexlib { namespace file_system {
+AUTIL_LOG_SETUP(indexlib.file_system, PageHeatRecorder);
+
+namespace {
+// persisted form, heats of a file are flattened as [block, heat, block, heat, ...] in heat order
+struct PageHeatMap : public autil::legacy::Jsonizable {
+    int64_t blockSize = 0;
+    std::map<std::string, std::vector<int64_t>> heats;
+
+    void Jsonize(autil::legacy::Jsonizable::JsonWrapper& json) override
+    {
+        json.Jsonize("block_size", blockSize, blockSize);
+        json.Jsonize("heats", heats, heats);
+    }
+};
+
+std::vector<std::pair<uint32_t, double>> SortByHeat(const std::map<uint32_t, double>& blockHeats)
+{
+    std::vector<std::pair<uint32_t, double>> sorted(blockHeats.begin(), blockHeats.end());
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+    return sorted;
+}
+} // namespace
+
+PageHeatRecorder::PageHeatRecorder(size_t blockSize) : _blockSize(blockSize == 0 ? DEFAULT_BLOCK_SIZE : blockSize) {}
+
+PageHeatRecorder::~PageHeatRecorder() {}
+
+void PageHeatRecorder::Register(const std::shared_ptr<MmapFileNode>& fileNode) noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    _fileNodes[fileNode->GetLogicalPath()] = fileNode;
+}
+
+size_t PageHeatRecorder::GetFileCount() const noexcept
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _heats.size();
+}
+
+void PageHeatRecorder::Sample() noexcept
+{
+    std::vector<std::pair<std::string, std::shared_ptr<MmapFileNode>>> fileNodes;
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        for (auto it = _fileNodes.begin(); it != _fileNodes.end();) {
+            auto fileNode = it->second.lock();
+            if (!fileNode) {
+                it = _fileNodes.erase(it);
+                continue;
+            }
+            fileNodes.emplace_back(it->first, std::move(fileNode));
+            ++it;
+        }
+    }
+
+    // mincore out of lock, files may be large
+    std::map<std::string, std::vector<double>> samples;
+    for (const auto& [logicalPath, fileNode] : fileNodes) {
+        std::vector<double> residentRatios;
+        if (fileNode->GetResidentBlocks(_blockSize, &residentRatios) != FSEC_OK) {
+            continue;
+        }
+        samples[logicalPath] = std::move(residentRatios);
+    }
+
+    std::lock_guard<std::mutex> guard(_mutex);
+    // files no longer open cool down and are dropped eventually, e.g. segments merged away
+    for (auto fileIt = _heats.begin(); fileIt != _heats.end();) {
+        auto& blockHeats = fileIt->second;
+        for (auto it = blockHeats.begin(); it != blockHeats.end();) {
+            it->second *= HEAT_DECAY;
+            it = it->second < MIN_HEAT ? blockHeats.erase(it) : std::next(it);
+        }
+        fileIt = blockHeats.empty() ? _heats.erase(fileIt) : std::next(fileIt);
+    }
+    for (const auto& [logicalPath, residentRatios] : samples) {
+        for (size_t block = 0; block < residentRatios.size(); ++block) {
+            double heat = residentRatios[block] * MAX_SAMPLE_HEAT;
+            if (heat > 0) {
+                _heats[logicalPath][block] += heat;
+            }
+        }
+    }
+    AUTIL_LOG(DEBUG, "sampled [%lu] files, [%lu] files in heat map", samples.size(), _heats.size());
+}
+
+std::vector<std::pair<size_t, size_t>> PageHeatRecorder::GetHotRanges(const std::string& logicalPath,
+                                                                      size_t fileLength) const noexcept
+{
+    std::vector<std::pair<size_t, size_t>> ranges;
+    std::lock_guard<std::mutex> guard(_mutex);
+    auto it = _heats.find(logicalPath);
+    if (it == _heats.end()) {
+        return ranges;
+    }
+    for (const auto& [block, heat] : SortByHeat(it->second)) {
+        size_t offset = (size_t)block * _blockSize;
+        if (offset >= fileLength) {
+            // file of the same path rewritten shorter, e.g. realtime segment
+            continue;
+        }
+        ranges.emplace_back(offset, std::min(_blockSize, fileLength - offset));
+    }
+    return ranges;
+}
+
+FSResult<bool> PageHeatRecorder::Load(const std::string& dirPath) noexcept
+{
+    PageHeatMap heatMap;
+    string path = util::PathUtil::JoinPath(dirPath, PAGE_HEAT_MAP_FILE_NAME);
+    auto ec = JsonUtil::Load(path, &heatMap).Code();
+    if (ec == FSEC_NOENT) {
+        return {FSEC_OK, false};
+    }
+    RETURN2_IF_FS_ERROR(ec, false, "load page heat map [%s] failed", path.c_str());
+    if (heatMap.blockSize != (int64_t)_blockSize) {
+        AUTIL_LOG(WARN, "block size of page heat map [%s] is [%ld], expect [%lu], ignore it", path.c_str(),
+                  heatMap.blockSize, _blockSize);
+        return {FSEC_OK, false};
+    }
+
+    std::lock_guard<std::mutex> guard(_mutex);
+    _heats.clear();
+    for (const auto& [logicalPath, flatHeats] : heatMap.heats) {
+        auto& blockHeats = _heats[logicalPath];
+        for (size_t i = 0; i + 1 < flatHeats.size(); i += 2) {
+            blockHeats[(uint32_t)flatHeats[i]] = (double)flatHeats[i + 1];
+        }
+    }
+    AUTIL_LOG(INFO, "load page heat map [%s] of [%lu] files", path.c_str(), _heats.size());
+    return {FSEC_OK, true};
+}
+
+ErrorCode PageHeatRecorder::Store(const std::string& dirPath) const noexcept
+{
+    PageHeatMap heatMap;
+    heatMap.blockSize = _blockSize;
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        for (const auto& [logicalPath, blockHeats] : _heats) {
+            auto& flatHeats = heatMap.heats[logicalPath];
+            flatHeats.reserve(blockHeats.size() * 2);
+            for (const auto& [block, heat] : SortByHeat(blockHeats)) {
+                flatHeats.push_back(block);
+                flatHeats.push_back(std::max((int64_t)heat, (int64_t)MIN_HEAT));
+            }
+        }
+    }
+    auto [ec, content] = JsonUtil::ToString(heatMap, /*compact=*/true);
+    RETURN_IF_FS_ERROR(ec, "serialize page heat map failed");
+    string path = util::PathUtil::JoinPath(dirPath, PAGE_HEAT_MAP_FILE_NAME);
+    ec = FslibWrapper::AtomicStore(path, content, /*removeIfExist=*/true).Code();
+    RETURN_IF_FS_ERROR(ec, "store page heat map [%s] failed", path.c_str());
+    return FSEC_OK;
+}
+
+}} // namespace indexlib::file_system
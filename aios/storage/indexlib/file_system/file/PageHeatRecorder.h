@@ -0,0 +1,79 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "autil/Log.h"
+#include "indexlib/file_system/ErrorCode.h"
+#include "indexlib/file_system/FSResult.h"
+
+namespace indexlib { namespace file_system {
+
+class MmapFileNode;
+
+// Heat map of the blocks of mmap files opened with recorded warmup. Resident pages are sampled periodically with
+// mincore, and the heat map is persisted beside the local index so that the next open prefetches exactly the hot
+// ranges, hottest first, instead of touching whole files.
+class PageHeatRecorder
+{
+public:
+    explicit PageHeatRecorder(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~PageHeatRecorder();
+
+    PageHeatRecorder(const PageHeatRecorder&) = delete;
+    PageHeatRecorder& operator=(const PageHeatRecorder&) = delete;
+
+public:
+    void Register(const std::shared_ptr<MmapFileNode>& fileNode) noexcept;
+    // decay all heats and add resident ratio of each block of the registered files
+    void Sample() noexcept;
+    // [offset, length) of hot blocks of the file in heat order, clipped to fileLength
+    std::vector<std::pair<size_t, size_t>> GetHotRanges(const std::string& logicalPath,
+                                                        size_t fileLength) const noexcept;
+
+    FSResult<bool> Load(const std::string& dirPath) noexcept;
+    ErrorCode Store(const std::string& dirPath) const noexcept;
+
+    size_t GetBlockSize() const noexcept { return _blockSize; }
+    size_t GetFileCount() const noexcept;
+
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 1024 * 1024;
+    static constexpr double HEAT_DECAY = 0.8;
+    // blocks cooler than this are forgotten
+    static constexpr double MIN_HEAT = 1.0;
+    static constexpr double MAX_SAMPLE_HEAT = 100.0;
+
+private:
+    size_t _blockSize;
+    mutable std::mutex _mutex;
+    // logical path -> block index -> heat
+    std::map<std::string, std::map<uint32_t, double>> _heats;
+    std::map<std::string, std::weak_ptr<MmapFileNode>> _fileNodes;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+
+}} // namespace indexlib::file_system
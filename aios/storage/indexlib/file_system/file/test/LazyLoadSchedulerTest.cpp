@@ -0,0 +1,156 @@
+#include "indexlib/file_system/file/LazyLoadScheduler.h"
+
+#include "autil/legacy/jsonizable.h"
+#include "indexlib/file_system/file/MmapFileNode.h"
+#include "indexlib/file_system/file/ReadOption.h"
+#include "indexlib/file_system/load_config/LoadConfig.h"
+#include "indexlib/file_system/test/FileSystemTestUtil.h"
+#include "indexlib/util/PathUtil.h"
+#include "indexlib/util/memory_control/MemoryQuotaControllerCreator.h"
+#include "indexlib/util/testutil/unittest.h"
+
+using namespace std;
+using namespace indexlib::util;
+
+namespace indexlib { namespace file_system {
+
+class LazyLoadSchedulerTest : public INDEXLIB_TESTBASE
+{
+public:
+    LazyLoadSchedulerTest();
+    ~LazyLoadSchedulerTest();
+
+    DECLARE_CLASS_NAME(LazyLoadSchedulerTest);
+
+public:
+    void CaseSetUp() override;
+    void CaseTearDown() override;
+
+    void TestExtractIndexKey();
+    void TestLazyPopulate();
+    void TestSmallFileNotLazy();
+    void TestPopTaskByAccessHints();
+
+private:
+    LoadConfig MakeLazyLoadConfig(uint64_t lazyMinLength) const;
+
+private:
+    std::string _rootDir;
+    util::BlockMemoryQuotaControllerPtr _memoryController;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+AUTIL_LOG_SETUP(indexlib.file_system, LazyLoadSchedulerTest);
+
+INDEXLIB_UNIT_TEST_CASE(LazyLoadSchedulerTest, TestExtractIndexKey);
+INDEXLIB_UNIT_TEST_CASE(LazyLoadSchedulerTest, TestLazyPopulate);
+INDEXLIB_UNIT_TEST_CASE(LazyLoadSchedulerTest, TestSmallFileNotLazy);
+INDEXLIB_UNIT_TEST_CASE(LazyLoadSchedulerTest, TestPopTaskByAccessHints);
+//////////////////////////////////////////////////////////////////////
+
+LazyLoadSchedulerTest::LazyLoadSchedulerTest() {}
+
+LazyLoadSchedulerTest::~LazyLoadSchedulerTest() {}
+
+void LazyLoadSchedulerTest::CaseSetUp()
+{
+    _rootDir = util::PathUtil::NormalizePath(GET_TEMP_DATA_PATH()) + "/";
+    _memoryController = MemoryQuotaControllerCreator::CreateBlockMemoryController();
+}
+
+void LazyLoadSchedulerTest::CaseTearDown() {}
+
+LoadConfig LazyLoadSchedulerTest::MakeLazyLoadConfig(uint64_t lazyMinLength) const
+{
+    string jsonStr = R"({
+        "file_patterns": [".*"],
+        "load_strategy": "mmap",
+        "load_strategy_param": {"lock": true, "lazy": true, "lazy_min_length": )" +
+                     std::to_string(lazyMinLength) + "}}";
+    LoadConfig loadConfig;
+    autil::legacy::FromJsonString(loadConfig, jsonStr);
+    return loadConfig;
+}
+
+void LazyLoadSchedulerTest::TestExtractIndexKey()
+{
+    ASSERT_EQ("attribute/price", LazyLoadScheduler::ExtractIndexKey("segment_1_level_0/attribute/price/data"));
+    ASSERT_EQ("index/title", LazyLoadScheduler::ExtractIndexKey("segment_1_level_0/index/title/posting"));
+    ASSERT_EQ("summary", LazyLoadScheduler::ExtractIndexKey("segment_1_level_0/summary/data"));
+    ASSERT_EQ("attribute/price", LazyLoadScheduler::ExtractIndexKey("__FENCE__/segment_2/attribute/price/offset"));
+    ASSERT_EQ("index_format_version", LazyLoadScheduler::ExtractIndexKey("index_format_version"));
+}
+
+void LazyLoadSchedulerTest::TestLazyPopulate()
+{
+    string content(8192, 'a');
+    FileSystemTestUtil::CreateDiskFile(_rootDir + "data", content);
+    auto scheduler = std::make_shared<LazyLoadScheduler>();
+    auto fileNode = std::make_shared<MmapFileNode>(MakeLazyLoadConfig(0), _memoryController, true, scheduler,
+                                                   /*pageHeatRecorder=*/nullptr);
+    ASSERT_EQ(FSEC_OK, fileNode->Open("segment_0_level_0/attribute/price/data", _rootDir + "data", FSOT_MMAP, -1));
+    ASSERT_EQ(FSEC_OK, fileNode->Populate());
+    ASSERT_TRUE(fileNode->_populated);
+
+    // readable before the background load is done
+    string readContent(content.size(), '\0');
+    ASSERT_EQ(content.size(), fileNode->Read(readContent.data(), readContent.size(), 0, ReadOption()).GetOrThrow());
+    ASSERT_EQ(content, readContent);
+
+    ASSERT_TRUE(scheduler->WaitIdle(10000));
+    ASSERT_FALSE(fileNode->_lazyPending);
+    ASSERT_EQ(0, scheduler->GetPendingBytes());
+    auto readiness = scheduler->GetReadiness();
+    ASSERT_EQ(1, readiness.size());
+    const auto& priceReadiness = readiness["attribute/price"];
+    ASSERT_TRUE(priceReadiness.IsReady());
+    ASSERT_EQ(1, priceReadiness.loadedFileCount);
+    ASSERT_EQ(content.size(), priceReadiness.loadedBytes);
+}
+
+void LazyLoadSchedulerTest::TestSmallFileNotLazy()
+{
+    FileSystemTestUtil::CreateDiskFile(_rootDir + "small", "small file");
+    auto scheduler = std::make_shared<LazyLoadScheduler>();
+    auto fileNode = std::make_shared<MmapFileNode>(MakeLazyLoadConfig(1024), _memoryController, true, scheduler,
+                                                   /*pageHeatRecorder=*/nullptr);
+    ASSERT_EQ(FSEC_OK, fileNode->Open("segment_0_level_0/attribute/price/data", _rootDir + "small", FSOT_MMAP, -1));
+    ASSERT_EQ(FSEC_OK, fileNode->Populate());
+    ASSERT_FALSE(fileNode->_lazyPending);
+    ASSERT_TRUE(scheduler->GetReadiness().empty());
+
+    // without scheduler lazy load config loads eagerly
+    auto eagerFileNode = std::make_shared<MmapFileNode>(MakeLazyLoadConfig(0), _memoryController, true);
+    ASSERT_EQ(FSEC_OK,
+              eagerFileNode->Open("segment_0_level_0/attribute/price/data", _rootDir + "small", FSOT_MMAP, -1));
+    ASSERT_EQ(FSEC_OK, eagerFileNode->Populate());
+    ASSERT_FALSE(eagerFileNode->_lazyPending);
+}
+
+void LazyLoadSchedulerTest::TestPopTaskByAccessHints()
+{
+    LazyLoadScheduler scheduler;
+    auto addTask = [&](const string& indexKey) {
+        if (scheduler._pendingTasks[indexKey].empty()) {
+            scheduler._firstSubmitSeq[indexKey] = scheduler._submitSeq;
+        }
+        ++scheduler._submitSeq;
+        scheduler._pendingTasks[indexKey].push_back(LazyLoadScheduler::Task());
+    };
+    addTask("index/title");
+    addTask("attribute/price");
+    addTask("summary");
+    addTask("index/title");
+    scheduler.UpdateAccessHints({{"attribute/price", 100}, {"summary", 10}});
+
+    vector<string> order;
+    string indexKey;
+    LazyLoadScheduler::Task task;
+    while (scheduler.PopTask(&indexKey, &task)) {
+        order.push_back(indexKey);
+    }
+    ASSERT_EQ(vector<string>({"attribute/price", "summary", "index/title", "index/title"}), order);
+}
+
+}} // namespace indexlib::file_system
@@ -0,0 +1,139 @@
+#include "indexlib/file_system/file/PageHeatRecorder.h"
+
+#include "autil/legacy/jsonizable.h"
+#include "indexlib/file_system/file/MmapFileNode.h"
+#include "indexlib/file_system/file/ReadOption.h"
+#include "indexlib/file_system/load_config/LoadConfig.h"
+#include "indexlib/file_system/test/FileSystemTestUtil.h"
+#include "indexlib/util/PathUtil.h"
+#include "indexlib/util/memory_control/MemoryQuotaControllerCreator.h"
+#include "indexlib/util/testutil/unittest.h"
+
+using namespace std;
+using namespace indexlib::util;
+
+namespace indexlib { namespace file_system {
+
+class PageHeatRecorderTest : public INDEXLIB_TESTBASE
+{
+public:
+    PageHeatRecorderTest();
+    ~PageHeatRecorderTest();
+
+    DECLARE_CLASS_NAME(PageHeatRecorderTest);
+
+public:
+    void CaseSetUp() override;
+    void CaseTearDown() override;
+
+    void TestSampleAndGetHotRanges();
+    void TestStoreAndLoad();
+    void TestHeatDecay();
+
+private:
+    LoadConfig MakeRecordedLoadConfig() const;
+
+private:
+    std::string _rootDir;
+    util::BlockMemoryQuotaControllerPtr _memoryController;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+AUTIL_LOG_SETUP(indexlib.file_system, PageHeatRecorderTest);
+
+INDEXLIB_UNIT_TEST_CASE(PageHeatRecorderTest, TestSampleAndGetHotRanges);
+INDEXLIB_UNIT_TEST_CASE(PageHeatRecorderTest, TestStoreAndLoad);
+INDEXLIB_UNIT_TEST_CASE(PageHeatRecorderTest, TestHeatDecay);
+//////////////////////////////////////////////////////////////////////
+
+PageHeatRecorderTest::PageHeatRecorderTest() {}
+
+PageHeatRecorderTest::~PageHeatRecorderTest() {}
+
+void PageHeatRecorderTest::CaseSetUp()
+{
+    _rootDir = util::PathUtil::NormalizePath(GET_TEMP_DATA_PATH()) + "/";
+    _memoryController = MemoryQuotaControllerCreator::CreateBlockMemoryController();
+}
+
+void PageHeatRecorderTest::CaseTearDown() {}
+
+LoadConfig PageHeatRecorderTest::MakeRecordedLoadConfig() const
+{
+    string jsonStr = R"({
+        "file_patterns": [".*"],
+        "load_strategy": "mmap",
+        "warmup_strategy": "recorded"
+    })";
+    LoadConfig loadConfig;
+    autil::legacy::FromJsonString(loadConfig, jsonStr);
+    return loadConfig;
+}
+
+void PageHeatRecorderTest::TestSampleAndGetHotRanges()
+{
+    const size_t blockSize = 4096;
+    string content(blockSize * 4, 'a');
+    FileSystemTestUtil::CreateDiskFile(_rootDir + "data", content);
+    auto recorder = std::make_shared<PageHeatRecorder>(blockSize);
+    auto fileNode = std::make_shared<MmapFileNode>(MakeRecordedLoadConfig(), _memoryController, true,
+                                                   /*lazyLoadScheduler=*/nullptr, recorder);
+    ASSERT_EQ(FSEC_OK, fileNode->Open("segment_0_level_0/attribute/price/data", _rootDir + "data", FSOT_MMAP, -1));
+    ASSERT_EQ(FSEC_OK, fileNode->Populate());
+    ASSERT_FALSE(fileNode->_warmup);
+    ASSERT_TRUE(recorder->GetHotRanges("segment_0_level_0/attribute/price/data", content.size()).empty());
+
+    // the file was just written, its pages are in page cache
+    char buffer[16];
+    ASSERT_EQ(sizeof(buffer), fileNode->Read(buffer, sizeof(buffer), blockSize * 2, ReadOption()).GetOrThrow());
+    recorder->Sample();
+    ASSERT_EQ(1, recorder->GetFileCount());
+    auto ranges = recorder->GetHotRanges("segment_0_level_0/attribute/price/data", content.size());
+    ASSERT_FALSE(ranges.empty());
+    for (const auto& [offset, length] : ranges) {
+        ASSERT_EQ(0, offset % blockSize);
+        ASSERT_EQ(blockSize, length);
+    }
+    // clipped to file length
+    auto clipped = recorder->GetHotRanges("segment_0_level_0/attribute/price/data", blockSize + 1);
+    for (const auto& [offset, length] : clipped) {
+        ASSERT_LE(offset + length, blockSize + 1);
+    }
+    ASSERT_TRUE(recorder->GetHotRanges("segment_0_level_0/attribute/price/offset", content.size()).empty());
+}
+
+void PageHeatRecorderTest::TestStoreAndLoad()
+{
+    PageHeatRecorder recorder(4096);
+    recorder._heats["segment_0/index/title/posting"] = {{0, 10.0}, {3, 300.0}, {5, 50.0}};
+    ASSERT_EQ(FSEC_OK, recorder.Store(_rootDir));
+
+    PageHeatRecorder loaded(4096);
+    ASSERT_TRUE(loaded.Load(_rootDir).GetOrThrow());
+    auto ranges = loaded.GetHotRanges("segment_0/index/title/posting", 4096 * 10);
+    ASSERT_EQ(3, ranges.size());
+    ASSERT_EQ(4096 * 3, ranges[0].first);
+    ASSERT_EQ(4096 * 5, ranges[1].first);
+    ASSERT_EQ(0, ranges[2].first);
+
+    // block size changed, heat map is useless
+    PageHeatRecorder otherBlockSize(8192);
+    ASSERT_FALSE(otherBlockSize.Load(_rootDir).GetOrThrow());
+    ASSERT_EQ(0, otherBlockSize.GetFileCount());
+
+    PageHeatRecorder notExist(4096);
+    ASSERT_FALSE(notExist.Load(_rootDir + "not_exist").GetOrThrow());
+}
+
+void PageHeatRecorderTest::TestHeatDecay()
+{
+    PageHeatRecorder recorder(4096);
+    recorder._heats["segment_0/index/title/posting"] = {{0, 1.1}, {1, 100.0}};
+    recorder.Sample();
+    auto ranges = recorder.GetHotRanges("segment_0/index/title/posting", 4096 * 2);
+    ASSERT_EQ(1, ranges.size());
+    ASSERT_EQ(4096, ranges[0].first);
+}
+
+}} // namespace indexlib::file_system
@@ -34,6 +34,8 @@ MmapLoadStrategy::MmapLoadStrategy()
     , _adviseRandom(false)
     , _slice(4 * 1024 * 1024) // 4M
     , _interval(0)
+    , _isLazy(false)
+    , _lazyMinLength(DEFAULT_LAZY_MIN_LENGTH)
 {
 }
 
@@ -42,6 +44,8 @@ MmapLoadStrategy::MmapLoadStrategy(bool isLock, bool adviseRandom, uint32_t slic
     , _adviseRandom(adviseRandom)
     , _slice(slice)
     , _interval(interval)
+    , _isLazy(false)
+    , _lazyMinLength(DEFAULT_LAZY_MIN_LENGTH)
 {
 }
 
@@ -76,6 +80,10 @@ void MmapLoadStrategy::Jsonize(autil::legacy::Jsonizable::JsonWrapper& json)
     json.Jsonize("advise_random", _adviseRandom, false);
     json.Jsonize("slice", _slice, (uint32_t)(4 * 1024 * 1024));
     json.Jsonize("interval", _interval, (uint32_t)0);
+    if (json.GetMode() == FROM_JSON || _isLazy) {
+        json.Jsonize("lazy", _isLazy, false);
+        json.Jsonize("lazy_min_length", _lazyMinLength, DEFAULT_LAZY_MIN_LENGTH);
+    }
 }
 
 bool MmapLoadStrategy::EqualWith(const LoadStrategyPtr& loadStrategy) const
@@ -93,7 +101,8 @@ bool MmapLoadStrategy::EqualWith(const LoadStrategyPtr& loadStrategy) const
 bool MmapLoadStrategy::operator==(const MmapLoadStrategy& loadStrategy) const
 {
     return _isLock == loadStrategy._isLock && _adviseRandom == loadStrategy._adviseRandom &&
-           _slice == loadStrategy._slice && _interval == loadStrategy._interval;
+           _slice == loadStrategy._slice && _interval == loadStrategy._interval && _isLazy == loadStrategy._isLazy &&
+           _lazyMinLength == loadStrategy._lazyMinLength;
 }
 
 void MmapLoadStrategy::SetEnableLoadSpeedLimit(const std::shared_ptr<bool>& enableLoadSpeedLimit)
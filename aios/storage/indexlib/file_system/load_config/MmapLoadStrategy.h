@@ -49,13 +49,21 @@ public:
     bool IsAdviseRandom() const { return _adviseRandom; }
     uint32_t GetSlice() const { return _slice; }
     uint32_t GetInterval() const;
+    // lazy: open without loading, files not shorter than lazy min length are loaded by LazyLoadScheduler later
+    bool IsLazy() const { return _isLazy; }
+    uint64_t GetLazyMinLength() const { return _lazyMinLength; }
     MemLoadStrategy* CreateMemLoadStrategy() const noexcept;
 
+private:
+    static constexpr uint64_t DEFAULT_LAZY_MIN_LENGTH = 4 * 1024 * 1024;
+
 private:
     bool _isLock;
     bool _adviseRandom;
     uint32_t _slice;
     uint32_t _interval;
+    bool _isLazy;
+    uint64_t _lazyMinLength;
     std::shared_ptr<bool> _enableLoadSpeedLimit;
 
 private:
@@ -24,6 +24,7 @@ AUTIL_LOG_SETUP(indexlib.file_system, WarmupStrategy);
 
 static const string WARMUP_NONE_TYPE_STRING = string("none");
 static const string WARMUP_SEQUENTIAL_TYPE_STRING = string("sequential");
+static const string WARMUP_RECORDED_TYPE_STRING = string("recorded");
 
 WarmupStrategy::WarmupStrategy() : _warmupType(WARMUP_NONE) {}
 
@@ -37,6 +38,9 @@ WarmupStrategy::WarmupType WarmupStrategy::FromTypeString(const string& typeStr)
     if (typeStr == WARMUP_SEQUENTIAL_TYPE_STRING) {
         return WarmupStrategy::WARMUP_SEQUENTIAL;
     }
+    if (typeStr == WARMUP_RECORDED_TYPE_STRING) {
+        return WarmupStrategy::WARMUP_RECORDED;
+    }
     INDEXLIB_THROW(util::BadParameterException, "unsupported warmup strategy [ %s ]", typeStr.c_str());
     return WarmupStrategy::WARMUP_NONE;
 }
@@ -49,6 +53,9 @@ string WarmupStrategy::ToTypeString(const WarmupType& type)
     if (type == WARMUP_SEQUENTIAL) {
         return WARMUP_SEQUENTIAL_TYPE_STRING;
     }
+    if (type == WARMUP_RECORDED) {
+        return WARMUP_RECORDED_TYPE_STRING;
+    }
     INDEXLIB_THROW(util::BadParameterException, "unsupported enum warmup type [ %d ]", type);
     return WARMUP_NONE_TYPE_STRING;
 }
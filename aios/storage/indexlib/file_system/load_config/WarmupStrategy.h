@@ -24,7 +24,8 @@ namespace indexlib { namespace file_system {
 class WarmupStrategy
 {
 public:
-    enum WarmupType { WARMUP_NONE, WARMUP_SEQUENTIAL };
+    // WARMUP_RECORDED: prefetch the hot ranges recorded by PageHeatRecorder in heat order, nothing if none recorded
+    enum WarmupType { WARMUP_NONE, WARMUP_SEQUENTIAL, WARMUP_RECORDED };
 
 public:
     WarmupStrategy();
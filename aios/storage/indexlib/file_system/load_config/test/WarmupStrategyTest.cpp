@@ -16,11 +16,13 @@ TEST_F(WarmupStrategyTest, TestFromTypeString)
 {
     ASSERT_EQ(WarmupStrategy::WARMUP_NONE, WarmupStrategy::FromTypeString("none"));
     ASSERT_EQ(WarmupStrategy::WARMUP_SEQUENTIAL, WarmupStrategy::FromTypeString("sequential"));
+    ASSERT_EQ(WarmupStrategy::WARMUP_RECORDED, WarmupStrategy::FromTypeString("recorded"));
 }
 
 TEST_F(WarmupStrategyTest, TestToTypeString)
 {
     ASSERT_EQ("none", WarmupStrategy::ToTypeString(WarmupStrategy::WARMUP_NONE));
     ASSERT_EQ("sequential", WarmupStrategy::ToTypeString(WarmupStrategy::WARMUP_SEQUENTIAL));
+    ASSERT_EQ("recorded", WarmupStrategy::ToTypeString(WarmupStrategy::WARMUP_RECORDED));
 }
 }} // namespace indexlib::file_system
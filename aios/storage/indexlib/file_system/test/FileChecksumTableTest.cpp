@@ -0,0 +1,231 @@
+#include "indexlib/file_system/FileChecksumTable.h"
+
+#include <unistd.h>
+
+#include "indexlib/file_system/FileChecksumGenerator.h"
+#include "indexlib/file_system/fslib/FslibWrapper.h"
+#include "indexlib/util/PathUtil.h"
+#include "indexlib/util/testutil/unittest.h"
+
+using namespace std;
+
+namespace indexlib { namespace file_system {
+
+class FileChecksumTableTest : public INDEXLIB_TESTBASE
+{
+public:
+    FileChecksumTableTest();
+    ~FileChecksumTableTest();
+
+    DECLARE_CLASS_NAME(FileChecksumTableTest);
+
+public:
+    void CaseSetUp() override;
+    void CaseTearDown() override;
+
+    void TestComputeChecksum();
+    void TestStoreAndLoad();
+    void TestFill();
+    void TestReuseNeedSameModifyTime();
+    void TestGenerateReuseLastPublishedTable();
+    void TestGeneratorStartAndStop();
+
+private:
+    // version [versionId] in fence2 refers to segment_0 of fence1 and segment_1 of fence2
+    void PrepareTwoFences(versionid_t versionId);
+
+private:
+    string _rootDir;
+    string _fence1;
+    string _fence2;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+AUTIL_LOG_SETUP(indexlib.file_system, FileChecksumTableTest);
+
+INDEXLIB_UNIT_TEST_CASE(FileChecksumTableTest, TestComputeChecksum);
+INDEXLIB_UNIT_TEST_CASE(FileChecksumTableTest, TestStoreAndLoad);
+INDEXLIB_UNIT_TEST_CASE(FileChecksumTableTest, TestFill);
+INDEXLIB_UNIT_TEST_CASE(FileChecksumTableTest, TestReuseNeedSameModifyTime);
+INDEXLIB_UNIT_TEST_CASE(FileChecksumTableTest, TestGenerateReuseLastPublishedTable);
+INDEXLIB_UNIT_TEST_CASE(FileChecksumTableTest, TestGeneratorStartAndStop);
+
+//////////////////////////////////////////////////////////////////////
+
+FileChecksumTableTest::FileChecksumTableTest() {}
+
+FileChecksumTableTest::~FileChecksumTableTest() {}
+
+void FileChecksumTableTest::CaseSetUp()
+{
+    _rootDir = GET_TEMP_DATA_PATH();
+    _fence1 = util::PathUtil::JoinPath(_rootDir, "__FENCE__1");
+    _fence2 = util::PathUtil::JoinPath(_rootDir, "__FENCE__2");
+}
+
+void FileChecksumTableTest::CaseTearDown() {}
+
+void FileChecksumTableTest::TestComputeChecksum()
+{
+    string path1 = util::PathUtil::JoinPath(_rootDir, "file1");
+    string path2 = util::PathUtil::JoinPath(_rootDir, "file2");
+    string path3 = util::PathUtil::JoinPath(_rootDir, "file3");
+    ASSERT_EQ(FSEC_OK, FslibWrapper::AtomicStore(path1, "abcdef").Code());
+    ASSERT_EQ(FSEC_OK, FslibWrapper::AtomicStore(path2, "abcdef").Code());
+    ASSERT_EQ(FSEC_OK, FslibWrapper::AtomicStore(path3, "abcdeg").Code());
+
+    auto [ec1, checksum1] = FileChecksumTable::ComputeChecksum(path1);
+    ASSERT_EQ(FSEC_OK, ec1);
+    auto [ec2, checksum2] = FileChecksumTable::ComputeChecksum(path2);
+    ASSERT_EQ(FSEC_OK, ec2);
+    auto [ec3, checksum3] = FileChecksumTable::ComputeChecksum(path3);
+    ASSERT_EQ(FSEC_OK, ec3);
+    ASSERT_EQ(checksum1, checksum2);
+    ASSERT_NE(checksum1, checksum3);
+    ASSERT_EQ(0, checksum1.find("6-"));
+
+    ASSERT_EQ(FSEC_NOENT, FileChecksumTable::ComputeChecksum(util::PathUtil::JoinPath(_rootDir, "none")).Code());
+}
+
+void FileChecksumTableTest::TestStoreAndLoad()
+{
+    FileChecksumTable table;
+    auto [ec, exist] = table.Load(_rootDir, 1);
+    ASSERT_EQ(FSEC_OK, ec);
+    ASSERT_FALSE(exist);
+
+    table.Set(_rootDir, util::PathUtil::JoinPath(_rootDir, "segment_0/data"), "4-1-2");
+    table.Set(_rootDir, "/other/root/segment_1/data", "5-3-4");
+    ASSERT_EQ(FSEC_OK, table.Store(_rootDir, 1));
+    ASSERT_TRUE(FslibWrapper::IsExist(util::PathUtil::JoinPath(_rootDir, "file_checksum.1")).GetOrThrow());
+
+    FileChecksumTable loadedTable;
+    auto [loadEc, loaded] = loadedTable.Load(_rootDir, 1);
+    ASSERT_EQ(FSEC_OK, loadEc);
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(2, loadedTable.Size());
+    auto checksum = loadedTable.Find(_rootDir, util::PathUtil::JoinPath(_rootDir, "segment_0/data"));
+    ASSERT_TRUE(checksum);
+    ASSERT_EQ("4-1-2", *checksum);
+    checksum = loadedTable.Find(_rootDir, "/other/root/segment_1/data");
+    ASSERT_TRUE(checksum);
+    ASSERT_EQ("5-3-4", *checksum);
+    ASSERT_FALSE(loadedTable.Find(_rootDir, util::PathUtil::JoinPath(_rootDir, "segment_0/none")));
+}
+
+void FileChecksumTableTest::TestFill()
+{
+    string physicalRoot = util::PathUtil::JoinPath(_rootDir, "__FENCE__1");
+    FileChecksumTable table;
+    table.Set(physicalRoot, util::PathUtil::JoinPath(physicalRoot, "segment_0/data"), "4-1-2");
+
+    DeployIndexMeta deployIndexMeta;
+    deployIndexMeta.sourceRootPath = _rootDir;
+    deployIndexMeta.Append(FileInfo("__FENCE__1/segment_0/data", 4, 0));
+    deployIndexMeta.Append(FileInfo("__FENCE__1/segment_0/attribute", 8, 0));
+    deployIndexMeta.Append(FileInfo("__FENCE__1/segment_0/"));
+    table.Fill(physicalRoot, &deployIndexMeta);
+    ASSERT_EQ("4-1-2", deployIndexMeta.deployFileMetas[0].checksum);
+    ASSERT_TRUE(deployIndexMeta.deployFileMetas[1].checksum.empty());
+    ASSERT_TRUE(deployIndexMeta.deployFileMetas[2].checksum.empty());
+}
+
+void FileChecksumTableTest::TestReuseNeedSameModifyTime()
+{
+    FileChecksumTable table;
+    table.Set(_rootDir, util::PathUtil::JoinPath(_rootDir, "segment_0/data"), "4-1-2", 100);
+    table.Set(_rootDir, util::PathUtil::JoinPath(_rootDir, "segment_0/attribute"), "8-3-4");
+    ASSERT_EQ(FSEC_OK, table.Store(_rootDir, 1));
+
+    FileChecksumTable loadedTable;
+    auto [ec, exist] = loadedTable.Load(_rootDir, 1);
+    ASSERT_EQ(FSEC_OK, ec);
+    ASSERT_TRUE(exist);
+    auto checksum = loadedTable.FindReusable("segment_0/data", 4, 100);
+    ASSERT_TRUE(checksum);
+    ASSERT_EQ("4-1-2", *checksum);
+    // rewritten with the same length
+    ASSERT_FALSE(loadedTable.FindReusable("segment_0/data", 4, 101));
+    ASSERT_FALSE(loadedTable.FindReusable("segment_0/data", 5, 100));
+    // modify time unknown
+    ASSERT_FALSE(loadedTable.FindReusable("segment_0/attribute", 8, 100));
+    ASSERT_FALSE(loadedTable.FindReusable("segment_0/none", 4, 100));
+}
+
+void FileChecksumTableTest::PrepareTwoFences(versionid_t versionId)
+{
+    ASSERT_EQ(FSEC_OK, FslibWrapper::AtomicStore(util::PathUtil::JoinPath(_fence1, "segment_0/data"), "abcd").Code());
+    ASSERT_EQ(FSEC_OK, FslibWrapper::AtomicStore(util::PathUtil::JoinPath(_fence2, "segment_1/data"), "efgh").Code());
+    string entryTable = R"({
+        "files": {
+            ")" + _fence1 + R"(": {
+                "segment_0": {"length": -2},
+                "segment_0/data": {"length": 4}
+            },
+            ")" + _fence2 + R"(": {
+                "segment_1": {"length": -2},
+                "segment_1/data": {"length": 4}
+            }
+        }
+    })";
+    ASSERT_EQ(FSEC_OK, FslibWrapper::AtomicStore(
+                           util::PathUtil::JoinPath(_fence2, "entry_table." + std::to_string(versionId)), entryTable)
+                           .Code());
+}
+
+void FileChecksumTableTest::TestGenerateReuseLastPublishedTable()
+{
+    PrepareTwoFences(1);
+    // the previously published version 0 lives in fence1, its table is the only one that knows segment_0
+    string reusedFile = util::PathUtil::JoinPath(_fence1, "segment_0/data");
+    auto [metaEc, fileMeta] = FslibWrapper::GetFileMeta(reusedFile);
+    ASSERT_EQ(FSEC_OK, metaEc);
+    FileChecksumTable lastTable;
+    lastTable.Set(_fence1, reusedFile, "4-reused", fileMeta.lastModifyTime);
+    ASSERT_EQ(FSEC_OK, lastTable.Store(_fence1, 0));
+
+    ASSERT_EQ(FSEC_OK, FileChecksumTable::Generate(_fence2, 1, _fence1, 0));
+    FileChecksumTable table;
+    auto [ec, exist] = table.Load(_fence2, 1);
+    ASSERT_EQ(FSEC_OK, ec);
+    ASSERT_TRUE(exist);
+    auto checksum = table.Find(_fence2, reusedFile);
+    ASSERT_TRUE(checksum);
+    ASSERT_EQ("4-reused", *checksum);
+    string computedFile = util::PathUtil::JoinPath(_fence2, "segment_1/data");
+    checksum = table.Find(_fence2, computedFile);
+    ASSERT_TRUE(checksum);
+    ASSERT_EQ(FileChecksumTable::ComputeChecksum(computedFile).Value(), *checksum);
+
+    // without the last published table, only tables of the same root are searched
+    ASSERT_EQ(FSEC_OK, FslibWrapper::DeleteFile(util::PathUtil::JoinPath(_fence2, "file_checksum.1"),
+                                                DeleteOption::NoFence(false))
+                           .Code());
+    ASSERT_EQ(FSEC_OK, FileChecksumTable::Generate(_fence2, 1));
+    auto [reloadEc, reloaded] = table.Load(_fence2, 1);
+    ASSERT_EQ(FSEC_OK, reloadEc);
+    ASSERT_TRUE(reloaded);
+    checksum = table.Find(_fence2, reusedFile);
+    ASSERT_TRUE(checksum);
+    ASSERT_EQ(FileChecksumTable::ComputeChecksum(reusedFile).Value(), *checksum);
+}
+
+void FileChecksumTableTest::TestGeneratorStartAndStop()
+{
+    PrepareTwoFences(1);
+    FileChecksumGenerator generator;
+    // not started
+    ASSERT_FALSE(generator.GenerateAsync(_fence2, 1, "", INVALID_VERSIONID));
+    ASSERT_TRUE(generator.Start());
+    ASSERT_TRUE(generator.GenerateAsync(_fence2, 1, "", INVALID_VERSIONID));
+    string tablePath = util::PathUtil::JoinPath(_fence2, "file_checksum.1");
+    for (size_t i = 0; i < 1000 && !FslibWrapper::IsExist(tablePath).GetOrThrow(); ++i) {
+        usleep(10 * 1000);
+    }
+    ASSERT_TRUE(FslibWrapper::IsExist(tablePath).GetOrThrow());
+    generator.Stop();
+    ASSERT_FALSE(generator.GenerateAsync(_fence2, 1, "", INVALID_VERSIONID));
+}
+
+}} // namespace indexlib::file_system
@@ -192,6 +192,44 @@ uint32_t WAL::Writer::GetDataCRC(const std::string& record)
 bool WAL::Writer::AppendRecord(const std::string& record)
 {
     ::indexlib::proto::WalRecordMeta meta;
+    std::string compressData;
+    if (!Compress(record, compressData)) {
+        AUTIL_LOG(ERROR, "compress data failed");
+        return false;
+    }
+    return WriteBlock(meta, compressData, /*needSync=*/false);
+}
+
+bool WAL::Writer::AppendRecords(const std::vector<std::string>& records, bool needSync)
+{
+    if (records.empty()) {
+        return true;
+    }
+    // format like: |record_len|record|record_len|record|..., compressed as a whole
+    size_t totalLen = 0;
+    for (const auto& record : records) {
+        totalLen += sizeof(uint32_t) + record.size();
+    }
+    std::string batchData;
+    batchData.reserve(totalLen);
+    for (const auto& record : records) {
+        uint32_t len = record.size();
+        batchData.append((const char*)&len, sizeof(len));
+        batchData.append(record);
+    }
+
+    ::indexlib::proto::WalRecordMeta meta;
+    meta.set_recordcount(records.size());
+    std::string compressData;
+    if (!Compress(batchData, compressData)) {
+        AUTIL_LOG(ERROR, "compress batch data failed, record count[%lu]", records.size());
+        return false;
+    }
+    return WriteBlock(meta, compressData, needSync);
+}
+
+bool WAL::Writer::WriteBlock(::indexlib::proto::WalRecordMeta& meta, const std::string& compressData, bool needSync)
+{
     meta.set_offset(_offset);
     ::indexlib::proto::CompressType type;
     if (!ToPBType(_compressType, type)) {
@@ -199,12 +237,6 @@ bool WAL::Writer::AppendRecord(const std::string& record)
         return false;
     }
     meta.set_compresstype(type);
-
-    std::string compressData;
-    if (!Compress(record, compressData)) {
-        AUTIL_LOG(ERROR, "compress data failed");
-        return false;
-    }
     meta.set_datalen(compressData.size());
     meta.set_crc(GetDataCRC(compressData));
 
@@ -235,15 +267,15 @@ bool WAL::Writer::AppendRecord(const std::string& record)
         return false;
     }
 
-    auto ec = _file->flush();
+    auto ec = needSync ? _file->sync() : _file->flush();
     if (ec != fslib::EC_OK) {
-        AUTIL_LOG(ERROR, "flush failed, ec[%d] file[%s]", static_cast<int>(ec), _file->getFileName());
+        AUTIL_LOG(ERROR, "%s failed, ec[%d] file[%s]", needSync ? "sync" : "flush", static_cast<int>(ec),
+                  _file->getFileName());
         return false;
     }
 
     _offset += writeBytes;
     AUTIL_LOG(DEBUG, "meta[%s] current offset[%lu]", meta.ShortDebugString().c_str(), _offset);
-    // std::cout << "meta:" << meta.ShortDebugString() << " offset:" << _offset << std::endl;
     return true;
 }
 
@@ -313,8 +345,38 @@ bool WAL::Reader::RotateNextBlock(size_t& leftLen, int64_t requiredBytes)
     return true;
 }
 
+bool WAL::Reader::ReadBatchRecord(std::string& record)
+{
+    if (_batchCursor + sizeof(uint32_t) > _batchData.size()) {
+        AUTIL_LOG(ERROR, "invalid batch block, cursor[%lu] size[%lu] file[%s]", _batchCursor, _batchData.size(),
+                  _file->getFileName());
+        return false;
+    }
+    uint32_t len = *(uint32_t*)(_batchData.data() + _batchCursor);
+    _batchCursor += sizeof(uint32_t);
+    if (_batchCursor + len > _batchData.size()) {
+        AUTIL_LOG(ERROR, "invalid batch record, cursor[%lu] len[%u] size[%lu] file[%s]", _batchCursor, len,
+                  _batchData.size(), _file->getFileName());
+        return false;
+    }
+    record.assign(_batchData.data() + _batchCursor, len);
+    _batchCursor += len;
+    if (--_batchLeftCount == 0) {
+        // the block counts as consumed only when its last record is handed out, so that
+        // LastRecordOffset never points into the middle of a group committed block
+        _offsetInFile += _batchBlockLen;
+        _batchData.clear();
+        _batchCursor = 0;
+        _batchBlockLen = 0;
+    }
+    return true;
+}
+
 bool WAL::Reader::ReadRecord(std::string& record)
 {
+    if (_batchLeftCount > 0) {
+        return ReadBatchRecord(record);
+    }
     if (_eof) {
         return false;
     }
@@ -383,10 +445,24 @@ bool WAL::Reader::ReadRecord(std::string& record)
     }
     _offsetInBlock += meta.datalen();
     leftLen -= meta.datalen();
-    _offsetInFile += _headerLen + pb_len + meta.datalen();
-    return true;
+    size_t blockLen = _headerLen + pb_len + meta.datalen();
+    if (!meta.has_recordcount()) {
+        _offsetInFile += blockLen;
+        return true;
+    }
+    if (meta.recordcount() == 0) {
+        _offsetInFile += blockLen;
+        return ReadRecord(record);
+    }
+    _batchData.swap(record);
+    _batchCursor = 0;
+    _batchLeftCount = meta.recordcount();
+    _batchBlockLen = blockLen;
+    return ReadBatchRecord(record);
 }
 
+WAL::~WAL() { StopGroupCommit(); }
+
 bool WAL::Init()
 {
     bool isExist = false;
@@ -421,6 +497,11 @@ bool WAL::Init()
         AUTIL_LOG(ERROR, "Init failed");
         return false;
     }
+    if (_walOpt.enableGroupCommit && !_groupCommitThread.joinable()) {
+        _groupCommitThread = std::thread([this]() { GroupCommitLoop(); });
+        AUTIL_LOG(INFO, "wal group commit enabled, max latency[%ld]us, max batch size[%lu], max batch bytes[%lu]",
+                  _walOpt.groupCommitMaxLatencyUs, _walOpt.groupCommitMaxBatchSize, _walOpt.groupCommitMaxBatchBytes);
+    }
     return true;
 }
 
@@ -436,7 +517,10 @@ bool WAL::Recycle()
         return false;
     }
     _walFiles.clear();
-    _writer.reset();
+    {
+        std::lock_guard<std::mutex> guard(_writerMutex);
+        _writer.reset();
+    }
     _reader.reset();
     return true;
 }
@@ -489,13 +573,9 @@ bool WAL::OpenReader(size_t begin_pos, size_t offset)
     return true;
 }
 
-bool WAL::AppendRecord(const std::string& record)
+bool WAL::CheckAppendResult(bool success)
 {
-    if (_writer == nullptr) {
-        return false; // make sure error_code
-    }
-
-    if (!_writer->AppendRecord(record)) {
+    if (!success) {
         AUTIL_LOG(ERROR, "append record failed, file[%s]", _writer->GetWriterFileName());
         if (++_continuousAppendFails > CONTINUOUS_APPEND_FAIL_LIMITS) {
             AUTIL_LOG(ERROR, "continuous append fail [%lu] exceed limits [%lu]", _continuousAppendFails,
@@ -514,6 +594,114 @@ bool WAL::AppendRecord(const std::string& record)
     return true;
 }
 
+bool WAL::AppendRecord(const std::string& record)
+{
+    std::lock_guard<std::mutex> guard(_writerMutex);
+    if (_writer == nullptr) {
+        return false; // make sure error_code
+    }
+    return CheckAppendResult(_writer->AppendRecord(record));
+}
+
+bool WAL::AppendRecords(const std::vector<std::string>& records)
+{
+    std::lock_guard<std::mutex> guard(_writerMutex);
+    if (_writer == nullptr) {
+        return false;
+    }
+    return CheckAppendResult(_writer->AppendRecords(records, _walOpt.isGroupCommitSync));
+}
+
+std::future<bool> WAL::AppendRecordAsync(std::string record)
+{
+    if (!_walOpt.enableGroupCommit || !_groupCommitThread.joinable()) {
+        std::promise<bool> promise;
+        promise.set_value(AppendRecord(record));
+        return promise.get_future();
+    }
+    PendingRecord pending;
+    pending.record = std::move(record);
+    pending.enqueueTime = std::chrono::steady_clock::now();
+    auto future = pending.promise.get_future();
+    bool needNotify = false;
+    {
+        std::unique_lock<std::mutex> lock(_groupMutex);
+        if (_stopGroupCommit) {
+            // the committer is leaving, write the record by the caller like a non group committed wal
+            lock.unlock();
+            pending.promise.set_value(AppendRecord(pending.record));
+            return future;
+        }
+        _pendingBytes += pending.record.size();
+        _pendingRecords.push_back(std::move(pending));
+        // committer only cares about the first record (starts the window) and the size limits
+        needNotify = _pendingRecords.size() == 1 || _pendingRecords.size() >= _walOpt.groupCommitMaxBatchSize ||
+                     _pendingBytes >= _walOpt.groupCommitMaxBatchBytes;
+    }
+    if (needNotify) {
+        _groupCond.notify_one();
+    }
+    return future;
+}
+
+void WAL::GroupCommitLoop()
+{
+    std::vector<PendingRecord> batch;
+    std::vector<std::string> records;
+    std::unique_lock<std::mutex> lock(_groupMutex);
+    while (true) {
+        _groupCond.wait(lock, [this]() { return _stopGroupCommit || !_pendingRecords.empty(); });
+        if (_pendingRecords.empty()) {
+            break;
+        }
+        auto deadline =
+            _pendingRecords.front().enqueueTime + std::chrono::microseconds(_walOpt.groupCommitMaxLatencyUs);
+        _groupCond.wait_until(lock, deadline, [this]() {
+            return _stopGroupCommit || _pendingRecords.size() >= _walOpt.groupCommitMaxBatchSize ||
+                   _pendingBytes >= _walOpt.groupCommitMaxBatchBytes;
+        });
+        // one write takes at most the batch limits (but at least one record), the rest waits for the next round
+        size_t batchBytes = 0;
+        while (!_pendingRecords.empty()) {
+            size_t recordBytes = _pendingRecords.front().record.size();
+            if (!batch.empty() && (batch.size() >= _walOpt.groupCommitMaxBatchSize ||
+                                   batchBytes + recordBytes > _walOpt.groupCommitMaxBatchBytes)) {
+                break;
+            }
+            batchBytes += recordBytes;
+            batch.push_back(std::move(_pendingRecords.front()));
+            _pendingRecords.pop_front();
+        }
+        _pendingBytes -= batchBytes;
+        lock.unlock();
+
+        records.clear();
+        records.reserve(batch.size());
+        for (auto& pending : batch) {
+            records.push_back(std::move(pending.record));
+        }
+        bool ret = AppendRecords(records);
+        for (auto& pending : batch) {
+            pending.promise.set_value(ret);
+        }
+        batch.clear();
+        lock.lock();
+    }
+}
+
+void WAL::StopGroupCommit()
+{
+    {
+        std::lock_guard<std::mutex> guard(_groupMutex);
+        _stopGroupCommit = true;
+    }
+    _groupCond.notify_all();
+    if (_groupCommitThread.joinable()) {
+        // pending records are committed before the thread exits
+        _groupCommitThread.join();
+    }
+}
+
 bool WAL::ReadRecord(std::string& record)
 {
     if (_isRecovered) {
@@ -564,6 +752,7 @@ bool WAL::ReadRecord(std::string& record)
 
 bool WAL::ReOpen(bool removeOldFile)
 {
+    std::lock_guard<std::mutex> guard(_writerMutex);
     std::string fileName = _writer->GetWriterFileName(); // use std::string instead of const char* for safe
     if (!OpenWriter(_writer->LastNextFileOffset())) {
         AUTIL_LOG(ERROR, "reopen failed");
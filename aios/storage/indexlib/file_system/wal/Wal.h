@@ -15,11 +15,17 @@
  */
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <stddef.h>
 #include <stdint.h>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "autil/Log.h"
@@ -51,6 +57,12 @@ public:
         bool isReadDirectIO = false;
         bool isWriteDirectIO = false;
         bool isCheckSum = true;
+        // group commit: concurrent AppendRecordAsync callers are coalesced into one block per window
+        bool enableGroupCommit = false;
+        int64_t groupCommitMaxLatencyUs = 1000;
+        size_t groupCommitMaxBatchSize = 256;
+        size_t groupCommitMaxBatchBytes = 4 * 1024 * 1024;
+        bool isGroupCommitSync = false; // sync instead of flush after each group commit
 
         WALOption(const std::string& workDir_ = "") : workDir(workDir_) {}
         WALOption& operator=(const WALOption& opt)
@@ -62,6 +74,11 @@ public:
                 isReadDirectIO = opt.isReadDirectIO;
                 isWriteDirectIO = opt.isWriteDirectIO;
                 isCheckSum = opt.isCheckSum;
+                enableGroupCommit = opt.enableGroupCommit;
+                groupCommitMaxLatencyUs = opt.groupCommitMaxLatencyUs;
+                groupCommitMaxBatchSize = opt.groupCommitMaxBatchSize;
+                groupCommitMaxBatchBytes = opt.groupCommitMaxBatchBytes;
+                isGroupCommitSync = opt.isGroupCommitSync;
             }
             return *this;
         }
@@ -70,13 +87,18 @@ public:
     static bool IsValidWALDirName(const std::string& fileName);
 
     explicit WAL(const WALOption& opt) : _walOpt(opt), _continuousAppendFails(0) {}
-    ~WAL() = default;
+    ~WAL();
 
     WAL(const WAL&) = delete;
     WAL& operator=(const WAL&) = delete;
 
     bool Init();
     bool AppendRecord(const std::string& record);
+    // write all records as one block with a single write+flush
+    bool AppendRecords(const std::vector<std::string>& records);
+    // the future is ready once the group containing the record is persisted,
+    // falls back to synchronous AppendRecord when group commit is disabled
+    std::future<bool> AppendRecordAsync(std::string record);
     bool ReadRecord(std::string& record);
     bool IsRecovered() const { return _isRecovered; };
 
@@ -127,6 +149,7 @@ public:
         Writer& operator=(const Writer&) = delete;
 
         bool AppendRecord(const std::string& record);
+        bool AppendRecords(const std::vector<std::string>& records, bool needSync);
 
         size_t LastOffset() const { return _offset; }
 
@@ -137,6 +160,7 @@ public:
     private:
         uint32_t GetDataCRC(const std::string& record);
         bool Compress(const std::string& record, std::string& compressData);
+        bool WriteBlock(::indexlib::proto::WalRecordMeta& meta, const std::string& data, bool needSync);
 
     private:
         static constexpr uint32_t DEFAULT_DATA_BUF_SIZE = 1024 * 1024; // 1M
@@ -180,6 +204,7 @@ public:
         bool DeCompress(const WAL::CompressType& type, const char* rawData, uint32_t len, std::string& record) const;
 
         bool RotateNextBlock(size_t& leftLen, int64_t requiredBytes);
+        bool ReadBatchRecord(std::string& record);
 
     private:
         static constexpr uint32_t DEFAULT_DATA_BUF_SIZE = 1024 * 1024; // 1M
@@ -195,6 +220,11 @@ public:
         const uint32_t _headerLen;
         const uint64_t _beginOffset;
         const bool _isCheckSum;
+        // decompressed group committed block, records are handed out one by one
+        std::string _batchData;
+        size_t _batchCursor = 0;
+        uint32_t _batchLeftCount = 0;
+        size_t _batchBlockLen = 0;
 
     private:
         AUTIL_LOG_DECLARE();
@@ -215,6 +245,16 @@ private:
     bool OpenWriter(size_t offset);
     bool OpenReader(size_t begin_pos, size_t offset);
     bool LoadWALFiles();
+    bool CheckAppendResult(bool success);
+    void GroupCommitLoop();
+    void StopGroupCommit();
+
+private:
+    struct PendingRecord {
+        std::string record;
+        std::promise<bool> promise;
+        std::chrono::steady_clock::time_point enqueueTime;
+    };
 
 private:
     const WALOption _walOpt;
@@ -224,6 +264,14 @@ private:
     std::unique_ptr<Reader> _reader;
     size_t _continuousAppendFails;
 
+    std::mutex _writerMutex;
+    std::mutex _groupMutex;
+    std::condition_variable _groupCond;
+    std::deque<PendingRecord> _pendingRecords;
+    size_t _pendingBytes = 0;
+    bool _stopGroupCommit = false;
+    std::thread _groupCommitThread;
+
 private:
     AUTIL_LOG_DECLARE();
 };
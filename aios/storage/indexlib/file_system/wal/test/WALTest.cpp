@@ -0,0 +1,230 @@
+#include "indexlib/file_system/wal/Wal.h"
+
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "indexlib/util/testutil/unittest.h"
+
+namespace indexlib { namespace file_system {
+
+class WALTest : public TESTBASE
+{
+public:
+    WALTest() = default;
+    ~WALTest() = default;
+
+    void setUp() override
+    {
+        ASSERT_TRUE(WAL::WALOperator::Init());
+        _workDir = GET_TEMP_DATA_PATH() + "/wal";
+    }
+    void tearDown() override {}
+
+protected:
+    WAL::WALOption MakeOption(WAL::CompressType compressType = WAL::CompressType::CompressionKind_NONE) const
+    {
+        WAL::WALOption option(_workDir);
+        option.compressType = compressType;
+        return option;
+    }
+    std::vector<std::string> ReadAll(const WAL::WALOption& option) const
+    {
+        WAL wal(option);
+        EXPECT_TRUE(wal.Init());
+        std::vector<std::string> records;
+        while (!wal.IsRecovered()) {
+            // like recovering callers, an empty record means nothing is read
+            std::string record;
+            EXPECT_TRUE(wal.ReadRecord(record));
+            if (!record.empty()) {
+                records.push_back(record);
+            }
+        }
+        return records;
+    }
+
+protected:
+    std::string _workDir;
+};
+
+TEST_F(WALTest, testBatchAppendAndRead)
+{
+    for (auto compressType : {WAL::CompressType::CompressionKind_NONE, WAL::CompressType::CompressionKind_ZSTD}) {
+        _workDir = GET_TEMP_DATA_PATH() + "/wal_" + std::to_string(static_cast<int>(compressType));
+        std::vector<std::string> expected = {"record_0", std::string(10000, 'a'), "record_2"};
+        {
+            WAL wal(MakeOption(compressType));
+            ASSERT_TRUE(wal.Init());
+            ASSERT_TRUE(wal.AppendRecords(expected));
+            ASSERT_TRUE(wal.AppendRecords({}));
+        }
+        ASSERT_EQ(expected, ReadAll(MakeOption(compressType)));
+    }
+}
+
+TEST_F(WALTest, testReadMixedSingleAndBatchRecords)
+{
+    {
+        WAL wal(MakeOption());
+        ASSERT_TRUE(wal.Init());
+        ASSERT_TRUE(wal.AppendRecord("single_0"));
+        ASSERT_TRUE(wal.AppendRecords({"batch_0", "batch_1"}));
+        ASSERT_TRUE(wal.AppendRecord("single_1"));
+        ASSERT_TRUE(wal.AppendRecords({"batch_2"}));
+        ASSERT_TRUE(wal.AppendRecord("single_2"));
+    }
+    std::vector<std::string> expected = {"single_0", "batch_0", "batch_1", "single_1", "batch_2", "single_2"};
+    ASSERT_EQ(expected, ReadAll(MakeOption()));
+}
+
+TEST_F(WALTest, testLastRecordOffsetInBatch)
+{
+    {
+        WAL wal(MakeOption());
+        ASSERT_TRUE(wal.Init());
+        ASSERT_TRUE(wal.AppendRecord("single"));
+        ASSERT_TRUE(wal.AppendRecords({"batch_0", "batch_1", "batch_2"}));
+        ASSERT_TRUE(wal.AppendRecord("tail"));
+    }
+    WAL wal(MakeOption());
+    ASSERT_TRUE(wal.Init());
+    std::string record;
+    ASSERT_TRUE(wal.ReadRecord(record));
+    ASSERT_EQ("single", record);
+    size_t batchBegin = wal._reader->LastRecordOffset();
+    ASSERT_LT(0u, batchBegin);
+
+    // the whole block counts as consumed only after its last record
+    ASSERT_TRUE(wal.ReadRecord(record));
+    ASSERT_EQ("batch_0", record);
+    ASSERT_EQ(batchBegin, wal._reader->LastRecordOffset());
+    ASSERT_TRUE(wal.ReadRecord(record));
+    ASSERT_EQ("batch_1", record);
+    ASSERT_EQ(batchBegin, wal._reader->LastRecordOffset());
+    ASSERT_TRUE(wal.ReadRecord(record));
+    ASSERT_EQ("batch_2", record);
+    size_t batchEnd = wal._reader->LastRecordOffset();
+    ASSERT_LT(batchBegin, batchEnd);
+
+    // recovering from the beginning of the batch replays all of its records
+    WAL::WALOption option = MakeOption();
+    option.recoverPos = batchBegin;
+    std::vector<std::string> expected = {"batch_0", "batch_1", "batch_2", "tail"};
+    ASSERT_EQ(expected, ReadAll(option));
+    option.recoverPos = batchEnd;
+    ASSERT_EQ(std::vector<std::string>({"tail"}), ReadAll(option));
+}
+
+TEST_F(WALTest, testGroupCommit)
+{
+    WAL::WALOption option = MakeOption();
+    option.enableGroupCommit = true;
+    option.groupCommitMaxLatencyUs = 1000;
+    option.groupCommitMaxBatchSize = 4;
+    std::vector<std::string> expected;
+    {
+        WAL wal(option);
+        ASSERT_TRUE(wal.Init());
+        std::vector<std::future<bool>> futures;
+        for (size_t i = 0; i < 10; ++i) {
+            expected.push_back("record_" + std::to_string(i));
+            futures.push_back(wal.AppendRecordAsync(expected.back()));
+        }
+        for (auto& future : futures) {
+            ASSERT_TRUE(future.get());
+        }
+    }
+    ASSERT_EQ(expected, ReadAll(MakeOption()));
+}
+
+TEST_F(WALTest, testGroupCommitBatchLimits)
+{
+    // (max batch size, max batch bytes), records are 10 bytes, the last one is larger than the byte limit
+    std::vector<std::pair<size_t, size_t>> limits = {{4, 1024 * 1024}, {100, 35}};
+    for (size_t caseIdx = 0; caseIdx < limits.size(); ++caseIdx) {
+        _workDir = GET_TEMP_DATA_PATH() + "/wal_limits_" + std::to_string(caseIdx);
+        WAL::WALOption option = MakeOption();
+        option.enableGroupCommit = true;
+        option.groupCommitMaxLatencyUs = 3600L * 1000 * 1000;
+        option.groupCommitMaxBatchSize = limits[caseIdx].first;
+        option.groupCommitMaxBatchBytes = limits[caseIdx].second;
+        std::vector<std::string> expected;
+        {
+            WAL wal(option);
+            ASSERT_TRUE(wal.Init());
+            std::vector<std::future<bool>> futures;
+            {
+                // hold the writer so that records pile up far beyond the limits while the committer waits
+                std::lock_guard<std::mutex> guard(wal._writerMutex);
+                for (size_t i = 0; i < 30; ++i) {
+                    char buf[16];
+                    snprintf(buf, sizeof(buf), "record_%03lu", i);
+                    expected.push_back(buf);
+                    futures.push_back(wal.AppendRecordAsync(expected.back()));
+                }
+                expected.push_back(std::string(100, 'a'));
+                futures.push_back(wal.AppendRecordAsync(expected.back()));
+            }
+            wal.StopGroupCommit();
+            for (auto& future : futures) {
+                ASSERT_TRUE(future.get());
+            }
+        }
+
+        WAL wal(MakeOption());
+        ASSERT_TRUE(wal.Init());
+        std::vector<std::string> records;
+        size_t batchCount = 0;
+        size_t batchBytes = 0;
+        while (!wal.IsRecovered()) {
+            bool newBatch = !wal._reader || wal._reader->_batchLeftCount == 0;
+            std::string record;
+            ASSERT_TRUE(wal.ReadRecord(record));
+            if (record.empty()) {
+                continue;
+            }
+            records.push_back(record);
+            if (newBatch) {
+                batchCount = 0;
+                batchBytes = 0;
+            }
+            ++batchCount;
+            batchBytes += record.size();
+            ASSERT_GE(option.groupCommitMaxBatchSize, batchCount) << caseIdx;
+            ASSERT_TRUE(batchCount == 1 || batchBytes <= option.groupCommitMaxBatchBytes) << caseIdx;
+        }
+        ASSERT_EQ(expected, records);
+    }
+}
+
+TEST_F(WALTest, testStopCompletesPendingRecords)
+{
+    WAL::WALOption option = MakeOption();
+    option.enableGroupCommit = true;
+    // the window never closes by itself, only stopping the wal commits the records
+    option.groupCommitMaxLatencyUs = 3600L * 1000 * 1000;
+    std::vector<std::string> expected;
+    std::vector<std::future<bool>> futures;
+    {
+        WAL wal(option);
+        ASSERT_TRUE(wal.Init());
+        for (size_t i = 0; i < 3; ++i) {
+            expected.push_back("record_" + std::to_string(i));
+            futures.push_back(wal.AppendRecordAsync(expected.back()));
+        }
+        ASSERT_EQ(std::future_status::timeout, futures[0].wait_for(std::chrono::milliseconds(10)));
+        wal.StopGroupCommit();
+        for (auto& future : futures) {
+            ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(0)));
+            ASSERT_TRUE(future.get());
+        }
+        // records appended after stop are not lost
+        expected.push_back("after_stop");
+        ASSERT_TRUE(wal.AppendRecordAsync(expected.back()).get());
+    }
+    ASSERT_EQ(expected, ReadAll(MakeOption()));
+}
+
+}} // namespace indexlib::file_system
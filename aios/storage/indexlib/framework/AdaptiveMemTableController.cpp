@@ -0,0 +1,92 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/framework/AdaptiveMemTableController.h"
+
+#include <algorithm>
+
+namespace indexlibv2::framework {
+
+void AdaptiveMemTableController::Update(const Sample& sample)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    if (!_preallocated && _hasSample && sample.timestampUs > _lastTimestampUs) {
+        // building mem drops when a new segment is opened, the growth is all in the new segment then
+        int64_t growth = sample.buildingMemUse >= _lastBuildingMemUse ? sample.buildingMemUse - _lastBuildingMemUse
+                                                                      : sample.buildingMemUse;
+        double rate = (double)growth * 1000000 / (sample.timestampUs - _lastTimestampUs);
+        _writeRate = EWMA_ALPHA * rate + (1 - EWMA_ALPHA) * _writeRate;
+    }
+    if (sample.dumpingMemUse > 0 && _dumpBeginTimestampUs < 0) {
+        _dumpBeginTimestampUs = sample.timestampUs;
+    } else if (sample.dumpingMemUse == 0 && _dumpBeginTimestampUs >= 0) {
+        double latency = std::max<int64_t>(sample.timestampUs - _dumpBeginTimestampUs, 0);
+        _dumpLatencyUs = _dumpLatencyUs < 0 ? latency : EWMA_ALPHA * latency + (1 - EWMA_ALPHA) * _dumpLatencyUs;
+        _dumpBeginTimestampUs = -1;
+    }
+    _hasSample = true;
+    _lastTimestampUs = sample.timestampUs;
+    _lastBuildingMemUse = sample.buildingMemUse;
+    _buildingMemLimit = CalculateLimit(sample);
+}
+
+int64_t AdaptiveMemTableController::CalculateLimit(const Sample& sample) const
+{
+    // memory the building and dumping segments may hold together
+    int64_t occupied = sample.buildingMemUse + sample.dumpingMemUse;
+    int64_t budget = sample.rtMemQuota - sample.builtRtMemUse;
+    budget = std::min(budget, sample.totalFreeQuota + occupied - sample.dumpExpandMemUse);
+    budget = std::min(budget, sample.buildFreeQuota + occupied);
+    budget = budget * SAFETY_RATIO;
+    if (budget <= 0) {
+        return MIN_BUILDING_MEM_LIMIT;
+    }
+    int64_t limit = budget / 2;
+    if (!_preallocated && _dumpLatencyUs >= 0) {
+        // the next segment only grows writeRate * dumpLatency before the previous one is released
+        int64_t overlap = _writeRate * _dumpLatencyUs / 1000000;
+        limit = std::max(limit, budget - overlap);
+    }
+    return std::max(limit, MIN_BUILDING_MEM_LIMIT);
+}
+
+int64_t AdaptiveMemTableController::GetBuildingSegmentMemoryLimit(int64_t defaultLimit) const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _hasSample ? _buildingMemLimit : defaultLimit;
+}
+
+int64_t AdaptiveMemTableController::GetWriteRate() const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _writeRate;
+}
+
+int64_t AdaptiveMemTableController::GetDumpLatency() const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _dumpLatencyUs;
+}
+
+int64_t AdaptiveMemTableController::GetDumpInterval() const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    if (!_hasSample || _writeRate < 1.0) {
+        return -1;
+    }
+    return _buildingMemLimit / _writeRate;
+}
+
+} // namespace indexlibv2::framework
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <mutex>
+#include <stdint.h>
+
+namespace indexlibv2::framework {
+
+// AdaptiveMemTableController sizes the building segment (memtable) of LSM tables online.
+// Each sample carries the realtime memory split and the free quota; the controller tracks the
+// write rate of the building segment and how long a segment stays in dumping. A bigger memtable
+// means fewer, larger segments, but while the previous memtable is dumping the new one keeps
+// growing, so the limit L must satisfy L + min(L, writeRate * dumpLatency) <= budget.
+// Indexers that preallocate the whole memtable when a segment opens (e.g. kv/kkv hash tables) hold L at once while
+// the previous memtable dumps, so L is kept at budget / 2 for them, and their memory growth is not a write rate.
+class AdaptiveMemTableController
+{
+public:
+    struct Sample {
+        int64_t timestampUs = 0;
+        int64_t buildingMemUse = 0;
+        int64_t dumpingMemUse = 0;
+        int64_t builtRtMemUse = 0;
+        int64_t rtMemQuota = 0;
+        int64_t totalFreeQuota = 0; // free quota of tablet memory, inc reader memory excluded
+        int64_t buildFreeQuota = 0; // free quota of build memory, maybe shared by multi tablets
+        int64_t dumpExpandMemUse = 0;
+    };
+
+public:
+    explicit AdaptiveMemTableController(bool preallocated = false) : _preallocated(preallocated) {}
+    ~AdaptiveMemTableController() = default;
+
+public:
+    void Update(const Sample& sample);
+    // return defaultLimit before the first sample arrives
+    int64_t GetBuildingSegmentMemoryLimit(int64_t defaultLimit) const;
+    int64_t GetWriteRate() const;     // bytes per second
+    int64_t GetDumpLatency() const;   // us, -1 if no dump observed
+    int64_t GetDumpInterval() const;  // seconds to fill a building segment, -1 if no write
+
+private:
+    int64_t CalculateLimit(const Sample& sample) const;
+
+public:
+    static constexpr double EWMA_ALPHA = 0.3;
+    static constexpr double SAFETY_RATIO = 0.9;
+    static constexpr int64_t MIN_BUILDING_MEM_LIMIT = 16L * 1024 * 1024;
+
+private:
+    const bool _preallocated;
+    mutable std::mutex _mutex;
+    bool _hasSample = false;
+    int64_t _lastTimestampUs = 0;
+    int64_t _lastBuildingMemUse = 0;
+    int64_t _dumpBeginTimestampUs = -1;
+    double _writeRate = 0.0;
+    double _dumpLatencyUs = -1.0;
+    int64_t _buildingMemLimit = 0;
+};
+
+} // namespace indexlibv2::framework
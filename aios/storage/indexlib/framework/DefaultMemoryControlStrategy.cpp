@@ -19,6 +19,7 @@
 #include <stddef.h>
 #include <string>
 
+#include "autil/TimeUtility.h"
 #include "autil/UnitUtil.h"
 
 namespace indexlibv2::framework {
@@ -26,10 +27,14 @@ AUTIL_LOG_SETUP(indexlib.framework, DefaultMemoryControlStrategy);
 
 DefaultMemoryControlStrategy::DefaultMemoryControlStrategy(
     const std::shared_ptr<config::TabletOptions>& options,
-    const std::shared_ptr<MemoryQuotaSynchronizer>& buildMemoryQuotaSynchronizer)
+    const std::shared_ptr<MemoryQuotaSynchronizer>& buildMemoryQuotaSynchronizer, bool enableAdaptiveMemTable,
+    bool preallocatedMemTable)
     : _tabletOptions(options)
     , _buildMemoryQuotaSynchronizer(buildMemoryQuotaSynchronizer)
 {
+    if (enableAdaptiveMemTable) {
+        _memTableController = std::make_unique<AdaptiveMemTableController>(preallocatedMemTable);
+    }
 }
 
 DefaultMemoryControlStrategy::~DefaultMemoryControlStrategy() {}
@@ -88,6 +93,47 @@ DefaultMemoryControlStrategy::CheckTotalMemoryQuota(const std::shared_ptr<Tablet
 void DefaultMemoryControlStrategy::SyncMemoryQuota(const std::shared_ptr<TabletMetrics>& tabletMetrics)
 {
     _buildMemoryQuotaSynchronizer->SyncMemoryQuota(tabletMetrics->GetRtIndexMemSize());
+    if (_memTableController) {
+        UpdateMemTableController(tabletMetrics);
+    }
+}
+
+void DefaultMemoryControlStrategy::UpdateMemTableController(const std::shared_ptr<TabletMetrics>& tabletMetrics)
+{
+    AdaptiveMemTableController::Sample sample;
+    sample.timestampUs = autil::TimeUtility::currentTime();
+    sample.buildingMemUse = tabletMetrics->GetRtIndexMemSize(RealtimeIndexMemoryType::BUILDING);
+    sample.dumpingMemUse = tabletMetrics->GetRtIndexMemSize(RealtimeIndexMemoryType::DUMPING);
+    sample.builtRtMemUse = tabletMetrics->GetRtIndexMemSize(RealtimeIndexMemoryType::BUILT);
+    sample.rtMemQuota = _tabletOptions->GetBuildMemoryQuota();
+    // free quota of tablet controller maybe negative
+    sample.totalFreeQuota = static_cast<int64_t>(tabletMetrics->GetFreeQuota());
+    sample.buildFreeQuota = _buildMemoryQuotaSynchronizer->GetFreeQuota();
+    sample.dumpExpandMemUse = std::max(tabletMetrics->GetBuildingSegmentDumpExpandMemsize(),
+                                       tabletMetrics->GetMaxDumpingSegmentExpandMemsize());
+    auto lastLimit = _memTableController->GetBuildingSegmentMemoryLimit(/*defaultLimit=*/0);
+    _memTableController->Update(sample);
+    auto limit = _memTableController->GetBuildingSegmentMemoryLimit(/*defaultLimit=*/0);
+    tabletMetrics->SetMemTableControlMetrics(limit, _memTableController->GetWriteRate(),
+                                             _memTableController->GetDumpInterval());
+    if (limit != lastLimit) {
+        AUTIL_LOG(DEBUG, "table[%s] adapt building segment memory limit [%s] -> [%s], write rate [%s/s]",
+                  _tabletOptions->GetTabletName().c_str(), autil::UnitUtil::GiBDebugString(lastLimit).c_str(),
+                  autil::UnitUtil::GiBDebugString(limit).c_str(),
+                  autil::UnitUtil::GiBDebugString(_memTableController->GetWriteRate()).c_str());
+    }
+}
+
+int64_t DefaultMemoryControlStrategy::GetBuildingSegmentMemoryLimit(int64_t suggestLimit) const
+{
+    if (!_memTableController) {
+        return suggestLimit;
+    }
+    auto limit = _memTableController->GetBuildingSegmentMemoryLimit(suggestLimit);
+    AUTIL_LOG(INFO, "table[%s] adaptive building segment memory limit [%s], suggest [%s], dump interval [%ld]s",
+              _tabletOptions->GetTabletName().c_str(), autil::UnitUtil::GiBDebugString(limit).c_str(),
+              autil::UnitUtil::GiBDebugString(suggestLimit).c_str(), _memTableController->GetDumpInterval());
+    return limit;
 }
 
 } // namespace indexlibv2::framework
@@ -20,6 +20,7 @@
 #include "autil/Log.h"
 #include "indexlib/base/MemoryQuotaSynchronizer.h"
 #include "indexlib/config/TabletOptions.h"
+#include "indexlib/framework/AdaptiveMemTableController.h"
 #include "indexlib/framework/IMemoryControlStrategy.h"
 #include "indexlib/framework/TabletInfos.h"
 #include "indexlib/framework/TabletMetrics.h"
@@ -30,17 +31,24 @@ class DefaultMemoryControlStrategy : public IMemoryControlStrategy
 {
 public:
     DefaultMemoryControlStrategy(const std::shared_ptr<config::TabletOptions>& options,
-                                 const std::shared_ptr<MemoryQuotaSynchronizer>& buildMemoryQuotaSynchronizer);
+                                 const std::shared_ptr<MemoryQuotaSynchronizer>& buildMemoryQuotaSynchronizer,
+                                 bool enableAdaptiveMemTable = false, bool preallocatedMemTable = false);
     ~DefaultMemoryControlStrategy();
 
 public:
     MemoryStatus CheckRealtimeIndexMemoryQuota(const std::shared_ptr<TabletMetrics>& tabletMetrics) const override;
     MemoryStatus CheckTotalMemoryQuota(const std::shared_ptr<TabletMetrics>& tabletMetrics) const override;
     void SyncMemoryQuota(const std::shared_ptr<TabletMetrics>& tabletMetrics) override;
+    int64_t GetBuildingSegmentMemoryLimit(int64_t suggestLimit) const override;
+
+protected:
+    // adaptive memtable only decides the building segment size, quota check and sync are not affected
+    void UpdateMemTableController(const std::shared_ptr<TabletMetrics>& tabletMetrics);
 
 protected:
     std::shared_ptr<config::TabletOptions> _tabletOptions;
     std::shared_ptr<MemoryQuotaSynchronizer> _buildMemoryQuotaSynchronizer;
+    std::unique_ptr<AdaptiveMemTableController> _memTableController;
 
 private:
     AUTIL_LOG_DECLARE();
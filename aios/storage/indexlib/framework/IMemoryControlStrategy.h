@@ -33,6 +33,8 @@ public:
     virtual MemoryStatus CheckRealtimeIndexMemoryQuota(const std::shared_ptr<TabletMetrics>& tabletMetrics) const = 0;
     virtual MemoryStatus CheckTotalMemoryQuota(const std::shared_ptr<TabletMetrics>& tabletMetrics) const = 0;
     virtual void SyncMemoryQuota(const std::shared_ptr<TabletMetrics>& tabletMetrics) = 0;
+    // only used when building memory limit is not configured
+    virtual int64_t GetBuildingSegmentMemoryLimit(int64_t suggestLimit) const { return suggestLimit; }
 };
 
 } // namespace indexlibv2::framework
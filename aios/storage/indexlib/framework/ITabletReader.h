@@ -16,6 +16,7 @@
 #pragma once
 
 #include <memory>
+#include <stddef.h>
 
 #include "indexlib/base/Status.h"
 
@@ -39,6 +40,9 @@ public:
                                                                 const std::string& indexName) const = 0;
     virtual std::shared_ptr<config::ITabletSchema> GetSchema() const = 0;
     virtual Status Search(const std::string& jsonQuery, std::string& result) const = 0;
+
+    // memory allocated by the reader itself at open, segment data is accounted by the segments
+    virtual size_t EvaluateCurrentMemUsed() const { return 0; }
 };
 
 } // namespace indexlibv2::framework
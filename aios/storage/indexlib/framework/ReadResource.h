@@ -21,6 +21,7 @@
 
 namespace indexlibv2 { namespace framework {
 class IIndexMemoryReclaimer;
+class ITabletReader;
 class MetricsManager;
 }} // namespace indexlibv2::framework
 
@@ -38,6 +39,8 @@ struct ReadResource {
     std::shared_ptr<IIndexMemoryReclaimer> indexMemoryReclaimer;
     std::shared_ptr<indexlib::file_system::Directory> rootDirectory;
     std::shared_ptr<indexlib::util::SearchCachePartitionWrapper> searchCache;
+    // reader of the previous tablet data, index readers over unchanged segments may be inherited from it
+    std::shared_ptr<ITabletReader> lastTabletReader;
 };
 
 } // namespace indexlibv2::framework
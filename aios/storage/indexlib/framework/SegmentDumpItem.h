@@ -32,6 +32,8 @@ public:
 
     virtual Status Dump() noexcept = 0;
     virtual bool IsDumped() const = 0;
+    // building memory held by the item, larger items are dumped first
+    virtual int64_t EstimateMemUse() const { return 0; }
 };
 
 } // namespace indexlibv2::framework
@@ -15,6 +15,7 @@
  */
 #include "indexlib/framework/SegmentDumper.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -104,6 +105,8 @@ void SegmentDumper::DumpTask(const std::vector<std::shared_ptr<SegmentDumpItem>>
         if (!status.IsOK()) {
             TABLET_LOG(ERROR, "dump segment task failed, segId[%d], seq[%u], error:%s", control->GetSegmentId(), seq,
                        status.ToString().c_str());
+        } else {
+            ReportDumpProgress(dumpItems[seq]);
         }
         std::tie(seq, total) = control->Iterate(status);
     }
@@ -123,6 +126,18 @@ Status SegmentDumper::Dump(future_lite::Executor* executor, const uint32_t dumpT
     auto segId = GetSegmentId();
     auto [st, dumpItems] = _dumpingSegment->CreateSegmentDumpItems();
     RETURN_IF_STATUS_ERROR(st, "create dump param failed, segId[%d]", segId);
+    // largest indexers first, so that the longest items start at once and small ones fill the idle threads,
+    // items without memory estimation keep their order at the tail
+    std::stable_sort(dumpItems.begin(), dumpItems.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs->EstimateMemUse() > rhs->EstimateMemUse();
+    });
+    _remainItemCount = dumpItems.size();
+    _remainMemUse = 0;
+    for (const auto& dumpItem : dumpItems) {
+        _remainMemUse += dumpItem->EstimateMemUse();
+    }
+    INDEXLIB_FM_REPORT_METRIC_WITH_VALUE(dumpSegmentRemainItemCount, _remainItemCount.load());
+    INDEXLIB_FM_REPORT_METRIC_WITH_VALUE(dumpSegmentRemainMemUse, _remainMemUse.load());
 
     const uint32_t parallelism =
         executor == nullptr ? 1 : std::min(dumpThreadCount, static_cast<uint32_t>(dumpItems.size()));
@@ -157,6 +172,7 @@ Status SegmentDumper::SequentialDump(const std::vector<std::shared_ptr<SegmentDu
             TABLET_LOG(ERROR, "dump segment failed, segId[%d], error:%s", segId, status.ToString().c_str());
             return status;
         }
+        ReportDumpProgress(dumpItem);
     }
     return StoreSegmentInfo();
 }
@@ -180,5 +196,15 @@ Status SegmentDumper::ParallelDump(future_lite::Executor* executor,
     return StoreSegmentInfo();
 }
 
+void SegmentDumper::ReportDumpProgress(const std::shared_ptr<SegmentDumpItem>& finishedItem)
+{
+    int64_t remainItemCount = --_remainItemCount;
+    int64_t remainMemUse = (_remainMemUse -= finishedItem->EstimateMemUse());
+    INDEXLIB_FM_REPORT_METRIC_WITH_VALUE(dumpSegmentRemainItemCount, remainItemCount);
+    INDEXLIB_FM_REPORT_METRIC_WITH_VALUE(dumpSegmentRemainMemUse, remainMemUse);
+    TABLET_LOG(DEBUG, "dump segment progress, segId[%d], remain items[%ld], remain mem use[%ld]", GetSegmentId(),
+               remainItemCount, remainMemUse);
+}
+
 std::shared_ptr<MemSegment> SegmentDumper::TEST_GetDumpingSegment() const { return _dumpingSegment; }
 } // namespace indexlibv2::framework
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -93,6 +94,10 @@ public:
         if (_metricsReporter) {
             REGISTER_METRIC_WITH_INDEXLIB_PREFIX(_metricsReporter, dumpSegmentLatency, "build/dumpSegmentLatency",
                                                  kmonitor::GAUGE);
+            REGISTER_METRIC_WITH_INDEXLIB_PREFIX(_metricsReporter, dumpSegmentRemainItemCount,
+                                                 "build/dumpSegmentRemainItemCount", kmonitor::GAUGE);
+            REGISTER_METRIC_WITH_INDEXLIB_PREFIX(_metricsReporter, dumpSegmentRemainMemUse,
+                                                 "build/dumpSegmentRemainMemUse", kmonitor::GAUGE);
         }
         _dumpingSegment->SetSegmentStatus(Segment::SegmentStatus::ST_DUMPING);
     }
@@ -113,6 +118,7 @@ private:
                         const segmentid_t segId, const uint32_t parallelism);
     void DumpTask(const std::vector<std::shared_ptr<SegmentDumpItem>>& dumpItems, DumpControl* control,
                   const bool isCoordinator);
+    void ReportDumpProgress(const std::shared_ptr<SegmentDumpItem>& finishedItem);
 
 private:
     static constexpr size_t PARALLEL_DUMP_THRESHOLD {4};
@@ -121,7 +127,12 @@ private:
     std::shared_ptr<MemSegment> _dumpingSegment;
     int64_t _dumpExpandMemSize;
     std::shared_ptr<kmonitor::MetricsReporter> _metricsReporter;
+    // dump progress of the segment, updated by all dump tasks
+    std::atomic<int64_t> _remainItemCount = 0;
+    std::atomic<int64_t> _remainMemUse = 0;
     INDEXLIB_FM_DECLARE_METRIC(dumpSegmentLatency);
+    INDEXLIB_FM_DECLARE_METRIC(dumpSegmentRemainItemCount);
+    INDEXLIB_FM_DECLARE_METRIC(dumpSegmentRemainMemUse);
 
     AUTIL_LOG_DECLARE();
 };
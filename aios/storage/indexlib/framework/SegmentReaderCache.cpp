@@ -0,0 +1,90 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/framework/SegmentReaderCache.h"
+
+#include <set>
+
+#include "indexlib/framework/Segment.h"
+#include "indexlib/framework/TabletData.h"
+
+namespace indexlibv2::framework {
+AUTIL_LOG_SETUP(indexlib.framework, SegmentReaderCache);
+
+std::shared_ptr<index::IIndexer> SegmentReaderCache::DoGet(const std::string& indexType,
+                                                           const std::string& indexName,
+                                                           const Segments& segments) const
+{
+    if (segments.empty() || segments.back() == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> guard(_mutex);
+    auto iter = _entries.find(Key(indexType, indexName, segments.back()->GetSegmentId()));
+    if (iter == _entries.end() || iter->second.segments != segments) {
+        return nullptr;
+    }
+    ++_hitCount;
+    return iter->second.indexer;
+}
+
+void SegmentReaderCache::Put(const std::string& indexType, const std::string& indexName, const Segments& segments,
+                             const std::shared_ptr<index::IIndexer>& indexer)
+{
+    if (segments.empty() || !indexer) {
+        return;
+    }
+    for (const auto segment : segments) {
+        // building segments change after open
+        if (segment == nullptr || segment->GetSegmentStatus() != Segment::SegmentStatus::ST_BUILT) {
+            return;
+        }
+    }
+    std::lock_guard<std::mutex> guard(_mutex);
+    _entries[Key(indexType, indexName, segments.back()->GetSegmentId())] = Entry {segments, indexer};
+}
+
+size_t SegmentReaderCache::Inherit(const SegmentReaderCache& lastCache, const TabletData& tabletData)
+{
+    std::set<const Segment*> builtSegments;
+    auto slice = tabletData.CreateSlice(Segment::SegmentStatus::ST_BUILT);
+    for (auto iter = slice.begin(); iter != slice.end(); iter++) {
+        builtSegments.insert(iter->get());
+    }
+    size_t inheritCount = 0;
+    std::scoped_lock guard(_mutex, lastCache._mutex);
+    for (const auto& [key, entry] : lastCache._entries) {
+        bool allSegmentsExist = true;
+        for (const auto segment : entry.segments) {
+            if (builtSegments.count(segment) == 0) {
+                allSegmentsExist = false;
+                break;
+            }
+        }
+        if (allSegmentsExist) {
+            _entries[key] = entry;
+            ++inheritCount;
+        }
+    }
+    AUTIL_LOG(INFO, "inherit [%lu] of [%lu] segment readers from last reader", inheritCount, lastCache._entries.size());
+    return inheritCount;
+}
+
+size_t SegmentReaderCache::GetSize() const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _entries.size();
+}
+
+} // namespace indexlibv2::framework
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "autil/Log.h"
+#include "autil/NoCopyable.h"
+#include "indexlib/base/Types.h"
+#include "indexlib/index/IIndexer.h"
+
+namespace indexlibv2::framework {
+class Segment;
+class TabletData;
+
+// Per-segment indexers opened by index readers, keyed by index and segment id. A tablet reader inherits the entries
+// of its last reader whose segments are still in its tablet data, so index readers only open new segments on reopen.
+// Segments are compared by object: a segment reloaded with the same id is a different object and is opened again.
+class SegmentReaderCache : private autil::NoCopyable
+{
+public:
+    SegmentReaderCache() = default;
+    ~SegmentReaderCache() = default;
+
+public:
+    // segments covered by the indexer, the last one is used as cache key
+    using Segments = std::vector<const Segment*>;
+
+    template <typename IndexerType>
+    std::shared_ptr<IndexerType> Get(const std::string& indexType, const std::string& indexName,
+                                     const Segments& segments) const;
+    void Put(const std::string& indexType, const std::string& indexName, const Segments& segments,
+             const std::shared_ptr<index::IIndexer>& indexer);
+    // entries of the last reader are only kept if all their built segments are still in tablet data, tablet data
+    // and last reader must both be alive while inheriting so that segment addresses are not reused
+    size_t Inherit(const SegmentReaderCache& lastCache, const TabletData& tabletData);
+
+    size_t GetHitCount() const { return _hitCount; }
+    size_t GetSize() const;
+
+private:
+    using Key = std::tuple<std::string, std::string, segmentid_t>;
+    struct Entry {
+        Segments segments;
+        std::shared_ptr<index::IIndexer> indexer;
+    };
+
+    std::shared_ptr<index::IIndexer> DoGet(const std::string& indexType, const std::string& indexName,
+                                           const Segments& segments) const;
+
+private:
+    mutable std::mutex _mutex;
+    std::map<Key, Entry> _entries;
+    mutable size_t _hitCount = 0;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+
+template <typename IndexerType>
+std::shared_ptr<IndexerType> SegmentReaderCache::Get(const std::string& indexType, const std::string& indexName,
+                                                     const Segments& segments) const
+{
+    return std::dynamic_pointer_cast<IndexerType>(DoGet(indexType, indexName, segments));
+}
+
+} // namespace indexlibv2::framework
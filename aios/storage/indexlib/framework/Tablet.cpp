@@ -65,9 +65,13 @@
 #include "indexlib/file_system/LifecycleTable.h"
 #include "indexlib/file_system/MountOption.h"
 #include "indexlib/file_system/ReaderOption.h"
+#include "indexlib/file_system/file/LazyLoadScheduler.h"
+#include "indexlib/file_system/file/PageHeatRecorder.h"
 #include "indexlib/file_system/fslib/FenceContext.h"
 #include "indexlib/file_system/fslib/FslibWrapper.h"
 #include "indexlib/file_system/load_config/LoadConfigList.h"
+#include "indexlib/file_system/load_config/MmapLoadStrategy.h"
+#include "indexlib/file_system/load_config/WarmupStrategy.h"
 #include "indexlib/framework/BuildResource.h"
 #include "indexlib/framework/DefaultMemoryControlStrategy.h"
 #include "indexlib/framework/DeployIndexUtil.h"
@@ -216,6 +220,10 @@ Tablet::OpenWriterAndReader(std::shared_ptr<TabletData> tabletData, const framew
     auto readSchema = GetReadSchema(tabletData);
     auto tabletReader = _tabletFactory->CreateTabletReader(readSchema);
     if (_tabletOptions->IsOnline()) {
+        {
+            std::lock_guard<std::mutex> guard(_readerMutex);
+            readResource.lastTabletReader = _tabletReader;
+        }
         auto versionId = tabletData->GetOnDiskVersion().GetVersionId();
         TABLET_LOG(INFO, "begin open tablet reader, version id[%d]", versionId);
         auto st = tabletReader->Open(tabletData, readResource);
@@ -1303,6 +1311,37 @@ Status Tablet::InitIndexDirectory(const IndexRoot& indexRoot)
     fsOptions.loadConfigList = _tabletOptions->GetLoadConfigList();
     fsOptions.fileBlockCacheContainer = _fileBlockCacheContainer;
     fsOptions.redirectPhysicalRoot = _tabletOptions->IsOnline();
+    if (_tabletOptions->IsOnline()) {
+        for (const auto& loadConfig : fsOptions.loadConfigList.GetLoadConfigs()) {
+            auto mmapLoadStrategy =
+                std::dynamic_pointer_cast<indexlib::file_system::MmapLoadStrategy>(loadConfig.GetLoadStrategy());
+            if (mmapLoadStrategy && mmapLoadStrategy->IsLazy()) {
+                fsOptions.lazyLoadScheduler = std::make_shared<indexlib::file_system::LazyLoadScheduler>();
+                TABLET_LOG(INFO, "load config [%s] is lazy, files will be loaded in background",
+                           loadConfig.GetName().c_str());
+                break;
+            }
+        }
+    }
+    _tabletInfos->SetLazyLoadScheduler(fsOptions.lazyLoadScheduler);
+    if (_tabletOptions->IsOnline()) {
+        for (const auto& loadConfig : fsOptions.loadConfigList.GetLoadConfigs()) {
+            if (loadConfig.GetWarmupStrategy().GetWarmupType() ==
+                indexlib::file_system::WarmupStrategy::WARMUP_RECORDED) {
+                // heat map recorded by the last open of this tablet, lives beside the local index
+                auto pageHeatRecorder = std::make_shared<indexlib::file_system::PageHeatRecorder>();
+                auto [ec, loaded] = pageHeatRecorder->Load(indexRoot.GetLocalRoot());
+                if (ec != indexlib::file_system::FSEC_OK) {
+                    TABLET_LOG(WARN, "load page heat map from [%s] failed, ec[%d], warm up nothing",
+                               indexRoot.GetLocalRoot().c_str(), ec);
+                }
+                TABLET_LOG(INFO, "load config [%s] warms up recorded ranges, heat map loaded [%d]",
+                           loadConfig.GetName().c_str(), loaded);
+                fsOptions.pageHeatRecorder = pageHeatRecorder;
+                break;
+            }
+        }
+    }
 
     std::string primaryRoot = _tabletOptions->FlushRemote() ? indexRoot.GetRemoteRoot() : indexRoot.GetLocalRoot();
     std::string fenceName = Fence::GenerateNewFenceName(_tabletOptions->FlushRemote(), _tabletInfos->GetTabletId());
@@ -1697,6 +1736,22 @@ bool Tablet::StartIntervalTask()
             return false;
         }
     }
+    auto fileSystem = _fence.GetFileSystem();
+    if (fileSystem && fileSystem->GetFileSystemOptions().pageHeatRecorder) {
+        if (!startTask(
+                TaskType::TT_RECORD_PAGE_HEAT,
+                [this, pageHeatRecorder = fileSystem->GetFileSystemOptions().pageHeatRecorder]() {
+                    pageHeatRecorder->Sample();
+                    const std::string& localRoot = _tabletInfos->GetIndexRoot().GetLocalRoot();
+                    auto ec = pageHeatRecorder->Store(localRoot);
+                    if (ec != indexlib::file_system::FSEC_OK) {
+                        TABLET_LOG(WARN, "store page heat map to [%s] failed, ec[%d]", localRoot.c_str(), ec);
+                    }
+                },
+                taskConfig.GetRecordPageHeatIntervalMs())) {
+            return false;
+        }
+    }
     // only for compute-storage separation
     if (_tabletOptions->GetNeedReadRemoteIndex() &&
         DeployIndexUtil::NeedSubscribeRemoteIndex(_tabletInfos->GetIndexRoot().GetRemoteRoot())) {
@@ -1768,6 +1823,9 @@ BuildResource Tablet::GenerateBuildResource(const std::string& counterPrefix)
     auto buildingMemLimit = _tabletOptions->GetBuildConfig().GetBuildingMemoryLimit();
     if (buildingMemLimit == -1) {
         buildingMemLimit = GetSuggestBuildingSegmentMemoryUse();
+        if (_memControlStrategy) {
+            buildingMemLimit = _memControlStrategy->GetBuildingSegmentMemoryLimit(buildingMemLimit);
+        }
         TABLET_LOG(INFO, "using suggest building segment memory [%s]",
                    autil::UnitUtil::GiBDebugString(buildingMemLimit).c_str());
     }
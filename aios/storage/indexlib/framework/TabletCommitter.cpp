@@ -24,9 +24,11 @@
 #include <utility>
 
 #include "ITabletImporter.h"
+#include "autil/EnvUtil.h"
 #include "autil/TimeUtility.h"
 #include "indexlib/config/ITabletSchema.h"
 #include "indexlib/file_system/FSResult.h"
+#include "indexlib/file_system/FileChecksumGenerator.h"
 #include "indexlib/file_system/FileSystemDefine.h"
 #include "indexlib/file_system/IFileSystem.h"
 #include "indexlib/file_system/MountOption.h"
@@ -41,6 +43,7 @@
 #include "indexlib/framework/VersionCommitter.h"
 #include "indexlib/framework/cleaner/DropIndexCleaner.h"
 #include "indexlib/framework/index_task/Constant.h"
+#include "indexlib/util/PathUtil.h"
 
 namespace indexlibv2::framework {
 AUTIL_LOG_SETUP(indexlib.framework, TabletCommitter);
@@ -54,9 +57,24 @@ TabletCommitter::TabletCommitter(const std::string& tabletName)
 {
 }
 
+TabletCommitter::~TabletCommitter()
+{
+    if (_checksumGenerator) {
+        _checksumGenerator->Stop();
+    }
+}
+
 void TabletCommitter::Init(const std::shared_ptr<VersionMerger>& versionMerger,
                            const std::shared_ptr<TabletData>& tabletData)
 {
+    if (!_checksumGenerator && autil::EnvUtil::getEnv("INDEXLIB_GENERATE_FILE_CHECKSUM", false)) {
+        auto checksumGenerator = std::make_unique<indexlib::file_system::FileChecksumGenerator>();
+        if (checksumGenerator->Start()) {
+            _checksumGenerator = std::move(checksumGenerator);
+        } else {
+            TABLET_LOG(WARN, "start file checksum generator failed, file checksums are not generated");
+        }
+    }
     _versionMerger = versionMerger;
     const auto& onDiskVersion = tabletData->GetOnDiskVersion();
     _schemaRoadMap = onDiskVersion.GetSchemaVersionRoadMap();
@@ -432,6 +450,18 @@ std::pair<Status, Version> TabletCommitter::Commit(const std::shared_ptr<TabletD
                        version.GetVersionId());
         }
     }
+    if (commitOptions.NeedPublish() && _checksumGenerator) {
+        // checksums only help deployers reuse files, they are read in background and never block the commit. The
+        // table of the previously published version, maybe in an older fence, saves reading unchanged files again.
+        const std::string fenceRoot = indexlib::util::PathUtil::JoinPath(fence.GetGlobalRoot(), fence.GetFenceName());
+        std::string lastFenceRoot;
+        if (_lastPublicVersion.GetVersionId() != INVALID_VERSIONID) {
+            lastFenceRoot =
+                indexlib::util::PathUtil::JoinPath(fence.GetGlobalRoot(), _lastPublicVersion.GetFenceName());
+        }
+        _checksumGenerator->GenerateAsync(fenceRoot, version.GetVersionId(), lastFenceRoot,
+                                          _lastPublicVersion.GetVersionId());
+    }
     _lastPublicVersion = version;
     return std::make_pair(Status::OK(), std::move(version));
 }
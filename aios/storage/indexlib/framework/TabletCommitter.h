@@ -42,6 +42,10 @@
 #include "indexlib/framework/VersionMerger.h"
 #include "indexlib/framework/index_task/MergeTaskDefine.h"
 
+namespace indexlib::file_system {
+class FileChecksumGenerator;
+}
+
 namespace indexlibv2::framework {
 
 class IdGenerator;
@@ -137,7 +141,7 @@ private:
 
 public:
     explicit TabletCommitter(const std::string& tabletName);
-    ~TabletCommitter() = default;
+    ~TabletCommitter();
     void Init(const std::shared_ptr<VersionMerger>& versionMerger, const std::shared_ptr<TabletData>& tabletData);
     bool NeedCommit() const;
     void Push(segmentid_t segId);
@@ -172,6 +176,8 @@ private:
     std::vector<schemaid_t> _schemaRoadMap;
     Status _dumpErrorStatus;
     bool _sealed;
+    // generates file checksum tables of published versions in background
+    std::unique_ptr<indexlib::file_system::FileChecksumGenerator> _checksumGenerator;
 
     AUTIL_LOG_DECLARE();
 };
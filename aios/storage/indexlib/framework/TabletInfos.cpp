@@ -104,6 +104,12 @@ std::shared_ptr<TabletMetrics> TabletInfos::GetTabletMetrics() const
     return _tabletMetrics;
 }
 
+std::shared_ptr<indexlib::file_system::LazyLoadScheduler> TabletInfos::GetLazyLoadScheduler() const
+{
+    autil::ScopedReadLock lock(_rwlock);
+    return _lazyLoadScheduler;
+}
+
 void TabletInfos::SetMemoryStatus(const MemoryStatus& memoryStatus)
 {
     autil::ScopedWriteLock lock(_rwlock);
@@ -178,6 +184,13 @@ void TabletInfos::SetTabletMetrics(const std::shared_ptr<TabletMetrics>& tabletM
     _tabletMetrics = tabletMetrics;
 }
 
+void TabletInfos::SetLazyLoadScheduler(
+    const std::shared_ptr<indexlib::file_system::LazyLoadScheduler>& lazyLoadScheduler)
+{
+    autil::ScopedWriteLock lock(_rwlock);
+    _lazyLoadScheduler = lazyLoadScheduler;
+}
+
 const char* TabletInfos::MemoryStatusToStr(MemoryStatus status)
 {
     switch (status) {
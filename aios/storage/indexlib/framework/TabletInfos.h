@@ -26,6 +26,9 @@
 #include "indexlib/framework/TabletId.h"
 #include "indexlib/framework/Version.h"
 
+namespace indexlib::file_system {
+class LazyLoadScheduler;
+} // namespace indexlib::file_system
 namespace indexlib::util {
 class CounterMap;
 class StateCounter;
@@ -64,6 +67,8 @@ public:
     std::shared_ptr<VersionDeployDescription> GetLoadedVersionDeployDescription() const;
 
     std::shared_ptr<TabletMetrics> GetTabletMetrics() const;
+    // null if no file is loaded lazily
+    std::shared_ptr<indexlib::file_system::LazyLoadScheduler> GetLazyLoadScheduler() const;
 
     void SetTabletId(const indexlib::framework::TabletId& tid);
     void SetMemoryStatus(const MemoryStatus& memoryStatus);
@@ -79,6 +84,7 @@ public:
     Status InitCounter(bool isOnline);
     void UpdateTabletDocCount(int64_t tabletdocCount);
     void SetTabletMetrics(const std::shared_ptr<TabletMetrics>& tabletMetrics);
+    void SetLazyLoadScheduler(const std::shared_ptr<indexlib::file_system::LazyLoadScheduler>& lazyLoadScheduler);
 
     static const char* MemoryStatusToStr(MemoryStatus status);
 
@@ -95,6 +101,7 @@ private:
     std::shared_ptr<indexlib::util::CounterMap> _counterMap;
     std::shared_ptr<indexlib::util::StateCounter> _tabletDocCounter;
     std::shared_ptr<TabletMetrics> _tabletMetrics;
+    std::shared_ptr<indexlib::file_system::LazyLoadScheduler> _lazyLoadScheduler;
     std::shared_ptr<indexlibv2::framework::VersionDeployDescription> _loadedVersionDpDesc;
 
     mutable autil::ReadWriteLock _rwlock;
@@ -122,6 +122,12 @@ size_t TabletMemoryCalculator::GetBuildingSegmentMemsize() const
     std::lock_guard<std::mutex> guard(_mutex);
     return _tabletWriter != nullptr ? _tabletWriter->GetTotalMemSize() : 0;
 }
+// memory built by tablet readers at open besides segments, e.g. merged term dictionaries
+size_t TabletMemoryCalculator::GetTabletReadersMemsize() const
+{
+    return _tabletReaderContainer->EvaluateTabletReadersMemUsed();
+}
+
 size_t TabletMemoryCalculator::GetBuildingSegmentDumpExpandMemsize() const
 {
     std::lock_guard<std::mutex> guard(_mutex);
@@ -41,6 +41,7 @@ public:
     size_t GetBuildingSegmentMemsize() const;
     size_t GetDumpingSegmentMemsize() const;
     size_t GetBuildingSegmentDumpExpandMemsize() const;
+    size_t GetTabletReadersMemsize() const;
 
 private:
     mutable std::mutex _mutex;
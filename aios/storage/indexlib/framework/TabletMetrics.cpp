@@ -24,6 +24,7 @@
 #include "indexlib/base/Constant.h"
 #include "indexlib/file_system/IFileSystem.h"
 #include "indexlib/file_system/LogicalFileSystem.h"
+#include "indexlib/file_system/file/LazyLoadScheduler.h"
 #include "indexlib/framework/Version.h"
 #include "indexlib/framework/VersionMerger.h"
 #include "kmonitor/client/MetricType.h"
@@ -67,11 +68,16 @@ void TabletMetrics::RegisterOnlineMetrics()
     REGISTER_TABLET_ONLINE_METRIC(totalMemoryQuotaLimit, kmonitor::GAUGE);
     REGISTER_TABLET_ONLINE_METRIC(freeMemoryQuota, kmonitor::GAUGE);
     REGISTER_TABLET_ONLINE_METRIC(memoryStatus, kmonitor::GAUGE);
+    REGISTER_TABLET_ONLINE_METRIC(buildingSegmentMemoryLimit, kmonitor::GAUGE);
+    REGISTER_TABLET_ONLINE_METRIC(realtimeWriteRate, kmonitor::GAUGE);
+    REGISTER_TABLET_ONLINE_METRIC(estimateDumpInterval, kmonitor::GAUGE);
     REGISTER_TABLET_ONLINE_METRIC(dumpingSegmentCount, kmonitor::GAUGE);
     REGISTER_TABLET_ONLINE_METRIC(tabletPhase, kmonitor::GAUGE);
     REGISTER_TABLET_ONLINE_METRIC(partitionReaderVersionCount, kmonitor::GAUGE);
     REGISTER_TABLET_ONLINE_METRIC(latestReaderVersionId, kmonitor::GAUGE);
     REGISTER_TABLET_ONLINE_METRIC(oldestReaderVersionId, kmonitor::GAUGE);
+    REGISTER_TABLET_ONLINE_METRIC(lazyLoadPendingBytes, kmonitor::GAUGE);
+    REGISTER_TABLET_ONLINE_METRIC(lazyLoadPendingFileCount, kmonitor::GAUGE);
 
 #undef REGISTER_TABLET_ONLINE_METRIC
 }
@@ -129,6 +135,9 @@ void TabletMetrics::ReportReOpenMetrics()
 void TabletMetrics::ReportOnlineMetrics()
 {
     INDEXLIB_FM_REPORT_METRIC(memoryStatus);
+    INDEXLIB_FM_REPORT_METRIC(buildingSegmentMemoryLimit);
+    INDEXLIB_FM_REPORT_METRIC(realtimeWriteRate);
+    INDEXLIB_FM_REPORT_METRIC(estimateDumpInterval);
     INDEXLIB_FM_REPORT_METRIC(tabletPhase);
     INDEXLIB_FM_REPORT_METRIC(dumpingSegmentCount);
     INDEXLIB_FM_REPORT_METRIC(partitionIndexSize);
@@ -147,6 +156,8 @@ void TabletMetrics::ReportOnlineMetrics()
     INDEXLIB_FM_REPORT_METRIC(partitionReaderVersionCount);
     INDEXLIB_FM_REPORT_METRIC(latestReaderVersionId);
     INDEXLIB_FM_REPORT_METRIC(oldestReaderVersionId);
+    INDEXLIB_FM_REPORT_METRIC(lazyLoadPendingBytes);
+    INDEXLIB_FM_REPORT_METRIC(lazyLoadPendingFileCount);
 }
 
 void TabletMetrics::ReportMetrics()
@@ -178,9 +189,13 @@ void TabletMetrics::FillMetricsInfo(std::map<std::string, std::string>& infoMap)
     infoMap["builtRtIndexMemoryUse"] = autil::StringUtil::toString(_builtRtIndexMemoryUse);
     infoMap["buildingSegmentMemoryUse"] = autil::StringUtil::toString(_buildingSegmentMemoryUse);
     infoMap["partitionMemoryQuotaUse"] = autil::StringUtil::toString(_partitionMemoryQuotaUse);
+    infoMap["buildingSegmentMemoryLimit"] = autil::StringUtil::toString(_buildingSegmentMemoryLimit);
+    infoMap["realtimeWriteRate"] = autil::StringUtil::toString(_realtimeWriteRate);
+    infoMap["estimateDumpInterval"] = autil::StringUtil::toString(_estimateDumpInterval);
     infoMap["partitionReaderVersionCount"] = autil::StringUtil::toString(_partitionReaderVersionCount);
     infoMap["latestReaderVersionId"] = autil::StringUtil::toString(_latestReaderVersionId);
     infoMap["oldestReaderVersionId"] = autil::StringUtil::toString(_oldestReaderVersionId);
+    infoMap["lazyLoadPendingBytes"] = autil::StringUtil::toString(_lazyLoadPendingBytes);
     infoMap["incVersionFreshness"] = autil::StringUtil::toString(_incVersionFreshness);
     infoMap["incVersionLatestTaskFreshness"] = autil::StringUtil::toString(_incVersionLatestTaskFreshness);
     if (_faultManager) {
@@ -238,14 +253,15 @@ void TabletMetrics::UpdateMetrics(const std::shared_ptr<TabletReaderContainer>&
     SetbuiltRtIndexMemoryUseValue(builtRtIndexMemoryUse);
     size_t incIndexMemoryUse = _tabletMemoryCalculator->GetIncIndexMemsize();
     SetincIndexMemoryUseValue(incIndexMemoryUse);
+    size_t tabletReadersMemoryUse = _tabletMemoryCalculator->GetTabletReadersMemsize();
     // TODO(xinfei.sxf) refactor "index size" to "memory size"
     // built segment: incBuilt + rtBuilt
     const size_t incIndexSize = GetIncIndexSize(tabletData, fileSystem);
     SetpartitionIndexSizeValue(incIndexSize + builtRtIndexMemoryUse);
     // rt index: rtBuilt + dumping + building
     SetrtIndexMemoryUseValue(rtIndexMemoryUse);
-    // incBuilt + rtBuilt + dumping + building
-    SetpartitionMemoryUseValue(incIndexMemoryUse + rtIndexMemoryUse);
+    // incBuilt + rtBuilt + dumping + building + readers
+    SetpartitionMemoryUseValue(incIndexMemoryUse + rtIndexMemoryUse + tabletReadersMemoryUse);
 
     // ====> from controller view
     double rtIndexMemoryRatio = (double)rtIndexMemoryUse / maxRtMemsize;
@@ -273,6 +289,12 @@ void TabletMetrics::UpdateMetrics(const std::shared_ptr<TabletReaderContainer>&
     SetoldestReaderVersionIdValue(tabletReaderContainer->GetOldestIncVersionId());
     SetlatestReaderVersionIdValue(tabletReaderContainer->GetLatestIncVersionId());
 
+    if (fileSystem && fileSystem->GetFileSystemOptions().lazyLoadScheduler) {
+        const auto& lazyLoadScheduler = fileSystem->GetFileSystemOptions().lazyLoadScheduler;
+        SetlazyLoadPendingBytesValue(lazyLoadScheduler->GetPendingBytes());
+        SetlazyLoadPendingFileCountValue(lazyLoadScheduler->GetPendingFileCount());
+    }
+
     int64_t latestIncVersionTs = tabletReaderContainer->GetLatestIncVersionTimestamp();
     int64_t currentTs = autil::TimeUtility::currentTime();
     if (latestIncVersionTs != INVALID_TIMESTAMP && currentTs > latestIncVersionTs) {
@@ -290,7 +312,8 @@ size_t TabletMetrics::GetTabletMemoryUse() const
     if (_tabletMemoryCalculator == nullptr) {
         return 0;
     }
-    return _tabletMemoryCalculator->GetIncIndexMemsize() + _tabletMemoryCalculator->GetRtIndexMemsize();
+    return _tabletMemoryCalculator->GetIncIndexMemsize() + _tabletMemoryCalculator->GetRtIndexMemsize() +
+           _tabletMemoryCalculator->GetTabletReadersMemsize();
 }
 
 size_t TabletMetrics::GetRtIndexMemSize() const
@@ -337,6 +360,14 @@ void TabletMetrics::SetMemoryStatus(MemoryStatus memoryStatus)
     SetmemoryStatusValue((int64_t)memoryStatus);
 }
 
+void TabletMetrics::SetMemTableControlMetrics(int64_t buildingMemLimit, int64_t writeRate, int64_t dumpInterval)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    SetbuildingSegmentMemoryLimitValue(buildingMemLimit);
+    SetrealtimeWriteRateValue(writeRate);
+    SetestimateDumpIntervalValue(dumpInterval);
+}
+
 void TabletMetrics::AddTabletFault(const std::string& fault)
 {
     std::lock_guard<std::mutex> guard(_mutex);
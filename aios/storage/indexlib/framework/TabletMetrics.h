@@ -78,6 +78,7 @@ public:
     size_t GetBuildingSegmentDumpExpandMemsize() const;
     size_t GetMaxDumpingSegmentExpandMemsize() const;
     void SetMemoryStatus(MemoryStatus memoryStatus);
+    void SetMemTableControlMetrics(int64_t buildingMemLimit, int64_t writeRate, int64_t dumpInterval);
 
     void FillMetricsInfo(std::map<std::string, std::string>& infoMap);
 
@@ -125,6 +126,11 @@ private:
     INDEXLIB_FM_DECLARE_NORMAL_METRIC(int64_t, freeMemoryQuota);             // free from controller
     INDEXLIB_FM_DECLARE_NORMAL_METRIC(double, freeMemoryQuotaRatio);         // free / total
 
+    // memtable control
+    INDEXLIB_FM_DECLARE_NORMAL_METRIC(int64_t, buildingSegmentMemoryLimit);
+    INDEXLIB_FM_DECLARE_NORMAL_METRIC(int64_t, realtimeWriteRate);        // bytes per second
+    INDEXLIB_FM_DECLARE_NORMAL_METRIC(int64_t, estimateDumpInterval);     // seconds
+
     // reopen
     INDEXLIB_FM_DECLARE_METRIC(preloadLatency);
     INDEXLIB_FM_DECLARE_METRIC(finalLoadLatency);
@@ -143,6 +149,8 @@ private:
     INDEXLIB_FM_DECLARE_NORMAL_METRIC(int64_t, incVersionLatestTaskFreshness);
     INDEXLIB_FM_DECLARE_NORMAL_METRIC(int32_t, latestReaderVersionId);
     INDEXLIB_FM_DECLARE_NORMAL_METRIC(int32_t, oldestReaderVersionId);
+    INDEXLIB_FM_DECLARE_NORMAL_METRIC(int64_t, lazyLoadPendingBytes);     // lazy mmap files not loaded yet
+    INDEXLIB_FM_DECLARE_NORMAL_METRIC(int64_t, lazyLoadPendingFileCount);
 
 private:
     AUTIL_LOG_DECLARE();
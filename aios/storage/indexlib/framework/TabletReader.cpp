@@ -18,17 +18,23 @@
 #include <stddef.h>
 #include <typeinfo>
 
+#include "indexlib/config/ITabletSchema.h"
 #include "indexlib/framework/mem_reclaimer/IIndexMemoryReclaimer.h"
 
 namespace indexlibv2::framework {
 AUTIL_LOG_SETUP(indexlib.framework, TabletReader);
 
-TabletReader::TabletReader(const std::shared_ptr<config::ITabletSchema>& schema) : _schema(schema) {}
+TabletReader::TabletReader(const std::shared_ptr<config::ITabletSchema>& schema)
+    : _schema(schema)
+    , _segmentReaderCache(std::make_shared<SegmentReaderCache>())
+{
+}
 TabletReader::~TabletReader()
 {
+    std::lock_guard<std::mutex> guard(_sharedIndexReaderMutex);
     for (auto iter = _indexReaderMap.begin(); iter != _indexReaderMap.end(); iter++) {
         size_t useCount = iter->second.use_count();
-        if (useCount > 1) {
+        if (useCount > 1 && _sharedIndexReaderKeys.count(iter->first) == 0) {
             AUTIL_LOG(WARN, "unreleased index reader, indexName[%s] indexType[%s] use count [%ld]",
                       iter->first.second.c_str(), iter->first.first.c_str(), useCount);
         }
@@ -38,9 +44,82 @@ TabletReader::~TabletReader()
 Status TabletReader::Open(const std::shared_ptr<TabletData>& tabletData, const ReadResource& readResource)
 {
     _indexMemoryReclaimer = readResource.indexMemoryReclaimer;
+    InitSegmentSignature(tabletData);
+    InitSegmentReaderCache(tabletData, readResource);
     return DoOpen(tabletData, readResource);
 }
 
+void TabletReader::InitSegmentReaderCache(const std::shared_ptr<TabletData>& tabletData,
+                                          const ReadResource& readResource)
+{
+    auto lastTabletReader = std::dynamic_pointer_cast<TabletReader>(readResource.lastTabletReader);
+    if (!tabletData || !lastTabletReader || lastTabletReader.get() == this) {
+        return;
+    }
+    if (!_schema || !lastTabletReader->_schema || _schema->GetSchemaId() != lastTabletReader->_schema->GetSchemaId()) {
+        return;
+    }
+    _segmentReaderCache->Inherit(*lastTabletReader->_segmentReaderCache, *tabletData);
+}
+
+void TabletReader::InitSegmentSignature(const std::shared_ptr<TabletData>& tabletData)
+{
+    _builtSegments.clear();
+    _readSchemaId = INVALID_SCHEMAID;
+    if (!tabletData || !_schema) {
+        return;
+    }
+    auto readSchema = tabletData->GetOnDiskVersionReadSchema();
+    if (!readSchema) {
+        return;
+    }
+    auto slice = tabletData->CreateSlice();
+    for (auto iter = slice.begin(); iter != slice.end(); iter++) {
+        if ((*iter)->GetSegmentStatus() != Segment::SegmentStatus::ST_BUILT) {
+            _builtSegments.clear();
+            return;
+        }
+        _builtSegments.push_back(*iter);
+    }
+    _readSchemaId = readSchema->GetSchemaId();
+}
+
+bool TabletReader::HasSameSegmentSignature(const TabletReader& other) const
+{
+    if (_builtSegments.empty() || _readSchemaId == INVALID_SCHEMAID) {
+        return false;
+    }
+    if (_readSchemaId != other._readSchemaId || _schema->GetSchemaId() != other._schema->GetSchemaId()) {
+        return false;
+    }
+    // segments are shared across tablet data generations, same objects means nothing changed in between
+    return _builtSegments == other._builtSegments;
+}
+
+void TabletReader::MarkIndexReaderShared(const IndexReaderMapKey& key) const
+{
+    std::lock_guard<std::mutex> guard(_sharedIndexReaderMutex);
+    _sharedIndexReaderKeys.insert(key);
+}
+
+std::shared_ptr<index::IIndexReader> TabletReader::InheritIndexReader(const ReadResource& readResource,
+                                                                      const std::string& indexType,
+                                                                      const std::string& indexName) const
+{
+    auto lastTabletReader = std::dynamic_pointer_cast<TabletReader>(readResource.lastTabletReader);
+    if (!lastTabletReader || lastTabletReader.get() == this || !HasSameSegmentSignature(*lastTabletReader)) {
+        return nullptr;
+    }
+    auto key = std::make_pair(indexType, indexName);
+    auto indexReader = lastTabletReader->GetIndexReader(indexType, indexName);
+    if (!indexReader) {
+        return nullptr;
+    }
+    MarkIndexReaderShared(key);
+    lastTabletReader->MarkIndexReaderShared(key);
+    return indexReader;
+}
+
 Status TabletReader::Search(const std::string& jsonQuery, std::string& result) const
 {
     return Status::Unimplement("search query [%s] fail.\n"
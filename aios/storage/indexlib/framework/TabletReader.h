@@ -17,13 +17,18 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "autil/Log.h"
+#include "indexlib/base/Constant.h"
 #include "indexlib/base/Status.h"
 #include "indexlib/framework/ITabletReader.h"
 #include "indexlib/framework/ReadResource.h"
+#include "indexlib/framework/SegmentReaderCache.h"
 #include "indexlib/framework/TabletData.h"
 
 namespace indexlibv2::framework {
@@ -48,6 +53,15 @@ public:
 protected:
     virtual Status DoOpen(const std::shared_ptr<TabletData>& tabletData, const ReadResource& readResource) = 0;
 
+    // Return the index reader opened by readResource.lastTabletReader if both readers are opened on the same
+    // built segments with the same schema, nullptr otherwise. Only call it for index readers that are not
+    // modified after open and do not depend on anything but the segments.
+    std::shared_ptr<index::IIndexReader> InheritIndexReader(const ReadResource& readResource,
+                                                            const std::string& indexType,
+                                                            const std::string& indexName) const;
+    // per-segment indexers inherited from readResource.lastTabletReader, index readers reuse them on partial changes
+    const std::shared_ptr<SegmentReaderCache>& GetSegmentReaderCache() const { return _segmentReaderCache; }
+
 protected:
     using IndexReaderMapKey = std::pair<std::string, std::string>;
 
@@ -55,6 +69,20 @@ protected:
     std::map<IndexReaderMapKey, std::shared_ptr<index::IIndexReader>> _indexReaderMap;
     std::shared_ptr<IIndexMemoryReclaimer> _indexMemoryReclaimer;
 
+private:
+    void InitSegmentSignature(const std::shared_ptr<TabletData>& tabletData);
+    void InitSegmentReaderCache(const std::shared_ptr<TabletData>& tabletData, const ReadResource& readResource);
+    bool HasSameSegmentSignature(const TabletReader& other) const;
+    void MarkIndexReaderShared(const IndexReaderMapKey& key) const;
+
+private:
+    // empty if any segment is not built, building segments change after open
+    std::vector<std::shared_ptr<Segment>> _builtSegments;
+    schemaid_t _readSchemaId = INVALID_SCHEMAID;
+    mutable std::mutex _sharedIndexReaderMutex;
+    mutable std::set<IndexReaderMapKey> _sharedIndexReaderKeys;
+    std::shared_ptr<SegmentReaderCache> _segmentReaderCache;
+
 private:
     AUTIL_LOG_DECLARE();
 };
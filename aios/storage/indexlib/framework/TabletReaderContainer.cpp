@@ -208,6 +208,18 @@ std::vector<std::shared_ptr<TabletData>> TabletReaderContainer::GetTabletDatas()
     return tabletDatas;
 }
 
+size_t TabletReaderContainer::EvaluateTabletReadersMemUsed() const
+{
+    size_t memUsed = 0;
+    std::lock_guard<std::mutex> guard(_mutex);
+    for (const auto& [_, tabletReader, __] : _tabletReaderVec) {
+        if (tabletReader) {
+            memUsed += tabletReader->EvaluateCurrentMemUsed();
+        }
+    }
+    return memUsed;
+}
+
 bool TabletReaderContainer::GetNeedKeepFiles(std::set<std::string>* keepFiles)
 {
     std::lock_guard<std::mutex> guard(_mutex);
@@ -61,6 +61,8 @@ public:
     int64_t GetLatestIncVersionTimestamp() const;
     int64_t GetLatestIncVersionTaskLogTimestamp() const;
     std::vector<std::shared_ptr<TabletData>> GetTabletDatas() const;
+    // memory the readers allocated themselves, excluding segments
+    size_t EvaluateTabletReadersMemUsed() const;
     bool GetNeedKeepFiles(std::set<std::string>* keepFiles);
     void GetNeedKeepSegments(std::set<segmentid_t>* keepSegments);
     versionid_t GetLatestPrivateVersion() const;
@@ -44,6 +44,8 @@ const char* TaskTypeToString(TaskType type)
         return "MEMORY_RECLAIM";
     case TaskType::TT_MERGE_VERSION:
         return "MERGE_VERSION";
+    case TaskType::TT_RECORD_PAGE_HEAT:
+        return "RECORD_PAGE_HEAT";
     case TaskType::TT_UNKOWN:
         return "UNKOWN";
 
@@ -31,6 +31,7 @@ enum class TaskType {
     TT_MEMORY_RECLAIM,
     TT_MERGE_VERSION,
     TT_SUBSCRIBE_REMOTE_INDEX,
+    TT_RECORD_PAGE_HEAT,
     TT_UNKOWN = 255
 };
 
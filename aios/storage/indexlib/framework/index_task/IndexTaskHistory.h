@@ -75,6 +75,7 @@ public:
 
     const std::string& GetTaskId() const { return _taskId; }
     versionid_t GetBaseVersion() const { return _baseVersion; }
+    versionid_t GetTargetVersion() const { return _targetVersion; }
     int64_t GetTriggerTimestampInSecond() const { return _triggerTimestampInSec; }
     const std::map<std::string, std::string>& GetTaskDescription() const { return _taskDescription; }
     void AddTaskDescItem(const std::string& key, const std::string& value) { _taskDescription[key] = value; }
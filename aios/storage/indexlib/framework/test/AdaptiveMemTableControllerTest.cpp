@@ -0,0 +1,117 @@
+#include "indexlib/framework/AdaptiveMemTableController.h"
+
+#include "unittest/unittest.h"
+
+namespace indexlibv2::framework {
+
+class AdaptiveMemTableControllerTest : public TESTBASE
+{
+public:
+    AdaptiveMemTableControllerTest() = default;
+    ~AdaptiveMemTableControllerTest() = default;
+
+    void setUp() override {}
+    void tearDown() override {}
+
+protected:
+    static constexpr int64_t MB = 1024 * 1024;
+    static constexpr int64_t SECOND = 1000 * 1000;
+
+    AdaptiveMemTableController::Sample MakeSample(int64_t ts, int64_t building, int64_t dumping) const
+    {
+        AdaptiveMemTableController::Sample sample;
+        sample.timestampUs = ts;
+        sample.buildingMemUse = building;
+        sample.dumpingMemUse = dumping;
+        sample.builtRtMemUse = 0;
+        sample.rtMemQuota = 1000 * MB;
+        sample.totalFreeQuota = 10000 * MB;
+        sample.buildFreeQuota = 10000 * MB;
+        sample.dumpExpandMemUse = 0;
+        return sample;
+    }
+};
+
+TEST_F(AdaptiveMemTableControllerTest, testDefaultLimit)
+{
+    AdaptiveMemTableController controller;
+    ASSERT_EQ(123, controller.GetBuildingSegmentMemoryLimit(123));
+    ASSERT_EQ(0, controller.GetWriteRate());
+    ASSERT_EQ(-1, controller.GetDumpLatency());
+    ASSERT_EQ(-1, controller.GetDumpInterval());
+}
+
+TEST_F(AdaptiveMemTableControllerTest, testHalfBudgetWithoutDumpHistory)
+{
+    AdaptiveMemTableController controller;
+    controller.Update(MakeSample(0, 0, 0));
+    // budget = 1000MB * 0.9, keep half for the dumping segment
+    ASSERT_EQ(450 * MB, controller.GetBuildingSegmentMemoryLimit(123));
+
+    auto sample = MakeSample(SECOND, 100 * MB, 0);
+    sample.builtRtMemUse = 200 * MB;
+    controller.Update(sample);
+    ASSERT_EQ(360 * MB, controller.GetBuildingSegmentMemoryLimit(123));
+    ASSERT_EQ(30 * MB, controller.GetWriteRate());
+    ASSERT_EQ(12, controller.GetDumpInterval());
+}
+
+TEST_F(AdaptiveMemTableControllerTest, testGrowWithFastDump)
+{
+    AdaptiveMemTableController controller;
+    controller.Update(MakeSample(0, 0, 0));
+    controller.Update(MakeSample(SECOND, 10 * MB, 0));
+    // segment switched, previous one is dumping
+    controller.Update(MakeSample(2 * SECOND, 10 * MB, 10 * MB));
+    ASSERT_EQ(-1, controller.GetDumpLatency());
+    controller.Update(MakeSample(3 * SECOND, 20 * MB, 0));
+    ASSERT_EQ(SECOND, controller.GetDumpLatency());
+    int64_t limit = controller.GetBuildingSegmentMemoryLimit(123);
+    // only about one second of writes overlaps the dump
+    ASSERT_GT(limit, 850 * MB);
+    ASSERT_LT(limit, 900 * MB);
+}
+
+TEST_F(AdaptiveMemTableControllerTest, testPreallocatedKeepHalfBudget)
+{
+    AdaptiveMemTableController controller(/*preallocated=*/true);
+    controller.Update(MakeSample(0, 450 * MB, 0));
+    // segment switched, the new segment allocates its whole memtable at open
+    controller.Update(MakeSample(SECOND, 450 * MB, 450 * MB));
+    controller.Update(MakeSample(2 * SECOND, 450 * MB, 0));
+    ASSERT_EQ(SECOND, controller.GetDumpLatency());
+    // building and dumping segment both hold the full limit during dump
+    ASSERT_EQ(450 * MB, controller.GetBuildingSegmentMemoryLimit(123));
+    // preallocation is not counted as writes
+    ASSERT_EQ(0, controller.GetWriteRate());
+    ASSERT_EQ(-1, controller.GetDumpInterval());
+}
+
+TEST_F(AdaptiveMemTableControllerTest, testShrinkWithSlowDump)
+{
+    AdaptiveMemTableController controller;
+    controller.Update(MakeSample(0, 0, 0));
+    controller.Update(MakeSample(SECOND, 100 * MB, 0));
+    controller.Update(MakeSample(2 * SECOND, 100 * MB, 100 * MB));
+    controller.Update(MakeSample(100 * SECOND, 100 * MB, 0));
+    // overlap exceeds half of budget, fall back to double buffering
+    ASSERT_EQ(450 * MB, controller.GetBuildingSegmentMemoryLimit(123));
+}
+
+TEST_F(AdaptiveMemTableControllerTest, testLimitedByFreeQuota)
+{
+    AdaptiveMemTableController controller;
+    auto sample = MakeSample(0, 100 * MB, 100 * MB);
+    sample.totalFreeQuota = 300 * MB;
+    sample.dumpExpandMemUse = 100 * MB;
+    controller.Update(sample);
+    // (300 + 200 - 100) * 0.9 / 2
+    ASSERT_EQ(180 * MB, controller.GetBuildingSegmentMemoryLimit(123));
+
+    sample.timestampUs = SECOND;
+    sample.buildFreeQuota = -300 * MB;
+    controller.Update(sample);
+    ASSERT_EQ(AdaptiveMemTableController::MIN_BUILDING_MEM_LIMIT, controller.GetBuildingSegmentMemoryLimit(123));
+}
+
+} // namespace indexlibv2::framework
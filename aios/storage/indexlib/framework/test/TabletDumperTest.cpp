@@ -37,6 +37,28 @@ auto createSegmentDumpItem(bool success)
     return dumpItem;
 }
 
+class SizedSegmentDumpItem : public SegmentDumpItem
+{
+public:
+    SizedSegmentDumpItem(int64_t memUse, std::vector<int64_t>* dumpOrder) : _memUse(memUse), _dumpOrder(dumpOrder)
+    {
+    }
+
+    Status Dump() noexcept override
+    {
+        _dumpOrder->push_back(_memUse);
+        _dumped = true;
+        return Status::OK();
+    }
+    bool IsDumped() const override { return _dumped; }
+    int64_t EstimateMemUse() const override { return _memUse; }
+
+private:
+    int64_t _memUse;
+    std::vector<int64_t>* _dumpOrder;
+    bool _dumped = false;
+};
+
 auto createSegmentDumper(segmentid_t segmentId, const std::vector<std::shared_ptr<SegmentDumpItem>>& segmentDumpItems)
 {
     SegmentMeta segmentMeta(segmentId);
@@ -190,4 +212,22 @@ TEST_F(TabletDumperTest, testEstimate)
     ASSERT_EQ(200, tabletDumper->GetMaxDumpingSegmentExpandMemsize());
     ASSERT_EQ(1024 * 3, tabletDumper->GetTotalDumpingSegmentsMemsize());
 }
+
+TEST_F(TabletDumperTest, testDumpLargestItemFirst)
+{
+    std::vector<int64_t> dumpOrder;
+    std::vector<std::shared_ptr<SegmentDumpItem>> dumpItems;
+    for (int64_t memUse : {10, 0, 300, 20, 300}) {
+        dumpItems.push_back(std::make_shared<SizedSegmentDumpItem>(memUse, &dumpOrder));
+    }
+    auto segmentDumper = createSegmentDumper(510234, dumpItems);
+    auto tabletCommitter = std::make_shared<TabletCommitter>(std::string("test_dumper"));
+    auto tabletDumper =
+        std::make_shared<TabletDumper>(std::string("test_dumper"), _executor.get(), tabletCommitter.get());
+    tabletDumper->Init(/*dumperInterval=*/1);
+    tabletDumper->PushSegmentDumper(std::move(segmentDumper));
+    ASSERT_TRUE(tabletDumper->Dump(/*dumpThreadCount=*/1).IsOK());
+    std::vector<int64_t> expectOrder = {300, 300, 20, 10, 0};
+    ASSERT_EQ(expectOrder, dumpOrder);
+}
 } // namespace indexlibv2::framework
@@ -0,0 +1,157 @@
+#include "indexlib/framework/TabletReader.h"
+
+#include "indexlib/config/TabletSchema.h"
+#include "indexlib/framework/DiskSegment.h"
+#include "indexlib/framework/ResourceMap.h"
+#include "indexlib/framework/TabletDataSchemaGroup.h"
+#include "indexlib/index/IIndexReader.h"
+#include "indexlib/index/IIndexer.h"
+#include "unittest/unittest.h"
+
+namespace indexlibv2::framework {
+
+class TabletReaderTest : public TESTBASE
+{
+};
+
+namespace {
+
+class TestSegment : public DiskSegment
+{
+public:
+    TestSegment(segmentid_t segId) : DiskSegment(SegmentMeta(segId)) {}
+    size_t EvaluateCurrentMemUsed() override { return 0; }
+    std::pair<Status, size_t> EstimateMemUsed(const std::shared_ptr<config::ITabletSchema>& schema) override
+    {
+        return {Status::OK(), 0};
+    }
+
+private:
+    Status Open(const std::shared_ptr<MemoryQuotaController>& memoryQuotaController,
+                framework::DiskSegment::OpenMode mode) override
+    {
+        return Status::OK();
+    }
+    Status Reopen(const std::vector<std::shared_ptr<config::ITabletSchema>>& schema) override { return Status::OK(); }
+};
+
+class TestIndexReader : public index::IIndexReader
+{
+public:
+    Status Open(const std::shared_ptr<config::IIndexConfig>& indexConfig,
+                const framework::TabletData* tabletData) override
+    {
+        return Status::OK();
+    }
+};
+
+class TestIndexer : public index::IIndexer
+{
+};
+
+class TestTabletReader : public TabletReader
+{
+public:
+    TestTabletReader(const std::shared_ptr<config::ITabletSchema>& schema) : TabletReader(schema) {}
+
+    Status DoOpen(const std::shared_ptr<TabletData>& tabletData, const ReadResource& readResource) override
+    {
+        auto indexReader = InheritIndexReader(readResource, "attribute", "price");
+        if (indexReader) {
+            inherited = true;
+        } else {
+            indexReader = std::make_shared<TestIndexReader>();
+        }
+        _indexReaderMap[std::make_pair("attribute", "price")] = indexReader;
+
+        // open one indexer per segment, like pk load plans
+        const auto& segmentReaderCache = GetSegmentReaderCache();
+        auto slice = tabletData->CreateSlice();
+        for (auto iter = slice.begin(); iter != slice.end(); iter++) {
+            SegmentReaderCache::Segments segments = {iter->get()};
+            auto indexer = segmentReaderCache->Get<TestIndexer>("primarykey", "pk", segments);
+            if (!indexer) {
+                indexer = std::make_shared<TestIndexer>();
+                segmentReaderCache->Put("primarykey", "pk", segments, indexer);
+                ++openedIndexerCount;
+            }
+            indexers[(*iter)->GetSegmentId()] = indexer;
+        }
+        return Status::OK();
+    }
+
+    bool inherited = false;
+    size_t openedIndexerCount = 0;
+    std::map<segmentid_t, std::shared_ptr<TestIndexer>> indexers;
+};
+
+std::shared_ptr<TabletData> CreateTabletData(const std::shared_ptr<config::ITabletSchema>& schema,
+                                             const std::vector<std::shared_ptr<Segment>>& segments)
+{
+    auto resourceMap = std::make_shared<ResourceMap>();
+    auto schemaGroup = std::make_shared<TabletDataSchemaGroup>();
+    schemaGroup->onDiskReadSchema = schema;
+    schemaGroup->onDiskWriteSchema = schema;
+    schemaGroup->writeSchema = schema;
+    EXPECT_TRUE(resourceMap->AddVersionResource(TabletDataSchemaGroup::NAME, schemaGroup).IsOK());
+    Version version;
+    for (const auto& segment : segments) {
+        version.AddSegment(segment->GetSegmentId());
+    }
+    auto tabletData = std::make_shared<TabletData>("ut");
+    EXPECT_TRUE(tabletData->Init(std::move(version), segments, resourceMap).IsOK());
+    return tabletData;
+}
+
+} // namespace
+
+TEST_F(TabletReaderTest, testInheritReaders)
+{
+    auto schema = std::make_shared<config::TabletSchema>();
+    std::vector<std::shared_ptr<Segment>> segments = {std::make_shared<TestSegment>(0),
+                                                      std::make_shared<TestSegment>(1)};
+    auto firstReader = std::make_shared<TestTabletReader>(schema);
+    ASSERT_TRUE(firstReader->Open(CreateTabletData(schema, segments), ReadResource()).IsOK());
+    ASSERT_FALSE(firstReader->inherited);
+    ASSERT_EQ(2, firstReader->openedIndexerCount);
+
+    // same segments, index reader is shared with last reader
+    ReadResource readResource;
+    readResource.lastTabletReader = firstReader;
+    auto secondReader = std::make_shared<TestTabletReader>(schema);
+    ASSERT_TRUE(secondReader->Open(CreateTabletData(schema, segments), readResource).IsOK());
+    ASSERT_TRUE(secondReader->inherited);
+    ASSERT_EQ(firstReader->GetIndexReader("attribute", "price"), secondReader->GetIndexReader("attribute", "price"));
+    ASSERT_EQ(0, secondReader->openedIndexerCount);
+    ASSERT_EQ(firstReader->indexers, secondReader->indexers);
+
+    // a new segment is added, index reader is rebuilt and only the new segment is opened
+    segments.push_back(std::make_shared<TestSegment>(2));
+    readResource.lastTabletReader = secondReader;
+    auto thirdReader = std::make_shared<TestTabletReader>(schema);
+    ASSERT_TRUE(thirdReader->Open(CreateTabletData(schema, segments), readResource).IsOK());
+    ASSERT_FALSE(thirdReader->inherited);
+    ASSERT_EQ(1, thirdReader->openedIndexerCount);
+    ASSERT_EQ(secondReader->indexers[0], thirdReader->indexers[0]);
+    ASSERT_EQ(secondReader->indexers[1], thirdReader->indexers[1]);
+
+    // segment with same id is reloaded, only the reloaded segment is opened
+    segments[2] = std::make_shared<TestSegment>(2);
+    readResource.lastTabletReader = thirdReader;
+    auto fourthReader = std::make_shared<TestTabletReader>(schema);
+    ASSERT_TRUE(fourthReader->Open(CreateTabletData(schema, segments), readResource).IsOK());
+    ASSERT_FALSE(fourthReader->inherited);
+    ASSERT_EQ(1, fourthReader->openedIndexerCount);
+    ASSERT_NE(thirdReader->indexers[2], fourthReader->indexers[2]);
+    ASSERT_EQ(thirdReader->indexers[1], fourthReader->indexers[1]);
+
+    // segments are merged, indexers of dropped segments are not inherited
+    segments = {std::make_shared<TestSegment>(3)};
+    readResource.lastTabletReader = fourthReader;
+    auto fifthReader = std::make_shared<TestTabletReader>(schema);
+    ASSERT_TRUE(fifthReader->Open(CreateTabletData(schema, segments), readResource).IsOK());
+    ASSERT_EQ(1, fifthReader->openedIndexerCount);
+    ASSERT_EQ(1, fifthReader->GetSegmentReaderCache()->GetSize());
+}
+
+} // namespace indexlibv2::framework
@@ -1358,6 +1358,60 @@ TEST_F(TabletTest, testCheckMemoryStatus)
         tablet->_memControlStrategy.reset(new LSMMemTableControlStrategy(tabletOptions, memoryQuotaSynchronizer));
         EXPECT_EQ(MemoryStatus::OK, tablet->CheckMemoryStatus());
     }
+    {
+        // adaptive memtable keeps default quota semantics, builtRt memory is still counted
+        auto tabletData = std::make_shared<TabletData>("demo");
+        auto mockDiskSegment = std::make_unique<MockDiskSegment>(segMeta);
+        ON_CALL(*mockDiskSegment, EvaluateCurrentMemUsed).WillByDefault(Return(1024 * 1024 + 1));
+        auto segment = std::shared_ptr<Segment>(mockDiskSegment.release());
+        ASSERT_TRUE(tabletData->Init(framework::Version(), {segment}, resourceMap).IsOK());
+        auto readerContainer = std::make_shared<TabletReaderContainer>("testTableName");
+        readerContainer->AddTabletReader(tabletData, nullptr, nullptr);
+        auto tablet = std::make_unique<Tablet>(_resource);
+        tablet->_tabletMetrics =
+            std::make_shared<TabletMetrics>(nullptr, memoryQuotaController.get(), "test", tabletDumper.get(), nullptr);
+        tablet->_tabletMetrics->_tabletMemoryCalculator.reset(new TabletMemoryCalculator(nullptr, readerContainer));
+        tablet->_memControlStrategy.reset(new DefaultMemoryControlStrategy(tabletOptions, memoryQuotaSynchronizer,
+                                                                           /*enableAdaptiveMemTable=*/true));
+        EXPECT_EQ(MemoryStatus::REACH_MAX_RT_INDEX_SIZE, tablet->CheckMemoryStatus());
+    }
+}
+
+TEST_F(TabletTest, testGenerateBuildResourceWithAdaptiveMemTable)
+{
+    const int64_t maxRtMemUse = 300L * 1024 * 1024;
+    auto tabletOptions = std::make_shared<indexlibv2::config::TabletOptions>();
+    tabletOptions->SetIsOnline(true);
+    tabletOptions->TEST_GetOnlineConfig().TEST_SetMaxRealtimeMemoryUse(maxRtMemUse);
+    auto memoryQuotaController = std::make_shared<MemoryQuotaController>("test", 1024L * 1024 * 1024);
+    auto memoryQuotaSynchronizer = std::make_shared<MemoryQuotaSynchronizer>(memoryQuotaController);
+    auto tabletCommitter = std::make_unique<TabletCommitter>("test");
+    auto tabletDumper = std::make_unique<TabletDumper>("test", nullptr, tabletCommitter.get());
+
+    auto tablet = std::make_unique<Tablet>(_resource);
+    tablet->_tabletOptions = tabletOptions;
+    tablet->_tabletMetrics =
+        std::make_shared<TabletMetrics>(nullptr, memoryQuotaController.get(), "test", tabletDumper.get(), nullptr);
+    {
+        // default strategy uses the suggest building segment memory
+        tablet->_memControlStrategy.reset(new DefaultMemoryControlStrategy(tabletOptions, memoryQuotaSynchronizer));
+        tablet->_memControlStrategy->SyncMemoryQuota(tablet->_tabletMetrics);
+        EXPECT_EQ(maxRtMemUse / 3, tablet->GenerateBuildResource("test").buildingMemLimit);
+    }
+    {
+        tablet->_memControlStrategy.reset(new DefaultMemoryControlStrategy(tabletOptions, memoryQuotaSynchronizer,
+                                                                           /*enableAdaptiveMemTable=*/true));
+        // no sample yet, fall back to the suggest building segment memory
+        EXPECT_EQ(maxRtMemUse / 3, tablet->GenerateBuildResource("test").buildingMemLimit);
+        // no dump observed, building and dumping segment share the rt quota
+        tablet->_memControlStrategy->SyncMemoryQuota(tablet->_tabletMetrics);
+        EXPECT_EQ((int64_t)(maxRtMemUse * 0.9) / 2, tablet->GenerateBuildResource("test").buildingMemLimit);
+    }
+    {
+        // configured building memory limit wins
+        tabletOptions->TEST_GetOnlineConfig().TEST_GetBuildConfig().TEST_SetBuildingMemoryLimit(64L * 1024 * 1024);
+        EXPECT_EQ(64L * 1024 * 1024, tablet->GenerateBuildResource("test").buildingMemLimit);
+    }
 }
 
 } // namespace indexlibv2::framework
@@ -15,11 +15,14 @@
  */
 #pragma once
 
+#include <memory>
+
 #include "indexlib/base/Constant.h"
 #include "indexlib/config/SortDescription.h"
 
 namespace indexlibv2::framework {
 class MetricsManager;
+class SegmentReaderCache;
 }
 
 namespace indexlibv2::index {
@@ -30,6 +33,8 @@ struct IndexReaderParameter {
     schemaid_t readerSchemaId = DEFAULT_SCHEMAID;
     SortPatternFunc sortPatternFunc;
     framework::MetricsManager* metricsManager = nullptr;
+    // per-segment indexers of the last tablet reader, nullptr if not reopened by a tablet reader
+    std::shared_ptr<framework::SegmentReaderCache> segmentReaderCache;
 };
 
 } // namespace indexlibv2::index
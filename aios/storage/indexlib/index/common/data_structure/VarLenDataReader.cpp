@@ -25,6 +25,7 @@ VarLenDataReader::VarLenDataReader(const VarLenDataParam& param, bool isOnline)
     , _offlineOffsetReader(param)
     , _dataBaseAddr(nullptr)
     , _dataLength(0)
+    , _compressBlockSize(0)
     , _param(param)
     , _isOnline(isOnline)
     , _dataFileCompress(false)
@@ -63,8 +64,9 @@ Status VarLenDataReader::Init(uint32_t docCount, const std::shared_ptr<indexlib:
     }
     _dataFileReader = dataFileReader;
 
-    _dataFileCompress =
-        std::dynamic_pointer_cast<indexlib::file_system::CompressFileReader>(_dataFileReader) != nullptr;
+    auto compressFileReader = std::dynamic_pointer_cast<indexlib::file_system::CompressFileReader>(_dataFileReader);
+    _dataFileCompress = compressFileReader != nullptr;
+    _compressBlockSize = _dataFileCompress ? compressFileReader->GetMaxUnCompressBlockSize() : 0;
     _dataLength = _dataFileReader->GetLogicLength();
     _dataBaseAddr = (char*)_dataFileReader->GetBaseAddress();
     return Status::OK();
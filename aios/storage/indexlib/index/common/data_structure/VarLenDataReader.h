@@ -75,6 +75,16 @@ private:
                        indexlib::file_system::ReadOption readOption, std::vector<uint64_t>* offsets,
                        std::vector<uint32_t>* lens) const noexcept;
 
+    // [rangeEnd, itemBegin) is a gap inside one compressed block or there is no gap at all
+    inline bool CanCoalesceRead(uint64_t rangeEnd, uint64_t itemBegin) const
+    {
+        if (itemBegin <= rangeEnd) {
+            return true;
+        }
+        return _compressBlockSize > 0 && rangeEnd > 0 &&
+               itemBegin / _compressBlockSize == (rangeEnd - 1) / _compressBlockSize;
+    }
+
 private:
     autil::mem_pool::Pool _offlinePool;
     VarLenOffsetReader _offsetReader;
@@ -82,6 +92,7 @@ private:
     std::shared_ptr<indexlib::file_system::FileReader> _dataFileReader;
     char* _dataBaseAddr;
     size_t _dataLength;
+    size_t _compressBlockSize;
     VarLenDataParam _param;
     bool _isOnline;
     bool _dataFileCompress;
@@ -357,27 +368,66 @@ VarLenDataReader::GetValue(const std::vector<docid_t>& docIds, autil::mem_pool::
         AUTIL_LOG(ERROR, "read value fail, pool should not be null.");
         co_return indexlib::index::ErrorCodeVec(docIds.size(), indexlib::index::ErrorCode::Runtime);
     }
-    indexlib::file_system::BatchIO batchIO;
+    // coalesce neighboring items into one io per range, items in one compressed block are
+    // read and decompressed only once, then sliced back in request order
+    std::vector<size_t> itemIdxs;
+    itemIdxs.reserve(docIds.size());
     for (size_t i = 0; i < docIds.size(); ++i) {
         if (indexlib::index::ErrorCode::OK == offsetResult[i]) {
-            batchIO.emplace_back(pool->allocate(lens[i]), lens[i], offsets[i]);
+            itemIdxs.push_back(i);
         }
     }
-    auto dataReadResult = co_await fileStream->BatchRead(batchIO, readOption);
-    size_t resultIdx = 0;
-    for (size_t i = 0; i < docIds.size(); ++i) {
-        if (offsetResult[i] == indexlib::index::ErrorCode::OK) {
-            if (dataReadResult[resultIdx].OK()) {
-                data->push_back(autil::StringView((char*)batchIO[resultIdx].buffer, batchIO[resultIdx].len));
-            } else {
-                ret[i] = indexlib::index::ConvertFSErrorCode(dataReadResult[resultIdx].ec);
-                data->push_back(autil::StringView());
+    if (_param.dataItemUniqEncode) {
+        // uniq encoded items may share data or be out of docid order
+        std::stable_sort(itemIdxs.begin(), itemIdxs.end(),
+                         [&offsets](size_t lhs, size_t rhs) { return offsets[lhs] < offsets[rhs]; });
+    }
+    indexlib::file_system::BatchIO batchIO;
+    std::vector<size_t> itemRangeIdxs(docIds.size(), 0);
+    uint64_t rangeBegin = 0;
+    uint64_t rangeEnd = 0;
+    for (size_t k = 0; k < itemIdxs.size(); ++k) {
+        size_t i = itemIdxs[k];
+        uint64_t itemBegin = offsets[i];
+        uint64_t itemEnd = itemBegin + lens[i];
+        if (k == 0 || !CanCoalesceRead(rangeEnd, itemBegin)) {
+            if (k != 0) {
+                batchIO.emplace_back(pool->allocate(rangeEnd - rangeBegin), rangeEnd - rangeBegin, rangeBegin);
             }
-            resultIdx++;
+            rangeBegin = itemBegin;
+            rangeEnd = itemEnd;
         } else {
+            rangeEnd = std::max(rangeEnd, itemEnd);
+        }
+        itemRangeIdxs[i] = batchIO.size();
+    }
+    if (!itemIdxs.empty()) {
+        batchIO.emplace_back(pool->allocate(rangeEnd - rangeBegin), rangeEnd - rangeBegin, rangeBegin);
+    }
+    auto dataReadResult = co_await fileStream->BatchRead(batchIO, readOption);
+    assert(dataReadResult.size() == batchIO.size());
+    for (size_t i = 0; i < docIds.size(); ++i) {
+        if (offsetResult[i] != indexlib::index::ErrorCode::OK) {
             ret[i] = offsetResult[i];
             data->push_back(autil::StringView());
+            continue;
+        }
+        size_t rangeIdx = itemRangeIdxs[i];
+        const auto& rangeIO = batchIO[rangeIdx];
+        if (!dataReadResult[rangeIdx].OK()) {
+            ret[i] = indexlib::index::ConvertFSErrorCode(dataReadResult[rangeIdx].ec);
+            data->push_back(autil::StringView());
+            continue;
+        }
+        if (dataReadResult[rangeIdx].result != rangeIO.len) {
+            AUTIL_LOG(ERROR, "read value fail from file [%s], offset [%lu], len [%lu], read len [%lu]",
+                      _dataFileReader->DebugString().c_str(), rangeIO.offset, rangeIO.len,
+                      dataReadResult[rangeIdx].result);
+            ret[i] = indexlib::index::ErrorCode::FileIO;
+            data->push_back(autil::StringView());
+            continue;
         }
+        data->push_back(autil::StringView((char*)rangeIO.buffer + (offsets[i] - rangeIO.offset), lens[i]));
     }
     co_return ret;
 }
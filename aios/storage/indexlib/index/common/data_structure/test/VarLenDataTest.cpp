@@ -40,6 +40,7 @@ private:
     /* para_str= adaptiveOffset[1000]|equal|uniq|appendLen|guardOffset|compressor=zlib[2048] */
     VarLenDataParam CreateParam(const std::string& para_str);
     void InnerTest(const std::string& para_str, bool useBlockCache);
+    void InnerTestBatchGetValue(const std::string& para_str);
 
     void InnerTestBuildAndRead(const std::shared_ptr<indexlib::file_system::IDirectory>& directory,
                                const VarLenDataParam& param, size_t segCount, size_t repeatDocCountPerSegment);
@@ -414,4 +415,54 @@ TEST_F(VarLenDataTest, TestBatchGetValueBadParam)
     }
 }
 
+void VarLenDataTest::InnerTestBatchGetValue(const std::string& para_str)
+{
+    tearDown();
+    setUp();
+    LoadConfigList loadConfigList = LoadConfigListCreator::CreateLoadConfigList(READ_MODE_CACHE);
+    ResetRootDirectory(loadConfigList);
+
+    VarLenDataParam param = CreateParam(para_str);
+    VarLenDataAccessor accessor;
+    accessor.Init(&_pool, param.dataItemUniqEncode);
+    uint32_t docCount = 0;
+    for (size_t i = 0; i < 200; i++) {
+        for (auto data : _data) {
+            std::string field = data + StringUtil::toString(i);
+            accessor.AppendValue(StringView(field));
+            docCount++;
+        }
+    }
+    auto [status, segDir] = _rootDir->MakeDirectory("segment_0", indexlib::file_system::DirectoryOption()).StatusWith();
+    ASSERT_TRUE(status.IsOK());
+    VarLenDataDumper dumper;
+    dumper.Init(&accessor, param);
+    ASSERT_TRUE(dumper.Dump(segDir, "offset", "data", nullptr, nullptr, &_pool).IsOK());
+
+    VarLenDataReader reader(param, true);
+    ASSERT_TRUE(reader.Init(docCount, segDir, "offset", "data").IsOK());
+    // adjacent docs, duplicate docs, far away docs and the last doc
+    std::vector<docid_t> docIds {0, 1, 2, 2, 3, 17, 18, 100, 401, 402, 700, (docid_t)docCount - 1};
+    autil::mem_pool::Pool pool;
+    std::vector<StringView> values;
+    auto ret =
+        future_lite::coro::syncAwait(reader.GetValue(docIds, &pool, indexlib::file_system::ReadOption(), &values));
+    ASSERT_EQ(docIds.size(), ret.size());
+    ASSERT_EQ(docIds.size(), values.size());
+    for (size_t i = 0; i < docIds.size(); ++i) {
+        ASSERT_EQ(indexlib::index::ErrorCode::OK, ret[i]);
+        std::string expectField = _data[docIds[i] % _data.size()] + StringUtil::toString(docIds[i] / _data.size());
+        ASSERT_EQ(StringView(expectField), values[i]) << "docid: " << docIds[i];
+    }
+}
+
+TEST_F(VarLenDataTest, TestBatchGetValueCoalesced)
+{
+    InnerTestBatchGetValue("");
+    InnerTestBatchGetValue("equal|appendLen");
+    InnerTestBatchGetValue("compressor=zstd");
+    InnerTestBatchGetValue("compressor=lz4[256]");
+    InnerTestBatchGetValue("adaptiveOffset|equal|uniq|appendLen|compressor=zstd");
+}
+
 } // namespace indexlibv2::index
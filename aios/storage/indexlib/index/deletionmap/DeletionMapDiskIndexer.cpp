@@ -15,6 +15,7 @@
  */
 #include "indexlib/index/deletionmap/DeletionMapDiskIndexer.h"
 
+#include "autil/EnvUtil.h"
 #include "autil/mem_pool/Pool.h"
 #include "indexlib/file_system/Directory.h"
 #include "indexlib/file_system/IDirectory.h"
@@ -68,19 +69,61 @@ Status DeletionMapDiskIndexer::Open(const std::shared_ptr<config::IIndexConfig>&
     if (diskBitmap) {
         RETURN_IF_STATUS_ERROR(ApplyDeletionMapPatch(diskBitmap.get()), "apply deletionmap patch failed");
     }
+    if (autil::EnvUtil::getEnv(COMPRESS_BITMAP_ENV, false)) {
+        CompressBitmap();
+    }
     if (_metrics) {
         _metrics->Start();
     }
     return Status::OK();
 }
 
+void DeletionMapDiskIndexer::CompressBitmap()
+{
+    auto compressedBitmap = indexlib::util::CompressedBitmap::Create(*_bitmap);
+    size_t bitmapSize = indexlib::util::Bitmap::GetDumpSize(_docCount);
+    size_t compressedSize = compressedBitmap->EstimateMemoryUse();
+    if (compressedSize >= bitmapSize) {
+        AUTIL_LOG(DEBUG, "segment [%d] keep plain deletion map, compressed size [%lu] >= bitmap size [%lu]", _segmentId,
+                  compressedSize, bitmapSize);
+        return;
+    }
+    _compressedBitmap = std::move(compressedBitmap);
+    _useCompressedBitmap.store(true, std::memory_order_release);
+    _bitmap.reset();
+    _pool.reset();
+    _allocator.reset();
+    AUTIL_LOG(INFO, "segment [%d] deletion map compressed, deleted doc count [%u], memory [%lu] -> [%lu]", _segmentId,
+              _compressedBitmap->GetSetCount(), bitmapSize, compressedSize);
+}
+
+void DeletionMapDiskIndexer::DecompressBitmap()
+{
+    std::lock_guard<std::mutex> guard(_decompressMutex);
+    if (!_useCompressedBitmap.load(std::memory_order_acquire)) {
+        return;
+    }
+    _allocator.reset(new indexlib::util::MMapAllocator);
+    _pool.reset(new autil::mem_pool::Pool(_allocator.get(), 1 * 1024 * 1024));
+    _bitmap.reset(new indexlib::util::Bitmap(_docCount, false, _pool.get()));
+    _compressedBitmap->CopyTo(_bitmap.get());
+    _useCompressedBitmap.store(false, std::memory_order_release);
+    AUTIL_LOG(INFO, "segment [%d] deletion map decompressed for modification", _segmentId);
+}
+
 Status DeletionMapDiskIndexer::Delete(docid_t docid)
 {
+    if (_useCompressedBitmap.load(std::memory_order_acquire)) {
+        DecompressBitmap();
+    }
     _bitmap->Set(docid);
     return Status::OK();
 }
 uint32_t DeletionMapDiskIndexer::GetDeletedDocCount() const
 {
+    if (_useCompressedBitmap.load(std::memory_order_acquire)) {
+        return _compressedBitmap->GetSetCount();
+    }
     auto bitmap = _bitmap.get();
     if (bitmap) {
         return bitmap->GetSetCount();
@@ -111,7 +154,13 @@ size_t DeletionMapDiskIndexer::EstimateMemUsed(const std::shared_ptr<config::IIn
     return indexlib::util::Bitmap::GetDumpSize(_docCount);
 }
 
-size_t DeletionMapDiskIndexer::EvaluateCurrentMemUsed() { return indexlib::util::Bitmap::GetDumpSize(_docCount); }
+size_t DeletionMapDiskIndexer::EvaluateCurrentMemUsed()
+{
+    if (_useCompressedBitmap.load(std::memory_order_acquire)) {
+        return _compressedBitmap->EstimateMemoryUse();
+    }
+    return indexlib::util::Bitmap::GetDumpSize(_docCount);
+}
 
 Status DeletionMapDiskIndexer::ApplyDeletionMapPatch(indexlib::util::Bitmap* bitmap)
 {
@@ -124,6 +173,9 @@ Status DeletionMapDiskIndexer::ApplyDeletionMapPatch(indexlib::util::Bitmap* bit
                   bitmap->GetValidItemCount(), _docCount);
         return Status::InvalidArgs("apply deletionmap patch failed");
     }
+    if (_useCompressedBitmap.load(std::memory_order_acquire)) {
+        DecompressBitmap();
+    }
     *_bitmap |= *bitmap;
     return Status::OK();
 }
@@ -191,11 +243,18 @@ DeletionMapDiskIndexer::GetDeletionMapPatch(segmentid_t segmentId)
 
 Status DeletionMapDiskIndexer::Dump(const std::shared_ptr<indexlib::file_system::IDirectory>& indexDirectory)
 {
-    if (!_bitmap) {
+    indexlib::util::Bitmap* bitmap = _bitmap.get();
+    std::unique_ptr<indexlib::util::Bitmap> dumpBitmap;
+    if (_useCompressedBitmap.load(std::memory_order_acquire)) {
+        dumpBitmap.reset(new indexlib::util::Bitmap((uint32_t)_docCount));
+        _compressedBitmap->CopyTo(dumpBitmap.get());
+        bitmap = dumpBitmap.get();
+    }
+    if (!bitmap) {
         AUTIL_LOG(ERROR, "_bitmap is nullptr");
         return Status::Corruption("_bitmap is nullptr");
     }
-    if (_bitmap->GetSetCount() == 0) {
+    if (bitmap->GetSetCount() == 0) {
         return Status::OK();
     }
     std::string fileName = DeletionMapUtil::GetDeletionMapFileName(_segmentId);
@@ -207,7 +266,7 @@ Status DeletionMapDiskIndexer::Dump(const std::shared_ptr<indexlib::file_system:
         return Status::IOError("create file writer failed");
     }
     std::shared_ptr<indexlib::file_system::FileWriter> writer = writerResult.Value();
-    RETURN_IF_STATUS_ERROR(DeletionMapUtil::DumpBitmap(writer, _bitmap.get(), _bitmap->GetValidItemCount()),
+    RETURN_IF_STATUS_ERROR(DeletionMapUtil::DumpBitmap(writer, bitmap, bitmap->GetValidItemCount()),
                            "dump bitmap fail");
 
     auto ret = writer->Close();
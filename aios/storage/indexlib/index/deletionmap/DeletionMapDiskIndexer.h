@@ -15,10 +15,15 @@
  */
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include "autil/Log.h"
 #include "indexlib/base/Types.h"
 #include "indexlib/index/IDiskIndexer.h"
+#include "indexlib/index/deletionmap/DeletionMapUtil.h"
 #include "indexlib/util/Bitmap.h"
+#include "indexlib/util/CompressedBitmap.h"
 
 namespace autil::mem_pool {
 class Pool;
@@ -38,6 +43,11 @@ class DeletionMapMetrics;
 
 class DeletionMapDiskIndexer : public IDiskIndexer
 {
+public:
+    // keep opened deletion map in a compressed bitmap when it takes less memory, the plain bitmap is restored on
+    // the first delete or patch
+    static constexpr const char* COMPRESS_BITMAP_ENV = "INDEXLIB_COMPRESS_DELETION_MAP";
+
 public:
     DeletionMapDiskIndexer(size_t docCount, segmentid_t segmentId);
     ~DeletionMapDiskIndexer();
@@ -49,10 +59,13 @@ public:
     size_t EvaluateCurrentMemUsed() override;
 
     bool IsDeleted(docid_t docid) const;
+    // first run [begin, end) of not deleted docs in [beginDocId, endDocId), begin equals end if all deleted
+    std::pair<docid_t, docid_t> GetNextNonDeletedRun(docid_t beginDocId, docid_t endDocId) const;
     Status Delete(docid_t docid);
     uint32_t GetDeletedDocCount() const;
     segmentid_t GetSegmentId() const;
     void TEST_InitWithoutOpen();
+    bool IsBitmapCompressed() const { return _useCompressedBitmap.load(std::memory_order_acquire); }
 
     std::pair<Status, std::unique_ptr<indexlib::util::Bitmap>> GetDeletionMapPatch(segmentid_t segmentId);
     Status ApplyDeletionMapPatch(indexlib::util::Bitmap* bitmap);
@@ -62,6 +75,8 @@ public:
 private:
     Status LoadFileHeader(const std::shared_ptr<indexlib::file_system::FileReader>& fileReader,
                           DeletionMapFileHeader& fileHeader);
+    void CompressBitmap();
+    void DecompressBitmap();
 
 private:
     size_t _docCount;
@@ -71,6 +86,10 @@ private:
     std::unique_ptr<indexlib::util::MMapAllocator> _allocator;
     std::unique_ptr<autil::mem_pool::Pool> _pool;
     std::shared_ptr<indexlib::file_system::IDirectory> _directory;
+    // kept until destruction once set, readers may still access it after decompressed
+    std::unique_ptr<indexlib::util::CompressedBitmap> _compressedBitmap;
+    std::atomic<bool> _useCompressedBitmap = false;
+    std::mutex _decompressMutex;
 
 private:
     AUTIL_LOG_DECLARE();
@@ -79,7 +98,20 @@ private:
 inline bool DeletionMapDiskIndexer::IsDeleted(docid_t docid) const
 {
     assert(docid < _docCount);
+    if (_useCompressedBitmap.load(std::memory_order_acquire)) {
+        return _compressedBitmap->Test(docid);
+    }
     return _bitmap->Test(docid);
 }
 
+inline std::pair<docid_t, docid_t> DeletionMapDiskIndexer::GetNextNonDeletedRun(docid_t beginDocId,
+                                                                               docid_t endDocId) const
+{
+    endDocId = std::min(endDocId, (docid_t)_docCount);
+    if (_useCompressedBitmap.load(std::memory_order_acquire)) {
+        return DeletionMapUtil::GetUnsetRun(*_compressedBitmap, _docCount, beginDocId, endDocId);
+    }
+    return DeletionMapUtil::GetUnsetRun(*_bitmap, _docCount, beginDocId, endDocId);
+}
+
 } // namespace indexlibv2::index
@@ -141,6 +141,54 @@ Status DeletionMapIndexReader::DoOpen(
     return Status::OK();
 }
 
+std::pair<docid_t, docid_t> DeletionMapIndexReader::GetNextNonDeletedRun(docid_t beginDocId, docid_t endDocId) const
+{
+    endDocId = std::min(endDocId, (docid_t)_tabletDataInfo->GetDocCount());
+    docid_t docid = std::max(beginDocId, (docid_t)0);
+    while (docid < endDocId) {
+        size_t idx = std::upper_bound(_segmentBaseDocids.begin(), _segmentBaseDocids.end(), docid) -
+                     _segmentBaseDocids.begin() - 1;
+        docid_t baseDocid = _segmentBaseDocids[idx];
+        docid_t segmentEndDocid = endDocId;
+        if (idx + 1 < _segmentBaseDocids.size()) {
+            segmentEndDocid = std::min(segmentEndDocid, _segmentBaseDocids[idx + 1]);
+        }
+        auto [runBegin, runEnd] = GetSegmentNonDeletedRun(idx, docid - baseDocid, segmentEndDocid - baseDocid);
+        if (runBegin < runEnd) {
+            return {baseDocid + runBegin, baseDocid + runEnd};
+        }
+        docid = segmentEndDocid;
+    }
+    return {endDocId, endDocId};
+}
+
+std::pair<docid_t, docid_t> DeletionMapIndexReader::GetSegmentNonDeletedRun(size_t idx, docid_t beginDocId,
+                                                                            docid_t endDocId) const
+{
+    while (beginDocId < endDocId) {
+        std::pair<docid_t, docid_t> run;
+        if (idx < _builtIndexers.size()) {
+            run = _builtIndexers[idx]->GetNextNonDeletedRun(beginDocId, endDocId);
+        } else if (idx < _builtIndexers.size() + _dumpingIndexers.size()) {
+            run = _dumpingIndexers[idx - _builtIndexers.size()]->GetNextNonDeletedRun(beginDocId, endDocId);
+        } else if (_buildingIndexer) {
+            run = _buildingIndexer->GetNextNonDeletedRun(beginDocId, endDocId);
+        } else {
+            break;
+        }
+        if (run.first >= run.second || idx >= _deletionMapResources.size()) {
+            return run;
+        }
+        // docs deleted in resource split the run of indexer
+        auto resourceRun = _deletionMapResources[idx]->GetNextNonDeletedRun(run.first, run.second);
+        if (resourceRun.first < resourceRun.second) {
+            return resourceRun;
+        }
+        beginDocId = run.second;
+    }
+    return {endDocId, endDocId};
+}
+
 uint32_t DeletionMapIndexReader::GetDeletedDocCount() const
 {
     uint32_t deletedCount = 0;
@@ -42,6 +42,9 @@ public:
     Status Open(const std::shared_ptr<config::IIndexConfig>& indexConfig,
                 const framework::TabletData* tabletData) override;
     bool IsDeleted(docid_t docid) const;
+    // first run [begin, end) of not deleted docs in [beginDocId, endDocId), returns {endDocId, endDocId} if all
+    // deleted, scans use it to skip deleted ranges instead of testing doc by doc
+    std::pair<docid_t, docid_t> GetNextNonDeletedRun(docid_t beginDocId, docid_t endDocId) const;
     uint32_t GetDeletedDocCount() const;
     uint32_t GetSegmentDeletedDocCount(segmentid_t segmentId) const;
     void RegisterMetrics(const std::shared_ptr<DeletionMapMetrics>& metrics);
@@ -49,6 +52,7 @@ public:
 private:
     Status DoOpen(
         const std::vector<std::tuple<std::shared_ptr<IIndexer>, framework::Segment::SegmentStatus, size_t>>& indexers);
+    std::pair<docid_t, docid_t> GetSegmentNonDeletedRun(size_t idx, docid_t beginDocId, docid_t endDocId) const;
 
 private:
     std::shared_ptr<DeletionMapMetrics> _metrics;
@@ -18,6 +18,7 @@
 #include "autil/Log.h"
 #include "indexlib/base/Types.h"
 #include "indexlib/index/IMemIndexer.h"
+#include "indexlib/index/deletionmap/DeletionMapUtil.h"
 #include "indexlib/util/ExpandableBitmap.h"
 
 namespace indexlib::util {
@@ -58,6 +59,8 @@ public:
     autil::StringView GetIndexType() const override;
 
     bool IsDeleted(docid_t docid) const;
+    // first run [begin, end) of not deleted docs in [beginDocId, endDocId), begin equals end if all deleted
+    std::pair<docid_t, docid_t> GetNextNonDeletedRun(docid_t beginDocId, docid_t endDocId) const;
     Status Delete(docid_t docid);
     uint32_t GetDeletedDocCount() const;
     void RegisterMetrics(const std::shared_ptr<DeletionMapMetrics>& metrics);
@@ -95,4 +98,12 @@ inline bool DeletionMapMemIndexer::IsDeleted(docid_t docid) const
     return _bitmap->Test(docid);
 }
 
+inline std::pair<docid_t, docid_t> DeletionMapMemIndexer::GetNextNonDeletedRun(docid_t beginDocId,
+                                                                              docid_t endDocId) const
+{
+    // docs not less than _docCount are deleted, docs not in bitmap yet are not
+    endDocId = std::min(endDocId, (docid_t)_docCount);
+    return DeletionMapUtil::GetUnsetRun(*_bitmap, _bitmap->GetValidItemCount(), beginDocId, endDocId);
+}
+
 } // namespace indexlibv2::index
@@ -18,6 +18,7 @@
 #include "autil/Log.h"
 #include "indexlib/base/Types.h"
 #include "indexlib/framework/IResource.h"
+#include "indexlib/index/deletionmap/DeletionMapUtil.h"
 #include "indexlib/util/ExpandableBitmap.h"
 
 namespace indexlibv2::index {
@@ -45,6 +46,12 @@ public:
         return false;
     }
 
+    std::pair<docid_t, docid_t> GetNextNonDeletedRun(docid_t beginDocId, docid_t endDocId) const
+    {
+        uint32_t itemCount = std::min(_docCount, (size_t)_bitmap.GetItemCount());
+        return DeletionMapUtil::GetUnsetRun(_bitmap, itemCount, beginDocId, endDocId);
+    }
+
     bool ApplyBitmap(indexlib::util::Bitmap* bitmap)
     {
         if (bitmap && bitmap->GetItemCount() == _bitmap.GetItemCount()) {
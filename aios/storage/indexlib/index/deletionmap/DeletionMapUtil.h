@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <algorithm>
+
 #include "autil/Log.h"
 #include "indexlib/base/Status.h"
 #include "indexlib/index/deletionmap/Common.h"
@@ -48,6 +50,12 @@ public:
     static std::string GetDeletionMapFileName(segmentid_t segmentId);
     static std::pair<bool, segmentid_t> ExtractDeletionMapFileName(const std::string& fileName);
 
+    // first run [begin, end) of unset items in [beginDocId, endDocId), items not less than itemCount are unset,
+    // begin equals end if all items are set. BitmapType should provide FindNextSet and FindNextUnset.
+    template <typename BitmapType>
+    static std::pair<docid_t, docid_t> GetUnsetRun(const BitmapType& bitmap, uint32_t itemCount, docid_t beginDocId,
+                                                   docid_t endDocId);
+
 private:
     static Status DumpFileHeader(const std::shared_ptr<indexlib::file_system::FileWriter>& fileWriter,
                                  const DeletionMapFileHeader& fileHeader);
@@ -56,4 +64,26 @@ private:
     AUTIL_LOG_DECLARE();
 };
 
+template <typename BitmapType>
+inline std::pair<docid_t, docid_t> DeletionMapUtil::GetUnsetRun(const BitmapType& bitmap, uint32_t itemCount,
+                                                                docid_t beginDocId, docid_t endDocId)
+{
+    if (beginDocId >= endDocId) {
+        return {endDocId, endDocId};
+    }
+    if ((uint32_t)beginDocId >= itemCount) {
+        return {beginDocId, endDocId};
+    }
+    // INVALID_INDEX is not less than itemCount
+    uint32_t runBegin = std::min(bitmap.FindNextUnset(beginDocId), itemCount);
+    if (runBegin >= (uint32_t)endDocId) {
+        return {endDocId, endDocId};
+    }
+    uint32_t runEnd = (runBegin < itemCount) ? bitmap.FindNextSet(runBegin) : itemCount;
+    if (runEnd >= itemCount || runEnd >= (uint32_t)endDocId) {
+        return {runBegin, endDocId};
+    }
+    return {runBegin, runEnd};
+}
+
 } // namespace indexlibv2::index
@@ -1,5 +1,6 @@
 #include "indexlib/index/deletionmap/DeletionMapDiskIndexer.h"
 
+#include "autil/EnvUtil.h"
 #include "indexlib/file_system/Directory.h"
 #include "indexlib/file_system/FileSystemCreator.h"
 #include "indexlib/index/deletionmap/DeletionMapConfig.h"
@@ -22,12 +23,14 @@ public:
     void CaseSetUp() override;
     void CaseTearDown() override;
     void TestSimpleProcess();
+    void TestCompressedBitmap();
 
 private:
     AUTIL_LOG_DECLARE();
 };
 
 INDEXLIB_UNIT_TEST_CASE(DeletionMapDiskIndexerTest, TestSimpleProcess);
+INDEXLIB_UNIT_TEST_CASE(DeletionMapDiskIndexerTest, TestCompressedBitmap);
 AUTIL_LOG_SETUP(indexlib.index, DeletionMapDiskIndexerTest);
 
 DeletionMapDiskIndexerTest::DeletionMapDiskIndexerTest() {}
@@ -60,6 +63,51 @@ void DeletionMapDiskIndexerTest::TestSimpleProcess()
     ASSERT_TRUE(bitmap.Set(11));
     ASSERT_TRUE(diskIndexer.ApplyDeletionMapPatch(&bitmap).IsOK());
     ASSERT_TRUE(diskIndexer.IsDeleted(11));
+    ASSERT_EQ(std::make_pair(1, 11), diskIndexer.GetNextNonDeletedRun(0, 100));
+    ASSERT_EQ(std::make_pair(12, 99), diskIndexer.GetNextNonDeletedRun(11, 100));
+    ASSERT_EQ(std::make_pair(12, 50), diskIndexer.GetNextNonDeletedRun(12, 50));
+    ASSERT_EQ(std::make_pair(100, 100), diskIndexer.GetNextNonDeletedRun(99, 200));
+}
+
+void DeletionMapDiskIndexerTest::TestCompressedBitmap()
+{
+    const size_t docCount = 200000;
+    shared_ptr<DeletionMapConfig> config(new DeletionMapConfig);
+    indexlib::file_system::FileSystemOptions fsOptions;
+    fsOptions.enableAsyncFlush = false;
+    auto fs = indexlib::file_system::FileSystemCreator::Create("test", GET_TEMP_DATA_PATH(), fsOptions).GetOrThrow();
+    auto rootDir = indexlib::file_system::Directory::Get(fs);
+    {
+        // most docs deleted
+        DeletionMapDiskIndexer diskIndexer(docCount, 0);
+        ASSERT_TRUE(diskIndexer.Open(config, rootDir->GetIDirectory()).IsOK());
+        for (docid_t docId = 0; docId < docCount; ++docId) {
+            if (docId % 50000 != 10) {
+                ASSERT_TRUE(diskIndexer.Delete(docId).IsOK());
+            }
+        }
+        ASSERT_FALSE(diskIndexer.IsBitmapCompressed());
+        ASSERT_TRUE(diskIndexer.Dump(rootDir->GetIDirectory()).IsOK());
+    }
+
+    autil::EnvGuard envGuard(DeletionMapDiskIndexer::COMPRESS_BITMAP_ENV, "true");
+    DeletionMapDiskIndexer diskIndexer(docCount, 0);
+    ASSERT_TRUE(diskIndexer.Open(config, rootDir->GetIDirectory()).IsOK());
+    ASSERT_TRUE(diskIndexer.IsBitmapCompressed());
+    ASSERT_LT(diskIndexer.EvaluateCurrentMemUsed(), indexlib::util::Bitmap::GetDumpSize(docCount) / 10);
+    ASSERT_EQ((uint32_t)(docCount - 4), diskIndexer.GetDeletedDocCount());
+    ASSERT_TRUE(diskIndexer.IsDeleted(0));
+    ASSERT_FALSE(diskIndexer.IsDeleted(50010));
+    ASSERT_EQ(std::make_pair(10, 11), diskIndexer.GetNextNonDeletedRun(0, docCount));
+    ASSERT_EQ(std::make_pair(50010, 50011), diskIndexer.GetNextNonDeletedRun(11, docCount));
+    ASSERT_EQ(std::make_pair(60000, 60000), diskIndexer.GetNextNonDeletedRun(50011, 60000));
+
+    // delete restores plain bitmap
+    ASSERT_TRUE(diskIndexer.Delete(10).IsOK());
+    ASSERT_FALSE(diskIndexer.IsBitmapCompressed());
+    ASSERT_TRUE(diskIndexer.IsDeleted(10));
+    ASSERT_EQ((uint32_t)(docCount - 3), diskIndexer.GetDeletedDocCount());
+    ASSERT_EQ(std::make_pair(50010, 50011), diskIndexer.GetNextNonDeletedRun(0, docCount));
 }
 
 } // namespace indexlibv2::index
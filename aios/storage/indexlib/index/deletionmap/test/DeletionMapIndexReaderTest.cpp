@@ -28,6 +28,7 @@ public:
     void CaseTearDown() override;
     void TestCaseForReadAndWrite();
     void TestCaseForGetDeletedDocCount();
+    void TestCaseForGetNextNonDeletedRun();
 
 private:
     void InnerTestDeletionmapReadAndWrite(
@@ -46,6 +47,7 @@ private:
 
 INDEXLIB_UNIT_TEST_CASE(DeletionMapIndexReaderTest, TestCaseForReadAndWrite);
 INDEXLIB_UNIT_TEST_CASE(DeletionMapIndexReaderTest, TestCaseForGetDeletedDocCount);
+INDEXLIB_UNIT_TEST_CASE(DeletionMapIndexReaderTest, TestCaseForGetNextNonDeletedRun);
 AUTIL_LOG_SETUP(indexlib.index, DeletionMapIndexReaderTest);
 
 DeletionMapIndexReaderTest::DeletionMapIndexReaderTest() {}
@@ -113,6 +115,58 @@ void DeletionMapIndexReaderTest::TestCaseForGetDeletedDocCount()
     ASSERT_EQ((uint32_t)1, reader->GetSegmentDeletedDocCount(2));
 }
 
+void DeletionMapIndexReaderTest::TestCaseForGetNextNonDeletedRun()
+{
+    std::vector<tuple<std::shared_ptr<IIndexer>, framework::Segment::SegmentStatus, size_t>> indexers;
+    const uint32_t segmentDocCount = 10;
+    for (size_t i = 0; i < 3; ++i) {
+        shared_ptr<DeletionMapDiskIndexer> diskIndexer(new DeletionMapDiskIndexer(segmentDocCount, i));
+        diskIndexer->TEST_InitWithoutOpen();
+        indexers.emplace_back(diskIndexer, framework::Segment::SegmentStatus::ST_BUILT, segmentDocCount);
+    }
+    // segment 0: 0-4 deleted, segment 1: all deleted, segment 2: 25 deleted
+    for (docid_t docId = 0; docId < 5; ++docId) {
+        ASSERT_TRUE(dynamic_pointer_cast<DeletionMapDiskIndexer>(get<0>(indexers[0]))->Delete(docId).IsOK());
+    }
+    for (docid_t docId = 0; docId < 10; ++docId) {
+        ASSERT_TRUE(dynamic_pointer_cast<DeletionMapDiskIndexer>(get<0>(indexers[1]))->Delete(docId).IsOK());
+    }
+    ASSERT_TRUE(dynamic_pointer_cast<DeletionMapDiskIndexer>(get<0>(indexers[2]))->Delete(5).IsOK());
+
+    shared_ptr<DeletionMapIndexReader> reader(new DeletionMapIndexReader);
+    auto tabletDataInfo = new framework::TabletDataInfo;
+    tabletDataInfo->SetDocCount(30);
+    reader->_tabletDataInfo.reset(tabletDataInfo);
+    ASSERT_TRUE(reader->DoOpen(indexers).IsOK());
+    for (size_t i = 0; i < 3; ++i) {
+        reader->_deletionMapResources.push_back(DeletionMapResource::DeletionMapResourceCreator(segmentDocCount));
+    }
+    // deleted in resource of segment 0
+    reader->_deletionMapResources[0]->Delete(7);
+
+    ASSERT_EQ(std::make_pair(5, 7), reader->GetNextNonDeletedRun(0, 100));
+    ASSERT_EQ(std::make_pair(8, 10), reader->GetNextNonDeletedRun(7, 100));
+    ASSERT_EQ(std::make_pair(20, 25), reader->GetNextNonDeletedRun(10, 100));
+    ASSERT_EQ(std::make_pair(26, 30), reader->GetNextNonDeletedRun(25, 100));
+    ASSERT_EQ(std::make_pair(26, 28), reader->GetNextNonDeletedRun(25, 28));
+    ASSERT_EQ(std::make_pair(30, 30), reader->GetNextNonDeletedRun(30, 100));
+    ASSERT_EQ(std::make_pair(20, 20), reader->GetNextNonDeletedRun(10, 20));
+
+    // runs agree with IsDeleted
+    for (docid_t docId = 0; docId < 30; ++docId) {
+        auto [runBegin, runEnd] = reader->GetNextNonDeletedRun(docId, 30);
+        for (docid_t i = docId; i < runBegin; ++i) {
+            ASSERT_TRUE(reader->IsDeleted(i)) << i;
+        }
+        for (docid_t i = runBegin; i < runEnd; ++i) {
+            ASSERT_FALSE(reader->IsDeleted(i)) << i;
+        }
+        if (runEnd < 30) {
+            ASSERT_TRUE(reader->IsDeleted(runEnd)) << runEnd;
+        }
+    }
+}
+
 void DeletionMapIndexReaderTest::InnerTestDeletionmapReadAndWrite(
     uint32_t segmentDocCount, const string& toDeleteDocs, const string& deletedDocs,
     std::vector<tuple<std::shared_ptr<IIndexer>, framework::Segment::SegmentStatus, size_t>>& indexers)
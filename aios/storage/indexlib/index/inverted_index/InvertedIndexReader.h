@@ -82,6 +82,11 @@ public:
     GetSegmentPostingAsync(const index::DictKeyInfo& key, uint32_t segmentIdx, SegmentPosting& segPosting,
                            file_system::ReadOption option, InvertedIndexSearchTracer* tracer) noexcept = 0;
 
+    // reuse what the reader opened on the last tablet data built over the same segments, call it before Open
+    virtual void SetLastReader(const std::shared_ptr<InvertedIndexReader>& lastReader) {}
+    // memory allocated by the reader itself at open, segment data is accounted by the segments
+    virtual size_t EvaluateCurrentMemUsed() const { return 0; }
+
     // to convert field names to fieldmap_t
     virtual bool GenFieldMapMask(const std::string& indexName, const std::vector<std::string>& termFieldNames,
                                  fieldmap_t& targetFieldMap);
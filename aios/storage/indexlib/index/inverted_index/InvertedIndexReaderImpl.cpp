@@ -15,6 +15,9 @@
  */
 #include "indexlib/index/inverted_index/InvertedIndexReaderImpl.h"
 
+#include <unordered_map>
+
+#include "autil/EnvUtil.h"
 #include "indexlib/config/ITabletSchema.h"
 #include "indexlib/index/inverted_index/BufferedPostingIterator.h"
 #include "indexlib/index/inverted_index/BuildingIndexReader.h"
@@ -27,6 +30,7 @@
 #include "indexlib/index/inverted_index/InvertedLeafMemReader.h"
 #include "indexlib/index/inverted_index/InvertedLeafReader.h"
 #include "indexlib/index/inverted_index/InvertedMemIndexer.h"
+#include "indexlib/index/inverted_index/MergedTermDictionary.h"
 #include "indexlib/index/inverted_index/builtin_index/bitmap/BitmapDiskIndexer.h"
 #include "indexlib/index/inverted_index/builtin_index/bitmap/BitmapIndexWriter.h"
 #include "indexlib/index/inverted_index/builtin_index/dynamic/DynamicIndexReader.h"
@@ -188,6 +192,7 @@ Status InvertedIndexReaderImpl::DoOpen(const std::shared_ptr<InvertedIndexConfig
     }
     _segmentReaders.swap(segmentReaders);
     _baseDocIds.swap(baseDocIds);
+    TryBuildMergedTermDictionary();
 
     if (_highFreqVol != nullptr) {
         _bitmapIndexReader = std::make_unique<BitmapIndexReader>();
@@ -244,6 +249,70 @@ Status InvertedIndexReaderImpl::TryOpenTruncateIndexReader(
     return Status::OK();
 }
 
+void InvertedIndexReaderImpl::TryBuildMergedTermDictionary()
+{
+    _mergedTermDictionary.reset();
+    auto lastReader = std::move(_lastReader);
+    auto minSegmentCount = autil::EnvUtil::getEnv(MERGED_TERM_DICTIONARY_ENV, (size_t)0);
+    if (minSegmentCount == 0 || _segmentReaders.size() < minSegmentCount) {
+        return;
+    }
+    auto indexType = _indexConfig->GetInvertedIndexType();
+    if (indexType == it_range || indexType == it_date || indexType == it_spatial ||
+        !_indexConfig->GetNonTruncateIndexName().empty()) {
+        // these readers look up postings by their own leaf readers
+        return;
+    }
+    auto mergedTermDictionary = std::make_shared<MergedTermDictionary>();
+    // leaf readers are shared across tablet data generations, segments the last reader has merged are inherited
+    // from its dictionary, only the others are iterated
+    std::vector<bool> inherited(_segmentReaders.size(), false);
+    if (lastReader && lastReader->_mergedTermDictionary) {
+        if (lastReader->_segmentReaders == _segmentReaders) {
+            // same segments in the same order, the sealed dictionary is immutable and can be shared
+            AUTIL_LOG(INFO, "share merged term dictionary of last reader for index [%s], segment count [%lu]",
+                      _indexConfig->GetIndexName().c_str(), _segmentReaders.size());
+            _mergedTermDictionary = lastReader->_mergedTermDictionary;
+            return;
+        }
+        std::unordered_map<const InvertedLeafReader*, uint32_t> segmentIdxs;
+        for (uint32_t i = 0; i < _segmentReaders.size(); ++i) {
+            segmentIdxs[_segmentReaders[i].get()] = i;
+        }
+        std::vector<uint32_t> segmentIdxMap(lastReader->_segmentReaders.size(),
+                                            MergedTermDictionary::INVALID_SEGMENT_IDX);
+        for (uint32_t i = 0; i < lastReader->_segmentReaders.size(); ++i) {
+            auto iter = segmentIdxs.find(lastReader->_segmentReaders[i].get());
+            if (iter != segmentIdxs.end()) {
+                segmentIdxMap[i] = iter->second;
+                inherited[iter->second] = true;
+            }
+        }
+        mergedTermDictionary->Inherit(*lastReader->_mergedTermDictionary, segmentIdxMap);
+    }
+    size_t inheritedCount = 0;
+    for (uint32_t i = 0; i < _segmentReaders.size(); ++i) {
+        if (inherited[i]) {
+            ++inheritedCount;
+            continue;
+        }
+        auto status = mergedTermDictionary->AddSegment(i, _segmentReaders[i]->GetDictionaryReader());
+        if (!status.IsOK()) {
+            AUTIL_LOG(WARN, "build merged term dictionary for index [%s] failed, use segment dictionaries, %s",
+                      _indexConfig->GetIndexName().c_str(), status.ToString().c_str());
+            return;
+        }
+    }
+    mergedTermDictionary->Seal();
+    AUTIL_LOG(INFO,
+              "build merged term dictionary for index [%s], segment count [%lu], inherited [%lu], term count [%lu], "
+              "entry count [%lu], mem used [%lu]",
+              _indexConfig->GetIndexName().c_str(), _segmentReaders.size(), inheritedCount,
+              mergedTermDictionary->GetTermCount(), mergedTermDictionary->GetEntryCount(),
+              mergedTermDictionary->EstimateMemUsed());
+    _mergedTermDictionary = std::move(mergedTermDictionary);
+}
+
 void InvertedIndexReaderImpl::AddBuildingSegmentReader(docid64_t baseDocId,
                                                        const std::shared_ptr<IndexSegmentReader>& segReader)
 {
@@ -385,6 +454,16 @@ future_lite::coro::Lazy<Result<PostingIterator*>> InvertedIndexReaderImpl::Creat
     if (!ranges.empty()) {
         std::tie(tasks, segmentPostings, needBuildingSegment) =
             FillRangeByBuiltSegments(term, termHashKey, ranges, option, tracer.get());
+    } else if (_mergedTermDictionary && !NeedTruncatePosting(*term)) {
+        auto [entry, end] = _mergedTermDictionary->Lookup(termHashKey);
+        tracer->IncDictionaryLookupCount();
+        tasks.reserve(end - entry);
+        segmentPostings.reserve(end - entry + 1); // for building segments
+        for (; entry != end; ++entry) {
+            segmentPostings.emplace_back();
+            tasks.push_back(GetSegmentPostingByDictValueAsync(entry->dictValue, entry->segmentIdx,
+                                                              segmentPostings.back(), option, tracer.get()));
+        }
     } else {
         tasks.reserve(_segmentReaders.size());
         segmentPostings.reserve(_segmentReaders.size() + 1); // for building segments
@@ -466,6 +545,20 @@ void InvertedIndexReaderImpl::SetAccessoryReader(const std::shared_ptr<IndexAcce
     }
 }
 
+void InvertedIndexReaderImpl::SetLastReader(const std::shared_ptr<InvertedIndexReader>& lastReader)
+{
+    _lastReader = std::dynamic_pointer_cast<InvertedIndexReaderImpl>(lastReader);
+}
+
+size_t InvertedIndexReaderImpl::EvaluateCurrentMemUsed() const
+{
+    size_t memUsed = _mergedTermDictionary ? _mergedTermDictionary->EstimateMemUsed() : 0;
+    for (const auto& [_, truncateIndexReader] : _truncateIndexReaders) {
+        memUsed += truncateIndexReader->EvaluateCurrentMemUsed();
+    }
+    return memUsed;
+}
+
 bool InvertedIndexReaderImpl::NeedTruncatePosting(const Term& term) const
 {
     if (!_truncateIndexReaders.empty() && !term.GetIndexName().empty() && !term.GetTruncateName().empty()) {
@@ -560,15 +653,29 @@ InvertedIndexReaderImpl::CreateMainPostingIteratorAsync(DictKeyInfo key, uint32_
     tracer->SetSearchedSegmentCount(count);
     tracer->SetSearchedInMemSegmentCount(buildingCount);
 
-    for (uint32_t i = 0; i < _segmentReaders.size(); i++) {
-        SegmentPosting segPosting;
-        auto ret = co_await GetSegmentPostingAsync(key, i, segPosting, option, tracer.get());
-        if (ret.Ok()) {
-            if (ret.Value()) {
-                segPostings->push_back(std::move(segPosting));
+    if (_mergedTermDictionary) {
+        auto [entry, end] = _mergedTermDictionary->Lookup(key);
+        tracer->IncDictionaryLookupCount();
+        for (; entry != end; ++entry) {
+            SegmentPosting segPosting;
+            auto ret = co_await GetSegmentPostingByDictValueAsync(entry->dictValue, entry->segmentIdx, segPosting,
+                                                                  option, tracer.get());
+            if (!ret.Ok()) {
+                co_return ret.GetErrorCode();
+            }
+            segPostings->push_back(std::move(segPosting));
+        }
+    } else {
+        for (uint32_t i = 0; i < _segmentReaders.size(); i++) {
+            SegmentPosting segPosting;
+            auto ret = co_await GetSegmentPostingAsync(key, i, segPosting, option, tracer.get());
+            if (ret.Ok()) {
+                if (ret.Value()) {
+                    segPostings->push_back(std::move(segPosting));
+                }
+            } else {
+                co_return ret.GetErrorCode();
             }
-        } else {
-            co_return ret.GetErrorCode();
         }
     }
 
@@ -644,6 +751,32 @@ InvertedIndexReaderImpl::FillSegmentPostingAsync(const Term* term, const DictKey
     co_return co_await GetSegmentPostingAsync(key, segmentIdx, segPosting, option, tracer);
 }
 
+future_lite::coro::Lazy<Result<bool>>
+InvertedIndexReaderImpl::GetSegmentPostingByDictValueAsync(dictvalue_t dictValue, uint32_t segmentIdx,
+                                                           SegmentPosting& segPosting, file_system::ReadOption option,
+                                                           InvertedIndexSearchTracer* tracer) noexcept
+{
+    assert(segmentIdx < _segmentReaders.size());
+    if (tracer) {
+        tracer->IncDictionaryHitCount();
+    }
+    if (_executor) {
+        auto errorCode = co_await _segmentReaders[segmentIdx]->GetSegmentPostingAsync(
+            dictValue, _baseDocIds[segmentIdx], segPosting, nullptr, option, tracer);
+        if (errorCode != ErrorCode::OK) {
+            co_return errorCode;
+        }
+        co_return true;
+    }
+    try {
+        _segmentReaders[segmentIdx]->InnerGetSegmentPosting(dictValue, _baseDocIds[segmentIdx], segPosting, nullptr);
+        co_return true;
+    } catch (...) {
+        AUTIL_LOG(ERROR, "get segment posting failed");
+        co_return ErrorCode::FileIO;
+    }
+}
+
 future_lite::coro::Lazy<Result<bool>>
 InvertedIndexReaderImpl::FillTruncSegmentPosting(const Term& term, const DictKeyInfo& key, uint32_t segmentIdx,
                                                  SegmentPosting& segPosting, file_system::ReadOption option,
@@ -46,6 +46,7 @@ class BufferedPostingIterator;
 class DynamicIndexReader;
 class InvertedLeafReader;
 class InvertedIndexMetrics;
+class MergedTermDictionary;
 class TermMeta;
 class InvertedDiskIndexer;
 
@@ -58,11 +59,16 @@ public:
     using Indexer = std::tuple<docid64_t, std::shared_ptr<indexlibv2::index::IIndexer>, segmentid_t,
                                indexlibv2::framework::Segment::SegmentStatus>;
 
+    // build merged term dictionary when built segment count reaches this value, 0 means disabled
+    static constexpr const char* MERGED_TERM_DICTIONARY_ENV = "INDEXLIB_MERGED_TERM_DICTIONARY_MIN_SEGMENT_COUNT";
+
 public:
     Status Open(const std::shared_ptr<indexlibv2::config::IIndexConfig>& indexConfig,
                 const indexlibv2::framework::TabletData* tabletData) override;
 
     void SetAccessoryReader(const std::shared_ptr<IndexAccessoryReader>& accessoryReader) override;
+    void SetLastReader(const std::shared_ptr<InvertedIndexReader>& lastReader) override;
+    size_t EvaluateCurrentMemUsed() const override;
 
     index::Result<PostingIterator*> Lookup(const index::Term& term, uint32_t statePoolSize, PostingType type,
                                            autil::mem_pool::Pool* sessionPool) override;
@@ -150,6 +156,10 @@ private:
                                     InvertedIndexSearchTracer* tracer) noexcept;
     Status TryOpenTruncateIndexReader(const std::shared_ptr<indexlibv2::config::InvertedIndexConfig>& indexConfig,
                                       const indexlibv2::framework::TabletData* tabletData);
+    void TryBuildMergedTermDictionary();
+    future_lite::coro::Lazy<index::Result<bool>>
+    GetSegmentPostingByDictValueAsync(dictvalue_t dictValue, uint32_t segmentIdx, SegmentPosting& segPosting,
+                                      file_system::ReadOption option, InvertedIndexSearchTracer* tracer) noexcept;
 
 protected:
     std::vector<std::shared_ptr<InvertedLeafReader>> _segmentReaders;
@@ -166,6 +176,9 @@ private:
     std::shared_ptr<IndexAccessoryReader> _accessoryReader;
     std::shared_ptr<InvertedIndexMetrics> _indexMetrics;
     std::map<std::string, std::shared_ptr<InvertedIndexReaderImpl>> _truncateIndexReaders;
+    std::shared_ptr<const MergedTermDictionary> _mergedTermDictionary; // shared with reopened readers if unchanged
+    // only held during open to inherit its merged term dictionary
+    std::shared_ptr<InvertedIndexReaderImpl> _lastReader;
 
 private:
     friend class MultiShardInvertedIndexReader;
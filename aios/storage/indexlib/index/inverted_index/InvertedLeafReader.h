@@ -61,7 +61,7 @@ public:
 
     size_t EvaluateCurrentMemUsed() const;
 
-protected:
+    // read posting by dict value which is already looked up, e.g. by MergedTermDictionary
     void InnerGetSegmentPosting(dictvalue_t value, docid64_t baseDocId, SegmentPosting& segPosting,
                                 autil::mem_pool::Pool* sessionPool) const;
     future_lite::coro::Lazy<index::ErrorCode> GetSegmentPostingAsync(dictvalue_t value, docid64_t baseDocId,
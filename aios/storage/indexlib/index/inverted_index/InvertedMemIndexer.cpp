@@ -16,8 +16,11 @@
 #include "indexlib/index/inverted_index/InvertedMemIndexer.h"
 
 #include <any>
+#include <future>
 
+#include "autil/EnvUtil.h"
 #include "autil/Scope.h"
+#include "autil/ThreadPool.h"
 #include "indexlib/document/DocumentIterator.h"
 #include "indexlib/document/IDocument.h"
 #include "indexlib/document/extractor/plain/DocumentInfoExtractorFactory.h"
@@ -74,8 +77,21 @@ InvertedMemIndexer::InvertedMemIndexer(const indexlibv2::index::MemIndexerParame
     _estimateDumpTempMemSize = NeedEstimateDumpTempMemSize() ? indexlibv2::DEFAULT_CHUNK_SIZE * 1024 * 1024 * 2 : 0;
 }
 
+InvertedMemIndexer::BuildShard::BuildShard(util::MMapAllocator* allocator,
+                                           const PostingFormatOption& postingFormatOption)
+    : byteSlicePool(allocator, DEFAULT_CHUNK_SIZE * 1024 * 1024)
+    , bufferPool(allocator, DEFAULT_CHUNK_SIZE * 1024 * 1024, 8)
+    , postingWriterResource(
+          std::make_unique<PostingWriterResource>(&simplePool, &byteSlicePool, &bufferPool, postingFormatOption))
+    , modifiedPosting(autil::mem_pool::pool_allocator<PostingPair>(&simplePool))
+{
+}
+
+InvertedMemIndexer::BuildShard::~BuildShard() {}
+
 InvertedMemIndexer::~InvertedMemIndexer()
 {
+    _buildShardThreadPool.reset();
     if (_postingTable) {
         PostingTable::Iterator it = _postingTable->CreateIterator();
         while (it.HasNext()) {
@@ -165,6 +181,11 @@ Status InvertedMemIndexer::Init(const std::shared_ptr<IIndexConfig>& indexConfig
         }
         _invertedIndexSegmentUpdater = std::make_unique<InvertedIndexSegmentUpdater>(0, _indexConfig);
     }
+    size_t buildShardCount = autil::EnvUtil::getEnv(BUILD_SHARD_COUNT_ENV, (size_t)1);
+    if (buildShardCount > 1 && _indexerParam.isOnline && SupportShardedBuild() && !InitBuildShards(buildShardCount)) {
+        AUTIL_LOG(WARN, "init [%lu] build shards failed, indexName[%s], fall back to single thread build",
+                  buildShardCount, GetIndexName().c_str());
+    }
     _sealed = false;
     return Status::OK();
 }
@@ -239,6 +260,9 @@ Status InvertedMemIndexer::DoBuild(IDocumentBatch* docBatch)
         AUTIL_LOG(ERROR, "convert doc batch to docs failed");
         return status;
     }
+    if (_buildShardThreadPool && docs.size() > 1) {
+        return DoShardedBuild(docs);
+    }
     for (const auto& doc : docs) {
         auto status = AddDocument(doc);
         RETURN_IF_STATUS_ERROR(status, "add document failed");
@@ -246,6 +270,132 @@ Status InvertedMemIndexer::DoBuild(IDocumentBatch* docBatch)
     return Status::OK();
 }
 
+bool InvertedMemIndexer::SupportShardedBuild() const
+{
+    // sub classes (range, date...) customize AddField/EndDocument, only plain term indexes are sharded
+    InvertedIndexType indexType = _indexConfig->GetInvertedIndexType();
+    return indexType == it_text || indexType == it_pack || indexType == it_expack || indexType == it_string;
+}
+
+bool InvertedMemIndexer::InitBuildShards(size_t shardCount)
+{
+    // the building thread builds one shard itself
+    auto threadPool = std::make_unique<autil::ThreadPool>(shardCount - 1, shardCount, /*stopIfHasException=*/false,
+                                                          "InvertedBuild");
+    if (!threadPool->start("InvertedBuild")) {
+        AUTIL_LOG(ERROR, "start build shard thread pool failed, indexName[%s]", GetIndexName().c_str());
+        return false;
+    }
+    for (size_t i = 0; i < shardCount; ++i) {
+        _buildShards.emplace_back(
+            std::make_unique<BuildShard>(_allocator.get(), _indexFormatOption->GetPostingFormatOption()));
+    }
+    _buildShardThreadPool = std::move(threadPool);
+    AUTIL_LOG(INFO, "index [%s] build with [%lu] term shards", GetIndexName().c_str(), shardCount);
+    return true;
+}
+
+PostingWriterResource* InvertedMemIndexer::GetPostingWriterResource(dictkey_t retrievalHashKey) const
+{
+    if (_buildShards.empty()) {
+        return _postingWriterResource;
+    }
+    return _buildShards[GetBuildShardIdx(retrievalHashKey)]->postingWriterResource.get();
+}
+
+// Terms, the posting table and the doc level writers (bitmap, section attribute, null term) are handled by the
+// building thread in doc order, while positions of a term are only buffered for the shard owning the term. Shards
+// then replay their buffered tokens in parallel. Build returns after all shards finished, so the building doc count
+// published to readers never covers a doc whose postings are partially written.
+Status InvertedMemIndexer::DoShardedBuild(const std::vector<document::IndexDocument*>& docs)
+{
+    Status status = Status::OK();
+    _shardedBuilding = true;
+    for (const auto& doc : docs) {
+        status = AddDocument(doc);
+        if (!status.IsOK()) {
+            break;
+        }
+        for (auto& shard : _buildShards) {
+            size_t lastEnd = shard->pendingDocs.empty() ? 0 : shard->pendingDocs.back().second;
+            if (shard->pendingTokens.size() > lastEnd) {
+                shard->pendingDocs.emplace_back(doc, shard->pendingTokens.size());
+            }
+        }
+    }
+    _shardedBuilding = false;
+    FlushBuildShards();
+    RETURN_IF_STATUS_ERROR(status, "add document failed");
+    return Status::OK();
+}
+
+void InvertedMemIndexer::FlushBuildShards()
+{
+    std::vector<std::future<void>> futures;
+    for (size_t i = 1; i < _buildShards.size(); ++i) {
+        BuildShard* shard = _buildShards[i].get();
+        if (shard->pendingDocs.empty()) {
+            shard->pendingTokens.clear();
+            continue;
+        }
+        auto task = std::make_shared<std::packaged_task<void()>>([this, shard]() { FlushBuildShard(shard); });
+        futures.emplace_back(task->get_future());
+        if (_buildShardThreadPool->pushTask([task]() { (*task)(); }) != autil::ThreadPool::ERROR_NONE) {
+            AUTIL_LOG(WARN, "push build shard task failed, indexName[%s], build in current thread",
+                      GetIndexName().c_str());
+            (*task)();
+        }
+    }
+    FlushBuildShard(_buildShards[0].get());
+    for (auto& future : futures) {
+        future.wait();
+    }
+    for (auto& shard : _buildShards) {
+        _toCompressShortListCount += shard->toCompressShortListCount;
+        shard->toCompressShortListCount = 0;
+        if (NeedEstimateDumpTempMemSize()) {
+            _estimateDumpTempMemSize = std::max(_estimateDumpTempMemSize, shard->estimateDumpTempMemSize);
+        }
+    }
+    for (auto& future : futures) {
+        // rethrow exception of shard task
+        future.get();
+    }
+}
+
+void InvertedMemIndexer::FlushBuildShard(BuildShard* shard) const
+{
+    size_t tokenIdx = 0;
+    for (const auto& [indexDocument, tokenEnd] : shard->pendingDocs) {
+        for (; tokenIdx < tokenEnd; ++tokenIdx) {
+            const auto& token = shard->pendingTokens[tokenIdx];
+            if (token.writer->NotExistInCurrentDoc()) {
+                shard->modifiedPosting.push_back(std::make_pair(token.termKey, token.writer));
+            }
+            token.writer->AddPosition(token.pos, token.posPayload, token.fieldIdxInPack);
+        }
+        for (auto& [termKey, writer] : shard->modifiedPosting) {
+            if (_indexFormatOption->HasTermPayload()) {
+                writer->SetTermPayload(indexDocument->GetTermPayload(termKey));
+            }
+            docpayload_t docPayload =
+                _indexFormatOption->HasDocPayload()
+                    ? indexDocument->GetDocPayload(_indexConfig->GetTruncatePayloadConfig(), termKey)
+                    : 0;
+            writer->EndDocument(indexDocument->GetDocId(), docPayload);
+            shard->toCompressShortListCount += GetToCompressShortListCountDelta(writer->GetDF());
+            if (NeedEstimateDumpTempMemSize()) {
+                shard->estimateDumpTempMemSize =
+                    std::max(shard->estimateDumpTempMemSize, writer->GetEstimateDumpTempMemSize());
+            }
+        }
+        shard->modifiedPosting.clear();
+    }
+    // tokens of a doc failed to add are dropped
+    shard->pendingDocs.clear();
+    shard->pendingTokens.clear();
+}
+
 Status InvertedMemIndexer::AddDocument(document::IndexDocument* doc)
 {
     for (auto fieldId : _fieldIds) {
@@ -353,12 +503,18 @@ void InvertedMemIndexer::EndDocument(const document::IndexDocument& indexDocumen
 }
 
 void InvertedMemIndexer::UpdateToCompressShortListCount(uint32_t df)
+{
+    _toCompressShortListCount += GetToCompressShortListCountDelta(df);
+}
+
+int64_t InvertedMemIndexer::GetToCompressShortListCountDelta(uint32_t df)
 {
     if (df == UNCOMPRESS_SHORT_LIST_MIN_LEN) {
-        _toCompressShortListCount++;
+        return 1;
     } else if (df == UNCOMPRESS_SHORT_LIST_MAX_LEN + 1) {
-        _toCompressShortListCount--;
+        return -1;
     }
+    return 0;
 }
 
 Status InvertedMemIndexer::DoAddNullToken(fieldid_t fieldId)
@@ -438,23 +594,27 @@ void InvertedMemIndexer::DoAddHashToken(DictKeyInfo termKey, const document::Tok
     // AUTIL_LOG(ERROR, "thuhujin index name:%s, key:%s, retrievalHashKey:%lu", _indexConfig->GetIndexName().c_str(),
     //           termKey.ToString().c_str(), retrievalHashKey);
     PostingWriter** pWriter = _postingTable->Find(retrievalHashKey);
+    PostingWriter* writer = nullptr;
     if (pWriter == nullptr) {
         // not found, add a new <term,posting>
-        PostingWriter* postingWriter =
-            IndexFormatWriterCreator::CreatePostingWriter(_indexConfig->GetInvertedIndexType(), _postingWriterResource);
-        _postingTable->Insert(retrievalHashKey, postingWriter);
+        writer = IndexFormatWriterCreator::CreatePostingWriter(_indexConfig->GetInvertedIndexType(),
+                                                               GetPostingWriterResource(retrievalHashKey));
+        _postingTable->Insert(retrievalHashKey, writer);
         _hashKeyVector.push_back(termKey.GetKey());
-
-        postingWriter->AddPosition(tokenBasePos, token->GetPosPayload(), fieldIdxInPack);
-        _modifiedPosting.push_back(std::make_pair(termKey.GetKey(), postingWriter));
     } else {
-        // found, append to the end
-        auto writer = *pWriter;
-        if (writer->NotExistInCurrentDoc()) {
-            _modifiedPosting.push_back(std::make_pair(termKey.GetKey(), writer));
-        }
-        writer->AddPosition(tokenBasePos, token->GetPosPayload(), fieldIdxInPack);
+        writer = *pWriter;
     }
+    if (_shardedBuilding) {
+        // posting writer is owned by its build shard, position is added when flushing the shard
+        _buildShards[GetBuildShardIdx(retrievalHashKey)]->pendingTokens.push_back(
+            {writer, termKey.GetKey(), tokenBasePos, token->GetPosPayload(), fieldIdxInPack});
+        return;
+    }
+    // append to the end
+    if (writer->NotExistInCurrentDoc()) {
+        _modifiedPosting.push_back(std::make_pair(termKey.GetKey(), writer));
+    }
+    writer->AddPosition(tokenBasePos, token->GetPosPayload(), fieldIdxInPack);
 }
 
 Status InvertedMemIndexer::AddField(const document::Field* field)
@@ -801,9 +961,15 @@ void InvertedMemIndexer::UpdateMemUse(indexlibv2::index::BuildingIndexMemoryUseU
     size_t dynamicIndexerCurrentMemUse = _dynamicMemIndexer ? _dynamicMemIndexer->GetCurrentMemoryUse() : 0u;
 
     int64_t currentMemUse = _byteSlicePool->getUsedBytes() + _simplePool.getUsedBytes() + _bufferPool->getUsedBytes();
+    int64_t bufferPoolMemUse = _bufferPool->getUsedBytes();
+    for (const auto& shard : _buildShards) {
+        currentMemUse +=
+            shard->byteSlicePool.getUsedBytes() + shard->simplePool.getUsedBytes() + shard->bufferPool.getUsedBytes();
+        bufferPoolMemUse += shard->bufferPool.getUsedBytes();
+    }
     int64_t dumpTempBufferSize = TieredDictionaryWriter<dictkey_t>::GetInitialMemUse() + _estimateDumpTempMemSize;
     int64_t dumpExpandBufferSize =
-        _bufferPool->getUsedBytes() + _toCompressShortListCount * UNCOMPRESS_SHORT_LIST_DUMP_EXPAND_FACTOR;
+        bufferPoolMemUse + _toCompressShortListCount * UNCOMPRESS_SHORT_LIST_DUMP_EXPAND_FACTOR;
     int64_t dumpFileSize = currentMemUse * 0.2;
     memUpdater->UpdateCurrentMemUse(currentMemUse + attrCurrentMemUse + dynamicIndexerCurrentMemUse);
     memUpdater->EstimateDumpTmpMemUse(std::max(dumpTempBufferSize, attrDumpTmpMemUse));
@@ -30,6 +30,10 @@
 #include "indexlib/util/HashMap.h"
 #include "indexlib/util/SimplePool.h"
 
+namespace autil {
+class ThreadPool;
+}
+
 namespace indexlibv2::index {
 struct DocMapDumpParams;
 class PatchFileInfo;
@@ -57,6 +61,7 @@ class SectionAttributeMemIndexer;
 class MultiShardInvertedMemIndexer;
 class PostingWriter;
 struct PostingWriterResource;
+class PostingFormatOption;
 class IndexFormatOption;
 class DynamicMemIndexer;
 class InvertedIndexSegmentUpdater;
@@ -69,6 +74,8 @@ public:
     using PostingPair = std::pair<dictkey_t, PostingWriter*>;
     using PostingVector = std::vector<PostingPair, autil::mem_pool::pool_allocator<PostingPair>>;
     static constexpr double HASHMAP_INIT_SIZE_FACTOR = 1.3;
+    // number of term-hashed build shards, shards > 1 enables multi-threaded building of one index
+    static constexpr const char* BUILD_SHARD_COUNT_ENV = "INDEXLIB_INVERTED_INDEX_BUILD_SHARD_COUNT";
 
     InvertedMemIndexer(const indexlibv2::index::MemIndexerParameter& indexerParam,
                        const std::shared_ptr<InvertedIndexMetrics>& metrics);
@@ -147,12 +154,47 @@ private:
     std::pair<Status, dictvalue_t> DumpNormalPosting(PostingWriter* writer,
                                                      const std::shared_ptr<file_system::FileWriter>& fileWriter);
     void UpdateToCompressShortListCount(uint32_t df);
+    static int64_t GetToCompressShortListCountDelta(uint32_t df);
     const PostingWriter* GetPostingListWriter(const DictKeyInfo& key) const;
     uint32_t GetDistinctTermCount() const;
     bool NeedEstimateDumpTempMemSize() const;
     Status DoBuild(indexlibv2::document::IDocumentBatch* docBatch);
     void FlushBuffer();
 
+private:
+    // Posting writers of the terms hashed to a build shard are allocated from the shard's own pools and are only
+    // written by the thread building that shard, so shards of one index can be built concurrently without locking.
+    struct BuildShard {
+        struct PendingToken {
+            PostingWriter* writer;
+            dictkey_t termKey;
+            pos_t pos;
+            pospayload_t posPayload;
+            fieldid_t fieldIdxInPack;
+        };
+        BuildShard(util::MMapAllocator* allocator, const PostingFormatOption& postingFormatOption);
+        ~BuildShard();
+
+        util::SimplePool simplePool;
+        autil::mem_pool::Pool byteSlicePool;
+        autil::mem_pool::RecyclePool bufferPool;
+        std::unique_ptr<PostingWriterResource> postingWriterResource;
+        PostingVector modifiedPosting;
+        std::vector<PendingToken> pendingTokens;
+        // <doc, end offset in pendingTokens>
+        std::vector<std::pair<const document::IndexDocument*, size_t>> pendingDocs;
+        int64_t toCompressShortListCount = 0;
+        size_t estimateDumpTempMemSize = 0;
+    };
+
+    bool InitBuildShards(size_t shardCount);
+    bool SupportShardedBuild() const;
+    size_t GetBuildShardIdx(dictkey_t retrievalHashKey) const { return retrievalHashKey % _buildShards.size(); }
+    PostingWriterResource* GetPostingWriterResource(dictkey_t retrievalHashKey) const;
+    Status DoShardedBuild(const std::vector<document::IndexDocument*>& docs);
+    void FlushBuildShards();
+    void FlushBuildShard(BuildShard* shard) const;
+
 protected:
     std::vector<fieldid_t> _fieldIds; // field ids related to this indexer
     pos_t _basePos = 0;
@@ -190,6 +232,10 @@ private:
     bool _sealed = false;
     int32_t _docCount = 0;
 
+    std::vector<std::unique_ptr<BuildShard>> _buildShards;
+    std::unique_ptr<autil::ThreadPool> _buildShardThreadPool;
+    bool _shardedBuilding = false;
+
     friend class MultiShardInvertedMemIndexer;
 
     AUTIL_LOG_DECLARE();
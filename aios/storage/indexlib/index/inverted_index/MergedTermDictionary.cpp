@@ -0,0 +1,209 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/index/inverted_index/MergedTermDictionary.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "indexlib/index/inverted_index/format/dictionary/DictionaryIterator.h"
+#include "indexlib/index/inverted_index/format/dictionary/DictionaryReader.h"
+
+namespace indexlib::index {
+AUTIL_LOG_SETUP(indexlib.index, MergedTermDictionary);
+
+Status MergedTermDictionary::AddSegment(uint32_t segmentIdx, const std::shared_ptr<DictionaryReader>& dictReader)
+{
+    if (!dictReader) {
+        return Status::OK();
+    }
+    try {
+        auto iter = dictReader->CreateIterator();
+        if (!iter) {
+            return Status::Unimplement("dictionary of segment idx [%u] not support iterate", segmentIdx);
+        }
+        index::DictKeyInfo key;
+        dictvalue_t value = 0;
+        while (iter->HasNext()) {
+            iter->Next(key, value);
+            if (key.IsNull()) {
+                _nullTermEntries.push_back({segmentIdx, value});
+                continue;
+            }
+            _pendingEntries.push_back({key.GetKey(), {segmentIdx, value}});
+        }
+    } catch (const std::exception& e) {
+        AUTIL_LOG(ERROR, "iterate dictionary of segment idx [%u] failed, exception [%s]", segmentIdx, e.what());
+        return Status::IOError("iterate dictionary failed, exception [%s]", e.what());
+    }
+    return Status::OK();
+}
+
+void MergedTermDictionary::Inherit(const MergedTermDictionary& other, const std::vector<uint32_t>& segmentIdxMap)
+{
+    assert(other._pendingEntries.empty());
+    assert(_termIndex.empty() && _offsets.empty() && _pendingEntries.empty());
+    auto mapEntry = [&segmentIdxMap](const Entry& entry, Entry& mapped) {
+        if (entry.segmentIdx >= segmentIdxMap.size() || segmentIdxMap[entry.segmentIdx] == INVALID_SEGMENT_IDX) {
+            return false;
+        }
+        mapped = {segmentIdxMap[entry.segmentIdx], entry.dictValue};
+        return true;
+    };
+    auto bySegmentIdx = [](const Entry& lhs, const Entry& rhs) { return lhs.segmentIdx < rhs.segmentIdx; };
+    // terms keep their idx in other unless all their segments are dropped
+    uint32_t otherTermCount = other._offsets.empty() ? 0 : other._offsets.size() - 1;
+    std::vector<uint32_t> termIdxMap(otherTermCount, INVALID_TERM_IDX);
+    _offsets.reserve(otherTermCount + 1);
+    _entries.reserve(other._entries.size());
+    Entry mapped;
+    for (uint32_t termIdx = 0; termIdx < otherTermCount; ++termIdx) {
+        size_t begin = _entries.size();
+        bool sorted = true;
+        for (uint32_t i = other._offsets[termIdx]; i < other._offsets[termIdx + 1]; ++i) {
+            if (mapEntry(other._entries[i], mapped)) {
+                sorted = sorted && (_entries.size() == begin || _entries.back().segmentIdx < mapped.segmentIdx);
+                _entries.push_back(mapped);
+            }
+        }
+        if (_entries.size() == begin) {
+            continue;
+        }
+        if (!sorted) {
+            std::sort(_entries.begin() + begin, _entries.end(), bySegmentIdx);
+        }
+        termIdxMap[termIdx] = _offsets.size();
+        _offsets.push_back(begin);
+    }
+    _offsets.push_back(_entries.size());
+    if (_offsets.size() == other._offsets.size()) {
+        _termIndex = other._termIndex;
+    } else {
+        _termIndex.reserve(_offsets.size() - 1);
+        for (const auto& [key, termIdx] : other._termIndex) {
+            if (termIdxMap[termIdx] != INVALID_TERM_IDX) {
+                _termIndex.emplace(key, termIdxMap[termIdx]);
+            }
+        }
+    }
+    for (const auto& entry : other._nullTermEntries) {
+        if (mapEntry(entry, mapped)) {
+            _nullTermEntries.push_back(mapped);
+        }
+    }
+}
+
+void MergedTermDictionary::Seal()
+{
+    std::sort(_nullTermEntries.begin(), _nullTermEntries.end(),
+              [](const Entry& lhs, const Entry& rhs) { return lhs.segmentIdx < rhs.segmentIdx; });
+    if (_offsets.empty()) {
+        _offsets.push_back(0);
+    }
+    if (_pendingEntries.empty()) {
+        return;
+    }
+    // only entries added since the last seal are sorted, sealed terms keep their idx and entries
+    std::sort(_pendingEntries.begin(), _pendingEntries.end(), [](const PendingEntry& lhs, const PendingEntry& rhs) {
+        return lhs.key != rhs.key ? lhs.key < rhs.key : lhs.entry.segmentIdx < rhs.entry.segmentIdx;
+    });
+    struct PendingRange {
+        uint32_t termIdx;
+        size_t begin;
+        size_t end;
+    };
+    std::vector<PendingRange> sealedTermRanges;
+    std::vector<PendingRange> newTermRanges;
+    uint32_t sealedTermCount = _offsets.size() - 1;
+    for (size_t begin = 0, end = 0; begin < _pendingEntries.size(); begin = end) {
+        dictkey_t key = _pendingEntries[begin].key;
+        for (end = begin + 1; end < _pendingEntries.size() && _pendingEntries[end].key == key; ++end) {}
+        auto iter = _termIndex.find(key);
+        if (iter != _termIndex.end()) {
+            sealedTermRanges.push_back({iter->second, begin, end});
+        } else {
+            uint32_t termIdx = sealedTermCount + newTermRanges.size();
+            _termIndex.emplace(key, termIdx);
+            newTermRanges.push_back({termIdx, begin, end});
+        }
+    }
+
+    std::vector<Entry> entries;
+    std::vector<uint32_t> offsets;
+    if (sealedTermRanges.empty()) {
+        // sealed terms are not touched, new terms are appended
+        entries.swap(_entries);
+        offsets.swap(_offsets);
+    } else {
+        std::sort(sealedTermRanges.begin(), sealedTermRanges.end(),
+                  [](const PendingRange& lhs, const PendingRange& rhs) { return lhs.termIdx < rhs.termIdx; });
+        entries.reserve(_entries.size() + _pendingEntries.size());
+        offsets.reserve(sealedTermCount + newTermRanges.size() + 1);
+        auto range = sealedTermRanges.begin();
+        for (uint32_t termIdx = 0; termIdx < sealedTermCount; ++termIdx) {
+            offsets.push_back(entries.size());
+            uint32_t sealedBegin = _offsets[termIdx];
+            uint32_t sealedEnd = _offsets[termIdx + 1];
+            if (range == sealedTermRanges.end() || range->termIdx != termIdx) {
+                entries.insert(entries.end(), _entries.begin() + sealedBegin, _entries.begin() + sealedEnd);
+                continue;
+            }
+            // both sides are in ascending segment order
+            size_t i = range->begin;
+            for (uint32_t j = sealedBegin; j < sealedEnd; ++j) {
+                for (; i < range->end && _pendingEntries[i].entry.segmentIdx < _entries[j].segmentIdx; ++i) {
+                    entries.push_back(_pendingEntries[i].entry);
+                }
+                entries.push_back(_entries[j]);
+            }
+            for (; i < range->end; ++i) {
+                entries.push_back(_pendingEntries[i].entry);
+            }
+            ++range;
+        }
+        offsets.push_back(entries.size());
+    }
+    entries.reserve(entries.size() + _pendingEntries.size());
+    for (const auto& range : newTermRanges) {
+        for (size_t i = range.begin; i < range.end; ++i) {
+            entries.push_back(_pendingEntries[i].entry);
+        }
+        offsets.push_back(entries.size());
+    }
+    _offsets.swap(offsets);
+    _entries.swap(entries);
+    std::vector<PendingEntry>().swap(_pendingEntries);
+}
+
+MergedTermDictionary::EntryRange MergedTermDictionary::Lookup(const index::DictKeyInfo& key) const
+{
+    if (key.IsNull()) {
+        return {_nullTermEntries.data(), _nullTermEntries.data() + _nullTermEntries.size()};
+    }
+    auto iter = _termIndex.find(key.GetKey());
+    if (iter == _termIndex.end()) {
+        return {nullptr, nullptr};
+    }
+    return {_entries.data() + _offsets[iter->second], _entries.data() + _offsets[iter->second + 1]};
+}
+
+size_t MergedTermDictionary::EstimateMemUsed() const
+{
+    return _termIndex.size() * (sizeof(dictkey_t) + sizeof(uint32_t) + sizeof(void*)) +
+           _termIndex.bucket_count() * sizeof(void*) + _offsets.capacity() * sizeof(uint32_t) +
+           (_entries.capacity() + _nullTermEntries.capacity()) * sizeof(Entry);
+}
+
+} // namespace indexlib::index
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "autil/Log.h"
+#include "indexlib/base/Status.h"
+#include "indexlib/index/common/DictKeyInfo.h"
+#include "indexlib/index/common/Types.h"
+
+namespace indexlib::index {
+class DictionaryReader;
+
+// MergedTermDictionary maps each term of several built segments to the (segment, dict value) list
+// of the segments holding it, so a lookup probes one in-memory table instead of every segment dictionary.
+// Segments are added in segment order, Seal() compacts them into flat arrays. On reopen, Inherit() copies the
+// sealed arrays of the last reader with segment idxs remapped, so only new segments are iterated and sorted, and
+// Seal() merges their entries into the inherited terms in one pass, appending terms not seen before.
+class MergedTermDictionary
+{
+public:
+    struct Entry {
+        uint32_t segmentIdx;
+        dictvalue_t dictValue;
+    };
+    using EntryRange = std::pair<const Entry*, const Entry*>;
+    static constexpr uint32_t INVALID_SEGMENT_IDX = std::numeric_limits<uint32_t>::max();
+
+public:
+    MergedTermDictionary() = default;
+    ~MergedTermDictionary() = default;
+
+    MergedTermDictionary(const MergedTermDictionary&) = delete;
+    MergedTermDictionary& operator=(const MergedTermDictionary&) = delete;
+
+public:
+    Status AddSegment(uint32_t segmentIdx, const std::shared_ptr<DictionaryReader>& dictReader);
+    // take entries of the sealed dictionary other into this empty dictionary, segmentIdxMap[i] is the segment idx in
+    // this dictionary of segment idx i in other, entries of segments mapped to INVALID_SEGMENT_IDX are dropped
+    void Inherit(const MergedTermDictionary& other, const std::vector<uint32_t>& segmentIdxMap);
+    void Seal();
+
+    // entries in ascending segment order, empty if no segment has the term
+    EntryRange Lookup(const index::DictKeyInfo& key) const;
+
+    size_t GetTermCount() const { return _termIndex.size() + (_nullTermEntries.empty() ? 0 : 1); }
+    size_t GetEntryCount() const { return _entries.size() + _nullTermEntries.size(); }
+    size_t EstimateMemUsed() const;
+
+private:
+    struct PendingEntry {
+        dictkey_t key;
+        Entry entry;
+    };
+
+    static constexpr uint32_t INVALID_TERM_IDX = std::numeric_limits<uint32_t>::max();
+
+    std::unordered_map<dictkey_t, uint32_t> _termIndex; // key -> idx of _offsets, new terms get the next idx
+    std::vector<uint32_t> _offsets;                     // term idx -> begin of _entries, one more as end
+    std::vector<Entry> _entries;
+    std::vector<Entry> _nullTermEntries;
+    std::vector<PendingEntry> _pendingEntries;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+
+} // namespace indexlib::index
@@ -133,15 +133,33 @@ Status MultiShardInvertedIndexReader::DoOpen(const std::shared_ptr<InvertedIndex
                                            segId, segStatus);
             }
         }
+        if (_lastReader && _lastReader->_indexReaders.size() == shardIndexConfigs.size()) {
+            indexReader->SetLastReader(_lastReader->_indexReaders[_indexReaders.size()]);
+        }
         RETURN_IF_STATUS_ERROR(indexReader->DoOpen(shardIndexConfig, shardIndexers),
                                "do open shard indexer failed, indexName[%s]", shardIndexConfig->GetIndexName().c_str());
         RETURN_IF_STATUS_ERROR(indexReader->TryOpenTruncateIndexReader(shardIndexConfig, tabletData),
                                "do open shard indexer failed, indexName[%s]", shardIndexConfig->GetIndexName().c_str());
         _indexReaders.push_back(indexReader);
     }
+    _lastReader.reset();
     return Status::OK();
 }
 
+void MultiShardInvertedIndexReader::SetLastReader(const std::shared_ptr<InvertedIndexReader>& lastReader)
+{
+    _lastReader = std::dynamic_pointer_cast<MultiShardInvertedIndexReader>(lastReader);
+}
+
+size_t MultiShardInvertedIndexReader::EvaluateCurrentMemUsed() const
+{
+    size_t memUsed = 0;
+    for (const auto& indexReader : _indexReaders) {
+        memUsed += indexReader->EvaluateCurrentMemUsed();
+    }
+    return memUsed;
+}
+
 future_lite::coro::Lazy<index::Result<PostingIterator*>>
 MultiShardInvertedIndexReader::LookupAsync(const index::Term* term, uint32_t statePoolSize, PostingType type,
                                            autil::mem_pool::Pool* pool, file_system::ReadOption option) noexcept
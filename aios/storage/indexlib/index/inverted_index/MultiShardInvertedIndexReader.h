@@ -46,6 +46,8 @@ public:
                 const indexlibv2::framework::TabletData* tabletData) override;
 
     void SetAccessoryReader(const std::shared_ptr<IndexAccessoryReader>& accessoryReader) override;
+    void SetLastReader(const std::shared_ptr<InvertedIndexReader>& lastReader) override;
+    size_t EvaluateCurrentMemUsed() const override;
 
     index::Result<PostingIterator*> Lookup(const index::Term& term, uint32_t statePoolSize = DEFAULT_STATE_POOL_SIZE,
                                            PostingType type = pt_default,
@@ -86,6 +88,7 @@ private:
     std::vector<std::shared_ptr<InvertedIndexReaderImpl>> _indexReaders;
     std::unique_ptr<ShardingIndexHasher> _indexHasher;
     std::shared_ptr<IndexAccessoryReader> _accessoryReader;
+    std::shared_ptr<MultiShardInvertedIndexReader> _lastReader;
 
     AUTIL_LOG_DECLARE();
 };
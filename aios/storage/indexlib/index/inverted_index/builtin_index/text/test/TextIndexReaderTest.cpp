@@ -1,9 +1,12 @@
+#include "autil/EnvUtil.h"
 #include "autil/mem_pool/SimpleAllocator.h"
 #include "indexlib/framework/SegmentInfo.h"
+#include "indexlib/framework/Version.h"
 #include "indexlib/index/inverted_index/BufferedPostingIterator.h"
 #include "indexlib/index/inverted_index/InvertedDiskIndexer.h"
 #include "indexlib/index/inverted_index/InvertedIndexReaderImpl.h"
 #include "indexlib/index/inverted_index/InvertedMemIndexer.h"
+#include "indexlib/index/inverted_index/MergedTermDictionary.h"
 #include "indexlib/index/inverted_index/builtin_index/bitmap/BitmapPostingIterator.h"
 #include "indexlib/index/inverted_index/builtin_index/test_util/InvertedTestUtil.h"
 #include "indexlib/index/inverted_index/config/DictionaryConfig.h"
@@ -82,7 +85,15 @@ public:
         autil::mem_pool::Pool pool;
         InvertedTestHelper::MakeIndexDocuments(&pool, indexDocs, docCount, baseDocId, &answer);
 
-        for (size_t idx = 0; idx < indexDocs.size(); ++idx) {
+        if (_shardedBuild) {
+            ASSERT_FALSE(writer->_buildShards.empty());
+            std::vector<document::IndexDocument*> docs;
+            for (const auto& indexDoc : indexDocs) {
+                docs.push_back(indexDoc.get());
+            }
+            ASSERT_TRUE(writer->DoShardedBuild(docs).IsOK());
+        }
+        for (size_t idx = 0; !_shardedBuild && idx < indexDocs.size(); ++idx) {
             document::IndexDocument::Iterator iter = indexDocs[idx]->CreateIterator();
             while (iter.HasNext()) {
                 auto s = writer->AddField(iter.Next());
@@ -270,6 +281,23 @@ public:
         }
     }
 
+    std::vector<docid64_t> LookupDocIds(const std::shared_ptr<InvertedIndexReaderImpl>& indexReader,
+                                        const std::string& key)
+    {
+        std::vector<docid64_t> docIds;
+        autil::mem_pool::Pool pool;
+        PostingIterator* iter = indexReader->Lookup(index::Term(key, ""), 1000, pt_default, &pool).ValueOrThrow();
+        if (!iter) {
+            return docIds;
+        }
+        docid64_t docId = INVALID_DOCID;
+        while ((docId = iter->SeekDoc(docId)) != INVALID_DOCID) {
+            docIds.push_back(docId);
+        }
+        IE_POOL_COMPATIBLE_DELETE_CLASS(&pool, iter);
+        return docIds;
+    }
+
     std::shared_ptr<indexlibv2::config::SingleFieldIndexConfig> CreateIndexConfig(bool hasHighFreq = false)
     {
         auto indexConfig = InvertedIndexConfigCreator::CreateSingleFieldIndexConfig();
@@ -284,6 +312,7 @@ public:
 private:
     std::shared_ptr<InvertedTestUtil> _testUtil;
     std::shared_ptr<config::HighFrequencyVocabulary> _vol;
+    bool _shardedBuild = false;
 
     AUTIL_LOG_DECLARE();
 };
@@ -344,6 +373,68 @@ TEST_F(TextIndexReaderTest, testCaseForNoPositionListLookUpWithMultiSegment)
     TestLookUpWithMultiSegment(NO_POSITION_LIST, true);
 }
 
+TEST_F(TextIndexReaderTest, testCaseForLookUpWithShardedBuild)
+{
+    autil::EnvGuard envGuard(InvertedMemIndexer::BUILD_SHARD_COUNT_ENV, "4");
+    _shardedBuild = true;
+    TestLookUpWithManyDoc(OPTION_FLAG_ALL);
+    TestLookUpWithManyDoc(OPTION_FLAG_ALL, true);
+    TestLookUpWithMultiSegment(NO_PAYLOAD);
+    TestLookUpWithMultiSegment(NO_POSITION_LIST, true);
+}
+
+TEST_F(TextIndexReaderTest, testCaseForLookUpWithMergedTermDictionary)
+{
+    autil::EnvGuard envGuard(InvertedIndexReaderImpl::MERGED_TERM_DICTIONARY_ENV, "2");
+    for (bool hasHighFreq : {false, true}) {
+        auto indexConfig = CreateIndexConfig(hasHighFreq);
+        std::vector<uint32_t> docNums = {13, 27, 8, 41, 19};
+        Answer answer;
+        CreateMultiSegmentsData(docNums, indexConfig, answer);
+
+        indexlibv2::framework::Version version;
+        for (size_t i = 0; i < docNums.size(); ++i) {
+            version.AddSegment(i);
+        }
+        InvertedTestUtil::Indexers indexers;
+        ASSERT_TRUE(_testUtil->GetIndexers(_testUtil->_dir, indexConfig, version, indexers).IsOK());
+        // the last reader sees the first three segments, the new one inherits them and merges the others
+        InvertedTestUtil::Indexers lastIndexers(indexers.begin(), indexers.begin() + 3);
+        auto lastReader = std::make_shared<InvertedIndexReaderImpl>(/*InvertedIndexMetrics=*/nullptr);
+        ASSERT_TRUE(lastReader->DoOpen(indexConfig, lastIndexers).IsOK());
+        ASSERT_TRUE(lastReader->_mergedTermDictionary);
+
+        auto indexReader = std::make_shared<InvertedIndexReaderImpl>(/*InvertedIndexMetrics=*/nullptr);
+        indexReader->SetLastReader(lastReader);
+        ASSERT_TRUE(indexReader->DoOpen(indexConfig, indexers).IsOK());
+        ASSERT_TRUE(indexReader->_mergedTermDictionary);
+        ASSERT_FALSE(indexReader->_lastReader);
+        ASSERT_LT(0u, indexReader->EvaluateCurrentMemUsed());
+        ASSERT_EQ(indexReader->_mergedTermDictionary->EstimateMemUsed(), indexReader->EvaluateCurrentMemUsed());
+        CheckIndexReaderLookup(docNums, indexReader, indexConfig, answer);
+
+        // reopen over the same segments shares the sealed dictionary
+        auto sameReader = std::make_shared<InvertedIndexReaderImpl>(/*InvertedIndexMetrics=*/nullptr);
+        sameReader->SetLastReader(indexReader);
+        ASSERT_TRUE(sameReader->DoOpen(indexConfig, indexers).IsOK());
+        ASSERT_EQ(indexReader->_mergedTermDictionary, sameReader->_mergedTermDictionary);
+        CheckIndexReaderLookup(docNums, sameReader, indexConfig, answer);
+
+        std::shared_ptr<InvertedIndexReaderImpl> segmentDictReader;
+        {
+            autil::EnvGuard disableGuard(InvertedIndexReaderImpl::MERGED_TERM_DICTIONARY_ENV, "0");
+            segmentDictReader = _testUtil->CreateIndexReader(docNums, indexConfig);
+        }
+        ASSERT_TRUE(segmentDictReader);
+        ASSERT_FALSE(segmentDictReader->_mergedTermDictionary);
+        ASSERT_EQ(0u, segmentDictReader->EvaluateCurrentMemUsed());
+        for (const auto& [key, _] : answer.postingAnswerMap) {
+            ASSERT_EQ(LookupDocIds(segmentDictReader, key), LookupDocIds(indexReader, key)) << key;
+        }
+        ASSERT_TRUE(LookupDocIds(indexReader, "not_exist_term").empty());
+    }
+}
+
 TEST_F(TextIndexReaderTest, testCaseForDumpEmptySegment)
 {
     TestDumpEmptySegment(OPTION_FLAG_ALL);
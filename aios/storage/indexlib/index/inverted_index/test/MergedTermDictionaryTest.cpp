@@ -0,0 +1,195 @@
+#include "indexlib/index/inverted_index/MergedTermDictionary.h"
+
+#include <map>
+
+#include "indexlib/index/inverted_index/format/dictionary/DictionaryIterator.h"
+#include "indexlib/index/inverted_index/format/dictionary/DictionaryReader.h"
+#include "unittest/unittest.h"
+
+namespace indexlib::index {
+
+namespace {
+class FakeDictionaryIterator : public DictionaryIterator
+{
+public:
+    FakeDictionaryIterator(const std::map<dictkey_t, dictvalue_t>& terms, bool hasNullTerm, dictvalue_t nullTermValue)
+        : _terms(terms)
+        , _iter(_terms.begin())
+        , _hasNullTerm(hasNullTerm)
+        , _nullTermValue(nullTermValue)
+    {
+    }
+    bool HasNext() const override { return _iter != _terms.end() || _hasNullTerm; }
+    void Next(index::DictKeyInfo& key, dictvalue_t& value) override
+    {
+        if (_iter != _terms.end()) {
+            key = index::DictKeyInfo(_iter->first);
+            value = _iter->second;
+            ++_iter;
+            return;
+        }
+        key = index::DictKeyInfo::NULL_TERM;
+        value = _nullTermValue;
+        _hasNullTerm = false;
+    }
+
+private:
+    std::map<dictkey_t, dictvalue_t> _terms;
+    std::map<dictkey_t, dictvalue_t>::const_iterator _iter;
+    bool _hasNullTerm;
+    dictvalue_t _nullTermValue;
+};
+
+class FakeDictionaryReader : public DictionaryReader
+{
+public:
+    FakeDictionaryReader(const std::map<dictkey_t, dictvalue_t>& terms) : _terms(terms) {}
+    Status Open(const std::shared_ptr<file_system::Directory>& directory, const std::string& fileName,
+                bool supportFileCompress) override
+    {
+        return Status::OK();
+    }
+    std::shared_ptr<DictionaryIterator> CreateIterator() const override
+    {
+        return std::make_shared<FakeDictionaryIterator>(_terms, _hasNullTerm, _nullTermValue);
+    }
+    index::Result<bool> InnerLookup(dictkey_t key, file_system::ReadOption option, dictvalue_t& value) noexcept override
+    {
+        return false;
+    }
+    void SetNullTerm(dictvalue_t value)
+    {
+        _hasNullTerm = true;
+        _nullTermValue = value;
+    }
+
+private:
+    std::map<dictkey_t, dictvalue_t> _terms;
+};
+} // namespace
+
+class MergedTermDictionaryTest : public TESTBASE
+{
+public:
+    MergedTermDictionaryTest() = default;
+    ~MergedTermDictionaryTest() = default;
+
+    void setUp() override {}
+    void tearDown() override {}
+
+protected:
+    std::vector<std::pair<uint32_t, dictvalue_t>> Lookup(const MergedTermDictionary& dictionary,
+                                                         const index::DictKeyInfo& key) const
+    {
+        std::vector<std::pair<uint32_t, dictvalue_t>> ret;
+        auto [entry, end] = dictionary.Lookup(key);
+        for (; entry != end; ++entry) {
+            ret.emplace_back(entry->segmentIdx, entry->dictValue);
+        }
+        return ret;
+    }
+};
+
+TEST_F(MergedTermDictionaryTest, testLookup)
+{
+    auto dict0 = std::make_shared<FakeDictionaryReader>(std::map<dictkey_t, dictvalue_t> {{1, 10}, {3, 30}});
+    auto dict2 = std::make_shared<FakeDictionaryReader>(std::map<dictkey_t, dictvalue_t> {{3, 32}, {5, 52}});
+    dict2->SetNullTerm(100);
+
+    MergedTermDictionary dictionary;
+    ASSERT_TRUE(dictionary.AddSegment(0, dict0).IsOK());
+    ASSERT_TRUE(dictionary.AddSegment(1, nullptr).IsOK());
+    ASSERT_TRUE(dictionary.AddSegment(2, dict2).IsOK());
+    dictionary.Seal();
+
+    ASSERT_EQ(4, dictionary.GetTermCount());
+    ASSERT_EQ(5, dictionary.GetEntryCount());
+    using Entries = std::vector<std::pair<uint32_t, dictvalue_t>>;
+    ASSERT_EQ((Entries {{0, 10}}), Lookup(dictionary, index::DictKeyInfo(1)));
+    ASSERT_EQ((Entries {{0, 30}, {2, 32}}), Lookup(dictionary, index::DictKeyInfo(3)));
+    ASSERT_EQ((Entries {{2, 52}}), Lookup(dictionary, index::DictKeyInfo(5)));
+    ASSERT_EQ((Entries {{2, 100}}), Lookup(dictionary, index::DictKeyInfo::NULL_TERM));
+    ASSERT_TRUE(Lookup(dictionary, index::DictKeyInfo(2)).empty());
+    ASSERT_GT(dictionary.EstimateMemUsed(), 0);
+}
+
+TEST_F(MergedTermDictionaryTest, testAddSegmentAfterSeal)
+{
+    auto dict0 = std::make_shared<FakeDictionaryReader>(std::map<dictkey_t, dictvalue_t> {{1, 10}, {3, 30}});
+    auto dict1 = std::make_shared<FakeDictionaryReader>(std::map<dictkey_t, dictvalue_t> {{1, 11}, {4, 41}});
+
+    MergedTermDictionary dictionary;
+    ASSERT_TRUE(dictionary.AddSegment(0, dict0).IsOK());
+    dictionary.Seal();
+    ASSERT_TRUE(dictionary.AddSegment(1, dict1).IsOK());
+    dictionary.Seal();
+
+    using Entries = std::vector<std::pair<uint32_t, dictvalue_t>>;
+    ASSERT_EQ((Entries {{0, 10}, {1, 11}}), Lookup(dictionary, index::DictKeyInfo(1)));
+    ASSERT_EQ((Entries {{0, 30}}), Lookup(dictionary, index::DictKeyInfo(3)));
+    ASSERT_EQ((Entries {{1, 41}}), Lookup(dictionary, index::DictKeyInfo(4)));
+    ASSERT_TRUE(Lookup(dictionary, index::DictKeyInfo::NULL_TERM).empty());
+}
+
+TEST_F(MergedTermDictionaryTest, testInherit)
+{
+    auto dict0 = std::make_shared<FakeDictionaryReader>(std::map<dictkey_t, dictvalue_t> {{1, 10}, {3, 30}});
+    auto dict1 = std::make_shared<FakeDictionaryReader>(std::map<dictkey_t, dictvalue_t> {{1, 11}});
+    dict1->SetNullTerm(101);
+    auto dict2 = std::make_shared<FakeDictionaryReader>(std::map<dictkey_t, dictvalue_t> {{3, 32}, {4, 42}});
+    MergedTermDictionary lastDictionary;
+    ASSERT_TRUE(lastDictionary.AddSegment(0, dict0).IsOK());
+    ASSERT_TRUE(lastDictionary.AddSegment(1, dict1).IsOK());
+    ASSERT_TRUE(lastDictionary.AddSegment(2, dict2).IsOK());
+    lastDictionary.Seal();
+
+    // segment 0 is merged away, segments 1 and 2 move to idx 0 and 1, a new segment is added as idx 2
+    auto dict3 = std::make_shared<FakeDictionaryReader>(std::map<dictkey_t, dictvalue_t> {{1, 13}, {5, 53}});
+    MergedTermDictionary dictionary;
+    dictionary.Inherit(lastDictionary, {MergedTermDictionary::INVALID_SEGMENT_IDX, 0, 1});
+    ASSERT_TRUE(dictionary.AddSegment(2, dict3).IsOK());
+    dictionary.Seal();
+
+    using Entries = std::vector<std::pair<uint32_t, dictvalue_t>>;
+    ASSERT_EQ(5, dictionary.GetTermCount());
+    ASSERT_EQ(6, dictionary.GetEntryCount());
+    ASSERT_EQ((Entries {{0, 11}, {2, 13}}), Lookup(dictionary, index::DictKeyInfo(1)));
+    ASSERT_EQ((Entries {{1, 32}}), Lookup(dictionary, index::DictKeyInfo(3)));
+    ASSERT_EQ((Entries {{1, 42}}), Lookup(dictionary, index::DictKeyInfo(4)));
+    ASSERT_EQ((Entries {{2, 53}}), Lookup(dictionary, index::DictKeyInfo(5)));
+    ASSERT_EQ((Entries {{0, 101}}), Lookup(dictionary, index::DictKeyInfo::NULL_TERM));
+    // the last dictionary is not changed
+    ASSERT_EQ((Entries {{0, 10}, {1, 11}}), Lookup(lastDictionary, index::DictKeyInfo(1)));
+}
+
+TEST_F(MergedTermDictionaryTest, testInheritDropTermAndInsertSegment)
+{
+    auto dict0 = std::make_shared<FakeDictionaryReader>(std::map<dictkey_t, dictvalue_t> {{1, 10}, {2, 20}});
+    auto dict1 = std::make_shared<FakeDictionaryReader>(std::map<dictkey_t, dictvalue_t> {{1, 11}, {3, 31}});
+    MergedTermDictionary lastDictionary;
+    ASSERT_TRUE(lastDictionary.AddSegment(0, dict0).IsOK());
+    ASSERT_TRUE(lastDictionary.AddSegment(1, dict1).IsOK());
+    lastDictionary.Seal();
+
+    // segment 0 is dropped with its only term 2, segment 1 moves to idx 2, a new segment is inserted as idx 0 and
+    // another one appended as idx 1
+    auto newDict0 = std::make_shared<FakeDictionaryReader>(std::map<dictkey_t, dictvalue_t> {{3, 300}, {4, 400}});
+    auto newDict1 = std::make_shared<FakeDictionaryReader>(std::map<dictkey_t, dictvalue_t> {{1, 101}, {2, 201}});
+    MergedTermDictionary dictionary;
+    dictionary.Inherit(lastDictionary, {MergedTermDictionary::INVALID_SEGMENT_IDX, 2});
+    ASSERT_EQ(2, dictionary.GetTermCount());
+    ASSERT_TRUE(dictionary.AddSegment(0, newDict0).IsOK());
+    ASSERT_TRUE(dictionary.AddSegment(1, newDict1).IsOK());
+    dictionary.Seal();
+
+    using Entries = std::vector<std::pair<uint32_t, dictvalue_t>>;
+    ASSERT_EQ(4, dictionary.GetTermCount());
+    ASSERT_EQ(6, dictionary.GetEntryCount());
+    ASSERT_EQ((Entries {{1, 101}, {2, 11}}), Lookup(dictionary, index::DictKeyInfo(1)));
+    ASSERT_EQ((Entries {{1, 201}}), Lookup(dictionary, index::DictKeyInfo(2)));
+    ASSERT_EQ((Entries {{0, 300}, {2, 31}}), Lookup(dictionary, index::DictKeyInfo(3)));
+    ASSERT_EQ((Entries {{0, 400}}), Lookup(dictionary, index::DictKeyInfo(4)));
+    ASSERT_TRUE(Lookup(dictionary, index::DictKeyInfo::NULL_TERM).empty());
+}
+
+} // namespace indexlib::index
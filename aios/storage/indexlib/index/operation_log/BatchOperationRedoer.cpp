@@ -0,0 +1,113 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/index/operation_log/BatchOperationRedoer.h"
+
+#include "autil/ConstString.h"
+#include "indexlib/index/operation_log/OperationBase.h"
+#include "indexlib/index/primary_key/PrimaryKeyIndexReader.h"
+
+namespace indexlib::index {
+AUTIL_LOG_SETUP(indexlib.index, BatchOperationRedoer);
+
+BatchOperationRedoer::BatchOperationRedoer(const PrimaryKeyIndexReader* pkReader, OperationLogProcessor* processor,
+                                           size_t batchSize)
+    : _pkReader(pkReader)
+    , _processor(processor)
+    , _batchSize(batchSize)
+{
+}
+
+BatchOperationRedoer::~BatchOperationRedoer() {}
+
+void BatchOperationRedoer::Redo(const OperationBase* operation,
+                                const std::vector<std::pair<docid_t, docid_t>>& targetRanges)
+{
+    autil::uint128_t pkHash;
+    if (operation->GetPkHash(&pkHash)) {
+        docid_t docId = LookupDocId(pkHash, targetRanges);
+        if (docId != INVALID_DOCID) {
+            [[maybe_unused]] bool processResult = operation->ProcessWithDocId(docId, this);
+        }
+    } else {
+        [[maybe_unused]] bool processResult = operation->Process(_pkReader, this, targetRanges);
+    }
+    if (++_pendingOpCount >= _batchSize) {
+        Flush();
+    }
+}
+
+docid_t BatchOperationRedoer::LookupDocId(const autil::uint128_t& pkHash,
+                                          const std::vector<std::pair<docid_t, docid_t>>& targetRanges)
+{
+    auto iter = _pkLookupResults.find(pkHash);
+    if (iter != _pkLookupResults.end() && iter->second.targetRanges == targetRanges &&
+        _removedDocIds.find(iter->second.docId) == _removedDocIds.end()) {
+        return iter->second.docId;
+    }
+    // pk reader skips deleted docs, so a doc removed in this batch needs a new lookup
+    docid_t docId = INVALID_DOCID;
+    for (const auto& targetRange : targetRanges) {
+        docId = _pkReader->LookupWithDocRange(pkHash, targetRange, /*executor*/ nullptr);
+        if (docId != INVALID_DOCID) {
+            break;
+        }
+    }
+    ++_pkLookupCount;
+    auto& result = _pkLookupResults[pkHash];
+    result.targetRanges = targetRanges;
+    result.docId = docId;
+    return docId;
+}
+
+Status BatchOperationRedoer::RemoveDocument(docid_t docId)
+{
+    _removedDocIds.insert(docId);
+    return _processor->RemoveDocument(docId);
+}
+
+bool BatchOperationRedoer::UpdateFieldValue(docid_t docId, const std::string& fieldName,
+                                            const autil::StringView& value, bool isNull)
+{
+    auto [iter, inserted] = _pendingUpdates[fieldName].try_emplace(docId);
+    if (!inserted) {
+        ++_coalescedUpdateCount;
+    }
+    iter->second = {autil::MakeCString(value.data(), value.size(), &_pool), isNull};
+    return true;
+}
+
+Status BatchOperationRedoer::UpdateFieldTokens(docid_t docId, const document::ModifiedTokens& modifiedTokens)
+{
+    return _processor->UpdateFieldTokens(docId, modifiedTokens);
+}
+
+void BatchOperationRedoer::Flush()
+{
+    for (const auto& [fieldName, docValues] : _pendingUpdates) {
+        for (const auto& [docId, value] : docValues) {
+            if (!_processor->UpdateFieldValue(docId, fieldName, value.first, value.second)) {
+                AUTIL_INTERVAL_LOG2(2, ERROR, "update field [%s] for doc [%d] failed", fieldName.c_str(), docId);
+            }
+        }
+    }
+    _pendingUpdates.clear();
+    _pkLookupResults.clear();
+    _removedDocIds.clear();
+    _pool.reset();
+    _pendingOpCount = 0;
+}
+
+} // namespace indexlib::index
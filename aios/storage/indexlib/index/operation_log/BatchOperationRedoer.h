@@ -0,0 +1,81 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <map>
+#include <unordered_set>
+
+#include "autil/LongHashValue.h"
+#include "autil/Log.h"
+#include "autil/mem_pool/Pool.h"
+#include "indexlib/base/Constant.h"
+#include "indexlib/index/operation_log/OperationLogProcessor.h"
+
+namespace indexlib::index {
+class PrimaryKeyIndexReader;
+class OperationBase;
+
+// Redo operations in batches instead of one by one. Operations on the same pk in one batch share a single pk lookup,
+// attribute updates are buffered and coalesced (last value wins) per field and docid, and are patched field by field
+// in docid order when the batch is flushed. Removes and token updates are forwarded to the processor in order.
+class BatchOperationRedoer : public OperationLogProcessor
+{
+public:
+    static constexpr size_t DEFAULT_BATCH_SIZE = 4096;
+
+    BatchOperationRedoer(const PrimaryKeyIndexReader* pkReader, OperationLogProcessor* processor,
+                         size_t batchSize = DEFAULT_BATCH_SIZE);
+    ~BatchOperationRedoer();
+
+public:
+    void Redo(const OperationBase* operation, const std::vector<std::pair<docid_t, docid_t>>& targetRanges);
+    // patch buffered attribute updates to processor
+    void Flush();
+
+    size_t GetPkLookupCount() const { return _pkLookupCount; }
+    size_t GetCoalescedUpdateCount() const { return _coalescedUpdateCount; }
+
+public:
+    Status RemoveDocument(docid_t docId) override;
+    bool UpdateFieldValue(docid_t docId, const std::string& fieldName, const autil::StringView& value,
+                          bool isNull) override;
+    Status UpdateFieldTokens(docid_t docId, const document::ModifiedTokens& modifiedTokens) override;
+
+private:
+    struct PkLookupResult {
+        std::vector<std::pair<docid_t, docid_t>> targetRanges;
+        docid_t docId = INVALID_DOCID;
+    };
+    docid_t LookupDocId(const autil::uint128_t& pkHash, const std::vector<std::pair<docid_t, docid_t>>& targetRanges);
+
+private:
+    const PrimaryKeyIndexReader* _pkReader = nullptr;
+    OperationLogProcessor* _processor = nullptr;
+    size_t _batchSize = DEFAULT_BATCH_SIZE;
+    size_t _pendingOpCount = 0;
+    autil::mem_pool::Pool _pool;
+    std::map<autil::uint128_t, PkLookupResult> _pkLookupResults;
+    std::unordered_set<docid_t> _removedDocIds;
+    // field name -> docid -> <value, isNull>
+    std::map<std::string, std::map<docid_t, std::pair<autil::StringView, bool>>> _pendingUpdates;
+    size_t _pkLookupCount = 0;
+    size_t _coalescedUpdateCount = 0;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+
+} // namespace indexlib::index
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "autil/LongHashValue.h"
 #include "autil/NoCopyable.h"
 #include "autil/mem_pool/Pool.h"
 #include "indexlib/document/IDocument.h"
@@ -51,6 +52,9 @@ public:
     //[docIdRange.first, docIdRange.second)
     virtual bool Process(const PrimaryKeyIndexReader* pkReader, OperationLogProcessor* processor,
                          const std::vector<std::pair<docid_t, docid_t>>& docidRange) const = 0;
+    // for batch redo, which looks up pk by itself and processes the found doc
+    virtual bool GetPkHash(autil::uint128_t* pkHash) const { return false; }
+    virtual bool ProcessWithDocId(docid_t docId, OperationLogProcessor* processor) const { return false; }
     void SetOperationFieldInfo(const std::shared_ptr<OperationFieldInfo>& operationFieldInfo)
     {
         _operationFieldInfo = operationFieldInfo;
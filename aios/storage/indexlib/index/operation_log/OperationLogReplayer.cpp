@@ -17,6 +17,7 @@
 
 #include "autil/UnitUtil.h"
 #include "indexlib/base/MemoryQuotaController.h"
+#include "indexlib/index/operation_log/BatchOperationRedoer.h"
 #include "indexlib/index/operation_log/OperationBase.h"
 #include "indexlib/index/operation_log/OperationCursor.h"
 #include "indexlib/index/operation_log/OperationIterator.h"
@@ -82,6 +83,7 @@ std::pair<Status, OperationCursor> OperationLogReplayer::InnerDoOperation(const
     OperationIterator iter(_indexers, _indexConfig);
     RETURN2_IF_STATUS_ERROR(iter.Init(skipCursor, locator), invalidCursor, "init operation iterator failed");
     OperationCursor lastCursur = skipCursor;
+    BatchOperationRedoer redoer(pkReader, processor);
     size_t updateCount = 0, deleteCount = 0, skipUpdateCount = 0, skipDeleteCount = 0;
     while (true) {
         auto [nextStatus, hasNext] = iter.HasNext();
@@ -111,10 +113,7 @@ std::pair<Status, OperationCursor> OperationLogReplayer::InnerDoOperation(const
                 AUTIL_LOG(ERROR, "left memory [%s] is not enough", autil::UnitUtil::GiBDebugString(leftMemory).c_str());
                 return {Status::NoMem("left memory is not enough"), invalidCursor};
             }
-            if (!RedoOneOperation(pkReader, processor, operation, targetDocRanges)) {
-                AUTIL_LOG(ERROR, "redo operation failed");
-                return {Status::InternalError("redo operation failed"), invalidCursor};
-            }
+            redoer.Redo(operation, targetDocRanges);
             if (docType == DELETE_DOC) {
                 deleteCount++;
             } else if (docType == UPDATE_FIELD) {
@@ -127,19 +126,14 @@ std::pair<Status, OperationCursor> OperationLogReplayer::InnerDoOperation(const
             break;
         }
     }
+    redoer.Flush();
     AUTIL_LOG(
         INFO,
-        "update redo count [%lu], delete redo count [%lu], skip update redo count[%lu], skip delete redo count [%lu]",
-        updateCount, deleteCount, skipUpdateCount, skipDeleteCount);
+        "update redo count [%lu], delete redo count [%lu], skip update redo count[%lu], skip delete redo count [%lu], "
+        "pk lookup count [%lu], coalesced attribute update count [%lu]",
+        updateCount, deleteCount, skipUpdateCount, skipDeleteCount, redoer.GetPkLookupCount(),
+        redoer.GetCoalescedUpdateCount());
     return {Status::OK(), lastCursur};
 }
 
-bool OperationLogReplayer::RedoOneOperation(const PrimaryKeyIndexReader* pkReader, OperationLogProcessor* processor,
-                                            OperationBase* operation,
-                                            const std::vector<std::pair<docid_t, docid_t>>& targetRanges) const
-{
-    [[maybe_unused]] bool processResult = operation->Process(pkReader, processor, targetRanges);
-    return true;
-}
-
 } // namespace indexlib::index
@@ -61,9 +61,6 @@ private:
                                                         const OperationCursor& cursorEnd,
                                                         const indexlibv2::framework::Locator& locator) const;
 
-    bool RedoOneOperation(const PrimaryKeyIndexReader* pkReader, OperationLogProcessor* processor,
-                          OperationBase* operation, const std::vector<std::pair<docid_t, docid_t>>& targetRange) const;
-
 private:
     std::vector<std::shared_ptr<OperationLogIndexer>> _indexers;
     std::shared_ptr<OperationLogConfig> _indexConfig;
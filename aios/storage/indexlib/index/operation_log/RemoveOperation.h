@@ -44,6 +44,12 @@ public:
     const T& GetPkHash() const { return _pkHash; }
     bool Process(const PrimaryKeyIndexReader* pkReader, OperationLogProcessor* processor,
                  const std::vector<std::pair<docid_t, docid_t>>& docidRange) const override;
+    bool GetPkHash(autil::uint128_t* pkHash) const override
+    {
+        *pkHash = autil::uint128_t(_pkHash);
+        return true;
+    }
+    bool ProcessWithDocId(docid_t docId, OperationLogProcessor* processor) const override;
     const char* GetPkHashPointer() const override { return (char*)(&_pkHash); }
 
 private:
@@ -102,10 +108,16 @@ bool RemoveOperation<T>::Process(const PrimaryKeyIndexReader* pkReader, Operatio
         if (docId == INVALID_DOCID) {
             continue;
         }
-        auto status = processor->RemoveDocument(docId);
-        return status.IsOK();
+        return ProcessWithDocId(docId, processor);
     }
     return true;
 }
 
+template <typename T>
+bool RemoveOperation<T>::ProcessWithDocId(docid_t docId, OperationLogProcessor* processor) const
+{
+    auto status = processor->RemoveDocument(docId);
+    return status.IsOK();
+}
+
 } // namespace indexlib::index
@@ -49,6 +49,12 @@ public:
     const T& GetPkHash() const { return _pkHash; }
     bool Process(const PrimaryKeyIndexReader* pkReader, OperationLogProcessor* processor,
                  const std::vector<std::pair<docid_t, docid_t>>& docidRange) const override;
+    bool GetPkHash(autil::uint128_t* pkHash) const override
+    {
+        *pkHash = autil::uint128_t(_pkHash);
+        return true;
+    }
+    bool ProcessWithDocId(docid_t docId, OperationLogProcessor* processor) const override;
     size_t GetItemSize() { return _itemSize; }
     OperationItem GetOperationItem(size_t itemIdx) { return _items[itemIdx]; }
     const char* GetPkHashPointer() const override { return (char*)(&_pkHash); }
@@ -98,37 +104,44 @@ bool UpdateFieldOperation<T>::Process(const PrimaryKeyIndexReader* pkIndexReader
         if (docId == INVALID_DOCID) {
             continue;
         }
-        bool isAfterSeparator = false;
-        for (uint32_t i = 0; i < _itemSize; i++) {
-            const auto& item = _items[i];
-            fieldid_t fieldId = item.first;
-            if (fieldId == INVALID_FIELDID) {
-                isAfterSeparator = true;
+        return ProcessWithDocId(docId, processor);
+    }
+    return true;
+}
+
+template <typename T>
+bool UpdateFieldOperation<T>::ProcessWithDocId(docid_t docId, OperationLogProcessor* processor) const
+{
+    assert(processor != nullptr);
+    bool isAfterSeparator = false;
+    for (uint32_t i = 0; i < _itemSize; i++) {
+        const auto& item = _items[i];
+        fieldid_t fieldId = item.first;
+        if (fieldId == INVALID_FIELDID) {
+            isAfterSeparator = true;
+            continue;
+        }
+        if (!isAfterSeparator) {
+            // attribute
+            const std::string& fieldName = _operationFieldInfo->GetFieldName(fieldId);
+            if (unlikely(fieldName.empty())) {
                 continue;
             }
-            if (!isAfterSeparator) {
-                // attribute
-                const std::string& fieldName = _operationFieldInfo->GetFieldName(fieldId);
-                if (unlikely(fieldName.empty())) {
-                    continue;
-                }
-                const autil::StringView& value = item.second;
-                bool ret = processor->UpdateFieldValue(docId, fieldName, value, value.empty());
-                if (!ret) {
-                    AUTIL_INTERVAL_LOG2(2, ERROR, "process update field op for doc [%d] failed", docId);
-                }
-            } else {
-                // inverted index
-                autil::DataBuffer buffer((char*)item.second.data(), item.second.size());
-                document::ModifiedTokens modifiedTokens;
-                modifiedTokens.Deserialize(buffer);
-                auto status = processor->UpdateFieldTokens(docId, modifiedTokens);
-                if (not status.IsOK()) {
-                    AUTIL_LOG(WARN, "process update field op for doc [%d] failed", docId);
-                }
+            const autil::StringView& value = item.second;
+            bool ret = processor->UpdateFieldValue(docId, fieldName, value, value.empty());
+            if (!ret) {
+                AUTIL_INTERVAL_LOG2(2, ERROR, "process update field op for doc [%d] failed", docId);
+            }
+        } else {
+            // inverted index
+            autil::DataBuffer buffer((char*)item.second.data(), item.second.size());
+            document::ModifiedTokens modifiedTokens;
+            modifiedTokens.Deserialize(buffer);
+            auto status = processor->UpdateFieldTokens(docId, modifiedTokens);
+            if (not status.IsOK()) {
+                AUTIL_LOG(WARN, "process update field op for doc [%d] failed", docId);
             }
         }
-        return true;
     }
     return true;
 }
@@ -0,0 +1,104 @@
+#include "indexlib/index/operation_log/BatchOperationRedoer.h"
+
+#include "future_lite/coro/Lazy.h"
+#include "indexlib/index/operation_log/RemoveOperation.h"
+#include "indexlib/index/operation_log/UpdateFieldOperation.h"
+#include "indexlib/index/primary_key/PrimaryKeyReader.h"
+#include "unittest/unittest.h"
+
+namespace indexlib::index {
+
+namespace {
+
+class MockPrimaryKeyIndexReader : public indexlibv2::index::PrimaryKeyReader<uint64_t>
+{
+public:
+    MockPrimaryKeyIndexReader() : indexlibv2::index::PrimaryKeyReader<uint64_t>(nullptr) {}
+
+public:
+    MOCK_METHOD(docid64_t, LookupWithDocRange,
+                (const autil::uint128_t&, (std::pair<docid_t, docid_t>), future_lite::Executor*), (const, override));
+};
+
+class MockModifier : public OperationLogProcessor
+{
+public:
+    MOCK_METHOD(Status, RemoveDocument, (docid_t docid), (override));
+    MOCK_METHOD(bool, UpdateFieldValue, (docid_t, const std::string&, const autil::StringView&, bool), (override));
+    MOCK_METHOD(Status, UpdateFieldTokens, (docid_t, const document::ModifiedTokens&), (override));
+};
+}; // namespace
+
+class BatchOperationRedoerTest : public TESTBASE
+{
+public:
+    void setUp() override
+    {
+        _fieldInfo.reset(new OperationFieldInfo());
+        _fieldInfo->TEST_AddField(_fieldId, "price");
+    }
+    void tearDown() override {}
+
+private:
+    std::shared_ptr<UpdateFieldOperation<uint64_t>> MakeUpdateOperation(uint64_t pkHash, const std::string& value)
+    {
+        OperationItem* items = IE_POOL_COMPATIBLE_NEW_VECTOR(&_pool, OperationItem, 1);
+        items[0].first = _fieldId;
+        items[0].second = autil::MakeCString(value, &_pool);
+        auto operation = std::make_shared<UpdateFieldOperation<uint64_t>>(indexlibv2::framework::Locator::DocInfo());
+        operation->Init(pkHash, items, 1, /*segmentId=*/0);
+        operation->SetOperationFieldInfo(_fieldInfo);
+        return operation;
+    }
+
+private:
+    autil::mem_pool::Pool _pool;
+    fieldid_t _fieldId = 1;
+    std::shared_ptr<OperationFieldInfo> _fieldInfo;
+};
+
+TEST_F(BatchOperationRedoerTest, TestCoalesceUpdates)
+{
+    MockPrimaryKeyIndexReader pkReader;
+    MockModifier modifier;
+    std::vector<std::pair<docid_t, docid_t>> docIdRanges({{0, 100}});
+
+    EXPECT_CALL(pkReader, LookupWithDocRange(autil::uint128_t(1), _, _)).WillOnce(Return(10));
+    EXPECT_CALL(pkReader, LookupWithDocRange(autil::uint128_t(2), _, _)).WillOnce(Return(5));
+    {
+        InSequence seq;
+        EXPECT_CALL(modifier, UpdateFieldValue(5, "price", autil::StringView("c"), false)).WillOnce(Return(true));
+        EXPECT_CALL(modifier, UpdateFieldValue(10, "price", autil::StringView("b"), false)).WillOnce(Return(true));
+    }
+
+    BatchOperationRedoer redoer(&pkReader, &modifier);
+    redoer.Redo(MakeUpdateOperation(1, "a").get(), docIdRanges);
+    redoer.Redo(MakeUpdateOperation(1, "b").get(), docIdRanges);
+    redoer.Redo(MakeUpdateOperation(2, "c").get(), docIdRanges);
+    redoer.Flush();
+    ASSERT_EQ(2, redoer.GetPkLookupCount());
+    ASSERT_EQ(1, redoer.GetCoalescedUpdateCount());
+}
+
+TEST_F(BatchOperationRedoerTest, TestLookupAgainAfterRemove)
+{
+    MockPrimaryKeyIndexReader pkReader;
+    MockModifier modifier;
+    std::vector<std::pair<docid_t, docid_t>> docIdRanges({{0, 100}});
+
+    EXPECT_CALL(pkReader, LookupWithDocRange(autil::uint128_t(1), _, _))
+        .WillOnce(Return(10))
+        .WillOnce(Return(INVALID_DOCID));
+    EXPECT_CALL(modifier, RemoveDocument(10)).WillOnce(Return(Status::OK()));
+    EXPECT_CALL(modifier, UpdateFieldValue(_, _, _, _)).Times(0);
+
+    RemoveOperation<uint64_t> removeOperation((indexlibv2::framework::Locator::DocInfo()));
+    removeOperation.Init(1, /*segmentId=*/0);
+    BatchOperationRedoer redoer(&pkReader, &modifier, /*batchSize=*/2);
+    redoer.Redo(&removeOperation, docIdRanges);
+    redoer.Redo(MakeUpdateOperation(1, "a").get(), docIdRanges);
+    redoer.Flush();
+    ASSERT_EQ(2, redoer.GetPkLookupCount());
+}
+
+} // namespace indexlib::index
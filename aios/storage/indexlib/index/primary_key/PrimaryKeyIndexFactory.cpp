@@ -80,10 +80,12 @@ PrimaryKeyIndexFactory::CreateIndexReader(const std::shared_ptr<config::IIndexCo
 {
     auto indexType = GetInvertedIndexType(indexConfig);
     if (indexType == it_primarykey64) {
-        return std::make_unique<index::PrimaryKeyReader<uint64_t>>(indexReaderParam.metricsManager);
+        return std::make_unique<index::PrimaryKeyReader<uint64_t>>(indexReaderParam.metricsManager,
+                                                                   indexReaderParam.segmentReaderCache);
     }
     if (indexType == it_primarykey128) {
-        return std::make_unique<index::PrimaryKeyReader<autil::uint128_t>>(indexReaderParam.metricsManager);
+        return std::make_unique<index::PrimaryKeyReader<autil::uint128_t>>(indexReaderParam.metricsManager,
+                                                                           indexReaderParam.segmentReaderCache);
     }
     assert(false);
     return nullptr;
@@ -20,6 +20,7 @@
 #include "indexlib/base/Status.h"
 #include "indexlib/file_system/IDirectory.h"
 #include "indexlib/framework/Segment.h"
+#include "indexlib/framework/SegmentReaderCache.h"
 #include "indexlib/index/DiskIndexerParameter.h"
 #include "indexlib/index/IDiskIndexer.h"
 #include "indexlib/index/IIndexFactory.h"
@@ -60,6 +61,19 @@ public:
     size_t GetSegmentNum() const { return _segments.size(); }
     std::vector<SegmentDataAdapter::SegmentDataType>& GetLoadSegmentDatas() { return _segments; }
 
+    // empty if any segment data is not from tablet data, e.g. legacy partition data
+    framework::SegmentReaderCache::Segments GetSegments() const
+    {
+        framework::SegmentReaderCache::Segments segments;
+        for (const auto& segmentData : _segments) {
+            if (!segmentData._segment) {
+                return {};
+            }
+            segments.push_back(segmentData._segment);
+        }
+        return segments;
+    }
+
     template <typename Key>
     bool SetSegmentIndexer(const std::shared_ptr<config::IIndexConfig>& indexConfig,
                            std::shared_ptr<PrimaryKeyDiskIndexer<Key>> indexer)
@@ -103,6 +117,10 @@ public:
                 std::shared_ptr<PrimaryKeyDiskIndexer<Key>> oldTypedIndexer;
                 if (oldIndexer) {
                     oldTypedIndexer = std::dynamic_pointer_cast<PrimaryKeyDiskIndexer<Key>>(oldIndexer);
+                    if (oldTypedIndexer == newIndexer) {
+                        // reused indexer opened by last reader
+                        continue;
+                    }
                     if (oldTypedIndexer) {
                         indexer->InhertPkAttributeDiskIndexer(oldTypedIndexer.get());
                     }
@@ -20,6 +20,7 @@
 #include "indexlib/config/IIndexConfig.h"
 #include "indexlib/framework/Segment.h"
 #include "indexlib/framework/SegmentMeta.h"
+#include "indexlib/framework/SegmentReaderCache.h"
 #include "indexlib/framework/TabletData.h"
 #include "indexlib/index/IIndexReader.h"
 #include "indexlib/index/attribute/AttributeIndexFactory.h"
@@ -78,9 +79,11 @@ public:
         std::vector<segmentid_t> _segmentIds;
     } SegmentReaderInfoType;
 
-    explicit PrimaryKeyReader(framework::MetricsManager* metricsManager)
+    explicit PrimaryKeyReader(framework::MetricsManager* metricsManager,
+                              const std::shared_ptr<framework::SegmentReaderCache>& segmentReaderCache = nullptr)
         : PrimaryKeyIndexReader()
         , _metricsManager(metricsManager)
+        , _segmentReaderCache(segmentReaderCache)
     {
     }
 
@@ -188,6 +191,9 @@ protected:
                                                                                            const std::string& fileName);
     [[nodiscard]] inline bool DoOpen(std::vector<SegmentDataAdapter::SegmentDataType>& segmentDatas,
                                      bool forceReverseLookup);
+    [[nodiscard]] bool OpenDiskIndexer(PrimaryKeyLoadPlan* plan,
+                                       const std::shared_ptr<PrimaryKeyDiskIndexer<Key>>& diskIndexer,
+                                       std::string& fileName);
     inline void InnerInitbuilding();
     inline void InnerInit();
     void AppendBuildingIndexes(const std::shared_ptr<config::IIndexConfig>& indexConfig,
@@ -238,6 +244,7 @@ protected:
     std::vector<SegmentReaderInfoType> _segmentReaderList;
     std::vector<SegmentDataAdapter::SegmentDataType> _segmentDatas;
     framework::MetricsManager* _metricsManager;
+    std::shared_ptr<framework::SegmentReaderCache> _segmentReaderCache;
 
 private:
     AUTIL_LOG_DECLARE();
@@ -370,53 +377,33 @@ inline bool PrimaryKeyReader<Key, DerivedType>::DoOpen(std::vector<SegmentDataAd
     } else {
         std::sort(_loadPlans.begin(), _loadPlans.end(), CompByDocCount);
     }
+    size_t reusedIndexerCount = 0;
     for (auto& plan : _loadPlans) {
         std::string fileName(PRIMARY_KEY_DATA_FILE_NAME);
         DiskIndexerParameter indexerParam;
         std::vector<segmentid_t> segments;
         plan->GetSegmentIdList(&segments);
-        indexerParam.metricsManager = _metricsManager;
-        indexerParam.docCount = plan->GetLastSegmentDocCount();
-        auto diskIndexer = std::make_shared<PrimaryKeyDiskIndexer<Key>>(indexerParam);
         _baseDocid += plan->GetDocCount();
-        auto [status, directory] = plan->GetPrimaryKeyDirectory(_primaryKeyIndexConfig);
-        if (!status.IsOK() || nullptr == directory) {
-            AUTIL_LOG(ERROR, "fail to get primary key directory");
-            return false;
-        }
-        auto [st, pkDataDir] = directory->GetDirectory(_primaryKeyIndexConfig->GetIndexName()).StatusWith();
-        if (!st.IsOK() || nullptr == pkDataDir) {
-            AUTIL_LOG(ERROR, "fail to get primary key data directory");
-            return false;
+        auto planSegments = plan->GetSegments();
+        std::shared_ptr<PrimaryKeyDiskIndexer<Key>> diskIndexer;
+        if (_segmentReaderCache) {
+            diskIndexer = _segmentReaderCache->template Get<PrimaryKeyDiskIndexer<Key>>(
+                _primaryKeyIndexConfig->GetIndexType(), _primaryKeyIndexConfig->GetIndexName(), planSegments);
         }
-
-        if (!CanDirectLoad(_primaryKeyIndexConfig) || plan->GetSegmentNum() > 1) {
-            fileName = plan->GetTargetSliceFileName();
-            auto [readerStatus, sliceFileReader] =
-                pkDataDir->CreateFileReader(fileName, indexlib::file_system::FSOT_SLICE).StatusWith();
-            std::shared_ptr<indexlib::file_system::FileWriter> fileWriter;
-            if (!readerStatus.IsOK() || !sliceFileReader) {
-                fileWriter = CreateTargetSliceFile(plan.get(), fileName);
-                if (!fileWriter) {
-                    AUTIL_LOG(ERROR, "fail to create target slice file: [%s]", fileName.c_str());
-                    return false;
-                }
-            }
-            autil::Defer defer([&fileWriter]() {
-                if (fileWriter) {
-                    fileWriter->Close().GetOrThrow();
-                }
-            });
-            if (!diskIndexer->OpenWithSliceFile(_primaryKeyIndexConfig, pkDataDir, fileName)) {
-                AUTIL_LOG(ERROR, "primary key reader open fail [%s]", fileName.c_str());
-                return false;
-            }
+        if (diskIndexer) {
+            // opened by last reader on the same segments
+            ++reusedIndexerCount;
         } else {
-            auto status = diskIndexer->Open(_primaryKeyIndexConfig, directory);
-            if (!status.IsOK()) {
-                AUTIL_LOG(ERROR, "primary key reader open fail [%s]", directory->DebugString().c_str());
+            indexerParam.metricsManager = _metricsManager;
+            indexerParam.docCount = plan->GetLastSegmentDocCount();
+            diskIndexer = std::make_shared<PrimaryKeyDiskIndexer<Key>>(indexerParam);
+            if (!OpenDiskIndexer(plan.get(), diskIndexer, fileName)) {
                 return false;
             }
+            if (_segmentReaderCache) {
+                _segmentReaderCache->Put(_primaryKeyIndexConfig->GetIndexType(),
+                                         _primaryKeyIndexConfig->GetIndexName(), planSegments, diskIndexer);
+            }
         }
         AUTIL_LOG(DEBUG, "primary key load plan target [%s]", fileName.c_str());
         _segmentReaderList.push_back({std::make_pair(plan->GetBaseDocId(), diskIndexer), segments});
@@ -424,7 +411,55 @@ inline bool PrimaryKeyReader<Key, DerivedType>::DoOpen(std::vector<SegmentDataAd
             return false;
         }
     }
+    AUTIL_LOG(INFO, "primary key [%s] open [%lu] load plans, reuse [%lu] opened by last reader",
+              _primaryKeyIndexConfig->GetIndexName().c_str(), _loadPlans.size(), reusedIndexerCount);
+    return true;
+}
 
+template <typename Key, typename DerivedType>
+bool PrimaryKeyReader<Key, DerivedType>::OpenDiskIndexer(PrimaryKeyLoadPlan* plan,
+                                                         const std::shared_ptr<PrimaryKeyDiskIndexer<Key>>& diskIndexer,
+                                                         std::string& fileName)
+{
+    auto [status, directory] = plan->GetPrimaryKeyDirectory(_primaryKeyIndexConfig);
+    if (!status.IsOK() || nullptr == directory) {
+        AUTIL_LOG(ERROR, "fail to get primary key directory");
+        return false;
+    }
+    auto [st, pkDataDir] = directory->GetDirectory(_primaryKeyIndexConfig->GetIndexName()).StatusWith();
+    if (!st.IsOK() || nullptr == pkDataDir) {
+        AUTIL_LOG(ERROR, "fail to get primary key data directory");
+        return false;
+    }
+
+    if (!CanDirectLoad(_primaryKeyIndexConfig) || plan->GetSegmentNum() > 1) {
+        fileName = plan->GetTargetSliceFileName();
+        auto [readerStatus, sliceFileReader] =
+            pkDataDir->CreateFileReader(fileName, indexlib::file_system::FSOT_SLICE).StatusWith();
+        std::shared_ptr<indexlib::file_system::FileWriter> fileWriter;
+        if (!readerStatus.IsOK() || !sliceFileReader) {
+            fileWriter = CreateTargetSliceFile(plan, fileName);
+            if (!fileWriter) {
+                AUTIL_LOG(ERROR, "fail to create target slice file: [%s]", fileName.c_str());
+                return false;
+            }
+        }
+        autil::Defer defer([&fileWriter]() {
+            if (fileWriter) {
+                fileWriter->Close().GetOrThrow();
+            }
+        });
+        if (!diskIndexer->OpenWithSliceFile(_primaryKeyIndexConfig, pkDataDir, fileName)) {
+            AUTIL_LOG(ERROR, "primary key reader open fail [%s]", fileName.c_str());
+            return false;
+        }
+        return true;
+    }
+    auto openStatus = diskIndexer->Open(_primaryKeyIndexConfig, directory);
+    if (!openStatus.IsOK()) {
+        AUTIL_LOG(ERROR, "primary key reader open fail [%s]", directory->DebugString().c_str());
+        return false;
+    }
     return true;
 }
 
@@ -44,6 +44,27 @@ public:
         return false;
     }
 
+    // first run [begin, end) of not deleted docs in [beginDocId, endDocId), begin equals endDocId if all deleted.
+    // the v1 fallback tests docs one by one, callers bound the window to keep each call short
+    std::pair<docid_t, docid_t> GetNextNonDeletedRun(docid_t beginDocId, docid_t endDocId) const
+    {
+        if (_deletionMapReaderV2) {
+            return _deletionMapReaderV2->GetNextNonDeletedRun(beginDocId, endDocId);
+        }
+        docid_t runBegin = beginDocId;
+        while (runBegin < endDocId && IsDeleted(runBegin)) {
+            ++runBegin;
+        }
+        if (runBegin >= endDocId) {
+            return {endDocId, endDocId};
+        }
+        docid_t runEnd = runBegin + 1;
+        while (runEnd < endDocId && !IsDeleted(runEnd)) {
+            ++runEnd;
+        }
+        return {runBegin, runEnd};
+    }
+
 public:
     std::shared_ptr<indexlib::index::DeletionMapReader> _deletionMapReader;
     std::shared_ptr<indexlibv2::index::DeletionMapIndexReader> _deletionMapReaderV2;
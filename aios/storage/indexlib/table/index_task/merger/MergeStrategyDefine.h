@@ -35,6 +35,7 @@ public:
     static constexpr char BALANCE_TREE_MERGE_STRATEGY_NAME[] = "balance_tree";
     static constexpr char SPECIFIC_SEGMENTS_MERGE_STRATEGY_NAME[] = "specific_segments";
     static constexpr char LEVELED_COMPACTION_MERGE_STRATEGY_NAME[] = "leveled_compaction";
+    static constexpr char COST_BASED_MERGE_STRATEGY_NAME[] = "cost_based";
 
 private:
     AUTIL_LOG_DECLARE();
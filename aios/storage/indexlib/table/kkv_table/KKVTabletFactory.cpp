@@ -19,6 +19,7 @@
 #include "indexlib/document/extractor/IDocumentInfoExtractorFactory.h"
 #include "indexlib/document/kkv/KKVDocumentFactory.h"
 #include "indexlib/framework/BuildResource.h"
+#include "indexlib/framework/DefaultMemoryControlStrategy.h"
 #include "indexlib/framework/DiskSegment.h"
 #include "indexlib/framework/EnvironmentVariablesProvider.h"
 #include "indexlib/framework/IMemoryControlStrategy.h"
@@ -173,7 +174,15 @@ std::unique_ptr<indexlib::framework::ITabletValidator> KKVTabletFactory::CreateT
 std::unique_ptr<framework::IMemoryControlStrategy> KKVTabletFactory::CreateMemoryControlStrategy(
     const std::shared_ptr<MemoryQuotaSynchronizer>& buildMemoryQuotaSynchronizer)
 {
-    return nullptr;
+    if (!_options->IsAdaptiveMemTableEnabled()) {
+        return nullptr;
+    }
+    // keep default quota semantics, only the building segment memory limit is adapted
+    // hash table of building segment is allocated at segment open
+    return std::make_unique<framework::DefaultMemoryControlStrategy>(_options->GetSharedTabletOptions(),
+                                                                     buildMemoryQuotaSynchronizer,
+                                                                     /*enableAdaptiveMemTable=*/true,
+                                                                     /*preallocatedMemTable=*/true);
 }
 
 std::unique_ptr<framework::EnvironmentVariablesProvider> KKVTabletFactory::CreateEnvironmentVariablesProvider()
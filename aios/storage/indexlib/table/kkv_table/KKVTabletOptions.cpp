@@ -53,4 +53,17 @@ uint32_t KKVTabletOptions::GetLevelNum() const
     return levelNum;
 }
 
+bool KKVTabletOptions::IsAdaptiveMemTableEnabled() const
+{
+    if (!_tabletOptions->IsOnline()) {
+        return false;
+    }
+    std::string path = "online_index_config.build_config.enable_adaptive_memtable";
+    bool ret = false;
+    if (!_tabletOptions->GetFromRawJson(path, &ret).IsOK()) {
+        return false;
+    }
+    return ret;
+}
+
 } // namespace indexlibv2::table
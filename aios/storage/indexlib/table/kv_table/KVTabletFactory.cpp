@@ -19,6 +19,7 @@
 #include "indexlib/document/extractor/IDocumentInfoExtractorFactory.h"
 #include "indexlib/document/kv/KVDocumentFactory.h"
 #include "indexlib/framework/BuildResource.h"
+#include "indexlib/framework/DefaultMemoryControlStrategy.h"
 #include "indexlib/framework/DiskSegment.h"
 #include "indexlib/framework/EnvironmentVariablesProvider.h"
 #include "indexlib/framework/IMemoryControlStrategy.h"
@@ -184,7 +185,15 @@ std::unique_ptr<indexlib::framework::ITabletValidator> KVTabletFactory::CreateTa
 std::unique_ptr<framework::IMemoryControlStrategy> KVTabletFactory::CreateMemoryControlStrategy(
     const std::shared_ptr<MemoryQuotaSynchronizer>& buildMemoryQuotaSynchronizer)
 {
-    return nullptr;
+    if (!_options->IsAdaptiveMemTableEnabled()) {
+        return nullptr;
+    }
+    // keep default quota semantics, only the building segment memory limit is adapted
+    // hash table of building segment is allocated at segment open
+    return std::make_unique<framework::DefaultMemoryControlStrategy>(_options->GetSharedTabletOptions(),
+                                                                     buildMemoryQuotaSynchronizer,
+                                                                     /*enableAdaptiveMemTable=*/true,
+                                                                     /*preallocatedMemTable=*/true);
 }
 
 std::unique_ptr<framework::EnvironmentVariablesProvider> KVTabletFactory::CreateEnvironmentVariablesProvider()
@@ -28,9 +28,11 @@ public:
 
 public:
     const config::TabletOptions* GetTabletOptions() const { return _tabletOptions.get(); }
+    const std::shared_ptr<config::TabletOptions>& GetSharedTabletOptions() const { return _tabletOptions; }
 
     uint32_t GetShardNum() const;
     uint32_t GetLevelNum() const;
+    bool IsAdaptiveMemTableEnabled() const;
     bool IsMemoryReclaimEnabled() const;
 
 private:
@@ -491,6 +491,41 @@ TEST_P(KVTabletInteTest, TestBuildNoMemWithDump)
     ASSERT_TRUE(memController->GetFreeQuota() > 20);
 }
 
+TEST_P(KVTabletInteTest, TestAdaptiveMemTableAcrossDump)
+{
+    std::string jsonStr = R"( {
+    "online_index_config": {
+        "build_config": {
+            "sharding_column_num" : 2,
+            "level_num" : 3,
+            "enable_adaptive_memtable" : true
+        }
+    }
+    } )";
+    auto tabletOptions = CreateOnlineMultiShardOptions(jsonStr);
+    tabletOptions->SetIsLeader(true);
+    tabletOptions->SetFlushRemote(true);
+    tabletOptions->SetFlushLocal(false);
+    // building segment is sized by the adaptive memtable
+    tabletOptions->TEST_GetOnlineConfig().TEST_GetBuildConfig().TEST_SetBuildingMemoryLimit(-1);
+    tabletOptions->TEST_GetOnlineConfig().TEST_SetMaxRealtimeMemoryUse(128 * 1024 * 1024);
+    framework::IndexRoot indexRoot(GET_TEMP_DATA_PATH(), GET_TEMP_DATA_PATH());
+    KVTableTestHelper helper;
+    ASSERT_TRUE(helper.Open(indexRoot, _tabletSchema, tabletOptions).IsOK());
+    auto tablet = helper.GetTablet();
+    framework::TabletTestAgent agent(tablet);
+    for (size_t i = 0; i < 3; ++i) {
+        // the sealed segment waits in dump queue while the next one allocates its hash table
+        ASSERT_TRUE(helper.BuildSegment(docString1(), /*oneBatch=*/false, /*autoDumpAndReload=*/false).IsOK());
+        agent.TEST_ReportMetrics();
+        ASSERT_TRUE(helper.Build(docString2()).IsOK()) << "round " << i;
+        agent.TEST_ReportMetrics();
+        ASSERT_EQ(MemoryStatus::OK, tablet->CheckMemoryStatus()) << "round " << i;
+        ASSERT_TRUE(helper.TriggerDump().IsOK());
+        agent.TEST_ReportMetrics();
+    }
+}
+
 TEST_P(KVTabletInteTest, TestBuildingSegmentMemCheck)
 {
     std::string jsonStr = R"( {
@@ -23,6 +23,7 @@
 #include "indexlib/index/inverted_index/Common.h"
 #include "indexlib/util/counter/AccumulativeCounter.h"
 #include "indexlib/util/counter/CounterMap.h"
+#include "indexlib/util/counter/StateCounter.h"
 
 namespace indexlibv2::table {
 AUTIL_LOG_SETUP(indexlib.table, NormalTabletMetrics);
@@ -102,6 +103,38 @@ void NormalTabletMetrics::IncInvertedAccess(const std::string& indexName)
     }
 }
 
+std::shared_ptr<indexlib::util::StateCounter> NormalTabletMetrics::GetReopenCounter(const std::string& name)
+{
+    if (!_counterMap) {
+        return nullptr;
+    }
+    std::string counterNodePath = "online.reopen." + name;
+    auto counter = _counterMap->GetStateCounter(counterNodePath);
+    if (!counter) {
+        TABLET_LOG(ERROR, "get counter[%s] failed", counterNodePath.c_str());
+    }
+    return counter;
+}
+
+void NormalTabletMetrics::ReportReaderOpen(size_t inheritedReaderCount, size_t rebuiltReaderCount,
+                                           int64_t openLatencyUs)
+{
+    if (!_inheritedReaderCounter) {
+        _inheritedReaderCounter = GetReopenCounter("inherited_index_reader_count");
+        _rebuiltReaderCounter = GetReopenCounter("rebuilt_index_reader_count");
+        _openReaderLatencyCounter = GetReopenCounter("open_reader_latency_us");
+    }
+    if (_inheritedReaderCounter) {
+        _inheritedReaderCounter->Set(inheritedReaderCount);
+    }
+    if (_rebuiltReaderCounter) {
+        _rebuiltReaderCounter->Set(rebuiltReaderCount);
+    }
+    if (_openReaderLatencyCounter) {
+        _openReaderLatencyCounter->Set(openLatencyUs);
+    }
+}
+
 const NormalTabletMetrics::AccessCounterMap& NormalTabletMetrics::GetAttributeAccessCounter() const
 {
     return _attributeAccessCounter;
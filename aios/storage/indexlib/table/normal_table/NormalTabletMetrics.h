@@ -20,6 +20,7 @@
 namespace indexlib::util {
 class CounterMap;
 class AccumulativeCounter;
+class StateCounter;
 } // namespace indexlib::util
 
 namespace indexlibv2::config {
@@ -52,6 +53,12 @@ public:
     const AccessCounterMap& GetAttributeAccessCounter() const;
     const AccessCounterMap& GetInvertedAccessCounter() const;
 
+    // index readers inherited from last reader and rebuilt in the latest reader open
+    void ReportReaderOpen(size_t inheritedReaderCount, size_t rebuiltReaderCount, int64_t openLatencyUs);
+
+private:
+    std::shared_ptr<indexlib::util::StateCounter> GetReopenCounter(const std::string& name);
+
 private:
     std::string _tabletName;
     std::shared_ptr<indexlib::util::CounterMap> _counterMap;
@@ -59,6 +66,9 @@ private:
     void* schemaSignature = nullptr;
     AccessCounterMap _attributeAccessCounter;
     AccessCounterMap _invertedAccessCounter;
+    std::shared_ptr<indexlib::util::StateCounter> _inheritedReaderCounter;
+    std::shared_ptr<indexlib::util::StateCounter> _rebuiltReaderCounter;
+    std::shared_ptr<indexlib::util::StateCounter> _openReaderLatencyCounter;
 
 private:
     AUTIL_LOG_DECLARE();
@@ -65,14 +65,24 @@ NormalTabletReader::NormalTabletReader(const std::shared_ptr<config::ITabletSche
 Status NormalTabletReader::DoOpen(const std::shared_ptr<framework::TabletData>& tabletData,
                                   const framework::ReadResource& readResource)
 {
+    autil::ScopedTime2 timer;
     index::IndexReaderParameter indexReaderParam;
     RETURN_IF_STATUS_ERROR(PrepareIndexReaderParameter(readResource, indexReaderParam),
                            "prepare indexer parameter failed");
     auto indexFactoryCreator = index::IndexFactoryCreator::GetInstance();
     auto indexConfigs = _schema->GetIndexConfigs();
+    size_t inheritedReaderCount = 0;
     for (const auto& indexConfig : indexConfigs) {
         const auto& indexType = indexConfig->GetIndexType();
         const auto& indexName = indexConfig->GetIndexName();
+        if (IsIndexReaderInheritable(indexType)) {
+            auto lastIndexReader = InheritIndexReader(readResource, indexType, indexName);
+            if (lastIndexReader) {
+                _indexReaderMap[std::pair(indexType, indexName)] = std::move(lastIndexReader);
+                ++inheritedReaderCount;
+                continue;
+            }
+        }
         auto [status, indexFactory] = indexFactoryCreator->Create(indexType);
         if (!status.IsOK()) {
             AUTIL_LOG(ERROR, "create index factory for index type [%s] failed, error: %s", indexType.c_str(),
@@ -84,6 +94,11 @@ Status NormalTabletReader::DoOpen(const std::shared_ptr<framework::TabletData>&
             AUTIL_LOG(ERROR, "create index reader [%s] failed", indexName.c_str());
             return Status::Corruption("create index reader failed");
         }
+        auto invertedIndexReader = dynamic_cast<indexlib::index::InvertedIndexReader*>(indexReader.get());
+        if (invertedIndexReader && readResource.lastTabletReader) {
+            invertedIndexReader->SetLastReader(std::dynamic_pointer_cast<indexlib::index::InvertedIndexReader>(
+                readResource.lastTabletReader->GetIndexReader(indexType, indexName)));
+        }
         status = indexReader->Open(indexConfig, tabletData.get());
         if (!status.IsOK()) {
             AUTIL_LOG(ERROR, "create indexReader IndexType[%s] indexName[%s] failed, status[%s].", indexType.c_str(),
@@ -127,9 +142,38 @@ Status NormalTabletReader::DoOpen(const std::shared_ptr<framework::TabletData>&
     // summary reader need pkReader && attribute reader
     status = InitSummaryReader();
     RETURN_IF_STATUS_ERROR(status, "init summary reader failed.");
+
+    size_t rebuiltReaderCount = _indexReaderMap.size() - inheritedReaderCount;
+    int64_t openLatencyUs = timer.done_us();
+    if (_normalTabletMetrics) {
+        _normalTabletMetrics->ReportReaderOpen(inheritedReaderCount, rebuiltReaderCount, openLatencyUs);
+    }
+    AUTIL_LOG(INFO, "open tablet reader for version [%d], inherit [%lu] index readers, rebuild [%lu], used [%ld]us",
+              _version.GetVersionId(), inheritedReaderCount, rebuiltReaderCount, openLatencyUs);
     return status;
 }
 
+size_t NormalTabletReader::EvaluateCurrentMemUsed() const
+{
+    size_t memUsed = 0;
+    for (const auto& [_, indexReader] : _indexReaderMap) {
+        auto invertedIndexReader = std::dynamic_pointer_cast<indexlib::index::InvertedIndexReader>(indexReader);
+        if (invertedIndexReader) {
+            memUsed += invertedIndexReader->EvaluateCurrentMemUsed();
+        }
+    }
+    return memUsed;
+}
+
+bool NormalTabletReader::IsIndexReaderInheritable(const std::string& indexType)
+{
+    // readers of these types only hold segment indexers and are not modified after open. inverted index readers
+    // are excluded as accessory readers are re-attached on every open, pk and deletion map readers depend on
+    // the resource map of tablet data, summary readers are wired with pk and attribute readers.
+    return indexType == index::ATTRIBUTE_INDEX_TYPE_STR || indexType == index::PACK_ATTRIBUTE_INDEX_TYPE_STR ||
+           indexType == index::SOURCE_INDEX_TYPE_STR || indexType == indexlib::index::FIELD_META_INDEX_TYPE_STR;
+}
+
 void NormalTabletReader::InitFieldMetaIndexFieldNameToReader()
 {
     _fieldMetaIndexFieldNameToReader =
@@ -494,6 +538,7 @@ Status NormalTabletReader::PrepareIndexReaderParameter(const framework::ReadReso
     }
     auto normalTabletMeta = std::make_shared<NormalTabletMeta>(descs);
     indexReaderParam.metricsManager = readResource.metricsManager;
+    indexReaderParam.segmentReaderCache = GetSegmentReaderCache();
     indexReaderParam.sortPatternFunc = [normalTabletMeta](const std::string& name) -> config::SortPattern {
         return normalTabletMeta->GetSortPattern(name);
     };
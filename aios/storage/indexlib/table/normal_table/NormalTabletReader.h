@@ -75,6 +75,7 @@ public:
 
     // redirect to NormalTabletSearcher::Search
     Status Search(const std::string& jsonQuery, std::string& result) const final override;
+    size_t EvaluateCurrentMemUsed() const override;
 
 public:
     std::shared_ptr<NormalTabletInfo> GetNormalTabletInfo() const;
@@ -124,6 +125,7 @@ private:
     Status PrepareIndexReaderParameter(const framework::ReadResource& readResource,
                                        index::IndexReaderParameter& parameter);
     void InitFieldMetaIndexFieldNameToReader();
+    static bool IsIndexReaderInheritable(const std::string& indexType);
 
 private:
     std::shared_ptr<indexlib::index::MultiFieldIndexReader> _multiFieldIndexReader;
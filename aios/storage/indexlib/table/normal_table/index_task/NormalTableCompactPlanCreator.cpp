@@ -46,6 +46,7 @@
 #include "indexlib/table/normal_table/index_task/merger/AdaptiveMergeStrategy.h"
 #include "indexlib/table/normal_table/index_task/merger/BalanceTreeMergeStrategy.h"
 #include "indexlib/table/normal_table/index_task/merger/CombinedMergeStrategy.h"
+#include "indexlib/table/normal_table/index_task/merger/CostBasedMergeStrategy.h"
 #include "indexlib/table/normal_table/index_task/merger/NormalTabletOptimizeMergeStrategy.h"
 #include "indexlib/table/normal_table/index_task/merger/PriorityQueueMergeStrategy.h"
 
@@ -172,6 +173,10 @@ NormalTableCompactPlanCreator::CreateCompactStrategy(const std::string& mergeStr
         auto strategy = std::make_unique<BalanceTreeMergeStrategy>();
         return {NORMAL_TABLE_MERGE_TYPE, std::make_unique<CombinedMergeStrategy>(std::move(strategy))};
     }
+    if (mergeStrategyName == MergeStrategyDefine::COST_BASED_MERGE_STRATEGY_NAME) {
+        auto strategy = std::make_unique<CostBasedMergeStrategy>();
+        return {NORMAL_TABLE_MERGE_TYPE, std::make_unique<CombinedMergeStrategy>(std::move(strategy))};
+    }
     if (mergeStrategyName == MergeStrategyDefine::SPECIFIC_SEGMENTS_MERGE_STRATEGY_NAME) {
         return {NORMAL_TABLE_MERGE_TYPE, std::make_unique<SpecificSegmentsMergeStrategy>()};
     }
@@ -21,6 +21,7 @@
 #include "indexlib/table/index_task/IndexTaskConstant.h"
 #include "indexlib/table/normal_table/Common.h"
 #include "indexlib/table/normal_table/index_task/merger/BalanceTreeMergeStrategy.h"
+#include "indexlib/table/normal_table/index_task/merger/CostBasedMergeStrategy.h"
 #include "indexlib/table/normal_table/index_task/merger/PriorityQueueMergeStrategy.h"
 
 namespace indexlibv2 { namespace table {
@@ -40,6 +41,10 @@ CombinedMergeStrategy::GetMergedSegmentMergePlan(const framework::IndexTaskConte
         auto strategy = dynamic_cast<PriorityQueueMergeStrategy*>(_mergedSegmentStrategy.get());
         assert(strategy != nullptr);
         std::tie(st, mergePlan) = strategy->DoCreateMergePlan(context);
+    } else if (strategyName == MergeStrategyDefine::COST_BASED_MERGE_STRATEGY_NAME) {
+        auto strategy = dynamic_cast<CostBasedMergeStrategy*>(_mergedSegmentStrategy.get());
+        assert(strategy != nullptr);
+        std::tie(st, mergePlan) = strategy->DoCreateMergePlan(context);
     } else {
         AUTIL_LOG(ERROR, "un-supported merge strategy [%s] for merged segment", strategyName.c_str());
         assert(false);
@@ -0,0 +1,259 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/table/normal_table/index_task/merger/CostBasedMergeStrategy.h"
+
+#include "autil/StringTokenizer.h"
+#include "autil/StringUtil.h"
+#include "indexlib/config/MergeConfig.h"
+#include "indexlib/file_system/Directory.h"
+#include "indexlib/table/index_task/IndexTaskConstant.h"
+#include "indexlib/table/normal_table/index_task/merger/NormalTableMergeStrategyUtil.h"
+
+namespace indexlibv2::table {
+AUTIL_LOG_SETUP(indexlib.table, CostBasedMergeStrategy);
+
+std::pair<Status, CostBasedMergeParams>
+CostBasedMergeStrategy::ExtractParams(const config::MergeStrategyParameter& param)
+{
+    CostBasedMergeParams params;
+    std::string mergeParam = param.GetLegacyString();
+    autil::StringUtil::trim(mergeParam);
+    if (mergeParam.empty()) {
+        AUTIL_LOG(INFO, "no specified merge param");
+        return {Status::OK(), params};
+    }
+
+    autil::StringTokenizer st(mergeParam, ";",
+                              autil::StringTokenizer::TOKEN_TRIM | autil::StringTokenizer::TOKEN_IGNORE_EMPTY);
+    for (size_t i = 0; i < st.getNumTokens(); i++) {
+        autil::StringTokenizer kvStr(st[i], "=",
+                                     autil::StringTokenizer::TOKEN_TRIM | autil::StringTokenizer::TOKEN_IGNORE_EMPTY);
+        if (kvStr.getNumTokens() != 2) {
+            auto status = Status::InvalidArgs("invalid parameter [%s] for merge strategy", mergeParam.c_str());
+            AUTIL_LOG(ERROR, "%s", status.ToString().c_str());
+            return {status, params};
+        }
+        const std::string& key = kvStr[0];
+        bool ret = true;
+        if (key == "query-count") {
+            ret = autil::StringUtil::fromString(kvStr[1], params.queryCount);
+        } else if (key == "segment-probe-cost") {
+            ret = autil::StringUtil::fromString(kvStr[1], params.segmentProbeCost) && params.segmentProbeCost >= 0;
+        } else if (key == "deleted-doc-cost") {
+            ret = autil::StringUtil::fromString(kvStr[1], params.deletedDocCost) && params.deletedDocCost >= 0;
+        } else if (key == "io-cost-per-mb") {
+            ret = autil::StringUtil::fromString(kvStr[1], params.ioCostPerMB) && params.ioCostPerMB >= 0;
+        } else if (key == "max-merge-io" || key == "max-merged-segment-size") {
+            uint64_t sizeInMB = 0;
+            ret = autil::StringUtil::fromString(kvStr[1], sizeInMB);
+            uint64_t& target = (key == "max-merge-io") ? params.maxMergeIo : params.maxMergedSegmentSize;
+            target = sizeInMB * 1024 * 1024;
+        } else {
+            AUTIL_LOG(INFO, "Skipping parameter not intended for for cost based merge strategy: [%s]:[%s]",
+                      kvStr[0].c_str(), kvStr[1].c_str());
+        }
+        if (!ret) {
+            auto status = Status::InvalidArgs("invalid parameter [%s] for merge strategy", mergeParam.c_str());
+            AUTIL_LOG(ERROR, "%s", status.ToString().c_str());
+            return {status, params};
+        }
+    }
+    return {Status::OK(), params};
+}
+
+std::pair<Status, std::shared_ptr<MergePlan>>
+CostBasedMergeStrategy::CreateMergePlan(const framework::IndexTaskContext* context)
+{
+    auto [status, mergePlan] = DoCreateMergePlan(context);
+    RETURN2_IF_STATUS_ERROR(status, nullptr, "Create merge plan failed");
+    RETURN2_IF_STATUS_ERROR(MergeStrategy::FillMergePlanTargetInfo(context, mergePlan), mergePlan,
+                            "fill merge plan target info failed");
+    AUTIL_LOG(INFO, "Create merge plan %s", autil::legacy::ToJsonString(mergePlan, true).c_str());
+    return {Status::OK(), mergePlan};
+}
+
+std::pair<Status, std::shared_ptr<MergePlan>>
+CostBasedMergeStrategy::DoCreateMergePlan(const framework::IndexTaskContext* context)
+{
+    auto tabletData = context->GetTabletData();
+    if (tabletData->GetOnDiskVersion().GetSegmentCount() == 0) {
+        AUTIL_LOG(INFO, "empty version, no need create merge plan")
+        return std::make_pair(Status::OK(), std::make_shared<MergePlan>(MERGE_PLAN, MERGE_PLAN));
+    }
+    auto [st, params] = ExtractParams(context->GetMergeConfig().GetMergeStrategyParameter());
+    RETURN2_IF_STATUS_ERROR(st, nullptr, "extract cost based merge params failed");
+    _params = params;
+    AUTIL_LOG(INFO, "cost based merge params %s", _params.DebugString().c_str());
+
+    auto [status, segments] = CollectSegmentCostInfos(tabletData);
+    RETURN2_IF_STATUS_ERROR(status, nullptr, "collect segment cost info failed");
+
+    auto mergePlan = std::make_shared<MergePlan>(/*name=*/MERGE_PLAN, /*type=*/MERGE_PLAN);
+    std::map<segmentid_t, SegmentCostInfo> segmentMap;
+    for (const auto& segment : segments) {
+        segmentMap[segment.segmentId] = segment;
+    }
+    double queryCost = EstimateQueryCost(segments, _params);
+    double mergedQueryCost = queryCost;
+    uint64_t totalMergeIo = 0;
+    for (const auto& group : PlanMerges(segments, _params)) {
+        SegmentMergePlan segmentMergePlan;
+        std::vector<SegmentCostInfo> groupSegments;
+        for (segmentid_t segmentId : group) {
+            segmentMergePlan.AddSrcSegment(segmentId);
+            groupSegments.push_back(segmentMap[segmentId]);
+        }
+        SegmentCostInfo mergedSegment;
+        for (const auto& segment : groupSegments) {
+            mergedSegment.docCount += segment.docCount - std::min(segment.deletedDocCount, segment.docCount);
+            mergedSegment.segmentSize += segment.GetValidSize();
+        }
+        mergedQueryCost += EstimateQueryCost({mergedSegment}, _params) - EstimateQueryCost(groupSegments, _params);
+        totalMergeIo += GetMergeIo(groupSegments);
+        AUTIL_LOG(INFO, "Merge plan generated [%s] by CostBased", segmentMergePlan.ToString().c_str());
+        mergePlan->AddMergePlan(segmentMergePlan);
+    }
+    AUTIL_LOG(INFO,
+              "cost based merge plan [%lu] groups, query cost [%.2lf] -> [%.2lf], merge io [%lu] bytes cost [%.2lf]",
+              mergePlan->Size(), queryCost, mergedQueryCost, totalMergeIo, EstimateMergeIoCost(totalMergeIo, _params));
+    return {Status::OK(), mergePlan};
+}
+
+std::pair<Status, std::vector<SegmentCostInfo>>
+CostBasedMergeStrategy::CollectSegmentCostInfos(const std::shared_ptr<framework::TabletData>& tabletData) const
+{
+    std::vector<SegmentCostInfo> segments;
+    auto slice = tabletData->CreateSlice(framework::Segment::SegmentStatus::ST_BUILT);
+    for (auto iter = slice.begin(); iter != slice.end(); iter++) {
+        auto segment = *iter;
+        if (!segment->GetSegmentInfo()->mergedSegment) {
+            continue;
+        }
+        auto [status, deleteDocCount] = NormalTableMergeStrategyUtil::GetDeleteDocCount(segment.get());
+        RETURN2_IF_STATUS_ERROR(status, segments, "get delete doc count failed, segment[%d]", segment->GetSegmentId());
+        auto ret = segment->GetSegmentDirectory()->GetIDirectory()->GetDirectorySize(/*path=*/"");
+        RETURN2_IF_STATUS_ERROR(ret.Status(), segments, "get directory size fail, dir[%s]",
+                                segment->GetSegmentDirectory()->GetLogicalPath().c_str());
+        SegmentCostInfo info;
+        info.segmentId = segment->GetSegmentId();
+        info.docCount = segment->GetSegmentInfo()->docCount;
+        info.deletedDocCount = static_cast<uint64_t>(deleteDocCount);
+        info.segmentSize = ret.result;
+        segments.push_back(info);
+    }
+    return {Status::OK(), segments};
+}
+
+double CostBasedMergeStrategy::EstimateQueryCost(const std::vector<SegmentCostInfo>& segments,
+                                                 const CostBasedMergeParams& params)
+{
+    uint64_t deletedDocCount = 0;
+    for (const auto& segment : segments) {
+        deletedDocCount += segment.deletedDocCount;
+    }
+    return (double)params.queryCount *
+           (params.segmentProbeCost * segments.size() + params.deletedDocCost * deletedDocCount);
+}
+
+double CostBasedMergeStrategy::EstimateMergeIoCost(uint64_t ioBytes, const CostBasedMergeParams& params)
+{
+    return params.ioCostPerMB * ioBytes / (1024.0 * 1024.0);
+}
+
+uint64_t CostBasedMergeStrategy::GetMergeIo(const std::vector<SegmentCostInfo>& segments)
+{
+    uint64_t io = 0;
+    for (const auto& segment : segments) {
+        // read whole segment, write valid docs
+        io += segment.segmentSize + segment.GetValidSize();
+    }
+    return io;
+}
+
+// Greedy planning: candidates are scanned from small to large, for every group the longest prefix with max positive
+// gain (query cost saved - merge io cost) is taken, then planning goes on with the remaining segments until no group
+// gains or io budget is used up.
+std::vector<std::vector<segmentid_t>> CostBasedMergeStrategy::PlanMerges(const std::vector<SegmentCostInfo>& segments,
+                                                                         const CostBasedMergeParams& params)
+{
+    std::vector<SegmentCostInfo> candidates;
+    for (const auto& segment : segments) {
+        if (segment.GetValidSize() <= params.maxMergedSegmentSize) {
+            candidates.push_back(segment);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const SegmentCostInfo& left, const SegmentCostInfo& right) {
+        if (left.segmentSize != right.segmentSize) {
+            return left.segmentSize < right.segmentSize;
+        }
+        return left.segmentId < right.segmentId;
+    });
+
+    std::vector<std::vector<segmentid_t>> groups;
+    uint64_t remainingIo = params.maxMergeIo;
+    double queryCount = params.queryCount;
+    while (!candidates.empty()) {
+        std::vector<size_t> members;
+        double gain = 0;
+        uint64_t validSize = 0;
+        uint64_t io = 0;
+        uint64_t deletedDocCount = 0;
+        double bestGain = 0;
+        size_t bestCount = 0;
+        uint64_t bestIo = 0;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            const auto& segment = candidates[i];
+            uint64_t segmentValidSize = segment.GetValidSize();
+            uint64_t segmentIo = segment.segmentSize + segmentValidSize;
+            if (validSize + segmentValidSize > params.maxMergedSegmentSize || io + segmentIo > remainingIo) {
+                continue;
+            }
+            double marginalGain = queryCount * params.deletedDocCost * segment.deletedDocCount -
+                                  EstimateMergeIoCost(segmentIo, params);
+            if (!members.empty()) {
+                // every segment merged into the first one is a segment less to probe
+                marginalGain += queryCount * params.segmentProbeCost;
+            }
+            members.push_back(i);
+            gain += marginalGain;
+            validSize += segmentValidSize;
+            io += segmentIo;
+            deletedDocCount += segment.deletedDocCount;
+            bool worthMerge = members.size() > 1 || deletedDocCount > 0;
+            if (worthMerge && gain > bestGain) {
+                bestGain = gain;
+                bestCount = members.size();
+                bestIo = io;
+            }
+        }
+        if (bestCount == 0) {
+            break;
+        }
+        std::vector<segmentid_t> group;
+        for (size_t i = 0; i < bestCount; ++i) {
+            group.push_back(candidates[members[i]].segmentId);
+        }
+        std::sort(group.begin(), group.end());
+        groups.push_back(group);
+        remainingIo -= bestIo;
+        for (size_t i = bestCount; i > 0; --i) {
+            candidates.erase(candidates.begin() + members[i - 1]);
+        }
+    }
+    return groups;
+}
+
+} // namespace indexlibv2::table
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "autil/Log.h"
+#include "indexlib/config/MergeStrategyParameter.h"
+#include "indexlib/framework/Segment.h"
+#include "indexlib/framework/TabletData.h"
+#include "indexlib/framework/index_task/IndexTaskContext.h"
+#include "indexlib/table/index_task/merger/MergePlan.h"
+#include "indexlib/table/index_task/merger/MergeStrategy.h"
+#include "indexlib/table/index_task/merger/MergeStrategyDefine.h"
+
+namespace indexlibv2::table {
+
+// Cost model of cost based merge strategy, all costs are in the same abstract unit.
+// Query side cost of a segment list in one merge period is
+//     queryCount * (segmentProbeCost * segmentCount + deletedDocCost * deletedDocCount)
+// and merge cost of a segment group is ioCostPerMB * (read size + written valid size).
+struct CostBasedMergeParams {
+    static constexpr uint64_t DEFAULT_QUERY_COUNT = 1000000;
+    static constexpr double DEFAULT_SEGMENT_PROBE_COST = 1.0;
+    static constexpr double DEFAULT_DELETED_DOC_COST = 0.000001;
+    static constexpr double DEFAULT_IO_COST_PER_MB = 1000.0;
+    static constexpr uint64_t DEFAULT_MAX_MERGE_IO = std::numeric_limits<uint64_t>::max();
+    static constexpr uint64_t DEFAULT_MAX_MERGED_SEGMENT_SIZE = std::numeric_limits<uint64_t>::max();
+
+    // queries expected to be served between two merges
+    uint64_t queryCount = DEFAULT_QUERY_COUNT;
+    double segmentProbeCost = DEFAULT_SEGMENT_PROBE_COST;
+    double deletedDocCost = DEFAULT_DELETED_DOC_COST;
+    double ioCostPerMB = DEFAULT_IO_COST_PER_MB;
+    // in bytes, total read and write size of one merge
+    uint64_t maxMergeIo = DEFAULT_MAX_MERGE_IO;
+    // in bytes, valid size of one merged segment
+    uint64_t maxMergedSegmentSize = DEFAULT_MAX_MERGED_SEGMENT_SIZE;
+
+    std::string DebugString() const
+    {
+        std::stringstream ss;
+        ss << "queryCount[" << queryCount << "],"
+           << "segmentProbeCost[" << segmentProbeCost << "],"
+           << "deletedDocCost[" << deletedDocCost << "],"
+           << "ioCostPerMB[" << ioCostPerMB << "],"
+           << "maxMergeIo[" << maxMergeIo << "],"
+           << "maxMergedSegmentSize[" << maxMergedSegmentSize << "]";
+        return ss.str();
+    }
+};
+
+struct SegmentCostInfo {
+    segmentid_t segmentId = INVALID_SEGMENTID;
+    uint64_t docCount = 0;
+    uint64_t deletedDocCount = 0;
+    // in bytes
+    uint64_t segmentSize = 0;
+
+    uint64_t GetValidSize() const
+    {
+        if (docCount == 0) {
+            return 0;
+        }
+        // segmentSize * validDocCount may overflow uint64, the quotient fits as validDocCount <= docCount
+        unsigned __int128 validSize = segmentSize;
+        validSize *= docCount - std::min(deletedDocCount, docCount);
+        return static_cast<uint64_t>(validSize / docCount);
+    }
+};
+
+// Pick merged segments to merge by trading query side cost (segments probed, deleted docs scanned) against merge io,
+// total io of all merge plans is limited by max-merge-io.
+class CostBasedMergeStrategy : public MergeStrategy
+{
+public:
+    CostBasedMergeStrategy() = default;
+    ~CostBasedMergeStrategy() = default;
+
+public:
+    std::string GetName() const override { return MergeStrategyDefine::COST_BASED_MERGE_STRATEGY_NAME; }
+    std::pair<Status, std::shared_ptr<MergePlan>> CreateMergePlan(const framework::IndexTaskContext* context) override;
+    std::pair<Status, std::shared_ptr<MergePlan>> DoCreateMergePlan(const framework::IndexTaskContext* context);
+
+public:
+    static std::pair<Status, CostBasedMergeParams> ExtractParams(const config::MergeStrategyParameter& param);
+    // each group is merged into one segment, groups are ordered by planning sequence
+    static std::vector<std::vector<segmentid_t>> PlanMerges(const std::vector<SegmentCostInfo>& segments,
+                                                            const CostBasedMergeParams& params);
+    static double EstimateQueryCost(const std::vector<SegmentCostInfo>& segments, const CostBasedMergeParams& params);
+    static double EstimateMergeIoCost(uint64_t ioBytes, const CostBasedMergeParams& params);
+    static uint64_t GetMergeIo(const std::vector<SegmentCostInfo>& segments);
+
+private:
+    std::pair<Status, std::vector<SegmentCostInfo>>
+    CollectSegmentCostInfos(const std::shared_ptr<framework::TabletData>& tabletData) const;
+
+private:
+    CostBasedMergeParams _params;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+
+} // namespace indexlibv2::table
@@ -0,0 +1,330 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/table/normal_table/index_task/merger/MergePolicySimulator.h"
+
+#include <algorithm>
+#include <set>
+
+#include "indexlib/file_system/IDirectory.h"
+#include "indexlib/framework/SegmentInfo.h"
+#include "indexlib/framework/Version.h"
+#include "indexlib/framework/VersionLoader.h"
+#include "indexlib/framework/index_task/IndexTaskHistory.h"
+#include "indexlib/index/deletionmap/Common.h"
+#include "indexlib/index/deletionmap/DeletionMapDiskIndexer.h"
+#include "indexlib/index/deletionmap/DeletionMapUtil.h"
+
+namespace indexlibv2::table {
+AUTIL_LOG_SETUP(indexlib.table, MergePolicySimulator);
+
+MergeSimulationResult MergePolicySimulator::Run(const std::vector<MergeSimulationStep>& steps,
+                                                const MergePolicy& policy) const
+{
+    segmentid_t nextSegmentId = 0;
+    for (const auto& step : steps) {
+        for (const auto& segment : step.newSegments) {
+            nextSegmentId = std::max(nextSegmentId, segment.segmentId + 1);
+        }
+        for (const auto& [segmentId, _] : step.newDeletedDocCounts) {
+            nextSegmentId = std::max(nextSegmentId, segmentId + 1);
+        }
+    }
+
+    MergeSimulationResult result;
+    std::map<segmentid_t, SegmentCostInfo> liveSegments;
+    // source segment id -> id of the simulated merged segment holding its docs
+    std::map<segmentid_t, segmentid_t> mergedTo;
+    for (const auto& step : steps) {
+        for (const auto& segment : step.newSegments) {
+            liveSegments[segment.segmentId] = segment;
+        }
+        ApplyDeletes(step.newDeletedDocCounts, mergedTo, &liveSegments);
+
+        std::vector<SegmentCostInfo> segments;
+        for (const auto& [_, segment] : liveSegments) {
+            segments.push_back(segment);
+        }
+        for (const auto& group : policy(segments)) {
+            std::vector<SegmentCostInfo> groupSegments;
+            for (segmentid_t segmentId : group) {
+                auto iter = liveSegments.find(segmentId);
+                if (iter == liveSegments.end()) {
+                    AUTIL_LOG(WARN, "policy merges unknown segment [%d], ignore it", segmentId);
+                    continue;
+                }
+                groupSegments.push_back(iter->second);
+                liveSegments.erase(iter);
+            }
+            if (groupSegments.empty()) {
+                continue;
+            }
+            SegmentCostInfo mergedSegment;
+            mergedSegment.segmentId = nextSegmentId++;
+            for (const auto& segment : groupSegments) {
+                mergedSegment.docCount += segment.docCount - std::min(segment.deletedDocCount, segment.docCount);
+                mergedSegment.segmentSize += segment.GetValidSize();
+                mergedTo[segment.segmentId] = mergedSegment.segmentId;
+            }
+            for (auto& [_, targetId] : mergedTo) {
+                auto iter = std::find_if(groupSegments.begin(), groupSegments.end(),
+                                         [targetId = targetId](const auto& s) { return s.segmentId == targetId; });
+                if (iter != groupSegments.end()) {
+                    targetId = mergedSegment.segmentId;
+                }
+            }
+            liveSegments[mergedSegment.segmentId] = mergedSegment;
+            result.mergeIo += CostBasedMergeStrategy::GetMergeIo(groupSegments);
+            result.mergedSegmentCount += groupSegments.size();
+            ++result.mergePlanCount;
+        }
+
+        // queries between this step and the next one see the merged segment list
+        segments.clear();
+        for (const auto& [_, segment] : liveSegments) {
+            segments.push_back(segment);
+        }
+        result.queryCost += CostBasedMergeStrategy::EstimateQueryCost(segments, _costParams);
+        result.maxSegmentCount = std::max(result.maxSegmentCount, segments.size());
+    }
+    result.finalSegmentCount = liveSegments.size();
+    result.mergeIoCost = CostBasedMergeStrategy::EstimateMergeIoCost(result.mergeIo, _costParams);
+    AUTIL_LOG(INFO,
+              "simulate [%lu] steps, query cost [%.2lf], merge io [%lu] bytes cost [%.2lf], merge plan [%lu], "
+              "max segment count [%lu]",
+              steps.size(), result.queryCost, result.mergeIo, result.mergeIoCost, result.mergePlanCount,
+              result.maxSegmentCount);
+    return result;
+}
+
+void MergePolicySimulator::AddDeletedDocs(uint64_t deletedDocCount, SegmentCostInfo* segment)
+{
+    segment->deletedDocCount = std::min(segment->docCount, segment->deletedDocCount + deletedDocCount);
+}
+
+void MergePolicySimulator::ApplyDeletes(const std::map<segmentid_t, uint64_t>& deletedDocCounts,
+                                        const std::map<segmentid_t, segmentid_t>& mergedTo,
+                                        std::map<segmentid_t, SegmentCostInfo>* liveSegments)
+{
+    uint64_t unknownDeletedDocCount = 0;
+    for (const auto& [segmentId, deletedDocCount] : deletedDocCounts) {
+        auto iter = liveSegments->find(segmentId);
+        if (iter == liveSegments->end()) {
+            auto mergedIter = mergedTo.find(segmentId);
+            if (mergedIter != mergedTo.end()) {
+                iter = liveSegments->find(mergedIter->second);
+            }
+        }
+        if (iter == liveSegments->end()) {
+            unknownDeletedDocCount += deletedDocCount;
+            continue;
+        }
+        AddDeletedDocs(deletedDocCount, &iter->second);
+    }
+    if (unknownDeletedDocCount == 0) {
+        return;
+    }
+    // deletes on segments the simulation does not have (e.g. outputs of real merges) spread by valid doc count
+    uint64_t totalValidDocCount = 0;
+    for (const auto& [_, segment] : *liveSegments) {
+        totalValidDocCount += segment.docCount - segment.deletedDocCount;
+    }
+    if (totalValidDocCount == 0) {
+        return;
+    }
+    for (auto& [_, segment] : *liveSegments) {
+        uint64_t validDocCount = segment.docCount - segment.deletedDocCount;
+        AddDeletedDocs((double)unknownDeletedDocCount * validDocCount / totalValidDocCount, &segment);
+    }
+}
+
+MergePolicySimulator::MergePolicy MergePolicySimulator::CreateCostBasedPolicy(const CostBasedMergeParams& params)
+{
+    return [params](const std::vector<SegmentCostInfo>& segments) {
+        return CostBasedMergeStrategy::PlanMerges(segments, params);
+    };
+}
+
+MergePolicySimulator::MergePolicy MergePolicySimulator::CreateSegmentCountPolicy(uint32_t conflictSegmentCount)
+{
+    return [conflictSegmentCount](const std::vector<SegmentCostInfo>& segments) {
+        std::vector<std::vector<segmentid_t>> groups;
+        if (segments.size() > conflictSegmentCount) {
+            std::vector<segmentid_t> group;
+            for (const auto& segment : segments) {
+                group.push_back(segment.segmentId);
+            }
+            groups.push_back(group);
+        }
+        return groups;
+    };
+}
+
+std::vector<MergeSimulationStep>
+MergePolicySimulator::CreateSteps(const std::vector<std::vector<SegmentCostInfo>>& versionSegments)
+{
+    std::vector<MergeSimulationStep> steps;
+    std::map<segmentid_t, SegmentCostInfo> lastSegments;
+    for (const auto& segments : versionSegments) {
+        std::map<segmentid_t, SegmentCostInfo> currentSegments;
+        for (const auto& segment : segments) {
+            currentSegments[segment.segmentId] = segment;
+        }
+        bool hasRemovedSegment = false;
+        for (const auto& [segmentId, _] : lastSegments) {
+            if (currentSegments.count(segmentId) == 0) {
+                hasRemovedSegment = true;
+                break;
+            }
+        }
+        MergeSimulationStep step;
+        for (const auto& [segmentId, segment] : currentSegments) {
+            auto iter = lastSegments.find(segmentId);
+            if (iter == lastSegments.end()) {
+                if (!hasRemovedSegment) {
+                    step.newSegments.push_back(segment);
+                }
+                continue;
+            }
+            if (segment.deletedDocCount > iter->second.deletedDocCount) {
+                step.newDeletedDocCounts[segmentId] = segment.deletedDocCount - iter->second.deletedDocCount;
+            }
+        }
+        steps.push_back(step);
+        lastSegments.swap(currentSegments);
+    }
+    return steps;
+}
+
+std::vector<versionid_t> MergePolicySimulator::CollectReplayVersions(const framework::IndexTaskHistory& history,
+                                                                     const std::string& taskType)
+{
+    std::set<versionid_t> versions;
+    for (const auto& taskLog : history.GetTaskLogs(taskType)) {
+        if (taskLog->GetBaseVersion() != INVALID_VERSIONID) {
+            versions.insert(taskLog->GetBaseVersion());
+        }
+        if (taskLog->GetTargetVersion() != INVALID_VERSIONID) {
+            versions.insert(taskLog->GetTargetVersion());
+        }
+    }
+    return std::vector<versionid_t>(versions.begin(), versions.end());
+}
+
+std::pair<Status, std::vector<SegmentCostInfo>>
+MergePolicySimulator::LoadVersionSegments(const std::shared_ptr<indexlib::file_system::IDirectory>& indexRoot,
+                                          versionid_t versionId)
+{
+    std::vector<SegmentCostInfo> segments;
+    auto [status, version] = framework::VersionLoader::GetVersion(indexRoot, versionId);
+    RETURN2_IF_STATUS_ERROR(status, segments, "load version [%d] failed", versionId);
+
+    std::vector<std::shared_ptr<indexlib::file_system::IDirectory>> deletionMapDirs;
+    for (auto [segmentId, _] : *version) {
+        auto segmentDirName = version->GetSegmentDirName(segmentId);
+        auto [segStatus, segmentDir] = indexRoot->GetDirectory(segmentDirName).StatusWith();
+        RETURN2_IF_STATUS_ERROR(segStatus, segments, "get segment dir [%s] failed", segmentDirName.c_str());
+        framework::SegmentInfo segmentInfo;
+        auto readerOption = indexlib::file_system::ReaderOption::NoCache(indexlib::file_system::FSOT_MEM);
+        status = segmentInfo.Load(segmentDir, readerOption);
+        RETURN2_IF_STATUS_ERROR(status, segments, "load segment info [%s] failed", segmentDirName.c_str());
+        auto [sizeStatus, segmentSize] = segmentDir->GetDirectorySize(/*path=*/"").StatusWith();
+        RETURN2_IF_STATUS_ERROR(sizeStatus, segments, "get directory size of [%s] failed", segmentDirName.c_str());
+
+        SegmentCostInfo info;
+        info.segmentId = segmentId;
+        info.docCount = segmentInfo.docCount;
+        info.segmentSize = segmentSize;
+        segments.push_back(info);
+
+        auto [existStatus, exist] = segmentDir->IsExist(index::DELETION_MAP_INDEX_PATH).StatusWith();
+        RETURN2_IF_STATUS_ERROR(existStatus, segments, "check deletion map of [%s] failed", segmentDirName.c_str());
+        if (exist) {
+            auto [dirStatus, deletionMapDir] = segmentDir->GetDirectory(index::DELETION_MAP_INDEX_PATH).StatusWith();
+            RETURN2_IF_STATUS_ERROR(dirStatus, segments, "get deletion map dir of [%s] failed",
+                                    segmentDirName.c_str());
+            deletionMapDirs.push_back(deletionMapDir);
+        }
+    }
+    for (auto& segment : segments) {
+        auto [delStatus, deletedDocCount] = LoadDeletedDocCount(segment.segmentId, segment.docCount, deletionMapDirs);
+        RETURN2_IF_STATUS_ERROR(delStatus, segments, "load deleted doc count of segment [%d] failed",
+                                segment.segmentId);
+        segment.deletedDocCount = deletedDocCount;
+    }
+    return {Status::OK(), segments};
+}
+
+std::pair<Status, uint64_t> MergePolicySimulator::LoadDeletedDocCount(
+    segmentid_t segmentId, uint64_t docCount,
+    const std::vector<std::shared_ptr<indexlib::file_system::IDirectory>>& deletionMapDirs)
+{
+    // deletion map of segment is in its own deletion map dir, patches from later segments are in theirs
+    std::unique_ptr<index::DeletionMapDiskIndexer> deletionMap;
+    auto fileName = index::DeletionMapUtil::GetDeletionMapFileName(segmentId);
+    for (const auto& deletionMapDir : deletionMapDirs) {
+        auto [status, exist] = deletionMapDir->IsExist(fileName).StatusWith();
+        RETURN2_IF_STATUS_ERROR(status, 0, "check [%s] failed", fileName.c_str());
+        if (!exist) {
+            continue;
+        }
+        auto patchReader = std::make_unique<index::DeletionMapDiskIndexer>(docCount, segmentId);
+        status = patchReader->Open(/*indexConfig=*/nullptr, deletionMapDir);
+        RETURN2_IF_STATUS_ERROR(status, 0, "open deletion map [%s] failed", fileName.c_str());
+        if (!deletionMap) {
+            deletionMap = std::move(patchReader);
+            continue;
+        }
+        auto [patchStatus, patch] = patchReader->GetDeletionMapPatch(segmentId);
+        RETURN2_IF_STATUS_ERROR(patchStatus, 0, "read deletion map patch [%s] failed", fileName.c_str());
+        status = deletionMap->ApplyDeletionMapPatch(patch.get());
+        RETURN2_IF_STATUS_ERROR(status, 0, "apply deletion map patch [%s] failed", fileName.c_str());
+    }
+    return {Status::OK(), deletionMap ? deletionMap->GetDeletedDocCount() : 0};
+}
+
+std::pair<Status, std::vector<MergeSimulationStep>>
+MergePolicySimulator::LoadReplaySteps(const std::shared_ptr<indexlib::file_system::IDirectory>& indexRoot,
+                                      versionid_t latestVersionId, const std::string& taskType)
+{
+    std::vector<MergeSimulationStep> steps;
+    auto [status, latestVersion] = framework::VersionLoader::GetVersion(indexRoot, latestVersionId);
+    RETURN2_IF_STATUS_ERROR(status, steps, "load version [%d] failed", latestVersionId);
+    auto versionIds = CollectReplayVersions(latestVersion->GetIndexTaskHistory(), taskType);
+    if (versionIds.empty() || versionIds.back() < latestVersionId) {
+        versionIds.push_back(latestVersionId);
+    }
+
+    std::vector<std::vector<SegmentCostInfo>> versionSegments;
+    for (versionid_t versionId : versionIds) {
+        if (versionId > latestVersionId) {
+            continue;
+        }
+        auto [hasStatus, hasVersion] = framework::VersionLoader::HasVersion(indexRoot, versionId);
+        RETURN2_IF_STATUS_ERROR(hasStatus, steps, "check version [%d] failed", versionId);
+        if (!hasVersion) {
+            AUTIL_LOG(WARN, "version [%d] in task history is cleaned, skip it", versionId);
+            continue;
+        }
+        auto [loadStatus, segments] = LoadVersionSegments(indexRoot, versionId);
+        RETURN2_IF_STATUS_ERROR(loadStatus, steps, "load segments of version [%d] failed", versionId);
+        versionSegments.push_back(std::move(segments));
+    }
+    AUTIL_LOG(INFO, "load [%lu] versions of task [%s] to replay, latest version [%d]", versionSegments.size(),
+              taskType.c_str(), latestVersionId);
+    return {Status::OK(), CreateSteps(versionSegments)};
+}
+
+} // namespace indexlibv2::table
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "autil/Log.h"
+#include "indexlib/base/Status.h"
+#include "indexlib/table/normal_table/index_task/merger/CostBasedMergeStrategy.h"
+
+namespace indexlib::file_system {
+class IDirectory;
+}
+namespace indexlibv2::framework {
+class IndexTaskHistory;
+}
+
+namespace indexlibv2::table {
+
+// One step of a replayed history: segments dumped or built since last step and docs deleted from existing segments.
+struct MergeSimulationStep {
+    std::vector<SegmentCostInfo> newSegments;
+    // segment id -> deleted doc count added in this step
+    std::map<segmentid_t, uint64_t> newDeletedDocCounts;
+};
+
+struct MergeSimulationResult {
+    double queryCost = 0;
+    double mergeIoCost = 0;
+    uint64_t mergeIo = 0;
+    size_t mergedSegmentCount = 0;
+    size_t mergePlanCount = 0;
+    size_t maxSegmentCount = 0;
+    size_t finalSegmentCount = 0;
+
+    double GetTotalCost() const { return queryCost + mergeIoCost; }
+};
+
+// Offline simulator comparing merge policies on a replayed segment history. Every step adds segments and deletes,
+// charges query cost of the segment list for one merge period, then applies merges picked by the policy and charges
+// their io, both by the cost model of CostBasedMergeParams.
+class MergePolicySimulator
+{
+public:
+    using MergePolicy = std::function<std::vector<std::vector<segmentid_t>>(const std::vector<SegmentCostInfo>&)>;
+
+public:
+    explicit MergePolicySimulator(const CostBasedMergeParams& costParams) : _costParams(costParams) {}
+    ~MergePolicySimulator() = default;
+
+public:
+    MergeSimulationResult Run(const std::vector<MergeSimulationStep>& steps, const MergePolicy& policy) const;
+
+    static MergePolicy CreateCostBasedPolicy(const CostBasedMergeParams& params);
+    // merge all segments once segment count exceeds conflictSegmentCount, like count triggered strategies
+    static MergePolicy CreateSegmentCountPolicy(uint32_t conflictSegmentCount);
+
+    // Build steps from segments of versions ordered from old to new. Segments showing up in a step where other
+    // segments are gone are outputs of a real merge and are skipped, the policy under test decides merges instead.
+    static std::vector<MergeSimulationStep>
+    CreateSteps(const std::vector<std::vector<SegmentCostInfo>>& versionSegments);
+    // versions touched by tasks of taskType in history ordered from old to new, load segment infos of them to replay
+    static std::vector<versionid_t> CollectReplayVersions(const framework::IndexTaskHistory& history,
+                                                          const std::string& taskType);
+    // Segments of version in index root: doc count from segment info, size of segment directory and deleted doc
+    // count of deletion map, including patches in later segments of the version.
+    static std::pair<Status, std::vector<SegmentCostInfo>>
+    LoadVersionSegments(const std::shared_ptr<indexlib::file_system::IDirectory>& indexRoot, versionid_t versionId);
+    // Replay steps of versions touched by tasks of taskType in the history of version latestVersionId, the latest
+    // version is always replayed. Versions already cleaned from index root are skipped.
+    static std::pair<Status, std::vector<MergeSimulationStep>>
+    LoadReplaySteps(const std::shared_ptr<indexlib::file_system::IDirectory>& indexRoot, versionid_t latestVersionId,
+                    const std::string& taskType);
+
+private:
+    static void ApplyDeletes(const std::map<segmentid_t, uint64_t>& deletedDocCounts,
+                             const std::map<segmentid_t, segmentid_t>& mergedTo,
+                             std::map<segmentid_t, SegmentCostInfo>* liveSegments);
+    static void AddDeletedDocs(uint64_t deletedDocCount, SegmentCostInfo* segment);
+    static std::pair<Status, uint64_t> LoadDeletedDocCount(
+        segmentid_t segmentId, uint64_t docCount,
+        const std::vector<std::shared_ptr<indexlib::file_system::IDirectory>>& deletionMapDirs);
+
+private:
+    CostBasedMergeParams _costParams;
+
+private:
+    AUTIL_LOG_DECLARE();
+};
+
+} // namespace indexlibv2::table
@@ -0,0 +1,121 @@
+#include "indexlib/table/normal_table/index_task/merger/CostBasedMergeStrategy.h"
+
+#include <limits>
+
+#include "indexlib/config/MergeStrategyParameter.h"
+#include "indexlib/table/index_task/merger/test/MergeTestHelper.h"
+#include "unittest/unittest.h"
+
+namespace indexlibv2::table {
+
+class CostBasedMergeStrategyTest : public TESTBASE
+{
+public:
+    CostBasedMergeStrategyTest() = default;
+    ~CostBasedMergeStrategyTest() = default;
+
+public:
+    void setUp() override {};
+    void tearDown() override {};
+};
+
+TEST_F(CostBasedMergeStrategyTest, TestExtractParams)
+{
+    config::MergeStrategyParameter param;
+    auto [st, params] = CostBasedMergeStrategy::ExtractParams(param);
+    ASSERT_TRUE(st.IsOK());
+    EXPECT_EQ(CostBasedMergeParams::DEFAULT_QUERY_COUNT, params.queryCount);
+    EXPECT_EQ(CostBasedMergeParams::DEFAULT_MAX_MERGE_IO, params.maxMergeIo);
+
+    param.SetLegacyString("query-count=1000;segment-probe-cost=2.5;deleted-doc-cost=0.01;io-cost-per-mb=10;"
+                          "max-merge-io=100;max-merged-segment-size=20");
+    std::tie(st, params) = CostBasedMergeStrategy::ExtractParams(param);
+    ASSERT_TRUE(st.IsOK());
+    EXPECT_EQ(1000u, params.queryCount);
+    EXPECT_DOUBLE_EQ(2.5, params.segmentProbeCost);
+    EXPECT_DOUBLE_EQ(0.01, params.deletedDocCost);
+    EXPECT_DOUBLE_EQ(10, params.ioCostPerMB);
+    EXPECT_EQ(100ul * 1024 * 1024, params.maxMergeIo);
+    EXPECT_EQ(20ul * 1024 * 1024, params.maxMergedSegmentSize);
+
+    param.SetLegacyString("query-count=abc");
+    ASSERT_FALSE(CostBasedMergeStrategy::ExtractParams(param).first.IsOK());
+    param.SetLegacyString("segment-probe-cost=-1");
+    ASSERT_FALSE(CostBasedMergeStrategy::ExtractParams(param).first.IsOK());
+}
+
+TEST_F(CostBasedMergeStrategyTest, TestGetValidSize)
+{
+    SegmentCostInfo segment {.docCount = 0, .segmentSize = 100};
+    EXPECT_EQ(0u, segment.GetValidSize());
+    segment = {.docCount = 4, .deletedDocCount = 1, .segmentSize = 100};
+    EXPECT_EQ(75u, segment.GetValidSize());
+    segment.deletedDocCount = 10;
+    EXPECT_EQ(0u, segment.GetValidSize());
+    // segmentSize * validDocCount overflows uint64
+    segment = {.docCount = 1ul << 40, .deletedDocCount = 1ul << 39, .segmentSize = 1ul << 40};
+    EXPECT_EQ(1ul << 39, segment.GetValidSize());
+    segment = {.docCount = 3, .deletedDocCount = 0, .segmentSize = std::numeric_limits<uint64_t>::max()};
+    EXPECT_EQ(std::numeric_limits<uint64_t>::max(), segment.GetValidSize());
+}
+
+TEST_F(CostBasedMergeStrategyTest, TestPlanMerges)
+{
+    CostBasedMergeParams params;
+    params.queryCount = 1000;
+    params.segmentProbeCost = 100;
+    params.ioCostPerMB = 100;
+    params.deletedDocCost = 0;
+    const uint64_t MB = 1024 * 1024;
+    std::vector<SegmentCostInfo> segments = {{.segmentId = 0, .docCount = 100, .segmentSize = 100 * MB},
+                                             {.segmentId = 1, .docCount = 100, .segmentSize = 100 * MB},
+                                             {.segmentId = 2, .docCount = 100, .segmentSize = 100 * MB},
+                                             {.segmentId = 3, .docCount = 100, .segmentSize = 10000 * MB}};
+    // merging the large segment costs more io than the probe cost it saves
+    auto groups = CostBasedMergeStrategy::PlanMerges(segments, params);
+    ASSERT_EQ((std::vector<std::vector<segmentid_t>> {{0, 1, 2}}), groups);
+
+    // io budget only allows two segments
+    params.maxMergeIo = 400 * MB;
+    groups = CostBasedMergeStrategy::PlanMerges(segments, params);
+    ASSERT_EQ((std::vector<std::vector<segmentid_t>> {{0, 1}}), groups);
+
+    // merged segment size limited, two groups
+    params.maxMergeIo = CostBasedMergeParams::DEFAULT_MAX_MERGE_IO;
+    params.maxMergedSegmentSize = 200 * MB;
+    segments.push_back({.segmentId = 4, .docCount = 100, .segmentSize = 100 * MB});
+    groups = CostBasedMergeStrategy::PlanMerges(segments, params);
+    ASSERT_EQ((std::vector<std::vector<segmentid_t>> {{0, 1}, {2, 4}}), groups);
+
+    // deleted docs make rewriting large segment worthwhile
+    params.maxMergedSegmentSize = CostBasedMergeParams::DEFAULT_MAX_MERGED_SEGMENT_SIZE;
+    params.deletedDocCost = 20000;
+    segments.pop_back();
+    segments[3].deletedDocCount = 90;
+    groups = CostBasedMergeStrategy::PlanMerges(segments, params);
+    ASSERT_EQ((std::vector<std::vector<segmentid_t>> {{0, 1, 2, 3}}), groups);
+
+    // single segment without deleted docs is never merged
+    groups = CostBasedMergeStrategy::PlanMerges({segments[0]}, params);
+    ASSERT_TRUE(groups.empty());
+}
+
+TEST_F(CostBasedMergeStrategyTest, TestCreateMergePlan)
+{
+    std::string mergeParams = "query-count=1000;segment-probe-cost=100;io-cost-per-mb=100;deleted-doc-cost=0";
+    auto mergeStrategy = std::make_unique<CostBasedMergeStrategy>();
+    MergeTestHelper::TestMergeStrategy(mergeStrategy.get(), /*expectSrcSegments=*/ {{0, 1, 2}}, mergeParams,
+                                       {{.isMerged = true, .docCount = 100, .segmentSize = 100},
+                                        {.isMerged = true, .docCount = 100, .segmentSize = 100},
+                                        {.isMerged = true, .docCount = 100, .segmentSize = 100},
+                                        {.isMerged = true, .docCount = 100, .segmentSize = 10000}});
+
+    mergeStrategy = std::make_unique<CostBasedMergeStrategy>();
+    MergeTestHelper::TestMergeStrategy(mergeStrategy.get(), /*expectSrcSegments=*/ {{0, 1}},
+                                       mergeParams + ";max-merge-io=400",
+                                       {{.isMerged = true, .docCount = 100, .segmentSize = 100},
+                                        {.isMerged = true, .docCount = 100, .segmentSize = 100},
+                                        {.isMerged = true, .docCount = 100, .segmentSize = 100}});
+}
+
+} // namespace indexlibv2::table
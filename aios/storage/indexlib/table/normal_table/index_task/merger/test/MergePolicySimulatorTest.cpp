@@ -0,0 +1,225 @@
+#include "indexlib/table/normal_table/index_task/merger/MergePolicySimulator.h"
+
+#include "indexlib/file_system/IDirectory.h"
+#include "indexlib/framework/SegmentInfo.h"
+#include "indexlib/framework/Version.h"
+#include "indexlib/framework/index_task/IndexTaskHistory.h"
+#include "indexlib/index/deletionmap/Common.h"
+#include "indexlib/index/deletionmap/DeletionMapDiskIndexer.h"
+#include "unittest/unittest.h"
+
+namespace indexlibv2::table {
+
+class MergePolicySimulatorTest : public TESTBASE
+{
+public:
+    MergePolicySimulatorTest() = default;
+    ~MergePolicySimulatorTest() = default;
+
+public:
+    void setUp() override
+    {
+        _params.queryCount = 1000;
+        _params.segmentProbeCost = 100;
+        _params.ioCostPerMB = 100;
+        _params.deletedDocCost = 0;
+    }
+    void tearDown() override {};
+
+private:
+    std::shared_ptr<indexlib::file_system::IDirectory>
+    MakeSegment(const std::shared_ptr<indexlib::file_system::IDirectory>& root, segmentid_t segmentId,
+                uint64_t docCount, const std::string& data);
+    void MakeDeletionMap(const std::shared_ptr<indexlib::file_system::IDirectory>& segmentDir,
+                         segmentid_t targetSegmentId, uint64_t docCount, const std::vector<docid_t>& deletedDocIds);
+    void StoreVersion(const std::shared_ptr<indexlib::file_system::IDirectory>& root,
+                      const framework::Version& version);
+
+private:
+    CostBasedMergeParams _params;
+};
+
+std::shared_ptr<indexlib::file_system::IDirectory>
+MergePolicySimulatorTest::MakeSegment(const std::shared_ptr<indexlib::file_system::IDirectory>& root,
+                                      segmentid_t segmentId, uint64_t docCount, const std::string& data)
+{
+    framework::Version version;
+    auto segmentDir = root->MakeDirectory(version.GetSegmentDirName(segmentId), indexlib::file_system::DirectoryOption())
+                          .GetOrThrow();
+    framework::SegmentInfo segmentInfo;
+    segmentInfo.docCount = docCount;
+    EXPECT_TRUE(segmentInfo.Store(segmentDir).IsOK());
+    EXPECT_TRUE(segmentDir->Store("data", data, indexlib::file_system::WriterOption()).OK());
+    return segmentDir;
+}
+
+void MergePolicySimulatorTest::MakeDeletionMap(const std::shared_ptr<indexlib::file_system::IDirectory>& segmentDir,
+                                               segmentid_t targetSegmentId, uint64_t docCount,
+                                               const std::vector<docid_t>& deletedDocIds)
+{
+    auto deletionMapDir =
+        segmentDir->MakeDirectory(index::DELETION_MAP_INDEX_PATH, indexlib::file_system::DirectoryOption())
+            .GetOrThrow();
+    index::DeletionMapDiskIndexer deletionMap(docCount, targetSegmentId);
+    deletionMap.TEST_InitWithoutOpen();
+    for (docid_t docId : deletedDocIds) {
+        ASSERT_TRUE(deletionMap.Delete(docId).IsOK());
+    }
+    ASSERT_TRUE(deletionMap.Dump(deletionMapDir).IsOK());
+}
+
+void MergePolicySimulatorTest::StoreVersion(const std::shared_ptr<indexlib::file_system::IDirectory>& root,
+                                            const framework::Version& version)
+{
+    ASSERT_TRUE(root->Store(version.GetVersionFileName(), version.ToString(), indexlib::file_system::WriterOption())
+                    .OK());
+}
+
+TEST_F(MergePolicySimulatorTest, TestComparePolicies)
+{
+    const uint64_t MB = 1024 * 1024;
+    std::vector<MergeSimulationStep> steps;
+    for (segmentid_t segmentId = 0; segmentId < 10; ++segmentId) {
+        MergeSimulationStep step;
+        step.newSegments.push_back({.segmentId = segmentId, .docCount = 1000, .segmentSize = 100 * MB});
+        steps.push_back(step);
+    }
+    MergePolicySimulator simulator(_params);
+    auto noMergePolicy = [](const std::vector<SegmentCostInfo>&) { return std::vector<std::vector<segmentid_t>>(); };
+    auto noMergeResult = simulator.Run(steps, noMergePolicy);
+    ASSERT_EQ(0u, noMergeResult.mergeIo);
+    ASSERT_EQ(10u, noMergeResult.finalSegmentCount);
+    ASSERT_EQ(10u, noMergeResult.maxSegmentCount);
+
+    auto countResult = simulator.Run(steps, MergePolicySimulator::CreateSegmentCountPolicy(1));
+    ASSERT_EQ(1u, countResult.finalSegmentCount);
+    ASSERT_EQ(9u, countResult.mergePlanCount);
+
+    auto costBasedResult = simulator.Run(steps, MergePolicySimulator::CreateCostBasedPolicy(_params));
+    ASSERT_LT(costBasedResult.GetTotalCost(), noMergeResult.GetTotalCost());
+    ASSERT_LT(costBasedResult.mergeIo, countResult.mergeIo);
+    ASSERT_LT(costBasedResult.finalSegmentCount, noMergeResult.finalSegmentCount);
+}
+
+TEST_F(MergePolicySimulatorTest, TestDeletesFollowMergedSegments)
+{
+    std::vector<MergeSimulationStep> steps(3);
+    steps[0].newSegments = {{.segmentId = 0, .docCount = 100, .segmentSize = 100},
+                            {.segmentId = 1, .docCount = 100, .segmentSize = 100}};
+    steps[1].newDeletedDocCounts = {{0, 10}};
+    // segment 5 is unknown to the simulation, deletes spread on live segments
+    steps[2].newDeletedDocCounts = {{5, 19}};
+    MergePolicySimulator simulator(_params);
+    std::vector<SegmentCostInfo> lastSegments;
+    auto result = simulator.Run(steps, [&lastSegments](const std::vector<SegmentCostInfo>& segments) {
+        lastSegments = segments;
+        std::vector<std::vector<segmentid_t>> groups;
+        if (segments.size() == 2) {
+            groups.push_back({0, 1});
+        }
+        return groups;
+    });
+    ASSERT_EQ(1u, result.mergePlanCount);
+    ASSERT_EQ(1u, result.finalSegmentCount);
+    ASSERT_EQ(1u, lastSegments.size());
+    // merged segment id is after all ids in steps
+    ASSERT_EQ(6, lastSegments[0].segmentId);
+    ASSERT_EQ(200u, lastSegments[0].docCount);
+    ASSERT_EQ(29u, lastSegments[0].deletedDocCount);
+}
+
+TEST_F(MergePolicySimulatorTest, TestCreateSteps)
+{
+    std::vector<std::vector<SegmentCostInfo>> versionSegments = {
+        {{.segmentId = 0, .docCount = 100}, {.segmentId = 1, .docCount = 100}},
+        {{.segmentId = 0, .docCount = 100, .deletedDocCount = 5},
+         {.segmentId = 1, .docCount = 100},
+         {.segmentId = 2, .docCount = 50}},
+        // 0 and 1 merged into 3
+        {{.segmentId = 2, .docCount = 50, .deletedDocCount = 1}, {.segmentId = 3, .docCount = 195}}};
+    auto steps = MergePolicySimulator::CreateSteps(versionSegments);
+    ASSERT_EQ(3u, steps.size());
+    ASSERT_EQ(2u, steps[0].newSegments.size());
+    ASSERT_EQ(1u, steps[1].newSegments.size());
+    ASSERT_EQ(2, steps[1].newSegments[0].segmentId);
+    ASSERT_EQ((std::map<segmentid_t, uint64_t> {{0, 5}}), steps[1].newDeletedDocCounts);
+    ASSERT_TRUE(steps[2].newSegments.empty());
+    ASSERT_EQ((std::map<segmentid_t, uint64_t> {{2, 1}}), steps[2].newDeletedDocCounts);
+}
+
+TEST_F(MergePolicySimulatorTest, TestCollectReplayVersions)
+{
+    framework::IndexTaskHistory history;
+    std::map<std::string, std::string> taskDesc;
+    history.AddLog("merge", std::make_shared<framework::IndexTaskLog>("task1", 1, 2, 10, taskDesc));
+    history.AddLog("merge", std::make_shared<framework::IndexTaskLog>("task2", 2, 5, 20, taskDesc));
+    history.AddLog("alter_table", std::make_shared<framework::IndexTaskLog>("task3", 5, 6, 30, taskDesc));
+    ASSERT_EQ((std::vector<versionid_t> {1, 2, 5}), MergePolicySimulator::CollectReplayVersions(history, "merge"));
+    ASSERT_TRUE(MergePolicySimulator::CollectReplayVersions(history, "reclaim").empty());
+}
+
+TEST_F(MergePolicySimulatorTest, TestReplayHistoryOnDisk)
+{
+    auto root = indexlib::file_system::IDirectory::GetPhysicalDirectory(GET_TEMP_DATA_PATH());
+    MakeSegment(root, 0, 100, std::string(1000, 'a'));
+    MakeSegment(root, 1, 50, std::string(500, 'b'));
+    auto segment0Dir = root->GetDirectory(framework::Version().GetSegmentDirName(0)).GetOrThrow();
+    // segment 0 deletes docs 0, 1 in its own deletion map, segment 2 patches docs 1, 2, 3 of it
+    MakeDeletionMap(segment0Dir, 0, 100, {0, 1});
+    auto segment2Dir = MakeSegment(root, 2, 10, std::string(100, 'c'));
+    MakeDeletionMap(segment2Dir, 0, 100, {1, 2, 3});
+    // segment 3 is the output of a real merge of 0 and 1
+    MakeSegment(root, 3, 146, std::string(1400, 'd'));
+
+    std::map<std::string, std::string> taskDesc;
+    framework::Version version1(1);
+    version1.AddSegment(0);
+    version1.AddSegment(1);
+    StoreVersion(root, version1);
+    framework::Version version2(2);
+    version2.AddSegment(0);
+    version2.AddSegment(1);
+    version2.AddSegment(2);
+    StoreVersion(root, version2);
+    framework::Version version3(3);
+    version3.AddSegment(2);
+    version3.AddSegment(3);
+    // version 0 is cleaned from disk
+    version3.GetIndexTaskHistory().AddLog("merge", std::make_shared<framework::IndexTaskLog>("t0", 0, 1, 10, taskDesc));
+    version3.GetIndexTaskHistory().AddLog("merge", std::make_shared<framework::IndexTaskLog>("t1", 1, 2, 20, taskDesc));
+    version3.GetIndexTaskHistory().AddLog("merge", std::make_shared<framework::IndexTaskLog>("t2", 2, 3, 30, taskDesc));
+    StoreVersion(root, version3);
+
+    auto [status, segments] = MergePolicySimulator::LoadVersionSegments(root, 2);
+    ASSERT_TRUE(status.IsOK());
+    ASSERT_EQ(3u, segments.size());
+    ASSERT_EQ(0, segments[0].segmentId);
+    ASSERT_EQ(100u, segments[0].docCount);
+    ASSERT_EQ(4u, segments[0].deletedDocCount);
+    ASSERT_LT(1000u, segments[0].segmentSize);
+    ASSERT_EQ(50u, segments[1].docCount);
+    ASSERT_EQ(0u, segments[1].deletedDocCount);
+    ASSERT_LT(500u, segments[1].segmentSize);
+    ASSERT_EQ(0u, segments[2].deletedDocCount);
+
+    auto [replayStatus, steps] = MergePolicySimulator::LoadReplaySteps(root, 3, "merge");
+    ASSERT_TRUE(replayStatus.IsOK());
+    ASSERT_EQ(3u, steps.size());
+    ASSERT_EQ(2u, steps[0].newSegments.size());
+    ASSERT_EQ(1u, steps[1].newSegments.size());
+    ASSERT_EQ(2, steps[1].newSegments[0].segmentId);
+    ASSERT_EQ((std::map<segmentid_t, uint64_t> {{0, 4}}), steps[1].newDeletedDocCounts);
+    // real merge output is left to the policy under test
+    ASSERT_TRUE(steps[2].newSegments.empty());
+    ASSERT_TRUE(steps[2].newDeletedDocCounts.empty());
+
+    MergePolicySimulator simulator(_params);
+    auto result = simulator.Run(steps, MergePolicySimulator::CreateSegmentCountPolicy(1));
+    ASSERT_EQ(2u, result.mergePlanCount);
+    ASSERT_EQ(1u, result.finalSegmentCount);
+
+    // latest version missing
+    ASSERT_FALSE(MergePolicySimulator::LoadReplaySteps(root, 4, "merge").first.IsOK());
+}
+
+} // namespace indexlibv2::table
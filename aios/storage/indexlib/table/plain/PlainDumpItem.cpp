@@ -24,18 +24,19 @@ AUTIL_LOG_SETUP(indexlib.plain, PlainDumpItem);
 PlainDumpItem::PlainDumpItem(const std::shared_ptr<autil::mem_pool::PoolBase>& dumpPool,
                              const std::shared_ptr<index::IMemIndexer>& buildingIndex,
                              const std::shared_ptr<indexlib::file_system::Directory>& dir,
-                             const std::shared_ptr<framework::DumpParams>& dumpParams)
+                             const std::shared_ptr<framework::DumpParams>& dumpParams, int64_t estimateMemUse)
     : _dumpPool(dumpPool)
     , _buildingIndex(buildingIndex)
     , _dir(dir)
     , _params(dumpParams)
+    , _estimateMemUse(estimateMemUse)
     , _dumped(false)
 {
 }
 
 Status PlainDumpItem::Dump() noexcept
 {
-    AUTIL_LOG(INFO, "begin dump index [%s]", _buildingIndex->GetIndexName().c_str());
+    AUTIL_LOG(INFO, "begin dump index [%s], mem use [%ld]", _buildingIndex->GetIndexName().c_str(), _estimateMemUse);
     auto status = _buildingIndex->Dump(_dumpPool.get(), _dir, _params);
     if (status.IsOK()) {
         _dumped = true;
@@ -39,7 +39,7 @@ public:
     PlainDumpItem(const std::shared_ptr<autil::mem_pool::PoolBase>& dumpPool,
                   const std::shared_ptr<index::IMemIndexer>& buildingIndex,
                   const std::shared_ptr<indexlib::file_system::Directory>& dir,
-                  const std::shared_ptr<framework::DumpParams>& dumpParams);
+                  const std::shared_ptr<framework::DumpParams>& dumpParams, int64_t estimateMemUse);
 
     PlainDumpItem(const PlainDumpItem&) = delete;
     PlainDumpItem& operator=(const PlainDumpItem&) = delete;
@@ -50,12 +50,14 @@ public:
 
     Status Dump() noexcept override;
     bool IsDumped() const override { return _dumped; }
+    int64_t EstimateMemUse() const override { return _estimateMemUse; }
 
 private:
     std::shared_ptr<autil::mem_pool::PoolBase> _dumpPool;
     std::shared_ptr<index::IMemIndexer> _buildingIndex;
     std::shared_ptr<indexlib::file_system::Directory> _dir;
     std::shared_ptr<framework::DumpParams> _params;
+    int64_t _estimateMemUse;
     bool _dumped;
 
     AUTIL_LOG_DECLARE();
@@ -183,12 +183,17 @@ std::pair<Status, std::vector<std::shared_ptr<framework::SegmentDumpItem>>> Plai
     auto indexFactoryCreator = index::IndexFactoryCreator::GetInstance();
     for (const auto& [indexMapKey, indexerAndMemUpdater] : _indexMap) {
         auto& indexType = indexMapKey.first;
-        auto& memIndexer = indexerAndMemUpdater.first;
+        auto& [memIndexer, memUpdater] = indexerAndMemUpdater;
         auto [status, indexFactory] = indexFactoryCreator->Create(indexType);
         assert(status.IsOK());
         auto indexDirectory = GetSegmentDirectory()->MakeDirectory(indexFactory->GetIndexPath());
         if (memIndexer->IsDirty()) {
-            auto dumpItem = std::make_shared<PlainDumpItem>(dumpPool, memIndexer, indexDirectory, dumpParams);
+            int64_t currentMemUse = 0, dumpTmpMemUse = 0, dumpExpandMemUse = 0, dumpFileSize = 0;
+            if (memUpdater) {
+                memUpdater->GetMemInfo(currentMemUse, dumpTmpMemUse, dumpExpandMemUse, dumpFileSize);
+            }
+            auto dumpItem =
+                std::make_shared<PlainDumpItem>(dumpPool, memIndexer, indexDirectory, dumpParams, currentMemUse);
             segmentDumpItems.push_back(dumpItem);
         }
     }
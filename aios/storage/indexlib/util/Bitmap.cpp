@@ -211,6 +211,34 @@ uint32_t Bitmap::Next(uint32_t nIndex) const
     return INVALID_INDEX;
 }
 
+uint32_t Bitmap::FindNextSet(uint32_t nIndex) const
+{
+    if (nIndex >= _itemCount) {
+        return INVALID_INDEX;
+    }
+    return Test(nIndex) ? nIndex : Next(nIndex);
+}
+
+uint32_t Bitmap::FindNextUnset(uint32_t nIndex) const
+{
+    if (nIndex >= _itemCount) {
+        return INVALID_INDEX;
+    }
+    uint32_t quot = nIndex >> SLOT_SIZE_BIT_NUM;
+    uint32_t rem = nIndex & SLOT_SIZE_BIT_MASK;
+    for (uint32_t i = quot; i < _slotCount; ++i) {
+        uint32_t unsetData = ~_data[i];
+        if (i == quot) {
+            unsetData &= BITMAP_NEXT_MASK[rem];
+        }
+        if (unsetData) {
+            uint32_t index = i * SLOT_SIZE + __builtin_clz(unsetData);
+            return index < _itemCount ? index : INVALID_INDEX;
+        }
+    }
+    return INVALID_INDEX;
+}
+
 bool Bitmap::Set(uint32_t nIndex)
 {
     assert(nIndex < _itemCount);
@@ -39,6 +39,9 @@ public:
 
     uint32_t Begin() const;
     uint32_t Next(uint32_t nIndex) const;
+    // first set / unset index not less than nIndex, INVALID_INDEX if not found
+    uint32_t FindNextSet(uint32_t nIndex) const;
+    uint32_t FindNextUnset(uint32_t nIndex) const;
     bool Set(uint32_t nIndex);
     bool Reset(uint32_t nIndex);
     void ResetAll();
@@ -0,0 +1,323 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "indexlib/util/CompressedBitmap.h"
+
+#include <algorithm>
+
+namespace indexlib { namespace util {
+
+CompressedBitmap::CompressedBitmap(uint32_t itemCount) : _itemCount(itemCount), _setCount(0)
+{
+    _containers.resize(((uint64_t)itemCount + CHUNK_SIZE - 1) >> CHUNK_BIT_NUM);
+}
+
+std::unique_ptr<CompressedBitmap> CompressedBitmap::Create(const Bitmap& bitmap)
+{
+    auto compressedBitmap = std::make_unique<CompressedBitmap>(bitmap.GetItemCount());
+    const uint32_t* data = bitmap.GetData();
+    for (uint32_t i = 0; i < bitmap.GetSlotCount(); ++i) {
+        uint32_t slotData = data[i];
+        while (slotData) {
+            uint32_t bit = __builtin_clz(slotData);
+            uint32_t index = i * Bitmap::SLOT_SIZE + bit;
+            if (index >= compressedBitmap->_itemCount) {
+                break;
+            }
+            compressedBitmap->Set(index);
+            slotData &= ~(0x80000000u >> bit);
+        }
+    }
+    compressedBitmap->RunOptimize();
+    return compressedBitmap;
+}
+
+bool CompressedBitmap::Set(uint32_t index)
+{
+    assert(index < _itemCount);
+    if (_containers[index >> CHUNK_BIT_NUM].Set(index & CHUNK_MASK)) {
+        ++_setCount;
+        return true;
+    }
+    return false;
+}
+
+uint32_t CompressedBitmap::GetChunkLimit(uint32_t chunk) const
+{
+    uint64_t chunkBegin = (uint64_t)chunk << CHUNK_BIT_NUM;
+    return std::min((uint64_t)CHUNK_SIZE, _itemCount - chunkBegin);
+}
+
+uint32_t CompressedBitmap::FindNextSet(uint32_t index) const
+{
+    if (index >= _itemCount) {
+        return Bitmap::INVALID_INDEX;
+    }
+    uint32_t low = index & CHUNK_MASK;
+    for (uint32_t chunk = index >> CHUNK_BIT_NUM; chunk < _containers.size(); ++chunk, low = 0) {
+        uint32_t found = _containers[chunk].FindNextSet(low);
+        if (found < CHUNK_SIZE) {
+            return (chunk << CHUNK_BIT_NUM) | found;
+        }
+    }
+    return Bitmap::INVALID_INDEX;
+}
+
+uint32_t CompressedBitmap::FindNextUnset(uint32_t index) const
+{
+    if (index >= _itemCount) {
+        return Bitmap::INVALID_INDEX;
+    }
+    uint32_t low = index & CHUNK_MASK;
+    for (uint32_t chunk = index >> CHUNK_BIT_NUM; chunk < _containers.size(); ++chunk, low = 0) {
+        uint32_t found = _containers[chunk].FindNextUnset(low);
+        if (found < GetChunkLimit(chunk)) {
+            return (chunk << CHUNK_BIT_NUM) | found;
+        }
+    }
+    return Bitmap::INVALID_INDEX;
+}
+
+void CompressedBitmap::RunOptimize()
+{
+    for (auto& container : _containers) {
+        container.RunOptimize();
+    }
+}
+
+void CompressedBitmap::CopyTo(Bitmap* bitmap) const
+{
+    assert(bitmap->GetItemCount() >= _itemCount);
+    uint32_t begin = FindNextSet(0);
+    while (begin != Bitmap::INVALID_INDEX) {
+        uint32_t end = FindNextUnset(begin);
+        if (end == Bitmap::INVALID_INDEX) {
+            end = _itemCount;
+        }
+        for (uint32_t i = begin; i < end; ++i) {
+            bitmap->Set(i);
+        }
+        begin = FindNextSet(end);
+    }
+}
+
+size_t CompressedBitmap::EstimateMemoryUse() const
+{
+    size_t memUse = sizeof(*this) + _containers.capacity() * sizeof(Container);
+    for (const auto& container : _containers) {
+        memUse += container.EstimateMemoryUse();
+    }
+    return memUse;
+}
+
+bool CompressedBitmap::Container::Test(uint16_t low) const
+{
+    switch (type) {
+    case CT_ARRAY:
+        return std::binary_search(values.begin(), values.end(), low);
+    case CT_BITMAP:
+        return (words[low >> 6] >> (low & 63)) & 1;
+    case CT_RUN: {
+        auto iter = std::lower_bound(runs.begin(), runs.end(), low,
+                                     [](const auto& run, uint16_t value) { return run.second < value; });
+        return iter != runs.end() && iter->first <= low;
+    }
+    }
+    return false;
+}
+
+bool CompressedBitmap::Container::Set(uint16_t low)
+{
+    if (type == CT_RUN) {
+        if (Test(low)) {
+            return false;
+        }
+        if (cardinality < MAX_ARRAY_CARDINALITY) {
+            ToArrayContainer();
+        } else {
+            ToBitmapContainer();
+        }
+    }
+    if (type == CT_ARRAY) {
+        auto iter = std::lower_bound(values.begin(), values.end(), low);
+        if (iter != values.end() && *iter == low) {
+            return false;
+        }
+        values.insert(iter, low);
+        ++cardinality;
+        if (cardinality > MAX_ARRAY_CARDINALITY) {
+            ToBitmapContainer();
+        }
+        return true;
+    }
+    uint64_t mask = 1ULL << (low & 63);
+    uint64_t& word = words[low >> 6];
+    if (word & mask) {
+        return false;
+    }
+    word |= mask;
+    ++cardinality;
+    return true;
+}
+
+uint32_t CompressedBitmap::Container::FindNextSet(uint32_t low) const
+{
+    switch (type) {
+    case CT_ARRAY: {
+        auto iter = std::lower_bound(values.begin(), values.end(), low);
+        return iter == values.end() ? CHUNK_SIZE : *iter;
+    }
+    case CT_BITMAP: {
+        uint32_t wordIdx = low >> 6;
+        uint64_t word = words[wordIdx] & (~0ULL << (low & 63));
+        while (true) {
+            if (word) {
+                return (wordIdx << 6) + __builtin_ctzll(word);
+            }
+            if (++wordIdx == BITMAP_WORD_COUNT) {
+                return CHUNK_SIZE;
+            }
+            word = words[wordIdx];
+        }
+    }
+    case CT_RUN: {
+        auto iter = std::lower_bound(runs.begin(), runs.end(), low,
+                                     [](const auto& run, uint32_t value) { return run.second < value; });
+        return iter == runs.end() ? CHUNK_SIZE : std::max((uint32_t)iter->first, low);
+    }
+    }
+    return CHUNK_SIZE;
+}
+
+uint32_t CompressedBitmap::Container::FindNextUnset(uint32_t low) const
+{
+    switch (type) {
+    case CT_ARRAY: {
+        auto iter = std::lower_bound(values.begin(), values.end(), low);
+        uint32_t unset = low;
+        for (; iter != values.end() && *iter == unset; ++iter) {
+            ++unset;
+        }
+        return unset;
+    }
+    case CT_BITMAP: {
+        uint32_t wordIdx = low >> 6;
+        uint64_t word = ~words[wordIdx] & (~0ULL << (low & 63));
+        while (true) {
+            if (word) {
+                return (wordIdx << 6) + __builtin_ctzll(word);
+            }
+            if (++wordIdx == BITMAP_WORD_COUNT) {
+                return CHUNK_SIZE;
+            }
+            word = ~words[wordIdx];
+        }
+    }
+    case CT_RUN: {
+        auto iter = std::lower_bound(runs.begin(), runs.end(), low,
+                                     [](const auto& run, uint32_t value) { return run.second < value; });
+        if (iter != runs.end() && iter->first <= low) {
+            return (uint32_t)iter->second + 1;
+        }
+        return low;
+    }
+    }
+    return CHUNK_SIZE;
+}
+
+void CompressedBitmap::Container::ToBitmapContainer()
+{
+    std::vector<uint64_t> newWords(BITMAP_WORD_COUNT, 0);
+    for (uint32_t low = FindNextSet(0); low < CHUNK_SIZE; low = FindNextSet(low + 1)) {
+        newWords[low >> 6] |= 1ULL << (low & 63);
+    }
+    words.swap(newWords);
+    std::vector<uint16_t>().swap(values);
+    std::vector<std::pair<uint16_t, uint16_t>>().swap(runs);
+    type = CT_BITMAP;
+}
+
+void CompressedBitmap::Container::ToArrayContainer()
+{
+    std::vector<uint16_t> newValues;
+    newValues.reserve(cardinality);
+    for (uint32_t low = FindNextSet(0); low < CHUNK_SIZE; low = FindNextSet(low + 1)) {
+        newValues.push_back(low);
+    }
+    values.swap(newValues);
+    std::vector<uint64_t>().swap(words);
+    std::vector<std::pair<uint16_t, uint16_t>>().swap(runs);
+    type = CT_ARRAY;
+}
+
+size_t CompressedBitmap::Container::GetRunCount() const
+{
+    switch (type) {
+    case CT_ARRAY: {
+        size_t runCount = values.empty() ? 0 : 1;
+        for (size_t i = 1; i < values.size(); ++i) {
+            if (values[i] != values[i - 1] + 1) {
+                ++runCount;
+            }
+        }
+        return runCount;
+    }
+    case CT_BITMAP: {
+        size_t runCount = 0;
+        uint64_t carry = 0;
+        for (uint64_t word : words) {
+            // count items set whose previous item is unset
+            runCount += __builtin_popcountll(word & ~((word << 1) | carry));
+            carry = word >> 63;
+        }
+        return runCount;
+    }
+    case CT_RUN:
+        return runs.size();
+    }
+    return 0;
+}
+
+void CompressedBitmap::Container::RunOptimize()
+{
+    if (type == CT_RUN || cardinality == 0) {
+        return;
+    }
+    size_t runSize = GetRunCount() * sizeof(std::pair<uint16_t, uint16_t>);
+    size_t currentSize =
+        (type == CT_ARRAY) ? cardinality * sizeof(uint16_t) : BITMAP_WORD_COUNT * sizeof(uint64_t);
+    if (runSize >= currentSize) {
+        return;
+    }
+    std::vector<std::pair<uint16_t, uint16_t>> newRuns;
+    newRuns.reserve(GetRunCount());
+    for (uint32_t first = FindNextSet(0); first < CHUNK_SIZE;) {
+        uint32_t end = FindNextUnset(first);
+        newRuns.emplace_back(first, end - 1);
+        first = (end < CHUNK_SIZE) ? FindNextSet(end) : CHUNK_SIZE;
+    }
+    runs.swap(newRuns);
+    std::vector<uint16_t>().swap(values);
+    std::vector<uint64_t>().swap(words);
+    type = CT_RUN;
+}
+
+size_t CompressedBitmap::Container::EstimateMemoryUse() const
+{
+    return values.capacity() * sizeof(uint16_t) + words.capacity() * sizeof(uint64_t) +
+           runs.capacity() * sizeof(std::pair<uint16_t, uint16_t>);
+}
+
+}} // namespace indexlib::util
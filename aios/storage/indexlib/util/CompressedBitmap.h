@@ -0,0 +1,109 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <assert.h>
+#include <memory>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+#include "indexlib/util/Bitmap.h"
+
+namespace indexlib { namespace util {
+
+// Roaring style bitmap: items are split into chunks of 65536, every chunk keeps its set items in the smallest of an
+// array container (sorted low 16 bits), a bitmap container or a run container, so sparse and very dense bitmaps
+// take much less memory than a plain Bitmap and set/unset ranges can be skipped without testing item by item.
+// Not thread safe, Set on a run container converts it back to an array or bitmap container.
+class CompressedBitmap
+{
+public:
+    explicit CompressedBitmap(uint32_t itemCount = 0);
+    ~CompressedBitmap() = default;
+
+public:
+    // build from a plain bitmap, containers are run optimized
+    static std::unique_ptr<CompressedBitmap> Create(const Bitmap& bitmap);
+
+public:
+    inline bool Test(uint32_t index) const;
+    bool Set(uint32_t index);
+    // first set / unset index not less than index, Bitmap::INVALID_INDEX if not found
+    uint32_t FindNextSet(uint32_t index) const;
+    uint32_t FindNextUnset(uint32_t index) const;
+    // convert containers to run containers when smaller
+    void RunOptimize();
+    // bitmap should have at least GetItemCount() items
+    void CopyTo(Bitmap* bitmap) const;
+
+    uint32_t GetItemCount() const { return _itemCount; }
+    uint32_t GetSetCount() const { return _setCount; }
+    size_t EstimateMemoryUse() const;
+
+public:
+    static constexpr uint32_t CHUNK_BIT_NUM = 16;
+    static constexpr uint32_t CHUNK_SIZE = 1 << CHUNK_BIT_NUM;
+    static constexpr uint32_t CHUNK_MASK = CHUNK_SIZE - 1;
+    static constexpr uint32_t MAX_ARRAY_CARDINALITY = 4096;
+    static constexpr uint32_t BITMAP_WORD_COUNT = CHUNK_SIZE / 64;
+
+private:
+    enum ContainerType : uint8_t {
+        CT_ARRAY = 0,
+        CT_BITMAP = 1,
+        CT_RUN = 2,
+    };
+
+    struct Container {
+        ContainerType type = CT_ARRAY;
+        uint32_t cardinality = 0;
+        std::vector<uint16_t> values;
+        std::vector<uint64_t> words;
+        // [first, last] of set items, sorted and not adjacent
+        std::vector<std::pair<uint16_t, uint16_t>> runs;
+
+        bool Test(uint16_t low) const;
+        bool Set(uint16_t low);
+        // CHUNK_SIZE if not found
+        uint32_t FindNextSet(uint32_t low) const;
+        uint32_t FindNextUnset(uint32_t low) const;
+        void ToBitmapContainer();
+        void ToArrayContainer();
+        void RunOptimize();
+        size_t GetRunCount() const;
+        size_t EstimateMemoryUse() const;
+    };
+
+private:
+    uint32_t GetChunkLimit(uint32_t chunk) const;
+
+private:
+    uint32_t _itemCount;
+    uint32_t _setCount;
+    std::vector<Container> _containers;
+};
+
+typedef std::shared_ptr<CompressedBitmap> CompressedBitmapPtr;
+
+///////////////////////////////////////////////////
+// inline functions
+inline bool CompressedBitmap::Test(uint32_t index) const
+{
+    assert(index < _itemCount);
+    return _containers[index >> CHUNK_BIT_NUM].Test(index & CHUNK_MASK);
+}
+}} // namespace indexlib::util
@@ -45,12 +45,16 @@ std::thread FutureExecutor::reportMetricsThread;
 future_lite::Executor* FutureExecutor::CreateExecutor(int threadNum, int maxAio)
 {
     static int32_t idx = 0;
+    // posix, uring or aio
+    static const std::string ioBackend = autil::EnvUtil::getEnv("INDEXLIB_ASYNC_IO_BACKEND", std::string("posix"));
     auto params = future_lite::ExecutorCreator::Parameters()
                       .SetExecutorName("async_io_thread_pool_" + std::to_string(idx++))
                       .SetThreadNum(threadNum)
-                      .Set<uint32_t>("max_aio", maxAio);
+                      .Set<uint32_t>("max_aio", maxAio)
+                      .Set<std::string>("io_backend", ioBackend);
     auto executor = future_lite::ExecutorCreator::Create(/*type*/ "async_io", params);
-    AUTIL_LOG(INFO, "pool created[%p], threadNum[%d], max_aio [%d]", executor.get(), threadNum, maxAio);
+    AUTIL_LOG(INFO, "pool created[%p], threadNum[%d], max_aio [%d], io_backend [%s]", executor.get(), threadNum,
+              maxAio, ioBackend.c_str());
     return executor.release();
 }
 void FutureExecutor::DestroyExecutor(future_lite::Executor* executor)
@@ -0,0 +1,88 @@
+#include "indexlib/util/CompressedBitmap.h"
+
+#include "unittest/unittest.h"
+
+namespace indexlib::util {
+
+class CompressedBitmapTest : public TESTBASE
+{
+public:
+    CompressedBitmapTest() = default;
+    ~CompressedBitmapTest() = default;
+
+public:
+    void setUp() override {}
+    void tearDown() override {}
+
+private:
+    void CheckSame(const Bitmap& bitmap, const CompressedBitmap& compressedBitmap)
+    {
+        ASSERT_EQ(bitmap.GetItemCount(), compressedBitmap.GetItemCount());
+        ASSERT_EQ(bitmap.GetSetCount(), compressedBitmap.GetSetCount());
+        for (uint32_t i = 0; i < bitmap.GetItemCount(); ++i) {
+            ASSERT_EQ(bitmap.Test(i), compressedBitmap.Test(i)) << i;
+            ASSERT_EQ(bitmap.FindNextSet(i), compressedBitmap.FindNextSet(i)) << i;
+            ASSERT_EQ(bitmap.FindNextUnset(i), compressedBitmap.FindNextUnset(i)) << i;
+        }
+        ASSERT_EQ(Bitmap::INVALID_INDEX, compressedBitmap.FindNextSet(bitmap.GetItemCount()));
+        ASSERT_EQ(Bitmap::INVALID_INDEX, compressedBitmap.FindNextUnset(bitmap.GetItemCount()));
+    }
+};
+
+TEST_F(CompressedBitmapTest, TestSparse)
+{
+    const uint32_t itemCount = 200000;
+    Bitmap bitmap(itemCount);
+    for (uint32_t i = 0; i < itemCount; i += 97) {
+        bitmap.Set(i);
+    }
+    auto compressedBitmap = CompressedBitmap::Create(bitmap);
+    CheckSame(bitmap, *compressedBitmap);
+    ASSERT_LT(compressedBitmap->EstimateMemoryUse(), Bitmap::GetDumpSize(itemCount));
+}
+
+TEST_F(CompressedBitmapTest, TestDenseAndRuns)
+{
+    const uint32_t itemCount = 300000;
+    Bitmap bitmap(itemCount);
+    // long deleted ranges with a few holes, typical for segments with most docs deleted
+    for (uint32_t i = 0; i < itemCount; ++i) {
+        if (i % 20000 != 7 && i < 250000) {
+            bitmap.Set(i);
+        }
+    }
+    auto compressedBitmap = CompressedBitmap::Create(bitmap);
+    CheckSame(bitmap, *compressedBitmap);
+    ASSERT_LT(compressedBitmap->EstimateMemoryUse(), Bitmap::GetDumpSize(itemCount) / 10);
+
+    // set on run containers
+    for (uint32_t i = 7; i < itemCount; i += 20000) {
+        ASSERT_EQ(bitmap.Set(i), compressedBitmap->Set(i));
+    }
+    ASSERT_FALSE(compressedBitmap->Set(0));
+    ASSERT_TRUE(compressedBitmap->Set(itemCount - 1));
+    bitmap.Set(itemCount - 1);
+    CheckSame(bitmap, *compressedBitmap);
+}
+
+TEST_F(CompressedBitmapTest, TestSetAndCopy)
+{
+    const uint32_t itemCount = 70000;
+    CompressedBitmap compressedBitmap(itemCount);
+    Bitmap bitmap(itemCount);
+    ASSERT_EQ(0u, compressedBitmap.FindNextUnset(0));
+    ASSERT_EQ(Bitmap::INVALID_INDEX, compressedBitmap.FindNextSet(0));
+    // array container turns to bitmap container when it is large
+    for (uint32_t i = 0; i < itemCount; i += 3) {
+        ASSERT_TRUE(compressedBitmap.Set(i));
+        bitmap.Set(i);
+    }
+    ASSERT_FALSE(compressedBitmap.Set(3));
+    CheckSame(bitmap, compressedBitmap);
+
+    Bitmap copied(itemCount);
+    compressedBitmap.CopyTo(&copied);
+    CheckSame(copied, compressedBitmap);
+}
+
+} // namespace indexlib::util
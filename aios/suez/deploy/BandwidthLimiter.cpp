@@ -0,0 +1,59 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "suez/deploy/BandwidthLimiter.h"
+
+#include <algorithm>
+#include <unistd.h>
+
+#include "autil/TimeUtility.h"
+
+using namespace std;
+using namespace autil;
+
+namespace suez {
+
+BandwidthLimiter::BandwidthLimiter(int64_t bytesPerSecond) : _bytesPerSecond(bytesPerSecond), _nextFreeTimeUs(0) {}
+
+BandwidthLimiter::~BandwidthLimiter() {}
+
+void BandwidthLimiter::setLimit(int64_t bytesPerSecond) {
+    unique_lock<mutex> lock(_mu);
+    _bytesPerSecond = bytesPerSecond;
+}
+
+int64_t BandwidthLimiter::getLimit() const {
+    unique_lock<mutex> lock(_mu);
+    return _bytesPerSecond;
+}
+
+int64_t BandwidthLimiter::reserve(int64_t bytes, int64_t nowUs) {
+    unique_lock<mutex> lock(_mu);
+    if (_bytesPerSecond <= 0 || bytes <= 0) {
+        return 0;
+    }
+    int64_t startUs = max(nowUs, _nextFreeTimeUs);
+    _nextFreeTimeUs = startUs + bytes * 1000000 / _bytesPerSecond;
+    return startUs - nowUs;
+}
+
+void BandwidthLimiter::acquire(int64_t bytes) {
+    int64_t waitUs = reserve(bytes, TimeUtility::currentTimeInMicroSeconds());
+    if (waitUs > 0) {
+        usleep(waitUs);
+    }
+}
+
+} // namespace suez
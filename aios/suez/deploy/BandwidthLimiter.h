@@ -0,0 +1,46 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <mutex>
+#include <stdint.h>
+
+#include "autil/NoCopyable.h"
+
+namespace suez {
+
+// paces callers so that the bytes passed to acquire() do not exceed the limit
+class BandwidthLimiter : public autil::NoCopyable {
+public:
+    explicit BandwidthLimiter(int64_t bytesPerSecond = 0);
+    ~BandwidthLimiter();
+
+public:
+    // <= 0 means unlimited
+    void setLimit(int64_t bytesPerSecond);
+    int64_t getLimit() const;
+    // block until bytes can be sent or received
+    void acquire(int64_t bytes);
+    // time in us the caller should wait before using bytes, without blocking
+    int64_t reserve(int64_t bytes, int64_t nowUs);
+
+private:
+    mutable std::mutex _mu;
+    int64_t _bytesPerSecond;
+    int64_t _nextFreeTimeUs;
+};
+
+} // namespace suez
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "suez/deploy/DeployFileDeduper.h"
+
+#include <algorithm>
+#include <unistd.h>
+
+#include "autil/Log.h"
+#include "fslib/fs/FileSystem.h"
+#include "indexlib/file_system/DeployIndexMeta.h"
+#include "indexlib/file_system/FileInfo.h"
+#include "indexlib/framework/VersionDeployDescription.h"
+#include "suez/sdk/PathDefine.h"
+
+using namespace std;
+using namespace fslib;
+using namespace fslib::fs;
+
+AUTIL_DECLARE_AND_SETUP_LOGGER(suez, DeployFileDeduper);
+
+namespace suez {
+
+DeployFileDeduper::DeployFileDeduper() {}
+
+DeployFileDeduper::~DeployFileDeduper() {}
+
+bool DeployFileDeduper::hasChecksum(const indexlibv2::framework::VersionDeployDescription &desc) {
+    for (const auto &deployIndexMeta : desc.localDeployIndexMetas) {
+        for (const auto &fileInfo : deployIndexMeta->deployFileMetas) {
+            if (!fileInfo.checksum.empty()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void DeployFileDeduper::addDeployedVersion(const indexlibv2::framework::VersionDeployDescription &deployedDesc) {
+    for (const auto &deployIndexMeta : deployedDesc.localDeployIndexMetas) {
+        for (const auto &fileInfo : deployIndexMeta->deployFileMetas) {
+            if (fileInfo.checksum.empty() || !fileInfo.isFile()) {
+                continue;
+            }
+            auto localPath = PathDefine::join(deployIndexMeta->targetRootPath, fileInfo.filePath);
+            auto &localFiles = _checksumToLocalFiles[fileInfo.checksum];
+            if (find(localFiles.begin(), localFiles.end(), localPath) == localFiles.end()) {
+                localFiles.push_back(localPath);
+            }
+        }
+    }
+}
+
+int64_t DeployFileDeduper::dedup(const indexlibv2::framework::VersionDeployDescription &targetDesc,
+                                 DeployFilesVec &deployFilesVec) {
+    if (_checksumToLocalFiles.empty()) {
+        return 0;
+    }
+    unordered_map<string, string> targetChecksums;
+    for (const auto &deployIndexMeta : targetDesc.localDeployIndexMetas) {
+        for (const auto &fileInfo : deployIndexMeta->deployFileMetas) {
+            if (!fileInfo.checksum.empty()) {
+                targetChecksums[PathDefine::join(deployIndexMeta->sourceRootPath, fileInfo.filePath)] =
+                    fileInfo.checksum;
+            }
+        }
+    }
+    int64_t savedBytes = 0;
+    size_t reusedCount = 0;
+    for (auto &deployFiles : deployFilesVec) {
+        vector<string> remainFiles;
+        vector<worker_framework::DataFileMeta> remainMetas;
+        bool hasMetas = deployFiles.srcFileMetas.size() == deployFiles.deployFiles.size();
+        for (size_t i = 0; i < deployFiles.deployFiles.size(); ++i) {
+            const auto &file = deployFiles.deployFiles[i];
+            int64_t length = hasMetas ? deployFiles.srcFileMetas[i].length : -1;
+            auto it = targetChecksums.find(PathDefine::join(deployFiles.sourceRootPath, file));
+            if (it != targetChecksums.end()) {
+                auto localIt = _checksumToLocalFiles.find(it->second);
+                if (localIt != _checksumToLocalFiles.end() &&
+                    reuseFile(localIt->second, length, PathDefine::join(deployFiles.targetRootPath, file))) {
+                    savedBytes += max(length, (int64_t)0);
+                    deployFiles.deploySize -= max(length, (int64_t)0);
+                    ++reusedCount;
+                    continue;
+                }
+            }
+            remainFiles.push_back(file);
+            if (hasMetas) {
+                remainMetas.push_back(deployFiles.srcFileMetas[i]);
+            }
+        }
+        deployFiles.deployFiles.swap(remainFiles);
+        if (hasMetas) {
+            deployFiles.srcFileMetas.swap(remainMetas);
+        }
+    }
+    deployFilesVec.erase(remove_if(deployFilesVec.begin(),
+                                   deployFilesVec.end(),
+                                   [](const DeployFiles &deployFiles) { return deployFiles.deployFiles.empty(); }),
+                         deployFilesVec.end());
+    if (reusedCount > 0) {
+        AUTIL_LOG(INFO, "reuse [%lu] local files by checksum, saved [%ld] bytes", reusedCount, savedBytes);
+    }
+    return savedBytes;
+}
+
+bool DeployFileDeduper::reuseFile(const vector<string> &candidates, int64_t length, const string &dstPath) const {
+    for (const auto &srcPath : candidates) {
+        if (srcPath == dstPath) {
+            continue;
+        }
+        FileMeta fileMeta;
+        if (FileSystem::getFileMeta(srcPath, fileMeta) != EC_OK) {
+            // cleaned since the version was deployed
+            continue;
+        }
+        if (length >= 0 && fileMeta.fileLength != length) {
+            AUTIL_LOG(WARN,
+                      "local file [%s] length [%ld] mismatch with [%s] length [%ld], skip",
+                      srcPath.c_str(),
+                      fileMeta.fileLength,
+                      dstPath.c_str(),
+                      length);
+            continue;
+        }
+        if (materialize(srcPath, dstPath)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool DeployFileDeduper::materialize(const string &srcPath, const string &dstPath) {
+    if (FileSystem::isExist(dstPath) == EC_TRUE && FileSystem::remove(dstPath) != EC_OK) {
+        AUTIL_LOG(WARN, "remove stale file [%s] failed", dstPath.c_str());
+        return false;
+    }
+    auto pos = dstPath.rfind('/');
+    if (pos != string::npos && pos > 0) {
+        auto ec = FileSystem::mkDir(dstPath.substr(0, pos), true);
+        if (ec != EC_OK && ec != EC_EXIST) {
+            AUTIL_LOG(WARN, "make parent dir for [%s] failed", dstPath.c_str());
+            return false;
+        }
+    }
+    // committed index files are immutable, so a hard link is as good as a copy
+    if (::link(srcPath.c_str(), dstPath.c_str()) == 0) {
+        return true;
+    }
+    if (FileSystem::copy(srcPath, dstPath) == EC_OK) {
+        return true;
+    }
+    AUTIL_LOG(WARN, "reuse [%s] for [%s] failed", srcPath.c_str(), dstPath.c_str());
+    FileSystem::remove(dstPath);
+    return false;
+}
+
+} // namespace suez
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "autil/NoCopyable.h"
+#include "suez/deploy/DeployFiles.h"
+
+namespace indexlibv2 {
+namespace framework {
+struct VersionDeployDescription;
+}
+} // namespace indexlibv2
+
+namespace suez {
+
+// Reuses files already deployed on local disk for target files with the same content checksum,
+// so that a version which repacks or renames unchanged data does not download it again.
+class DeployFileDeduper : public autil::NoCopyable {
+public:
+    DeployFileDeduper();
+    ~DeployFileDeduper();
+
+public:
+    // index local files of a deployed version by checksum
+    void addDeployedVersion(const indexlibv2::framework::VersionDeployDescription &deployedDesc);
+    // materialize reusable files locally and remove them from deployFilesVec, return saved bytes
+    int64_t dedup(const indexlibv2::framework::VersionDeployDescription &targetDesc, DeployFilesVec &deployFilesVec);
+    size_t size() const { return _checksumToLocalFiles.size(); }
+
+public:
+    static bool hasChecksum(const indexlibv2::framework::VersionDeployDescription &desc);
+
+private:
+    bool reuseFile(const std::vector<std::string> &candidates, int64_t length, const std::string &dstPath) const;
+    static bool materialize(const std::string &srcPath, const std::string &dstPath);
+
+private:
+    std::unordered_map<std::string, std::vector<std::string>> _checksumToLocalFiles;
+};
+
+} // namespace suez
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -29,6 +30,8 @@ struct DeployFiles {
         targetRootPath; // the root where file load, refer to local toot or index root, maybe local, mpangu, dcache...
     std::vector<std::string> deployFiles;
     std::vector<worker_framework::DataFileMeta> srcFileMetas;
+    // file -> content checksum from indexlib FileChecksumTable, only for files whose checksum is known
+    std::map<std::string, std::string> fileChecksums;
     int64_t deploySize = 0;
     bool isComplete = false;
 };
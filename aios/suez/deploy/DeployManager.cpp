@@ -15,17 +15,28 @@
  */
 #include "suez/deploy/DeployManager.h"
 
+#include "autil/Log.h"
+#include "suez/deploy/BandwidthLimiter.h"
 #include "suez/deploy/LocalDeployItem.h"
 #include "suez/deploy/NormalDeployItem.h"
+#include "suez/deploy/PeerChunkRegistry.h"
+#include "suez/deploy/PeerClient.h"
+#include "suez/deploy/PeerDeployItem.h"
 
 using namespace std;
 
 namespace suez {
 
+AUTIL_DECLARE_AND_SETUP_LOGGER(suez, DeployManager);
+
 DeployManager::DeployManager(const std::shared_ptr<worker_framework::DataClient> &dataClient,
                              DiskQuotaController *diskQuotaController,
                              bool localMode)
-    : _deployResource{dataClient, diskQuotaController}, _localMode(localMode) {}
+    : _deployResource{dataClient, diskQuotaController}
+    , _localMode(localMode)
+    , _peerRegistry(make_unique<PeerChunkRegistry>())
+    , _uploadLimiter(make_unique<BandwidthLimiter>())
+    , _downloadLimiter(make_unique<BandwidthLimiter>()) {}
 
 DeployManager::~DeployManager() {}
 
@@ -37,7 +48,11 @@ shared_ptr<DeployItem> DeployManager::deploy(const DeployFilesVec &deployFilesVe
     }
 
     shared_ptr<DeployItem> item;
-    if (!_localMode) {
+    if (!_localMode && _peerDeployConfig.isEnabled() && _peerClient) {
+        PeerDeployResource peerResource{_peerRegistry.get(), _peerClient.get(), _downloadLimiter.get()};
+        item = make_shared<PeerDeployItem>(
+            _deployResource, _dataOption, _peerDeployConfig, peerResource, deployFilesVec);
+    } else if (!_localMode) {
         item = make_shared<NormalDeployItem>(_deployResource, _dataOption, deployFilesVec);
     } else {
         item = make_shared<LocalDeployItem>(_deployResource, deployFilesVec);
@@ -52,6 +67,49 @@ void DeployManager::updateDeployConfig(const worker_framework::DataOption &dataO
     _dataOption = dataOption;
 }
 
+void DeployManager::updatePeerDeployConfig(const PeerDeployConfig &peerDeployConfig) {
+    unique_lock<mutex> lock(_mu);
+    if (_peerDeployConfig == peerDeployConfig) {
+        return;
+    }
+    if (!_localMode && peerDeployConfig.isEnabled() && !_peerClient) {
+        auto peerClient = make_shared<ArpcPeerClient>();
+        if (!peerClient->init()) {
+            AUTIL_LOG(ERROR, "init peer client failed, peer deploy disabled");
+            return;
+        }
+        _peerClient = peerClient;
+    }
+    if (_peerDeployConfig.isEnabled() && !peerDeployConfig.isEnabled()) {
+        // a disabled node serves nothing to its peers
+        _peerRegistry->clear();
+    }
+    int64_t bytesPerSecond = peerDeployConfig.bandwidthLimitMb * 1024 * 1024;
+    _uploadLimiter->setLimit(bytesPerSecond);
+    _downloadLimiter->setLimit(bytesPerSecond);
+    _peerDeployConfig = peerDeployConfig;
+    AUTIL_LOG(INFO,
+              "update peer deploy config to [%s]",
+              autil::legacy::FastToJsonString(_peerDeployConfig, true).c_str());
+}
+
+void DeployManager::setPeerClient(const shared_ptr<PeerClient> &peerClient) {
+    unique_lock<mutex> lock(_mu);
+    _peerClient = peerClient;
+}
+
+void DeployManager::markDeployed(const DeployFilesVec &deployFiles) {
+    if (!isPeerDeployEnabled()) {
+        return;
+    }
+    _peerRegistry->addDeployed(deployFiles);
+}
+
+bool DeployManager::isPeerDeployEnabled() const {
+    unique_lock<mutex> lock(_mu);
+    return !_localMode && _peerDeployConfig.isEnabled();
+}
+
 void DeployManager::erase(const DeployFilesVec &deployFiles) {
     unique_lock<mutex> lock(_mu);
     _deployFilesSet.erase(deployFiles);
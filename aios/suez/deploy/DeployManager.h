@@ -23,6 +23,7 @@
 #include "autil/NoCopyable.h"
 #include "suez/deploy/DeployFiles.h"
 #include "suez/deploy/DeployItem.h"
+#include "suez/deploy/PeerDeployConfig.h"
 #include "worker_framework/DataOption.h"
 
 namespace worker_framework {
@@ -33,8 +34,11 @@ class DataClient;
 
 namespace suez {
 
+class BandwidthLimiter;
 class DiskQuotaController;
 class DeployItem;
+class PeerChunkRegistry;
+class PeerClient;
 
 class DeployManager : public autil::NoCopyable {
 public:
@@ -47,8 +51,18 @@ public:
     // virtual for test
     virtual std::shared_ptr<DeployItem> deploy(const DeployFilesVec &deployFilesVec);
     void updateDeployConfig(const worker_framework::DataOption &dataOption);
+    void updatePeerDeployConfig(const PeerDeployConfig &peerDeployConfig);
 
     void erase(const DeployFilesVec &deployFiles);
+    // files under the target roots are complete and can be served to peers
+    // files are registered only while peer deploy is enabled
+    void markDeployed(const DeployFilesVec &deployFiles);
+    bool isPeerDeployEnabled() const;
+
+    PeerChunkRegistry *getPeerChunkRegistry() const { return _peerRegistry.get(); }
+    BandwidthLimiter *getPeerUploadLimiter() const { return _uploadLimiter.get(); }
+    // for test
+    void setPeerClient(const std::shared_ptr<PeerClient> &peerClient);
 
 private:
     DeployResource _deployResource;
@@ -56,6 +70,11 @@ private:
     mutable std::mutex _mu;
     std::unordered_map<DeployFilesVec, std::shared_ptr<DeployItem>> _deployFilesSet;
     worker_framework::DataOption _dataOption;
+    PeerDeployConfig _peerDeployConfig;
+    std::unique_ptr<PeerChunkRegistry> _peerRegistry;
+    std::unique_ptr<BandwidthLimiter> _uploadLimiter;
+    std::unique_ptr<BandwidthLimiter> _downloadLimiter;
+    std::shared_ptr<PeerClient> _peerClient;
 };
 
 } // namespace suez
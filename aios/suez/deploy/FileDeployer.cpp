@@ -51,6 +51,7 @@ DeployStatus FileDeployer::deploy(const DeployFilesVec &deployFilesVec,
                                   const std::function<bool()> &checkDeployDoneFunc,
                                   const std::function<bool()> &markDeployDoneFunc) {
     if (checkDeployDoneFunc()) {
+        markDeployed(deployFilesVec);
         return DS_DEPLOYDONE;
     }
     if (auto ret = doDeploy(deployFilesVec); ret != DS_DEPLOYDONE) {
@@ -60,6 +61,7 @@ DeployStatus FileDeployer::deploy(const DeployFilesVec &deployFilesVec,
         AUTIL_LOG(ERROR, "mark deployDone file failed!");
         return DS_FAILED;
     }
+    markDeployed(deployFilesVec);
     return DS_DEPLOYDONE;
 }
 
@@ -80,6 +82,12 @@ DeployStatus FileDeployer::doDeploy(const DeployFilesVec &deployFilesVec) {
     return DS_DEPLOYDONE;
 }
 
+void FileDeployer::markDeployed(const DeployFilesVec &deployFilesVec) {
+    if (_deployManager) {
+        _deployManager->markDeployed(deployFilesVec);
+    }
+}
+
 void FileDeployer::cancel() {
     unique_lock<mutex> lock(_mu);
     if (_deployItem) {
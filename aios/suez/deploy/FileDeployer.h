@@ -50,6 +50,9 @@ protected:
     // virtual for test
     virtual DeployStatus doDeploy(const DeployFilesVec &deployFilesVec);
 
+private:
+    void markDeployed(const DeployFilesVec &deployFilesVec);
+
 public:
     static bool checkDeployDone(const std::string &doneFile, const std::string &rawPath);
 
@@ -45,6 +45,7 @@
 #include "indexlib/index_define.h"
 #include "indexlib/indexlib.h"
 #include "suez/common/TablePathDefine.h"
+#include "suez/deploy/DeployFileDeduper.h"
 #include "suez/deploy/DeployFiles.h"
 #include "suez/deploy/FileDeployer.h"
 #include "suez/sdk/PathDefine.h"
@@ -187,6 +188,7 @@ DeployStatus IndexDeployer::deploy(const IndexPathDetail &pathDetail,
                   newVersionId);
         return DS_DEPLOYDONE;
     }
+    reuseLocalFiles(localPartitionPath, newVersionId, baseVersionDpDesc, targetVersionDpDesc, localDeployFilesVec);
     if (!pathDetail.checkIndexPath.empty()) {
         auto ret = _indexChecker.waitIndexReady(pathDetail.checkIndexPath);
         if (ret != DS_DEPLOYDONE) {
@@ -213,6 +215,36 @@ DeployStatus IndexDeployer::deploy(const IndexPathDetail &pathDetail,
     return ret;
 }
 
+void IndexDeployer::reuseLocalFiles(const string &localPartitionPath,
+                                    IncVersion newVersionId,
+                                    const indexlibv2::framework::VersionDeployDescription &baseVersionDpDesc,
+                                    const indexlibv2::framework::VersionDeployDescription &targetVersionDpDesc,
+                                    DeployFilesVec &localDeployFilesVec) const {
+    if (localDeployFilesVec.empty() || !DeployFileDeduper::hasChecksum(targetVersionDpDesc)) {
+        return;
+    }
+    DeployFileDeduper deduper;
+    deduper.addDeployedVersion(baseVersionDpDesc);
+    std::vector<std::pair<std::string, IncVersion>> doneFileList;
+    if (listDoneFiles(localPartitionPath, &doneFileList)) {
+        for (const auto &[doneFileName, versionId] : doneFileList) {
+            if (versionId == newVersionId) {
+                continue;
+            }
+            indexlibv2::framework::VersionDeployDescription deployedDesc;
+            if (loadDeployDone(PathDefine::join(localPartitionPath, doneFileName), deployedDesc)) {
+                deduper.addDeployedVersion(deployedDesc);
+            }
+        }
+    }
+    auto savedBytes = deduper.dedup(targetVersionDpDesc, localDeployFilesVec);
+    AUTIL_LOG(INFO,
+              "version [%d] in [%s] reused [%ld] bytes of local files by checksum",
+              newVersionId,
+              localPartitionPath.c_str(),
+              savedBytes);
+}
+
 void IndexDeployer::cancel() {
     _fileDeployer->cancel();
     _indexChecker.cancel();
@@ -303,6 +335,9 @@ static bool fillLocalDeployFilesVec(const indexlib::file_system::DeployIndexMeta
             deployFiles.srcFileMetas.push_back(dataFileMeta);
             deployFiles.deployFiles.push_back(dataFileMeta.path);
             deployFiles.deploySize += dataFileMeta.length;
+            if (!meta.checksum.empty()) {
+                deployFiles.fileChecksums[meta.filePath] = meta.checksum;
+            }
         }
         // only vesion.x in deployIndexMeta->finalDeployFileMetas, processed by self up to now.
     }
@@ -90,6 +90,13 @@ private:
 
     bool deployExtraFiles(const std::string &rawIndexRoot, const std::string &localRootPath) const;
 
+    // reuse files deployed for other versions whose checksum equals a target file
+    void reuseLocalFiles(const std::string &localPartitionPath,
+                         IncVersion newVersionId,
+                         const indexlibv2::framework::VersionDeployDescription &baseVersionDpDesc,
+                         const indexlibv2::framework::VersionDeployDescription &targetVersionDpDesc,
+                         DeployFilesVec &localDeployFilesVec) const;
+
     bool getDeployFiles(const std::string &remoteIndexRoot,
                         const std::string &localRootPath,
                         const std::string &remotePath,
@@ -0,0 +1,169 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "suez/deploy/PeerChunkRegistry.h"
+
+#include "autil/Log.h"
+#include "autil/StringUtil.h"
+#include "fslib/fs/FileSystem.h"
+
+using namespace std;
+using namespace autil;
+using namespace fslib::fs;
+
+AUTIL_DECLARE_AND_SETUP_LOGGER(suez, PeerChunkRegistry);
+
+namespace suez {
+
+PeerChunkRegistry::PeerChunkRegistry() {}
+
+PeerChunkRegistry::~PeerChunkRegistry() {}
+
+void PeerChunkRegistry::addDeployed(const DeployFilesVec &deployFilesVec) {
+    unique_lock<mutex> lock(_mu);
+    for (const auto &deployFiles : deployFilesVec) {
+        if (deployFiles.deployFiles.empty()) {
+            // the whole root is deployed without a file list, nothing is known to be complete
+            continue;
+        }
+        map<string, const worker_framework::DataFileMeta *> metas;
+        for (const auto &meta : deployFiles.srcFileMetas) {
+            metas[meta.path] = &meta;
+        }
+        auto &entry = _roots[normalize(deployFiles.sourceRootPath)];
+        if (entry.targetRootPath != deployFiles.targetRootPath) {
+            entry.targetRootPath = deployFiles.targetRootPath;
+            entry.files.clear();
+        }
+        size_t fileCount = 0;
+        for (const auto &fileName : deployFiles.deployFiles) {
+            if (fileName.empty() || fileName.back() == '/') {
+                continue;
+            }
+            FileState state;
+            auto metaIt = metas.find(fileName);
+            if (metaIt != metas.end() && !metaIt->second->isDir) {
+                state.length = metaIt->second->length;
+                state.modifyTime = metaIt->second->modifyTime;
+            }
+            if (state.length < 0) {
+                // the deploy is done, so the local length is the complete length
+                fslib::PathMeta pathMeta;
+                auto localFilePath = FileSystem::joinFilePath(deployFiles.targetRootPath, fileName);
+                if (fslib::EC_OK != FileSystem::getPathMeta(localFilePath, pathMeta) || !pathMeta.isFile) {
+                    continue;
+                }
+                state.length = pathMeta.length;
+            }
+            state.readyLength = state.length;
+            auto checksumIt = deployFiles.fileChecksums.find(fileName);
+            if (checksumIt != deployFiles.fileChecksums.end()) {
+                state.checksum = checksumIt->second;
+            }
+            entry.files[fileName] = state;
+            ++fileCount;
+        }
+        AUTIL_LOG(INFO,
+                  "serve [%lu] deployed files to peers, [%s --> %s]",
+                  fileCount,
+                  deployFiles.sourceRootPath.c_str(),
+                  deployFiles.targetRootPath.c_str());
+    }
+}
+
+void PeerChunkRegistry::updateProgress(const string &sourceRootPath,
+                                       const string &targetRootPath,
+                                       const string &fileName,
+                                       const FileState &state) {
+    unique_lock<mutex> lock(_mu);
+    auto &entry = _roots[normalize(sourceRootPath)];
+    if (entry.targetRootPath != targetRootPath) {
+        entry.targetRootPath = targetRootPath;
+        entry.files.clear();
+    }
+    entry.files[fileName] = state;
+}
+
+void PeerChunkRegistry::removeProgress(const string &sourceRootPath, const string &fileName) {
+    unique_lock<mutex> lock(_mu);
+    auto it = _roots.find(normalize(sourceRootPath));
+    if (it == _roots.end()) {
+        return;
+    }
+    it->second.files.erase(fileName);
+    if (it->second.files.empty()) {
+        _roots.erase(it);
+    }
+}
+
+void PeerChunkRegistry::clear() {
+    unique_lock<mutex> lock(_mu);
+    _roots.clear();
+}
+
+bool PeerChunkRegistry::getFileState(const string &sourceRootPath,
+                                     const string &fileName,
+                                     string &localFilePath,
+                                     FileState &state) const {
+    if (!isValidFileName(fileName)) {
+        AUTIL_LOG(WARN, "reject invalid file name [%s] from peer", fileName.c_str());
+        return false;
+    }
+    {
+        unique_lock<mutex> lock(_mu);
+        auto it = _roots.find(normalize(sourceRootPath));
+        if (it == _roots.end()) {
+            return false;
+        }
+        auto fileIt = it->second.files.find(fileName);
+        if (fileIt == it->second.files.end()) {
+            return false;
+        }
+        state = fileIt->second;
+        localFilePath = FileSystem::joinFilePath(it->second.targetRootPath, fileName);
+    }
+    if (!state.isComplete()) {
+        return true;
+    }
+    // complete files are checked on disk, so files removed or truncated locally are not served any more
+    fslib::PathMeta pathMeta;
+    if (fslib::EC_OK != FileSystem::getPathMeta(localFilePath, pathMeta) || !pathMeta.isFile ||
+        pathMeta.length != state.length) {
+        return false;
+    }
+    return true;
+}
+
+string PeerChunkRegistry::normalize(const string &path) {
+    string ret = path;
+    while (ret.size() > 1 && ret.back() == '/') {
+        ret.pop_back();
+    }
+    return ret;
+}
+
+bool PeerChunkRegistry::isValidFileName(const string &fileName) {
+    if (fileName.empty() || fileName[0] == '/') {
+        return false;
+    }
+    for (const auto &part : StringUtil::split(fileName, "/")) {
+        if (part == "..") {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace suez
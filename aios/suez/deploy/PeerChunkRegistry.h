@@ -0,0 +1,75 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+
+#include "autil/NoCopyable.h"
+#include "suez/deploy/DeployFiles.h"
+
+namespace suez {
+
+// what this node can serve to its peers: files listed by completed deploys plus
+// the head of the files that are still being fetched, tracked file by file so
+// that files rewritten by a later deploy are never served half written
+class PeerChunkRegistry : public autil::NoCopyable {
+public:
+    static constexpr uint64_t INVALID_MODIFY_TIME = (uint64_t)-1;
+    struct FileState {
+        int64_t length = -1;
+        int64_t readyLength = 0;
+        uint64_t modifyTime = INVALID_MODIFY_TIME; // modify time of the source file, if known
+        std::string checksum;                      // content checksum of the source file, if known
+        bool isComplete() const { return length >= 0 && readyLength == length; }
+    };
+
+public:
+    PeerChunkRegistry();
+    ~PeerChunkRegistry();
+
+public:
+    // the listed files under the target roots are complete
+    void addDeployed(const DeployFilesVec &deployFilesVec);
+    void updateProgress(const std::string &sourceRootPath,
+                        const std::string &targetRootPath,
+                        const std::string &fileName,
+                        const FileState &state);
+    // stop serving the file, e.g. it is removed or about to be rewritten
+    void removeProgress(const std::string &sourceRootPath, const std::string &fileName);
+    // stop serving all files, e.g. peer deploy is turned off
+    void clear();
+    bool getFileState(const std::string &sourceRootPath,
+                      const std::string &fileName,
+                      std::string &localFilePath,
+                      FileState &state) const;
+
+private:
+    static std::string normalize(const std::string &path);
+    static bool isValidFileName(const std::string &fileName);
+
+private:
+    struct RootEntry {
+        std::string targetRootPath;
+        std::map<std::string, FileState> files;
+    };
+    mutable std::mutex _mu;
+    std::map<std::string, RootEntry> _roots;
+};
+
+} // namespace suez
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "suez/deploy/PeerClient.h"
+
+#include "aios/network/arpc/arpc/ANetRPCChannelManager.h"
+#include "aios/network/arpc/arpc/ANetRPCController.h"
+#include "aios/network/arpc/arpc/RPCChannelBase.h"
+#include "aios/network/arpc/arpc/SyncClosure.h"
+#include "autil/Log.h"
+
+using namespace std;
+
+namespace suez {
+
+AUTIL_DECLARE_AND_SETUP_LOGGER(suez, PeerClient);
+
+ArpcPeerClient::ArpcPeerClient() {}
+
+ArpcPeerClient::~ArpcPeerClient() {
+    unique_lock<mutex> lock(_mu);
+    _channels.clear();
+    if (_channelManager) {
+        _channelManager->StopPrivateTransport();
+    }
+}
+
+bool ArpcPeerClient::init() {
+    unique_lock<mutex> lock(_mu);
+    _channelManager = make_unique<arpc::ANetRPCChannelManager>();
+    if (!_channelManager->StartPrivateTransport("PeerDeploy")) {
+        AUTIL_LOG(ERROR, "start peer deploy transport failed");
+        _channelManager.reset();
+        return false;
+    }
+    return true;
+}
+
+shared_ptr<arpc::RPCChannelBase> ArpcPeerClient::getChannel(const string &peerSpec, int32_t timeoutMs) {
+    unique_lock<mutex> lock(_mu);
+    if (!_channelManager) {
+        return nullptr;
+    }
+    auto it = _channels.find(peerSpec);
+    if (it != _channels.end() && !it->second->ChannelBroken()) {
+        return it->second;
+    }
+    auto channel = dynamic_cast<arpc::RPCChannelBase *>(
+        _channelManager->OpenChannel(peerSpec, false, 50ul, timeoutMs, false));
+    if (!channel) {
+        AUTIL_LOG(WARN, "open channel to peer [%s] failed", peerSpec.c_str());
+        _channels.erase(peerSpec);
+        return nullptr;
+    }
+    shared_ptr<arpc::RPCChannelBase> ret(channel);
+    _channels[peerSpec] = ret;
+    return ret;
+}
+
+bool ArpcPeerClient::queryChunks(const string &peerSpec,
+                                 const QueryChunksRequest &request,
+                                 QueryChunksResponse &response,
+                                 int32_t timeoutMs) {
+    auto channel = getChannel(peerSpec, timeoutMs);
+    if (!channel) {
+        return false;
+    }
+    PeerDeployService_Stub stub(channel.get(), google::protobuf::Service::STUB_DOESNT_OWN_CHANNEL);
+    arpc::ANetRPCController controller;
+    controller.SetExpireTime(timeoutMs);
+    arpc::SyncClosure closure;
+    stub.queryChunks(&controller, &request, &response, &closure);
+    closure.WaitReply();
+    if (controller.Failed()) {
+        AUTIL_LOG(WARN, "query chunks from [%s] failed, %s", peerSpec.c_str(), controller.ErrorText().c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ArpcPeerClient::readChunk(const string &peerSpec,
+                               const ReadChunkRequest &request,
+                               ReadChunkResponse &response,
+                               int32_t timeoutMs) {
+    auto channel = getChannel(peerSpec, timeoutMs);
+    if (!channel) {
+        return false;
+    }
+    PeerDeployService_Stub stub(channel.get(), google::protobuf::Service::STUB_DOESNT_OWN_CHANNEL);
+    arpc::ANetRPCController controller;
+    controller.SetExpireTime(timeoutMs);
+    arpc::SyncClosure closure;
+    stub.readChunk(&controller, &request, &response, &closure);
+    closure.WaitReply();
+    if (controller.Failed()) {
+        AUTIL_LOG(WARN, "read chunk from [%s] failed, %s", peerSpec.c_str(), controller.ErrorText().c_str());
+        return false;
+    }
+    if (!response.success()) {
+        AUTIL_LOG(WARN,
+                  "read chunk [%s] from [%s] failed, %s",
+                  request.filename().c_str(),
+                  peerSpec.c_str(),
+                  response.errormsg().c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace suez
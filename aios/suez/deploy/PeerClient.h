@@ -0,0 +1,73 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "autil/NoCopyable.h"
+#include "suez/deploy/PeerDeploy.pb.h"
+
+namespace arpc {
+class ANetRPCChannelManager;
+class RPCChannelBase;
+} // namespace arpc
+
+namespace suez {
+
+class PeerClient : public autil::NoCopyable {
+public:
+    virtual ~PeerClient() = default;
+
+public:
+    virtual bool queryChunks(const std::string &peerSpec,
+                             const QueryChunksRequest &request,
+                             QueryChunksResponse &response,
+                             int32_t timeoutMs) = 0;
+    virtual bool readChunk(const std::string &peerSpec,
+                           const ReadChunkRequest &request,
+                           ReadChunkResponse &response,
+                           int32_t timeoutMs) = 0;
+};
+
+class ArpcPeerClient : public PeerClient {
+public:
+    ArpcPeerClient();
+    ~ArpcPeerClient();
+
+public:
+    bool init();
+    bool queryChunks(const std::string &peerSpec,
+                     const QueryChunksRequest &request,
+                     QueryChunksResponse &response,
+                     int32_t timeoutMs) override;
+    bool readChunk(const std::string &peerSpec,
+                   const ReadChunkRequest &request,
+                   ReadChunkResponse &response,
+                   int32_t timeoutMs) override;
+
+private:
+    std::shared_ptr<arpc::RPCChannelBase> getChannel(const std::string &peerSpec, int32_t timeoutMs);
+
+private:
+    std::mutex _mu;
+    std::unique_ptr<arpc::ANetRPCChannelManager> _channelManager;
+    std::map<std::string, std::shared_ptr<arpc::RPCChannelBase>> _channels;
+};
+
+} // namespace suez
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "autil/legacy/jsonizable.h"
+
+namespace suez {
+
+// peer assisted deploy: replicas of one partition fetch index files from each
+// other and only fall back to the remote storage for what no peer holds
+class PeerDeployConfig : public autil::legacy::Jsonizable {
+public:
+    void Jsonize(autil::legacy::Jsonizable::JsonWrapper &json) override {
+        json.Jsonize("enable", enable, enable);
+        json.Jsonize("peers", peers, peers);
+        json.Jsonize("chunk_size", chunkSize, chunkSize);
+        json.Jsonize("bandwidth_limit_mb", bandwidthLimitMb, bandwidthLimitMb);
+        json.Jsonize("rpc_timeout_ms", rpcTimeoutMs, rpcTimeoutMs);
+    }
+    bool operator==(const PeerDeployConfig &other) const {
+        return enable == other.enable && peers == other.peers && chunkSize == other.chunkSize &&
+               bandwidthLimitMb == other.bandwidthLimitMb && rpcTimeoutMs == other.rpcTimeoutMs;
+    }
+    bool operator!=(const PeerDeployConfig &other) const { return !(*this == other); }
+    bool isEnabled() const { return enable && !peers.empty() && chunkSize > 0; }
+
+public:
+    bool enable = false;
+    std::vector<std::string> peers; // arpc specs of the other replicas, tcp:ip:port
+    int64_t chunkSize = 4 * 1024 * 1024;
+    int64_t bandwidthLimitMb = 100; // per node and direction, MB/s, <= 0 means unlimited
+    int32_t rpcTimeoutMs = 10000;
+};
+
+} // namespace suez
@@ -0,0 +1,383 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "suez/deploy/PeerDeployItem.h"
+
+#include <algorithm>
+#include <memory>
+#include <set>
+
+#include "autil/Log.h"
+#include "autil/legacy/jsonizable.h"
+#include "fslib/fs/File.h"
+#include "fslib/fs/FileSystem.h"
+#include "indexlib/file_system/FileChecksumTable.h"
+#include "suez/common/DiskQuotaController.h"
+#include "suez/deploy/BandwidthLimiter.h"
+#include "suez/deploy/NormalDeployItem.h"
+#include "suez/deploy/PeerClient.h"
+
+using namespace std;
+using namespace autil;
+using namespace fslib::fs;
+
+AUTIL_DECLARE_AND_SETUP_LOGGER(suez, PeerDeployItem);
+
+namespace suez {
+
+using worker_framework::DataOption;
+
+PeerDeployItem::PeerDeployItem(const DeployResource &deployResource,
+                               const DataOption &dataOption,
+                               const PeerDeployConfig &config,
+                               const PeerDeployResource &peerResource,
+                               const DeployFilesVec &deployFilesVec)
+    : DeployItem(deployResource, deployFilesVec)
+    , _dataOption(dataOption)
+    , _config(config)
+    , _peerResource(peerResource)
+    , _canceled(false)
+    , _deployed(false) {}
+
+DeployStatus PeerDeployItem::deployAndWaitDone() {
+    unique_lock<mutex> deployLock(_deployMu);
+    if (_deployed) {
+        return DS_DEPLOYDONE;
+    }
+    _canceled = false;
+    DeployFilesVec remainFilesVec;
+    for (auto deployFiles : _deployFilesVec) {
+        if (!checkAndFillDeployFiles(deployFiles)) {
+            return DS_FAILED;
+        }
+        DeployFiles remainFiles;
+        if (auto ret = deployFromPeers(deployFiles, remainFiles); ret != DS_UNKNOWN) {
+            return ret;
+        }
+        if (!remainFiles.deployFiles.empty() || !remainFiles.srcFileMetas.empty()) {
+            if (_peerResource.registry) {
+                // local copies of these files are rewritten by the remote deploy, stop serving them until it is done
+                for (const auto &file : remainFiles.deployFiles) {
+                    _peerResource.registry->removeProgress(remainFiles.sourceRootPath, file);
+                }
+            }
+            remainFilesVec.push_back(remainFiles);
+        }
+    }
+    if (remainFilesVec.empty()) {
+        AUTIL_LOG(INFO, "%p all files deployed from peers", this);
+        _deployed = true;
+        return DS_DEPLOYDONE;
+    }
+    shared_ptr<DeployItem> remoteItem;
+    {
+        unique_lock<mutex> lock(_mu);
+        if (isCanceled()) {
+            return DS_CANCELLED;
+        }
+        _remoteItem = make_shared<NormalDeployItem>(_deployResource, _dataOption, remainFilesVec);
+        remoteItem = _remoteItem;
+    }
+    auto ret = remoteItem->deployAndWaitDone();
+    {
+        unique_lock<mutex> lock(_mu);
+        _remoteItem.reset();
+    }
+    _deployed = (ret == DS_DEPLOYDONE);
+    return ret;
+}
+
+DeployStatus PeerDeployItem::deployFromPeers(const DeployFiles &deployFiles, DeployFiles &remainFiles) {
+    remainFiles = deployFiles;
+    FileStates expectStates;
+    for (const auto &meta : deployFiles.srcFileMetas) {
+        if (!meta.isDir) {
+            auto &state = expectStates[meta.path];
+            state.length = meta.length;
+            state.modifyTime = meta.modifyTime;
+        }
+    }
+    for (const auto &kv : deployFiles.fileChecksums) {
+        expectStates[kv.first].checksum = kv.second;
+    }
+    FileStates fileStates;
+    FileCandidates candidates;
+    queryPeers(deployFiles, expectStates, fileStates, candidates);
+    if (candidates.empty()) {
+        return DS_UNKNOWN;
+    }
+
+    DeployFiles peerFiles;
+    peerFiles.sourceRootPath = deployFiles.sourceRootPath;
+    peerFiles.targetRootPath = deployFiles.targetRootPath;
+    for (const auto &kv : candidates) {
+        peerFiles.deployFiles.push_back(kv.first);
+        peerFiles.deploySize += fileStates[kv.first].length;
+    }
+    const auto &remoteDataPath = deployFiles.sourceRootPath;
+    const auto &localDataPath = deployFiles.targetRootPath;
+    auto ret = reserveDiskQuota(remoteDataPath, localDataPath, peerFiles);
+    DiskQuotaReleaseHelper release(
+        _deployResource.diskQuotaController, remoteDataPath, localDataPath, peerFiles.deployFiles);
+    if (ret != DS_UNKNOWN) {
+        return ret;
+    }
+
+    set<string> fetched;
+    int64_t fetchedSize = 0;
+    for (const auto &kv : candidates) {
+        if (isCanceled()) {
+            return DS_CANCELLED;
+        }
+        const auto &fileState = fileStates[kv.first];
+        if (fetchFile(deployFiles, kv.first, fileState, kv.second)) {
+            fetched.insert(kv.first);
+            fetchedSize += fileState.length;
+        }
+    }
+    if (isCanceled()) {
+        return DS_CANCELLED;
+    }
+
+    remainFiles.deployFiles.clear();
+    for (const auto &file : deployFiles.deployFiles) {
+        if (fetched.count(file) == 0) {
+            remainFiles.deployFiles.push_back(file);
+        }
+    }
+    remainFiles.srcFileMetas.clear();
+    for (const auto &meta : deployFiles.srcFileMetas) {
+        if (fetched.count(meta.path) == 0) {
+            remainFiles.srcFileMetas.push_back(meta);
+        }
+    }
+    remainFiles.deploySize = max(0l, deployFiles.deploySize - fetchedSize);
+    AUTIL_LOG(INFO,
+              "%p deployed [%lu/%lu] files, [%ld/%ld] bytes from peers, [%s --> %s]",
+              this,
+              fetched.size(),
+              deployFiles.deployFiles.size(),
+              fetchedSize,
+              deployFiles.deploySize,
+              remoteDataPath.c_str(),
+              localDataPath.c_str());
+    return DS_UNKNOWN;
+}
+
+void PeerDeployItem::queryPeers(const DeployFiles &deployFiles,
+                                const FileStates &expectStates,
+                                FileStates &fileStates,
+                                FileCandidates &candidates) const {
+    QueryChunksRequest request;
+    request.set_sourcerootpath(deployFiles.sourceRootPath);
+    for (const auto &file : deployFiles.deployFiles) {
+        // directories are created by the remote deploy
+        if (!file.empty() && file.back() != '/') {
+            request.add_filenames(file);
+        }
+    }
+    if (request.filenames_size() == 0) {
+        return;
+    }
+    for (const auto &peer : _config.peers) {
+        if (isCanceled()) {
+            return;
+        }
+        QueryChunksResponse response;
+        if (!_peerResource.client->queryChunks(peer, request, response, _config.rpcTimeoutMs)) {
+            continue;
+        }
+        for (const auto &fileInfo : response.fileinfos()) {
+            const auto &fileName = fileInfo.filename();
+            PeerChunkRegistry::FileState peerState;
+            peerState.length = fileInfo.filelength();
+            peerState.readyLength = fileInfo.readylength();
+            if (fileInfo.has_modifytime()) {
+                peerState.modifyTime = fileInfo.modifytime();
+            }
+            peerState.checksum = fileInfo.checksum();
+            auto it = expectStates.find(fileName);
+            if (it != expectStates.end()) {
+                const auto &expect = it->second;
+                if (expect.length >= 0 && expect.length != peerState.length) {
+                    AUTIL_LOG(WARN,
+                              "length of [%s] on peer [%s] is [%ld], expect [%ld], ignore it",
+                              fileName.c_str(),
+                              peer.c_str(),
+                              peerState.length,
+                              expect.length);
+                    continue;
+                }
+                if (expect.modifyTime != PeerChunkRegistry::INVALID_MODIFY_TIME &&
+                    peerState.modifyTime != PeerChunkRegistry::INVALID_MODIFY_TIME &&
+                    expect.modifyTime != peerState.modifyTime) {
+                    AUTIL_LOG(WARN, "[%s] on peer [%s] is another version, ignore it", fileName.c_str(), peer.c_str());
+                    continue;
+                }
+                if (!expect.checksum.empty() && expect.checksum != peerState.checksum) {
+                    AUTIL_LOG(WARN,
+                              "checksum of [%s] on peer [%s] is [%s], expect [%s], ignore it",
+                              fileName.c_str(),
+                              peer.c_str(),
+                              peerState.checksum.c_str(),
+                              expect.checksum.c_str());
+                    continue;
+                }
+                if (peerState.modifyTime == PeerChunkRegistry::INVALID_MODIFY_TIME) {
+                    peerState.modifyTime = expect.modifyTime;
+                }
+            }
+            auto stateIt = fileStates.find(fileName);
+            if (stateIt != fileStates.end() &&
+                (stateIt->second.length != peerState.length || stateIt->second.checksum != peerState.checksum)) {
+                AUTIL_LOG(WARN, "peers disagree on [%s], ignore peer [%s]", fileName.c_str(), peer.c_str());
+                continue;
+            }
+            if (peerState.length < 0 || (peerState.readyLength <= 0 && peerState.length > 0)) {
+                continue;
+            }
+            if (stateIt == fileStates.end()) {
+                fileStates[fileName] = peerState;
+            }
+            candidates[fileName].push_back(PeerCandidate{peer, peerState.readyLength});
+        }
+    }
+}
+
+bool PeerDeployItem::fetchFile(const DeployFiles &deployFiles,
+                               const string &fileName,
+                               const PeerChunkRegistry::FileState &fileState,
+                               const vector<PeerCandidate> &candidates) {
+    const int64_t length = fileState.length;
+    const auto &sourceRootPath = deployFiles.sourceRootPath;
+    const auto &targetRootPath = deployFiles.targetRootPath;
+    auto registry = _peerResource.registry;
+    string localFile = FileSystem::joinFilePath(targetRootPath, fileName);
+    auto ec = FileSystem::mkDir(FileSystem::getParentPath(localFile), true);
+    if (ec != fslib::EC_OK && ec != fslib::EC_EXIST) {
+        AUTIL_LOG(WARN, "make parent dir for [%s] failed", localFile.c_str());
+        return false;
+    }
+    unique_ptr<File> file(FileSystem::openFile(localFile, fslib::WRITE));
+    if (!file || !file->isOpened()) {
+        AUTIL_LOG(WARN, "open [%s] for write failed", localFile.c_str());
+        return false;
+    }
+    auto failed = [&]() {
+        file->close();
+        FileSystem::remove(localFile);
+        if (registry) {
+            registry->removeProgress(sourceRootPath, fileName);
+        }
+        return false;
+    };
+
+    // neighbouring chunks start from different peers so that the load spreads over all of them
+    size_t seed = hash<string>()(fileName);
+    int64_t chunkIdx = 0;
+    for (int64_t offset = 0; offset < length; offset += _config.chunkSize, ++chunkIdx) {
+        if (isCanceled()) {
+            return failed();
+        }
+        int64_t chunkLen = min(_config.chunkSize, length - offset);
+        bool chunkDone = false;
+        for (size_t i = 0; i < candidates.size() && !chunkDone; ++i) {
+            const auto &peer = candidates[(seed + chunkIdx + i) % candidates.size()];
+            if (peer.readyLength < offset + chunkLen) {
+                continue;
+            }
+            ReadChunkRequest request;
+            request.set_sourcerootpath(sourceRootPath);
+            request.set_filename(fileName);
+            request.set_offset(offset);
+            request.set_length(chunkLen);
+            ReadChunkResponse response;
+            bool readOk = _peerResource.client->readChunk(peer.spec, request, response, _config.rpcTimeoutMs);
+            // charge the bytes actually received, failed attempts spend no bandwidth
+            if (_peerResource.downloadLimiter) {
+                _peerResource.downloadLimiter->acquire(response.data().size());
+            }
+            if (!readOk || (int64_t)response.data().size() != chunkLen) {
+                continue;
+            }
+            if (file->write(response.data().data(), chunkLen) != chunkLen) {
+                AUTIL_LOG(WARN, "write [%s] failed", localFile.c_str());
+                return failed();
+            }
+            chunkDone = true;
+        }
+        if (chunkDone && file->flush() != fslib::EC_OK) {
+            AUTIL_LOG(WARN, "flush [%s] failed", localFile.c_str());
+            return failed();
+        }
+        if (!chunkDone) {
+            AUTIL_LOG(INFO, "no peer serves [%s] at offset [%ld], leave it to remote deploy", fileName.c_str(), offset);
+            return failed();
+        }
+        // the file is served as complete only after it is verified
+        if (registry && offset + chunkLen < length) {
+            auto state = fileState;
+            state.readyLength = offset + chunkLen;
+            registry->updateProgress(sourceRootPath, targetRootPath, fileName, state);
+        }
+    }
+    auto dropFile = [&]() {
+        FileSystem::remove(localFile);
+        if (registry) {
+            registry->removeProgress(sourceRootPath, fileName);
+        }
+        return false;
+    };
+    if (file->close() != fslib::EC_OK) {
+        AUTIL_LOG(WARN, "close [%s] failed", localFile.c_str());
+        return dropFile();
+    }
+    if (!fileState.checksum.empty() && !verifyChecksum(localFile, fileState.checksum)) {
+        return dropFile();
+    }
+    if (registry) {
+        auto state = fileState;
+        state.readyLength = length;
+        registry->updateProgress(sourceRootPath, targetRootPath, fileName, state);
+    }
+    return true;
+}
+
+bool PeerDeployItem::verifyChecksum(const string &localFile, const string &expectChecksum) const {
+    auto [ec, checksum] = indexlib::file_system::FileChecksumTable::ComputeChecksum(localFile);
+    if (ec != indexlib::file_system::FSEC_OK) {
+        AUTIL_LOG(WARN, "compute checksum of [%s] failed, ec[%d]", localFile.c_str(), ec);
+        return false;
+    }
+    if (checksum != expectChecksum) {
+        AUTIL_LOG(WARN,
+                  "checksum of [%s] is [%s], expect [%s], leave it to remote deploy",
+                  localFile.c_str(),
+                  checksum.c_str(),
+                  expectChecksum.c_str());
+        return false;
+    }
+    return true;
+}
+
+void PeerDeployItem::cancel() {
+    _canceled = true;
+    unique_lock<mutex> lock(_mu);
+    if (_remoteItem) {
+        _remoteItem->cancel();
+    }
+}
+
+} // namespace suez
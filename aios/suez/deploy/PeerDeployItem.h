@@ -0,0 +1,88 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "suez/deploy/DeployItem.h"
+#include "suez/deploy/PeerChunkRegistry.h"
+#include "suez/deploy/PeerDeployConfig.h"
+#include "worker_framework/DataOption.h"
+
+namespace suez {
+
+class BandwidthLimiter;
+class PeerClient;
+
+struct PeerDeployResource {
+    PeerChunkRegistry *registry = nullptr;
+    PeerClient *client = nullptr;
+    BandwidthLimiter *downloadLimiter = nullptr;
+};
+
+// fetches the files other replicas already hold chunk by chunk, spreading the
+// chunks over all peers that have them, and deploys the rest from the remote storage
+class PeerDeployItem : public DeployItem {
+public:
+    PeerDeployItem(const DeployResource &deployResource,
+                   const worker_framework::DataOption &dataOption,
+                   const PeerDeployConfig &config,
+                   const PeerDeployResource &peerResource,
+                   const DeployFilesVec &deployFilesVec);
+    ~PeerDeployItem() = default;
+
+public:
+    DeployStatus deployAndWaitDone() override;
+    void cancel() override;
+
+private:
+    struct PeerCandidate {
+        std::string spec;
+        int64_t readyLength = 0;
+    };
+    typedef std::map<std::string, std::vector<PeerCandidate>> FileCandidates;
+    typedef std::map<std::string, PeerChunkRegistry::FileState> FileStates;
+
+private:
+    // fetch what peers hold, remainFiles is what is left for the remote storage
+    DeployStatus deployFromPeers(const DeployFiles &deployFiles, DeployFiles &remainFiles);
+    // only peers whose copy matches the expected length, modify time and checksum are candidates
+    void queryPeers(const DeployFiles &deployFiles,
+                    const FileStates &expectStates,
+                    FileStates &fileStates,
+                    FileCandidates &candidates) const;
+    bool fetchFile(const DeployFiles &deployFiles,
+                   const std::string &fileName,
+                   const PeerChunkRegistry::FileState &fileState,
+                   const std::vector<PeerCandidate> &candidates);
+    bool verifyChecksum(const std::string &localFile, const std::string &expectChecksum) const;
+    bool isCanceled() const { return _canceled.load(std::memory_order_relaxed); }
+
+private:
+    const worker_framework::DataOption _dataOption;
+    const PeerDeployConfig _config;
+    const PeerDeployResource _peerResource;
+    std::atomic<bool> _canceled;
+    std::mutex _deployMu; // one deploy at a time, the item is shared by callers of the same files
+    bool _deployed;
+    std::shared_ptr<DeployItem> _remoteItem;
+};
+
+} // namespace suez
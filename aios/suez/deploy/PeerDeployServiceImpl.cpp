@@ -0,0 +1,109 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "suez/deploy/PeerDeployServiceImpl.h"
+
+#include <memory>
+
+#include "autil/ClosureGuard.h"
+#include "autil/Log.h"
+#include "fslib/fs/File.h"
+#include "fslib/fs/FileSystem.h"
+#include "suez/deploy/BandwidthLimiter.h"
+#include "suez/deploy/PeerChunkRegistry.h"
+
+using namespace std;
+using namespace fslib::fs;
+
+namespace suez {
+
+AUTIL_DECLARE_AND_SETUP_LOGGER(suez, PeerDeployServiceImpl);
+
+PeerDeployServiceImpl::PeerDeployServiceImpl(const PeerChunkRegistry *registry, BandwidthLimiter *uploadLimiter)
+    : _registry(registry), _uploadLimiter(uploadLimiter) {}
+
+PeerDeployServiceImpl::~PeerDeployServiceImpl() {}
+
+void PeerDeployServiceImpl::queryChunks(google::protobuf::RpcController *controller,
+                                        const QueryChunksRequest *request,
+                                        QueryChunksResponse *response,
+                                        google::protobuf::Closure *done) {
+    autil::ClosureGuard guard(done);
+    for (const auto &fileName : request->filenames()) {
+        string localFilePath;
+        PeerChunkRegistry::FileState state;
+        if (!_registry->getFileState(request->sourcerootpath(), fileName, localFilePath, state) ||
+            state.readyLength <= 0) {
+            continue;
+        }
+        auto fileInfo = response->add_fileinfos();
+        fileInfo->set_filename(fileName);
+        fileInfo->set_filelength(state.length);
+        fileInfo->set_readylength(state.readyLength);
+        if (state.modifyTime != PeerChunkRegistry::INVALID_MODIFY_TIME) {
+            fileInfo->set_modifytime(state.modifyTime);
+        }
+        if (!state.checksum.empty()) {
+            fileInfo->set_checksum(state.checksum);
+        }
+    }
+}
+
+void PeerDeployServiceImpl::readChunk(google::protobuf::RpcController *controller,
+                                      const ReadChunkRequest *request,
+                                      ReadChunkResponse *response,
+                                      google::protobuf::Closure *done) {
+    autil::ClosureGuard guard(done);
+    const auto &fileName = request->filename();
+    int64_t offset = request->offset();
+    int64_t length = request->length();
+    string localFilePath;
+    PeerChunkRegistry::FileState state;
+    if (!_registry->getFileState(request->sourcerootpath(), fileName, localFilePath, state)) {
+        response->set_errormsg("file [" + fileName + "] not found");
+        return;
+    }
+    if (offset < 0 || length <= 0 || length > MAX_CHUNK_SIZE || offset + length > state.readyLength) {
+        response->set_errormsg("invalid range for file [" + fileName + "]");
+        return;
+    }
+    unique_ptr<File> file(FileSystem::openFile(localFilePath, fslib::READ));
+    if (!file || !file->isOpened()) {
+        AUTIL_LOG(WARN, "open [%s] failed", localFilePath.c_str());
+        response->set_errormsg("open file [" + fileName + "] failed");
+        return;
+    }
+    if (_uploadLimiter) {
+        _uploadLimiter->acquire(length);
+    }
+    auto data = response->mutable_data();
+    data->resize(length);
+    ssize_t readLen = file->pread(data->data(), length, offset);
+    file->close();
+    if (readLen != length) {
+        AUTIL_LOG(WARN,
+                  "read [%s] failed, offset [%ld], length [%ld], ret [%ld]",
+                  localFilePath.c_str(),
+                  offset,
+                  length,
+                  (int64_t)readLen);
+        response->clear_data();
+        response->set_errormsg("read file [" + fileName + "] failed");
+        return;
+    }
+    response->set_success(true);
+}
+
+} // namespace suez
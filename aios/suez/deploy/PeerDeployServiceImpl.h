@@ -0,0 +1,49 @@
+/*
+ * Copyright 2014-present Alibaba Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "suez/deploy/PeerDeploy.pb.h"
+
+namespace suez {
+
+class BandwidthLimiter;
+class PeerChunkRegistry;
+
+// serves the local copy of deployed and deploying index files to the other replicas
+class PeerDeployServiceImpl final : public PeerDeployService {
+public:
+    PeerDeployServiceImpl(const PeerChunkRegistry *registry, BandwidthLimiter *uploadLimiter);
+    ~PeerDeployServiceImpl();
+
+public:
+    void queryChunks(google::protobuf::RpcController *controller,
+                     const QueryChunksRequest *request,
+                     QueryChunksResponse *response,
+                     google::protobuf::Closure *done) override;
+    void readChunk(google::protobuf::RpcController *controller,
+                   const ReadChunkRequest *request,
+                   ReadChunkResponse *response,
+                   google::protobuf::Closure *done) override;
+
+private:
+    const PeerChunkRegistry *_registry;
+    BandwidthLimiter *_uploadLimiter;
+
+private:
+    static constexpr int64_t MAX_CHUNK_SIZE = 64 * 1024 * 1024;
+};
+
+} // namespace suez
@@ -0,0 +1,114 @@
+#include "suez/deploy/DeployFileDeduper.h"
+
+#include "fslib/fs/FileSystem.h"
+#include "fslib/util/FileUtil.h"
+#include "indexlib/file_system/DeployIndexMeta.h"
+#include "indexlib/framework/VersionDeployDescription.h"
+#include "unittest/unittest.h"
+
+using namespace std;
+using namespace fslib::fs;
+using namespace testing;
+using namespace indexlib::file_system;
+
+namespace suez {
+
+class DeployFileDeduperTest : public TESTBASE {
+public:
+    void setUp() override {
+        _localPath = GET_TEMPLATE_DATA_PATH() + "/local";
+        _remotePath = GET_TEMPLATE_DATA_PATH() + "/remote";
+        ASSERT_EQ(fslib::EC_OK, FileSystem::mkDir(_localPath + "/__FENCE__1/segment_0", true));
+        ASSERT_TRUE(fslib::util::FileUtil::writeFile(_localPath + "/__FENCE__1/segment_0/data", "abcd"));
+    }
+
+protected:
+    static shared_ptr<DeployIndexMeta>
+    makeMeta(const string &sourceRoot, const string &targetRoot, const vector<FileInfo> &fileInfos) {
+        auto meta = make_shared<DeployIndexMeta>();
+        meta->sourceRootPath = sourceRoot;
+        meta->targetRootPath = targetRoot;
+        for (const auto &fileInfo : fileInfos) {
+            meta->Append(fileInfo);
+        }
+        return meta;
+    }
+    static FileInfo makeFileInfo(const string &path, int64_t length, const string &checksum) {
+        FileInfo fileInfo(path, length, 0);
+        fileInfo.checksum = checksum;
+        return fileInfo;
+    }
+    DeployFiles makeDeployFiles(const vector<pair<string, int64_t>> &files) const {
+        DeployFiles deployFiles;
+        deployFiles.sourceRootPath = _remotePath;
+        deployFiles.targetRootPath = _localPath;
+        for (const auto &[path, length] : files) {
+            worker_framework::DataFileMeta meta;
+            meta.path = path;
+            meta.length = length;
+            deployFiles.deployFiles.push_back(path);
+            deployFiles.srcFileMetas.push_back(meta);
+            deployFiles.deploySize += length;
+        }
+        return deployFiles;
+    }
+
+protected:
+    string _localPath;
+    string _remotePath;
+};
+
+TEST_F(DeployFileDeduperTest, testDedup) {
+    indexlibv2::framework::VersionDeployDescription deployedDesc;
+    deployedDesc.localDeployIndexMetas.push_back(
+        makeMeta(_remotePath, _localPath, {makeFileInfo("__FENCE__1/segment_0/data", 4, "4-1-1")}));
+    ASSERT_TRUE(DeployFileDeduper::hasChecksum(deployedDesc));
+
+    indexlibv2::framework::VersionDeployDescription targetDesc;
+    targetDesc.localDeployIndexMetas.push_back(makeMeta(_remotePath,
+                                                        _localPath,
+                                                        {makeFileInfo("__FENCE__2/segment_1/data", 4, "4-1-1"),
+                                                         makeFileInfo("__FENCE__2/segment_1/index", 8, "8-2-2"),
+                                                         makeFileInfo("__FENCE__2/segment_1/meta", 4, "")}));
+
+    DeployFileDeduper deduper;
+    deduper.addDeployedVersion(deployedDesc);
+    ASSERT_EQ(1u, deduper.size());
+    DeployFilesVec deployFilesVec = {makeDeployFiles({{"__FENCE__2/segment_1/data", 4},
+                                                      {"__FENCE__2/segment_1/index", 8},
+                                                      {"__FENCE__2/segment_1/meta", 4}})};
+    ASSERT_EQ(4, deduper.dedup(targetDesc, deployFilesVec));
+    ASSERT_EQ(1u, deployFilesVec.size());
+    ASSERT_EQ(vector<string>({"__FENCE__2/segment_1/index", "__FENCE__2/segment_1/meta"}),
+              deployFilesVec[0].deployFiles);
+    ASSERT_EQ(2u, deployFilesVec[0].srcFileMetas.size());
+    ASSERT_EQ(12, deployFilesVec[0].deploySize);
+
+    string content;
+    ASSERT_TRUE(fslib::util::FileUtil::readFile(_localPath + "/__FENCE__2/segment_1/data", content));
+    ASSERT_EQ("abcd", content);
+}
+
+TEST_F(DeployFileDeduperTest, testDedupSkipMismatchOrMissing) {
+    indexlibv2::framework::VersionDeployDescription deployedDesc;
+    deployedDesc.localDeployIndexMetas.push_back(
+        makeMeta(_remotePath,
+                 _localPath,
+                 {makeFileInfo("__FENCE__1/segment_0/data", 4, "4-1-1"),
+                  makeFileInfo("__FENCE__1/segment_0/cleaned", 4, "4-3-3")}));
+    indexlibv2::framework::VersionDeployDescription targetDesc;
+    targetDesc.localDeployIndexMetas.push_back(makeMeta(_remotePath,
+                                                        _localPath,
+                                                        {makeFileInfo("__FENCE__2/segment_1/data", 5, "4-1-1"),
+                                                         makeFileInfo("__FENCE__2/segment_1/other", 4, "4-3-3")}));
+    DeployFileDeduper deduper;
+    deduper.addDeployedVersion(deployedDesc);
+    DeployFilesVec deployFilesVec = {
+        makeDeployFiles({{"__FENCE__2/segment_1/data", 5}, {"__FENCE__2/segment_1/other", 4}})};
+    ASSERT_EQ(0, deduper.dedup(targetDesc, deployFilesVec));
+    ASSERT_EQ(1u, deployFilesVec.size());
+    ASSERT_EQ(2u, deployFilesVec[0].deployFiles.size());
+    ASSERT_EQ(9, deployFilesVec[0].deploySize);
+}
+
+} // namespace suez
@@ -1,16 +1,36 @@
 #include "suez/deploy/DeployManager.h"
 
+#include "fslib/fs/FileSystem.h"
 #include "suez/deploy/LocalDeployItem.h"
 #include "suez/deploy/NormalDeployItem.h"
+#include "suez/deploy/PeerChunkRegistry.h"
+#include "suez/deploy/PeerClient.h"
 #include "unittest/unittest.h"
 
 using namespace std;
+using namespace fslib::fs;
 using namespace testing;
 
 namespace suez {
 
 class DeployManagerTest : public TESTBASE {};
 
+class NullPeerClient : public PeerClient {
+public:
+    bool queryChunks(const string &peerSpec,
+                     const QueryChunksRequest &request,
+                     QueryChunksResponse &response,
+                     int32_t timeoutMs) override {
+        return false;
+    }
+    bool readChunk(const string &peerSpec,
+                   const ReadChunkRequest &request,
+                   ReadChunkResponse &response,
+                   int32_t timeoutMs) override {
+        return false;
+    }
+};
+
 TEST_F(DeployManagerTest, testDedup) {
     DeployFilesVec deployFilesVec1;
     deployFilesVec1.push_back(DeployFiles{"path1", "path2"});
@@ -44,4 +64,46 @@ TEST_F(DeployManagerTest, testLocalDeploy) {
     ASSERT_NE(nullptr, dynamic_pointer_cast<LocalDeployItem>(itemLocal));
 }
 
+TEST_F(DeployManagerTest, testMarkDeployedOnlyWhenPeerDeployEnabled) {
+    auto localPath = GET_TEMPLATE_DATA_PATH() + "/local";
+    ASSERT_EQ(fslib::EC_OK, FileSystem::mkDir(localPath, true));
+    ASSERT_EQ(fslib::EC_OK, FileSystem::writeFile(localPath + "/data", "data"));
+    DeployFiles deployFiles{"remote", localPath, {"data"}};
+    DeployFilesVec deployFilesVec = {deployFiles};
+
+    DeployManager manager(nullptr, nullptr);
+    manager.setPeerClient(make_shared<NullPeerClient>());
+    auto registry = manager.getPeerChunkRegistry();
+    string localFilePath;
+    PeerChunkRegistry::FileState state;
+    // disabled by default, nothing is served
+    EXPECT_FALSE(manager.isPeerDeployEnabled());
+    manager.markDeployed(deployFilesVec);
+    EXPECT_FALSE(registry->getFileState("remote", "data", localFilePath, state));
+
+    PeerDeployConfig config;
+    config.enable = true;
+    config.peers = {"tcp:peer"};
+    manager.updatePeerDeployConfig(config);
+    EXPECT_TRUE(manager.isPeerDeployEnabled());
+    manager.markDeployed(deployFilesVec);
+    EXPECT_TRUE(registry->getFileState("remote", "data", localFilePath, state));
+
+    // turned off, the served files are dropped
+    config.enable = false;
+    manager.updatePeerDeployConfig(config);
+    EXPECT_FALSE(manager.isPeerDeployEnabled());
+    EXPECT_FALSE(registry->getFileState("remote", "data", localFilePath, state));
+    manager.markDeployed(deployFilesVec);
+    EXPECT_FALSE(registry->getFileState("remote", "data", localFilePath, state));
+
+    // never served in local mode
+    DeployManager localManager(nullptr, nullptr, true);
+    config.enable = true;
+    localManager.updatePeerDeployConfig(config);
+    EXPECT_FALSE(localManager.isPeerDeployEnabled());
+    localManager.markDeployed(deployFilesVec);
+    EXPECT_FALSE(localManager.getPeerChunkRegistry()->getFileState("remote", "data", localFilePath, state));
+}
+
 } // namespace suez
@@ -0,0 +1,319 @@
+#include "suez/deploy/PeerDeployItem.h"
+
+#include "MockDataClient.h"
+#include "autil/TimeUtility.h"
+#include "fslib/fs/FileSystem.h"
+#include "indexlib/file_system/FileChecksumTable.h"
+#include "suez/deploy/BandwidthLimiter.h"
+#include "suez/deploy/PeerChunkRegistry.h"
+#include "suez/deploy/PeerClient.h"
+#include "suez/deploy/PeerDeployServiceImpl.h"
+#include "unittest/unittest.h"
+
+using namespace std;
+using namespace fslib::fs;
+using namespace testing;
+
+namespace suez {
+
+// calls the service of the other replicas in process
+class InProcessPeerClient : public PeerClient {
+public:
+    bool queryChunks(const string &peerSpec,
+                     const QueryChunksRequest &request,
+                     QueryChunksResponse &response,
+                     int32_t timeoutMs) override {
+        auto service = getService(peerSpec);
+        if (!service) {
+            return false;
+        }
+        service->queryChunks(nullptr, &request, &response, nullptr);
+        return true;
+    }
+    bool readChunk(const string &peerSpec,
+                   const ReadChunkRequest &request,
+                   ReadChunkResponse &response,
+                   int32_t timeoutMs) override {
+        auto service = getService(peerSpec);
+        if (!service) {
+            return false;
+        }
+        ++readCount[peerSpec];
+        if (dropReads) {
+            // the request times out, nothing is received
+            return false;
+        }
+        service->readChunk(nullptr, &request, &response, nullptr);
+        return response.success();
+    }
+    PeerDeployServiceImpl *getService(const string &peerSpec) {
+        auto it = services.find(peerSpec);
+        return it == services.end() ? nullptr : it->second;
+    }
+
+public:
+    map<string, PeerDeployServiceImpl *> services;
+    map<string, int64_t> readCount;
+    bool dropReads = false;
+};
+
+class PeerDeployItemTest : public TESTBASE {
+public:
+    void setUp() override {
+        _remotePath = GET_TEMPLATE_DATA_PATH() + "/remote/12345";
+        ASSERT_EQ(fslib::EC_OK, FileSystem::mkDir(_remotePath, true));
+        writeFile(_remotePath, "seg/data", string(10000, 'd'));
+        writeFile(_remotePath, "seg/index", string(3000, 'i'));
+        writeFile(_remotePath, "version.0", "version");
+        for (size_t i = 0; i < 3; ++i) {
+            auto replica = make_unique<Replica>();
+            replica->localPath = GET_TEMPLATE_DATA_PATH() + "/replica_" + to_string(i) + "/12345";
+            ASSERT_EQ(fslib::EC_OK, FileSystem::mkDir(replica->localPath, true));
+            replica->service = make_unique<PeerDeployServiceImpl>(&replica->registry, nullptr);
+            _peerClient.services["tcp:replica_" + to_string(i)] = replica->service.get();
+            _replicas.push_back(std::move(replica));
+        }
+        _config.enable = true;
+        _config.chunkSize = 1024;
+    }
+
+protected:
+    struct Replica {
+        string localPath;
+        PeerChunkRegistry registry;
+        unique_ptr<PeerDeployServiceImpl> service;
+    };
+
+protected:
+    void writeFile(const string &root, const string &fileName, const string &content) {
+        auto path = FileSystem::joinFilePath(root, fileName);
+        ASSERT_EQ(fslib::EC_OK, FileSystem::mkDir(FileSystem::getParentPath(path), true));
+        ASSERT_EQ(fslib::EC_OK, FileSystem::writeFile(path, content));
+    }
+    string readFile(const string &root, const string &fileName) {
+        string content;
+        EXPECT_EQ(fslib::EC_OK, FileSystem::readFile(FileSystem::joinFilePath(root, fileName), content));
+        return content;
+    }
+    DeployFilesVec makeDeployFiles(size_t idx, const vector<string> &files) {
+        DeployFiles deployFiles{_remotePath, _replicas[idx]->localPath, files};
+        deployFiles.deploySize = 1;
+        return {deployFiles};
+    }
+    // replica idx already holds all files
+    void seed(size_t idx) {
+        vector<string> files = {"seg/data", "seg/index", "version.0"};
+        for (const auto &file : files) {
+            writeFile(_replicas[idx]->localPath, file, readFile(_remotePath, file));
+        }
+        _replicas[idx]->registry.addDeployed(makeDeployFiles(idx, files));
+    }
+    static PeerChunkRegistry::FileState makeState(int64_t length, int64_t readyLength) {
+        PeerChunkRegistry::FileState state;
+        state.length = length;
+        state.readyLength = readyLength;
+        return state;
+    }
+    string checksum(const string &root, const string &fileName) {
+        auto [ec, checksum] =
+            indexlib::file_system::FileChecksumTable::ComputeChecksum(FileSystem::joinFilePath(root, fileName));
+        EXPECT_EQ(indexlib::file_system::FSEC_OK, ec);
+        return checksum;
+    }
+
+protected:
+    string _remotePath;
+    vector<unique_ptr<Replica>> _replicas;
+    InProcessPeerClient _peerClient;
+    PeerDeployConfig _config;
+};
+
+TEST_F(PeerDeployItemTest, testDeployAllFromPeers) {
+    seed(0);
+    seed(1);
+    _config.peers = {"tcp:replica_0", "tcp:replica_1", "tcp:not_exist"};
+    shared_ptr<StrictMockDataClient> mockDataClient(new StrictMockDataClient);
+    vector<string> files = {"seg/data", "seg/index", "version.0"};
+    PeerDeployItem deployItem(DeployResource{shared_ptr<DataClient>(mockDataClient), nullptr},
+                              DataOption(),
+                              _config,
+                              PeerDeployResource{&_replicas[2]->registry, &_peerClient, nullptr},
+                              makeDeployFiles(2, files));
+    ASSERT_EQ(DS_DEPLOYDONE, deployItem.deployAndWaitDone());
+    for (const auto &file : files) {
+        EXPECT_EQ(readFile(_remotePath, file), readFile(_replicas[2]->localPath, file));
+    }
+    // chunks spread over both peers
+    EXPECT_LT(0, _peerClient.readCount["tcp:replica_0"]);
+    EXPECT_LT(0, _peerClient.readCount["tcp:replica_1"]);
+
+    // fetched files are served to other peers before the deploy is marked done
+    string localFilePath;
+    PeerChunkRegistry::FileState state;
+    ASSERT_TRUE(_replicas[2]->registry.getFileState(_remotePath + "/", "seg/data", localFilePath, state));
+    EXPECT_EQ(10000, state.length);
+    EXPECT_EQ(10000, state.readyLength);
+
+    // deployed twice
+    EXPECT_EQ(DS_DEPLOYDONE, deployItem.deployAndWaitDone());
+}
+
+TEST_F(PeerDeployItemTest, testDeployRemainFromRemote) {
+    // replica 0 only holds the head of seg/data
+    writeFile(_replicas[0]->localPath, "seg/data", readFile(_remotePath, "seg/data"));
+    _replicas[0]->registry.updateProgress(_remotePath, _replicas[0]->localPath, "seg/data", makeState(10000, 2048));
+    writeFile(_replicas[0]->localPath, "seg/index", readFile(_remotePath, "seg/index"));
+    _replicas[0]->registry.updateProgress(_remotePath, _replicas[0]->localPath, "seg/index", makeState(3000, 3000));
+    _config.peers = {"tcp:replica_0"};
+
+    shared_ptr<StrictMockDataClient> mockDataClient(new StrictMockDataClient);
+    DataItemPtr dataItem(new DataItem("", "", DataOption()));
+    dataItem->setStatus(worker_framework::DS_FINISHED);
+    EXPECT_CALL(*mockDataClient,
+                getData(_remotePath, vector<string>({"seg/data", "version.0"}), _replicas[1]->localPath, _))
+        .WillOnce(Return(dataItem));
+    PeerDeployItem deployItem(DeployResource{shared_ptr<DataClient>(mockDataClient), nullptr},
+                              DataOption(),
+                              _config,
+                              PeerDeployResource{&_replicas[1]->registry, &_peerClient, nullptr},
+                              makeDeployFiles(1, {"seg/data", "seg/index", "version.0"}));
+    ASSERT_EQ(DS_DEPLOYDONE, deployItem.deployAndWaitDone());
+    EXPECT_EQ(readFile(_remotePath, "seg/index"), readFile(_replicas[1]->localPath, "seg/index"));
+    // the partial copy of seg/data is dropped and left to the remote deploy
+    EXPECT_EQ(fslib::EC_FALSE, FileSystem::isExist(FileSystem::joinFilePath(_replicas[1]->localPath, "seg/data")));
+}
+
+TEST_F(PeerDeployItemTest, testServeOnlyCompletedFiles) {
+    seed(0);
+    auto &registry = _replicas[0]->registry;
+    string localFilePath;
+    PeerChunkRegistry::FileState state;
+    ASSERT_TRUE(registry.getFileState(_remotePath, "seg/data", localFilePath, state));
+    EXPECT_TRUE(state.isComplete());
+    // files on disk that no completed deploy lists are not served
+    writeFile(_replicas[0]->localPath, "seg/partial", "partial");
+    EXPECT_FALSE(registry.getFileState(_remotePath, "seg/partial", localFilePath, state));
+
+    // the next version rewrites seg/data in the same root, only its ready head is served
+    registry.updateProgress(_remotePath, _replicas[0]->localPath, "seg/data", makeState(20000, 1024));
+    writeFile(_replicas[0]->localPath, "seg/data", string(1024, 'n'));
+    ASSERT_TRUE(registry.getFileState(_remotePath, "seg/data", localFilePath, state));
+    EXPECT_EQ(20000, state.length);
+    EXPECT_EQ(1024, state.readyLength);
+    // other files of the completed deploy are still served
+    ASSERT_TRUE(registry.getFileState(_remotePath, "seg/index", localFilePath, state));
+    EXPECT_TRUE(state.isComplete());
+
+    // a completed file truncated on disk is not served any more
+    writeFile(_replicas[0]->localPath, "seg/index", "broken");
+    EXPECT_FALSE(registry.getFileState(_remotePath, "seg/index", localFilePath, state));
+    registry.removeProgress(_remotePath, "seg/data");
+    EXPECT_FALSE(registry.getFileState(_remotePath, "seg/data", localFilePath, state));
+}
+
+TEST_F(PeerDeployItemTest, testVerifyChecksum) {
+    // replica 0 advertises another checksum, replica 1 has the right checksum but corrupted content
+    seed(0);
+    auto deployFilesVec = makeDeployFiles(1, {"seg/data", "seg/index", "version.0"});
+    for (const auto &file : deployFilesVec[0].deployFiles) {
+        writeFile(_replicas[1]->localPath, file, readFile(_remotePath, file));
+        deployFilesVec[0].fileChecksums[file] = checksum(_remotePath, file);
+    }
+    writeFile(_replicas[1]->localPath, "seg/index", string(3000, 'x'));
+    _replicas[1]->registry.addDeployed(deployFilesVec);
+    auto badFilesVec = makeDeployFiles(0, {"seg/data", "seg/index", "version.0"});
+    badFilesVec[0].fileChecksums["seg/data"] = "10000-0-0";
+    _replicas[0]->registry.addDeployed(badFilesVec);
+    _config.peers = {"tcp:replica_0", "tcp:replica_1"};
+
+    auto targetFilesVec = makeDeployFiles(2, {"seg/data", "seg/index", "version.0"});
+    targetFilesVec[0].fileChecksums = deployFilesVec[0].fileChecksums;
+    shared_ptr<StrictMockDataClient> mockDataClient(new StrictMockDataClient);
+    DataItemPtr dataItem(new DataItem("", "", DataOption()));
+    dataItem->setStatus(worker_framework::DS_FINISHED);
+    EXPECT_CALL(*mockDataClient, getData(_remotePath, vector<string>({"seg/index"}), _replicas[2]->localPath, _))
+        .WillOnce(Return(dataItem));
+    PeerDeployItem deployItem(DeployResource{shared_ptr<DataClient>(mockDataClient), nullptr},
+                              DataOption(),
+                              _config,
+                              PeerDeployResource{&_replicas[2]->registry, &_peerClient, nullptr},
+                              targetFilesVec);
+    ASSERT_EQ(DS_DEPLOYDONE, deployItem.deployAndWaitDone());
+    EXPECT_EQ(readFile(_remotePath, "seg/data"), readFile(_replicas[2]->localPath, "seg/data"));
+    // seg/data only comes from replica 1, whose checksum matches
+    EXPECT_EQ(0, _peerClient.readCount["tcp:replica_0"]);
+    string localFilePath;
+    PeerChunkRegistry::FileState state;
+    EXPECT_FALSE(_replicas[2]->registry.getFileState(_remotePath, "seg/index", localFilePath, state));
+    ASSERT_TRUE(_replicas[2]->registry.getFileState(_remotePath, "seg/data", localFilePath, state));
+    EXPECT_EQ(checksum(_remotePath, "seg/data"), state.checksum);
+}
+
+TEST_F(PeerDeployItemTest, testRejectInvalidRange) {
+    seed(0);
+    ReadChunkRequest request;
+    request.set_sourcerootpath(_remotePath);
+    request.set_filename("../12345/seg/data");
+    request.set_offset(0);
+    request.set_length(10);
+    ReadChunkResponse response;
+    _replicas[0]->service->readChunk(nullptr, &request, &response, nullptr);
+    EXPECT_FALSE(response.success());
+
+    request.set_filename("seg/data");
+    request.set_offset(9995);
+    response.Clear();
+    _replicas[0]->service->readChunk(nullptr, &request, &response, nullptr);
+    EXPECT_FALSE(response.success());
+
+    request.set_offset(9990);
+    response.Clear();
+    _replicas[0]->service->readChunk(nullptr, &request, &response, nullptr);
+    ASSERT_TRUE(response.success());
+    EXPECT_EQ(string(10, 'd'), response.data());
+}
+
+TEST_F(PeerDeployItemTest, testDownloadLimiterChargesReceivedBytes) {
+    seed(0);
+    _config.peers = {"tcp:replica_0"};
+    vector<string> files = {"seg/data", "seg/index", "version.0"};
+    // 1 byte per us, the deploy of about 13KB finishes within tens of ms
+    BandwidthLimiter limiter(1000000);
+
+    // failed attempts spend no bandwidth
+    _peerClient.dropReads = true;
+    shared_ptr<StrictMockDataClient> mockDataClient(new StrictMockDataClient);
+    DataItemPtr dataItem(new DataItem("", "", DataOption()));
+    dataItem->setStatus(worker_framework::DS_FINISHED);
+    EXPECT_CALL(*mockDataClient, getData(_remotePath, files, _replicas[1]->localPath, _)).WillOnce(Return(dataItem));
+    PeerDeployItem failedItem(DeployResource{shared_ptr<DataClient>(mockDataClient), nullptr},
+                              DataOption(),
+                              _config,
+                              PeerDeployResource{&_replicas[1]->registry, &_peerClient, &limiter},
+                              makeDeployFiles(1, files));
+    ASSERT_EQ(DS_DEPLOYDONE, failedItem.deployAndWaitDone());
+    EXPECT_LT(0, _peerClient.readCount["tcp:replica_0"]);
+    EXPECT_EQ(0, limiter._nextFreeTimeUs);
+
+    // received chunks are charged
+    _peerClient.dropReads = false;
+    int64_t beginUs = autil::TimeUtility::currentTimeInMicroSeconds();
+    PeerDeployItem deployItem(DeployResource{shared_ptr<DataClient>(new StrictMockDataClient), nullptr},
+                              DataOption(),
+                              _config,
+                              PeerDeployResource{&_replicas[2]->registry, &_peerClient, &limiter},
+                              makeDeployFiles(2, files));
+    ASSERT_EQ(DS_DEPLOYDONE, deployItem.deployAndWaitDone());
+    EXPECT_LE(beginUs + 13007, limiter._nextFreeTimeUs);
+}
+
+TEST_F(PeerDeployItemTest, testBandwidthLimiter) {
+    BandwidthLimiter limiter(1000);
+    EXPECT_EQ(0, limiter.reserve(500, 0));
+    EXPECT_EQ(500000, limiter.reserve(500, 0));
+    EXPECT_EQ(0, limiter.reserve(100, 2000000));
+    limiter.setLimit(0);
+    EXPECT_EQ(0, limiter.reserve(100000, 2000000));
+}
+
+} // namespace suez
@@ -50,6 +50,7 @@ void HeartbeatTarget::Jsonize(JsonWrapper &json) {
     json.Jsonize("table_info", _tableMetas, _tableMetas);
     json.Jsonize("service_info", _serviceInfo, _serviceInfo);
     json.Jsonize("deploy_config", _deployConfig, _deployConfig);
+    json.Jsonize("peer_deploy_config", _peerDeployConfig, _peerDeployConfig);
     json.Jsonize("target_version", _targetVersion, _targetVersion);
     json.Jsonize("clean_disk", _cleanDisk, _cleanDisk);
     json.Jsonize("custom_app_info", _customAppInfo, _customAppInfo);
@@ -22,6 +22,7 @@
 #include "autil/legacy/jsonizable.h"
 #include "suez/common/InnerDef.h"
 #include "suez/common/TableMeta.h"
+#include "suez/deploy/PeerDeployConfig.h"
 #include "suez/sdk/BizMeta.h"
 #include "suez/sdk/ServiceInfo.h"
 #include "worker_framework/DataOption.h"
@@ -44,6 +45,7 @@ public:
     const BizMetas &getBizMetas() const { return _bizMetas; }
     const AppMeta &getAppMeta() const { return _appMeta; }
     const worker_framework::DataOption &getDeployConfig() const { return _deployConfig; }
+    const PeerDeployConfig &getPeerDeployConfig() const { return _peerDeployConfig; }
     const ServiceInfo &getServiceInfo() const { return _serviceInfo; }
     int64_t getTargetVersion() const { return _targetVersion; }
 
@@ -71,6 +73,7 @@ private:
     BizMetas _bizMetas;
     AppMeta _appMeta;
     worker_framework::DataOption _deployConfig;
+    PeerDeployConfig _peerDeployConfig;
     ServiceInfo _serviceInfo;
     autil::legacy::json::JsonMap _customAppInfo;
     int64_t _targetVersion;
@@ -30,6 +30,14 @@ void AccessCounterLog::reportIndexCounter(const string &name, uint32_t count) {
 
 void AccessCounterLog::reportAttributeCounter(const string &name, uint32_t count) { log("Attribute", name, count); }
 
+void AccessCounterLog::reportLazyLoadReadiness(const string &name, size_t pendingFileCount, size_t pendingBytes) {
+    AUTIL_LOG(INFO,
+              "[LazyLoad: %s]: not ready, pending files %lu, pending bytes %lu",
+              name.c_str(),
+              pendingFileCount,
+              pendingBytes);
+}
+
 void AccessCounterLog::log(const string &prefix, const string &name, uint32_t count) {
     AUTIL_LOG(INFO, "[%s: %s]: %u", prefix.c_str(), name.c_str(), count);
 }
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string>
 
@@ -32,6 +33,7 @@ private:
 public:
     void reportIndexCounter(const std::string &indexName, uint32_t count);
     void reportAttributeCounter(const std::string &attributeName, uint32_t count);
+    void reportLazyLoadReadiness(const std::string &indexName, size_t pendingFileCount, size_t pendingBytes);
 
 private:
     void log(const std::string &prefix, const std::string &name, uint32_t count);
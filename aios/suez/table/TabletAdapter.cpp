@@ -22,6 +22,7 @@
 #include "indexlib/config/TabletOptions.h"
 #include "indexlib/config/TabletSchema.h"
 #include "indexlib/config/index_partition_options.h"
+#include "indexlib/file_system/file/LazyLoadScheduler.h"
 #include "indexlib/framework/ITablet.h"
 #include "indexlib/framework/TabletInfos.h"
 #include "indexlib/framework/Version.h"
@@ -143,11 +144,14 @@ void TabletAdapter::reportAccessCounter(const std::string &name) const {
     }
     auto counterMap = tabletInfos->GetCounterMap();
 
+    // access counts also decide which lazily loaded index is warmed up first
+    std::map<std::string, int64_t> accessHints;
     auto attributeCounter = counterMap->GetMultiCounter("online.access.attribute");
     for (const auto &[attributeName, counter] : attributeCounter->GetCounterMap()) {
         auto accCounter = std::dynamic_pointer_cast<indexlib::util::AccumulativeCounter>(counter);
         if (accCounter) {
             accessCounterLog.reportAttributeCounter(name + "." + attributeName, accCounter->Get());
+            accessHints["attribute/" + attributeName] = accCounter->Get();
         }
     }
 
@@ -156,6 +160,18 @@ void TabletAdapter::reportAccessCounter(const std::string &name) const {
         auto accCounter = std::dynamic_pointer_cast<indexlib::util::AccumulativeCounter>(counter);
         if (accCounter) {
             accessCounterLog.reportIndexCounter(name + "." + invertedName, accCounter->Get());
+            accessHints["index/" + invertedName] = accCounter->Get();
+        }
+    }
+
+    auto lazyLoadScheduler = tabletInfos->GetLazyLoadScheduler();
+    if (lazyLoadScheduler) {
+        lazyLoadScheduler->UpdateAccessHints(accessHints);
+        for (const auto &[indexKey, readiness] : lazyLoadScheduler->GetReadiness()) {
+            if (!readiness.IsReady()) {
+                accessCounterLog.reportLazyLoadReadiness(
+                    name + "." + indexKey, readiness.pendingFileCount, readiness.pendingBytes);
+            }
         }
     }
 }
@@ -34,6 +34,7 @@
 #include "suez/common/InnerDef.h"
 #include "suez/common/TableMeta.h"
 #include "suez/deploy/DeployManager.h"
+#include "suez/deploy/PeerDeployServiceImpl.h"
 #include "suez/heartbeat/HeartbeatManager.h"
 #include "suez/heartbeat/HeartbeatTarget.h"
 #include "suez/sdk/RpcServer.h"
@@ -291,6 +292,8 @@ bool TaskExecutor::doWorkloop(HeartbeatTarget &target,
 
     _diskQuotaController.setQuotaMb(finalTarget.getDiskSize());
     _deployManager->updateDeployConfig(target.getDeployConfig());
+    _deployManager->updatePeerDeployConfig(target.getPeerDeployConfig());
+    maybeRegisterPeerDeployService();
     if (!shutdownFlag) {
         UPDATE_RESULT targetUpdateResult = maybeUpdateTarget(target, finalTarget);
         if (UR_REACH_TARGET != targetUpdateResult) {
@@ -331,6 +334,20 @@ bool TaskExecutor::doWorkloop(HeartbeatTarget &target,
     return reachTarget;
 }
 
+void TaskExecutor::maybeRegisterPeerDeployService() {
+    // registered once on first enable and kept, a disabled node serves nothing from its empty registry
+    if (_peerDeployService || !_rpcServer || !_deployManager->isPeerDeployEnabled()) {
+        return;
+    }
+    _peerDeployService = make_unique<PeerDeployServiceImpl>(_deployManager->getPeerChunkRegistry(),
+                                                            _deployManager->getPeerUploadLimiter());
+    if (!_rpcServer->RegisterService(_peerDeployService.get(), arpc::ThreadPoolDescriptor("PeerDeploy", 4, 64))) {
+        AUTIL_LOG(ERROR, "register peer deploy service failed, files are not served to peers");
+        return;
+    }
+    AUTIL_LOG(INFO, "peer deploy service registered");
+}
+
 void TaskExecutor::release() {
     AUTIL_LOG(INFO, "TaskExecutor::release begin");
     gracefullyShutdown();
@@ -44,6 +44,7 @@ struct EnvParam;
 class WorkerCurrent;
 class SchedulerInfo;
 class DeployManager;
+class PeerDeployServiceImpl;
 
 class TaskExecutor : autil::ObjectTracer<TaskExecutor, true> {
 public:
@@ -88,10 +89,12 @@ private:
     void adjustWorkerCurrent(WorkerCurrent &current);
     void stopService();
     UPDATE_RESULT maybeUpdateTarget(HeartbeatTarget &target, HeartbeatTarget &finalTarget);
+    void maybeRegisterPeerDeployService();
 
 private:
     HeartbeatManager *_hbManager;
     std::unique_ptr<DeployManager> _deployManager;
+    std::unique_ptr<PeerDeployServiceImpl> _peerDeployService;
     std::unique_ptr<TableManager> _tableManager;
     std::unique_ptr<SearchManagerUpdater> _searchManagerUpdater;
     autil::LoopThreadPtr _workThread;